@@ -24,13 +24,19 @@ function(ge_setup_lz4)
 
   set(_SRC "${lz4_upstream_SOURCE_DIR}/lib/lz4.c")
   set(_HDR "${lz4_upstream_SOURCE_DIR}/lib/lz4.h")
+  set(_HC_SRC "${lz4_upstream_SOURCE_DIR}/lib/lz4hc.c")
+  set(_HC_HDR "${lz4_upstream_SOURCE_DIR}/lib/lz4hc.h")
 
   if(NOT EXISTS "${_SRC}" OR NOT EXISTS "${_HDR}")
     message(FATAL_ERROR "[LZ4] No encontré lib/lz4.c o lib/lz4.h en: ${lz4_upstream_SOURCE_DIR}")
   endif()
 
-  add_library(ge_lz4 STATIC "${_SRC}" "${_HDR}")
-  set_source_files_properties("${_SRC}" PROPERTIES LANGUAGE C)
+  if(NOT EXISTS "${_HC_SRC}" OR NOT EXISTS "${_HC_HDR}")
+    message(FATAL_ERROR "[LZ4] No encontré lib/lz4hc.c o lib/lz4hc.h en: ${lz4_upstream_SOURCE_DIR}")
+  endif()
+
+  add_library(ge_lz4 STATIC "${_SRC}" "${_HDR}" "${_HC_SRC}" "${_HC_HDR}")
+  set_source_files_properties("${_SRC}" "${_HC_SRC}" PROPERTIES LANGUAGE C)
 
   target_include_directories(ge_lz4 PUBLIC
     "${lz4_upstream_SOURCE_DIR}/lib"
@@ -43,5 +49,5 @@ function(ge_setup_lz4)
   )
 
   # Opcional: para IDE
-  source_group(TREE "${lz4_upstream_SOURCE_DIR}" FILES "${_SRC}" "${_HDR}")
+  source_group(TREE "${lz4_upstream_SOURCE_DIR}" FILES "${_SRC}" "${_HDR}" "${_HC_SRC}" "${_HC_HDR}")
 endfunction()
@@ -62,6 +62,7 @@ namespace geEngineSDK {
 
       m_components.push_back(component);
       component->onAttach();
+      markBoundsDirty();
 
       return component;
     }
@@ -111,6 +112,7 @@ namespace geEngineSDK {
             (*it)->onDetach();
             (*it)->m_owner = nullptr;
             m_components.erase(it);
+            markBoundsDirty();
             return true;
           }
           count++;
@@ -120,6 +122,14 @@ namespace geEngineSDK {
       return false;
     }
 
+    /**
+     * @brief Tells the scene that the bounds of the actor changed, e.g. a
+     *        model was added, removed or replaced. Moving the scene node
+     *        doesn't need it.
+     */
+    void
+    markBoundsDirty();
+
     void
     update(float dt);
 
@@ -131,6 +141,8 @@ namespace geEngineSDK {
     bool m_active = true;
 
     Vector<SPtr<Component>> m_components;
+
+    friend class Scene;
   };
 
 } // namespace geEngineSDK
@@ -23,6 +23,7 @@
 #include "geVector3.h"
 #include "geQuaternion.h"
 #include "geMatrix4.h"
+#include "gePlane.h"
 
 namespace geEngineSDK {
   class GE_CORE_EXPORT Camera
@@ -108,6 +109,26 @@ namespace geEngineSDK {
       return m_projMatrix;
     }
 
+    /**
+     * @brief The planes of the view frustum in world space, see
+     *        extractFrustum().
+     */
+    Array<Plane, 6>
+    getFrustum() {
+      updateCamera();
+      return extractFrustum(m_viewMatrix * m_projMatrix);
+    }
+
+    /**
+     * @brief Extracts the six planes (left, right, bottom, top, near, far) of
+     *        the volume a view projection matrix maps to clip space, with
+     *        their normals facing out of it: a point is inside when
+     *        planeDot() is not positive for any of them. Also works for the
+     *        matrices of shadow and reflection views.
+     */
+    static Array<Plane, 6>
+    extractFrustum(const Matrix4& viewProj);
+
     void
     setScreenSize(float width, float height) {
       m_fScreenWidth = width;
@@ -244,6 +265,25 @@ namespace geEngineSDK {
       return front ^ right;
     }
 
+    /**
+     * @brief How many pixels one world unit covers at the given view distance.
+     *        Used to turn a world space error (like a LOD error) into pixels.
+     * @note  Matches the projection built by updateCamera(), which takes m_fFov
+     *        as the half field of view.
+     */
+    float
+    getPixelsPerUnit(float distance) const {
+      if (m_bIsOrtho) {
+        //OrthoMatrix maps [-height, height] to clip space
+        return m_fScreenHeight / (2.0f * m_fOrthoHeight);
+      }
+
+      //Y scale of the projection is Width / (Height * tan(fov)), and clip
+      //space covers half the screen height per unit
+      return m_fScreenWidth /
+             (2.0f * Math::tan(m_fFov.valueRadians()) * Math::max(distance, m_fNear));
+    }
+
     bool
     operator==(const Camera& other) const {
       return m_bIsDirty == other.m_bIsDirty &&
@@ -19,6 +19,8 @@
 /*****************************************************************************/
 #include "gePrerequisitesCore.h"
 #include "geAppInputEvents.h"
+#include "geGameConfig.h"
+#include "geFramePipeline.h"
 #include <geVector2I.h>
 
 #include <SFML/Window.hpp>
@@ -56,6 +58,15 @@ namespace geEngineSDK {
     GE_NODISCARD virtual Vector2I
     getWindowSize() const;
 
+    /**
+     * @brief Carries the render commands of each frame. Created before
+     *        onCreate, so the App can create its FrameSnapshot objects there.
+     */
+    GE_NODISCARD FramePipeline&
+    getFramePipeline() {
+      return *m_framePipeline;
+    }
+
    private:
     void
     startMountManager();
@@ -82,6 +93,9 @@ namespace geEngineSDK {
     void
     resize(int32 width, int32 height);
 
+    void
+    fixedUpdate();
+
     void
     update(float deltaTime);
 
@@ -121,12 +135,46 @@ namespace geEngineSDK {
 
     Event<void(void)> onCreate;
     Event<void(void)> onDestroy;
+
+    /**
+     * Called with the fixed step (Time::getFixedFrameDelta()) as many times
+     * as the elapsed time requires, before onUpdate.
+     */
+    Event<void(float)> onFixedUpdate;
+
+    /**
+     * With a RENDER/FRAMELATENCY above 0 the render thread is drawing the
+     * last frames meanwhile, so the work on the device has to be recorded
+     * with getFramePipeline().enqueue(), or come after a call to
+     * getFramePipeline().waitForDevice(). The loads of the TextureManager
+     * and the deferred calls already wait for the device.
+     */
     Event<void(float)> onUpdate;
+
+    /**
+     * With a RENDER/FRAMELATENCY above 0 this is called on the render thread
+     * while the next frames are simulated, so it has to read the state of the
+     * simulation through a FrameSnapshot.
+     */
     Event<void(void)> onRender;
 
     Vector2I m_clientSize = Vector2I(1280, 720);
 
    private:
+    ConfigVar<String> m_cfgEnginePath;
+    ConfigVar<String> m_cfgPluginsPath;
+    ConfigVar<String> m_cfgAppPath;
+    ConfigVar<bool> m_cfgCreateWindow;
+    ConfigVar<uint32> m_cfgWindowWidth;
+    ConfigVar<uint32> m_cfgWindowHeight;
+    ConfigVar<int32> m_cfgWindowPosX;
+    ConfigVar<int32> m_cfgWindowPosY;
+    ConfigVar<String> m_cfgWindowTitle;
+    ConfigVar<bool> m_cfgFullscreen;
+    ConfigVar<String> m_cfgRenderAPIModule;
+    ConfigVar<uint32> m_cfgFrameLatency;
+    ConfigVar<uint32> m_cfgStreamingBudgetMB;
+    UPtr<FramePipeline> m_framePipeline;
     bool m_windowHasFocus = false;
     WindowBase* m_window = nullptr;
   };
@@ -23,6 +23,8 @@
 #include "gePrerequisitesCore.h"
 #include "geGraphicsInterfaces.h"
 #include <geModule.h>
+#include <geSpinLock.h>
+#include <geThreading.h>
 #include <geVector3.h>
 #include <geVector4.h>
 #include <geColor.h>
@@ -47,18 +49,51 @@ namespace geEngineSDK {
   class GE_CORE_EXPORT DebugDraw : public Module<DebugDraw>
   {
    public:
+    /**
+     * @brief Vertices the GPU buffer grows by when a frame doesn't fit.
+     */
+    static CONSTEXPR uint32 VERTEX_CHUNK_SIZE = DEBUG_CACHE_OBJECTS_NUM;
+
+    /**
+     * @brief Frames that fit in the GPU buffer before it wraps around and
+     *        has to be discarded.
+     */
+    static CONSTEXPR uint32 RING_FRAMES = 3;
+
     DebugDraw();
     ~DebugDraw() = default;
 
+    /**
+     * @brief Collects the primitives added by every thread since the last
+     *        update, drops the timed ones that expired and uploads the rest.
+     *        Must be called from the render thread.
+     * @param deltaTime Seconds since the last update.
+     */
     void
-    update();
+    update(float deltaTime = 0.0f);
 
     void
     draw();
 
+    /**
+     * @brief Drops the primitives of a single frame (duration 0). The timed
+     *        ones stay until they expire.
+     */
     void
     reset();
 
+    /**
+     * @brief Drops every primitive, timed ones included.
+     */
+    void
+    clear();
+
+    /**
+     * The add functions can be called from any thread. Every thread appends
+     * to its own buffer, so they only wait on update() taking the buffer.
+     * A duration of 0 draws the primitive in the next frame only, otherwise
+     * it is drawn for that many seconds of update().
+     */
     void
     addLine(const Vector3& posA,
             const Vector3& posB,
@@ -92,13 +127,84 @@ namespace geEngineSDK {
             Color color = Color::Red,
             float duration = 0.0f);
 
+    /**
+     * @brief Vertices uploaded by the last update().
+     */
+    uint32
+    getNumVertices() const {
+      return m_numVertices;
+    }
+
+    /**
+     * @brief First vertex of the GPU buffer that draw() reads from.
+     */
+    uint32
+    getFirstVertex() const {
+      return m_drawFirstVertex;
+    }
+
+    /**
+     * @brief Vertices that fit in the GPU buffer.
+     */
+    uint32
+    getVertexCapacity() const {
+      return m_vbCapacity;
+    }
+
+    /**
+     * @brief Timed lines that haven't expired yet.
+     */
+    uint32
+    getNumPersistentLines() const {
+      return cast::st<uint32>(m_persistentExpiry.size());
+    }
+
    private:
-    SPtr<VertexBuffer> m_frameVB;
+    struct DebugLine
+    {
+      Vector3 posA;
+      Vector3 posB;
+      Color color;
+      float duration;
+    };
+
+    struct ThreadBuffer
+    {
+      ThreadId owner;
+      SpinLock lock;
+      Vector<DebugLine> lines;
+    };
+
+    /**
+     * @brief The buffer of the calling thread, registered on its first use.
+     *        A thread that alternates between instances finds its buffer
+     *        again instead of registering a new one.
+     */
+    ThreadBuffer&
+    getThreadBuffer();
 
-    uint32 m_numFrameObjsInUse = 0;
-    Vector<DEBUG_VERTEX> m_frameData;
+    void
+    uploadVertices();
 
-    uint32 m_numPersistentObjsInUse = 0;
+    //Tells the buffers of this instance from the ones of a restarted module
+    uint64 m_instanceId;
+
+    Mutex m_threadBuffersMutex;
+    Vector<UPtr<ThreadBuffer>> m_threadBuffers;
+    Vector<DebugLine> m_collected;
+
+    //Seconds of update(), a float would stop advancing after a long session
+    double m_time = 0.0;
+
+    Vector<DEBUG_VERTEX> m_frameData;
     Vector<DEBUG_VERTEX> m_persistentData;
+    Vector<double> m_persistentExpiry;
+
+    SPtr<VertexDeclaration> m_vertexDecl;
+    SPtr<VertexBuffer> m_frameVB;
+    uint32 m_vbCapacity = 0;
+    uint32 m_vbOffset = 0;
+    uint32 m_drawFirstVertex = 0;
+    uint32 m_numVertices = 0;
   };
-}
\ No newline at end of file
+}
@@ -6,7 +6,9 @@
  * @brief   Module used to send deferred calls.
  *
  * Module used to send deferred calls (function calls that will wait until the
- * next frame
+ * next frame). Any thread can queue calls, and the main thread runs them in
+ * the order they were queued, highest priority first, within a time budget
+ * for each frame.
  *
  * @bug	    No known bugs.
  */
@@ -27,58 +29,241 @@ namespace geEngineSDK {
   using std::forward;
   using std::make_tuple;
   using std::apply;
+  using std::atomic;
 
   constexpr float DEFERRED_BUDGET_RATIO = 0.02f;  // 2% of a frame
   constexpr uint64 MIN_DEFERRED_BUDGET_US = 200;  // 200 micro seconds
   constexpr uint64 MAX_DEFERRED_BUDGET_US = 2000; // 2000 micro seconds
 
+  namespace DEFERRED_PRIORITY {
+    enum E {
+      kHigh = 0,
+      kNormal,
+      kLow,
+      kNumPriorities
+    };
+  }
+
+  /**
+   * @brief What happened on the last pump of the deferred calls.
+   */
+  struct DeferredCallStats
+  {
+    uint32 numExecuted = 0;
+
+    /**
+     * Calls left for the next frames.
+     */
+    uint32 numRemaining = 0;
+
+    uint64 budgetUs = 0;
+    uint64 elapsedUs = 0;
+
+    /**
+     * Time spent past the budget, by a call that took longer than expected.
+     */
+    uint64 overrunUs = 0;
+
+    /**
+     * Pumps that went past their budget since the module started.
+     */
+    uint64 totalOverruns = 0;
+  };
+
   class GE_CORE_EXPORT DeferredCallManager final : public Module<DeferredCallManager>
   {
+    struct Call;
+
    public:
-    using Task = function<void()>;
+    /**
+     * Callables up to this size are stored in the call itself, larger ones
+     * are allocated apart.
+     */
+    static CONSTEXPR SIZE_T INLINE_CALL_SIZE = 96;
 
     DeferredCallManager() = default;
     ~DeferredCallManager() override;
 
-    //Enque callable + args
+    /**
+     * @brief Queues a call of normal priority. Safe to call from any thread.
+     */
     template<class F, class... Args>
     void
     queueDeferredCall(F&& f, Args&&... args) {
+      queuePrioritizedCall(DEFERRED_PRIORITY::kNormal,
+                           forward<F>(f),
+                           forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Queues a call that runs after the queued calls of the same
+     *        priority, and before any call of a lower priority. Safe to call
+     *        from any thread.
+     */
+    template<class F, class... Args>
+    void
+    queuePrioritizedCall(DEFERRED_PRIORITY::E priority, F&& f, Args&&... args) {
       using R = invoke_result_t<F, Args...>;
       static_assert(is_void_v<R>,
         "DeferredCallManager::queueDeferredCall requires a callable that returns void.");
 
       //Captures callable + args per value (moving when aplies).
-      m_tasks.emplace_back(
+      auto task =
         [fn = forward<F>(f), tup = make_tuple(forward<Args>(args)...)]() mutable
         {
           apply(std::move(fn), std::move(tup));
-        }
-      );
+        };
+      using Callable = decltype(task);
+
+      Call* call = allocateCall();
+      if CONSTEXPR(sizeof(Callable) <= INLINE_CALL_SIZE &&
+                   alignof(Callable) <= alignof(std::max_align_t)) {
+        new (call->storage) Callable(std::move(task));
+        call->run = [](void* storage, bool bInvoke) {
+          Callable* inlineTask = std::launder(reinterpret_cast<Callable*>(storage));
+          if (bInvoke) {
+            (*inlineTask)();
+          }
+          inlineTask->~Callable();
+        };
+      }
+      else {
+        *reinterpret_cast<Callable**>(call->storage) = ge_new<Callable>(std::move(task));
+        call->run = [](void* storage, bool bInvoke) {
+          Callable* heapTask = *reinterpret_cast<Callable**>(storage);
+          if (bInvoke) {
+            (*heapTask)();
+          }
+          ge_delete(heapTask);
+        };
+      }
+
+      push(priority, call);
     }
 
+    /**
+     * @brief Runs the calls of the frame within a budget relative to its
+     *        duration. Must be called from the main thread.
+     */
     void
     update(float deltaTime);
 
+    /**
+     * @brief Runs calls until the budget is spent or no call is left. The
+     *        budget is checked every few calls, as many as the calls run so
+     *        far suggest fit in the remaining time. Must be called from the
+     *        main thread.
+     * @return The number of calls executed.
+     */
     uint32
     pumpFor(uint64 budgetUs);
 
+    /**
+     * @brief Drops the queued calls without running them. Must be called from
+     *        the main thread.
+     */
     void
-    clear() {
-      m_tasks.clear();
-    }
+    clear();
 
     bool
     empty() const {
-      return m_tasks.empty();
+      return 0 == size();
     }
 
+    /**
+     * @brief Calls queued and not run yet.
+     */
     SIZE_T
     size() const {
-      return m_tasks.size();
+      return m_numPending.load(std::memory_order_acquire);
+    }
+
+    const DeferredCallStats&
+    getLastFrameStats() const {
+      return m_lastFrameStats;
     }
 
    private:
-    Vector<Task> m_tasks;
+    static CONSTEXPR uint32 CALLS_PER_CHUNK = 256;
+    static CONSTEXPR uint32 MAX_CHUNKS = 4096;
+    static CONSTEXPR uint32 INVALID_CALL = NumLimit::MAX_UINT32;
+
+    /**
+     * @brief A queued call, with its callable stored inline. Calls are never
+     *        freed, but returned to a list to be reused by the next ones.
+     */
+    struct Call
+    {
+      atomic<Call*> next{ nullptr };
+      atomic<uint32> nextFree{ INVALID_CALL };
+      uint32 index = 0;
+
+      /**
+       * Runs the callable if asked to, and destroys it.
+       */
+      void (*run)(void*, bool) = nullptr;
+
+      alignas(std::max_align_t) uint8 storage[INLINE_CALL_SIZE];
+    };
+
+    struct Chunk
+    {
+      Call calls[CALLS_PER_CHUNK];
+    };
+
+    /**
+     * @brief Intrusive queue with many producers and a single consumer.
+     *        Pushing swaps the tail and links the previous one, so no thread
+     *        ever waits for another.
+     */
+    struct Lane
+    {
+      Lane() {
+        head = &stub;
+        tail.store(&stub, std::memory_order_relaxed);
+      }
+
+      Call stub;
+      Call* head;
+      atomic<Call*> tail;
+    };
+
+    Call*
+    allocateCall();
+
+    void
+    freeCall(Call* call);
+
+    Call*
+    getCall(uint32 index) const;
+
+    void
+    push(DEFERRED_PRIORITY::E priority, Call* call);
+
+    static void
+    pushToLane(Lane& lane, Call* call);
+
+    /**
+     * @brief Next call of the lane, or null if it's empty or the call being
+     *        pushed isn't linked yet.
+     */
+    static Call*
+    popFromLane(Lane& lane);
+
+    Lane m_lanes[DEFERRED_PRIORITY::kNumPriorities];
+    atomic<SIZE_T> m_numPending{ 0 };
+
+    /**
+     * Head of the list of free calls: the index of the call in the low bits
+     * and a counter in the high bits, so a call popped and pushed back while
+     * another thread pops it too is told apart.
+     */
+    atomic<uint64> m_freeHead{ INVALID_CALL };
+
+    atomic<Chunk*> m_chunks[MAX_CHUNKS] = {};
+    atomic<uint32> m_numChunks{ 0 };
+    Mutex m_chunkMutex;
+
+    DeferredCallStats m_lastFrameStats;
   };
 }
@@ -30,7 +30,15 @@ namespace geEngineSDK {
   class GE_CORE_EXPORT DiskFileSystem
   {
    public:
-    explicit DiskFileSystem(const Path& rootPath);
+    /**
+     * @brief Constructor.
+     * @param rootPath        Folder the paths of this file system are relative to.
+     * @param indexCachePath  Optional file where getAllFiles() saves the
+     *        contents of every folder. Later scans only read again the folders
+     *        whose modified time changed since then.
+     */
+    explicit DiskFileSystem(const Path& rootPath,
+                            const Path& indexCachePath = Path::BLANK);
     virtual ~DiskFileSystem() = default;
 
     bool
@@ -39,16 +47,40 @@ namespace geEngineSDK {
     SPtr<DataStream>
     open(const Path& path);
 
+    /**
+     * @brief Returns all the files under the root, relative to it. Each level
+     *        of folders is read in parallel on the TaskScheduler workers (or
+     *        on temporary threads if the scheduler is not running yet).
+     */
     Vector<Path>
     getAllFiles() const;
 
    private:
+    struct DirectoryEntry
+    {
+      String relativePath;  //Ends with a '/', empty for the root
+      time_t lastModifiedTime = 0;
+      Vector<String> files;
+      Vector<String> directories;
+    };
+
+    using DirectoryIndex = UnorderedMap<String, DirectoryEntry>;
+
+    void
+    _readDirectory(const String& relativePath,
+                   DirectoryIndex& cachedIndex,
+                   time_t cachedScanTime,
+                   DirectoryEntry& outEntry) const;
+
+    bool
+    _loadIndex(DirectoryIndex& outIndex, time_t& outScanTime) const;
+
     void
-    _recursiveCollectFiles(const Path& currentPath,
-                           const Path& relativePath,
-                           Vector<Path>& outFiles) const;
+    _saveIndex(const Vector<DirectoryEntry>& directories, time_t scanTime) const;
 
-     Path m_root;
+    Path m_root;
+    String m_rootString;
+    Path m_indexCachePath;
   };
 
 }
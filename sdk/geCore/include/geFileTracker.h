@@ -22,6 +22,7 @@
 #include "gePrerequisitesCore.h"
 
 #include <geEvent.h>
+#include <geFlatHashMap.h>
 #include <geModule.h>
 #include <geStringID.h>
 #include <geFileSystem.h>
@@ -153,7 +154,7 @@ namespace geEngineSDK {
     watchFiles();
 
     UnorderedMap<uint32, ChangeCallback> m_subscribersCallbacks;
-    UnorderedSet<TrackedFile, TrackedFileHash> m_filesToWatch;
+    FlatHashSet<TrackedFile, TrackedFileHash> m_filesToWatch;
 
     Thread m_monitoringThread;
     Mutex m_dataMutex;
@@ -0,0 +1,202 @@
+/*****************************************************************************/
+/**
+ * @file    geFramePipeline.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Overlaps the simulation of a frame with the render of the last.
+ *
+ * The simulation records the render commands of each frame, and a render
+ * thread replays them while the simulation goes on with the next frames, up
+ * to a configurable latency. The state that both threads need is handed over
+ * through FrameSnapshot, which keeps one copy for each frame in flight.
+ *
+ * @bug	    No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include <geThreading.h>
+
+namespace geEngineSDK {
+  using std::function;
+
+  class GE_CORE_EXPORT FramePipeline
+  {
+   public:
+    using Command = function<void()>;
+
+    static CONSTEXPR uint32 MAX_LATENCY = 3;
+
+    /**
+     * @param latency Frames the simulation can run ahead of the render.
+     *                With 0 the commands are replayed on the calling thread
+     *                when the frame is submitted, without a render thread.
+     */
+    explicit FramePipeline(uint32 latency);
+
+    /**
+     * @brief Renders the frames already submitted and stops the render
+     *        thread. The commands of a frame not submitted are dropped.
+     */
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+
+    FramePipeline&
+    operator=(const FramePipeline&) = delete;
+
+    /**
+     * @brief Records a command of the frame being simulated. The render
+     *        thread replays the commands of a frame in the order they were
+     *        recorded.
+     */
+    void
+    enqueue(Command command);
+
+    /**
+     * @brief Hands the commands of the frame to the render thread and starts
+     *        the next one. Blocks while the render is more than the latency
+     *        frames behind.
+     */
+    void
+    submitFrame();
+
+    /**
+     * @brief Waits until every submitted frame is rendered.
+     */
+    void
+    flush();
+
+    /**
+     * @brief Whether the calling thread replays the commands: the render
+     *        thread, or with a latency of 0 the thread that submits.
+     */
+    bool
+    isRenderThread() const;
+
+    /**
+     * @brief Lets the calling thread use the device until the next frame is
+     *        submitted. Returns at once on the render thread, while on the
+     *        simulation thread it waits for the frames in flight.
+     * @note  No other thread can use the device while frames are submitted.
+     */
+    void
+    waitForDevice();
+
+    uint32
+    getLatency() const {
+      return m_latency;
+    }
+
+    /**
+     * @brief Number of copies of the state in a FrameSnapshot, one for each
+     *        frame that can be in flight.
+     */
+    uint32
+    getNumSlots() const {
+      return m_latency + 1;
+    }
+
+    /**
+     * @brief Index of the frame being simulated.
+     */
+    uint64
+    getSimFrame() const {
+      return m_simFrame;
+    }
+
+    uint64
+    getNumRenderedFrames() const {
+      return m_renderedFrames.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Slot of the frame being simulated.
+     */
+    uint32
+    getSimSlot() const {
+      return cast::st<uint32>(m_simFrame % getNumSlots());
+    }
+
+    /**
+     * @brief Slot of the frame being rendered. Only meaningful inside the
+     *        commands, on the render thread.
+     */
+    uint32
+    getRenderSlot() const {
+      return m_renderSlot;
+    }
+
+   private:
+    struct Frame
+    {
+      uint64 index = 0;
+      Vector<Command> commands;
+    };
+
+    void
+    renderThreadMain();
+
+    void
+    replay(Frame& frame);
+
+    uint32 m_latency;
+    uint64 m_simFrame = 0;
+    uint32 m_renderSlot = 0;
+    Vector<Command> m_recording;
+
+    /**
+     * Command lists of rendered frames, reused to avoid growing new ones.
+     */
+    Vector<Vector<Command>> m_freeLists;
+    Deque<Frame> m_submitted;
+    std::atomic<uint64> m_renderedFrames{ 0 };
+    bool m_bStop = false;
+
+    Mutex m_mutex;
+    Signal m_frameSubmitted;
+    Signal m_frameRendered;
+    Thread m_renderThread;
+
+    /**
+     * The thread that created the pipeline, the one that submits the frames.
+     */
+    ThreadId m_simThread;
+  };
+
+  /**
+   * @brief State written by the simulation for the render of a frame, with a
+   *        copy for each frame in flight so the simulation of a frame never
+   *        writes what the render of an earlier one reads.
+   * @note  A slot holds what was written getNumSlots() frames ago, so the
+   *        simulation has to fill it completely every frame.
+   */
+  template<typename T>
+  class FrameSnapshot
+  {
+   public:
+    explicit FrameSnapshot(const FramePipeline& pipeline)
+      : m_pipeline(pipeline),
+        m_slots(pipeline.getNumSlots()) {}
+
+    T&
+    getSimState() {
+      return m_slots[m_pipeline.getSimSlot()];
+    }
+
+    const T&
+    getRenderState() const {
+      return m_slots[m_pipeline.getRenderSlot()];
+    }
+
+   private:
+    const FramePipeline& m_pipeline;
+    Vector<T> m_slots;
+  };
+}
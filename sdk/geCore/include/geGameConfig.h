@@ -21,22 +21,233 @@
 #include "geModule.h"
 #include "gePath.h"
 
+#include <geFlatHashMap.h>
+
 namespace geEngineSDK {
-  
+  class GameConfig;
+
+  /**
+   * @brief Storage for a single resolved configuration value.
+   *        Slots live in fixed size blocks owned by the GameConfig so their
+   *        address never changes once a ConfigVar points to them.
+   */
+  struct GE_CORE_EXPORT ConfigSlot
+  {
+    /**
+     * @brief Identifies the type a slot was resolved with.
+     */
+    enum class TYPE : uint8
+    {
+      kBool,
+      kInt32,
+      kUInt32,
+      kInt64,
+      kUInt64,
+      kFloat,
+      kDouble,
+      kString
+    };
+
+    union Value
+    {
+      bool b;
+      int32 i32;
+      uint32 u32;
+      int64 i64;
+      uint64 u64;
+      float f32;
+      double f64;
+    };
+
+    template<typename T>
+    static CONSTEXPR TYPE
+    typeOf() {
+      if CONSTEXPR(std::is_same_v<T, bool>) { return TYPE::kBool; }
+      else if CONSTEXPR(std::is_same_v<T, int32>) { return TYPE::kInt32; }
+      else if CONSTEXPR(std::is_same_v<T, uint32>) { return TYPE::kUInt32; }
+      else if CONSTEXPR(std::is_same_v<T, int64>) { return TYPE::kInt64; }
+      else if CONSTEXPR(std::is_same_v<T, uint64>) { return TYPE::kUInt64; }
+      else if CONSTEXPR(std::is_same_v<T, float>) { return TYPE::kFloat; }
+      else if CONSTEXPR(std::is_same_v<T, double>) { return TYPE::kDouble; }
+      else {
+        static_assert(std::is_same_v<T, String>,
+                      "Unsupported type for a configuration variable.");
+        return TYPE::kString;
+      }
+    }
+
+    template<typename T>
+    static T&
+    member(Value& value) {
+      if CONSTEXPR(std::is_same_v<T, bool>) { return value.b; }
+      else if CONSTEXPR(std::is_same_v<T, int32>) { return value.i32; }
+      else if CONSTEXPR(std::is_same_v<T, uint32>) { return value.u32; }
+      else if CONSTEXPR(std::is_same_v<T, int64>) { return value.i64; }
+      else if CONSTEXPR(std::is_same_v<T, uint64>) { return value.u64; }
+      else if CONSTEXPR(std::is_same_v<T, float>) { return value.f32; }
+      else { return value.f64; }
+    }
+
+    template<typename T>
+    static const T&
+    member(const Value& value) {
+      return member<T>(const_cast<Value&>(value));
+    }
+
+    template<typename T>
+    const T&
+    as() const {
+      if CONSTEXPR(std::is_same_v<T, String>) {
+        return m_string;
+      }
+      else {
+        return member<T>(m_value);
+      }
+    }
+
+    /**
+     * @brief Stores the default value of the slot. The current value is set
+     *        to the default until the slot is bound to the loaded data.
+     */
+    template<typename T>
+    void
+    setDefault(const T& value) {
+      if CONSTEXPR(std::is_same_v<T, String>) {
+        m_defaultString = value;
+        m_string = value;
+      }
+      else {
+        member<T>(m_default) = value;
+        m_value = m_default;
+      }
+    }
+
+    /**
+     * @brief Registers a callback that is called each time the value of this
+     *        slot changes on a load, reload or set.
+     */
+    HEvent
+    connect(function<void()> func);
+
+    String m_section;
+    String m_key;
+    TYPE m_type = TYPE::kString;
+    Value m_value{};
+    Value m_default{};
+    String m_string;
+    String m_defaultString;
+
+    /**
+     * @brief Created on the first connection so unobserved slots don't pay
+     *        for an event.
+     */
+    SPtr<Event<void()>> m_onChanged;
+  };
+
+  /**
+   * @brief Typed handle to a configuration value.
+   *        The handle is resolved once through GameConfig::getVar() and reading
+   *        it afterwards is a plain load from the slot, with no string
+   *        operations or parsing involved.
+   * @note  Values are updated by GameConfig::load(), reload() and set(). Those
+   *        should be called from the same thread that reads the values.
+   */
+  template<typename T>
+  class ConfigVar
+  {
+   public:
+    ConfigVar() = default;
+
+    GE_NODISCARD const T&
+    get() const {
+      GE_ASSERT(nullptr != m_slot && "Reading an unresolved ConfigVar.");
+      return m_slot->as<T>();
+    }
+
+    operator const T&() const {
+      return get();
+    }
+
+    const T&
+    operator*() const {
+      return get();
+    }
+
+    GE_NODISCARD bool
+    isValid() const {
+      return nullptr != m_slot;
+    }
+
+    /**
+     * @brief Registers a callback that gets notified when the value changes.
+     */
+    HEvent
+    onChanged(function<void()> func) const {
+      GE_ASSERT(nullptr != m_slot && "Connecting to an unresolved ConfigVar.");
+      return m_slot->connect(std::move(func));
+    }
+
+   private:
+    friend class GameConfig;
+
+    explicit ConfigVar(ConfigSlot* slot) : m_slot(slot) {}
+
+    ConfigSlot* m_slot = nullptr;
+  };
+
   class GE_CORE_EXPORT GameConfig final : public Module<GameConfig>
   {
    public:
     GameConfig() = default;
-    ~GameConfig() override = default;
+    ~GameConfig() override;
 
+    /**
+     * @brief Parses a configuration file and adds its values to the
+     *        configuration. Values from later files override earlier ones.
+     *        All the resolved variables are updated and notified if changed.
+     */
     bool
     load(const Path& filePath);
 
+    /**
+     * @brief Clears the configuration data and loads again every file that
+     *        was loaded before, in the same order.
+     *        Variables whose value changed are notified, then onReloaded is
+     *        triggered.
+     */
+    bool
+    reload();
+
+    /**
+     * @brief Resolves a typed handle to a configuration value. The section and
+     *        key are case insensitive.
+     *        This does the string work once, keep the handle around and read
+     *        from it instead of calling get() repeatedly.
+     * @note  Resolving the same section, key and type more than once returns
+     *        the same slot, and the default of the first resolve is kept.
+     */
+    template<typename T>
+    ConfigVar<T>
+    getVar(const String& section, const String& key, const T& defaultVal) {
+      bool bCreated = false;
+      ConfigSlot* slot = resolveSlot(section, key, ConfigSlot::typeOf<T>(), bCreated);
+      if (bCreated) {
+        slot->setDefault(defaultVal);
+        bindSlot(*slot);
+      }
+      return ConfigVar<T>(slot);
+    }
+
+    /**
+     * @brief Triggered after a reload, once every variable has been updated.
+     */
+    Event<void()> onReloaded;
+
    private:
     template<typename T>
-    typename std::enable_if<!std::is_same<T, String>::value &&
-                            !std::is_same<T, bool>::value,
-                            T>::type
+    static typename std::enable_if<!std::is_same<T, String>::value &&
+                                   !std::is_same<T, bool>::value,
+                                   T>::type
     readFromStream(StringStream& str, const String&, const T& defaultVal) {
       T ret = defaultVal;
       str >> ret;
@@ -44,8 +255,8 @@ namespace geEngineSDK {
     }
 
     template<typename T>
-    typename std::enable_if<std::is_same<T, bool>::value,
-                            T>::type
+    static typename std::enable_if<std::is_same<T, bool>::value,
+                                   T>::type
     readFromStream(StringStream& str, const String&, const T& defaultVal) {
       T ret = defaultVal;
       str >> std::boolalpha >> ret;
@@ -53,13 +264,36 @@ namespace geEngineSDK {
     }
 
     template<typename T>
-    typename std::enable_if<std::is_same<T, String>::value,
-                            T>::type
+    static typename std::enable_if<std::is_same<T, String>::value,
+                                   T>::type
     readFromStream(StringStream&, const String& rawValue, const T&) {
       return rawValue;
     }
 
+    /**
+     * @brief Converts the text of a value, for get() and the variables alike.
+     */
+    template<typename T>
+    static T
+    parseValue(const String& rawValue, const T& defaultVal) {
+      StringStream str(rawValue);
+      return readFromStream<T>(str, rawValue, defaultVal);
+    }
+
+    /**
+     * @brief Parses the raw text into the typed value of a slot, or resets
+     *        it to the default when there is no text for it.
+     * @return true if the stored value changed.
+     */
+    template<typename T>
+    static bool
+    bindValue(ConfigSlot& slot, const String* rawValue);
+
    public:
+    /**
+     * @brief Reads and parses a configuration value on each call.
+     * @note  Prefer getVar() for values that are read more than once.
+     */
     template <typename T>
     T
     get(const String& section, const String& key, const T& defaultVal) {
@@ -72,14 +306,17 @@ namespace geEngineSDK {
       if (sectionIt != m_configData.end()) {
         auto keyIt = sectionIt->second.find(uppKey);
         if (keyIt != sectionIt->second.end()) {
-          StringStream str(keyIt->second);
-          return readFromStream<T>(str, keyIt->second, defaultVal);
+          return parseValue<T>(keyIt->second, defaultVal);
         }
       }
 
       return defaultVal;
     }
     
+    /**
+     * @brief Changes a configuration value. Resolved variables for the same
+     *        section and key are updated and notified if their value changed.
+     */
     template <typename T>
     void
     set(const String& section, const String& key, const T& value) {
@@ -87,44 +324,48 @@ namespace geEngineSDK {
       String uppKey = key;
       StringUtil::toUpperCase(uppSection);
       StringUtil::toUpperCase(uppKey);
-#if USING(GE_CPP17_OR_LATER)
       if CONSTEXPR(std::is_same_v<T, bool>) {
-        m_configData[uppSection][key] = toString(value, false);
+        m_configData[uppSection][uppKey] = toString(value, false);
       }
       else if CONSTEXPR(std::is_same_v<T, String>) {
-        m_configData[uppSection][key] = value;
+        m_configData[uppSection][uppKey] = value;
       }
       else {
-#endif
-        m_configData[uppSection][key] = toString(value);
-#if USING(GE_CPP17_OR_LATER)
+        m_configData[uppSection][uppKey] = toString(value);
       }
-#endif
-    }
 
-#if !USING(GE_CPP17_OR_LATER)
-    //Specialization for bool type
-    template <>
-    void
-    set<bool>(const String& section, const String& key, const bool& value) {
-      String uppSection = section;
-      String uppKey = key;
-      StringUtil::toUpperCase(uppSection);
-      StringUtil::toUpperCase(uppKey);
-      m_configData[uppSection][key] = toString(value, false);
+      refreshSlots(&uppSection, &uppKey);
     }
 
-    //Specialization for String type
-    template <>
+   private:
+    /**
+     * @brief Parses a single file into m_configData in a single pass.
+     */
+    bool
+    parseFile(const Path& filePath);
+
+    /**
+     * @brief Finds or creates the slot for a section, key and type.
+     */
+    ConfigSlot*
+    resolveSlot(const String& section,
+                const String& key,
+                ConfigSlot::TYPE type,
+                bool& bCreated);
+
+    /**
+     * @brief Binds a slot to the current configuration data.
+     * @return true if the value of the slot changed.
+     */
+    bool
+    bindSlot(ConfigSlot& slot);
+
+    /**
+     * @brief Binds again all the slots (or only the ones matching a section
+     *        and key) and notifies the ones whose value changed.
+     */
     void
-    set<String>(const String& section, const String& key, const String& value) {
-      String uppSection = section;
-      String uppKey = key;
-      StringUtil::toUpperCase(uppSection);
-      StringUtil::toUpperCase(uppKey);
-      m_configData[uppSection][key] = value;
-    }
-#endif
+    refreshSlots(const String* section = nullptr, const String* key = nullptr);
 
    private:
     /**
@@ -134,5 +375,28 @@ namespace geEngineSDK {
      *        and value is the configuration value.
      */
     UnorderedMap<String, UnorderedMap<String, String>> m_configData;
+
+    /**
+     * @brief Number of slots on each block of m_slotBlocks.
+     */
+    static CONSTEXPR uint32 SLOTS_PER_BLOCK = 64;
+
+    /**
+     * @brief Flat storage for the resolved variables. Blocks are never
+     *        reallocated so the handles can keep pointers to their slots.
+     */
+    Vector<ConfigSlot*> m_slotBlocks;
+    uint32 m_numSlots = 0;
+
+    /**
+     * @brief Maps "SECTION.KEY" plus the type to the slot index. Only used
+     *        when resolving a handle.
+     */
+    FlatStringMap<uint32> m_slotLookup;
+
+    /**
+     * @brief Files loaded so far, in order. Used by reload().
+     */
+    Vector<Path> m_loadedFiles;
   };
 }
@@ -414,6 +414,12 @@ namespace geEngineSDK {
       UINT2 = 22,       // 2D 32-bit signed integer value
       UINT3 = 23,       // 3D 32-bit signed integer value
       UBYTE4_NORM = 24, // 4D 8-bit uint value normalized to [0, 1] range
+      HALF2 = 25,       // 2D 16-bit floating point value
+      HALF4 = 26,       // 4D 16-bit floating point value
+      SHORT2_NORM = 27, // 2D 16-bit int value normalized to [-1, 1] range
+      SHORT4_NORM = 28, // 4D 16-bit int value normalized to [-1, 1] range
+      USHORT2_NORM = 29, // 2D 16-bit uint value normalized to [0, 1] range
+      USHORT4_NORM = 30, // 4D 16-bit uint value normalized to [0, 1] range
       COUNT,            // Keep at end before UNKNOWN
       UNKNOWN = 0xffff
     };
@@ -26,6 +26,8 @@
 namespace geEngineSDK {
   using std::function;
 
+  struct TextureMipChain;
+
   namespace CODEC_TYPE {
     enum E {
       IMAGE = 0,      // Codec for images
@@ -44,6 +46,9 @@ namespace geEngineSDK {
   #define CODEC_CANEXPORT_FN_NAME    "CodecCanExport"
   #define CODEC_IMPORT_FN_NAME       "CodecImport"
   #define CODEC_EXPORT_FN_NAME       "CodecExport"
+  #define CODEC_IMPORTBATCH_FN_NAME  "CodecImportBatch"
+  #define CODEC_READMIPCHAIN_FN_NAME "CodecReadMipChain"
+  #define CODEC_IMPORTMIPS_FN_NAME   "CodecImportMips"
 
   using CodecTypeFn = CODEC_TYPE::E(void);
   using CodecTypePtr = CODEC_TYPE::E(*)(void);
@@ -76,6 +81,27 @@ namespace geEngineSDK {
   using CodecExportFn = bool(const SPtr<Resource>& resource, const Path& filePath);
   using CodecExportPtr = bool (*)(const SPtr<Resource>& resource, const Path& filePath);
 
+  using CodecImportBatchFn = void(const Vector<Path>& filePaths,
+                                  bool useCacheIfAvailable,
+                                  Vector<SPtr<Resource>>& outRes);
+  using CodecImportBatchPtr = void(*)(const Vector<Path>& filePaths,
+                                      bool useCacheIfAvailable,
+                                      Vector<SPtr<Resource>>& outRes);
+
+  using CodecReadMipChainFn = bool(const Path& filePath, TextureMipChain& outChain);
+  using CodecReadMipChainPtr = bool(*)(const Path& filePath, TextureMipChain& outChain);
+
+  using CodecImportMipsFn = void(const Path& filePath,
+                                 const Vector<uint8>& fileData,
+                                 uint64 skippedSize,
+                                 uint32 firstMip,
+                                 SPtr<Resource>& outRes);
+  using CodecImportMipsPtr = void(*)(const Path& filePath,
+                                     const Vector<uint8>& fileData,
+                                     uint64 skippedSize,
+                                     uint32 firstMip,
+                                     SPtr<Resource>& outRes);
+
   class GE_CORE_EXPORT ICodec
   {
    public:
@@ -93,6 +119,28 @@ namespace geEngineSDK {
     function<CodecCanExportFn> canExport;
     function<CodecImportFn> importResource;
     function<CodecExportFn> exportResource;
+
+    /**
+     * @brief Optional. Imports several files at once so the codec can decode
+     *        them in parallel. Empty if the codec doesn't export it.
+     */
+    function<CodecImportBatchFn> importResources;
+
+    /**
+     * @brief Optional. Reads the mip chain of a texture from its header,
+     *        without its pixels, so the TextureStreamer can register it.
+     */
+    function<CodecReadMipChainFn> readMipChain;
+
+    /**
+     * @brief Optional. Imports the levels of a texture from firstMip on, as
+     *        a texture whose top level is firstMip. The file is already read,
+     *        so only the texture is created on the calling thread. The data
+     *        holds the headers, then the ranges of the file with those
+     *        levels one after the other (see TextureMipChain), the first one
+     *        skippedSize bytes after the headers.
+     */
+    function<CodecImportMipsFn> importMips;
   };
 
   GE_LOG_CATEGORY(ICodec, 700);
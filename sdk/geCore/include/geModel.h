@@ -43,6 +43,21 @@ namespace geEngineSDK {
     Vector<Matrix4> m_boneOffsets;
   };
 
+  /**
+   * @brief A simplified version of a SubMesh. It reuses the vertices of the
+   *        SubMesh and only has its own range in the index buffer.
+   */
+  struct SubMeshLod
+  {
+    uint32 m_firstIndex = 0;
+    uint32 m_indexCount = 0;
+
+    /**
+     * How far the surface moved from the full detail one, in model units.
+     */
+    float m_error = 0.0f;
+  };
+
   /**
    * @brief Describes a drawable range inside a mesh buffer.
    *
@@ -61,6 +76,22 @@ namespace geEngineSDK {
     bool
     isValid() const;
 
+    /**
+     * @brief Picks the coarsest LOD whose error covers less than
+     *        maxPixelError pixels on screen.
+     * @param pixelsPerUnit How many pixels a model unit covers where the
+     *        submesh is drawn (see Camera::getPixelsPerUnit).
+     * @return 0 for the full detail submesh, i for m_lods[i - 1].
+     */
+    uint32
+    selectLod(float pixelsPerUnit, float maxPixelError = 1.0f) const;
+
+    /**
+     * @brief The index range to draw for a LOD returned by selectLod().
+     */
+    void
+    getLodIndexRange(uint32 lod, uint32& outFirstIndex, uint32& outIndexCount) const;
+
    public:
     String m_name;
 
@@ -79,6 +110,27 @@ namespace geEngineSDK {
 
     AABox m_bounds = AABox::EMPTY;
     Sphere m_boundingSphere;
+
+    /**
+     * Rebuilds the positions when the vertex buffer stores them as 16-bit
+     * normalized values (USHORT4_NORM):
+     * position = m_positionOffset + m_positionScale * packed.xyz.
+     * Identity for full float positions.
+     */
+    Vector3 m_positionScale = Vector3::UNIT;
+    Vector3 m_positionOffset = Vector3::ZERO;
+
+    /**
+     * Simplified versions of the submesh, from the most to the least detailed.
+     */
+    Vector<SubMeshLod> m_lods;
+
+    /**
+     * Coarse copy of the triangles kept on the CPU for the OcclusionCuller,
+     * in the same space as m_bounds. Empty when the submesh doesn't occlude.
+     */
+    Vector<Vector3> m_occluderPositions;
+    Vector<uint32> m_occluderIndices;
   };
 
   struct NodeSubMeshRef
@@ -17,8 +17,9 @@
  * Includes
  */
 /*****************************************************************************/
-#include "geComponent.h"
+#include "geActor.h"
 #include "geModel.h"
+#include "geMaterial.h"
 
 namespace geEngineSDK {
   class ModelComponent : public Component
@@ -34,6 +35,9 @@ namespace geEngineSDK {
     void
     setModel(const SPtr<Model>& model) {
       m_model = model;
+      if (m_owner) {
+        m_owner->markBoundsDirty();
+      }
     }
 
     const SPtr<Model>&
@@ -22,6 +22,7 @@
 #include "geZipFileSystem.h"
 #include "geDiskFileSystem.h"
 
+#include <geFlatHashMap.h>
 #include <geModule.h>
 
 namespace geEngineSDK {
@@ -54,6 +55,14 @@ namespace geEngineSDK {
     Path
     getRealPath(const Path& virtualPath) const;
 
+    /**
+     * @brief Updates the index entry of a file that was created or deleted on
+     *        one of the mounted disks after it was mounted.
+     * @param virtualPath The path of the file relative to the mount roots.
+     */
+    void
+    refresh(const Path& virtualPath);
+
     void
     clear();
 
@@ -75,7 +84,11 @@ namespace geEngineSDK {
     Vector<SPtr<ZipFileSystem>> m_zipMounts;
     Vector<SPtr<DiskFileSystem>> m_diskMounts;
 
-    UnorderedMap<String, FileEntry> m_fileIndex;
+    /**
+     * @brief Files by virtual path. Paths hash and compare case insensitive
+     *        without building strings, so lookups don't allocate.
+     */
+    FlatHashMap<Path, FileEntry> m_fileIndex;
   };
 
 }
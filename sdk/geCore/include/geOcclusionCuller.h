@@ -0,0 +1,239 @@
+/*****************************************************************************/
+/**
+ * @file    geOcclusionCuller.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Software occlusion culling with a low resolution depth buffer.
+ *
+ * Software occlusion culling with a low resolution depth buffer. The
+ * occluders (coarse copies of the submeshes kept on the CPU) are rasterized
+ * four pixels at a time into a small depth buffer, split in bins that run on
+ * the TaskScheduler workers. Every tile of the buffer keeps its farthest
+ * depth, so most occludee boxes are resolved without reading the pixels.
+ *
+ * It doesn't touch the GPU, so it culls the same with every render API.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include "geSceneCuller.h"
+#include "geModel.h"
+#include "geCamera.h"
+#include <geBox.h>
+#include <geVector4.h>
+
+namespace geEngineSDK {
+
+  class GE_CORE_EXPORT OcclusionCuller
+  {
+   public:
+    /**
+     * @brief Size of the tiles that keep their farthest depth.
+     */
+    static CONSTEXPR uint32 TILE_SIZE = 8;
+
+    /**
+     * @brief Size of the screen regions rasterized by one worker.
+     */
+    static CONSTEXPR uint32 BIN_WIDTH = 64;
+    static CONSTEXPR uint32 BIN_HEIGHT = 32;
+
+    /**
+     * @brief Occluder triangles set up by a worker each time it takes more
+     *        work.
+     */
+    static CONSTEXPR uint32 CHUNK_SIZE = 1024;
+
+    /**
+     * @brief The size of the depth buffer is rounded up to whole bins.
+     */
+    explicit OcclusionCuller(uint32 width = 320, uint32 height = 192);
+
+    /**
+     * @brief Clears the occluders and the depth buffer for a new view.
+     */
+    void
+    beginFrame(const Matrix4& viewProj);
+
+    void
+    beginFrame(Camera& camera) {
+      beginFrame(camera.getViewMatrix() * camera.getProjMatrix());
+    }
+
+    /**
+     * @brief Queues a triangle list to be rasterized by render(). The
+     *        positions and indices must stay alive until then.
+     */
+    void
+    addOccluder(const Vector3* positions,
+                const uint32* indices,
+                uint32 numIndices,
+                const Matrix4& world);
+
+    /**
+     * @brief Queues the occluder geometry of a submesh, if it has any.
+     */
+    void
+    addOccluder(const SubMesh& subMesh, const Matrix4& world);
+
+    /**
+     * @brief Queues the occluder geometry of the submeshes that cover at least
+     *        minScreenArea of the screen (0 to 1), so the small ones don't
+     *        cost more than what they hide.
+     */
+    void
+    addOccluders(const Vector<VisibleSubMesh>& visible, float minScreenArea = 0.001f);
+
+    /**
+     * @brief Rasterizes the queued occluders.
+     */
+    void
+    render();
+
+    /**
+     * @brief Tests a world space box against the rendered occluders.
+     * @return false when every pixel the box covers is behind an occluder.
+     *         Boxes that cross the near plane are always visible.
+     */
+    bool
+    isVisible(const AABox& worldBox) const;
+
+    /**
+     * @brief Removes the submeshes hidden behind the rendered occluders,
+     *        keeping the order of the rest.
+     */
+    void
+    cull(Vector<VisibleSubMesh>& inOutVisible);
+
+    uint32
+    getWidth() const {
+      return m_width;
+    }
+
+    uint32
+    getHeight() const {
+      return m_height;
+    }
+
+    /**
+     * @brief Depth (0 near, 1 far) of a pixel, with y going down.
+     */
+    float
+    getDepth(uint32 x, uint32 y) const {
+      GE_ASSERT(x < m_width && y < m_height);
+      return m_depth[y * m_width + x];
+    }
+
+    /**
+     * @brief Triangles rasterized by the last render(), after clipping.
+     */
+    uint32
+    getNumTriangles() const {
+      return m_numTriangles;
+    }
+
+   private:
+    struct Occluder
+    {
+      const Vector3* positions;
+      const uint32* indices;
+      uint32 firstTriangle;
+      Matrix4 worldViewProj;
+    };
+
+    /**
+     * A triangle in pixel space: three edge functions that are not negative
+     * inside of it, the plane of its depth and the pixels it may cover.
+     */
+    struct ScreenTriangle
+    {
+      float edgeA[3];
+      float edgeB[3];
+      float edgeC[3];
+      float depthA;
+      float depthB;
+      float depthC;
+      int32 minX;
+      int32 minY;
+      int32 maxX;
+      int32 maxY;
+    };
+
+    /**
+     * Up to four triangles that need no clipping, in clip space and one lane
+     * per triangle, set up together.
+     */
+    struct TriangleBatch
+    {
+      float x[3][4];
+      float y[3][4];
+      float z[3][4];
+      float w[3][4];
+      uint32 size = 0;
+    };
+
+    /**
+     * @brief Sets the pixels a triangle may cover from the bounds of its
+     *        vertices.
+     * @return false if it covers none.
+     */
+    bool
+    setupBounds(float minX,
+                float minY,
+                float maxX,
+                float maxY,
+                ScreenTriangle& triangle) const;
+
+    void
+    setupTriangle(const Vector4& v0,
+                  const Vector4& v1,
+                  const Vector4& v2,
+                  Vector<ScreenTriangle>& outTriangles) const;
+
+    /**
+     * @brief Sets up the triangles of the batch, four at a time where SSE is
+     *        available, and empties it.
+     */
+    void
+    setupBatch(TriangleBatch& batch, Vector<ScreenTriangle>& outTriangles) const;
+
+    /**
+     * @brief Adds the triangle to the batch if it needs no clipping, or sets
+     *        up the pieces inside of the clip planes once the batch is done.
+     */
+    void
+    clipTriangle(const Occluder& occluder,
+                 uint32 triangle,
+                 TriangleBatch& batch,
+                 Vector<ScreenTriangle>& outTriangles) const;
+
+    void
+    renderBin(uint32 bin);
+
+    uint32 m_width;
+    uint32 m_height;
+    uint32 m_binsX;
+    uint32 m_binsY;
+    uint32 m_tilesX;
+
+    Matrix4 m_viewProj;
+    uint32 m_numOccluderTriangles = 0;
+    uint32 m_numTriangles = 0;
+
+    //Kept between frames so the per frame work doesn't allocate
+    Vector<Occluder> m_occluders;
+    Vector<Vector<ScreenTriangle>> m_chunkTriangles;
+    Vector<Vector<const ScreenTriangle*>> m_bins;
+    Vector<float> m_depth;
+    Vector<float> m_tileMaxDepth;
+    Vector<uint8> m_visibleFlags;
+  };
+}
@@ -22,6 +22,7 @@
 /*****************************************************************************/
 #include "gePrerequisitesCore.h"
 #include "geGraphicsInterfaces.h"
+#include <geFlatHashMap.h>
 #include <geModule.h>
 
 namespace geEngineSDK {
@@ -197,10 +198,10 @@ namespace geEngineSDK {
     _createDefaultDepthStates();
 
    private:
-    UnorderedMap<uint32, SPtr<SamplerState>> m_samplerStates;
-    UnorderedMap<uint32, SPtr<BlendState>> m_blendStates;
-    UnorderedMap<uint32, SPtr<RasterizerState>> m_rasterStates;
-    UnorderedMap<uint32, SPtr<DepthStencilState>> m_depthStates;
+    FlatHashMap<uint32, SPtr<SamplerState>> m_samplerStates;
+    FlatHashMap<uint32, SPtr<BlendState>> m_blendStates;
+    FlatHashMap<uint32, SPtr<RasterizerState>> m_rasterStates;
+    FlatHashMap<uint32, SPtr<DepthStencilState>> m_depthStates;
 
     uint32 m_currentSamplerState = 0;
     uint32 m_currentBlendState = 0;
@@ -21,6 +21,7 @@
 /*****************************************************************************/
 #include "gePrerequisitesCore.h"
 #include "geResource.h"
+#include "geResourceRegistry.h"
 
 #include <geModule.h>
 #include <geStringID.h>
@@ -52,7 +53,7 @@ namespace geEngineSDK {
       const bool bUsingFallback = !resource;
 
       if (!resource) {
-        resource = _getFallbackResource(filePath);
+        resource = _getManagedFallbackResource(filePath);
       }
 
       if (!resource) {
@@ -83,43 +84,51 @@ namespace geEngineSDK {
       return nullptr != _getLoadedResource(_resolveResourceID(filePath));
     }
 
+    /**
+     * @brief Unloads every resource nobody else holds.
+     */
     void
     garbageCollector() {
-      Lock lock(m_mutex);
-      for (auto it = m_loadedResources.begin(); it != m_loadedResources.end();) {
-        const ResourcePtr& resource = it->second;
-
-        if (!resource) {
-          it = m_loadedResources.erase(it);
-          continue;
-        }
-
-        if (_keepManagedResource(resource)) {
-          ++it;
-          continue;
-        }
-
-        if (1 == resource.use_count()) {
-          it = m_loadedResources.erase(it);
-          continue;
-        }
+      m_registry.evictUnused([this](const ResourcePtr& resource) {
+        return _keepManagedResource(resource);
+      });
+    }
 
-        ++it;
-      }
+    /**
+     * @brief One step of the incremental garbage collection, to be called
+     *        every frame. While the resources use more memory than the
+     *        budget, unloads the least recently used ones nobody else holds
+     *        among the next maxScanned.
+     * @return The number of resources unloaded.
+     */
+    uint32
+    collectGarbage(uint32 maxScanned = 64) {
+      return m_registry.collect(maxScanned, [this](const ResourcePtr& resource) {
+        return _keepManagedResource(resource);
+      });
     }
 
+    /**
+     * @brief Memory used by the loaded resources, as measured when they were
+     *        stored.
+     */
     SIZE_T
     getMemoryUsage() const {
-      Lock lock(m_mutex);
+      return m_registry.getMemoryUsage();
+    }
 
-      SIZE_T totalSize = 0;
-      for (const auto& resourceEntry : m_loadedResources) {
-        if (resourceEntry.second) {
-          totalSize += _getManagedResourceMemoryUsage(resourceEntry.second);
-        }
-      }
+    SIZE_T
+    getMemoryBudget() const {
+      return m_registry.getMemoryBudget();
+    }
 
-      return totalSize;
+    /**
+     * @brief Memory the loaded resources can use before collectGarbage()
+     *        unloads them. No limit by default.
+     */
+    void
+    setMemoryBudget(SIZE_T budget) {
+      m_registry.setMemoryBudget(budget);
     }
 
    protected:
@@ -130,14 +139,7 @@ namespace geEngineSDK {
 
     ResourcePtr
     _getLoadedResource(uint32 resourceID) const {
-      Lock lock(m_mutex);
-
-      auto it = m_loadedResources.find(resourceID);
-      if (it != m_loadedResources.end()) {
-        return it->second;
-      }
-
-      return nullptr;
+      return m_registry.find(resourceID);
     }
 
     void
@@ -149,19 +151,20 @@ namespace geEngineSDK {
     void
     _registerLoadedResource(uint32 resourceID,
                             const ResourcePtr& resource) {
-      Lock lock(m_mutex);
-      m_loadedResources[resourceID] = resource;
+      m_registry.update(resourceID,
+                        [&resource](const ResourcePtr&) { return resource; },
+                        [this](const ResourcePtr& managedResource) {
+                          return _getManagedResourceMemoryUsage(managedResource);
+                        });
     }
 
     void
     _clearLoadedResources() {
-      Lock lock(m_mutex);
-      m_loadedResources.clear();
+      m_registry.clear();
     }
 
    protected:
-    UnorderedMap<uint32, ResourcePtr> m_loadedResources;
-    mutable Mutex m_mutex;
+    ResourceRegistry<TResource> m_registry;
 
    private:
     TDerived&
@@ -198,7 +201,7 @@ namespace geEngineSDK {
     }
 
     ResourcePtr
-    _getFallbackResource(const Path& filePath) const {
+    _getManagedFallbackResource(const Path& filePath) const {
       if constexpr (requires(const TDerived& manager, const Path& path) {
         manager._getFallbackResource(path);
       }) {
@@ -292,24 +295,24 @@ namespace geEngineSDK {
         return nullptr;
       }
 
-      Lock lock(m_mutex);
-      auto it = m_loadedResources.find(resourceID);
-      if (it == m_loadedResources.end() || !it->second) {
-        m_loadedResources[resourceID] = resource;
-        return resource;
-      }
+      auto resolve = [&](const ResourcePtr& current) -> ResourcePtr {
+        if (!current || current == resource) {
+          return resource;
+        }
 
-      if (it->second == resource) {
-        return it->second;
-      }
+        if (_reuseManagedResource(current, resource, bReload)) {
+          current->moveFrom(*resource);
+          return current;
+        }
 
-      if (_reuseManagedResource(it->second, resource, bReload)) {
-        it->second->moveFrom(*resource);
-        return it->second;
-      }
+        return resource;
+      };
 
-      it->second = resource;
-      return resource;
+      return m_registry.update(resourceID,
+                               resolve,
+                               [this](const ResourcePtr& managedResource) {
+                                 return _getManagedResourceMemoryUsage(managedResource);
+                               });
     }
   };
 
@@ -0,0 +1,432 @@
+/*****************************************************************************/
+/**
+ * @file    geResourceRegistry.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Loaded resources by id, read without locks.
+ *
+ * Loaded resources by id (the StringID of their path), read without locks.
+ * The resources are spread on shards, and each shard publishes an immutable
+ * snapshot of its map: writers copy it, change the copy and swap it in, and
+ * readers only announce themselves on a counter of the shard so the old
+ * snapshot is freed once no reader can be using it.
+ *
+ * The memory used by the resources is kept as a running total, and once it
+ * goes over a budget the least recently used resources nobody else holds are
+ * evicted a few at a time, so the work is spread across frames.
+ *
+ * @bug	    No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+
+#include <geFlatHashMap.h>
+#include <geNonCopyable.h>
+
+namespace geEngineSDK {
+  using std::atomic;
+
+  template<class TResource>
+  class ResourceRegistry : public INonCopyable
+  {
+   public:
+    using ResourcePtr = SPtr<TResource>;
+
+    static CONSTEXPR uint32 NUM_SHARDS = 16;
+
+    ResourceRegistry() {
+      for (auto& shard : m_shards) {
+        shard.snapshot.store(ge_new<Snapshot>(), std::memory_order_relaxed);
+      }
+    }
+
+    ~ResourceRegistry() {
+      for (auto& shard : m_shards) {
+        ge_delete(const_cast<Snapshot*>(shard.snapshot.load(std::memory_order_relaxed)));
+      }
+    }
+
+    /**
+     * @brief The resource with the id, or null. Doesn't take any lock, and
+     *        marks the resource as used now.
+     */
+    ResourcePtr
+    find(uint32 id) const {
+      const Shard& shard = getShard(id);
+      ReadScope scope(shard);
+
+      const Snapshot* snapshot = shard.snapshot.load(std::memory_order_seq_cst);
+      auto it = snapshot->entries.find(id);
+      if (it == snapshot->entries.end()) {
+        return nullptr;
+      }
+
+      const Entry& entry = *it->second;
+      if (entry.lastUsed.load(std::memory_order_relaxed) != getClock()) {
+        entry.lastUsed.store(getClock(), std::memory_order_relaxed);
+      }
+      return entry.resource;
+    }
+
+    /**
+     * @brief Replaces the resource with the id by what the resolve function
+     *        returns for the current one (null if there's none). Returning
+     *        null removes it.
+     * @param measure Returns the memory used by a resource.
+     * @note  Both functions are called with the shard locked for writing.
+     */
+    template<typename Resolve, typename Measure>
+    ResourcePtr
+    update(uint32 id, Resolve&& resolve, Measure&& measure) {
+      Shard& shard = getShard(id);
+      Lock lock(shard.writeMutex);
+
+      const Snapshot* current = shard.snapshot.load(std::memory_order_relaxed);
+      auto it = current->entries.find(id);
+      const SPtr<Entry> previous = it != current->entries.end() ? it->second : nullptr;
+      ResourcePtr resource = resolve(previous ? previous->resource : nullptr);
+
+      //The same resource (maybe with new contents) is only measured again
+      if (previous && resource && resource == previous->resource) {
+        const SIZE_T memoryUsage = measure(resource);
+        m_memoryUsage.fetch_add(memoryUsage, std::memory_order_relaxed);
+        m_memoryUsage.fetch_sub(previous->memoryUsage.exchange(memoryUsage),
+                                std::memory_order_relaxed);
+        previous->lastUsed.store(getClock(), std::memory_order_relaxed);
+        return resource;
+      }
+
+      if (!previous && !resource) {
+        return nullptr;
+      }
+
+      Snapshot* next = ge_new<Snapshot>(*current);
+      if (previous) {
+        next->entries.erase(id);
+        removeUsage(*previous);
+      }
+
+      if (resource) {
+        auto entry = ge_shared_ptr_new<Entry>();
+        entry->resource = resource;
+        entry->memoryUsage.store(measure(resource), std::memory_order_relaxed);
+        entry->lastUsed.store(getClock(), std::memory_order_relaxed);
+        m_memoryUsage.fetch_add(entry->memoryUsage.load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+        m_numEntries.fetch_add(1, std::memory_order_relaxed);
+        next->entries[id] = std::move(entry);
+      }
+
+      publish(shard, next);
+      return resource;
+    }
+
+    void
+    remove(uint32 id) {
+      update(id,
+             [](const ResourcePtr&) { return ResourcePtr(); },
+             [](const ResourcePtr&) { return SIZE_T(0); });
+    }
+
+    void
+    clear() {
+      for (auto& shard : m_shards) {
+        Lock lock(shard.writeMutex);
+        const Snapshot* current = shard.snapshot.load(std::memory_order_relaxed);
+        for (const auto& entry : current->entries) {
+          removeUsage(*entry.second);
+        }
+        publish(shard, ge_new<Snapshot>());
+      }
+    }
+
+    /**
+     * @brief Evicts every resource not held outside the registry, whatever
+     *        the budget.
+     * @param keep Returns true for the resources that must stay loaded.
+     * @return The number of resources evicted.
+     */
+    template<typename Keep>
+    uint32
+    evictUnused(Keep&& keep) {
+      uint32 numEvicted = 0;
+      for (auto& shard : m_shards) {
+        Lock lock(shard.writeMutex);
+        const Snapshot* current = shard.snapshot.load(std::memory_order_relaxed);
+
+        Vector<uint32> evicted;
+        for (const auto& entry : current->entries) {
+          if (isEvictable(*entry.second, keep)) {
+            evicted.push_back(entry.first);
+          }
+        }
+
+        numEvicted += removeEntries(shard, evicted);
+      }
+      return numEvicted;
+    }
+
+    /**
+     * @brief One step of the incremental garbage collection, meant to be
+     *        called once a frame. While over the memory budget, looks at the
+     *        next shards until about maxScanned resources are seen, and
+     *        evicts the least recently used of those nobody else holds until
+     *        the usage is back under the budget.
+     * @param keep Returns true for the resources that must stay loaded.
+     * @return The number of resources evicted.
+     * @note  Must always be called from the same thread.
+     */
+    template<typename Keep>
+    uint32
+    collect(uint32 maxScanned, Keep&& keep) {
+      //Every step is a tick of the clock that dates the uses
+      m_clock.fetch_add(1, std::memory_order_relaxed);
+
+      const SIZE_T memoryUsage = getMemoryUsage();
+      const SIZE_T memoryBudget = getMemoryBudget();
+      if (memoryUsage <= memoryBudget) {
+        return 0;
+      }
+
+      struct Candidate
+      {
+        uint64 lastUsed;
+        SIZE_T memoryUsage;
+        uint32 id;
+      };
+      Vector<Candidate> candidates;
+
+      uint32 numScanned = 0;
+      for (uint32 i = 0; i < NUM_SHARDS && numScanned < maxScanned; ++i) {
+        const uint32 cursor = m_collectCursor;
+        m_collectCursor = (cursor + 1) % NUM_SHARDS;
+
+        Shard& shard = m_shards[cursor];
+        Lock lock(shard.writeMutex);
+        const Snapshot* current = shard.snapshot.load(std::memory_order_relaxed);
+        for (const auto& entry : current->entries) {
+          ++numScanned;
+          if (isEvictable(*entry.second, keep)) {
+            candidates.push_back({ entry.second->lastUsed.load(std::memory_order_relaxed),
+                                   entry.second->memoryUsage.load(std::memory_order_relaxed),
+                                   entry.first });
+          }
+        }
+      }
+
+      std::sort(candidates.begin(),
+                candidates.end(),
+                [](const Candidate& a, const Candidate& b) {
+                  return a.lastUsed < b.lastUsed;
+                });
+
+      //The oldest ones, until enough memory is freed
+      Array<Vector<uint32>, NUM_SHARDS> evicted;
+      SIZE_T toFree = memoryUsage - memoryBudget;
+      for (const auto& candidate : candidates) {
+        evicted[candidate.id % NUM_SHARDS].push_back(candidate.id);
+        if (candidate.memoryUsage >= toFree) {
+          break;
+        }
+        toFree -= candidate.memoryUsage;
+      }
+
+      uint32 numEvicted = 0;
+      for (uint32 i = 0; i < NUM_SHARDS; ++i) {
+        if (!evicted[i].empty()) {
+          Lock lock(m_shards[i].writeMutex);
+          numEvicted += removeEntries(m_shards[i], evicted[i], keep);
+        }
+      }
+      return numEvicted;
+    }
+
+    /**
+     * @brief Memory used by the resources, as measured when stored.
+     */
+    SIZE_T
+    getMemoryUsage() const {
+      return m_memoryUsage.load(std::memory_order_relaxed);
+    }
+
+    SIZE_T
+    getMemoryBudget() const {
+      return m_memoryBudget.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Memory the resources can use before collect() evicts them. No
+     *        limit by default.
+     */
+    void
+    setMemoryBudget(SIZE_T budget) {
+      m_memoryBudget.store(budget, std::memory_order_relaxed);
+    }
+
+    SIZE_T
+    size() const {
+      return m_numEntries.load(std::memory_order_relaxed);
+    }
+
+   private:
+    struct Entry
+    {
+      ResourcePtr resource;
+      atomic<SIZE_T> memoryUsage{ 0 };
+      mutable atomic<uint64> lastUsed{ 0 };
+    };
+
+    /**
+     * An immutable map of a shard. The entries are shared with the next
+     * snapshots until they're replaced.
+     */
+    struct Snapshot
+    {
+      FlatHashMap<uint32, SPtr<Entry>> entries;
+    };
+
+    struct Shard
+    {
+      atomic<const Snapshot*> snapshot{ nullptr };
+
+      /**
+       * Readers inside the shard, on one of two counters picked by the
+       * parity of the epoch. Writers flip the epoch so new readers count
+       * apart from the ones they wait for.
+       */
+      mutable atomic<uint32> readers[2] = {};
+      atomic<uint32> epoch{ 0 };
+
+      Mutex writeMutex;
+    };
+
+    /**
+     * @brief Announces a reader on the shard while it's alive.
+     */
+    class ReadScope
+    {
+     public:
+      explicit ReadScope(const Shard& shard)
+        : m_readers(shard.readers[shard.epoch.load(std::memory_order_relaxed) & 1]) {
+        m_readers.fetch_add(1, std::memory_order_seq_cst);
+      }
+
+      ~ReadScope() {
+        m_readers.fetch_sub(1, std::memory_order_release);
+      }
+
+     private:
+      atomic<uint32>& m_readers;
+    };
+
+    Shard&
+    getShard(uint32 id) {
+      return m_shards[id % NUM_SHARDS];
+    }
+
+    const Shard&
+    getShard(uint32 id) const {
+      return m_shards[id % NUM_SHARDS];
+    }
+
+    uint64
+    getClock() const {
+      return m_clock.load(std::memory_order_relaxed);
+    }
+
+    template<typename Keep>
+    static bool
+    isEvictable(const Entry& entry, Keep& keep) {
+      return 1 == entry.resource.use_count() && !keep(entry.resource);
+    }
+
+    void
+    removeUsage(const Entry& entry) {
+      m_memoryUsage.fetch_sub(entry.memoryUsage.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+      m_numEntries.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Removes the entries of the shard with the ids. Must be called
+     *        with the shard locked for writing.
+     */
+    uint32
+    removeEntries(Shard& shard, const Vector<uint32>& ids) {
+      return removeEntries(shard, ids, [](const ResourcePtr&) { return false; }, false);
+    }
+
+    /**
+     * @brief Same, but only while they're still evictable.
+     */
+    template<typename Keep>
+    uint32
+    removeEntries(Shard& shard,
+                  const Vector<uint32>& ids,
+                  Keep&& keep,
+                  bool bCheckEvictable = true) {
+      if (ids.empty()) {
+        return 0;
+      }
+
+      const Snapshot* current = shard.snapshot.load(std::memory_order_relaxed);
+      Snapshot* next = ge_new<Snapshot>(*current);
+      uint32 numRemoved = 0;
+      for (uint32 id : ids) {
+        auto it = next->entries.find(id);
+        if (it == next->entries.end() ||
+            (bCheckEvictable && !isEvictable(*it->second, keep))) {
+          continue;
+        }
+
+        removeUsage(*it->second);
+        next->entries.erase(it);
+        ++numRemoved;
+      }
+
+      publish(shard, next);
+      return numRemoved;
+    }
+
+    /**
+     * @brief Swaps in the new snapshot of the shard, and frees the previous
+     *        one once the readers that could still see it are gone. Must be
+     *        called with the shard locked for writing.
+     */
+    void
+    publish(Shard& shard, const Snapshot* next) {
+      const Snapshot* previous = shard.snapshot.exchange(next, std::memory_order_seq_cst);
+
+      //A reader seeing the previous snapshot entered before the exchange, on
+      //either counter. Flipping the epoch first lets each one drain
+      for (uint32 i = 0; i < 2; ++i) {
+        const uint32 epoch = shard.epoch.fetch_add(1, std::memory_order_seq_cst);
+        while (0 != shard.readers[epoch & 1].load(std::memory_order_seq_cst)) {
+          std::this_thread::yield();
+        }
+      }
+
+      ge_delete(const_cast<Snapshot*>(previous));
+    }
+
+    Shard m_shards[NUM_SHARDS];
+
+    atomic<SIZE_T> m_memoryUsage{ 0 };
+    atomic<SIZE_T> m_memoryBudget{ std::numeric_limits<SIZE_T>::max() };
+    atomic<SIZE_T> m_numEntries{ 0 };
+    atomic<uint64> m_clock{ 0 };
+
+    /**
+     * Shard where the next step of the collection starts. Collections run on
+     * a single thread.
+     */
+    uint32 m_collectCursor = 0;
+  };
+}
@@ -19,8 +19,11 @@
 /*****************************************************************************/
 #include "gePrerequisitesCore.h"
 #include "geActor.h"
+#include <geAABBTree.h>
 
 namespace geEngineSDK {
+  class Model;
+
   class Scene
   {
    public:
@@ -39,6 +42,15 @@ namespace geEngineSDK {
     void
     update(float dt);
 
+    /**
+     * @brief Queues the actor to refresh its proxy in the spatial index on
+     *        the next update(). Called by Actor::markBoundsDirty().
+     */
+    void
+    markSpatialDirty(Actor* actor) {
+      m_spatialDirty.push_back(actor);
+    }
+
     template<class Func>
     void
     forEachActor(Func&& func) {
@@ -49,8 +61,96 @@ namespace geEngineSDK {
       }
     }
 
+    /**
+     * @brief Calls func(actor) for every actor with a ModelComponent whose
+     *        world bounds (the union of all of its models, enlarged by the
+     *        margin of the spatial index) overlap the box. The index is
+     *        refreshed by update().
+     */
+    template<class Func>
+    void
+    queryActors(const AABox& box, Func&& func) const {
+      m_spatialIndex.query(box, [this, &func](int32 proxyId) {
+        func(*getProxyActor(proxyId));
+        return true;
+      });
+    }
+
+    /**
+     * @brief Same as the box query, for the actors that overlap the sphere.
+     */
+    template<class Func>
+    void
+    queryActors(const Sphere& sphere, Func&& func) const {
+      m_spatialIndex.query(sphere, [this, &func](int32 proxyId) {
+        func(*getProxyActor(proxyId));
+        return true;
+      });
+    }
+
+    /**
+     * @brief Same as the box query, for the actors inside a convex volume
+     *        like a frustum, given as planes that face out of it.
+     */
+    template<class Func>
+    void
+    queryActors(const Plane* planes, uint32 planeCount, Func&& func) const {
+      m_spatialIndex.query(planes, planeCount, [this, &func](int32 proxyId) {
+        func(*getProxyActor(proxyId));
+        return true;
+      });
+    }
+
+    /**
+     * @brief Calls func(actor, maxDistance) for the actors whose bounds the
+     *        ray hits, see AABBTree::raycast() for what func returns.
+     */
+    template<class Func>
+    void
+    raycastActors(const Vector3& origin,
+                  const Vector3& direction,
+                  float maxDistance,
+                  Func&& func) const {
+      m_spatialIndex.raycast(origin,
+                             direction,
+                             maxDistance,
+                             [this, &func](int32 proxyId, float currentMax) {
+                               return func(*getProxyActor(proxyId), currentMax);
+                             });
+    }
+
+    const AABBTree&
+    getSpatialIndex() const {
+      return m_spatialIndex;
+    }
+
    private:
+    struct SpatialProxy
+    {
+      int32 proxyId = AABBTree::NULL_NODE;
+      AABox bounds = AABox::EMPTY;
+    };
+
+    Actor*
+    getProxyActor(int32 proxyId) const {
+      return static_cast<Actor*>(m_spatialIndex.getUserData(proxyId));
+    }
+
+    /**
+     * Moves the proxies of the actors whose scene node changed since the
+     * last update, and adds or removes the ones that got or lost a model.
+     * Only the actors reported as moved or dirty are visited.
+     */
+    void
+    updateSpatialIndex();
+
     Vector<SPtr<Actor>> m_actors;
+
+    AABBTree m_spatialIndex;
+    UnorderedMap<Actor*, SpatialProxy> m_spatialProxies;
+
+    //Actors that moved or changed their models since the last update
+    Vector<Actor*> m_spatialDirty;
   };
 
 } // namespace geEngineSDK
@@ -0,0 +1,124 @@
+/*****************************************************************************/
+/**
+ * @file    geSceneCuller.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Frustum culling of the submeshes of a Scene.
+ *
+ * Frustum culling of the submeshes of a Scene. Every submesh of every model
+ * in the scene is tested against all the views (main camera, shadow
+ * cascades, reflections) in one pass, split in chunks that run on the
+ * TaskScheduler workers. The result is a compact list per view that the
+ * renderer can submit as is.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include "geScene.h"
+#include <gePlane.h>
+#include <geMatrix4.h>
+
+namespace geEngineSDK {
+
+  /**
+   * @brief A view to cull the scene for.
+   */
+  struct CullView
+  {
+    CullView() = default;
+    explicit CullView(const Array<Plane, 6>& frustum)
+      : planes(frustum)
+    {}
+
+    /**
+     * Planes facing out of the view volume, see Camera::extractFrustum().
+     */
+    Array<Plane, 6> planes;
+  };
+
+  /**
+   * @brief A submesh that is visible in a view.
+   */
+  struct VisibleSubMesh
+  {
+    const Actor* actor = nullptr;
+    const Model* model = nullptr;
+    uint32 meshIndex = 0;
+    uint32 subMeshIndex = 0;
+
+    /**
+     * World transform of the submesh, its model node and the actor combined.
+     */
+    Matrix4 world;
+  };
+
+  class GE_CORE_EXPORT SceneCuller
+  {
+   public:
+    /**
+     * @brief Views that can be culled together, one bit each in the masks.
+     */
+    static CONSTEXPR uint32 MAX_VIEWS = 32;
+
+    /**
+     * @brief Submeshes tested by a worker each time it takes more work.
+     */
+    static CONSTEXPR uint32 CHUNK_SIZE = 256;
+
+    /**
+     * @brief Finds the actors that overlap each view with the spatial index
+     *        of the scene, then tests the submeshes of the active and visible
+     *        ones against the views they overlap.
+     * @param[out] outVisible One list per view, with the submeshes that
+     *             overlap it grouped by actor.
+     * @note  The scene must be updated, the actors without model bounds are
+     *        not in its spatial index.
+     */
+    void
+    cull(const Scene& scene,
+         const Vector<CullView>& views,
+         Vector<Vector<VisibleSubMesh>>& outVisible);
+
+    /**
+     * @brief Number of submeshes of the actors found by the spatial index on
+     *        the last cull().
+     */
+    uint32
+    getNumInstances() const {
+      return cast::st<uint32>(m_instances.size());
+    }
+
+   private:
+    struct Candidate
+    {
+      const Actor* actor;
+
+      //Views whose volume overlaps the bounds of the actor
+      uint32 viewMask;
+    };
+
+    struct Instance
+    {
+      const Actor* actor;
+      const Model* model;
+      uint32 meshIndex;
+      uint32 subMeshIndex;
+      uint32 viewMask;
+    };
+
+    //Kept between frames so the per frame work doesn't allocate
+    Vector<Candidate> m_actors;
+    UnorderedMap<const Actor*, uint32> m_actorSlots;
+    Vector<Instance> m_instances;
+    Vector<Matrix4> m_worlds;
+    Vector<uint32> m_viewMasks;
+  };
+}
@@ -21,6 +21,8 @@
 #include <geTransform.h>
 
 namespace geEngineSDK {
+  class Actor;
+
   class SceneNode
   {
    public:
@@ -59,6 +61,20 @@ namespace geEngineSDK {
       return m_world;
     }
 
+    /**
+     * @brief The actor that owns this node, reported by updateWorldRecursive()
+     *        when the world matrix of the node changes.
+     */
+    Actor*
+    getActor() const {
+      return m_actor;
+    }
+
+    void
+    setActor(Actor* actor) {
+      m_actor = actor;
+    }
+
     void
     setVisible(bool value) {
       m_visible = value;
@@ -107,17 +123,28 @@ namespace geEngineSDK {
       return nullptr;
     }
 
+    /**
+     * @brief Recomputes the world matrices that changed.
+     * @param[out] outMoved If given, gets the actors of the nodes whose world
+     *             matrix was recomputed.
+     */
     void
-    updateWorldRecursive(const Matrix4* parentWorld = nullptr, bool parentDirty = false) {
+    updateWorldRecursive(const Matrix4* parentWorld = nullptr,
+                         bool parentDirty = false,
+                         Vector<Actor*>* outMoved = nullptr) {
       bool needsUpdate = m_dirty || parentDirty;
       if (needsUpdate) {
         Matrix4 localM = m_local.toMatrixWithScale();
         m_world = parentWorld ? (localM * (*parentWorld)) : localM;
         m_dirty = false;
+
+        if (outMoved && m_actor) {
+          outMoved->push_back(m_actor);
+        }
       }
 
       for (auto& child : m_children) {
-        child->updateWorldRecursive(&m_world, needsUpdate);
+        child->updateWorldRecursive(&m_world, needsUpdate, outMoved);
       }
     }
 
@@ -140,6 +167,7 @@ namespace geEngineSDK {
 
     Transform m_local;
     Matrix4 m_world = Matrix4::IDENTITY;
+    Actor* m_actor = nullptr;
 
     bool m_dirty = true;
     bool m_visible = true;
@@ -0,0 +1,88 @@
+/*****************************************************************************/
+/**
+ * @file    geTextureCooker.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Cooks source images into block compressed DDS files.
+ *
+ * Cooks source images into block compressed DDS files stored on a cache
+ * addressed by the hash of the source file contents.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include "geGraphicsTypes.h"
+#include "geGameConfig.h"
+
+#include <geMipMapGenerator.h>
+
+namespace geEngineSDK {
+
+  /**
+   * @brief Compresses decoded images and writes them to the texture cache.
+   *        The format is picked from [TEXTURES] COMPRESSION on the config:
+   *        AUTO (BC1 for opaque images, BC3 with alpha), BC7 or NONE.
+   */
+  class GE_CORE_EXPORT TextureCooker
+  {
+   public:
+    /**
+     * @brief Resolves the setting on the running GameConfig. Create it on the
+     *        loading thread for each import, the decode workers can then read
+     *        it while the import runs.
+     */
+    TextureCooker();
+
+    /**
+     * @brief Returns the cache path of the cooked version of a source file.
+     *        The name is a hash of the contents and of the cook settings, so
+     *        editing the file or the settings invalidates it.
+     * @param[in] data The contents of the source file.
+     * @param[in] size The size of the source file in bytes.
+     */
+    Path
+    getCachePath(const uint8* data, SIZE_T size) const;
+
+    /**
+     * @brief Returns the format to cook an image to, or kUNKNOWN if the
+     *        images should not be compressed.
+     */
+    GRAPHICS_FORMAT::E
+    selectFormat(bool hasAlpha) const;
+
+    /**
+     * @brief Compresses all the levels of an RGBA8 mip chain.
+     * @param[in] mips      The chain to compress.
+     * @param[in] format    One of the formats returned by selectFormat.
+     * @param[in] bParallel Splits each level across the TaskScheduler workers.
+     */
+    static MipChain
+    compress(const MipChain& mips, GRAPHICS_FORMAT::E format, bool bParallel = true);
+
+    /**
+     * @brief Writes a compressed chain as a DDS file (with a DX10 header)
+     *        under the application path, and adds it to the MountManager.
+     * @return false if the file could not be written.
+     */
+    static bool
+    writeDDS(const Path& cachePath, const MipChain& mips, GRAPHICS_FORMAT::E format);
+
+   private:
+    const String&
+    getCompressionSetting() const;
+
+    /**
+     * @brief [TEXTURES] COMPRESSION, unresolved when there is no GameConfig.
+     */
+    ConfigVar<String> m_compression;
+  };
+
+}
@@ -20,6 +20,7 @@
 /*****************************************************************************/
 #include "gePrerequisitesCore.h"
 
+#include <geFlatHashMap.h>
 #include <geModule.h>
 #include <geDebug.h>
 #include <geStringID.h>
@@ -29,6 +30,7 @@
 namespace geEngineSDK {
 
   class Texture;
+  class FramePipeline;
 
   class GE_CORE_EXPORT TextureManager : public Module<TextureManager>
   {
@@ -48,6 +50,16 @@ namespace geEngineSDK {
          bool useCacheIfAvailable = false,
          bool bReload = false);
 
+    /**
+     * @brief Load several textures at once. Codecs that support it decode the
+     *        files in parallel, and the rest are loaded one by one.
+     * @param filePaths The paths to the texture files.
+     * @param useCacheIfAvailable If true, will use cached textures if available.
+     * @return The loaded textures, in the same order as filePaths.
+     */
+    Vector<SPtr<Texture>>
+    loadBatch(const Vector<Path>& filePaths, bool useCacheIfAvailable = false);
+
     /**
      * @brief Reloads data or configuration from the specified file path.
      * @param filePath The path to the file to reload.
@@ -67,15 +79,48 @@ namespace geEngineSDK {
     bool
     isDefaultTexture(const WeakSPtr<Texture>& pTexture);
 
+    /**
+     * @brief Sets the pipeline that renders the frames. While a render
+     *        thread uses the device, the loads from the simulation thread
+     *        wait for it to go idle. Null when there are no frames in flight.
+     */
+    void
+    setFramePipeline(FramePipeline* pipeline) {
+      m_pFramePipeline = pipeline;
+    }
+
    protected:
     void
     onStartUp() override;
 
+    /**
+     * @brief Finds the file to import for a texture: the file itself, or the
+     *        file on the root folder.
+     * @return false if the file doesn't exist.
+     */
+    bool
+    _resolveRealPath(const Path& filePath, Path& realPath);
+
+    /**
+     * @brief Returns the default texture named by a "*.DEFAULT" path, or the
+     *        error texture if there's no default with that name.
+     */
+    SPtr<Texture>
+    _findDefaultTexture(const Path& filePath);
+
+    /**
+     * @brief Adds a newly imported texture to the loaded textures. If the
+     *        path was already loaded, the existing texture takes the new data.
+     */
+    SPtr<Texture>
+    _registerTexture(const Path& filePath, SPtr<Texture> pTexture);
+
     void
     onShutDown() override;
 
-    UnorderedMap<uint32, SPtr<Texture>> m_loadedTextures;
+    FlatHashMap<uint32, SPtr<Texture>> m_loadedTextures;
     Mutex m_mutex;
+    FramePipeline* m_pFramePipeline = nullptr;
 
    public:
     //Textures created by the manager, we have this so they are not unloaded
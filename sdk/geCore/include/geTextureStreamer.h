@@ -0,0 +1,408 @@
+/*****************************************************************************/
+/**
+ * @file    geTextureStreamer.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Streams the mips of the textures as they're needed.
+ *
+ * Keeps resident only the mips of each texture needed for its size on the
+ * screen. Textures are registered with the mip chain read from their header,
+ * the renderer reports every frame how they're seen, and the mips are loaded
+ * and dropped under a memory budget: the files are read in the background,
+ * and the textures created on the next update, or by the render commands of
+ * its frame when there is a FramePipeline. Until a texture has its first
+ * mips, one of the default textures is drawn instead.
+ *
+ * @bug	    No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include "geGraphicsTypes.h"
+
+#include <geFlatHashMap.h>
+#include <geModule.h>
+#include <geDebug.h>
+#include <geRadian.h>
+
+namespace geEngineSDK {
+  using std::function;
+
+  class Texture;
+  class Task;
+  class FramePipeline;
+
+  /**
+   * @brief The full mip chain of a texture, as described by its header.
+   */
+  struct GE_CORE_EXPORT TextureMipChain
+  {
+    /**
+     * Where the data of a subresource is on the file, after the headers.
+     */
+    struct SubresourceData
+    {
+      uint32 mip;
+      uint64 srcOffset;
+      uint64 size;
+    };
+
+    /**
+     * Bytes [begin, end) of the file.
+     */
+    struct DataRange
+    {
+      uint64 begin;
+      uint64 end;
+    };
+
+    TEXTURE_DESC desc;
+
+    /**
+     * Bytes of each level, with every array slice.
+     */
+    Vector<uint64> mipSizes;
+
+    /**
+     * Bytes of the headers at the start of the file, read with any range of
+     * levels. 0 if the codec needs the whole file.
+     */
+    uint64 headerSize = 0;
+
+    /**
+     * The ranges of the file that hold the levels from each one on, in file
+     * order. One for every array slice if each holds its own chain, so the
+     * finer levels of the others are left out.
+     */
+    Vector<Vector<DataRange>> mipDataRanges;
+
+    /**
+     * @brief Sets the bytes of each level and where the levels from each one
+     *        on are, from the subresources that follow inHeaderSize bytes of
+     *        headers on the file.
+     */
+    void
+    setLayout(uint64 inHeaderSize, const Vector<SubresourceData>& subresources);
+
+    /**
+     * @brief Same, from the subresources of a texture loader: anything with
+     *        a mip, a srcOffset and a size.
+     */
+    template<typename Subresource>
+    void
+    setLayout(uint64 inHeaderSize, const Vector<Subresource>& subresources) {
+      Vector<SubresourceData> subresourceData;
+      subresourceData.reserve(subresources.size());
+      for (const auto& subresource : subresources) {
+        subresourceData.push_back({ subresource.mip, subresource.srcOffset, subresource.size });
+      }
+      setLayout(inHeaderSize, subresourceData);
+    }
+  };
+
+  class GE_CORE_EXPORT TextureStreamer : public Module<TextureStreamer>
+  {
+   public:
+    /**
+     * Reads the first headerSize bytes of a texture file followed by the
+     * ranges one after the other, or the whole file if headerSize is 0.
+     * Called from the worker threads.
+     */
+    using FileReader = function<bool(const Path& filePath,
+                                     uint64 headerSize,
+                                     const Vector<TextureMipChain::DataRange>& ranges,
+                                     Vector<uint8>& outData)>;
+
+    /**
+     * Creates a texture with the levels of the file from firstMip on, so
+     * its top level is firstMip. The file data holds the headers and the
+     * ranges of those levels, the first one skippedSize bytes after the
+     * headers. Called on the render thread when update() gets a
+     * FramePipeline, otherwise from the thread that runs update() or flush().
+     */
+    using MipUploader = function<SPtr<Texture>(const Path& filePath,
+                                               const Vector<uint8>& fileData,
+                                               uint64 skippedSize,
+                                               uint32 firstMip)>;
+
+    static CONSTEXPR uint32 INVALID_ID = NumLimit::MAX_UINT32;
+
+    TextureStreamer();
+    ~TextureStreamer() override;
+
+    /**
+     * @brief Registers a texture with the mip chain read from its header by
+     *        the codec. Nothing is loaded until the texture is used.
+     * @param placeholder Drawn until the first mips are loaded, white if null.
+     * @return The id of the texture, or INVALID_ID if the codec can't stream
+     *         it (use the TextureManager instead).
+     */
+    uint32
+    registerTexture(const Path& filePath, const SPtr<Texture>& placeholder = nullptr);
+
+    uint32
+    registerTexture(const Path& filePath,
+                    const TextureMipChain& chain,
+                    const SPtr<Texture>& placeholder = nullptr);
+
+    void
+    unregisterTexture(uint32 id);
+
+    /**
+     * @brief Sets the view the usage is reported for.
+     * @param screenHeight Height of the viewport in pixels.
+     * @param fovY         Vertical field of view of the camera.
+     */
+    void
+    setViewport(float screenHeight, const Radian& fovY);
+
+    /**
+     * @brief Reports a use of the texture this frame.
+     * @param uvDensity Texture repetitions per world unit on the surface.
+     * @param distance  From the camera to the surface.
+     */
+    void
+    reportUsage(uint32 id, float uvDensity, float distance);
+
+    /**
+     * @brief Reports a use of the texture this frame that needs the level
+     *        mip and the coarser ones.
+     */
+    void
+    reportMip(uint32 id, uint32 mip);
+
+    /**
+     * @brief The level needed to draw a texture without aliasing or blur.
+     */
+    uint32
+    computeMip(uint32 id, float uvDensity, float distance) const;
+
+    /**
+     * @brief Applies the loaded mips, updates the levels each texture needs
+     *        from the usage reported since the last update, and starts
+     *        loading or dropping mips. Call it once a frame.
+     * @param pipeline If not null, the textures are created and swapped by
+     *        commands of the frame being simulated, so the render thread
+     *        never draws one while it changes. Those are applied on a later
+     *        update.
+     */
+    void
+    update(FramePipeline* pipeline = nullptr);
+
+    /**
+     * @brief Waits for the loads in progress and applies them. Creates the
+     *        textures on the calling thread, so with a pipeline, only call it
+     *        once the pipeline is flushed.
+     */
+    void
+    flush();
+
+    /**
+     * @brief The texture to draw: the resident mips, or the placeholder.
+     *        Look it up again every frame, as the placeholder is replaced
+     *        once the first mips are loaded.
+     */
+    SPtr<Texture>
+    getTexture(uint32 id) const;
+
+    /**
+     * @brief The finest level loaded, or the number of levels if none is.
+     */
+    uint32
+    getResidentMip(uint32 id) const;
+
+    /**
+     * @brief The finest level that should be loaded.
+     */
+    uint32
+    getWantedMip(uint32 id) const;
+
+    /**
+     * @brief Memory used by the resident mips.
+     */
+    SIZE_T
+    getMemoryUsage() const {
+      return m_memoryUsage;
+    }
+
+    SIZE_T
+    getMemoryBudget() const {
+      return m_memoryBudget;
+    }
+
+    /**
+     * @brief Memory the resident mips can use. Over it, the least recently
+     *        used textures drop their finest levels first. No limit by
+     *        default.
+     */
+    void
+    setMemoryBudget(SIZE_T budget) {
+      m_memoryBudget = budget;
+    }
+
+    /**
+     * @brief Frames a texture keeps its mips after its last use, before it
+     *        drops to its coarsest level.
+     */
+    void
+    setIdleFrames(uint32 numFrames) {
+      m_idleFrames = numFrames;
+    }
+
+    /**
+     * @brief Loads in progress at the same time, at most.
+     */
+    void
+    setMaxPendingLoads(uint32 maxLoads) {
+      m_maxPendingLoads = maxLoads;
+    }
+
+    /**
+     * @brief Replaces the reader, which by default reads the range of the
+     *        file from the MountManager.
+     */
+    void
+    setFileReader(FileReader reader) {
+      m_fileReader = std::move(reader);
+    }
+
+    /**
+     * @brief Replaces the uploader, which by default imports the levels with
+     *        the codec of the file.
+     */
+    void
+    setMipUploader(MipUploader uploader) {
+      m_mipUploader = std::move(uploader);
+    }
+
+   private:
+    struct StreamedTexture
+    {
+      Path filePath;
+      TextureMipChain chain;
+
+      SPtr<Texture> texture;
+      SPtr<Texture> placeholder;
+
+      uint32 residentMip = 0;
+      uint32 wantedMip = 0;
+
+      /**
+       * Finest level reported this frame.
+       */
+      uint32 requestedMip = 0;
+      uint64 lastUsedFrame = 0;
+
+      /**
+       * Serial of the load in progress. A completion with another one
+       * belongs to an earlier registration of the same file.
+       */
+      uint32 loadSerial = 0;
+
+      bool bLoading = false;
+      bool bFailed = false;
+    };
+
+    struct CompletedLoad
+    {
+      uint32 id;
+      uint32 serial;
+      uint32 firstMip;
+      bool bRead;
+      Vector<uint8> fileData;
+      uint64 skippedSize;
+    };
+
+    /**
+     * A load turned into a texture, null if it failed. If the texture had
+     * levels already, it's the same one with the new levels.
+     */
+    struct UploadedLoad
+    {
+      uint32 id;
+      uint32 serial;
+      uint32 firstMip;
+      SPtr<Texture> texture;
+    };
+
+    uint32
+    getNumMips(const StreamedTexture& texture) const {
+      return cast::st<uint32>(texture.chain.mipSizes.size());
+    }
+
+    /**
+     * @brief Bytes of the levels from firstMip on.
+     */
+    static uint64
+    getChainSize(const StreamedTexture& texture, uint32 firstMip);
+
+    /**
+     * @brief Creates the textures of the files read, right away or with the
+     *        commands of the pipeline.
+     */
+    void
+    uploadCompletedLoads(FramePipeline* pipeline);
+
+    void
+    upload(const CompletedLoad& load, const Path& filePath, const SPtr<Texture>& texture);
+
+    void
+    applyUploadedLoads();
+
+    void
+    updateWantedMips();
+
+    /**
+     * @brief Drops the finest wanted levels, least recently used textures
+     *        first, until the wanted mips fit in the budget.
+     */
+    void
+    fitInBudget();
+
+    void
+    startLoads();
+
+    void
+    startLoad(uint32 id, StreamedTexture& texture);
+
+    static bool
+    readFile(const Path& filePath,
+             uint64 headerSize,
+             const Vector<TextureMipChain::DataRange>& ranges,
+             Vector<uint8>& outData);
+
+    static SPtr<Texture>
+    uploadWithCodec(const Path& filePath,
+                    const Vector<uint8>& fileData,
+                    uint64 skippedSize,
+                    uint32 firstMip);
+
+    FlatHashMap<uint32, StreamedTexture> m_textures;
+
+    Vector<CompletedLoad> m_completedLoads;
+    Vector<UploadedLoad> m_uploadedLoads;
+    Vector<SPtr<Task>> m_loadTasks;
+    Mutex m_completedMutex;
+
+    FileReader m_fileReader;
+    MipUploader m_mipUploader;
+
+    SIZE_T m_memoryUsage = 0;
+    SIZE_T m_memoryBudget = std::numeric_limits<SIZE_T>::max();
+
+    float m_pixelsPerUnit = 1.0f;
+    uint64 m_frame = 1;
+    uint32 m_idleFrames = 60;
+    uint32 m_maxPendingLoads = 4;
+    uint32 m_numPendingLoads = 0;
+    uint32 m_nextLoadSerial = 0;
+  };
+
+  GE_LOG_CATEGORY(TextureStreamer, 210);
+}
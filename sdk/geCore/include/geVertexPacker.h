@@ -0,0 +1,133 @@
+/*****************************************************************************/
+/**
+ * @file    geVertexPacker.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Converts full float vertex layouts to quantized ones.
+ *
+ * Converts full float vertex layouts to quantized ones: octahedral normals,
+ * half float texture coordinates, 8-bit blend weights and (optionally)
+ * 16-bit positions relative to the bounds of the vertices.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesCore.h"
+#include "geVertexDeclaration.h"
+
+#include <geBox.h>
+#include <geVector4.h>
+
+namespace geEngineSDK {
+
+  /**
+   * @brief Selects which attributes VertexPacker is allowed to quantize.
+   *        Nothing is packed by default, as the shaders reading the vertices
+   *        have to decode what is.
+   */
+  struct VertexPackingOptions
+  {
+    /**
+     * Normals, tangents and bitangents to octahedral SHORT2_NORM. The shader
+     * rebuilds them with decodeOctahedral(). FLOAT4 tangents are only packed
+     * when all of them have a positive handedness.
+     */
+    bool packNormals = false;
+
+    /**
+     * FLOAT2 texture coordinates to HALF2, only if all of them fit in
+     * [-maxHalfTexCoord, maxHalfTexCoord].
+     */
+    bool packTexCoords = false;
+
+    /**
+     * Above 2 a half float has less than 1/1024 of precision, which is
+     * already a texel on a 1K texture.
+     */
+    float maxHalfTexCoord = 2.0f;
+
+    /**
+     * FLOAT4 blend weights to UBYTE4_NORM, still adding up to one.
+     */
+    bool packBlendWeights = false;
+
+    /**
+     * FLOAT3 positions to USHORT4_NORM relative to the range of the vertices
+     * (see packVertices). The shader rebuilds them as
+     * offset + scale * position.xyz.
+     */
+    bool packPositions = false;
+  };
+
+  /**
+   * @brief Quantizes interleaved vertices of a single stream. The packed
+   *        layout keeps the order and semantics of the source one, so it
+   *        stays compatible with the same shaders input signatures.
+   */
+  class GE_CORE_EXPORT VertexPacker
+  {
+   public:
+    /**
+     * @brief Chooses the packed version of a layout. Some choices depend on
+     *        the data (the range of the texture coordinates, the handedness
+     *        of the tangents), so it takes all the vertices that will share
+     *        the layout.
+     * @return The packed elements, with their offsets recomputed.
+     */
+    static Vector<VertexElement>
+    getPackedElements(const Vector<VertexElement>& elements,
+                      const uint8* vertices,
+                      uint32 vertexCount,
+                      const VertexPackingOptions& options);
+
+    /**
+     * @brief Returns the bounds of the positions of a range of vertices, to
+     *        be used as the quantization range on packVertices.
+     */
+    static AABox
+    getPositionRange(const Vector<VertexElement>& elements,
+                     const uint8* vertices,
+                     uint32 vertexCount);
+
+    /**
+     * @brief Converts vertices from a layout to its packed version.
+     * @param[in] positionRange Range the positions are normalized to when
+     *            they are packed. Ignored otherwise.
+     */
+    static void
+    packVertices(const Vector<VertexElement>& srcElements,
+                 const uint8* srcVertices,
+                 const Vector<VertexElement>& dstElements,
+                 uint8* dstVertices,
+                 uint32 vertexCount,
+                 const AABox& positionRange);
+
+    /**
+     * @brief Maps a unit vector to the octahedron and its two coordinates to
+     *        normalized 16-bit integers, picking the rounding that gives the
+     *        smallest angular error.
+     */
+    static void
+    encodeOctahedral(const Vector3& direction, int16* outEncoded);
+
+    /**
+     * @brief Inverse of encodeOctahedral(), the same the shaders do.
+     */
+    static Vector3
+    decodeOctahedral(const int16* encoded);
+
+    /**
+     * @brief Rounds four weights to 8 bits so they still add up to 255.
+     */
+    static void
+    encodeBlendWeights(const Vector4& weights, uint8* outEncoded);
+  };
+
+}
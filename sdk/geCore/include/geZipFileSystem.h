@@ -21,6 +21,7 @@
 #include "geZipDataStream.h"
 
 #include <geDebug.h>
+#include <geFlatHashMap.h>
 #include <geStringID.h>
 
 namespace geEngineSDK {
@@ -46,7 +47,7 @@ namespace geEngineSDK {
 
     void* m_zipHandle = nullptr;
     Path m_zipPath;
-    UnorderedMap<String, ZipFileData> m_fileIndex;
+    FlatStringMap<ZipFileData> m_fileIndex;
   };
 
 }
@@ -23,6 +23,7 @@ namespace geEngineSDK {
   Actor::Actor(Scene* scene)
     : m_scene(scene) {
     m_sceneNode = ge_shared_ptr_new<SceneNode>();
+    m_sceneNode->setActor(this);
   }
 
   Actor::~Actor() {
@@ -34,6 +35,7 @@ namespace geEngineSDK {
     }
 
     m_components.clear();
+    m_sceneNode->setActor(nullptr);
   }
 
   Scene*
@@ -71,6 +73,13 @@ namespace geEngineSDK {
     return m_active;
   }
 
+  void
+  Actor::markBoundsDirty() {
+    if (m_scene) {
+      m_scene->markSpatialDirty(this);
+    }
+  }
+
   void
   Actor::update(float dt) {
     if (!m_active) {
@@ -13,4 +13,30 @@ namespace geEngineSDK {
     m_projMatrix = Matrix4::IDENTITY;
   }
 
+  Array<Plane, 6>
+  Camera::extractFrustum(const Matrix4& viewProj) {
+    //Row vectors, so clip = world * viewProj and each clip coordinate is the
+    //dot product with a column. Inside means -w <= x, y <= w and 0 <= z <= w.
+    auto column = [&viewProj](uint32 j) {
+      return Vector4(viewProj.m[0][j], viewProj.m[1][j], viewProj.m[2][j], viewProj.m[3][j]);
+    };
+
+    const Vector4 x = column(0);
+    const Vector4 y = column(1);
+    const Vector4 z = column(2);
+    const Vector4 w = column(3);
+    const Vector4 insideAbove[6] = { w + x, w - x, w + y, w - y, z, w - z };
+
+    Array<Plane, 6> planes;
+    for (uint32 i = 0; i < 6; ++i) {
+      //a * p + d >= 0 inside, flipped so the normal faces out
+      const Vector4& plane = insideAbove[i];
+      const Vector3 normal(plane.x, plane.y, plane.z);
+      const float length = normal.size();
+      const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+      planes[i] = Plane(-normal * invLength, plane.w * invLength);
+    }
+    return planes;
+  }
+
 } // namespace geEngineSDK
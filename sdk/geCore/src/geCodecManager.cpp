@@ -87,7 +87,7 @@ namespace geEngineSDK {
           continue; // Skip non-dll files
         }
 
-        auto fileName = codecFile.getFilename();
+        String fileName(codecFile.getFilename());
         StringUtil::toUpperCase(fileName);
         if (fileName.find("CODEC") == String::npos) {
           continue; // Skip non codec files
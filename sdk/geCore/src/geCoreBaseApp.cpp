@@ -27,6 +27,8 @@
 #include <geThreadPool.h>
 #include <geTaskScheduler.h>
 #include <geTime.h>
+#include <geProfiler.h>
+#include <geMemoryTracker.h>
 #include <geDynLibManager.h>
 #include <geRenderAPI.h>
 #include <geGameConfig.h>
@@ -35,6 +37,8 @@
 #include <geMountManager.h>
 #include <geCodecManager.h>
 #include <geTextureManager.h>
+#include <geTextureStreamer.h>
+#include <geDebugDraw.h>
 
 #if USING(GE_FILE_TRACKER)
 #include <geFileTracker.h>
@@ -49,12 +53,38 @@
 namespace geEngineSDK {
   using sf::VideoMode;
 
+  namespace {
+    void
+    setWindowContextActive(sf::RenderWindow* window, bool bActive) {
+      if (!window->setActive(bActive)) {
+        GE_LOG(kWarning, Generic, "Failed to move the window context between threads.");
+      }
+    }
+  }
+
   GE_COREBASE_CLASS::GE_COREBASE_CLASS() {
     //First thing, we will initialize the CrashHandler and GameConfig
     CrashHandler::startUp();
     GameConfig::startUp();
     DynLibManager::startUp();
 
+    //Resolved before loading so they get bound when the config is read
+    auto& gameConfig = GameConfig::instance();
+    const String strWkPath = FileSystem::getWorkingDirectoryPath().toString();
+    m_cfgEnginePath = gameConfig.getVar<String>("ENGINE", "MainPath", strWkPath);
+    m_cfgPluginsPath = gameConfig.getVar<String>("ENGINE", "PluginsPath", strWkPath);
+    m_cfgAppPath = gameConfig.getVar<String>("ENGINE", "AppPath", strWkPath);
+    m_cfgCreateWindow = gameConfig.getVar<bool>("WINDOW", "CREATEWINDOW", true);
+    m_cfgWindowWidth = gameConfig.getVar<uint32>("WINDOW", "WIDTH", 1280);
+    m_cfgWindowHeight = gameConfig.getVar<uint32>("WINDOW", "HEIGHT", 720);
+    m_cfgWindowPosX = gameConfig.getVar<int32>("WINDOW", "POSITIONX", -1);
+    m_cfgWindowPosY = gameConfig.getVar<int32>("WINDOW", "POSITIONY", -1);
+    m_cfgWindowTitle = gameConfig.getVar<String>("WINDOW", "TITLE", "geEngine App");
+    m_cfgFullscreen = gameConfig.getVar<bool>("WINDOW", "FULLSCREEN", false);
+    m_cfgRenderAPIModule = gameConfig.getVar<String>("RENDERAPI", "DLLMODULE", "DX11");
+    m_cfgFrameLatency = gameConfig.getVar<uint32>("RENDER", "FRAMELATENCY", 0);
+    m_cfgStreamingBudgetMB = gameConfig.getVar<uint32>("TEXTURES", "STREAMING_BUDGET_MB", 0);
+
     //Initialize the MountManager
     startMountManager();
 
@@ -132,20 +162,23 @@ namespace geEngineSDK {
     }
     mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(confDir));
 
-    auto& gameConfig = GameConfig::instance();
-    gameConfig.load("Config/EngineConfig.ini");
+    GameConfig::instance().load("Config/EngineConfig.ini");
 
     //Check on the config for the engine path, and plugin path
-    String strWkPath = FileSystem::getWorkingDirectoryPath().toString();
-    FileSystem::setEnginePath(gameConfig.get<String>("ENGINE", "MainPath", strWkPath));
-    FileSystem::setPluginsPath(gameConfig.get<String>("ENGINE", "PluginsPath", strWkPath));
-    FileSystem::setAppPath(gameConfig.get<String>("ENGINE", "AppPath", strWkPath));
+    FileSystem::setEnginePath(m_cfgEnginePath.get());
+    FileSystem::setPluginsPath(m_cfgPluginsPath.get());
+    FileSystem::setAppPath(m_cfgAppPath.get());
 
-    //Clear the MountManager and once again mount the file systems with the new paths
+    //Clear the MountManager and once again mount the file systems with the new paths.
+    //The big trees keep an index on the user folder so the next start only
+    //reads again the folders that changed
     mountManager.clear();
-    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getEnginePath()));
-    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getPluginsPath()));
-    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getAppPath()));
+    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getEnginePath(),
+                                                         confDir + "MountIndex/Engine.idx"));
+    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getPluginsPath(),
+                                                         confDir + "MountIndex/Plugins.idx"));
+    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(FileSystem::getAppPath(),
+                                                         confDir + "MountIndex/App.idx"));
     mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(confDir));
 
     auto baseEnginePack = mountManager.getRealPath("BaseEngine.zip");
@@ -169,13 +202,34 @@ namespace geEngineSDK {
     //Create the RenderAPI
     createRenderAPI();
 
+    //With a latency, the frames are rendered on their own thread while the
+    //next ones are simulated
+    m_framePipeline = ge_unique_ptr_new<FramePipeline>(m_cfgFrameLatency.get());
+    if (TextureManager::isStarted()) {
+      TextureManager::instance().setFramePipeline(m_framePipeline.get());
+    }
+
     //Sends the onCreate Message
     onCreate();
 
     if(!m_window || !m_window->isOpen()) {
+      if (TextureManager::isStarted()) {
+        TextureManager::instance().setFramePipeline(nullptr);
+      }
+      m_framePipeline.reset();
       return;
     }
 
+    //The render thread takes the window context
+    sf::RenderWindow* pRW = cast::re<sf::RenderWindow*>(m_window);
+    const bool bPipelined = m_framePipeline->getLatency() > 0;
+    if (bPipelined) {
+      setWindowContextActive(pRW, false);
+      m_framePipeline->enqueue([pRW]() {
+        setWindowContextActive(pRW, true);
+      });
+    }
+
     //Main App Loop
     bool shouldClose = false;
     while (m_window->isOpen()) {
@@ -184,7 +238,6 @@ namespace geEngineSDK {
           break;
         }
         if (wndEvent.value().is<sf::Event::Closed>()) GE_UNLIKELY {
-          m_window->close();
           shouldClose = true;
           break;
         }
@@ -200,24 +253,66 @@ namespace geEngineSDK {
       //Update the game timer
       g_time()._update();
 
+      //Collect the profiler zones of the last frame
+      if (Profiler::isStarted()) {
+        Profiler::instance().endFrame();
+      }
+      if (MemoryTracker::isStarted()) {
+        MemoryTracker::instance().endFrame();
+      }
+
       //Update the Debug callbacks
       g_debug()._triggerCallbacks();
 
       //Update game logic
-      update(g_time().getFrameDelta());
+      {
+        GE_PROFILE_SCOPE("Update");
+        fixedUpdate();
+        update(g_time().getFrameDelta());
+      }
+
+      //Render game frame, or hand it to the render thread. The debug lines
+      //added during the update are drawn with it.
+      {
+        GE_PROFILE_SCOPE("Render");
+        const float frameDelta = g_time().getFrameDelta();
+        m_framePipeline->enqueue([this, frameDelta]() {
+          if (DebugDraw::isStarted()) {
+            DebugDraw::instance().update(frameDelta);
+          }
+          render();
+          if (DebugDraw::isStarted()) {
+            DebugDraw::instance().reset();
+          }
+        });
+        m_framePipeline->submitFrame();
+      }
+    }
 
-      //Render game frame
-      render();
+    //The frames in flight still use the window
+    if (bPipelined) {
+      m_framePipeline->enqueue([pRW]() {
+        setWindowContextActive(pRW, false);
+      });
+      m_framePipeline->submitFrame();
+      m_framePipeline->flush();
+      setWindowContextActive(pRW, true);
+    }
+    if (shouldClose) {
+      m_window->close();
     }
 
     //Sends the message right before the systems are destroyed
     onDestroy();
+    if (TextureManager::isStarted()) {
+      TextureManager::instance().setFramePipeline(nullptr);
+    }
+    m_framePipeline.reset();
   }
 
   void
   GE_COREBASE_CLASS::createWindow() {
-    auto& gameConfig = GameConfig::instance();
-    if (!gameConfig.get<bool>("WINDOW", "CREATEWINDOW", true)) {
+    if (!m_cfgCreateWindow) {
       return;
     }
 
@@ -226,20 +321,18 @@ namespace geEngineSDK {
     }
 
     m_window = ge_new<sf::RenderWindow>();
-    sf::Vector2u wndSize(gameConfig.get<uint32>("WINDOW", "WIDTH", 1280),
-                         gameConfig.get<uint32>("WINDOW", "HEIGHT", 720));
+    sf::Vector2u wndSize(m_cfgWindowWidth.get(), m_cfgWindowHeight.get());
     m_clientSize.x = wndSize.x;
     m_clientSize.y = wndSize.y;
 
     m_window->create(VideoMode(wndSize),
-                     gameConfig.get<String>("WINDOW", "TITLE", "geEngine App").c_str(),
+                     m_cfgWindowTitle.get().c_str(),
                      sf::Style::Default,
-                     gameConfig.get<bool>("WINDOW", "FULLSCREEN", false) ?
+                     m_cfgFullscreen ?
                      sf::State::Fullscreen :
                      sf::State::Windowed);
 
-    sf::Vector2i wndPosition(gameConfig.get<int32>("WINDOW", "POSITIONX", -1),
-                             gameConfig.get<int32>("WINDOW", "POSITIONY", -1));
+    sf::Vector2i wndPosition(m_cfgWindowPosX.get(), m_cfgWindowPosY.get());
 
     if (-1 != wndPosition.x && -1 != wndPosition.y) {
       m_window->setPosition(wndPosition);
@@ -255,6 +348,7 @@ namespace geEngineSDK {
 
     //Initilize the Engine Systems
     MemStack::beginThread();
+    Profiler::startUp();
     MessageHandler::startUp();
     ThreadPool::startUp<TThreadPool<ThreadDefaultPolicy>>((numWorkerThreads));
     TaskScheduler::startUp();
@@ -275,10 +369,8 @@ namespace geEngineSDK {
       return; //No window to create the RenderAPI with
     }
 
-    auto& gameConfig = GameConfig::instance();
-
     String renderApiDllName = "geRenderAPI";
-    renderApiDllName += gameConfig.get<String>("RENDERAPI", "DLLMODULE", "DX11");
+    renderApiDllName += m_cfgRenderAPIModule.get();
 
     auto renderAPIDll = g_dynLibManager().load(renderApiDllName);
     if (!renderAPIDll) {
@@ -296,11 +388,18 @@ namespace geEngineSDK {
 
     //Initialize the RenderAPI
     auto& renderApi = RenderAPI::instance();
-    renderApi.initRenderAPI(m_window->getNativeHandle(),
-                            gameConfig.get<bool>("WINDOW", "FULLSCREEN", false));
+    renderApi.initRenderAPI(m_window->getNativeHandle(), m_cfgFullscreen);
 
     //Initialize the Graphics managers
     TextureManager::startUp();
+    TextureStreamer::startUp();
+    DebugDraw::startUp();
+
+    //The budget of the streamed textures, none if zero
+    const SIZE_T streamingBudgetMB = m_cfgStreamingBudgetMB.get();
+    if (streamingBudgetMB > 0) {
+      TextureStreamer::instance().setMemoryBudget(streamingBudgetMB * 1024 * 1024);
+    }
 
   }
 
@@ -316,6 +415,14 @@ namespace geEngineSDK {
   void
   GE_COREBASE_CLASS::destroySystems() {
     //Destroy the Graphics Managers before the RenderAPI
+    if (DebugDraw::isStarted()) {
+      DebugDraw::shutDown();
+    }
+
+    if (TextureStreamer::isStarted()) {
+      TextureStreamer::shutDown();
+    }
+
     if(TextureManager::isStarted()) {
       TextureManager::shutDown();
     }
@@ -334,10 +441,10 @@ namespace geEngineSDK {
     TaskScheduler::shutDown();
     ThreadPool::shutDown();
     MessageHandler::shutDown();
+    Profiler::shutDown();
     MemStack::endThread();
 
-    auto& gameConfig = GameConfig::instance();
-    if (gameConfig.get<bool>("WINDOW", "CREATEWINDOW", true)) {
+    if (m_cfgCreateWindow) {
       if (m_window) {
         m_window->close();
         ge_delete(m_window);
@@ -355,8 +462,11 @@ namespace geEngineSDK {
     m_clientSize.x = clientSize.x;
     m_clientSize.y = clientSize.y;
 
+    //In order with the render commands, which may run on the render thread
     auto& graphman = RenderAPI::instance();
-    graphman.resizeSwapChain(clientSize.x, clientSize.y);
+    m_framePipeline->enqueue([&graphman, clientSize]() {
+      graphman.resizeSwapChain(clientSize.x, clientSize.y);
+    });
   }
 
   void
@@ -496,9 +606,32 @@ namespace geEngineSDK {
     }
   }
 
+  void
+  GE_COREBASE_CLASS::fixedUpdate() {
+    //Steps of the same length whatever the frame rate, for a deterministic
+    //simulation
+    uint64 step = 0;
+    const uint32 numSteps = g_time()._getFixedUpdateStep(step);
+    const auto stepSeconds = cast::st<float>(step * Time::MICROSEC_TO_SEC);
+    for (uint32 i = 0; i < numSteps; ++i) {
+      onFixedUpdate(stepSeconds);
+      g_time()._advanceFixedUpdate(step);
+    }
+  }
+
   void
   GE_COREBASE_CLASS::update(float deltaTime) {
-    DeferredCallManager::instance().update(deltaTime);
+    //The deferred calls can create and write resources, which the render
+    //thread can't be using meanwhile
+    auto& deferredCalls = DeferredCallManager::instance();
+    if (!deferredCalls.empty()) {
+      m_framePipeline->waitForDevice();
+    }
+    deferredCalls.update(deltaTime);
+    if (TextureStreamer::isStarted()) {
+      //The new mips are uploaded by the render commands of this frame
+      TextureStreamer::instance().update(m_framePipeline.get());
+    }
     onUpdate(deltaTime);
   }
 
@@ -536,9 +669,7 @@ namespace geEngineSDK {
 
   void
   GE_COREBASE_CLASS::setWindow(WindowBase* window) {
-    auto& gameConfig = GameConfig::instance();
-    bool bCreateWindow = gameConfig.get<bool>("WINDOW", "CREATEWINDOW", true);
-    if (bCreateWindow) {
+    if (m_cfgCreateWindow) {
       return;
     }
     m_window = window;
@@ -26,7 +26,16 @@
 #include <geSphere.h>
 
 namespace geEngineSDK {
-  DebugDraw::DebugDraw() {
+  namespace {
+    atomic<uint64> s_nextInstanceId(1);
+
+    //Buffer of the calling thread, valid while the id matches the instance
+    GE_THREADLOCAL uint64 t_bufferInstanceId = 0;
+    GE_THREADLOCAL void* t_buffer = nullptr;
+  }
+
+  DebugDraw::DebugDraw()
+    : m_instanceId(s_nextInstanceId.fetch_add(1)) {
     auto& renderAPI = RenderAPI::instance();
 
     if (!renderAPI.isStarted()) {
@@ -34,7 +43,7 @@ namespace geEngineSDK {
                 "RenderAPI module must be started before DebugDraw.");
     }
 
-    m_frameData.resize(DEBUG_CACHE_OBJECTS_NUM);
+    m_frameData.reserve(DEBUG_CACHE_OBJECTS_NUM);
 
     /*
     m_debugPass = ge_shared_ptr_new<Pass>("Data/Shaders/DebugShader.hlsl", "DebugVS", nullptr,
@@ -46,41 +55,133 @@ namespace geEngineSDK {
     //Create a vertex declaration for the debug vertices
     using VET = VERTEX_ELEMENT_TYPE::E;
     using VES = VERTEX_ELEMENT_SEMANTIC::E;
-    auto debugVertexDecl = renderAPI.createVertexDeclaration(
+    m_vertexDecl = renderAPI.createVertexDeclaration(
     {
       VertexElement(0, 0, VET::FLOAT3, VES::POSITION),
       VertexElement(0, 12, VET::COLOR_ABGR, VES::COLOR)
     });
 
-    SIZE_T bufferSize = DEBUG_CACHE_OBJECTS_NUM * sizeof(DEBUG_VERTEX);
-    m_frameVB = renderAPI.createVertexBuffer(debugVertexDecl,
-                                             bufferSize,
+    m_vbCapacity = DEBUG_CACHE_OBJECTS_NUM;
+    m_frameVB = renderAPI.createVertexBuffer(m_vertexDecl,
+                                             m_vbCapacity * sizeof(DEBUG_VERTEX),
                                              nullptr,
                                              RESOURCE_USAGE::DYNAMIC);
   }
 
+  DebugDraw::ThreadBuffer&
+  DebugDraw::getThreadBuffer() {
+    if (t_bufferInstanceId == m_instanceId) {
+      return *static_cast<ThreadBuffer*>(t_buffer);
+    }
+
+    const ThreadId threadId = GE_THREAD_CURRENT_ID;
+
+    Lock lock(m_threadBuffersMutex);
+    auto it = std::find_if(m_threadBuffers.begin(), m_threadBuffers.end(),
+      [&threadId](const UPtr<ThreadBuffer>& buffer) { return buffer->owner == threadId; });
+    if (it == m_threadBuffers.end()) {
+      m_threadBuffers.push_back(ge_unique_ptr_new<ThreadBuffer>());
+      m_threadBuffers.back()->owner = threadId;
+      it = m_threadBuffers.end() - 1;
+    }
+
+    t_bufferInstanceId = m_instanceId;
+    t_buffer = it->get();
+    return **it;
+  }
+
   void
-  DebugDraw::update() {
-    GE_ASSERT(m_numFrameObjsInUse < DEBUG_CACHE_OBJECTS_NUM);
+  DebugDraw::update(float deltaTime) {
+    m_time += cast::st<double>(deltaTime);
+
+    //Drop the timed lines that expired, keeping the order of the rest
+    uint32 numKept = 0;
+    for (uint32 i = 0; i < m_persistentExpiry.size(); ++i) {
+      if (m_persistentExpiry[i] < m_time) {
+        continue;
+      }
+
+      m_persistentExpiry[numKept] = m_persistentExpiry[i];
+      m_persistentData[numKept * 2] = m_persistentData[i * 2];
+      m_persistentData[numKept * 2 + 1] = m_persistentData[i * 2 + 1];
+      ++numKept;
+    }
+    m_persistentExpiry.resize(numKept);
+    m_persistentData.resize(numKept * 2);
+
+    //Take the lines of every thread, they keep adding to an empty buffer
+    //while these are sorted out
+    Lock lock(m_threadBuffersMutex);
+    for (auto& threadBuffer : m_threadBuffers) {
+      m_collected.clear();
+      {
+        ScopedSpinLock spinLock(threadBuffer->lock);
+        std::swap(m_collected, threadBuffer->lines);
+      }
+
+      for (const auto& line : m_collected) {
+        if (0.0f == line.duration) {
+          m_frameData.emplace_back(line.posA, line.color);
+          m_frameData.emplace_back(line.posB, line.color);
+        }
+        else {
+          m_persistentData.emplace_back(line.posA, line.color);
+          m_persistentData.emplace_back(line.posB, line.color);
+          m_persistentExpiry.push_back(m_time + cast::st<double>(line.duration));
+        }
+      }
+    }
+    lock.unlock();
+
+    uploadVertices();
+  }
 
-    if (0 == m_numFrameObjsInUse) {
+  void
+  DebugDraw::uploadVertices() {
+    const uint32 numFrameVertices = cast::st<uint32>(m_frameData.size());
+    m_numVertices = numFrameVertices + cast::st<uint32>(m_persistentData.size());
+    if (0 == m_numVertices) {
       return;
     }
 
-    //Update the buffer with the data of the lines
     auto& renderAPI = RenderAPI::instance();
-    
-    MappedSubresource mappedRes;
-    ge_zero_out(mappedRes);
 
-    mappedRes = renderAPI.map(m_frameVB);
-    memcpy(mappedRes.pData, m_frameData.data(), m_numFrameObjsInUse * sizeof(DEBUG_VERTEX));
+    //Grow in whole chunks, big enough for a few frames like this one
+    if (m_numVertices > m_vbCapacity) {
+      const uint32 needed = m_numVertices * RING_FRAMES;
+      m_vbCapacity = ((needed + VERTEX_CHUNK_SIZE - 1) / VERTEX_CHUNK_SIZE) * VERTEX_CHUNK_SIZE;
+      m_frameVB = renderAPI.createVertexBuffer(m_vertexDecl,
+                                               m_vbCapacity * sizeof(DEBUG_VERTEX),
+                                               nullptr,
+                                               RESOURCE_USAGE::DYNAMIC);
+      m_vbOffset = m_vbCapacity;
+    }
+
+    //Append after the previous frames while they fit, the GPU may still be
+    //reading those. Start over on a discarded buffer when they don't.
+    MAP_TYPE::E mapType = MAP_TYPE::WRITE_NO_OVERWRITE;
+    if (m_vbOffset + m_numVertices > m_vbCapacity) {
+      mapType = MAP_TYPE::WRITE_DISCARD;
+      m_vbOffset = 0;
+    }
+
+    MappedSubresource mappedRes = renderAPI.map(m_frameVB, 0, mapType);
+    if (nullptr != mappedRes.pData) {
+      auto* vertices = reinterpret_cast<DEBUG_VERTEX*>(mappedRes.pData) + m_vbOffset;
+      memcpy(vertices, m_frameData.data(), numFrameVertices * sizeof(DEBUG_VERTEX));
+      memcpy(vertices + numFrameVertices,
+             m_persistentData.data(),
+             m_persistentData.size() * sizeof(DEBUG_VERTEX));
+    }
     renderAPI.unmap(m_frameVB);
+
+    m_drawFirstVertex = m_vbOffset;
+    m_vbOffset += m_numVertices;
   }
 
   void
   DebugDraw::draw() {
-    if (0 == m_numFrameObjsInUse) {
+    if (0 == m_numVertices) {
       return;
     }
 
@@ -91,33 +192,43 @@ namespace geEngineSDK {
     
     //m_debugPass->setPass();
 
-    renderAPI.draw(m_numFrameObjsInUse);
+    renderAPI.draw(m_numVertices, m_drawFirstVertex);
   }
 
   void
   DebugDraw::reset() {
-    //Resets the counter for the frame objects
-    m_numFrameObjsInUse = 0;
+    //Drops the frame objects, the timed ones are dropped by update()
+    m_frameData.clear();
   }
 
   void
-    DebugDraw::addLine(const Vector3& posA,
-                       const Vector3& posB,
-                       Color color,
-                       float duration) {
-    GE_ASSERT(m_numFrameObjsInUse + 2 < DEBUG_CACHE_OBJECTS_NUM);
-    if (0.0f == duration) { //This is a frame only line
-      m_frameData[m_numFrameObjsInUse++] = { posA, color };
-      m_frameData[m_numFrameObjsInUse++] = { posB, color };
+  DebugDraw::clear() {
+    Lock lock(m_threadBuffersMutex);
+    for (auto& threadBuffer : m_threadBuffers) {
+      ScopedSpinLock spinLock(threadBuffer->lock);
+      threadBuffer->lines.clear();
     }
+
+    m_frameData.clear();
+    m_persistentData.clear();
+    m_persistentExpiry.clear();
+    m_numVertices = 0;
+  }
+
+  void
+  DebugDraw::addLine(const Vector3& posA,
+                     const Vector3& posB,
+                     Color color,
+                     float duration) {
+    auto& buffer = getThreadBuffer();
+    ScopedSpinLock lock(buffer.lock);
+    buffer.lines.push_back({ posA, posB, color, duration });
   }
 
   void
   DebugDraw::addBox(const AABox& box,
                     Color color,
                     float duration) {
-    GE_UNREFERENCED_PARAMETER(duration);
-
     Vector3 Vertices[8] =
     {
       Vector3(box.m_min),
@@ -130,23 +241,21 @@ namespace geEngineSDK {
       Vector3(box.m_max)
     };
 
-    //Bottom frame of the box
-    addLine(Vertices[0], Vertices[2], color);
-    addLine(Vertices[0], Vertices[3], color);
-    addLine(Vertices[2], Vertices[4], color);
-    addLine(Vertices[3], Vertices[4], color);
-
-    //Top frame of the box
-    addLine(Vertices[7], Vertices[5], color);
-    addLine(Vertices[7], Vertices[6], color);
-    addLine(Vertices[5], Vertices[1], color);
-    addLine(Vertices[6], Vertices[1], color);
-
-    //Side frames of the box
-    addLine(Vertices[0], Vertices[1], color);
-    addLine(Vertices[2], Vertices[6], color);
-    addLine(Vertices[3], Vertices[5], color);
-    addLine(Vertices[7], Vertices[4], color);
+    const uint32 edges[12][2] =
+    {
+      //Bottom frame of the box
+      { 0, 2 }, { 0, 3 }, { 2, 4 }, { 3, 4 },
+      //Top frame of the box
+      { 7, 5 }, { 7, 6 }, { 5, 1 }, { 6, 1 },
+      //Side frames of the box
+      { 0, 1 }, { 2, 6 }, { 3, 5 }, { 7, 4 }
+    };
+
+    auto& buffer = getThreadBuffer();
+    ScopedSpinLock lock(buffer.lock);
+    for (const auto& edge : edges) {
+      buffer.lines.push_back({ Vertices[edge[0]], Vertices[edge[1]], color, duration });
+    }
   }
 
   void
@@ -154,8 +263,6 @@ namespace geEngineSDK {
                        uint32 numSegments,
                        Color color,
                        float duration) {
-    GE_UNREFERENCED_PARAMETER(duration);
-
     numSegments = Math::clamp(numSegments, 3u, 32u);
 
     const Vector3& center = sphere.m_center;
@@ -163,6 +270,9 @@ namespace geEngineSDK {
 
     const float step = Math::TWO_PI / cast::st<float>(numSegments);
 
+    auto& buffer = getThreadBuffer();
+    ScopedSpinLock lock(buffer.lock);
+
     for (uint32 i = 0; i < numSegments; ++i) {
       const float angle0 = step * cast::st<float>(i);
       const float angle1 = step * cast::st<float>(i + 1);
@@ -182,7 +292,7 @@ namespace geEngineSDK {
                    center.y + sin1 * radius,
                    center.z);
 
-        addLine(p0, p1, color, duration);
+        buffer.lines.push_back({ p0, p1, color, duration });
       }
 
       //Circle on XZ plane
@@ -195,7 +305,7 @@ namespace geEngineSDK {
                    center.y,
                    center.z + sin1 * radius);
 
-        addLine(p0, p1, color, duration);
+        buffer.lines.push_back({ p0, p1, color, duration });
       }
 
       // Circle on YZ plane
@@ -208,7 +318,7 @@ namespace geEngineSDK {
                    center.y + cos1 * radius,
                    center.z + sin1 * radius);
 
-        addLine(p0, p1, color, duration);
+        buffer.lines.push_back({ p0, p1, color, duration });
       }
     }
   }
@@ -222,8 +332,6 @@ namespace geEngineSDK {
                      float cellSize,
                      Color color,
                      float duration) {
-    GE_UNREFERENCED_PARAMETER(duration);
-
     //Calculate the half size of the grid
     float halfSize = cellSize * 0.5f;
 
@@ -232,21 +340,43 @@ namespace geEngineSDK {
       (up * halfSize * cast::st<float>(numRows)) -
       (right * halfSize * cast::st<float>(numCols));
 
-    //Add the horizontal lines
+    auto& buffer = getThreadBuffer();
+    ScopedSpinLock lock(buffer.lock);
+
+    //Add the lines along up, one per column edge
     Vector3 start = startPos;
     for (uint32 i = 0; i <= numCols; ++i) {
-      Vector3 end = start + (up * cellSize * static_cast<float>(numCols));
-      addLine(start, end, color);
+      Vector3 end = start + (up * cellSize * cast::st<float>(numRows));
+      buffer.lines.push_back({ start, end, color, duration });
       start += (right * cellSize);
     }
 
-    //Add the vertical lines
+    //Add the lines along right, one per row edge
     start = startPos;
     for (uint32 i = 0; i <= numRows; ++i) {
-      Vector3 end = start + (right * cellSize * static_cast<float>(numRows));
-      addLine(start, end, color);
+      Vector3 end = start + (right * cellSize * cast::st<float>(numCols));
+      buffer.lines.push_back({ start, end, color, duration });
       start += (up * cellSize);
     }
   }
 
+  void
+  DebugDraw::addMesh(const Vector<Vector3>& vertices,
+                     const Vector<uint32>& indices,
+                     Color color,
+                     float duration) {
+    auto& buffer = getThreadBuffer();
+    ScopedSpinLock lock(buffer.lock);
+
+    //Wireframe of a triangle list, the shared edges are drawn twice
+    for (SIZE_T i = 0; i + 2 < indices.size(); i += 3) {
+      const Vector3& p0 = vertices[indices[i]];
+      const Vector3& p1 = vertices[indices[i + 1]];
+      const Vector3& p2 = vertices[indices[i + 2]];
+      buffer.lines.push_back({ p0, p1, color, duration });
+      buffer.lines.push_back({ p1, p2, color, duration });
+      buffer.lines.push_back({ p2, p0, color, duration });
+    }
+  }
+
 } // namespace geEngineSDK
@@ -20,16 +20,33 @@
 #include "geDeferredCallManager.h"
 #include <geMath.h>
 #include <geTimer.h>
+#include <geProfiler.h>
+#include <geException.h>
 
 namespace geEngineSDK {
+  namespace {
+    /**
+     * Calls run between two reads of the timer, at most.
+     */
+    CONSTEXPR uint32 MAX_CALLS_BETWEEN_CHECKS = 16;
+
+    CONSTEXPR uint64 FREE_INDEX_MASK = 0xFFFFFFFFull;
+    CONSTEXPR uint64 FREE_COUNTER_ONE = 0x100000000ull;
+  }
+
   DeferredCallManager::~DeferredCallManager() {
     clear();
+
+    const uint32 numChunks = m_numChunks.load(std::memory_order_acquire);
+    for (uint32 i = 0; i < numChunks; ++i) {
+      ge_delete(m_chunks[i].load(std::memory_order_relaxed));
+    }
   }
 
   void
   DeferredCallManager::update(float deltaTime) {
     uint64 budgetUs = Math::clamp(cast::st<uint64>(deltaTime *
-                                    DEFERRED_BUDGET_RATIO * 1000.0f),
+                                    DEFERRED_BUDGET_RATIO * 1000000.0f),
                                   MIN_DEFERRED_BUDGET_US,
                                   MAX_DEFERRED_BUDGET_US);
     pumpFor(budgetUs);
@@ -37,20 +54,172 @@ namespace geEngineSDK {
 
   uint32
   DeferredCallManager::pumpFor(uint64 budgetUs) {
+    GE_PROFILE_SCOPE("DeferredCalls");
+
     uint32 executed = 0;
+    uint32 nextCheck = 1;
+    uint64 elapsedUs = 0;
     Timer timer;
 
-    while (!m_tasks.empty()) {
-      if (timer.getMicroseconds() >= budgetUs) {
-        break;
+    for (auto& lane : m_lanes) {
+      while (elapsedUs < budgetUs) {
+        Call* call = popFromLane(lane);
+        if (nullptr == call) {
+          break;
+        }
+
+        m_numPending.fetch_sub(1, std::memory_order_release);
+        call->run(call->storage, true);
+        freeCall(call);
+
+        if (++executed < nextCheck) {
+          continue;
+        }
+
+        //Checks again once the calls run so far say the budget may be spent
+        elapsedUs = timer.getMicroseconds();
+        const uint64 usPerCall = std::max(elapsedUs / executed, uint64(1));
+        const uint64 callsLeft = elapsedUs < budgetUs ?
+                                   (budgetUs - elapsedUs) / usPerCall : 0;
+        nextCheck = executed + Math::clamp(cast::st<uint32>(callsLeft / 2),
+                                           1U,
+                                           MAX_CALLS_BETWEEN_CHECKS);
       }
+    }
 
-      auto t = std::move(m_tasks.back());
-      m_tasks.pop_back();
-      t();
-      ++executed;
+    elapsedUs = timer.getMicroseconds();
+
+    DeferredCallStats& stats = m_lastFrameStats;
+    stats.numExecuted = executed;
+    stats.numRemaining = cast::st<uint32>(size());
+    stats.budgetUs = budgetUs;
+    stats.elapsedUs = elapsedUs;
+    stats.overrunUs = elapsedUs > budgetUs ? elapsedUs - budgetUs : 0;
+    if (stats.overrunUs > 0) {
+      ++stats.totalOverruns;
     }
 
     return executed;
   }
+
+  void
+  DeferredCallManager::clear() {
+    for (auto& lane : m_lanes) {
+      while (Call* call = popFromLane(lane)) {
+        m_numPending.fetch_sub(1, std::memory_order_release);
+        call->run(call->storage, false);
+        freeCall(call);
+      }
+    }
+  }
+
+  DeferredCallManager::Call*
+  DeferredCallManager::getCall(uint32 index) const {
+    Chunk* chunk = m_chunks[index / CALLS_PER_CHUNK].load(std::memory_order_acquire);
+    return &chunk->calls[index % CALLS_PER_CHUNK];
+  }
+
+  DeferredCallManager::Call*
+  DeferredCallManager::allocateCall() {
+    uint64 head = m_freeHead.load(std::memory_order_acquire);
+    while (INVALID_CALL != (head & FREE_INDEX_MASK)) {
+      Call* call = getCall(cast::st<uint32>(head & FREE_INDEX_MASK));
+      const uint64 next = call->nextFree.load(std::memory_order_relaxed);
+      const uint64 newHead = ((head & ~FREE_INDEX_MASK) + FREE_COUNTER_ONE) | next;
+      if (m_freeHead.compare_exchange_weak(head,
+                                           newHead,
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+        return call;
+      }
+    }
+
+    //No free call, a new chunk is added. Another thread may have added one
+    //meanwhile, but a few spare calls are harmless
+    Lock lock(m_chunkMutex);
+    const uint32 chunkIndex = m_numChunks.load(std::memory_order_relaxed);
+    if (chunkIndex >= MAX_CHUNKS) {
+      GE_EXCEPT(InternalErrorException,
+                "Too many deferred calls queued: " +
+                toString(MAX_CHUNKS * CALLS_PER_CHUNK));
+    }
+
+    Chunk* chunk = ge_new<Chunk>();
+    for (uint32 i = 0; i < CALLS_PER_CHUNK; ++i) {
+      chunk->calls[i].index = chunkIndex * CALLS_PER_CHUNK + i;
+    }
+    m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+    m_numChunks.store(chunkIndex + 1, std::memory_order_release);
+
+    //The first call is returned, the rest are free
+    for (uint32 i = 1; i < CALLS_PER_CHUNK; ++i) {
+      freeCall(&chunk->calls[i]);
+    }
+    return &chunk->calls[0];
+  }
+
+  void
+  DeferredCallManager::freeCall(Call* call) {
+    uint64 head = m_freeHead.load(std::memory_order_relaxed);
+    while (true) {
+      call->nextFree.store(cast::st<uint32>(head & FREE_INDEX_MASK),
+                           std::memory_order_relaxed);
+      const uint64 newHead = ((head & ~FREE_INDEX_MASK) + FREE_COUNTER_ONE) | call->index;
+      if (m_freeHead.compare_exchange_weak(head,
+                                           newHead,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  void
+  DeferredCallManager::push(DEFERRED_PRIORITY::E priority, Call* call) {
+    GE_ASSERT(priority < DEFERRED_PRIORITY::kNumPriorities);
+    m_numPending.fetch_add(1, std::memory_order_release);
+    pushToLane(m_lanes[priority], call);
+  }
+
+  void
+  DeferredCallManager::pushToLane(Lane& lane, Call* call) {
+    call->next.store(nullptr, std::memory_order_relaxed);
+    Call* prev = lane.tail.exchange(call, std::memory_order_acq_rel);
+    prev->next.store(call, std::memory_order_release);
+  }
+
+  DeferredCallManager::Call*
+  DeferredCallManager::popFromLane(Lane& lane) {
+    Call* head = lane.head;
+    Call* next = head->next.load(std::memory_order_acquire);
+
+    //The stub only keeps the lane from being empty
+    if (&lane.stub == head) {
+      if (nullptr == next) {
+        return nullptr;
+      }
+      lane.head = next;
+      head = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (nullptr != next) {
+      lane.head = next;
+      return head;
+    }
+
+    //The last call can only be taken once another one follows it
+    if (head != lane.tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+
+    pushToLane(lane, &lane.stub);
+    next = head->next.load(std::memory_order_acquire);
+    if (nullptr != next) {
+      lane.head = next;
+      return head;
+    }
+
+    return nullptr;
+  }
 }
@@ -21,12 +21,141 @@
 #include "geDiskFileSystem.h"
 
 #include <geFileSystem.h>
+#include <geTaskScheduler.h>
+#include <geThreading.h>
+
+#include <ctime>
 
 namespace geEngineSDK {
+  namespace {
+    CONSTEXPR uint32 INDEX_MAGIC = 0x58444947u; //'GIDX'
+    CONSTEXPR uint32 INDEX_VERSION = 1;
+
+    /**
+     * @brief Calls func(idx) for every index in [0, count). The workers pull
+     *        the next index from a shared counter, since some folders hold a
+     *        lot more entries than others.
+     */
+    void
+    parallelForEach(uint32 count, const function<void(uint32)>& func) {
+      if (TaskScheduler::isStarted()) {
+        parallelForChunks("DiskFileSystem", count, 1, [&func](uint32 begin, uint32 end) {
+          for (uint32 idx = begin; idx < end; ++idx) {
+            func(idx);
+          }
+        });
+        return;
+      }
+
+      //Mounting happens before the engine systems start, so there might not
+      //be a scheduler yet
+      CONSTEXPR uint32 MIN_PER_THREAD = 4;
+
+      atomic<uint32> nextIdx(0);
+      auto worker = [&](uint32) {
+        for (uint32 idx = nextIdx.fetch_add(1, std::memory_order_relaxed);
+             idx < count;
+             idx = nextIdx.fetch_add(1, std::memory_order_relaxed)) {
+          func(idx);
+        }
+      };
+
+      const uint32 numThreads = std::min(GE_THREAD_HARDWARE_CONCURRENCY,
+                                         count / MIN_PER_THREAD);
+      Vector<Thread> threads;
+      for (uint32 i = 1; i < numThreads; ++i) {
+        threads.emplace_back(worker, i);
+      }
+      worker(0);
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    /**
+     * @brief Bounds checked reads over the contents of an index file.
+     */
+    struct IndexReader
+    {
+      const uint8* data;
+      SIZE_T size;
+      SIZE_T offset = 0;
+
+      template<typename T>
+      bool
+      read(T& value) {
+        if (size - offset < sizeof(T)) {
+          return false;
+        }
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+      }
+
+      bool
+      read(String& value) {
+        uint32 length;
+        if (!read(length) || size - offset < length) {
+          return false;
+        }
+        value.assign(reinterpret_cast<const ANSICHAR*>(data + offset), length);
+        offset += length;
+        return true;
+      }
+
+      bool
+      read(Vector<String>& values) {
+        uint32 count;
+        if (!read(count) || size - offset < count * sizeof(uint32)) {
+          return false;
+        }
+        values.resize(count);
+        for (auto& value : values) {
+          if (!read(value)) {
+            return false;
+          }
+        }
+        return true;
+      }
+    };
+
+    struct IndexWriter
+    {
+      Vector<uint8> data;
+
+      template<typename T>
+      void
+      write(const T& value) {
+        const auto* bytes = reinterpret_cast<const uint8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+      }
 
-  DiskFileSystem::DiskFileSystem(const Path& rootPath)
-    : m_root(rootPath)
-  {}
+      void
+      write(const String& value) {
+        write(cast::st<uint32>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+      }
+
+      void
+      write(const Vector<String>& values) {
+        write(cast::st<uint32>(values.size()));
+        for (const auto& value : values) {
+          write(value);
+        }
+      }
+    };
+  }
+
+  DiskFileSystem::DiskFileSystem(const Path& rootPath, const Path& indexCachePath)
+    : m_root(rootPath),
+      m_rootString(rootPath.toString()),
+      m_indexCachePath(indexCachePath) {
+    //The root is always a folder, even if it was given without the separator
+    if (!m_rootString.empty() &&
+        '/' != m_rootString.back() && '\\' != m_rootString.back()) {
+      m_rootString += '/';
+    }
+  }
 
   bool
   DiskFileSystem::exists(const Path& path) const {
@@ -46,34 +175,161 @@ namespace geEngineSDK {
 
   Vector<Path>
   DiskFileSystem::getAllFiles() const {
+    DirectoryIndex cachedIndex;
+    time_t cachedScanTime = 0;
+    if (!m_indexCachePath.isEmpty()) {
+      _loadIndex(cachedIndex, cachedScanTime);
+    }
+
+    const time_t scanTime = std::time(nullptr);
+
+    //Breadth first, one level of folders at a time
+    Vector<DirectoryEntry> directories;
+    Vector<String> pending = { String() };
+    while (!pending.empty()) {
+      const SIZE_T levelStart = directories.size();
+      directories.resize(levelStart + pending.size());
+
+      parallelForEach(cast::st<uint32>(pending.size()), [&](uint32 idx) {
+        _readDirectory(pending[idx],
+                       cachedIndex,
+                       cachedScanTime,
+                       directories[levelStart + idx]);
+      });
+
+      pending.clear();
+      for (SIZE_T i = levelStart; i < directories.size(); ++i) {
+        for (const auto& dirName : directories[i].directories) {
+          pending.push_back(directories[i].relativePath + dirName + '/');
+        }
+      }
+    }
+
+    if (!m_indexCachePath.isEmpty()) {
+      _saveIndex(directories, scanTime);
+    }
+
+    SIZE_T numFiles = 0;
+    for (const auto& directory : directories) {
+      numFiles += directory.files.size();
+    }
+
     Vector<Path> outFiles;
-    _recursiveCollectFiles(m_root, m_root, outFiles);
+    outFiles.reserve(numFiles);
+    for (const auto& directory : directories) {
+      for (const auto& fileName : directory.files) {
+        outFiles.emplace_back(directory.relativePath + fileName);
+      }
+    }
+
     return outFiles;
   }
 
   void
-  DiskFileSystem::_recursiveCollectFiles(const Path& currentPath,
-                                        const Path& relativePath,
-                                        Vector<Path>& outFiles) const {
-    Path dirPath = currentPath;
-    
-    auto strPath = dirPath.toString();
-    auto lastChar = strPath[strPath.size()];
-    if(lastChar != '\\' && lastChar != '/'){
-      dirPath = strPath + '/';
+  DiskFileSystem::_readDirectory(const String& relativePath,
+                                 DirectoryIndex& cachedIndex,
+                                 time_t cachedScanTime,
+                                 DirectoryEntry& outEntry) const {
+    const Path fullPath(m_rootString + relativePath);
+
+    //Every folder is visited by a single worker, so taking its entry out of
+    //the cache doesn't race with the others
+    auto it = cachedIndex.find(relativePath);
+    if (it != cachedIndex.end()) {
+      //A folder changed on the same second the cache was built might have
+      //been read before the change, so only older times can be trusted
+      const time_t lastModifiedTime = FileSystem::getLastModifiedTime(fullPath);
+      if (0 != lastModifiedTime &&
+          lastModifiedTime == it->second.lastModifiedTime &&
+          lastModifiedTime < cachedScanTime) {
+        outEntry = std::move(it->second);
+        return;
+      }
+    }
+
+    outEntry.relativePath = relativePath;
+    FileSystem::readDirectory(fullPath,
+                              outEntry.files,
+                              outEntry.directories,
+                              outEntry.lastModifiedTime);
+  }
+
+  bool
+  DiskFileSystem::_loadIndex(DirectoryIndex& outIndex, time_t& outScanTime) const {
+    if (!FileSystem::isFile(m_indexCachePath)) {
+      return false;
     }
-    
-    Vector<Path> files, directories;
-    FileSystem::getChildren(dirPath, files, directories);
-    for (const auto& file : files) {
-      outFiles.push_back(file.getRelative(relativePath));
+
+    auto pStream = FileSystem::openFile(m_indexCachePath, true);
+    if (!pStream) {
+      return false;
+    }
+
+    Vector<uint8> contents(pStream->size());
+    const SIZE_T bytesRead = pStream->read(contents.data(), contents.size());
+    pStream->close();
+
+    IndexReader reader{ contents.data(), bytesRead };
+    uint32 magic = 0, version = 0, numDirectories = 0;
+    String root;
+    int64 scanTime = 0;
+    if (!reader.read(magic) || INDEX_MAGIC != magic ||
+        !reader.read(version) || INDEX_VERSION != version ||
+        !reader.read(root) || root != m_rootString ||
+        !reader.read(scanTime) ||
+        !reader.read(numDirectories)) {
+      return false;
+    }
+
+    outIndex.reserve(numDirectories);
+    for (uint32 i = 0; i < numDirectories; ++i) {
+      DirectoryEntry entry;
+      int64 lastModifiedTime = 0;
+      if (!reader.read(entry.relativePath) ||
+          !reader.read(lastModifiedTime) ||
+          !reader.read(entry.files) ||
+          !reader.read(entry.directories)) {
+        outIndex.clear();
+        return false;
+      }
+
+      entry.lastModifiedTime = static_cast<time_t>(lastModifiedTime);
+      String key = entry.relativePath;
+      outIndex.emplace(std::move(key), std::move(entry));
+    }
+
+    outScanTime = static_cast<time_t>(scanTime);
+    return true;
+  }
+
+  void
+  DiskFileSystem::_saveIndex(const Vector<DirectoryEntry>& directories,
+                             time_t scanTime) const {
+    IndexWriter writer;
+    writer.write(INDEX_MAGIC);
+    writer.write(INDEX_VERSION);
+    writer.write(m_rootString);
+    writer.write(static_cast<int64>(scanTime));
+    writer.write(cast::st<uint32>(directories.size()));
+    for (const auto& directory : directories) {
+      writer.write(directory.relativePath);
+      writer.write(static_cast<int64>(directory.lastModifiedTime));
+      writer.write(directory.files);
+      writer.write(directory.directories);
     }
 
-    for (const auto& dir : directories) {
-      // Recursively collect files from subdirectories
-      _recursiveCollectFiles(dir, m_root, outFiles);
+    FileSystem::createDir(m_indexCachePath);
+    auto pStream = FileSystem::createAndOpenFile(m_indexCachePath);
+    if (!pStream) {
+      GE_LOG(kWarning,
+             Generic,
+             "Could not write the mount index: {0}",
+             m_indexCachePath.toString());
+      return;
     }
 
+    pStream->write(writer.data.data(), writer.data.size());
+    pStream->close();
   }
 
 }
@@ -0,0 +1,155 @@
+/*****************************************************************************/
+/**
+ * @file    geFramePipeline.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Overlaps the simulation of a frame with the render of the last.
+ *
+ * Overlaps the simulation of a frame with the render of the last.
+ *
+ * @bug	    No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geFramePipeline.h"
+
+#include <geProfiler.h>
+#include <geStackAlloc.h>
+
+namespace geEngineSDK {
+  FramePipeline::FramePipeline(uint32 latency)
+    : m_latency(std::min(latency, MAX_LATENCY)),
+      m_simThread(GE_THREAD_CURRENT_ID) {
+    if (m_latency > 0) {
+      m_renderThread = Thread([this]() { renderThreadMain(); });
+    }
+  }
+
+  FramePipeline::~FramePipeline() {
+    if (m_latency > 0) {
+      {
+        Lock lock(m_mutex);
+        m_bStop = true;
+      }
+      m_frameSubmitted.notify_one();
+      m_renderThread.join();
+    }
+  }
+
+  void
+  FramePipeline::enqueue(Command command) {
+    m_recording.push_back(std::move(command));
+  }
+
+  void
+  FramePipeline::submitFrame() {
+    Frame frame;
+    frame.index = m_simFrame;
+    frame.commands.swap(m_recording);
+
+    if (0 == m_latency) {
+      replay(frame);
+      frame.commands.clear();
+      m_recording.swap(frame.commands);
+      ++m_simFrame;
+      m_renderedFrames.store(m_simFrame, std::memory_order_release);
+      return;
+    }
+
+    Lock lock(m_mutex);
+    m_submitted.push_back(std::move(frame));
+    if (!m_freeLists.empty()) {
+      m_recording.swap(m_freeLists.back());
+      m_freeLists.pop_back();
+    }
+    ++m_simFrame;
+    m_frameSubmitted.notify_one();
+
+    //The next frame can't reuse the slot of a frame still being rendered
+    m_frameRendered.wait(lock, [this]() {
+      return m_simFrame - m_renderedFrames.load(std::memory_order_relaxed) <= m_latency;
+    });
+  }
+
+  void
+  FramePipeline::flush() {
+    if (0 == m_latency) {
+      return;
+    }
+
+    Lock lock(m_mutex);
+    m_frameRendered.wait(lock, [this]() {
+      return m_renderedFrames.load(std::memory_order_relaxed) == m_simFrame;
+    });
+  }
+
+  bool
+  FramePipeline::isRenderThread() const {
+    if (0 == m_latency) {
+      return GE_THREAD_CURRENT_ID == m_simThread;
+    }
+    return GE_THREAD_CURRENT_ID == m_renderThread.get_id();
+  }
+
+  void
+  FramePipeline::waitForDevice() {
+    if (isRenderThread()) {
+      return;
+    }
+
+    GE_ASSERT(GE_THREAD_CURRENT_ID == m_simThread &&
+              "Only the simulation and the render threads can use the device");
+
+    //The render thread stays idle until the simulation submits again
+    flush();
+  }
+
+  void
+  FramePipeline::renderThreadMain() {
+    if (Profiler::isStarted()) {
+      Profiler::instance().setThreadName("Render");
+    }
+    MemStack::beginThread();
+
+    Lock lock(m_mutex);
+    while (true) {
+      m_frameSubmitted.wait(lock, [this]() {
+        return m_bStop || !m_submitted.empty();
+      });
+
+      //Stops once the submitted frames are rendered
+      if (m_submitted.empty()) {
+        break;
+      }
+
+      Frame frame = std::move(m_submitted.front());
+      m_submitted.pop_front();
+
+      lock.unlock();
+      replay(frame);
+      frame.commands.clear();
+      lock.lock();
+
+      m_freeLists.push_back(std::move(frame.commands));
+      m_renderedFrames.store(frame.index + 1, std::memory_order_release);
+      m_frameRendered.notify_all();
+    }
+
+    lock.unlock();
+    MemStack::endThread();
+  }
+
+  void
+  FramePipeline::replay(Frame& frame) {
+    GE_PROFILE_SCOPE("RenderFrame");
+    m_renderSlot = cast::st<uint32>(frame.index % getNumSlots());
+    for (auto& command : frame.commands) {
+      command();
+    }
+  }
+}
@@ -18,41 +18,251 @@
 /*****************************************************************************/
 #include "geGameConfig.h"
 #include <geMountManager.h>
+#include <geDebug.h>
 
 namespace geEngineSDK {
+  namespace {
+    FORCEINLINE bool
+    isBlank(char c) {
+      return ' ' == c || '\t' == c || '\r' == c;
+    }
+
+    /**
+     * @brief Shrinks [begin, end) so it doesn't start or end with blanks.
+     */
+    FORCEINLINE void
+    trimRange(const String& text, SIZE_T& begin, SIZE_T& end) {
+      while (begin < end && isBlank(text[begin])) {
+        ++begin;
+      }
+      while (end > begin && isBlank(text[end - 1])) {
+        --end;
+      }
+    }
+  }
+
+  HEvent
+  ConfigSlot::connect(function<void()> func) {
+    if (!m_onChanged) {
+      m_onChanged = ge_shared_ptr_new<Event<void()>>();
+    }
+    return m_onChanged->connect(std::move(func));
+  }
+
+  GameConfig::~GameConfig() {
+    for (auto pBlock : m_slotBlocks) {
+      ge_deleteN(pBlock, SLOTS_PER_BLOCK);
+    }
+  }
+
   bool
   GameConfig::load(const Path& filePath) {
-    //Load the file and parse it in lines, remove the empty lines and comments
+    if (!parseFile(filePath)) {
+      return false;
+    }
+
+    if (std::find(m_loadedFiles.begin(), m_loadedFiles.end(), filePath) ==
+        m_loadedFiles.end()) {
+      m_loadedFiles.push_back(filePath);
+    }
+
+    refreshSlots();
+    return true;
+  }
+
+  bool
+  GameConfig::reload() {
+    m_configData.clear();
+
+    bool bAllLoaded = true;
+    for (const auto& filePath : m_loadedFiles) {
+      if (!parseFile(filePath)) {
+        GE_LOG(kWarning, Generic, "Failed to reload config file: {0}", filePath.toString());
+        bAllLoaded = false;
+      }
+    }
+
+    refreshSlots();
+    onReloaded();
+    return bAllLoaded;
+  }
+
+  bool
+  GameConfig::parseFile(const Path& filePath) {
     auto pFile = MountManager::instance().open(filePath);
     if (!pFile) {
       return false;
     }
-    auto fileContent = pFile->getAsString();
+    const String fileContent = pFile->getAsString();
+    const SIZE_T contentSize = fileContent.size();
 
-    auto splitLines = StringUtil::split(fileContent, "\n");
+    //Walk the lines in place, skipping empty lines and comments
     String currentSection = "GLOBAL";
-    for (auto& line : splitLines) {
-      StringUtil::trim(line);
-      if (line.empty() || line.starts_with("#")) {
+    UnorderedMap<String, String>* pSection = nullptr;
+    SIZE_T lineStart = 0;
+    while (lineStart < contentSize) {
+      SIZE_T lineEnd = fileContent.find('\n', lineStart);
+      if (String::npos == lineEnd) {
+        lineEnd = contentSize;
+      }
+      const SIZE_T nextLine = lineEnd + 1;
+
+      SIZE_T begin = lineStart;
+      SIZE_T end = lineEnd;
+      lineStart = nextLine;
+
+      trimRange(fileContent, begin, end);
+      if (begin == end || '#' == fileContent[begin]) {
         continue;
       }
 
-      if (line.starts_with("[") && line.ends_with("]")) {
-        currentSection = line.substr(1, line.size() - 2);
-        StringUtil::trim(currentSection);
+      if ('[' == fileContent[begin] && ']' == fileContent[end - 1]) {
+        SIZE_T nameBegin = begin + 1;
+        SIZE_T nameEnd = end - 1;
+        trimRange(fileContent, nameBegin, nameEnd);
+        currentSection.assign(fileContent, nameBegin, nameEnd - nameBegin);
         StringUtil::toUpperCase(currentSection);
+        pSection = nullptr;
         continue;
       }
 
-      auto keyValue = StringUtil::split(line, "=");
-      if (keyValue.size() == 2) {
-        StringUtil::trim(keyValue[0]);
-        StringUtil::trim(keyValue[1]);
-        StringUtil::toUpperCase(keyValue[0]);
-        m_configData[currentSection][keyValue[0]] = keyValue[1];
+      const SIZE_T separator = fileContent.find('=', begin);
+      if (String::npos == separator || separator >= end) {
+        continue;
+      }
+
+      SIZE_T keyEnd = separator;
+      SIZE_T valueBegin = separator + 1;
+      trimRange(fileContent, begin, keyEnd);
+      trimRange(fileContent, valueBegin, end);
+      if (begin == keyEnd || valueBegin == end) {
+        continue;
       }
+
+      if (nullptr == pSection) {
+        pSection = &m_configData[currentSection];
+      }
+
+      String key(fileContent, begin, keyEnd - begin);
+      StringUtil::toUpperCase(key);
+      (*pSection)[std::move(key)].assign(fileContent, valueBegin, end - valueBegin);
     }
+
     return true;
   }
 
+  ConfigSlot*
+  GameConfig::resolveSlot(const String& section,
+                          const String& key,
+                          ConfigSlot::TYPE type,
+                          bool& bCreated) {
+    String uppSection = section;
+    String uppKey = key;
+    StringUtil::toUpperCase(uppSection);
+    StringUtil::toUpperCase(uppKey);
+
+    String lookupKey;
+    lookupKey.reserve(uppSection.size() + uppKey.size() + 3);
+    lookupKey += uppSection;
+    lookupKey += '.';
+    lookupKey += uppKey;
+    lookupKey += ':';
+    lookupKey += static_cast<char>('0' + static_cast<uint8>(type));
+
+    auto it = m_slotLookup.find(lookupKey);
+    if (it != m_slotLookup.end()) {
+      bCreated = false;
+      const uint32 index = it->second;
+      return &m_slotBlocks[index / SLOTS_PER_BLOCK][index % SLOTS_PER_BLOCK];
+    }
+
+    const uint32 index = m_numSlots++;
+    if (index / SLOTS_PER_BLOCK >= m_slotBlocks.size()) {
+      m_slotBlocks.push_back(ge_newN<ConfigSlot>(SLOTS_PER_BLOCK));
+    }
+    m_slotLookup.emplace(std::move(lookupKey), index);
+
+    ConfigSlot& slot = m_slotBlocks[index / SLOTS_PER_BLOCK][index % SLOTS_PER_BLOCK];
+    slot.m_section = std::move(uppSection);
+    slot.m_key = std::move(uppKey);
+    slot.m_type = type;
+
+    bCreated = true;
+    return &slot;
+  }
+
+  template<typename T>
+  bool
+  GameConfig::bindValue(ConfigSlot& slot, const String* rawValue) {
+    const T& defaultVal = ConfigSlot::member<T>(slot.m_default);
+    const T newValue = rawValue ? parseValue<T>(*rawValue, defaultVal) : defaultVal;
+    T& value = ConfigSlot::member<T>(slot.m_value);
+    if (value == newValue) {
+      return false;
+    }
+    value = newValue;
+    return true;
+  }
+
+  bool
+  GameConfig::bindSlot(ConfigSlot& slot) {
+    const String* rawValue = nullptr;
+    auto sectionIt = m_configData.find(slot.m_section);
+    if (sectionIt != m_configData.end()) {
+      auto keyIt = sectionIt->second.find(slot.m_key);
+      if (keyIt != sectionIt->second.end()) {
+        rawValue = &keyIt->second;
+      }
+    }
+
+    using TYPE = ConfigSlot::TYPE;
+    switch (slot.m_type) {
+      case TYPE::kBool:
+        return bindValue<bool>(slot, rawValue);
+      case TYPE::kInt32:
+        return bindValue<int32>(slot, rawValue);
+      case TYPE::kUInt32:
+        return bindValue<uint32>(slot, rawValue);
+      case TYPE::kInt64:
+        return bindValue<int64>(slot, rawValue);
+      case TYPE::kUInt64:
+        return bindValue<uint64>(slot, rawValue);
+      case TYPE::kFloat:
+        return bindValue<float>(slot, rawValue);
+      case TYPE::kDouble:
+        return bindValue<double>(slot, rawValue);
+      case TYPE::kString:
+      default:
+      {
+        const String& newValue = rawValue ? *rawValue : slot.m_defaultString;
+        if (slot.m_string == newValue) {
+          return false;
+        }
+        slot.m_string = newValue;
+        return true;
+      }
+    }
+  }
+
+  void
+  GameConfig::refreshSlots(const String* section, const String* key) {
+    //Bind everything first so callbacks see a consistent configuration
+    Vector<ConfigSlot*> changedSlots;
+    for (uint32 i = 0; i < m_numSlots; ++i) {
+      ConfigSlot& slot = m_slotBlocks[i / SLOTS_PER_BLOCK][i % SLOTS_PER_BLOCK];
+      if ((section && slot.m_section != *section) || (key && slot.m_key != *key)) {
+        continue;
+      }
+
+      if (bindSlot(slot) && slot.m_onChanged) {
+        changedSlots.push_back(&slot);
+      }
+    }
+
+    for (auto pSlot : changedSlots) {
+      //Keep the event alive in case a callback disconnects the last handle
+      auto onChanged = pSlot->m_onChanged;
+      (*onChanged)();
+    }
+  }
 }
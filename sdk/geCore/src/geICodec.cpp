@@ -48,6 +48,11 @@ namespace geEngineSDK {
     importResource = cast::re<CodecImportPtr>(codec->getSymbol(CODEC_IMPORT_FN_NAME));
     exportResource = cast::re<CodecExportPtr>(codec->getSymbol(CODEC_EXPORT_FN_NAME));
 
+    //Optional functions
+    importResources = cast::re<CodecImportBatchPtr>(codec->getSymbol(CODEC_IMPORTBATCH_FN_NAME));
+    readMipChain = cast::re<CodecReadMipChainPtr>(codec->getSymbol(CODEC_READMIPCHAIN_FN_NAME));
+    importMips = cast::re<CodecImportMipsPtr>(codec->getSymbol(CODEC_IMPORTMIPS_FN_NAME));
+
     if(getType == nullptr || getVersion == nullptr || getName == nullptr ||
        getDescription == nullptr || getExtensions == nullptr || canImport == nullptr ||
        canExport == nullptr || importResource == nullptr || exportResource == nullptr) {
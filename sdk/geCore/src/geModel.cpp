@@ -34,6 +34,32 @@ namespace geEngineSDK {
     return m_vertexCount > 0 && m_indexCount > 0;
   }
 
+  uint32
+  SubMesh::selectLod(float pixelsPerUnit, float maxPixelError) const {
+    uint32 selected = 0;
+    for (SIZE_T i = 0; i < m_lods.size(); ++i) {
+      if (m_lods[i].m_error * pixelsPerUnit > maxPixelError) {
+        break;
+      }
+      selected = cast::st<uint32>(i + 1);
+    }
+    return selected;
+  }
+
+  void
+  SubMesh::getLodIndexRange(uint32 lod,
+                            uint32& outFirstIndex,
+                            uint32& outIndexCount) const {
+    if (0 == lod || lod > m_lods.size()) {
+      outFirstIndex = m_firstIndex;
+      outIndexCount = m_indexCount;
+      return;
+    }
+
+    outFirstIndex = m_lods[lod - 1].m_firstIndex;
+    outIndexCount = m_lods[lod - 1].m_indexCount;
+  }
+
   /***************************************************************************/
   /**
    * ModelNode
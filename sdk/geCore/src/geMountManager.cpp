@@ -34,7 +34,9 @@ namespace geEngineSDK {
   MountManager::mount(const SPtr<DiskFileSystem>& diskFs) {
     m_diskMounts.push_back(diskFs);
 
-    for (const auto& path : diskFs->getAllFiles()) {
+    const auto files = diskFs->getAllFiles();
+    m_fileIndex.reserve(m_fileIndex.size() + files.size());
+    for (const auto& path : files) {
       _addToIndex(path, FS_TYPE::kDISK, path, diskFs.get());
     }
   }
@@ -44,23 +46,17 @@ namespace geEngineSDK {
                            FS_TYPE::E type,
                            const Path& internalPath,
                            void* backend) {
-    String key = virtualPath.toString();
-    StringUtil::toLowerCase(key);
-    m_fileIndex[key] = { virtualPath, internalPath, type, backend };
+    m_fileIndex[virtualPath] = { virtualPath, internalPath, type, backend };
   }
 
   bool
   MountManager::exists(const Path& path) const {
-    String key = path.toString();
-    StringUtil::toLowerCase(key);
-    return m_fileIndex.find(key) != m_fileIndex.end();
+    return m_fileIndex.find(path) != m_fileIndex.end();
   }
 
   SPtr<DataStream>
   MountManager::open(const Path& path) {
-    String key = path.toString();
-    StringUtil::toLowerCase(key);
-    auto it = m_fileIndex.find(key);
+    auto it = m_fileIndex.find(path);
     if (it == m_fileIndex.end()) {
       return nullptr;
     }
@@ -79,9 +75,7 @@ namespace geEngineSDK {
 
   Path
   MountManager::getRealPath(const Path& virtualPath) const {
-    String key = virtualPath.toString();
-    StringUtil::toLowerCase(key);
-    auto it = m_fileIndex.find(key);
+    auto it = m_fileIndex.find(virtualPath);
     if (it == m_fileIndex.end()) {
       return Path(); // Not found
     }
@@ -90,6 +84,22 @@ namespace geEngineSDK {
     return entry.internalPath;
   }
 
+  void
+  MountManager::refresh(const Path& virtualPath) {
+    //The last mounted disk wins, same as when the index is built
+    for (auto it = m_diskMounts.rbegin(); it != m_diskMounts.rend(); ++it) {
+      if ((*it)->exists(virtualPath)) {
+        _addToIndex(virtualPath, FS_TYPE::kDISK, virtualPath, it->get());
+        return;
+      }
+    }
+
+    auto it = m_fileIndex.find(virtualPath);
+    if (it != m_fileIndex.end() && FS_TYPE::kDISK == it->second.sourceType) {
+      m_fileIndex.erase(it);
+    }
+  }
+
   void
   MountManager::clear() {
     m_zipMounts.clear();
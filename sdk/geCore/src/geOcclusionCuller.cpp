@@ -0,0 +1,717 @@
+/*****************************************************************************/
+/**
+ * @file    geOcclusionCuller.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Software occlusion culling with a low resolution depth buffer.
+ *
+ * Software occlusion culling with a low resolution depth buffer.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geOcclusionCuller.h"
+
+#include <geTaskScheduler.h>
+
+#if USING(GE_ARCHITECTURE_x86_64)
+# include <emmintrin.h>
+#endif
+
+namespace geEngineSDK {
+  namespace {
+    /**
+     * Keeps the boxes that touch an occluder visible when both project to
+     * the same depth, like a wall and the floor it stands on.
+     */
+    CONSTEXPR float DEPTH_BIAS = 1.0e-5f;
+
+    /**
+     * Inside when not negative: near, left, right, bottom and top. The far
+     * plane isn't clipped, the buffer starts at 1 so the pixels past it never
+     * get in.
+     */
+    CONSTEXPR uint32 NUM_CLIP_PLANES = 5;
+
+    FORCEINLINE float
+    clipDistance(const Vector4& v, uint32 plane) {
+      switch (plane) {
+        case 0: return v.z;
+        case 1: return v.w + v.x;
+        case 2: return v.w - v.x;
+        case 3: return v.w + v.y;
+        default: return v.w - v.y;
+      }
+    }
+
+    FORCEINLINE uint32
+    outCode(const Vector4& v) {
+      uint32 code = 0;
+      for (uint32 plane = 0; plane < NUM_CLIP_PLANES; ++plane) {
+        code |= (clipDistance(v, plane) < 0.0f ? 1u : 0u) << plane;
+      }
+      return code;
+    }
+
+    FORCEINLINE Vector4
+    toClip(const Vector3& position, const Matrix4& m) {
+      return Vector4(
+        position.x * m.m[0][0] + position.y * m.m[1][0] + position.z * m.m[2][0] + m.m[3][0],
+        position.x * m.m[0][1] + position.y * m.m[1][1] + position.z * m.m[2][1] + m.m[3][1],
+        position.x * m.m[0][2] + position.y * m.m[1][2] + position.z * m.m[2][2] + m.m[3][2],
+        position.x * m.m[0][3] + position.y * m.m[1][3] + position.z * m.m[2][3] + m.m[3][3]);
+    }
+
+    /**
+     * @brief Projects the corners of a world box to pixels (y going down).
+     * @return false if the box crosses the near plane, and then nothing else
+     *         is written.
+     */
+    bool
+    projectBox(const AABox& box,
+               const Matrix4& viewProj,
+               float width,
+               float height,
+               float& outMinX,
+               float& outMinY,
+               float& outMaxX,
+               float& outMaxY,
+               float& outMinDepth) {
+      outMinX = outMinY = outMinDepth = NumLimit::MAX_FLOAT;
+      outMaxX = outMaxY = -NumLimit::MAX_FLOAT;
+
+      for (uint32 corner = 0; corner < 8; ++corner) {
+        const Vector3 position((corner & 1) ? box.m_max.x : box.m_min.x,
+                               (corner & 2) ? box.m_max.y : box.m_min.y,
+                               (corner & 4) ? box.m_max.z : box.m_min.z);
+        const Vector4 clip = toClip(position, viewProj);
+        if (clip.z < 0.0f || clip.w <= 0.0f) {
+          return false;
+        }
+
+        const float invW = 1.0f / clip.w;
+        const float x = (clip.x * invW * 0.5f + 0.5f) * width;
+        const float y = (0.5f - clip.y * invW * 0.5f) * height;
+        outMinX = Math::min(outMinX, x);
+        outMinY = Math::min(outMinY, y);
+        outMaxX = Math::max(outMaxX, x);
+        outMaxY = Math::max(outMaxY, y);
+        outMinDepth = Math::min(outMinDepth, clip.z * invW);
+      }
+      return true;
+    }
+
+    /**
+     * @brief Writes the nearest of the triangle and the buffer to the pixels
+     *        of the rectangle it covers, four at a time. x0 must be a
+     *        multiple of four and the rows hold whole groups of four.
+     */
+    void
+    rasterizeTriangle(const float edgeA[3],
+                      const float edgeB[3],
+                      const float edgeC[3],
+                      float depthA,
+                      float depthB,
+                      float depthC,
+                      int32 x0,
+                      int32 y0,
+                      int32 x1,
+                      int32 y1,
+                      float* depth,
+                      uint32 pitch) {
+#if USING(GE_ARCHITECTURE_x86_64)
+      const __m128 laneCenters = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 a0 = _mm_set1_ps(edgeA[0]);
+      const __m128 a1 = _mm_set1_ps(edgeA[1]);
+      const __m128 a2 = _mm_set1_ps(edgeA[2]);
+      const __m128 za = _mm_set1_ps(depthA);
+
+      for (int32 y = y0; y <= y1; ++y) {
+        const float py = cast::st<float>(y) + 0.5f;
+        const __m128 row0 = _mm_set1_ps(edgeB[0] * py + edgeC[0]);
+        const __m128 row1 = _mm_set1_ps(edgeB[1] * py + edgeC[1]);
+        const __m128 row2 = _mm_set1_ps(edgeB[2] * py + edgeC[2]);
+        const __m128 rowZ = _mm_set1_ps(depthB * py + depthC);
+        float* pixels = depth + y * pitch;
+
+        for (int32 x = x0; x <= x1; x += 4) {
+          const __m128 px = _mm_add_ps(_mm_set1_ps(cast::st<float>(x)), laneCenters);
+          const __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), row0);
+          const __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), row1);
+          const __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), row2);
+          const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero),
+                                                      _mm_cmpge_ps(e1, zero)),
+                                           _mm_cmpge_ps(e2, zero));
+          if (0 == _mm_movemask_ps(inside)) {
+            continue;
+          }
+
+          const __m128 z = _mm_add_ps(_mm_mul_ps(za, px), rowZ);
+          const __m128 current = _mm_loadu_ps(pixels + x);
+          const __m128 nearest = _mm_min_ps(current, z);
+          _mm_storeu_ps(pixels + x, _mm_or_ps(_mm_and_ps(inside, nearest),
+                                              _mm_andnot_ps(inside, current)));
+        }
+      }
+#else
+      //Same four lanes as the SSE path, written so the compiler can
+      //vectorize them
+      for (int32 y = y0; y <= y1; ++y) {
+        const float py = cast::st<float>(y) + 0.5f;
+        const float row0 = edgeB[0] * py + edgeC[0];
+        const float row1 = edgeB[1] * py + edgeC[1];
+        const float row2 = edgeB[2] * py + edgeC[2];
+        const float rowZ = depthB * py + depthC;
+        float* pixels = depth + y * pitch;
+
+        for (int32 x = x0; x <= x1; x += 4) {
+          for (int32 lane = 0; lane < 4; ++lane) {
+            const float px = cast::st<float>(x + lane) + 0.5f;
+            const bool bInside = edgeA[0] * px + row0 >= 0.0f &&
+                                 edgeA[1] * px + row1 >= 0.0f &&
+                                 edgeA[2] * px + row2 >= 0.0f;
+            const float z = depthA * px + rowZ;
+            float& pixel = pixels[x + lane];
+            pixel = bInside && z < pixel ? z : pixel;
+          }
+        }
+      }
+#endif
+    }
+  }
+
+  OcclusionCuller::OcclusionCuller(uint32 width, uint32 height) {
+    m_binsX = Math::max(1u, (width + BIN_WIDTH - 1) / BIN_WIDTH);
+    m_binsY = Math::max(1u, (height + BIN_HEIGHT - 1) / BIN_HEIGHT);
+    m_width = m_binsX * BIN_WIDTH;
+    m_height = m_binsY * BIN_HEIGHT;
+    m_tilesX = m_width / TILE_SIZE;
+
+    m_bins.resize(m_binsX * m_binsY);
+    m_depth.resize(m_width * m_height, 1.0f);
+    m_tileMaxDepth.resize(m_tilesX * (m_height / TILE_SIZE), 1.0f);
+    m_viewProj = Matrix4::IDENTITY;
+  }
+
+  void
+  OcclusionCuller::beginFrame(const Matrix4& viewProj) {
+    m_viewProj = viewProj;
+    m_occluders.clear();
+    m_numOccluderTriangles = 0;
+    m_numTriangles = 0;
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    std::fill(m_tileMaxDepth.begin(), m_tileMaxDepth.end(), 1.0f);
+  }
+
+
+  void
+  OcclusionCuller::addOccluder(const Vector3* positions,
+                               const uint32* indices,
+                               uint32 numIndices,
+                               const Matrix4& world) {
+    const uint32 numTriangles = numIndices / 3;
+    if (0 == numTriangles) {
+      return;
+    }
+
+    m_occluders.push_back({ positions, indices, m_numOccluderTriangles, world * m_viewProj });
+    m_numOccluderTriangles += numTriangles;
+  }
+
+  void
+  OcclusionCuller::addOccluder(const SubMesh& subMesh, const Matrix4& world) {
+    addOccluder(subMesh.m_occluderPositions.data(),
+                subMesh.m_occluderIndices.data(),
+                cast::st<uint32>(subMesh.m_occluderIndices.size()),
+                world);
+  }
+
+  void
+  OcclusionCuller::addOccluders(const Vector<VisibleSubMesh>& visible, float minScreenArea) {
+    const float width = cast::st<float>(m_width);
+    const float height = cast::st<float>(m_height);
+
+    for (const auto& instance : visible) {
+      const SubMesh& subMesh =
+        instance.model->m_meshes[instance.meshIndex].m_subMeshes[instance.subMeshIndex];
+      if (subMesh.m_occluderIndices.empty()) {
+        continue;
+      }
+
+      //The ones crossing the near plane are as big as they get
+      float minX, minY, maxX, maxY, minDepth;
+      if (subMesh.m_bounds.m_isValid &&
+          projectBox(subMesh.m_bounds.transformBy(instance.world),
+                     m_viewProj,
+                     width,
+                     height,
+                     minX,
+                     minY,
+                     maxX,
+                     maxY,
+                     minDepth)) {
+        const float areaX = Math::clamp(maxX, 0.0f, width) - Math::clamp(minX, 0.0f, width);
+        const float areaY = Math::clamp(maxY, 0.0f, height) - Math::clamp(minY, 0.0f, height);
+        if (areaX * areaY < minScreenArea * width * height) {
+          continue;
+        }
+      }
+
+      addOccluder(subMesh, instance.world);
+    }
+  }
+
+  bool
+  OcclusionCuller::setupBounds(float minX,
+                               float minY,
+                               float maxX,
+                               float maxY,
+                               ScreenTriangle& triangle) const {
+    triangle.minX = cast::st<int32>(Math::ceil(minX - 0.5f));
+    triangle.minY = cast::st<int32>(Math::ceil(minY - 0.5f));
+    triangle.maxX = cast::st<int32>(Math::floor(maxX - 0.5f));
+    triangle.maxY = cast::st<int32>(Math::floor(maxY - 0.5f));
+    triangle.minX = Math::max(triangle.minX, 0);
+    triangle.minY = Math::max(triangle.minY, 0);
+    triangle.maxX = Math::min(triangle.maxX, cast::st<int32>(m_width) - 1);
+    triangle.maxY = Math::min(triangle.maxY, cast::st<int32>(m_height) - 1);
+    return triangle.minX <= triangle.maxX && triangle.minY <= triangle.maxY;
+  }
+
+  void
+  OcclusionCuller::setupTriangle(const Vector4& v0,
+                                 const Vector4& v1,
+                                 const Vector4& v2,
+                                 Vector<ScreenTriangle>& outTriangles) const {
+    const float width = cast::st<float>(m_width);
+    const float height = cast::st<float>(m_height);
+
+    float x[3], y[3], z[3];
+    const Vector4* vertices[3] = { &v0, &v1, &v2 };
+    for (uint32 i = 0; i < 3; ++i) {
+      const float invW = 1.0f / vertices[i]->w;
+      x[i] = (vertices[i]->x * invW * 0.5f + 0.5f) * width;
+      y[i] = (0.5f - vertices[i]->y * invW * 0.5f) * height;
+      z[i] = vertices[i]->z * invW;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (Math::abs(area) < 1.0e-6f) {
+      return;
+    }
+
+    //Both windings are occluders, turn them all the same way so the inside
+    //is where the three edge functions are positive
+    if (area < 0.0f) {
+      std::swap(x[1], x[2]);
+      std::swap(y[1], y[2]);
+      std::swap(z[1], z[2]);
+      area = -area;
+    }
+
+    ScreenTriangle triangle;
+    if (!setupBounds(Math::min3(x[0], x[1], x[2]),
+                     Math::min3(y[0], y[1], y[2]),
+                     Math::max3(x[0], x[1], x[2]),
+                     Math::max3(y[0], y[1], y[2]),
+                     triangle)) {
+      return;
+    }
+
+    //Edge from a to b: (a.y - b.y) * px + (b.x - a.x) * py + a.x * b.y - a.y * b.x
+    for (uint32 i = 0; i < 3; ++i) {
+      const uint32 j = (i + 1) % 3;
+      triangle.edgeA[i] = y[i] - y[j];
+      triangle.edgeB[i] = x[j] - x[i];
+      triangle.edgeC[i] = x[i] * y[j] - y[i] * x[j];
+    }
+
+    const float invArea = 1.0f / area;
+    triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) * invArea;
+    triangle.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) * invArea;
+    triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+
+    outTriangles.push_back(triangle);
+  }
+
+  void
+  OcclusionCuller::setupBatch(TriangleBatch& batch,
+                              Vector<ScreenTriangle>& outTriangles) const {
+    if (0 == batch.size) {
+      return;
+    }
+
+#if USING(GE_ARCHITECTURE_x86_64)
+    //The lanes left are copies of the first one, and are dropped at the end
+    for (uint32 lane = batch.size; lane < 4; ++lane) {
+      for (uint32 i = 0; i < 3; ++i) {
+        batch.x[i][lane] = batch.x[i][0];
+        batch.y[i][lane] = batch.y[i][0];
+        batch.z[i][lane] = batch.z[i][0];
+        batch.w[i][lane] = batch.w[i][0];
+      }
+    }
+
+    //Same operations as setupTriangle(), so both give the same triangles
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 width = _mm_set1_ps(cast::st<float>(m_width));
+    const __m128 height = _mm_set1_ps(cast::st<float>(m_height));
+
+    __m128 x[3], y[3], z[3];
+    for (uint32 i = 0; i < 3; ++i) {
+      const __m128 invW = _mm_div_ps(one, _mm_loadu_ps(batch.w[i]));
+      const __m128 ndcX = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(batch.x[i]), invW), half);
+      const __m128 ndcY = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(batch.y[i]), invW), half);
+      x[i] = _mm_mul_ps(_mm_add_ps(ndcX, half), width);
+      y[i] = _mm_mul_ps(_mm_sub_ps(half, ndcY), height);
+      z[i] = _mm_mul_ps(_mm_loadu_ps(batch.z[i]), invW);
+    }
+
+    __m128 area = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(x[1], x[0]), _mm_sub_ps(y[2], y[0])),
+                             _mm_mul_ps(_mm_sub_ps(x[2], x[0]), _mm_sub_ps(y[1], y[0])));
+
+    //Turns the lanes wound the other way, as setupTriangle() does
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 flipped = _mm_cmplt_ps(area, _mm_setzero_ps());
+    auto select = [](__m128 mask, __m128 a, __m128 b) {
+      return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    };
+    const __m128 x1 = select(flipped, x[2], x[1]);
+    const __m128 y1 = select(flipped, y[2], y[1]);
+    const __m128 z1 = select(flipped, z[2], z[1]);
+    x[2] = select(flipped, x[1], x[2]);
+    y[2] = select(flipped, y[1], y[2]);
+    z[2] = select(flipped, z[1], z[2]);
+    x[1] = x1;
+    y[1] = y1;
+    z[1] = z1;
+    area = _mm_andnot_ps(signBit, area);
+    const __m128 valid = _mm_cmpge_ps(area, _mm_set1_ps(1.0e-6f));
+
+    alignas(16) float edgeA[3][4], edgeB[3][4], edgeC[3][4];
+    for (uint32 i = 0; i < 3; ++i) {
+      const uint32 j = (i + 1) % 3;
+      _mm_store_ps(edgeA[i], _mm_sub_ps(y[i], y[j]));
+      _mm_store_ps(edgeB[i], _mm_sub_ps(x[j], x[i]));
+      _mm_store_ps(edgeC[i], _mm_sub_ps(_mm_mul_ps(x[i], y[j]), _mm_mul_ps(y[i], x[j])));
+    }
+
+    const __m128 invArea = _mm_div_ps(one, area);
+    const __m128 dz1 = _mm_sub_ps(z[1], z[0]);
+    const __m128 dz2 = _mm_sub_ps(z[2], z[0]);
+    const __m128 depthA = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dz1, _mm_sub_ps(y[2], y[0])),
+                                                _mm_mul_ps(dz2, _mm_sub_ps(y[1], y[0]))),
+                                     invArea);
+    const __m128 depthB = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dz2, _mm_sub_ps(x[1], x[0])),
+                                                _mm_mul_ps(dz1, _mm_sub_ps(x[2], x[0]))),
+                                     invArea);
+    const __m128 depthC = _mm_sub_ps(_mm_sub_ps(z[0], _mm_mul_ps(depthA, x[0])),
+                                     _mm_mul_ps(depthB, y[0]));
+
+    alignas(16) float depth[3][4], bounds[4][4];
+    _mm_store_ps(depth[0], depthA);
+    _mm_store_ps(depth[1], depthB);
+    _mm_store_ps(depth[2], depthC);
+    _mm_store_ps(bounds[0], _mm_min_ps(_mm_min_ps(x[0], x[1]), x[2]));
+    _mm_store_ps(bounds[1], _mm_min_ps(_mm_min_ps(y[0], y[1]), y[2]));
+    _mm_store_ps(bounds[2], _mm_max_ps(_mm_max_ps(x[0], x[1]), x[2]));
+    _mm_store_ps(bounds[3], _mm_max_ps(_mm_max_ps(y[0], y[1]), y[2]));
+    const int32 validMask = _mm_movemask_ps(valid);
+
+    for (uint32 lane = 0; lane < batch.size; ++lane) {
+      ScreenTriangle triangle;
+      if (0 == (validMask & (1 << lane)) ||
+          !setupBounds(bounds[0][lane],
+                       bounds[1][lane],
+                       bounds[2][lane],
+                       bounds[3][lane],
+                       triangle)) {
+        continue;
+      }
+
+      for (uint32 i = 0; i < 3; ++i) {
+        triangle.edgeA[i] = edgeA[i][lane];
+        triangle.edgeB[i] = edgeB[i][lane];
+        triangle.edgeC[i] = edgeC[i][lane];
+      }
+      triangle.depthA = depth[0][lane];
+      triangle.depthB = depth[1][lane];
+      triangle.depthC = depth[2][lane];
+      outTriangles.push_back(triangle);
+    }
+#else
+    for (uint32 lane = 0; lane < batch.size; ++lane) {
+      Vector4 v[3];
+      for (uint32 i = 0; i < 3; ++i) {
+        v[i] = Vector4(batch.x[i][lane], batch.y[i][lane], batch.z[i][lane], batch.w[i][lane]);
+      }
+      setupTriangle(v[0], v[1], v[2], outTriangles);
+    }
+#endif
+    batch.size = 0;
+  }
+
+  void
+  OcclusionCuller::clipTriangle(const Occluder& occluder,
+                                uint32 triangle,
+                                TriangleBatch& batch,
+                                Vector<ScreenTriangle>& outTriangles) const {
+    const uint32* indices = &occluder.indices[triangle * 3];
+    const Vector4 v0 = toClip(occluder.positions[indices[0]], occluder.worldViewProj);
+    const Vector4 v1 = toClip(occluder.positions[indices[1]], occluder.worldViewProj);
+    const Vector4 v2 = toClip(occluder.positions[indices[2]], occluder.worldViewProj);
+
+    const uint32 code0 = outCode(v0);
+    const uint32 code1 = outCode(v1);
+    const uint32 code2 = outCode(v2);
+    if (0 != (code0 & code1 & code2)) {
+      return;
+    }
+
+    const uint32 crossed = code0 | code1 | code2;
+    if (0 == crossed) {
+      const Vector4* vertices[3] = { &v0, &v1, &v2 };
+      const uint32 lane = batch.size;
+      for (uint32 i = 0; i < 3; ++i) {
+        batch.x[i][lane] = vertices[i]->x;
+        batch.y[i][lane] = vertices[i]->y;
+        batch.z[i][lane] = vertices[i]->z;
+        batch.w[i][lane] = vertices[i]->w;
+      }
+      if (4 == ++batch.size) {
+        setupBatch(batch, outTriangles);
+      }
+      return;
+    }
+
+    //The triangles keep the order they were added in
+    setupBatch(batch, outTriangles);
+
+    //Every plane adds at most one vertex to the polygon
+    Vector4 polygon[3 + NUM_CLIP_PLANES];
+    Vector4 clipped[3 + NUM_CLIP_PLANES];
+    polygon[0] = v0;
+    polygon[1] = v1;
+    polygon[2] = v2;
+    uint32 numVertices = 3;
+
+    for (uint32 plane = 0; plane < NUM_CLIP_PLANES && numVertices >= 3; ++plane) {
+      if (0 == (crossed & (1u << plane))) {
+        continue;
+      }
+
+      uint32 numClipped = 0;
+      for (uint32 i = 0; i < numVertices; ++i) {
+        const Vector4& a = polygon[i];
+        const Vector4& b = polygon[(i + 1) % numVertices];
+        const float distanceA = clipDistance(a, plane);
+        const float distanceB = clipDistance(b, plane);
+
+        if (distanceA >= 0.0f) {
+          clipped[numClipped++] = a;
+        }
+        if ((distanceA >= 0.0f) != (distanceB >= 0.0f)) {
+          const float t = distanceA / (distanceA - distanceB);
+          clipped[numClipped++] = a + (b - a) * t;
+        }
+      }
+
+      numVertices = numClipped;
+      for (uint32 i = 0; i < numVertices; ++i) {
+        polygon[i] = clipped[i];
+      }
+    }
+
+    for (uint32 i = 2; i < numVertices; ++i) {
+      setupTriangle(polygon[0], polygon[i - 1], polygon[i], outTriangles);
+    }
+  }
+
+  void
+  OcclusionCuller::render() {
+    const uint32 numChunks = (m_numOccluderTriangles + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (m_chunkTriangles.size() < numChunks) {
+      m_chunkTriangles.resize(numChunks);
+    }
+
+    //Transform, clip and set up the triangles of every occluder
+    auto setupTriangles = [&](uint32 begin, uint32 end) {
+      auto& triangles = m_chunkTriangles[begin / CHUNK_SIZE];
+      triangles.clear();
+
+      auto it = std::upper_bound(m_occluders.begin(),
+                                 m_occluders.end(),
+                                 begin,
+                                 [](uint32 triangle, const Occluder& occluder) {
+                                   return triangle < occluder.firstTriangle;
+                                 });
+      uint32 occluder = cast::st<uint32>(it - m_occluders.begin()) - 1;
+      TriangleBatch batch;
+      for (uint32 i = begin; i < end; ++i) {
+        while (occluder + 1 < m_occluders.size() &&
+               i >= m_occluders[occluder + 1].firstTriangle) {
+          ++occluder;
+        }
+        clipTriangle(m_occluders[occluder],
+                     i - m_occluders[occluder].firstTriangle,
+                     batch,
+                     triangles);
+      }
+      setupBatch(batch, triangles);
+    };
+    parallelForChunks("OcclusionCuller", m_numOccluderTriangles, CHUNK_SIZE, setupTriangles);
+
+    //Sort them in bins, in the order they were added so every run matches
+    for (auto& bin : m_bins) {
+      bin.clear();
+    }
+
+    m_numTriangles = 0;
+    for (uint32 chunk = 0; chunk < numChunks; ++chunk) {
+      for (const auto& triangle : m_chunkTriangles[chunk]) {
+        const uint32 binX0 = cast::st<uint32>(triangle.minX) / BIN_WIDTH;
+        const uint32 binX1 = cast::st<uint32>(triangle.maxX) / BIN_WIDTH;
+        const uint32 binY0 = cast::st<uint32>(triangle.minY) / BIN_HEIGHT;
+        const uint32 binY1 = cast::st<uint32>(triangle.maxY) / BIN_HEIGHT;
+        for (uint32 binY = binY0; binY <= binY1; ++binY) {
+          for (uint32 binX = binX0; binX <= binX1; ++binX) {
+            m_bins[binY * m_binsX + binX].push_back(&triangle);
+          }
+        }
+      }
+      m_numTriangles += cast::st<uint32>(m_chunkTriangles[chunk].size());
+    }
+
+    //Bins don't share pixels, so they are rasterized without locks
+    auto renderBins = [&](uint32 begin, uint32 end) {
+      for (uint32 bin = begin; bin < end; ++bin) {
+        renderBin(bin);
+      }
+    };
+    parallelForChunks("OcclusionCuller", cast::st<uint32>(m_bins.size()), 1, renderBins);
+  }
+
+  void
+  OcclusionCuller::renderBin(uint32 bin) {
+    const auto& triangles = m_bins[bin];
+    if (triangles.empty()) {
+      return;
+    }
+
+    const int32 binX0 = cast::st<int32>((bin % m_binsX) * BIN_WIDTH);
+    const int32 binY0 = cast::st<int32>((bin / m_binsX) * BIN_HEIGHT);
+    const int32 binX1 = binX0 + cast::st<int32>(BIN_WIDTH) - 1;
+    const int32 binY1 = binY0 + cast::st<int32>(BIN_HEIGHT) - 1;
+
+    for (const ScreenTriangle* triangle : triangles) {
+      rasterizeTriangle(triangle->edgeA,
+                        triangle->edgeB,
+                        triangle->edgeC,
+                        triangle->depthA,
+                        triangle->depthB,
+                        triangle->depthC,
+                        Math::max(triangle->minX, binX0) & ~3,
+                        Math::max(triangle->minY, binY0),
+                        Math::min(triangle->maxX, binX1),
+                        Math::min(triangle->maxY, binY1),
+                        m_depth.data(),
+                        m_width);
+    }
+
+    //Farthest depth of every tile of the bin
+    for (int32 tileY = binY0; tileY < binY1; tileY += TILE_SIZE) {
+      for (int32 tileX = binX0; tileX < binX1; tileX += TILE_SIZE) {
+        float maxDepth = 0.0f;
+        for (int32 y = tileY; y < tileY + cast::st<int32>(TILE_SIZE); ++y) {
+          const float* pixels = &m_depth[y * m_width];
+          for (int32 x = tileX; x < tileX + cast::st<int32>(TILE_SIZE); ++x) {
+            maxDepth = Math::max(maxDepth, pixels[x]);
+          }
+        }
+        m_tileMaxDepth[(tileY / TILE_SIZE) * m_tilesX + tileX / TILE_SIZE] = maxDepth;
+      }
+    }
+  }
+
+  bool
+  OcclusionCuller::isVisible(const AABox& worldBox) const {
+    if (!worldBox.m_isValid) {
+      return true;
+    }
+
+    const float width = cast::st<float>(m_width);
+    const float height = cast::st<float>(m_height);
+
+    float minX, minY, maxX, maxY, minDepth;
+    if (!projectBox(worldBox, m_viewProj, width, height, minX, minY, maxX, maxY, minDepth)) {
+      return true;
+    }
+
+    //Off screen, there is nothing to hide it
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+      return true;
+    }
+
+    const int32 x0 = cast::st<int32>(Math::max(minX, 0.0f));
+    const int32 y0 = cast::st<int32>(Math::max(minY, 0.0f));
+    const int32 x1 = cast::st<int32>(Math::min(maxX, width - 1.0f));
+    const int32 y1 = cast::st<int32>(Math::min(maxY, height - 1.0f));
+    minDepth -= DEPTH_BIAS;
+
+    const int32 tileSize = cast::st<int32>(TILE_SIZE);
+    for (int32 tileY = y0 / tileSize; tileY <= y1 / tileSize; ++tileY) {
+      for (int32 tileX = x0 / tileSize; tileX <= x1 / tileSize; ++tileX) {
+        //Most tiles are fully in front of the box or fully empty
+        const float tileMaxDepth = m_tileMaxDepth[tileY * m_tilesX + tileX];
+        if (tileMaxDepth < minDepth) {
+          continue;
+        }
+
+        const int32 pixelY1 = Math::min(y1, tileY * tileSize + tileSize - 1);
+        const int32 pixelX1 = Math::min(x1, tileX * tileSize + tileSize - 1);
+        for (int32 y = Math::max(y0, tileY * tileSize); y <= pixelY1; ++y) {
+          const float* pixels = &m_depth[y * m_width];
+          for (int32 x = Math::max(x0, tileX * tileSize); x <= pixelX1; ++x) {
+            if (pixels[x] >= minDepth) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void
+  OcclusionCuller::cull(Vector<VisibleSubMesh>& inOutVisible) {
+    const uint32 numVisible = cast::st<uint32>(inOutVisible.size());
+    m_visibleFlags.resize(numVisible);
+
+    parallelForChunks("OcclusionCuller", numVisible, 256, [&](uint32 begin, uint32 end) {
+      for (uint32 i = begin; i < end; ++i) {
+        const VisibleSubMesh& instance = inOutVisible[i];
+        const SubMesh& subMesh =
+          instance.model->m_meshes[instance.meshIndex].m_subMeshes[instance.subMeshIndex];
+        m_visibleFlags[i] = !subMesh.m_bounds.m_isValid ||
+                            isVisible(subMesh.m_bounds.transformBy(instance.world));
+      }
+    });
+
+    uint32 numKept = 0;
+    for (uint32 i = 0; i < numVisible; ++i) {
+      if (m_visibleFlags[i]) {
+        inOutVisible[numKept++] = inOutVisible[i];
+      }
+    }
+    inOutVisible.resize(numKept);
+  }
+}
@@ -17,8 +17,28 @@
  */
 /*****************************************************************************/
 #include "geScene.h"
+#include "geModelComponent.h"
 
 namespace geEngineSDK {
+  namespace {
+    /**
+     * Union of the bounds of every model of the actor, in world space.
+     */
+    AABox
+    getActorWorldBounds(const Actor& actor) {
+      AABox bounds = AABox::EMPTY;
+      for (uint32 i = 0; auto* component = actor.getComponent<ModelComponent>(i); ++i) {
+        const Model* model = component->getModel().get();
+        if (nullptr == model || !model->m_bounds.m_isValid) {
+          continue;
+        }
+
+        bounds += model->m_bounds.transformBy(actor.getSceneNode().getWorldMatrix());
+      }
+      return bounds;
+    }
+  }
+
   SPtr<Actor>
   Scene::createActor(const String& name) {
     SPtr<Actor> actor = ge_shared_ptr_new<Actor>(this);
@@ -34,6 +54,17 @@ namespace geEngineSDK {
       return;
     }
 
+    auto proxyIt = m_spatialProxies.find(actor);
+    if (proxyIt != m_spatialProxies.end()) {
+      m_spatialIndex.destroyProxy(proxyIt->second.proxyId);
+      m_spatialProxies.erase(proxyIt);
+    }
+
+    //The actor may outlive the scene, it can't report to it anymore
+    m_spatialDirty.erase(std::remove(m_spatialDirty.begin(), m_spatialDirty.end(), actor),
+                         m_spatialDirty.end());
+    actor->m_scene = nullptr;
+
     for (auto it = m_actors.begin(); it != m_actors.end(); ++it) {
       if (it->get() == actor) {
         m_actors.erase(it);
@@ -62,9 +93,48 @@ namespace geEngineSDK {
 
       SceneNode& node = actor->getSceneNode();
       if (!node.getParent()) {
-        node.updateWorldRecursive(nullptr);
+        node.updateWorldRecursive(nullptr, false, &m_spatialDirty);
+      }
+    }
+
+    updateSpatialIndex();
+  }
+
+  void
+  Scene::updateSpatialIndex() {
+    //An actor can be reported by its node and by its components
+    std::sort(m_spatialDirty.begin(), m_spatialDirty.end());
+    m_spatialDirty.erase(std::unique(m_spatialDirty.begin(), m_spatialDirty.end()),
+                         m_spatialDirty.end());
+
+    for (Actor* actor : m_spatialDirty) {
+      auto it = m_spatialProxies.find(actor);
+
+      const AABox bounds = getActorWorldBounds(*actor);
+      if (!bounds.m_isValid) {
+        if (it != m_spatialProxies.end()) {
+          m_spatialIndex.destroyProxy(it->second.proxyId);
+          m_spatialProxies.erase(it);
+        }
+        continue;
       }
+
+      if (it == m_spatialProxies.end()) {
+        SpatialProxy proxy;
+        proxy.proxyId = m_spatialIndex.createProxy(bounds, actor);
+        proxy.bounds = bounds;
+        m_spatialProxies[actor] = proxy;
+        continue;
+      }
+
+      //Expect the actor to keep moving the same way until the next update
+      SpatialProxy& proxy = it->second;
+      const Vector3 displacement = bounds.getCenter() - proxy.bounds.getCenter();
+      m_spatialIndex.moveProxy(proxy.proxyId, bounds, displacement);
+      proxy.bounds = bounds;
     }
+
+    m_spatialDirty.clear();
   }
 
 } // namespace geEngineSDK
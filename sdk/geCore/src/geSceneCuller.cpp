@@ -0,0 +1,197 @@
+/*****************************************************************************/
+/**
+ * @file    geSceneCuller.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Frustum culling of the submeshes of a Scene.
+ *
+ * Frustum culling of the submeshes of a Scene.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geSceneCuller.h"
+#include "geModelComponent.h"
+
+#include <geTaskScheduler.h>
+
+namespace geEngineSDK {
+  namespace {
+    bool
+    isBoxOutside(const Plane& plane, const Vector3& center, const Vector3& extent) {
+      const float radius = Math::abs(plane.x * extent.x) +
+                           Math::abs(plane.y * extent.y) +
+                           Math::abs(plane.z * extent.z);
+      return plane.planeDot(center) > radius;
+    }
+  }
+
+  void
+  SceneCuller::cull(const Scene& scene,
+                    const Vector<CullView>& views,
+                    Vector<Vector<VisibleSubMesh>>& outVisible) {
+    GE_ASSERT(views.size() <= MAX_VIEWS);
+    const uint32 numViews = cast::st<uint32>(views.size());
+
+    outVisible.resize(numViews);
+    for (auto& visible : outVisible) {
+      visible.clear();
+    }
+
+    //Broad phase, the actors whose bounds overlap each view come from the
+    //spatial index of the scene
+    m_actors.clear();
+    m_actorSlots.clear();
+    for (uint32 v = 0; v < numViews; ++v) {
+      const auto& planes = views[v].planes;
+      scene.queryActors(planes.data(), cast::st<uint32>(planes.size()), [&](Actor& actor) {
+        auto it = m_actorSlots.find(&actor);
+        if (it != m_actorSlots.end()) {
+          m_actors[it->second].viewMask |= 1u << v;
+          return;
+        }
+
+        m_actorSlots[&actor] = cast::st<uint32>(m_actors.size());
+        m_actors.push_back({ &actor, 1u << v });
+      });
+    }
+
+    //Flatten the candidates to a list of submeshes
+    m_instances.clear();
+    for (const auto& candidate : m_actors) {
+      const Actor* actor = candidate.actor;
+      if (!actor->isActive() || !actor->getSceneNode().isVisible()) {
+        continue;
+      }
+
+      for (uint32 i = 0; auto* component = actor->getComponent<ModelComponent>(i); ++i) {
+        const Model* model = component->getModel().get();
+        if (nullptr == model) {
+          continue;
+        }
+
+        for (uint32 meshIndex = 0; meshIndex < model->m_meshes.size(); ++meshIndex) {
+          const auto& subMeshes = model->m_meshes[meshIndex].m_subMeshes;
+          for (uint32 subMeshIndex = 0; subMeshIndex < subMeshes.size(); ++subMeshIndex) {
+            m_instances.push_back({ actor, model, meshIndex, subMeshIndex, candidate.viewMask });
+          }
+        }
+      }
+    }
+
+    const uint32 numInstances = cast::st<uint32>(m_instances.size());
+    m_worlds.resize(numInstances);
+    m_viewMasks.resize(numInstances);
+    if (0 == numInstances) {
+      return;
+    }
+
+    auto cullInstances = [&](uint32 begin, uint32 end) {
+      for (uint32 i = begin; i < end; ++i) {
+        const Instance& instance = m_instances[i];
+        const SubMesh& subMesh =
+          instance.model->m_meshes[instance.meshIndex].m_subMeshes[instance.subMeshIndex];
+
+        const Matrix4& actorWorld = instance.actor->getSceneNode().getWorldMatrix();
+        if (subMesh.m_nodeIndex < instance.model->m_nodes.size()) {
+          const auto& node = instance.model->m_nodes[subMesh.m_nodeIndex];
+          m_worlds[i] = node.m_worldTransform * actorWorld;
+        }
+        else {
+          m_worlds[i] = actorWorld;
+        }
+
+        if (!subMesh.m_bounds.m_isValid) {
+          m_viewMasks[i] = instance.viewMask;
+          continue;
+        }
+
+        //The sphere encloses the corners of the box, m_boundingSphere of the
+        //imported submeshes only reaches the middle of the largest side
+        const Sphere localSphere(subMesh.m_bounds.getCenter(),
+                                 subMesh.m_bounds.getExtent().size());
+        const Sphere sphere = localSphere.transformBy(m_worlds[i]);
+
+        uint32 mask = 0;
+        uint32 intersecting = 0;
+        for (uint32 v = 0; v < numViews; ++v) {
+          if (0 == (instance.viewMask & (1u << v))) {
+            continue;
+          }
+
+          bool bOutside = false;
+          bool bCrossing = false;
+          for (const Plane& plane : views[v].planes) {
+            const float distance = plane.planeDot(sphere.m_center);
+            if (distance > sphere.m_radius) {
+              bOutside = true;
+              break;
+            }
+            bCrossing |= distance > -sphere.m_radius;
+          }
+
+          if (!bOutside) {
+            (bCrossing ? intersecting : mask) |= 1u << v;
+          }
+        }
+
+        //The world box is tighter, but only worth making for the spheres that
+        //cross a plane
+        if (0 != intersecting) {
+          const AABox box = subMesh.m_bounds.transformBy(m_worlds[i]);
+          const Vector3 center = box.getCenter();
+          const Vector3 extent = box.getExtent();
+          for (uint32 v = 0; v < numViews; ++v) {
+            if (0 == (intersecting & (1u << v))) {
+              continue;
+            }
+
+            bool bOutside = false;
+            for (const Plane& plane : views[v].planes) {
+              if (isBoxOutside(plane, center, extent)) {
+                bOutside = true;
+                break;
+              }
+            }
+
+            if (!bOutside) {
+              mask |= 1u << v;
+            }
+          }
+        }
+
+        m_viewMasks[i] = mask;
+      }
+    };
+
+    parallelForChunks("SceneCuller", numInstances, CHUNK_SIZE, cullInstances);
+
+    //Compact the masks to one list per view, keeping the order of the
+    //candidates
+    for (uint32 i = 0; i < numInstances; ++i) {
+      const uint32 mask = m_viewMasks[i];
+      if (0 == mask) {
+        continue;
+      }
+
+      const Instance& instance = m_instances[i];
+      for (uint32 v = 0; v < numViews; ++v) {
+        if (mask & (1u << v)) {
+          VisibleSubMesh visible;
+          visible.actor = instance.actor;
+          visible.model = instance.model;
+          visible.meshIndex = instance.meshIndex;
+          visible.subMeshIndex = instance.subMeshIndex;
+          visible.world = m_worlds[i];
+          outVisible[v].push_back(visible);
+        }
+      }
+    }
+  }
+}
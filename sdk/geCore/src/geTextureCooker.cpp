@@ -0,0 +1,241 @@
+/*****************************************************************************/
+/**
+ * @file    geTextureCooker.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Cooks source images into block compressed DDS files.
+ *
+ * Cooks source images into block compressed DDS files stored on a cache
+ * addressed by the hash of the source file contents.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geTextureCooker.h"
+#include "geGameConfig.h"
+#include "geMountManager.h"
+
+#include <geBlockCompression.h>
+#include <geFileSystem.h>
+#include <geDataStream.h>
+#include <geDebug.h>
+
+using std::hex;
+using std::setw;
+using std::setfill;
+
+namespace geEngineSDK {
+  namespace {
+    /**
+     * @brief Bump it when the encoder output changes, so old caches are
+     *        ignored instead of loaded.
+     */
+    CONSTEXPR uint64 COOK_VERSION = 1;
+
+    CONSTEXPR uint32 DDS_MAGIC = 0x20534444u; //'DDS '
+    CONSTEXPR uint32 DDS_FOURCC_DX10 = 0x30315844u; //'DX10'
+
+    CONSTEXPR uint32 DDSD_CAPS = 0x1;
+    CONSTEXPR uint32 DDSD_HEIGHT = 0x2;
+    CONSTEXPR uint32 DDSD_WIDTH = 0x4;
+    CONSTEXPR uint32 DDSD_PIXELFORMAT = 0x1000;
+    CONSTEXPR uint32 DDSD_MIPMAPCOUNT = 0x20000;
+    CONSTEXPR uint32 DDSD_LINEARSIZE = 0x80000;
+    CONSTEXPR uint32 DDPF_FOURCC = 0x4;
+    CONSTEXPR uint32 DDSCAPS_COMPLEX = 0x8;
+    CONSTEXPR uint32 DDSCAPS_TEXTURE = 0x1000;
+    CONSTEXPR uint32 DDSCAPS_MIPMAP = 0x400000;
+    CONSTEXPR uint32 DDS_DIMENSION_TEXTURE2D = 3;
+
+    /**
+     * @brief DDS_HEADER followed by DDS_HEADER_DXT10, all 32 bit fields.
+     */
+    struct DDSFileHeader
+    {
+      uint32 magic;
+      uint32 size;
+      uint32 flags;
+      uint32 height;
+      uint32 width;
+      uint32 pitchOrLinearSize;
+      uint32 depth;
+      uint32 mipMapCount;
+      uint32 reserved1[11];
+      uint32 pfSize;
+      uint32 pfFlags;
+      uint32 pfFourCC;
+      uint32 pfRGBBitCount;
+      uint32 pfBitMasks[4];
+      uint32 caps;
+      uint32 caps2;
+      uint32 caps3;
+      uint32 caps4;
+      uint32 reserved2;
+      uint32 dxgiFormat;
+      uint32 resourceDimension;
+      uint32 miscFlag;
+      uint32 arraySize;
+      uint32 miscFlags2;
+    };
+    static_assert(sizeof(DDSFileHeader) == 4 + 124 + 20, "Unexpected DDS header size");
+
+    FORCEINLINE uint64
+    rotl64(uint64 value, uint32 bits) {
+      return (value << bits) | (value >> (64 - bits));
+    }
+
+    /**
+     * @brief 64 bit hash of a buffer, eight bytes per step. It only names
+     *        cache files, so it needs to be fast and well distributed, not
+     *        cryptographic.
+     */
+    uint64
+    hashData(const uint8* data, SIZE_T size, uint64 seed) {
+      CONSTEXPR uint64 PRIME1 = 0x9E3779B185EBCA87ull;
+      CONSTEXPR uint64 PRIME2 = 0xC2B2AE3D27D4EB4Full;
+      CONSTEXPR uint64 PRIME3 = 0x165667B19E3779F9ull;
+
+      uint64 hash = seed ^ (static_cast<uint64>(size) * PRIME1);
+
+      SIZE_T i = 0;
+      for (; i + 8 <= size; i += 8) {
+        uint64 block;
+        std::memcpy(&block, data + i, sizeof(block));
+        hash ^= rotl64(block * PRIME2, 31) * PRIME1;
+        hash = rotl64(hash, 27) * PRIME1 + PRIME3;
+      }
+      for (; i < size; ++i) {
+        hash ^= static_cast<uint64>(data[i]) * PRIME3;
+        hash = rotl64(hash, 11) * PRIME1;
+      }
+
+      hash ^= hash >> 33;
+      hash *= PRIME2;
+      hash ^= hash >> 29;
+      hash *= PRIME3;
+      hash ^= hash >> 32;
+      return hash;
+    }
+
+    BLOCK_FORMAT::E
+    toBlockFormat(GRAPHICS_FORMAT::E format) {
+      switch (format) {
+      case GRAPHICS_FORMAT::kBC3_UNORM:
+        return BLOCK_FORMAT::kBC3;
+      case GRAPHICS_FORMAT::kBC5_UNORM:
+        return BLOCK_FORMAT::kBC5;
+      case GRAPHICS_FORMAT::kBC7_UNORM:
+        return BLOCK_FORMAT::kBC7;
+      default:
+        GE_ASSERT(GRAPHICS_FORMAT::kBC1_UNORM == format &&
+                  "Unsupported format for the texture cooker.");
+        return BLOCK_FORMAT::kBC1;
+      }
+    }
+  }
+
+  TextureCooker::TextureCooker() {
+    if (GameConfig::isStarted()) {
+      m_compression = GameConfig::instance().getVar<String>("TEXTURES",
+                                                            "COMPRESSION",
+                                                            String("AUTO"));
+    }
+  }
+
+  const String&
+  TextureCooker::getCompressionSetting() const {
+    static const String DEFAULT_SETTING = "AUTO";
+    return m_compression.isValid() ? m_compression.get() : DEFAULT_SETTING;
+  }
+
+  Path
+  TextureCooker::getCachePath(const uint8* data, SIZE_T size) const {
+    //The setting is case insensitive, the name must be too
+    String setting = getCompressionSetting();
+    StringUtil::toUpperCase(setting);
+    uint64 seed = COOK_VERSION;
+    seed = hashData(reinterpret_cast<const uint8*>(setting.data()), setting.size(), seed);
+    const uint64 hash = hashData(data, size, seed);
+
+    StringStream ss;
+    ss << "Saved/TextureCache/" << hex << setw(16) << setfill('0') << hash << ".dds";
+    return Path(ss.str());
+  }
+
+  GRAPHICS_FORMAT::E
+  TextureCooker::selectFormat(bool hasAlpha) const {
+    const String& setting = getCompressionSetting();
+    if (StringUtil::match(setting, "NONE", false)) {
+      return GRAPHICS_FORMAT::kUNKNOWN;
+    }
+
+    if (StringUtil::match(setting, "BC7", false)) {
+      return GRAPHICS_FORMAT::kBC7_UNORM;
+    }
+
+    return hasAlpha ? GRAPHICS_FORMAT::kBC3_UNORM : GRAPHICS_FORMAT::kBC1_UNORM;
+  }
+
+  MipChain
+  TextureCooker::compress(const MipChain& mips, GRAPHICS_FORMAT::E format, bool bParallel) {
+    return BlockCompression::compressChain(toBlockFormat(format), mips, bParallel);
+  }
+
+  bool
+  TextureCooker::writeDDS(const Path& cachePath,
+                          const MipChain& mips,
+                          GRAPHICS_FORMAT::E format) {
+    if (mips.levels.empty()) {
+      return false;
+    }
+
+    const Path fullPath = cachePath.getAbsolute(FileSystem::getAppPath());
+    FileSystem::createDir(fullPath);
+
+    auto pStream = FileSystem::createAndOpenFile(fullPath);
+    if (!pStream) {
+      GE_LOG(kWarning,
+             Generic,
+             "Could not write the cooked texture: {0}",
+             fullPath.toString());
+      return false;
+    }
+
+    DDSFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = DDS_MAGIC;
+    header.size = 124;
+    header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT |
+                   DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+    header.height = mips.levels[0].height;
+    header.width = mips.levels[0].width;
+    header.pitchOrLinearSize = cast::st<uint32>(mips.levels.size() > 1 ?
+                                                  mips.levels[1].offset :
+                                                  mips.data.size());
+    header.mipMapCount = cast::st<uint32>(mips.levels.size());
+    header.pfSize = 32;
+    header.pfFlags = DDPF_FOURCC;
+    header.pfFourCC = DDS_FOURCC_DX10;
+    header.caps = DDSCAPS_TEXTURE | DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    header.dxgiFormat = cast::st<uint32>(format);
+    header.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+    header.arraySize = 1;
+
+    pStream->write(&header, sizeof(header));
+    pStream->write(mips.data.data(), mips.data.size());
+    pStream->close();
+
+    if (MountManager::isStarted()) {
+      MountManager::instance().refresh(cachePath);
+    }
+
+    return true;
+  }
+
+}
@@ -21,18 +21,26 @@
 #include "geRenderAPI.h"
 #include "geCodecManager.h"
 #include "geMountManager.h"
+#include "geFramePipeline.h"
+#include "geDeferredCallManager.h"
 
 #include <geFileSystem.h>
 #include <geDataStream.h>
 #include <geColor.h>
 #include <geMath.h>
-#include <geUUID.h>
 #include <geFloat16.h>
 #include <geFloat16Color.h>
 
 namespace geEngineSDK {
   GE_LOG_CATEGORY_IMPL(TextureManager);
 
+  namespace {
+    bool
+    isDefaultPath(const Path& filePath) {
+      return StringUtil::match(filePath.getExtension(), ".DEFAULT", false);
+    }
+  }
+
   SPtr<Texture> TextureManager::DEFAULT_ERROR;
   SPtr<Texture> TextureManager::DEFAULT_TRANSPARENT;
   SPtr<Texture> TextureManager::DEFAULT_BLACK;
@@ -130,8 +138,12 @@ namespace geEngineSDK {
 
     m_fileChangeCB.connect(
       [this](const PlatformString& filePath) {
-        Path path(toString(filePath));
-        reload(path);
+        //Called from the thread of the tracker, the texture is reloaded on
+        //the main thread
+        DeferredCallManager::instance().queueDeferredCall(
+          [this, path = Path(toString(filePath))]() {
+            reload(path);
+          });
       });
 
     auto& fileTracker = FileTracker::instance();
@@ -209,40 +221,190 @@ namespace geEngineSDK {
              filePath.toPlatformString());
     }
 
-    auto& mountMan = MountManager::instance();
     StringID fileID(filePath.toString());
-    Path realPath = filePath;
-    Path TextureCachePath;
 
-    if (StringUtil::match(filePath.getExtension(), ".DEFAULT", false)) {
-      //If the file is a default texture, return the default texture
+    if (isDefaultPath(filePath)) {
+      //Default textures are created by the manager, never read from disk
+      return _findDefaultTexture(filePath);
+    }
+
+    if (!bReload && isLoaded(filePath)) {
+      //If the texture is already loaded, return it
+      Lock lock(m_mutex);
+      return m_loadedTextures[fileID.id()];
+    }
+
+    Path realPath;
+    if (!_resolveRealPath(filePath, realPath)) {
+      return DEFAULT_ERROR;
+    }
+
+    auto& codecMan = CodecManager::instance();
+
+    auto& pCodec = codecMan.getImportCodec(CODEC_TYPE::IMAGE, realPath.getExtension());
+    if (!pCodec) { //If there's no codec for this kind of file
+      return nullptr;
+    }
+
+    //The codec creates and writes the texture on the device
+    if (m_pFramePipeline) {
+      m_pFramePipeline->waitForDevice();
+    }
+
+    //Load the texture using the codec, the codecs that cook their textures
+    //look for the cooked version on their own
+    SPtr<Resource> pTexResource;
+    pCodec->importResource(realPath, useCacheIfAvailable && !bReload, pTexResource);
+    if (!pTexResource) {
+      GE_LOG(kError,
+             TextureManager,
+             "Failed to load texture: {0}. Codec returned null.",
+             realPath.toPlatformString());
+      return DEFAULT_ERROR;
+    }
+
+    return _registerTexture(filePath, std::static_pointer_cast<Texture>(pTexResource));
+  }
+
+  Vector<SPtr<Texture>>
+  TextureManager::loadBatch(const Vector<Path>& filePaths, bool useCacheIfAvailable) {
+    Vector<SPtr<Texture>> textures(filePaths.size());
+
+    struct PendingImport
+    {
+      SIZE_T index;
+      Path realPath;
+    };
+
+    //Group the files that need to be imported by the codec that handles them
+    auto& codecMan = CodecManager::instance();
+    Vector<std::pair<SPtr<ICodec>, Vector<PendingImport>>> groups;
+    UnorderedMap<uint32, SIZE_T> firstRequest;
+
+    for (SIZE_T i = 0; i < filePaths.size(); ++i) {
+      const Path& filePath = filePaths[i];
+      StringID fileID(filePath.toString());
+
+      if (isDefaultPath(filePath)) {
+        textures[i] = _findDefaultTexture(filePath);
+        continue;
+      }
+
       if (isLoaded(filePath)) {
         Lock lock(m_mutex);
-        return m_loadedTextures[fileID.id()];
+        textures[i] = m_loadedTextures[fileID.id()];
+        continue;
+      }
+
+      //The same file requested twice is only imported once
+      if (firstRequest.find(fileID.id()) != firstRequest.end()) {
+        continue;
+      }
+      firstRequest[fileID.id()] = i;
+
+      PendingImport pending;
+      pending.index = i;
+      if (!_resolveRealPath(filePath, pending.realPath)) {
+        textures[i] = DEFAULT_ERROR;
+        continue;
+      }
+
+      auto pCodec = codecMan.getImportCodec(CODEC_TYPE::IMAGE,
+                                            pending.realPath.getExtension());
+      if (!pCodec) { //If there's no codec for this kind of file
+        continue;
+      }
+
+      auto itGroup = std::find_if(groups.begin(), groups.end(),
+        [&pCodec](const auto& group) {
+          return group.first == pCodec;
+        });
+      if (itGroup == groups.end()) {
+        groups.emplace_back(pCodec, Vector<PendingImport>());
+        itGroup = groups.end() - 1;
       }
+      itGroup->second.push_back(std::move(pending));
     }
 
-    if (useCacheIfAvailable && !bReload) {
-      if (!StringUtil::match(filePath.getExtension(), ".DDS", false)) {
-        //Check if there's a cached DDS texture
-        geEngineSDK::UUID fileuuid(filePath);
-        TextureCachePath = "Saved/TextureCache/";
-        TextureCachePath += fileuuid.toString() + ".dds";
-        if (mountMan.exists(TextureCachePath)) {
-          realPath = TextureCachePath;
+    if (m_pFramePipeline && !groups.empty()) {
+      m_pFramePipeline->waitForDevice();
+    }
+
+    for (auto& group : groups) {
+      const auto& pCodec = group.first;
+      auto& pendings = group.second;
+
+      Vector<SPtr<Resource>> resources;
+      if (pCodec->importResources) {
+        Vector<Path> realPaths;
+        realPaths.reserve(pendings.size());
+        for (auto& pending : pendings) {
+          realPaths.push_back(pending.realPath);
         }
-        else {
-          TextureCachePath = "";
+        pCodec->importResources(realPaths, useCacheIfAvailable, resources);
+      }
+      else {
+        resources.resize(pendings.size());
+        for (SIZE_T i = 0; i < pendings.size(); ++i) {
+          pCodec->importResource(pendings[i].realPath,
+                                 useCacheIfAvailable,
+                                 resources[i]);
         }
       }
+
+      for (SIZE_T i = 0; i < pendings.size(); ++i) {
+        auto& pending = pendings[i];
+        if (i >= resources.size() || !resources[i]) {
+          GE_LOG(kError,
+                 TextureManager,
+                 "Failed to load texture: {0}. Codec returned null.",
+                 pending.realPath.toPlatformString());
+          textures[pending.index] = DEFAULT_ERROR;
+          continue;
+        }
+
+        textures[pending.index] =
+          _registerTexture(filePaths[pending.index],
+                           std::static_pointer_cast<Texture>(resources[i]));
+      }
     }
 
-    if (!bReload && isLoaded(filePath)) {
-      //If the texture is already loaded, return it
-      Lock lock(m_mutex);
-      return m_loadedTextures[fileID.id()];
+    //Resolve the repeated requests
+    for (SIZE_T i = 0; i < filePaths.size(); ++i) {
+      if (!textures[i]) {
+        StringID fileID(filePaths[i].toString());
+        textures[i] = textures[firstRequest[fileID.id()]];
+      }
     }
 
+    return textures;
+  }
+
+  SPtr<Texture>
+  TextureManager::_findDefaultTexture(const Path& filePath) {
+    //Default textures are registered by their file name, e.g. "WHITE.DEFAULT"
+    String fileName(filePath.getFilename());
+    StringUtil::toUpperCase(fileName);
+    StringID fileID(fileName);
+
+    Lock lock(m_mutex);
+    auto it = m_loadedTextures.find(fileID.id());
+    if (it != m_loadedTextures.end()) {
+      return it->second;
+    }
+
+    GE_LOG(kWarning,
+           TextureManager,
+           "Unknown default texture: {0}",
+           filePath.toPlatformString());
+    return DEFAULT_ERROR;
+  }
+
+  bool
+  TextureManager::_resolveRealPath(const Path& filePath, Path& realPath) {
+    auto& mountMan = MountManager::instance();
+    realPath = filePath;
+
     if (!mountMan.exists(realPath)) {
       GE_LOG(kWarning,
              TextureManager,
@@ -255,31 +417,19 @@ namespace geEngineSDK {
                TextureManager,
                "Texture: {0}. Not Found in Root Folder...",
                filePath.toPlatformString());
-        return DEFAULT_ERROR;
+        return false;
       }
 
       realPath = fileInRoot;
     }
 
-    auto& codecMan = CodecManager::instance();
+    return true;
+  }
 
-    auto& pCodec = codecMan.getImportCodec(CODEC_TYPE::IMAGE, realPath.getExtension());
-    if (!pCodec) { //If there's no codec for this kind of file
-      return nullptr;
-    }
+  SPtr<Texture>
+  TextureManager::_registerTexture(const Path& filePath, SPtr<Texture> pTexture) {
+    StringID fileID(filePath.toString());
 
-    //Load the texture using the codec
-    SPtr<Resource> pTexResource;
-    pCodec->importResource(realPath, useCacheIfAvailable, pTexResource);
-    if (!pTexResource) {
-      GE_LOG(kError,
-             TextureManager,
-             "Failed to load texture: {0}. Codec returned null.",
-             realPath.toPlatformString());
-      return DEFAULT_ERROR;
-    }
-    auto pTexture = std::static_pointer_cast<Texture>(pTexResource);
-    
     {
       Lock lock(m_mutex);
       auto it = m_loadedTextures.find(fileID.id());
@@ -299,8 +449,7 @@ namespace geEngineSDK {
 #endif
 
     pTexture->setPath(filePath);
-    pTexture->setCookedPath(TextureCachePath);
-    pTexture->setDebugName(filePath.getFilename());
+    pTexture->setDebugName(String(filePath.getFilename()));
 
     return pTexture;
   }
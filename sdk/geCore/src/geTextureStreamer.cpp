@@ -0,0 +1,545 @@
+/*****************************************************************************/
+/**
+ * @file    geTextureStreamer.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Streams the mips of the textures as they're needed.
+ *
+ * Keeps resident only the mips of each texture needed for its size on the
+ * screen. Textures are registered with the mip chain read from their header,
+ * the renderer reports every frame how they're seen, and the mips are loaded
+ * and dropped under a memory budget: the files are read in the background,
+ * and the textures created on the next update, or by the render commands of
+ * its frame when there is a FramePipeline. Until a texture has its first
+ * mips, one of the default textures is drawn instead.
+ *
+ * @bug	    No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geTextureStreamer.h"
+#include "geTexture.h"
+#include "geTextureManager.h"
+#include "geCodecManager.h"
+#include "geMountManager.h"
+#include "geFramePipeline.h"
+
+#include <geMath.h>
+#include <geStringID.h>
+#include <geTaskScheduler.h>
+
+namespace geEngineSDK {
+  GE_LOG_CATEGORY_IMPL(TextureStreamer);
+
+  void
+  TextureMipChain::setLayout(uint64 inHeaderSize,
+                             const Vector<SubresourceData>& subresources) {
+    uint32 mipCount = 0;
+    for (const auto& subresource : subresources) {
+      mipCount = std::max(mipCount, subresource.mip + 1);
+    }
+
+    headerSize = inHeaderSize;
+    mipSizes.assign(mipCount, 0);
+    for (const auto& subresource : subresources) {
+      mipSizes[subresource.mip] += subresource.size;
+    }
+
+    //In file order, a range ends at the first subresource left out
+    Vector<SubresourceData> sorted = subresources;
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](const SubresourceData& a, const SubresourceData& b) {
+                return a.srcOffset < b.srcOffset;
+              });
+
+    mipDataRanges.assign(mipCount, {});
+    for (uint32 firstMip = 0; firstMip < mipCount; ++firstMip) {
+      Vector<DataRange>& ranges = mipDataRanges[firstMip];
+      bool bInRange = false;
+      for (const auto& subresource : sorted) {
+        if (subresource.mip < firstMip) {
+          bInRange = false;
+          continue;
+        }
+
+        const uint64 begin = headerSize + subresource.srcOffset;
+        const uint64 end = begin + subresource.size;
+        if (bInRange) {
+          ranges.back().end = std::max(ranges.back().end, end);
+        }
+        else {
+          ranges.push_back({ begin, end });
+          bInRange = true;
+        }
+      }
+    }
+  }
+
+  TextureStreamer::TextureStreamer()
+    : m_fileReader(readFile),
+      m_mipUploader(uploadWithCodec) {
+    //Until the renderer sets its own: 720 lines with a 60 degrees field
+    setViewport(720.0f, Radian(Math::PI / 3.0f));
+  }
+
+  TextureStreamer::~TextureStreamer() {
+    //The loads in progress still write to the streamer
+    for (auto& task : m_loadTasks) {
+      task->wait();
+    }
+  }
+
+  uint32
+  TextureStreamer::registerTexture(const Path& filePath,
+                                   const SPtr<Texture>& placeholder) {
+    auto pCodec = CodecManager::instance().getImportCodec(CODEC_TYPE::IMAGE,
+                                                          filePath.getExtension());
+    if (!pCodec || !pCodec->readMipChain || !pCodec->importMips) {
+      return INVALID_ID;
+    }
+
+    TextureMipChain chain;
+    if (!pCodec->readMipChain(filePath, chain)) {
+      return INVALID_ID;
+    }
+
+    return registerTexture(filePath, chain, placeholder);
+  }
+
+  uint32
+  TextureStreamer::registerTexture(const Path& filePath,
+                                   const TextureMipChain& chain,
+                                   const SPtr<Texture>& placeholder) {
+    if (chain.mipSizes.empty()) {
+      GE_LOG(kWarning,
+             TextureStreamer,
+             "Texture {0} has no mips to stream.",
+             filePath.toPlatformString());
+      return INVALID_ID;
+    }
+
+    const uint32 id = StringID(filePath.toString()).id();
+    auto it = m_textures.find(id);
+    if (it != m_textures.end()) {
+      return id;
+    }
+
+    StreamedTexture& texture = m_textures[id];
+    texture.filePath = filePath;
+    texture.chain = chain;
+    texture.placeholder = placeholder ? placeholder : TextureManager::DEFAULT_WHITE;
+
+    //Nothing is resident or wanted until it's used
+    texture.residentMip = getNumMips(texture);
+    texture.wantedMip = texture.residentMip;
+    texture.requestedMip = texture.residentMip;
+    return id;
+  }
+
+  void
+  TextureStreamer::unregisterTexture(uint32 id) {
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) {
+      return;
+    }
+
+    //A load in progress finds the texture gone, or registered again with
+    //another load, and is dropped
+    m_memoryUsage -= getChainSize(it->second, it->second.residentMip);
+    if (it->second.bLoading) {
+      --m_numPendingLoads;
+    }
+    m_textures.erase(it);
+  }
+
+  void
+  TextureStreamer::setViewport(float screenHeight, const Radian& fovY) {
+    m_pixelsPerUnit = screenHeight / (2.0f * Math::tan(fovY * 0.5f));
+  }
+
+  uint32
+  TextureStreamer::computeMip(uint32 id, float uvDensity, float distance) const {
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) {
+      return 0;
+    }
+
+    //Texels of the top level under a pixel of the screen
+    const TEXTURE_DESC& desc = it->second.chain.desc;
+    const float size = cast::st<float>(std::max(desc.width, desc.height));
+    const float texelsPerPixel = size * uvDensity * distance / m_pixelsPerUnit;
+    if (texelsPerPixel <= 1.0f) {
+      return 0;
+    }
+
+    const uint32 mip = cast::st<uint32>(Math::floor(Math::log2(texelsPerPixel)));
+    return std::min(mip, getNumMips(it->second) - 1);
+  }
+
+  void
+  TextureStreamer::reportUsage(uint32 id, float uvDensity, float distance) {
+    reportMip(id, computeMip(id, uvDensity, distance));
+  }
+
+  void
+  TextureStreamer::reportMip(uint32 id, uint32 mip) {
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) {
+      return;
+    }
+
+    StreamedTexture& texture = it->second;
+    texture.requestedMip = std::min(texture.requestedMip,
+                                    std::min(mip, getNumMips(texture) - 1));
+    texture.lastUsedFrame = m_frame;
+  }
+
+  void
+  TextureStreamer::update(FramePipeline* pipeline) {
+    uploadCompletedLoads(pipeline);
+    applyUploadedLoads();
+    updateWantedMips();
+    fitInBudget();
+    startLoads();
+    ++m_frame;
+  }
+
+  void
+  TextureStreamer::flush() {
+    for (auto& task : m_loadTasks) {
+      task->wait();
+    }
+    uploadCompletedLoads(nullptr);
+    applyUploadedLoads();
+  }
+
+  SPtr<Texture>
+  TextureStreamer::getTexture(uint32 id) const {
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) {
+      return nullptr;
+    }
+
+    return it->second.texture ? it->second.texture : it->second.placeholder;
+  }
+
+  uint32
+  TextureStreamer::getResidentMip(uint32 id) const {
+    auto it = m_textures.find(id);
+    return it != m_textures.end() ? it->second.residentMip : 0;
+  }
+
+  uint32
+  TextureStreamer::getWantedMip(uint32 id) const {
+    auto it = m_textures.find(id);
+    return it != m_textures.end() ? it->second.wantedMip : 0;
+  }
+
+  uint64
+  TextureStreamer::getChainSize(const StreamedTexture& texture, uint32 firstMip) {
+    uint64 size = 0;
+    for (SIZE_T i = firstMip; i < texture.chain.mipSizes.size(); ++i) {
+      size += texture.chain.mipSizes[i];
+    }
+    return size;
+  }
+
+  void
+  TextureStreamer::uploadCompletedLoads(FramePipeline* pipeline) {
+    Vector<CompletedLoad> completedLoads;
+    {
+      Lock lock(m_completedMutex);
+      completedLoads.swap(m_completedLoads);
+    }
+
+    for (auto& load : completedLoads) {
+      auto it = m_textures.find(load.id);
+      if (it == m_textures.end()) {
+        continue;
+      }
+
+      //Unregistered after the load started, and maybe registered again
+      const StreamedTexture& texture = it->second;
+      if (!texture.bLoading || load.serial != texture.loadSerial) {
+        continue;
+      }
+
+      if (nullptr == pipeline) {
+        upload(load, texture.filePath, texture.texture);
+        continue;
+      }
+
+      //The render thread may be drawing the texture of an earlier frame
+      pipeline->enqueue([this, load = std::move(load),
+                         filePath = texture.filePath, target = texture.texture]() {
+        upload(load, filePath, target);
+      });
+    }
+  }
+
+  void
+  TextureStreamer::upload(const CompletedLoad& load,
+                          const Path& filePath,
+                          const SPtr<Texture>& texture) {
+    SPtr<Texture> loaded;
+    if (load.bRead) {
+      loaded = m_mipUploader(filePath, load.fileData, load.skippedSize, load.firstMip);
+    }
+
+    if (loaded) {
+      //Whoever holds the texture sees the new levels
+      if (texture) {
+        texture->moveFrom(*loaded);
+        loaded = texture;
+      }
+      loaded->setPath(filePath);
+    }
+
+    Lock lock(m_completedMutex);
+    m_uploadedLoads.push_back({ load.id, load.serial, load.firstMip, std::move(loaded) });
+  }
+
+  void
+  TextureStreamer::applyUploadedLoads() {
+    Vector<UploadedLoad> uploadedLoads;
+    {
+      Lock lock(m_completedMutex);
+      uploadedLoads.swap(m_uploadedLoads);
+    }
+
+    for (auto& load : uploadedLoads) {
+      auto it = m_textures.find(load.id);
+      if (it == m_textures.end()) {
+        continue;
+      }
+
+      StreamedTexture& texture = it->second;
+      if (!texture.bLoading || load.serial != texture.loadSerial) {
+        continue;
+      }
+      texture.bLoading = false;
+      --m_numPendingLoads;
+
+      if (!load.texture) {
+        GE_LOG(kError,
+               TextureStreamer,
+               "Failed to stream the mips of {0} from level {1}.",
+               texture.filePath.toPlatformString(),
+               load.firstMip);
+        texture.bFailed = true;
+        continue;
+      }
+
+      texture.texture = load.texture;
+      m_memoryUsage -= getChainSize(texture, texture.residentMip);
+      m_memoryUsage += getChainSize(texture, load.firstMip);
+      texture.residentMip = load.firstMip;
+    }
+  }
+
+  void
+  TextureStreamer::updateWantedMips() {
+    for (auto& entry : m_textures) {
+      StreamedTexture& texture = entry.second;
+      const uint32 numMips = getNumMips(texture);
+
+      if (texture.lastUsedFrame == m_frame) {
+        texture.wantedMip = texture.requestedMip;
+      }
+      else if (texture.lastUsedFrame > 0 &&
+               m_frame - texture.lastUsedFrame > m_idleFrames) {
+        //Unused for a while, only the coarsest level stays
+        texture.wantedMip = numMips - 1;
+      }
+
+      texture.requestedMip = numMips;
+    }
+  }
+
+  void
+  TextureStreamer::fitInBudget() {
+    Vector<StreamedTexture*> textures;
+    uint64 wantedSize = 0;
+    for (auto& entry : m_textures) {
+      StreamedTexture& texture = entry.second;
+      wantedSize += getChainSize(texture, texture.wantedMip);
+      if (texture.wantedMip + 1 < getNumMips(texture)) {
+        textures.push_back(&texture);
+      }
+    }
+
+    if (wantedSize <= m_memoryBudget) {
+      return;
+    }
+
+    std::sort(textures.begin(),
+              textures.end(),
+              [](const StreamedTexture* a, const StreamedTexture* b) {
+                return a->lastUsedFrame < b->lastUsedFrame;
+              });
+
+    //A level at a time from each texture, so they all lose detail evenly
+    bool bChanged = true;
+    while (wantedSize > m_memoryBudget && bChanged) {
+      bChanged = false;
+      for (StreamedTexture* texture : textures) {
+        if (wantedSize <= m_memoryBudget) {
+          break;
+        }
+
+        if (texture->wantedMip + 1 < getNumMips(*texture)) {
+          wantedSize -= texture->chain.mipSizes[texture->wantedMip];
+          ++texture->wantedMip;
+          bChanged = true;
+        }
+      }
+    }
+  }
+
+  void
+  TextureStreamer::startLoads() {
+    //Finished tasks are no longer waited for
+    m_loadTasks.erase(std::remove_if(m_loadTasks.begin(),
+                                     m_loadTasks.end(),
+                                     [](const SPtr<Task>& task) {
+                                       return task->isComplete();
+                                     }),
+                      m_loadTasks.end());
+
+    Vector<std::pair<uint32, StreamedTexture*>> candidates;
+    for (auto& entry : m_textures) {
+      StreamedTexture& texture = entry.second;
+      if (!texture.bLoading && !texture.bFailed &&
+          texture.wantedMip != texture.residentMip) {
+        candidates.emplace_back(entry.first, &texture);
+      }
+    }
+
+    //Dropping levels frees memory first, then the largest gains of detail
+    auto priority = [](const StreamedTexture* texture) {
+      if (texture->wantedMip > texture->residentMip) {
+        return NumLimit::MAX_INT32;
+      }
+      return cast::st<int32>(texture->residentMip - texture->wantedMip);
+    };
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [&priority](const auto& a, const auto& b) {
+                return priority(a.second) > priority(b.second);
+              });
+
+    for (auto& candidate : candidates) {
+      if (m_numPendingLoads >= m_maxPendingLoads) {
+        break;
+      }
+      startLoad(candidate.first, *candidate.second);
+    }
+  }
+
+  void
+  TextureStreamer::startLoad(uint32 id, StreamedTexture& texture) {
+    texture.bLoading = true;
+    texture.loadSerial = ++m_nextLoadSerial;
+    ++m_numPendingLoads;
+
+    //Only the headers and the levels from firstMip on, when the codec
+    //knows where those are
+    const TextureMipChain& chain = texture.chain;
+    const uint32 firstMip = texture.wantedMip;
+    uint64 headerSize = 0;
+    Vector<TextureMipChain::DataRange> ranges;
+    if (chain.headerSize > 0 &&
+        chain.mipDataRanges.size() == chain.mipSizes.size() &&
+        !chain.mipDataRanges[firstMip].empty()) {
+      headerSize = chain.headerSize;
+      ranges = chain.mipDataRanges[firstMip];
+    }
+    const uint64 skippedSize = headerSize > 0 ? ranges.front().begin - headerSize : 0;
+
+    auto load = [this, id, serial = texture.loadSerial, filePath = texture.filePath,
+                 firstMip, headerSize, ranges = std::move(ranges), skippedSize]() {
+      Vector<uint8> fileData;
+      const bool bRead = m_fileReader(filePath, headerSize, ranges, fileData);
+      Lock lock(m_completedMutex);
+      m_completedLoads.push_back({ id,
+                                   serial,
+                                   firstMip,
+                                   bRead,
+                                   std::move(fileData),
+                                   skippedSize });
+    };
+
+    if (!TaskScheduler::isStarted()) {
+      load();
+      return;
+    }
+
+    auto task = Task::create("TextureStreamer", load, TASKPRIORITY::kLow);
+    m_loadTasks.push_back(task);
+    TaskScheduler::instance().addTask(task);
+  }
+
+  bool
+  TextureStreamer::readFile(const Path& filePath,
+                            uint64 headerSize,
+                            const Vector<TextureMipChain::DataRange>& ranges,
+                            Vector<uint8>& outData) {
+    auto pFileData = MountManager::instance().open(filePath);
+    if (!pFileData) {
+      return false;
+    }
+
+    if (0 == headerSize) {
+      pFileData->getAllData(outData);
+      return true;
+    }
+
+    uint64 totalSize = headerSize;
+    for (const auto& range : ranges) {
+      if (range.begin < headerSize || range.end < range.begin ||
+          range.end > pFileData->size()) {
+        return false;
+      }
+      totalSize += range.end - range.begin;
+    }
+
+    outData.resize(cast::st<SIZE_T>(totalSize));
+    const auto header = cast::st<SIZE_T>(headerSize);
+    if (pFileData->read(outData.data(), header) != header) {
+      return false;
+    }
+
+    SIZE_T offset = header;
+    for (const auto& range : ranges) {
+      const auto size = cast::st<SIZE_T>(range.end - range.begin);
+      pFileData->seek(cast::st<SIZE_T>(range.begin));
+      if (pFileData->read(outData.data() + offset, size) != size) {
+        return false;
+      }
+      offset += size;
+    }
+    return true;
+  }
+
+  SPtr<Texture>
+  TextureStreamer::uploadWithCodec(const Path& filePath,
+                                   const Vector<uint8>& fileData,
+                                   uint64 skippedSize,
+                                   uint32 firstMip) {
+    auto pCodec = CodecManager::instance().getImportCodec(CODEC_TYPE::IMAGE,
+                                                          filePath.getExtension());
+    if (!pCodec || !pCodec->importMips) {
+      return nullptr;
+    }
+
+    SPtr<Resource> pResource;
+    pCodec->importMips(filePath, fileData, skippedSize, firstMip, pResource);
+    return std::static_pointer_cast<Texture>(pResource);
+  }
+}
@@ -87,6 +87,14 @@ namespace geEngineSDK {
       return sizeof(int32) * 3;
     case VERTEX_ELEMENT_TYPE::UBYTE4:
       return sizeof(uint8) * 4;
+    case VERTEX_ELEMENT_TYPE::HALF2:
+    case VERTEX_ELEMENT_TYPE::SHORT2_NORM:
+    case VERTEX_ELEMENT_TYPE::USHORT2_NORM:
+      return sizeof(uint16) * 2;
+    case VERTEX_ELEMENT_TYPE::HALF4:
+    case VERTEX_ELEMENT_TYPE::SHORT4_NORM:
+    case VERTEX_ELEMENT_TYPE::USHORT4_NORM:
+      return sizeof(uint16) * 4;
     default:
       break;
     }
@@ -113,6 +121,9 @@ namespace geEngineSDK {
     case VERTEX_ELEMENT_TYPE::USHORT2:
     case VERTEX_ELEMENT_TYPE::INT2:
     case VERTEX_ELEMENT_TYPE::UINT2:
+    case VERTEX_ELEMENT_TYPE::HALF2:
+    case VERTEX_ELEMENT_TYPE::SHORT2_NORM:
+    case VERTEX_ELEMENT_TYPE::USHORT2_NORM:
       return 2;
     case VERTEX_ELEMENT_TYPE::FLOAT3:
     case VERTEX_ELEMENT_TYPE::INT3:
@@ -125,6 +136,9 @@ namespace geEngineSDK {
     case VERTEX_ELEMENT_TYPE::UINT4:
     case VERTEX_ELEMENT_TYPE::UBYTE4:
     case VERTEX_ELEMENT_TYPE::UBYTE4_NORM:
+    case VERTEX_ELEMENT_TYPE::HALF4:
+    case VERTEX_ELEMENT_TYPE::SHORT4_NORM:
+    case VERTEX_ELEMENT_TYPE::USHORT4_NORM:
       return 4;
     default:
       break;
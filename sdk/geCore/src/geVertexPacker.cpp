@@ -0,0 +1,343 @@
+/*****************************************************************************/
+/**
+ * @file    geVertexPacker.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Converts full float vertex layouts to quantized ones.
+ *
+ * Converts full float vertex layouts to quantized ones: octahedral normals,
+ * half float texture coordinates, 8-bit blend weights and (optionally)
+ * 16-bit positions relative to the bounds of the vertices.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geVertexPacker.h"
+
+#include <geDebug.h>
+#include <geFloat16.h>
+#include <geMath.h>
+
+namespace geEngineSDK {
+  using VET = VERTEX_ELEMENT_TYPE::E;
+  using VES = VERTEX_ELEMENT_SEMANTIC::E;
+
+  namespace {
+    bool
+    isDirection(VES semantic) {
+      return VES::NORMAL == semantic ||
+             VES::TANGENT == semantic ||
+             VES::BITANGENT == semantic;
+    }
+
+    uint32
+    getStride(const Vector<VertexElement>& elements) {
+      uint32 stride = 0;
+      for (const auto& element : elements) {
+        GE_ASSERT(0 == element.getStreamIndex() && "Only single stream layouts");
+        stride = Math::max(stride, element.getOffset() + element.getSize());
+      }
+      return stride;
+    }
+
+    template<uint32 N>
+    void
+    readFloats(const uint8* data, float (&out)[N]) {
+      std::memcpy(out, data, sizeof(out));
+    }
+
+    /**
+     * Float16 truncates, this picks the closest of the two candidates.
+     */
+    uint16
+    toHalf(float value) {
+      const Float16 truncated(value);
+      const Float16 next(truncated.integerValue() + 1);
+      const bool bNextIsCloser = Math::abs(cast::st<float>(next) - value) <
+                                 Math::abs(cast::st<float>(truncated) - value);
+      return cast::st<uint16>(bNextIsCloser ? next.integerValue() :
+                                              truncated.integerValue());
+    }
+
+    float
+    fromSnorm16(int16 value) {
+      return Math::max(value / 32767.0f, -1.0f);
+    }
+
+    float
+    signNotZero(float value) {
+      return value >= 0.0f ? 1.0f : -1.0f;
+    }
+  }
+
+  Vector<VertexElement>
+  VertexPacker::getPackedElements(const Vector<VertexElement>& elements,
+                                  const uint8* vertices,
+                                  uint32 vertexCount,
+                                  const VertexPackingOptions& options) {
+    const uint32 stride = getStride(elements);
+
+    Vector<VertexElement> packed;
+    packed.reserve(elements.size());
+
+    uint32 offset = 0;
+    for (const auto& element : elements) {
+      const VES semantic = element.getSemantic();
+      VET type = element.getType();
+
+      if (options.packNormals && isDirection(semantic)) {
+        bool bPositiveHandedness = true;
+        if (VET::FLOAT4 == type) {
+          for (uint32 i = 0; i < vertexCount && bPositiveHandedness; ++i) {
+            float tangent[4];
+            readFloats(vertices + SIZE_T(i) * stride + element.getOffset(), tangent);
+            bPositiveHandedness = tangent[3] >= 0.0f;
+          }
+        }
+
+        if (VET::FLOAT3 == type || (VET::FLOAT4 == type && bPositiveHandedness)) {
+          type = VET::SHORT2_NORM;
+        }
+      }
+      else if (options.packTexCoords && VES::TEXCOORD == semantic && VET::FLOAT2 == type) {
+        bool bFitsHalf = true;
+        for (uint32 i = 0; i < vertexCount && bFitsHalf; ++i) {
+          float uv[2];
+          readFloats(vertices + SIZE_T(i) * stride + element.getOffset(), uv);
+          bFitsHalf = Math::abs(uv[0]) <= options.maxHalfTexCoord &&
+                      Math::abs(uv[1]) <= options.maxHalfTexCoord;
+        }
+
+        if (bFitsHalf) {
+          type = VET::HALF2;
+        }
+      }
+      else if (options.packBlendWeights &&
+               VES::BLENDWEIGHT == semantic &&
+               VET::FLOAT4 == type) {
+        type = VET::UBYTE4_NORM;
+      }
+      else if (options.packPositions && VES::POSITION == semantic && VET::FLOAT3 == type) {
+        type = VET::USHORT4_NORM;
+      }
+
+      packed.emplace_back(0,
+                          offset,
+                          type,
+                          semantic,
+                          element.getSemanticIndex(),
+                          element.getInstanceStepRate());
+      offset += VertexElement::getTypeSize(type);
+    }
+
+    return packed;
+  }
+
+  AABox
+  VertexPacker::getPositionRange(const Vector<VertexElement>& elements,
+                                 const uint8* vertices,
+                                 uint32 vertexCount) {
+    const uint32 stride = getStride(elements);
+
+    AABox range = AABox::EMPTY;
+    for (const auto& element : elements) {
+      if (VES::POSITION != element.getSemantic() || VET::FLOAT3 != element.getType()) {
+        continue;
+      }
+
+      for (uint32 i = 0; i < vertexCount; ++i) {
+        float position[3];
+        readFloats(vertices + SIZE_T(i) * stride + element.getOffset(), position);
+        range += Vector3(position[0], position[1], position[2]);
+      }
+      break;
+    }
+
+    return range;
+  }
+
+  void
+  VertexPacker::packVertices(const Vector<VertexElement>& srcElements,
+                             const uint8* srcVertices,
+                             const Vector<VertexElement>& dstElements,
+                             uint8* dstVertices,
+                             uint32 vertexCount,
+                             const AABox& positionRange) {
+    GE_ASSERT(srcElements.size() == dstElements.size());
+
+    const uint32 srcStride = getStride(srcElements);
+    const uint32 dstStride = getStride(dstElements);
+
+    //Per axis factor from the range to [0, 65535], zero on flat axes
+    Vector3 positionFactor(0.0f, 0.0f, 0.0f);
+    for (uint32 axis = 0; axis < 3; ++axis) {
+      const float extent = positionRange.m_max[axis] - positionRange.m_min[axis];
+      if (extent > 0.0f) {
+        positionFactor[axis] = 65535.0f / extent;
+      }
+    }
+
+    for (uint32 i = 0; i < vertexCount; ++i) {
+      const uint8* srcVertex = srcVertices + SIZE_T(i) * srcStride;
+      uint8* dstVertex = dstVertices + SIZE_T(i) * dstStride;
+
+      for (SIZE_T e = 0; e < srcElements.size(); ++e) {
+        const VertexElement& src = srcElements[e];
+        const VertexElement& dst = dstElements[e];
+        const uint8* srcData = srcVertex + src.getOffset();
+        uint8* dstData = dstVertex + dst.getOffset();
+
+        if (src.getType() == dst.getType()) {
+          std::memcpy(dstData, srcData, src.getSize());
+          continue;
+        }
+
+        switch (dst.getType()) {
+        case VET::SHORT2_NORM:
+        {
+          //Also the xyz of FLOAT4 tangents, the handedness is known to be +1
+          float direction[3];
+          readFloats(srcData, direction);
+          int16 encoded[2];
+          encodeOctahedral(Vector3(direction[0], direction[1], direction[2]), encoded);
+          std::memcpy(dstData, encoded, sizeof(encoded));
+          break;
+        }
+        case VET::HALF2:
+        {
+          float uv[2];
+          readFloats(srcData, uv);
+          const uint16 encoded[2] = { toHalf(uv[0]), toHalf(uv[1]) };
+          std::memcpy(dstData, encoded, sizeof(encoded));
+          break;
+        }
+        case VET::UBYTE4_NORM:
+        {
+          float weights[4];
+          readFloats(srcData, weights);
+          encodeBlendWeights(Vector4(weights[0], weights[1], weights[2], weights[3]),
+                             dstData);
+          break;
+        }
+        case VET::USHORT4_NORM:
+        {
+          float position[3];
+          readFloats(srcData, position);
+          uint16 encoded[4] = { 0, 0, 0, 0 };
+          for (uint32 axis = 0; axis < 3; ++axis) {
+            const float normalized = (position[axis] - positionRange.m_min[axis]) *
+                                     positionFactor[axis];
+            encoded[axis] = cast::st<uint16>(Math::round(Math::clamp(normalized,
+                                                                     0.0f,
+                                                                     65535.0f)));
+          }
+          std::memcpy(dstData, encoded, sizeof(encoded));
+          break;
+        }
+        default:
+          GE_ASSERT(false && "Unsupported vertex element conversion");
+          break;
+        }
+      }
+    }
+  }
+
+  void
+  VertexPacker::encodeOctahedral(const Vector3& direction, int16* outEncoded) {
+    const float l1Norm = Math::abs(direction.x) +
+                         Math::abs(direction.y) +
+                         Math::abs(direction.z);
+    if (l1Norm <= 0.0f) {
+      outEncoded[0] = 0;
+      outEncoded[1] = 0;
+      return;
+    }
+
+    float u = direction.x / l1Norm;
+    float v = direction.y / l1Norm;
+    if (direction.z < 0.0f) {
+      //Fold the lower half of the octahedron over the upper one
+      const float foldedU = (1.0f - Math::abs(v)) * signNotZero(u);
+      const float foldedV = (1.0f - Math::abs(u)) * signNotZero(v);
+      u = foldedU;
+      v = foldedV;
+    }
+
+    const Vector3 unitDirection = direction / direction.size();
+    const float baseU = Math::floorFloat(Math::clamp(u, -1.0f, 1.0f) * 32767.0f);
+    const float baseV = Math::floorFloat(Math::clamp(v, -1.0f, 1.0f) * 32767.0f);
+
+    //Rounding each coordinate to the nearest value isn't always the nearest
+    //direction, so try the four neighbors
+    float bestDot = -2.0f;
+    for (uint32 i = 0; i < 4; ++i) {
+      const int16 candidate[2] = {
+        cast::st<int16>(Math::clamp(baseU + (i & 1), -32767.0f, 32767.0f)),
+        cast::st<int16>(Math::clamp(baseV + (i >> 1), -32767.0f, 32767.0f))
+      };
+
+      const float candidateDot = decodeOctahedral(candidate) | unitDirection;
+      if (candidateDot > bestDot) {
+        bestDot = candidateDot;
+        outEncoded[0] = candidate[0];
+        outEncoded[1] = candidate[1];
+      }
+    }
+  }
+
+  Vector3
+  VertexPacker::decodeOctahedral(const int16* encoded) {
+    Vector3 direction(fromSnorm16(encoded[0]), fromSnorm16(encoded[1]), 0.0f);
+    direction.z = 1.0f - Math::abs(direction.x) - Math::abs(direction.y);
+
+    const float fold = Math::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -fold : fold;
+    direction.y += direction.y >= 0.0f ? -fold : fold;
+
+    return direction / direction.size();
+  }
+
+  void
+  VertexPacker::encodeBlendWeights(const Vector4& weights, uint8* outEncoded) {
+    float clamped[4];
+    float sum = 0.0f;
+    for (uint32 i = 0; i < 4; ++i) {
+      clamped[i] = Math::max(weights[i], 0.0f);
+      sum += clamped[i];
+    }
+
+    if (sum <= 0.0f) {
+      std::memset(outEncoded, 0, 4);
+      return;
+    }
+
+    //Round down, then give the missing units to the largest remainders
+    float remainders[4];
+    uint32 total = 0;
+    for (uint32 i = 0; i < 4; ++i) {
+      const float scaled = clamped[i] / sum * 255.0f;
+      const float rounded = Math::floorFloat(scaled);
+      outEncoded[i] = cast::st<uint8>(rounded);
+      remainders[i] = scaled - rounded;
+      total += outEncoded[i];
+    }
+
+    for (; total < 255; ++total) {
+      uint32 largest = 0;
+      for (uint32 i = 1; i < 4; ++i) {
+        if (remainders[i] > remainders[largest]) {
+          largest = i;
+        }
+      }
+      ++outEncoded[largest];
+      remainders[largest] = -1.0f;
+    }
+  }
+
+}
@@ -0,0 +1,337 @@
+/*****************************************************************************/
+/**
+ * @file    geAABBTree.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Dynamic bounding volume hierarchy of axis aligned boxes.
+ *
+ * Dynamic bounding volume hierarchy of axis aligned boxes. Objects are
+ * stored as proxies with an enlarged ("fat") box, so small movements don't
+ * touch the tree at all, and the tree is kept balanced with rotations as
+ * proxies get inserted and removed. Box, sphere, convex volume and ray
+ * queries only visit the branches they overlap.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geBox.h"
+#include "geSphere.h"
+#include "gePlane.h"
+#include "geSmallVector.h"
+
+namespace geEngineSDK {
+
+  /**
+   * @brief A node of an AABBTree. Leaves hold the proxies.
+   */
+  struct AABBTreeNode
+  {
+    bool
+    isLeaf() const {
+      return -1 == child1;
+    }
+
+    /**
+     * Fat box for the leaves, union of the children for the rest.
+     */
+    AABox box = AABox::EMPTY;
+
+    void* userData = nullptr;
+
+    /**
+     * Next free node while the node is in the free list.
+     */
+    int32 parent = -1;
+    int32 child1 = -1;
+    int32 child2 = -1;
+
+    /**
+     * 0 for leaves, -1 for free nodes.
+     */
+    int32 height = -1;
+  };
+
+  /**
+   * @brief Dynamic AABB tree. Proxies are identified by the index of their
+   *        leaf node, which doesn't change until the proxy is destroyed.
+   * @note  Follows the dynamic tree of Box2D: the leaves are inserted next to
+   *        the sibling that grows the surface area the least, and every
+   *        ancestor of a changed leaf is refit on the way up and rotated
+   *        when swapping two grandchildren makes the tree smaller. The tree
+   *        is not thread safe for writes, but the queries are const and can
+   *        run from several threads at once.
+   */
+  class GE_UTILITIES_EXPORT AABBTree
+  {
+   public:
+    static CONSTEXPR int32 NULL_NODE = -1;
+
+    /**
+     * @param margin How much the boxes of the proxies grow on each side, so
+     *        they can move that far without being reinserted.
+     */
+    explicit AABBTree(float margin = 0.1f);
+
+    /**
+     * @brief Adds a proxy for an object with the given (tight) bounds.
+     * @return The id of the proxy.
+     */
+    int32
+    createProxy(const AABox& box, void* userData);
+
+    void
+    destroyProxy(int32 proxyId);
+
+    /**
+     * @brief Updates the bounds of a proxy. Nothing changes while the new
+     *        box stays inside the fat box, otherwise the proxy is reinserted
+     *        with a fat box that is also stretched along displacement, the
+     *        predicted movement until the next update.
+     * @return true if the proxy was reinserted.
+     */
+    bool
+    moveProxy(int32 proxyId,
+              const AABox& box,
+              const Vector3& displacement = Vector3(0.0f, 0.0f, 0.0f));
+
+    void*
+    getUserData(int32 proxyId) const {
+      GE_ASSERT(proxyId >= 0 && proxyId < cast::st<int32>(m_nodes.size()));
+      return m_nodes[proxyId].userData;
+    }
+
+    const AABox&
+    getFatBox(int32 proxyId) const {
+      GE_ASSERT(proxyId >= 0 && proxyId < cast::st<int32>(m_nodes.size()));
+      return m_nodes[proxyId].box;
+    }
+
+    /**
+     * @brief Removes every proxy and releases the nodes.
+     */
+    void
+    clear();
+
+    uint32
+    getProxyCount() const {
+      return m_proxyCount;
+    }
+
+    /**
+     * @brief Height of the tree, 0 for a single proxy.
+     */
+    int32
+    getHeight() const {
+      return NULL_NODE == m_root ? 0 : m_nodes[m_root].height;
+    }
+
+    /**
+     * @brief Sum of the surface areas of all the nodes over the one of the
+     *        root. Lower values mean cheaper queries.
+     */
+    float
+    getAreaRatio() const;
+
+    /**
+     * @brief Checks the links, heights and boxes of every node.
+     */
+    bool
+    validate() const;
+
+    /**
+     * @brief Calls func(proxyId) for every proxy whose fat box overlaps the
+     *        box. The query stops when func returns false.
+     */
+    template<class Func>
+    void
+    query(const AABox& box, Func&& func) const {
+      traverse([&box](const AABox& nodeBox) { return nodeBox.intersect(box); },
+               std::forward<Func>(func));
+    }
+
+    /**
+     * @brief Calls func(proxyId) for every proxy whose fat box overlaps the
+     *        sphere. The query stops when func returns false.
+     */
+    template<class Func>
+    void
+    query(const Sphere& sphere, Func&& func) const {
+      const float radiusSquared = sphere.m_radius * sphere.m_radius;
+      traverse([&sphere, radiusSquared](const AABox& nodeBox) {
+                 return Math::sphereAABBIntersection(sphere.m_center,
+                                                     radiusSquared,
+                                                     nodeBox);
+               },
+               std::forward<Func>(func));
+    }
+
+    /**
+     * @brief Calls func(proxyId) for every proxy whose fat box is not fully
+     *        outside one of the planes, like the six planes of a frustum.
+     *        The planes face out of the volume: a point is inside when
+     *        planeDot() is negative or zero for every plane. The query stops
+     *        when func returns false.
+     */
+    template<class Func>
+    void
+    query(const Plane* planes, uint32 planeCount, Func&& func) const {
+      traverse([planes, planeCount](const AABox& nodeBox) {
+                 const Vector3 center = nodeBox.getCenter();
+                 const Vector3 extent = nodeBox.getExtent();
+                 for (uint32 i = 0; i < planeCount; ++i) {
+                   const Plane& plane = planes[i];
+                   const float radius = Math::abs(plane.x * extent.x) +
+                                        Math::abs(plane.y * extent.y) +
+                                        Math::abs(plane.z * extent.z);
+                   if (plane.planeDot(center) > radius) {
+                     return false;
+                   }
+                 }
+                 return true;
+               },
+               std::forward<Func>(func));
+    }
+
+    /**
+     * @brief Calls func(proxyId, maxDistance) for every proxy whose fat box
+     *        the ray hits closer than maxDistance. func returns the new max
+     *        distance: the distance to its own hit to keep only the closer
+     *        ones, maxDistance to ignore the proxy, or 0 to stop.
+     * @param direction Normalized direction of the ray.
+     */
+    template<class Func>
+    void
+    raycast(const Vector3& origin,
+            const Vector3& direction,
+            float maxDistance,
+            Func&& func) const {
+      if (NULL_NODE == m_root) {
+        return;
+      }
+
+      const Vector3 invDirection(1.0f / direction.x,
+                                 1.0f / direction.y,
+                                 1.0f / direction.z);
+
+      SmallVector<int32, 64> stack;
+      stack.add(m_root);
+      while (!stack.empty() && maxDistance > 0.0f) {
+        const int32 nodeId = stack.back();
+        stack.pop();
+
+        const AABBTreeNode& node = m_nodes[nodeId];
+        if (!rayHitsBox(origin, invDirection, maxDistance, node.box)) {
+          continue;
+        }
+
+        if (node.isLeaf()) {
+          maxDistance = func(nodeId, maxDistance);
+        }
+        else {
+          stack.add(node.child1);
+          stack.add(node.child2);
+        }
+      }
+    }
+
+   private:
+    template<class Overlaps, class Func>
+    void
+    traverse(Overlaps&& overlaps, Func&& func) const {
+      if (NULL_NODE == m_root) {
+        return;
+      }
+
+      SmallVector<int32, 64> stack;
+      stack.add(m_root);
+      while (!stack.empty()) {
+        const int32 nodeId = stack.back();
+        stack.pop();
+
+        const AABBTreeNode& node = m_nodes[nodeId];
+        if (!overlaps(node.box)) {
+          continue;
+        }
+
+        if (node.isLeaf()) {
+          if (!func(nodeId)) {
+            return;
+          }
+        }
+        else {
+          stack.add(node.child1);
+          stack.add(node.child2);
+        }
+      }
+    }
+
+    /**
+     * Slab test, with the direction given as its reciprocal.
+     */
+    static bool
+    rayHitsBox(const Vector3& origin,
+               const Vector3& invDirection,
+               float maxDistance,
+               const AABox& box) {
+      float tMin = 0.0f;
+      float tMax = maxDistance;
+      for (uint32 axis = 0; axis < 3; ++axis) {
+        float t1 = (box.m_min[axis] - origin[axis]) * invDirection[axis];
+        float t2 = (box.m_max[axis] - origin[axis]) * invDirection[axis];
+        if (t1 > t2) {
+          std::swap(t1, t2);
+        }
+
+        //NaN (0 * inf on a parallel ray starting on a side) keeps the range
+        tMin = t1 > tMin ? t1 : tMin;
+        tMax = t2 < tMax ? t2 : tMax;
+        if (tMin > tMax) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    int32
+    allocateNode();
+
+    void
+    freeNode(int32 nodeId);
+
+    void
+    insertLeaf(int32 leafId);
+
+    void
+    removeLeaf(int32 leafId);
+
+    /**
+     * Refits the boxes and heights from nodeId up to the root, rotating the
+     * nodes on the way.
+     */
+    void
+    refitAncestors(int32 nodeId);
+
+    void
+    rotate(int32 nodeId);
+
+    void
+    swapChildren(int32 parentA, int32 childA, int32 parentB, int32 childB);
+
+    void
+    refitNode(int32 nodeId);
+
+    Vector<AABBTreeNode> m_nodes;
+    int32 m_root = NULL_NODE;
+    int32 m_freeList = NULL_NODE;
+    uint32 m_proxyCount = 0;
+    float m_margin;
+  };
+}
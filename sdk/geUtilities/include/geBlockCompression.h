@@ -0,0 +1,134 @@
+/*****************************************************************************/
+/**
+ * @file    geBlockCompression.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   CPU encoder and decoder for the BCn texture formats.
+ *
+ * CPU encoder and decoder for the block compressed texture formats BC1, BC3,
+ * BC5 and BC7. Images are encoded in blocks of 4x4 pixels.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geMipMapGenerator.h"
+
+namespace geEngineSDK {
+  namespace BLOCK_FORMAT {
+    enum E {
+      /**
+       * RGB with 5:6:5 endpoints, 8 bytes per block. No alpha.
+       */
+      kBC1,
+
+      /**
+       * BC1 color plus an interpolated alpha block, 16 bytes per block.
+       */
+      kBC3,
+
+      /**
+       * Two interpolated channels (red and green), 16 bytes per block.
+       * Meant for tangent space normal maps.
+       */
+      kBC5,
+
+      /**
+       * RGBA with 7:7:7:7 endpoints and 4 bit indices, 16 bytes per block.
+       * Only mode 6 is used by the encoder.
+       */
+      kBC7
+    };
+  }
+
+  /**
+   * @brief Encodes and decodes RGBA8 images in the BCn formats.
+   * @note  The encoder fits the endpoints along the principal axis of each
+   *        block and refines them with a least squares pass. Blocks are
+   *        independent, so big images are split across the TaskScheduler.
+   */
+  class GE_UTILITIES_EXPORT BlockCompression
+  {
+   public:
+    /**
+     * @brief Size in bytes of a 4x4 block.
+     */
+    static uint32
+    getBlockSize(BLOCK_FORMAT::E format);
+
+    /**
+     * @brief Size in bytes of a row of blocks for an image of the given width.
+     */
+    static uint32
+    calcRowPitch(BLOCK_FORMAT::E format, uint32 width);
+
+    /**
+     * @brief Size in bytes of a compressed image.
+     */
+    static SIZE_T
+    calcImageSize(BLOCK_FORMAT::E format, uint32 width, uint32 height);
+
+    /**
+     * @brief Encodes a single block.
+     * @param[in]  format   The format to encode to.
+     * @param[in]  pixels   16 RGBA pixels, row by row.
+     * @param[out] outBlock Where to write the block (getBlockSize bytes).
+     */
+    static void
+    encodeBlock(BLOCK_FORMAT::E format, const uint8* pixels, uint8* outBlock);
+
+    /**
+     * @brief Decodes a single block into 16 RGBA pixels, row by row.
+     *        Channels that the format doesn't store are set to 0 (or 255 for
+     *        the alpha).
+     */
+    static void
+    decodeBlock(BLOCK_FORMAT::E format, const uint8* block, uint8* outPixels);
+
+    /**
+     * @brief Encodes a whole image. The pixels of the partial blocks on the
+     *        right and bottom edges are replicated from the last column/row.
+     * @param[in]  format    The format to encode to.
+     * @param[in]  pixels    Tightly packed RGBA pixels.
+     * @param[in]  width     The width of the image in pixels.
+     * @param[in]  height    The height of the image in pixels.
+     * @param[out] outData   Where to write the blocks (calcImageSize bytes).
+     * @param[in]  bParallel Splits the rows of blocks across the TaskScheduler
+     *                       workers (if it's started).
+     */
+    static void
+    compress(BLOCK_FORMAT::E format,
+             const uint8* pixels,
+             uint32 width,
+             uint32 height,
+             uint8* outData,
+             bool bParallel = true);
+
+    /**
+     * @brief Decodes a whole image into tightly packed RGBA pixels.
+     */
+    static void
+    decompress(BLOCK_FORMAT::E format,
+               const uint8* data,
+               uint32 width,
+               uint32 height,
+               uint8* outPixels);
+
+    /**
+     * @brief Encodes every level of an RGBA8 mip chain.
+     * @return A chain with the same level sizes. The row pitch of each level
+     *         is the size of a row of blocks.
+     */
+    static MipChain
+    compressChain(BLOCK_FORMAT::E format,
+                  const MipChain& chain,
+                  bool bParallel = true);
+  };
+}
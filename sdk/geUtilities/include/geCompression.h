@@ -5,7 +5,11 @@
  * @date    2017/10/15
  * @brief   Performs generic compression and decompression on raw data
  *
- * Performs generic compression and decompression on raw data
+ * Performs generic compression and decompression on raw data. The data is
+ * split in blocks compressed independently with LZ4, so the blocks are
+ * compressed and decompressed in parallel, and a block index at the start
+ * lets CompressedDataStream read any part of it without decompressing the
+ * rest.
  *
  * @bug     No known bugs.
  */
@@ -18,13 +22,40 @@
  */
 /*****************************************************************************/
 #include "gePrerequisitesUtilities.h"
+#include "geDataStream.h"
 
 namespace geEngineSDK {
   using std::function;
 
+  struct CompressionOptions
+  {
+    /**
+     * Bytes of input per block, clamped to the range of Compression. Larger
+     * blocks compress better, smaller ones are faster to read at random.
+     */
+    uint32 blockSize = 128 * 1024;
+
+    /**
+     * 0 uses the fast LZ4 compressor, 1 to 12 the LZ4-HC levels, slower to
+     * compress and as fast to decompress.
+     */
+    int32 level = 0;
+
+    /**
+     * Data similar to the input (its last 64 KB are used) that every block
+     * can reference. The same dictionary is needed to decompress.
+     */
+    SPtr<MemoryDataStream> dictionary;
+
+    bool bParallel = true;
+  };
+
   class GE_UTILITIES_EXPORT Compression
   {
    public:
+    static CONSTEXPR uint32 MIN_BLOCK_SIZE = 4 * 1024;
+    static CONSTEXPR uint32 MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
     /**
      * @brief Compresses the data from the provided data stream and outputs the
      *        new stream with compressed data.
@@ -32,11 +63,131 @@ namespace geEngineSDK {
     static SPtr<MemoryDataStream>
     compress(SPtr<DataStream>& input, function<void(float)> reportProgress = nullptr);
 
+    /**
+     * @brief Compresses the data from the provided data stream with the
+     *        provided options. The input is read a few blocks at a time.
+     */
+    static SPtr<MemoryDataStream>
+    compress(SPtr<DataStream>& input,
+             const CompressionOptions& options,
+             function<void(float)> reportProgress = nullptr);
+
     /**
      * @brief Decompresses the data from the provided data stream and outputs
      *        the new stream with decompressed data.
      */
     static SPtr<MemoryDataStream>
     decompress(SPtr<DataStream>& input, function<void(float)> reportProgress = nullptr);
+
+    /**
+     * @brief Decompresses data compressed with a dictionary.
+     */
+    static SPtr<MemoryDataStream>
+    decompress(SPtr<DataStream>& input,
+               const SPtr<MemoryDataStream>& dictionary,
+               bool bParallel = true,
+               function<void(float)> reportProgress = nullptr);
+  };
+
+  /**
+   * @brief Reads the data of a stream written by Compression::compress(),
+   *        decompressing only the blocks that are read.
+   */
+  class GE_UTILITIES_EXPORT CompressedDataStream : public DataStream
+  {
+   public:
+    /**
+     * @param[in] source      Compressed data. It must be able to seek, and
+     *                        it's read from its current position.
+     * @param[in] dictionary  The dictionary it was compressed with, if any.
+     */
+    explicit CompressedDataStream(const SPtr<DataStream>& source,
+                                  const SPtr<MemoryDataStream>& dictionary = nullptr);
+
+    /**
+     * @brief False if the source doesn't hold compressed blocks, or needs
+     *        another dictionary.
+     */
+    bool
+    isValid() const {
+      return m_bValid;
+    }
+
+    bool
+    isFile() const override {
+      return m_source->isFile();
+    }
+
+    uint32
+    getBlockSize() const {
+      return m_blockSize;
+    }
+
+    uint32
+    getNumBlocks() const {
+      return cast::st<uint32>(m_blockSizes.size());
+    }
+
+    /**
+     * @brief @copydoc DataStream::read
+     */
+    SIZE_T
+    read(void* buf, SIZE_T count) override;
+
+    /**
+     * @brief @copydoc DataStream::skip
+     */
+    void
+    skip(SIZE_T count) override;
+
+    /**
+     * @brief @copydoc DataStream::seek
+     */
+    void
+    seek(SIZE_T pos) override;
+
+    /**
+     * @brief @copydoc DataStream::tell
+     */
+    SIZE_T
+    tell() const override;
+
+    /**
+     * @brief @copydoc DataStream::isEOF
+     */
+    bool
+    isEOF() const override;
+
+    /**
+     * @brief @copydoc DataStream::clone
+     */
+    SPtr<DataStream>
+    clone(bool copyData = true) const override;
+
+    /**
+     * @brief @copydoc DataStream::close
+     */
+    void
+    close() override;
+
+   private:
+    bool
+    loadBlock(uint32 block);
+
+    SPtr<DataStream> m_source;
+    SPtr<MemoryDataStream> m_dictionary;
+    bool m_bValid = false;
+
+    uint32 m_blockSize = 0;
+    SIZE_T m_sourceStart = 0;
+
+    //Packed size of every block, and where it starts in the source
+    Vector<uint32> m_blockSizes;
+    Vector<uint64> m_blockOffsets;
+
+    SIZE_T m_pos = 0;
+    uint32 m_loadedBlock = NumLimit::MAX_UINT32;
+    Vector<uint8> m_block;
+    Vector<uint8> m_packed;
   };
 }
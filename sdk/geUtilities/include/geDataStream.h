@@ -277,6 +277,13 @@ namespace geEngineSDK {
       return m_pos;
     }
 
+    /**
+     * @brief Drops the data after newSize, the memory is not reallocated.
+     *        Gives back the unused end of a stream sized for the worst case.
+     */
+    void
+    truncate(SIZE_T newSize);
+
     /**
      * @brief @copydoc DataStream::read
      */
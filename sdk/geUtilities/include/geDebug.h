@@ -177,15 +177,21 @@ bool LogCategory##name::s_registered = Log::_registerCategory(LogCategory##name:
 #define GE_LOG_GET_CATEGORY_ID(category) LogCategory##category::_id
 
 
+#define GE_LOG_STRINGIFY_IMPL(x) #x
+#define GE_LOG_STRINGIFY(x) GE_LOG_STRINGIFY_IMPL(x)
+
+  /**
+   * The message is formatted once and the location is appended in place, the
+   * line number is turned into a literal by the preprocessor.
+   */
 #define GE_LOG(verbosity, category, message, ...)                             \
   do {                                                                        \
   using namespace ::geEngineSDK;                                              \
   IF_CONSTEXPR (int32(LogVerbosity::verbosity) <= int32(GE_LOG_VERBOSITY)) {  \
-    g_debug().log(StringUtil::format(message, ##__VA_ARGS__) +                \
-                          String("\n\t\t in ") +                              \
-                          __PRETTY_FUNCTION__ +                               \
-                          " [" + __FILE__ + ":" +                             \
-                          toString(int32(__LINE__)) + "]\n",                  \
+    String geLogMessage_ = StringUtil::format(message, ##__VA_ARGS__);        \
+    geLogMessage_.append("\n\t\t in ").append(__PRETTY_FUNCTION__);          \
+    geLogMessage_.append(" [" __FILE__ ":" GE_LOG_STRINGIFY(__LINE__) "]\n"); \
+    g_debug().log(geLogMessage_,                                              \
                   LogVerbosity::verbosity, LogCategory##category::_id);       \
   }} while (0)
 
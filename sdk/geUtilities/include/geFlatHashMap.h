@@ -0,0 +1,952 @@
+/*****************************************************************************/
+/**
+ * @file    geFlatHashMap.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Open addressing hash map and set.
+ *
+ * Hash containers that keep their elements in a single flat array instead of
+ * a node per element. Each slot has a control byte holding 7 bits of the hash
+ * of its key, and lookups compare a group of 16 control bytes at once (with
+ * SSE2 where available), so most probes touch a single cache line and only
+ * compare keys whose hash bits already matched.
+ *
+ * Unlike UnorderedMap, inserting can move the elements, invalidating the
+ * iterators, pointers and references to them. Erasing never moves them.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geException.h"
+
+#include <bit>
+
+#if USING(GE_ARCHITECTURE_x86_64)
+# include <emmintrin.h>
+#endif
+
+namespace geEngineSDK {
+  namespace Implementation {
+    /**
+     * Control bytes of the slots. A full slot holds the low 7 bits of the hash
+     * of its key, so it is never negative.
+     */
+    CONSTEXPR int8 FLAT_EMPTY = -128;
+    CONSTEXPR int8 FLAT_DELETED = -2;
+    CONSTEXPR int8 FLAT_SENTINEL = -1;
+
+    CONSTEXPR SIZE_T FLAT_GROUP_WIDTH = 16;
+
+    /**
+     * @brief 16 consecutive control bytes, compared at once. Bit i of the
+     *        masks is set when the byte i matches.
+     */
+    class FlatGroup
+    {
+     public:
+      explicit FlatGroup(const int8* ctrl) {
+#if USING(GE_ARCHITECTURE_x86_64)
+        m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        memcpy(m_ctrl, ctrl, FLAT_GROUP_WIDTH);
+#endif
+      }
+
+      uint32
+      match(int8 h2) const {
+#if USING(GE_ARCHITECTURE_x86_64)
+        return cast::st<uint32>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+        uint32 mask = 0;
+        for (uint32 i = 0; i < FLAT_GROUP_WIDTH; ++i) {
+          mask |= cast::st<uint32>(m_ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+      }
+
+      uint32
+      matchEmpty() const {
+        return match(FLAT_EMPTY);
+      }
+
+      uint32
+      matchEmptyOrDeleted() const {
+#if USING(GE_ARCHITECTURE_x86_64)
+        return cast::st<uint32>(
+          _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(FLAT_SENTINEL), m_ctrl)));
+#else
+        uint32 mask = 0;
+        for (uint32 i = 0; i < FLAT_GROUP_WIDTH; ++i) {
+          mask |= cast::st<uint32>(m_ctrl[i] < FLAT_SENTINEL) << i;
+        }
+        return mask;
+#endif
+      }
+
+     private:
+#if USING(GE_ARCHITECTURE_x86_64)
+      __m128i m_ctrl;
+#else
+      int8 m_ctrl[FLAT_GROUP_WIDTH];
+#endif
+    };
+
+    /**
+     * @brief Spreads the bits of the hash, since std::hash of the integers is
+     *        the identity and both ends of the hash are used.
+     */
+    inline uint64
+    mixFlatHash(SIZE_T hash) {
+      uint64 h = cast::st<uint64>(hash);
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDull;
+      h ^= h >> 33;
+      return h;
+    }
+
+    template<typename Key>
+    struct FlatSetKeyOf
+    {
+      static const Key&
+      get(const Key& value) {
+        return value;
+      }
+    };
+
+    /**
+     * @brief Type taken by the lookups: any type when the hash and the
+     *        comparison are transparent, and only the key type otherwise.
+     */
+    template<bool IS_TRANSPARENT>
+    struct FlatKeyArg
+    {
+      template<typename K, typename Key>
+      using type = Key;
+    };
+
+    template<>
+    struct FlatKeyArg<true>
+    {
+      template<typename K, typename Key>
+      using type = K;
+    };
+
+    template<typename Key, typename Value>
+    struct FlatMapKeyOf
+    {
+      static const Key&
+      get(const std::pair<const Key, Value>& value) {
+        return value.first;
+      }
+    };
+
+    /**
+     * @brief The table shared by FlatHashMap and FlatHashSet.
+     */
+    template<typename Key,
+             typename Value,
+             typename KeyOf,
+             typename H,
+             typename C,
+             typename A>
+    class FlatHashTable
+    {
+      static CONSTEXPR bool IS_TRANSPARENT = requires {
+        typename H::is_transparent;
+        typename C::is_transparent;
+      };
+
+     protected:
+      template<typename K>
+      using KeyArg = typename FlatKeyArg<IS_TRANSPARENT>::template type<K, Key>;
+
+     public:
+      using key_type = Key;
+      using value_type = Value;
+      using size_type = SIZE_T;
+      using difference_type = ptrdiff_t;
+      using hasher = H;
+      using key_equal = C;
+      using allocator_type = A;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+
+      static CONSTEXPR bool IS_SET = std::is_same<Key, Value>::value;
+
+      template<bool IS_CONST>
+      class Iterator
+      {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = ptrdiff_t;
+        //The elements of a set are never modified through the iterators
+        using reference = typename std::conditional<IS_CONST || IS_SET,
+                                                    const Value&,
+                                                    Value&>::type;
+        using pointer = typename std::conditional<IS_CONST || IS_SET,
+                                                  const Value*,
+                                                  Value*>::type;
+
+        Iterator() = default;
+
+        /**
+         * @brief Converts an iterator to a const_iterator.
+         */
+        template<bool OTHER_CONST>
+          requires(IS_CONST && !OTHER_CONST)
+        Iterator(const Iterator<OTHER_CONST>& other)
+          : m_ctrl(other.m_ctrl),
+            m_slot(other.m_slot) {}
+
+        reference
+        operator*() const {
+          return *m_slot;
+        }
+
+        pointer
+        operator->() const {
+          return m_slot;
+        }
+
+        Iterator&
+        operator++() {
+          ++m_ctrl;
+          ++m_slot;
+          skipFree();
+          return *this;
+        }
+
+        Iterator
+        operator++(int) {
+          Iterator it = *this;
+          ++*this;
+          return it;
+        }
+
+        bool
+        operator==(const Iterator& other) const {
+          return m_ctrl == other.m_ctrl;
+        }
+
+       private:
+        friend class FlatHashTable;
+
+        template<bool OTHER_CONST>
+        friend class Iterator;
+
+        Iterator(const int8* ctrl, pointer slot)
+          : m_ctrl(ctrl),
+            m_slot(slot) {}
+
+        /**
+         * @brief Moves to the next full slot, or to the sentinel at the end.
+         */
+        void
+        skipFree() {
+          while (*m_ctrl < FLAT_SENTINEL) {
+            ++m_ctrl;
+            ++m_slot;
+          }
+        }
+
+        const int8* m_ctrl = nullptr;
+        pointer m_slot = nullptr;
+      };
+
+      using iterator = Iterator<false>;
+      using const_iterator = Iterator<true>;
+
+      FlatHashTable() = default;
+
+      explicit FlatHashTable(size_type numElements) {
+        reserve(numElements);
+      }
+
+      FlatHashTable(std::initializer_list<value_type> list) {
+        reserve(list.size());
+        for (const auto& value : list) {
+          insert(value);
+        }
+      }
+
+      FlatHashTable(const FlatHashTable& other)
+        : m_hash(other.m_hash),
+          m_equal(other.m_equal) {
+        reserve(other.m_size);
+        for (const auto& value : other) {
+          insertUnique(value);
+        }
+      }
+
+      FlatHashTable(FlatHashTable&& other) _NOEXCEPT
+        : m_hash(std::move(other.m_hash)),
+          m_equal(std::move(other.m_equal)),
+          m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+          m_slots(std::exchange(other.m_slots, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, 0)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_growthLeft(std::exchange(other.m_growthLeft, 0)) {}
+
+      ~FlatHashTable() {
+        destroyAll();
+        deallocate();
+      }
+
+      FlatHashTable&
+      operator=(const FlatHashTable& other) {
+        if (this != &other) {
+          FlatHashTable copy(other);
+          swap(copy);
+        }
+        return *this;
+      }
+
+      FlatHashTable&
+      operator=(FlatHashTable&& other) _NOEXCEPT {
+        if (this != &other) {
+          FlatHashTable moved(std::move(other));
+          swap(moved);
+        }
+        return *this;
+      }
+
+      iterator
+      begin() {
+        if (0 == m_size) {
+          return end();
+        }
+        iterator it(m_ctrl, m_slots);
+        it.skipFree();
+        return it;
+      }
+
+      const_iterator
+      begin() const {
+        return const_cast<FlatHashTable*>(this)->begin();
+      }
+
+      const_iterator
+      cbegin() const {
+        return begin();
+      }
+
+      iterator
+      end() {
+        return iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+      }
+
+      const_iterator
+      end() const {
+        return const_cast<FlatHashTable*>(this)->end();
+      }
+
+      const_iterator
+      cend() const {
+        return end();
+      }
+
+      bool
+      empty() const {
+        return 0 == m_size;
+      }
+
+      size_type
+      size() const {
+        return m_size;
+      }
+
+      /**
+       * @brief Number of slots. The table grows once it is 7/8 full.
+       */
+      size_type
+      capacity() const {
+        return m_capacity;
+      }
+
+      float
+      load_factor() const {
+        return 0 == m_capacity ? 0.0f : cast::st<float>(m_size) / m_capacity;
+      }
+
+      /**
+       * @brief Destroys the elements but keeps the slots.
+       */
+      void
+      clear() {
+        destroyAll();
+        m_size = 0;
+        if (m_capacity > 0) {
+          resetCtrl();
+        }
+      }
+
+      /**
+       * @brief Makes room for the number of elements, so inserting them
+       *        never moves the elements.
+       */
+      void
+      reserve(size_type numElements) {
+        //The erased slots that weren't reclaimed take room too
+        if (numElements > m_size + m_growthLeft) {
+          resize(capacityFor(std::max(numElements, m_size)));
+        }
+      }
+
+      std::pair<iterator, bool>
+      insert(const value_type& value) {
+        return emplaceKey(KeyOf::get(value), value);
+      }
+
+      std::pair<iterator, bool>
+      insert(value_type&& value) {
+        return emplaceKey(KeyOf::get(value), std::move(value));
+      }
+
+      template<typename It>
+      void
+      insert(It first, It last) {
+        for (; first != last; ++first) {
+          insert(*first);
+        }
+      }
+
+      void
+      insert(std::initializer_list<value_type> list) {
+        insert(list.begin(), list.end());
+      }
+
+      /**
+       * @brief Builds the element first, to find its key.
+       */
+      template<typename... Args>
+      std::pair<iterator, bool>
+      emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return emplaceKey(KeyOf::get(value), std::move(value));
+      }
+
+      template<typename K = key_type>
+      iterator
+      find(const KeyArg<K>& key) {
+        const size_type index = findIndex(key, hashOf(key));
+        return index == m_capacity ? end() : iteratorAt(index);
+      }
+
+      template<typename K = key_type>
+      const_iterator
+      find(const KeyArg<K>& key) const {
+        return const_cast<FlatHashTable*>(this)->find(key);
+      }
+
+      template<typename K = key_type>
+      bool
+      contains(const KeyArg<K>& key) const {
+        return findIndex(key, hashOf(key)) != m_capacity;
+      }
+
+      template<typename K = key_type>
+      size_type
+      count(const KeyArg<K>& key) const {
+        return contains(key) ? 1 : 0;
+      }
+
+      template<typename K = key_type>
+      size_type
+      erase(const KeyArg<K>& key) {
+        const size_type index = findIndex(key, hashOf(key));
+        if (index == m_capacity) {
+          return 0;
+        }
+        eraseAt(index);
+        return 1;
+      }
+
+      /**
+       * @brief Erases the element and returns the next one. The other
+       *        elements stay where they are.
+       */
+      iterator
+      erase(const_iterator it) {
+        const size_type index = cast::st<size_type>(it.m_ctrl - m_ctrl);
+        eraseAt(index);
+        iterator next(it.m_ctrl, m_slots + index);
+        ++next;
+        return next;
+      }
+
+      iterator
+      erase(iterator it) {
+        return erase(const_iterator(it));
+      }
+
+      void
+      swap(FlatHashTable& other) _NOEXCEPT {
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_equal, other.m_equal);
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+      }
+
+      hasher
+      hash_function() const {
+        return m_hash;
+      }
+
+      key_equal
+      key_eq() const {
+        return m_equal;
+      }
+
+     protected:
+      /**
+       * @brief Inserts the value built from the arguments if the key isn't in
+       *        the table.
+       */
+      template<typename K, typename... Args>
+      std::pair<iterator, bool>
+      emplaceKey(const K& key, Args&&... args) {
+        const uint64 hash = hashOf(key);
+        size_type index = findIndex(key, hash);
+        if (index != m_capacity) {
+          return { iteratorAt(index), false };
+        }
+
+        index = prepareInsert(hash);
+        new (m_slots + index) value_type(std::forward<Args>(args)...);
+        return { iteratorAt(index), true };
+      }
+
+      iterator
+      iteratorAt(size_type index) {
+        return iterator(m_ctrl + index, m_slots + index);
+      }
+
+     private:
+      /**
+       * Storage for an element, so the slots are allocated with the
+       * alignment of the elements.
+       */
+      struct alignas(value_type) Slot
+      {
+        uint8 bytes[sizeof(value_type)];
+      };
+
+      using SlotAllocator =
+        typename std::allocator_traits<A>::template rebind_alloc<Slot>;
+
+      static CONSTEXPR size_type MIN_CAPACITY = FLAT_GROUP_WIDTH - 1;
+
+      /**
+       * @brief Elements that fit in the slots before growing. At least one
+       *        slot is always empty so the probes stop.
+       */
+      static size_type
+      maxGrowth(size_type capacity) {
+        return capacity - capacity / 8;
+      }
+
+      /**
+       * @brief Smallest capacity (a power of two minus one) with room for the
+       *        number of elements.
+       */
+      static size_type
+      capacityFor(size_type numElements) {
+        size_type capacity = MIN_CAPACITY;
+        while (maxGrowth(capacity) < numElements) {
+          capacity = capacity * 2 + 1;
+        }
+        return capacity;
+      }
+
+      static int8
+      h2(uint64 hash) {
+        return cast::st<int8>(hash & 0x7F);
+      }
+
+      template<typename K>
+      uint64
+      hashOf(const K& key) const {
+        return mixFlatHash(m_hash(key));
+      }
+
+      /**
+       * @brief Index of the slot with the key, or the capacity if it's not in
+       *        the table. The groups are probed at triangular offsets, which
+       *        visit the whole table.
+       */
+      template<typename K>
+      size_type
+      findIndex(const K& key, uint64 hash) const {
+        if (0 == m_size) {
+          return m_capacity;
+        }
+
+        const int8 tag = h2(hash);
+        size_type pos = cast::st<size_type>(hash >> 7) & m_capacity;
+        size_type step = 0;
+        while (true) {
+          const FlatGroup group(m_ctrl + pos);
+          for (uint32 mask = group.match(tag); 0 != mask; mask &= mask - 1) {
+            const size_type index =
+              (pos + cast::st<size_type>(std::countr_zero(mask))) & m_capacity;
+            if (m_equal(KeyOf::get(*slotAt(index)), key)) {
+              return index;
+            }
+          }
+
+          if (0 != group.matchEmpty()) {
+            return m_capacity;
+          }
+
+          step += FLAT_GROUP_WIDTH;
+          pos = (pos + step) & m_capacity;
+        }
+      }
+
+      /**
+       * @brief First empty or deleted slot in the probe sequence of the hash.
+       */
+      size_type
+      findFirstFree(uint64 hash) const {
+        size_type pos = cast::st<size_type>(hash >> 7) & m_capacity;
+        size_type step = 0;
+        while (true) {
+          const uint32 mask = FlatGroup(m_ctrl + pos).matchEmptyOrDeleted();
+          if (0 != mask) {
+            return (pos + cast::st<size_type>(std::countr_zero(mask))) & m_capacity;
+          }
+
+          step += FLAT_GROUP_WIDTH;
+          pos = (pos + step) & m_capacity;
+        }
+      }
+
+      /**
+       * @brief Claims a slot for a new element of the hash, growing the table
+       *        if needed.
+       */
+      size_type
+      prepareInsert(uint64 hash) {
+        size_type index = 0 == m_capacity ? 0 : findFirstFree(hash);
+        if (0 == m_growthLeft && (0 == m_capacity || FLAT_DELETED != m_ctrl[index])) {
+          //Mostly erased slots are reclaimed without growing
+          if (m_capacity > MIN_CAPACITY && m_size * 32 <= m_capacity * 25) {
+            resize(m_capacity);
+          }
+          else {
+            resize(0 == m_capacity ? MIN_CAPACITY : m_capacity * 2 + 1);
+          }
+          index = findFirstFree(hash);
+        }
+
+        if (FLAT_EMPTY == m_ctrl[index]) {
+          --m_growthLeft;
+        }
+        setCtrl(index, h2(hash));
+        ++m_size;
+        return index;
+      }
+
+      /**
+       * @brief Sets the control byte of a slot, and its copy after the
+       *        sentinel, so the groups read past the end see the first slots.
+       */
+      void
+      setCtrl(size_type index, int8 value) {
+        m_ctrl[index] = value;
+        m_ctrl[((index - (FLAT_GROUP_WIDTH - 1)) & m_capacity) +
+               ((FLAT_GROUP_WIDTH - 1) & m_capacity)] = value;
+      }
+
+      void
+      eraseAt(size_type index) {
+        slotAt(index)->~value_type();
+        --m_size;
+
+        //If no group holding the slot was ever full, no probe went past it
+        //and the slot can be empty instead of deleted
+        const size_type before = (index - FLAT_GROUP_WIDTH) & m_capacity;
+        const uint32 emptyBefore = FlatGroup(m_ctrl + before).matchEmpty();
+        const uint32 emptyAfter = FlatGroup(m_ctrl + index).matchEmpty();
+        const bool bWasNeverFull = 0 != emptyBefore && 0 != emptyAfter &&
+          cast::st<uint32>(std::countr_zero(emptyAfter) +
+                           std::countl_zero(emptyBefore << 16)) < FLAT_GROUP_WIDTH;
+
+        setCtrl(index, bWasNeverFull ? FLAT_EMPTY : FLAT_DELETED);
+        if (bWasNeverFull) {
+          ++m_growthLeft;
+        }
+      }
+
+      value_type*
+      slotAt(size_type index) const {
+        return m_slots + index;
+      }
+
+      /**
+       * @brief Moves the elements to a new allocation with the capacity.
+       */
+      void
+      resize(size_type capacity) {
+        int8* oldCtrl = m_ctrl;
+        value_type* oldSlots = m_slots;
+        const size_type oldCapacity = m_capacity;
+
+        allocate(capacity);
+        for (size_type i = 0; i < oldCapacity; ++i) {
+          if (oldCtrl[i] < 0) {
+            continue;
+          }
+
+          const uint64 hash = hashOf(KeyOf::get(oldSlots[i]));
+          const size_type index = findFirstFree(hash);
+          setCtrl(index, h2(hash));
+          relocate(oldSlots + i, m_slots + index);
+        }
+        m_growthLeft -= m_size;
+
+        if (oldCapacity > 0) {
+          SlotAllocator allocator;
+          allocator.deallocate(reinterpret_cast<Slot*>(oldSlots),
+                               numAllocatedSlots(oldCapacity));
+        }
+      }
+
+      /**
+       * @brief Moves an element to another slot. The key of a map is const
+       *        only to its users, the old slot is destroyed right after.
+       */
+      static void
+      relocate(value_type* from, value_type* to) {
+        if CONSTEXPR(IS_SET) {
+          new (to) value_type(std::move(*from));
+        }
+        else {
+          new (to) value_type(std::move(const_cast<Key&>(from->first)),
+                              std::move(from->second));
+        }
+        from->~value_type();
+      }
+
+      /**
+       * @brief Slots allocated for the capacity, with the control bytes at
+       *        the end: one per slot, the sentinel and the copy of the first
+       *        group.
+       */
+      static size_type
+      numAllocatedSlots(size_type capacity) {
+        return capacity + (capacity + FLAT_GROUP_WIDTH + sizeof(Slot) - 1) / sizeof(Slot);
+      }
+
+      void
+      allocate(size_type capacity) {
+        SlotAllocator allocator;
+        Slot* slots = allocator.allocate(numAllocatedSlots(capacity));
+        m_slots = reinterpret_cast<value_type*>(slots);
+        m_ctrl = reinterpret_cast<int8*>(slots + capacity);
+        m_capacity = capacity;
+        resetCtrl();
+      }
+
+      void
+      deallocate() {
+        if (m_capacity > 0) {
+          SlotAllocator allocator;
+          allocator.deallocate(reinterpret_cast<Slot*>(m_slots),
+                               numAllocatedSlots(m_capacity));
+        }
+      }
+
+      void
+      resetCtrl() {
+        memset(m_ctrl, FLAT_EMPTY, m_capacity + FLAT_GROUP_WIDTH);
+        m_ctrl[m_capacity] = FLAT_SENTINEL;
+        m_growthLeft = maxGrowth(m_capacity);
+      }
+
+      void
+      destroyAll() {
+        if CONSTEXPR(!std::is_trivially_destructible<value_type>::value) {
+          for (size_type i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0) {
+              slotAt(i)->~value_type();
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Copies an element known not to be in the table.
+       */
+      void
+      insertUnique(const value_type& value) {
+        const size_type index = prepareInsert(hashOf(KeyOf::get(value)));
+        new (m_slots + index) value_type(value);
+      }
+
+      H m_hash;
+      C m_equal;
+      int8* m_ctrl = nullptr;
+      value_type* m_slots = nullptr;
+      size_type m_capacity = 0;
+      size_type m_size = 0;
+      size_type m_growthLeft = 0;
+    };
+  }
+
+  /**
+   * @brief Hash of the strings that also takes string views and literals,
+   *        to look them up without building a String.
+   */
+  struct FlatStringHash
+  {
+    using is_transparent = void;
+
+    size_t
+    operator()(std::string_view str) const {
+      return std::hash<std::string_view>()(str);
+    }
+  };
+
+  /**
+   * @brief Open addressing hash map. Faster than UnorderedMap to look up and
+   *        to iterate, but inserting can move the elements.
+   */
+  template<typename K,
+           typename V,
+           typename H = HashType<K>,
+           typename C = std::equal_to<K>,
+           typename A = StdAlloc<std::pair<const K, V>>>
+  class FlatHashMap
+    : public Implementation::FlatHashTable<K,
+                                           std::pair<const K, V>,
+                                           Implementation::FlatMapKeyOf<K, V>,
+                                           H,
+                                           C,
+                                           A>
+  {
+    using Base = Implementation::FlatHashTable<K,
+                                               std::pair<const K, V>,
+                                               Implementation::FlatMapKeyOf<K, V>,
+                                               H,
+                                               C,
+                                               A>;
+
+    template<typename T>
+    using KeyArg = typename Base::template KeyArg<T>;
+
+   public:
+    using mapped_type = V;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using Base::Base;
+
+    /**
+     * @brief Inserts the value built from the arguments if the key isn't in
+     *        the map. Nothing is built otherwise.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(const K& key, Args&&... args) {
+      return this->emplaceKey(key,
+                              std::piecewise_construct,
+                              std::forward_as_tuple(key),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(K&& key, Args&&... args) {
+      return this->emplaceKey(key,
+                              std::piecewise_construct,
+                              std::forward_as_tuple(std::move(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<typename T>
+    std::pair<iterator, bool>
+    insert_or_assign(const K& key, T&& value) {
+      auto result = try_emplace(key, std::forward<T>(value));
+      if (!result.second) {
+        result.first->second = std::forward<T>(value);
+      }
+      return result;
+    }
+
+    using Base::insert;
+
+    V&
+    operator[](const K& key) {
+      return try_emplace(key).first->second;
+    }
+
+    V&
+    operator[](K&& key) {
+      return try_emplace(std::move(key)).first->second;
+    }
+
+    template<typename T = K>
+    V&
+    at(const KeyArg<T>& key) {
+      auto it = this->find(key);
+      if (it == this->end()) {
+        GE_EXCEPT(InvalidParametersException, "Key not found in the map.");
+      }
+      return it->second;
+    }
+
+    template<typename T = K>
+    const V&
+    at(const KeyArg<T>& key) const {
+      return const_cast<FlatHashMap*>(this)->at(key);
+    }
+  };
+
+  /**
+   * @brief Open addressing hash set. Faster than UnorderedSet to look up and
+   *        to iterate, but inserting can move the elements.
+   */
+  template<typename T,
+           typename H = HashType<T>,
+           typename C = std::equal_to<T>,
+           typename A = StdAlloc<T>>
+  class FlatHashSet
+    : public Implementation::FlatHashTable<T,
+                                           T,
+                                           Implementation::FlatSetKeyOf<T>,
+                                           H,
+                                           C,
+                                           A>
+  {
+    using Base = Implementation::FlatHashTable<T,
+                                               T,
+                                               Implementation::FlatSetKeyOf<T>,
+                                               H,
+                                               C,
+                                               A>;
+
+   public:
+    using Base::Base;
+  };
+
+  /**
+   * @brief Map from strings that can be looked up with string views and
+   *        literals.
+   */
+  template<typename V>
+  using FlatStringMap = FlatHashMap<String, V, FlatStringHash, std::equal_to<>>;
+}
@@ -110,6 +110,19 @@ namespace geEngineSDK {
   }
 #endif
 
+  /**
+   * @brief Allocators that report to the MemoryTracker.
+   */
+  namespace MEMORY_SOURCE {
+    enum E {
+      kGeneral = 0,
+      kFrame,
+      kPool,
+      kStack,
+      kCount
+    };
+  }
+
   /**
    * @class MemoryCounter
    * @brief Thread safe class used for storing total number of memory
@@ -128,6 +141,18 @@ namespace geEngineSDK {
       return m_frees;
     }
 
+    /**
+     * @brief Reports an allocation to the MemoryTracker, if it runs.
+     */
+    static GE_UTILITIES_EXPORT void
+    trackAlloc(void* ptr, size_t bytes, MEMORY_SOURCE::E source);
+
+    /**
+     * @brief Reports a free to the MemoryTracker, if it runs.
+     */
+    static GE_UTILITIES_EXPORT void
+    trackFree(void* ptr, MEMORY_SOURCE::E source);
+
    private:
     friend class MemoryAllocatorBase;
 
@@ -181,10 +206,12 @@ namespace geEngineSDK {
    public:
     static void*
     allocate(size_t bytes) {
+      void* ptr = malloc(bytes);
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incAllocCount();
+      MemoryCounter::trackAlloc(ptr, bytes, MEMORY_SOURCE::kGeneral);
 #endif
-      return malloc(bytes);
+      return ptr;
     }
 
     /**
@@ -195,10 +222,12 @@ namespace geEngineSDK {
      */
     static void*
     allocateAligned(size_t bytes, size_t alignment) {
+      void* ptr = platformAlignedAlloc(bytes, alignment);
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incAllocCount();
+      MemoryCounter::trackAlloc(ptr, bytes, MEMORY_SOURCE::kGeneral);
 #endif
-      return platformAlignedAlloc(bytes, alignment);
+      return ptr;
     }
 
     /**
@@ -206,16 +235,19 @@ namespace geEngineSDK {
      */
     static void*
     allocateAligned16(size_t bytes) {
+      void* ptr = platformAlignedAlloc16(bytes);
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incAllocCount();
+      MemoryCounter::trackAlloc(ptr, bytes, MEMORY_SOURCE::kGeneral);
 #endif
-      return platformAlignedAlloc16(bytes);
+      return ptr;
     }
 
     static void
     free(void* ptr) {
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incFreeCount();
+      MemoryCounter::trackFree(ptr, MEMORY_SOURCE::kGeneral);
 #endif
       ::free(ptr);
     }
@@ -227,6 +259,7 @@ namespace geEngineSDK {
     freeAligned(void* ptr) {
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incFreeCount();
+      MemoryCounter::trackFree(ptr, MEMORY_SOURCE::kGeneral);
 #endif
       platformAlignedFree(ptr);
     }
@@ -238,6 +271,7 @@ namespace geEngineSDK {
     freeAligned16(void* ptr) {
 #if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
       incFreeCount();
+      MemoryCounter::trackFree(ptr, MEMORY_SOURCE::kGeneral);
 #endif
       platformAlignedFree16(ptr);
     }
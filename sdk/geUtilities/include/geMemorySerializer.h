@@ -3,9 +3,14 @@
  * @file    geMemorySerializer.h
  * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
  * @date    2017/11/03
- * @brief   Encodes/decodes an IReflectable object from/to memory.
+ * @brief   Encodes/decodes a reflected object from/to memory.
  *
- * Encodes/decodes an IReflectable object from/to memory.
+ * Encodes/decodes a reflected object from/to memory. The properties that a
+ * type registers with RTTR are written as versioned binary records, aligned
+ * and little-endian, with flat arrays of numbers written as single blocks.
+ * Decoding copies those blocks into Vector properties and points
+ * std::span<const T> properties into the source buffer, so the data is never
+ * copied.
  *
  * @bug     No known bugs.
  */
@@ -18,72 +23,300 @@
  */
 /*****************************************************************************/
 #include "gePrerequisitesUtilities.h"
+#include <span>
 
-namespace geEngineSDK {
-  struct SerializationContext;
+#if USING(GE_REFLECTION)
+# include <rttr/type>
+#endif
 
+namespace geEngineSDK {
   using std::function;
 
-  class GE_UTILITIES_EXPORT MemorySerializer
+  /**
+   * @brief Writes aligned little-endian values to a growing buffer. Values
+   *        are aligned to their size and arrays to ARRAY_ALIGNMENT, counting
+   *        from the start of the buffer.
+   */
+  class GE_UTILITIES_EXPORT MemoryRecordWriter
   {
-    struct BufferPiece
-    {
-      uint8* buffer;
-      uint32 size;
-    };
+   public:
+    static CONSTEXPR SIZE_T ARRAY_ALIGNMENT = 16;
+
+    template<typename T>
+    void
+    write(T value) {
+      static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                    "Only numbers and enums are written as values.");
+      value = swapToLittleEndian(value);
+      writeBytes(&value, sizeof(T), sizeof(T));
+    }
+
+    /**
+     * @brief Writes the number of elements and then the elements as a single
+     *        block, which MemoryRecordReader::readArrayInPlace() can use
+     *        without copying it.
+     */
+    template<typename T>
+    void
+    writeArray(const T* data, uint32 count) {
+      static_assert(std::is_trivially_copyable_v<T>,
+                    "Only trivially copyable elements are written as blocks.");
+      write(count);
+#if USING(GE_ENDIAN_BIG)
+      if constexpr (sizeof(T) > 1) {
+        static_assert(std::is_arithmetic_v<T>,
+                      "Big-endian platforms only swap arrays of numbers.");
+        writeBytes(nullptr, 0, ARRAY_ALIGNMENT);
+        for (uint32 i = 0; i < count; ++i) {
+          write(data[i]);
+        }
+        return;
+      }
+#endif
+      writeBytes(data, SIZE_T(count) * sizeof(T), ARRAY_ALIGNMENT);
+    }
+
+    void
+    writeString(const String& value);
+
+    /**
+     * @brief Pads the buffer to the alignment and then appends the data.
+     */
+    void
+    writeBytes(const void* data, SIZE_T size, SIZE_T alignment = 1);
+
+    /**
+     * @brief Leaves room for a value that is only known later, like the size
+     *        of what follows it.
+     * @return Offset to pass to patch().
+     */
+    template<typename T>
+    SIZE_T
+    reserve() {
+      writeBytes(nullptr, 0, sizeof(T));
+      const SIZE_T offset = m_buffer.size();
+      m_buffer.resize(offset + sizeof(T));
+      return offset;
+    }
 
+    template<typename T>
+    void
+    patch(SIZE_T offset, T value) {
+      GE_ASSERT(offset + sizeof(T) <= m_buffer.size());
+      value = swapToLittleEndian(value);
+      memcpy(&m_buffer[offset], &value, sizeof(T));
+    }
+
+    void
+    clear() {
+      m_buffer.clear();
+    }
+
+    const uint8*
+    data() const {
+      return m_buffer.data();
+    }
+
+    SIZE_T
+    size() const {
+      return m_buffer.size();
+    }
+
+    template<typename T>
+    static T
+    swapToLittleEndian(T value) {
+#if USING(GE_ENDIAN_BIG)
+      if constexpr (sizeof(T) > 1) {
+        uint8 bytes[sizeof(T)];
+        memcpy(bytes, &value, sizeof(T));
+        std::reverse(bytes, bytes + sizeof(T));
+        memcpy(&value, bytes, sizeof(T));
+      }
+#endif
+      return value;
+    }
+
+   private:
+    Vector<uint8> m_buffer;
+  };
+
+  /**
+   * @brief Reads what a MemoryRecordWriter wrote, from a buffer that the
+   *        caller keeps alive. Every read fails instead of going past the end
+   *        of the buffer.
+   */
+  class GE_UTILITIES_EXPORT MemoryRecordReader
+  {
    public:
+    MemoryRecordReader(const uint8* data, SIZE_T size)
+      : m_data(data),
+        m_size(size) {}
+
+    template<typename T>
+    bool
+    read(T& value) {
+      static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                    "Only numbers and enums are read as values.");
+      const uint8* data = readBlock(sizeof(T), sizeof(T));
+      if (nullptr == data) {
+        return false;
+      }
+      memcpy(&value, data, sizeof(T));
+      value = MemoryRecordWriter::swapToLittleEndian(value);
+      return true;
+    }
+
+    /**
+     * @brief Copies an array written by MemoryRecordWriter::writeArray().
+     */
+    template<typename T>
+    bool
+    readArray(Vector<T>& values) {
+      const T* data = nullptr;
+      uint32 count = 0;
+      if (!readArrayBlock(data, count)) {
+        return false;
+      }
+      values.resize(count);
+      if (count > 0) {
+        memcpy(values.data(), data, SIZE_T(count) * sizeof(T));
+      }
+#if USING(GE_ENDIAN_BIG)
+      for (auto& value : values) {
+        value = MemoryRecordWriter::swapToLittleEndian(value);
+      }
+#endif
+      return true;
+    }
+
+    /**
+     * @brief Points to an array written by MemoryRecordWriter::writeArray()
+     *        without copying it. Fails when the source buffer isn't aligned
+     *        for the elements, and for elements of more than one byte on
+     *        big-endian platforms.
+     */
+    template<typename T>
+    bool
+    readArrayInPlace(std::span<const T>& values) {
+#if USING(GE_ENDIAN_BIG)
+      if constexpr (sizeof(T) > 1) {
+        return false;
+      }
+#endif
+      const T* data = nullptr;
+      uint32 count = 0;
+      if (!readArrayBlock(data, count) ||
+          0 != reinterpret_cast<uintptr_t>(data) % alignof(T)) {
+        return false;
+      }
+      values = std::span<const T>(data, count);
+      return true;
+    }
+
+    bool
+    readString(String& value);
+
+    /**
+     * @brief Skips the padding to the alignment and returns the next bytes
+     *        in the buffer, or nullptr when there are not enough of them.
+     */
+    const uint8*
+    readBlock(SIZE_T size, SIZE_T alignment = 1);
+
+    bool
+    seek(SIZE_T pos);
+
+    SIZE_T
+    tell() const {
+      return m_pos;
+    }
+
+    SIZE_T
+    size() const {
+      return m_size;
+    }
+
+   private:
+    template<typename T>
+    bool
+    readArrayBlock(const T*& data, uint32& count) {
+      if (!read(count)) {
+        return false;
+      }
+      const uint8* block = readBlock(SIZE_T(count) * sizeof(T),
+                                     MemoryRecordWriter::ARRAY_ALIGNMENT);
+      data = reinterpret_cast<const T*>(block);
+      return nullptr != block;
+    }
+
+    const uint8* m_data;
+    SIZE_T m_size;
+    SIZE_T m_pos = 0;
+  };
+
+  class GE_UTILITIES_EXPORT MemorySerializer
+  {
+   public:
+    /**
+     * "GESR"
+     */
+    static CONSTEXPR uint32 MAGIC = 0x52534547;
+
+    /**
+     * Version of the records. Older versions are still decoded.
+     */
+    static CONSTEXPR uint16 VERSION = 1;
+
     MemorySerializer() = default;
     ~MemorySerializer() = default;
 
+#if USING(GE_REFLECTION)
     /**
-     * @brief Parses the provided object, serializes all of its data as
-     *        specified by its RTTIType and returns the data in the form of raw
-     *        memory.
+     * @brief Serializes the properties that the type of the object registers
+     *        with RTTR, recursing into objects and containers. Pointers are
+     *        not followed and are restored as null.
      * @param[in] object        Object to encode.
      * @param[in] bytesWritten  Output value containing the total number of
      *            bytes it took to encode the object.
      * @param[in] allocator     Determines how is memory allocated. If not
-     *            specified the default allocator is used.
-     * @param[in] shallow       Determines how to handle referenced objects.
-     *            If true then references will not be encoded and will be set
-     *            to null. If false then references will be encoded as well and
-     *            restored upon decoding.
-     * @param[in] params        Optional parameters to be passed to the
-     *            serialization callbacks on the objects being serialized.
+     *            specified ge_alloc() is used.
      * @return  A buffer containing the encoded object. It is up to the user to
      *          release the buffer memory when no longer needed.
      */
     uint8*
-    encode(IReflectable* object,
+    encode(const rttr::instance& object,
            uint32& bytesWritten,
-           function<void*(SIZE_T)> allocator = nullptr,
-           bool shallow = false,
-           SerializationContext* context = nullptr);
+           const function<void*(SIZE_T)>& allocator = nullptr);
 
     /**
-     * @brief Deserializes an IReflectable object by reading the binary data
-              from the provided memory location.
-     * @param[in] buffer      Previously allocated buffer to store the data in.
+     * @brief Restores the properties of an object from the binary data. The
+     *        properties missing from the data, or stored with another type,
+     *        keep their values, and the ones that the type doesn't have
+     *        anymore are skipped.
+     * @param[in] buffer      Encoded data. The std::span properties point
+     *            into it, so it must outlive them and be aligned to 16 bytes
+     *            like the buffers from ge_alloc().
      * @param[in] bufferSize  Size of the @p buffer in bytes.
-     * @param[in] params      Optional parameters to be passed to the
-                  serialization callbacks on the objects being serialized.
+     * @param[in] object      Object of the type that was encoded.
+     * @return  False if the data is corrupted or of another type.
      */
-    SPtr<IReflectable>
-    decode(uint8* buffer,
-           uint32 bufferSize,
-           SerializationContext* context = nullptr);
-
-   private:
-    Vector<BufferPiece> m_bufferPieces;
+    bool
+    decode(const uint8* buffer, SIZE_T bufferSize, const rttr::instance& object);
 
     /**
-     * @brief Called by the binary serializer whenever the buffer gets full.
+     * @brief Creates an object of the encoded type with its default
+     *        constructor and restores its properties.
+     * @return  An invalid variant if the data is corrupted or the type isn't
+     *          registered.
      */
-    uint8*
-    flushBuffer(uint8* bufferStart, uint32 bytesWritten, uint32& newBufferSize);
+    rttr::variant
+    decode(const uint8* buffer, SIZE_T bufferSize);
+#endif
 
    private:
-    static CONSTEXPR const uint32 WRITE_BUFFER_SIZE = 16384;
+    /**
+     * Kept between calls to avoid growing it again for every object.
+     */
+    MemoryRecordWriter m_writer;
   };
 }
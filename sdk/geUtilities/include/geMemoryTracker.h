@@ -0,0 +1,203 @@
+/*****************************************************************************/
+/**
+ * @file    geMemoryTracker.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Tracks the live allocations of the engine allocators.
+ *
+ * Tracks the live allocations of the engine allocators. With
+ * GE_PROFILING_ENABLED the general, pool, stack and frame allocators report
+ * every allocation here while the module runs. Each one is counted under the
+ * tag that the thread set with GE_MEMORY_TAG() and, optionally, under the
+ * call stack that made it. Snapshots of the counters can be compared to find
+ * what allocates between two points, and the allocations still alive at
+ * shut down are logged as leaks.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geModule.h"
+
+namespace geEngineSDK {
+  /**
+   * @brief Allocation counters. The live values are negative in a diff when
+   *        more was freed than allocated.
+   */
+  struct MemoryStats
+  {
+    int64 liveBytes = 0;
+    int64 liveAllocs = 0;
+    int64 peakBytes = 0;
+    int64 totalAllocs = 0;
+    int64 totalFrees = 0;
+    int64 totalBytes = 0;
+  };
+
+  /**
+   * @brief Allocations made and freed during one frame.
+   */
+  struct MemoryFrameStats
+  {
+    int64 allocs = 0;
+    int64 frees = 0;
+    int64 bytes = 0;
+  };
+
+  struct MemoryTagStats
+  {
+    const char* name = nullptr;
+    MemoryStats stats;
+
+    /**
+     * The last frame closed by MemoryTracker::endFrame().
+     */
+    MemoryFrameStats lastFrame;
+  };
+
+  struct MemoryCallsiteStats
+  {
+    static CONSTEXPR uint32 MAX_FRAMES = 16;
+
+    uint64 hash = 0;
+    uint32 tag = 0;
+    uint32 numFrames = 0;
+    Array<void*, MAX_FRAMES> frames{};
+    MemoryStats stats;
+  };
+
+  struct MemorySnapshot
+  {
+    uint64 frame = 0;
+
+    /**
+     * By MEMORY_SOURCE::E.
+     */
+    Array<MemoryStats, MEMORY_SOURCE::kCount> sources;
+
+    /**
+     * By tag index, the first one is the allocations made without a tag.
+     */
+    Vector<MemoryTagStats> tags;
+
+    /**
+     * Only filled while the call stacks are captured.
+     */
+    Vector<MemoryCallsiteStats> callsites;
+  };
+
+  class GE_UTILITIES_EXPORT MemoryTracker : public Module<MemoryTracker>
+  {
+   public:
+    static CONSTEXPR uint32 MAX_TAGS = 256;
+
+    /**
+     * @param captureCallsites  Hashes the call stack of every allocation to
+     *                          count them per call site, which costs a stack
+     *                          walk per allocation.
+     */
+    explicit MemoryTracker(bool captureCallsites = false);
+    ~MemoryTracker();
+
+    /**
+     * @brief Records an allocation of the calling thread. The allocators do
+     *        it themselves when GE_PROFILING_ENABLED is set.
+     * @note  Frame allocations are only counted: FrameAlloc::clear() releases
+     *        them without freeing each one.
+     */
+    void
+    recordAlloc(void* ptr, SIZE_T bytes, MEMORY_SOURCE::E source);
+
+    /**
+     * @brief Records a free. Pointers allocated while the tracker didn't run
+     *        are ignored.
+     */
+    void
+    recordFree(void* ptr, MEMORY_SOURCE::E source);
+
+    /**
+     * @brief Closes the allocation counters of the frame. Called once per
+     *        frame by the main loop.
+     */
+    void
+    endFrame();
+
+    /**
+     * @brief Index of a tag, registering it the first time. The name must
+     *        stay alive while the tracker runs.
+     */
+    uint32
+    getTagIndex(const char* name);
+
+    /**
+     * @brief Tag of the allocations of the calling thread, 0 for none.
+     */
+    static uint32
+    getThreadTag();
+
+    static void
+    setThreadTag(uint32 tag);
+
+    MemorySnapshot
+    snapshot() const;
+
+    /**
+     * @brief What changed from one snapshot to a later one. The call sites
+     *        are sorted by the allocations they made in between.
+     */
+    static MemorySnapshot
+    diff(const MemorySnapshot& from, const MemorySnapshot& to);
+
+    /**
+     * @brief The live allocations by tag and the call sites with the most
+     *        live bytes, with their call stacks where the platform can
+     *        resolve them.
+     */
+    String
+    getLeakReport(uint32 maxCallsites = 16) const;
+
+   protected:
+    void
+    onShutDown() override;
+
+   private:
+    struct Impl;
+
+    Impl* m_impl;
+  };
+
+  /**
+   * @brief Tags the allocations of the calling thread for the life of the
+   *        object.
+   */
+  class GE_UTILITIES_EXPORT MemoryTagScope
+  {
+   public:
+    explicit MemoryTagScope(const char* name);
+    ~MemoryTagScope();
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+
+    MemoryTagScope&
+    operator=(const MemoryTagScope&) = delete;
+
+   private:
+    uint32 m_previousTag;
+  };
+}
+
+#define GE_MEMORY_TAG_CONCAT_IMPL(a, b) a##b
+#define GE_MEMORY_TAG_CONCAT(a, b) GE_MEMORY_TAG_CONCAT_IMPL(a, b)
+
+/**
+ * Tags the allocations made in the rest of the enclosing scope.
+ */
+#define GE_MEMORY_TAG(name)                                                    \
+  geEngineSDK::MemoryTagScope GE_MEMORY_TAG_CONCAT(_geMemoryTag, __LINE__)(name)
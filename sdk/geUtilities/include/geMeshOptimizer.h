@@ -0,0 +1,133 @@
+/*****************************************************************************/
+/**
+ * @file    geMeshOptimizer.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Reorders indexed triangle meshes for the GPU.
+ *
+ * Welds duplicated vertices and reorders the triangles and vertices of
+ * indexed triangle lists for the post-transform vertex cache, overdraw and
+ * vertex fetch. Meant to run when meshes are imported, not per frame.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+
+namespace geEngineSDK {
+
+  /**
+   * @brief Post-transform vertex cache efficiency of an index buffer,
+   *        simulated on a FIFO cache.
+   */
+  struct VertexCacheStatistics
+  {
+    /**
+     * Number of vertices the GPU has to transform (cache misses).
+     */
+    uint32 vertexTransforms = 0;
+
+    /**
+     * Average cache miss ratio, transformed vertices per triangle. 3 means
+     * no reuse at all, and regular grids get close to 0.5.
+     */
+    float acmr = 0.0f;
+
+    /**
+     * Average transform to vertex ratio, transformed vertices per referenced
+     * vertex. 1 is the best possible.
+     */
+    float atvr = 0.0f;
+  };
+
+  /**
+   * @brief Optimizes indexed triangle lists. The vertices are opaque blocks
+   *        of vertexSize bytes, only the overdraw pass reads the positions
+   *        (three floats at positionOffset).
+   * @note  The vertex cache pass is Tipsify (Sander, Nehab and Barczak, "Fast
+   *        Triangle Reordering for Vertex Locality and Reduced Overdraw",
+   *        2007), which runs in linear time. The overdraw pass splits its
+   *        output in clusters and sorts them from the outside in, keeping
+   *        most of the cache locality.
+   */
+  class GE_UTILITIES_EXPORT MeshOptimizer
+  {
+   public:
+    /**
+     * @brief Size of the FIFO cache the passes and the statistics assume.
+     */
+    static CONSTEXPR uint32 DEFAULT_CACHE_SIZE = 16;
+
+    /**
+     * @brief Merges the vertices that are byte for byte equal and remaps the
+     *        indices to them.
+     * @return The new number of vertices.
+     */
+    static uint32
+    weldVertices(Vector<uint8>& vertices, uint32 vertexSize, Vector<uint32>& indices);
+
+    /**
+     * @brief Reorders the triangles so the vertices they share are still on
+     *        the post-transform cache when they are used again.
+     */
+    static void
+    optimizeVertexCache(Vector<uint32>& indices,
+                        uint32 vertexCount,
+                        uint32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Reorders clusters of triangles so the ones facing out of the
+     *        mesh are drawn first and occlude the rest. Works on the output
+     *        of optimizeVertexCache().
+     * @param[in] threshold How much the cache miss ratio can get worse, 1.05
+     *            allows a 5% increase. Higher values make more and smaller
+     *            clusters, which sort better.
+     */
+    static void
+    optimizeOverdraw(Vector<uint32>& indices,
+                     const Vector<uint8>& vertices,
+                     uint32 vertexSize,
+                     uint32 positionOffset,
+                     float threshold = 1.05f,
+                     uint32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Reorders the vertices in the order the indices use them first,
+     *        so the GPU reads the vertex buffer mostly sequentially. Vertices
+     *        that no triangle uses are removed.
+     * @return The new number of vertices.
+     */
+    static uint32
+    optimizeVertexFetch(Vector<uint8>& vertices,
+                        uint32 vertexSize,
+                        Vector<uint32>& indices);
+
+    /**
+     * @brief Simulates the post-transform cache on an index buffer.
+     */
+    static VertexCacheStatistics
+    analyzeVertexCache(const Vector<uint32>& indices,
+                       uint32 vertexCount,
+                       uint32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief Runs all the passes in order: weld, vertex cache, overdraw and
+     *        vertex fetch.
+     * @param[in] positionOffset Offset of the position in a vertex, or
+     *            NumLimit::MAX_UINT32 to skip the overdraw pass.
+     * @return The new number of vertices.
+     */
+    static uint32
+    optimize(Vector<uint8>& vertices,
+             uint32 vertexSize,
+             uint32 positionOffset,
+             Vector<uint32>& indices);
+  };
+}
@@ -0,0 +1,124 @@
+/*****************************************************************************/
+/**
+ * @file    geMeshSimplifier.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Quadric error mesh simplification for LOD generation.
+ *
+ * Reduces the triangle count of indexed triangle lists by collapsing edges
+ * in the order of their quadric error. The simplified index buffers keep
+ * using the original vertices, so all the LODs of a mesh can share them.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geVector3.h"
+
+namespace geEngineSDK {
+
+  /**
+   * @brief A float vertex attribute that adds to the cost of a collapse, so
+   *        the simplification avoids the edges where it changes the most.
+   */
+  struct SimplifyAttribute
+  {
+    /**
+     * Offset of the attribute in a vertex.
+     */
+    uint32 offset = 0;
+
+    /**
+     * Number of floats in the attribute (3 for a normal, 2 for a uv).
+     */
+    uint32 components = 0;
+
+    /**
+     * How much a difference of 1 on the attribute costs, relative to moving a
+     * vertex as far as the size of the mesh.
+     */
+    float weight = 0.0f;
+  };
+
+  /**
+   * @brief A simplified version of a mesh.
+   */
+  struct SimplifiedLod
+  {
+    Vector<uint32> indices;
+
+    /**
+     * How far the surface moved from the original one, in the units of the
+     * positions.
+     */
+    float error = 0.0f;
+  };
+
+  /**
+   * @brief Simplifies indexed triangle lists. The vertices are opaque blocks
+   *        of vertexSize bytes with a float3 position at positionOffset.
+   * @note  Based on Garland and Heckbert, "Surface Simplification Using
+   *        Quadric Error Metrics" (1997), collapsing each vertex onto one of
+   *        its neighbors so no new vertices are made. The vertices on the
+   *        open borders of the mesh and on attribute seams (several vertices
+   *        with the same position) never move, which keeps the silhouette of
+   *        open meshes and avoids cracks between the uv charts.
+   */
+  class GE_UTILITIES_EXPORT MeshSimplifier
+  {
+   public:
+    /**
+     * @brief Collapses edges until the index count gets to targetIndexCount
+     *        or the next collapse would move the surface more than maxError.
+     * @param[out] outError The error of the result, see SimplifiedLod::error.
+     * @return The simplified indices, that use the same vertices.
+     */
+    static Vector<uint32>
+    simplify(const Vector<uint32>& indices,
+             const Vector<uint8>& vertices,
+             uint32 vertexSize,
+             uint32 positionOffset,
+             const Vector<SimplifyAttribute>& attributes,
+             uint32 targetIndexCount,
+             float maxError = NumLimit::MAX_FLOAT,
+             float* outError = nullptr);
+
+    /**
+     * @brief Builds a chain of LODs, each one with reduction times the
+     *        triangles of the previous. All of them are simplified from the
+     *        original indices, so the errors don't add up. The chain stops
+     *        early once a level can't get any smaller.
+     * @note  The triangles of every LOD are reordered for the post-transform
+     *        vertex cache, so they are ready to be drawn.
+     */
+    static Vector<SimplifiedLod>
+    generateLods(const Vector<uint32>& indices,
+                 const Vector<uint8>& vertices,
+                 uint32 vertexSize,
+                 uint32 positionOffset,
+                 const Vector<SimplifyAttribute>& attributes,
+                 uint32 lodCount,
+                 float reduction = 0.5f);
+
+    /**
+     * @brief Copies the positions used by a list of triangles to a compact,
+     *        position only mesh, e.g. to rasterize it as an occluder.
+     * @param[out] outPositions The positions, in the order they are first used.
+     * @param[out] outIndices   The triangles, indexing outPositions.
+     */
+    static void
+    extractPositions(const Vector<uint32>& indices,
+                     const Vector<uint8>& vertices,
+                     uint32 vertexSize,
+                     uint32 positionOffset,
+                     Vector<Vector3>& outPositions,
+                     Vector<uint32>& outIndices);
+  };
+}
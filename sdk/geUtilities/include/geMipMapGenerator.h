@@ -0,0 +1,151 @@
+/*****************************************************************************/
+/**
+ * @file    geMipMapGenerator.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Generates mip map chains for images on the CPU.
+ *
+ * Generates mip map chains for images on the CPU, filtering in linear space
+ * so sRGB images don't get darker on the lower levels.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+
+namespace geEngineSDK {
+  namespace MIP_FILTER {
+    enum E {
+      /**
+       * Averages the area of the source covered by each destination pixel.
+       * Fastest, slightly blurry.
+       */
+      kBox,
+
+      /**
+       * Kaiser windowed sinc. Keeps the lower levels sharper at a higher cost.
+       */
+      kKaiser
+    };
+  }
+
+  /**
+   * @brief Information about a single level of a mip chain.
+   */
+  struct MipLevel
+  {
+    uint32 width = 0;
+    uint32 height = 0;
+
+    /**
+     * @brief Rows are tightly packed, so this is width times the pixel size.
+     *        On block compressed chains it's the size of a row of blocks.
+     */
+    uint32 rowPitch = 0;
+
+    /**
+     * @brief Offset of the level inside MipChain::data.
+     */
+    SIZE_T offset = 0;
+  };
+
+  /**
+   * @brief All the levels of an image, stored one after the other on a
+   *        single buffer. Level 0 is the source image.
+   */
+  struct MipChain
+  {
+    Vector<MipLevel> levels;
+    Vector<uint8> data;
+
+    const uint8*
+    getLevelData(uint32 level) const {
+      return data.data() + levels[level].offset;
+    }
+  };
+
+  /**
+   * @brief Options used when generating a mip chain.
+   */
+  struct MipMapOptions
+  {
+    MIP_FILTER::E filter = MIP_FILTER::kBox;
+
+    /**
+     * @brief If the color channels of 8 bit images are sRGB encoded. Filtering
+     *        is always done on linear values. Ignored for float images.
+     * @note  Set it only for images uploaded with an _SRGB format, the UNORM
+     *        ones are filtered as they are stored.
+     */
+    bool bSRGB = false;
+
+    /**
+     * @brief Weights the colors by their alpha when filtering, so fully
+     *        transparent pixels don't bleed their color into the next levels.
+     */
+    bool bAlphaWeighted = true;
+
+    /**
+     * @brief Number of levels to generate including the source. Zero means
+     *        the full chain down to 1x1.
+     */
+    uint32 maxLevels = 0;
+
+    /**
+     * @brief Splits the rows of the big levels across the TaskScheduler
+     *        workers (if it's started). Disable it when already generating
+     *        several images in parallel.
+     */
+    bool bParallel = true;
+  };
+
+  /**
+   * @brief Generates mip chains for RGBA images on the CPU.
+   * @note  Each level is resampled from the previous one using a separable
+   *        filter on linear float values, and only quantized when stored.
+   */
+  class GE_UTILITIES_EXPORT MipMapGenerator
+  {
+   public:
+    /**
+     * @brief Returns the number of levels of a full chain for the given size.
+     */
+    static uint32
+    calcMipCount(uint32 width, uint32 height);
+
+    /**
+     * @brief Generates the mip chain for an image with 8 bits per channel.
+     * @param[in] pixels  Tightly packed RGBA pixels.
+     * @param[in] width   The width of the image in pixels.
+     * @param[in] height  The height of the image in pixels.
+     * @param[in] options Filtering options.
+     * @return The chain with RGBA8 levels, including a copy of the source.
+     */
+    static MipChain
+    generateRGBA8(const uint8* pixels,
+                  uint32 width,
+                  uint32 height,
+                  const MipMapOptions& options = MipMapOptions());
+
+    /**
+     * @brief Generates the mip chain for an image with float channels.
+     * @param[in] pixels  Tightly packed RGBA float pixels.
+     * @param[in] width   The width of the image in pixels.
+     * @param[in] height  The height of the image in pixels.
+     * @param[in] options Filtering options. bSRGB is ignored.
+     * @return The chain with RGBA32F levels, including a copy of the source.
+     */
+    static MipChain
+    generateRGBA32F(const float* pixels,
+                    uint32 width,
+                    uint32 height,
+                    const MipMapOptions& options = MipMapOptions());
+  };
+}
@@ -38,6 +38,10 @@ namespace geEngineSDK {
    *        paths, try to ensure that all directory paths end with a separator
    *        (\ or / depending on platform). System won't fail if you don't
    *        but it will be easier to misuse.
+   * @note  All the elements of the path (node, device, directories and
+   *        filename) are stored back to back on a single buffer, with a table
+   *        of offsets for the directories. Short paths don't allocate memory,
+   *        and the elements are returned as views into the buffer.
    */
   class GE_UTILITIES_EXPORT Path
   {
@@ -53,11 +57,10 @@ namespace geEngineSDK {
      */
     Path(const String& pathStr, PATH_TYPE::E type = PATH_TYPE::kDefault);
     Path(const ANSICHAR* pathStr, PATH_TYPE::E type = PATH_TYPE::kDefault);
+    Path(StringView pathStr, PATH_TYPE::E type = PATH_TYPE::kDefault);
 
-    /**
-     * @brief	Copy constructor
-     */
-    Path(const Path& other);
+    Path(const Path& other) = default;
+    Path(Path&& other) = default;
 
     /**
      * @brief Assigns a path by parsing the provided path string. Path will be
@@ -66,7 +69,8 @@ namespace geEngineSDK {
      */
     Path& operator=(const String& pathStr);
     Path& operator=(const ANSICHAR* pathStr);
-    Path& operator=(const Path& path);
+    Path& operator=(const Path& path) = default;
+    Path& operator=(Path&& path) = default;
 
     /**
      * @brief Compares two paths and returns true if they match. Comparison is
@@ -89,7 +93,7 @@ namespace geEngineSDK {
     /**
      * @brief Gets a directory name with the specified index from the path.
      */
-    const String&
+    StringView
     operator[](SIZE_T idx) const {
       return getDirectory(idx);
     }
@@ -122,6 +126,12 @@ namespace geEngineSDK {
     void
     assign(const String& pathStr, PATH_TYPE::E type = PATH_TYPE::kDefault);
 
+    /**
+     * @copydoc void Path::assign(const ANSICHAR*, PATH_TYPE::E)
+     */
+    void
+    assign(StringView pathStr, PATH_TYPE::E type = PATH_TYPE::kDefault);
+
     /**
      * @brief Converts the path in a string according to platform path rules.
      * @param[in] type  If set to default path will be parsed according to the
@@ -151,7 +161,7 @@ namespace geEngineSDK {
      */
     bool
     isDirectory() const {
-      return m_filename.empty();
+      return getFilenameStart() == m_buffer.size();
     }
 
     /**
@@ -159,7 +169,7 @@ namespace geEngineSDK {
      */
     bool
     isFile() const {
-      return !m_filename.empty();
+      return !isDirectory();
     }
 
     /**
@@ -252,34 +262,41 @@ namespace geEngineSDK {
     bool
     equals(const Path& other) const;
 
+    /**
+     * @brief Returns a hash of the path that is consistent with equals(),
+     *        so it's case insensitive and a trailing separator doesn't
+     *        change it. Doesn't allocate memory.
+     */
+    SIZE_T
+    getHash() const;
+
     /**
      * @brief Change or set the filename in the path.
      */
     void
-    setFilename(const String& filename) {
-      m_filename = filename;
-    }
+    setFilename(StringView filename);
 
     /**
      * @brief	Change or set the base name in the path. Base name changes the filename
      *        by changing its base to the provided value but keeping extension intact.
      */
     void
-    setBasename(const String& basename);
+    setBasename(StringView basename);
 
     /**
      * @brief Change or set the extension of the filename in the path.
      * @param[in] extension Extension with a leading ".".
      */
     void
-    setExtension(const String& extension);
+    setExtension(StringView extension);
 
     /**
      * @brief Returns a filename with extension.
+     * @note  The view is invalidated when the path is modified.
      */
-    const String&
+    StringView
     getFilename() const {
-      return m_filename;
+      return getView(getFilenameStart(), m_buffer.size());
     }
 
     /**
@@ -300,36 +317,37 @@ namespace geEngineSDK {
      */
     SIZE_T
     getNumDirectories() const {
-      return m_directories.size();
+      return m_directoryEnds.size();
     }
 
     /**
      * @brief Gets a directory name with the specified index from the path.
+     * @note  The view is invalidated when the path is modified.
      */
-    const String&
+    StringView
     getDirectory(SIZE_T idx) const;
 
     /**
      * @brief Returns path device (e.g. drive, volume, etc.) if one exists in the path.
      */
-    const String&
+    StringView
     getDevice() const {
-      return m_device;
+      return getView(m_nodeLength, m_nodeLength + m_deviceLength);
     }
 
     /**
      * @brief Returns path node (e.g. network name) if one exists in the path.
      */
-    const String&
+    StringView
     getNode() const {
-      return m_node;
+      return getView(0, m_nodeLength);
     }
 
     /**
      * @brief Gets last element in the path, filename if it exists, otherwise
-     *        the last directory. If no directories exist returns device or node.
+     *        the last directory. If no directories exist returns an empty view.
      */
-    const String&
+    StringView
     getTail() const;
 
     /**
@@ -343,10 +361,7 @@ namespace geEngineSDK {
      */
     bool
     isEmpty() const {
-      return (m_directories.empty() && 
-              m_filename.empty() && 
-              m_device.empty() && 
-              m_node.empty());
+      return m_buffer.empty();
     }
 
     /**
@@ -365,7 +380,7 @@ namespace geEngineSDK {
      * @brief Compares two path elements (i.e. filenames, directory names, etc.)
      */
     static bool
-    comparePathElem(const String& left, const String& right);
+    comparePathElem(StringView left, StringView right);
 
     /**
      * @brief Combines two paths and returns the result. Right path should be relative.
@@ -382,168 +397,34 @@ namespace geEngineSDK {
 
    private:
     /**
-     * @brief Constructs a path by parsing the provided raw string data.
-     *        Throws exception if provided path is not valid.
-     * @param[in] type  If set to default path will be parsed according to the
-     *                  rules of the platform the application is being compiled to.
-     *                  Otherwise it will be parsed according to provided type.
+     * @brief Characters stored on the object before falling back to the heap.
      */
-    void
-    assign(const ANSICHAR* pathStr, SIZE_T numChars, PATH_TYPE::E type = PATH_TYPE::kDefault);
+    static CONSTEXPR uint32 INLINE_CHARS = 96;
+
+    /**
+     * @brief Directories stored on the object before falling back to the heap.
+     */
+    static CONSTEXPR uint32 INLINE_DIRECTORIES = 8;
 
     /**
      * @brief Parses a Windows path and stores the parsed data internally.
      *        Throws an exception if parsing fails.
      */
-    template<class T>
     void
-    parseWindows(const T* pathStr, SIZE_T numChars) {
-      clear();
-
-      SIZE_T idx = 0;
-      BasicStringStream<T> tempStream;
-
-      if (idx < numChars) {
-        if ('\\' == pathStr[idx] || '/' == pathStr[idx]) {
-          m_isAbsolute = true;
-          ++idx;
-        }
-      }
-
-      if (idx < numChars) { //Path starts with a node, a drive letter or is relative
-        if (m_isAbsolute && ('\\' == pathStr[idx] || '/' ==pathStr[idx])) {//Node
-          ++idx;
-          tempStream.str(BasicString<T>());
-          tempStream.clear();
-
-          while (idx < numChars && '\\' != pathStr[idx] && '/' != pathStr[idx]) {
-            tempStream << pathStr[idx++];
-          }
-
-          setNode(tempStream.str());
-
-          if (idx < numChars) {
-            ++idx;
-          }
-        }
-        else {  //A drive letter or not absolute
-          T drive = pathStr[idx];
-          ++idx;
-
-          if (idx < numChars && ':' == pathStr[idx]) {
-            if (m_isAbsolute 
-                || !(('a' <= drive && 'z' >= drive) 
-                || ('A' <= drive && 'Z' >= drive))) {
-              //The drive letter is not valid
-              throwInvalidPathException(BasicString<T>(pathStr, numChars));
-            }
-
-            m_isAbsolute = true;
-            setDevice(String(1, drive));
-
-            ++idx;
-            if (idx >= numChars || ('\\' != pathStr[idx] && '/' != pathStr[idx])) {
-              //The path does not end with a trailing slash
-              throwInvalidPathException(BasicString<T>(pathStr, numChars));
-            }
-
-            ++idx;
-          }
-          else {
-            --idx;
-          }
-        }
-
-        while (idx < numChars) {
-          tempStream.str(BasicString<T>());
-          tempStream.clear();
-          while (idx < numChars && '\\' != pathStr[idx] && '/' != pathStr[idx]) {
-            tempStream << pathStr[idx];
-            ++idx;
-          }
-
-          if (idx < numChars) {
-            pushDirectory(tempStream.str());
-          }
-          else {
-            setFilename(tempStream.str());
-          }
-
-          ++idx;
-        }
-      }
-    }
+    parseWindows(const ANSICHAR* pathStr, SIZE_T numChars);
 
     /**
      * @brief Parses a Unix path and stores the parsed data internally.
      *        Throws an exception if parsing fails.
      */
-    template<class T>
     void
-    parseUnix(const T* pathStr, SIZE_T numChars) {
-      clear();
-
-      SIZE_T idx = 0;
-      BasicStringStream<T> tempStream;
-
-      if (idx < numChars) {
-        if (pathStr[idx] == '/') {
-          m_isAbsolute = true;
-          ++idx;
-        }
-        else if (pathStr[idx] == '~') {
-          ++idx;
-          if (idx >= numChars || '/' == pathStr[idx]) {
-            pushDirectory(String("~"));
-            m_isAbsolute = true;
-          }
-          else {
-            --idx;
-          }
-        }
-
-        while (idx < numChars) {
-          tempStream.str(BasicString<T>());
-          tempStream.clear();
-
-          while (idx < numChars && '/' != pathStr[idx]) {
-            tempStream << pathStr[idx];
-            ++idx;
-          }
-
-          if (idx < numChars) {
-            if (m_directories.empty()) {
-              BasicString<T> deviceStr = tempStream.str();
-              if (!deviceStr.empty() && ':' == *(deviceStr.rbegin())) {
-                setDevice(deviceStr.substr(0, deviceStr.length() - 1));
-                m_isAbsolute = true;
-              }
-              else {
-                pushDirectory(deviceStr);
-              }
-            }
-            else {
-              pushDirectory(tempStream.str());
-            }
-          }
-          else {
-            setFilename(tempStream.str());
-          }
-
-          ++idx;
-        }
-      }
-    }
+    parseUnix(const ANSICHAR* pathStr, SIZE_T numChars);
 
     void
-    setNode(const String& node) {
-      m_node = node;
-    }
+    setNode(StringView node);
 
     void
-    setDevice(const String& device) {
-      m_device = device;
-    }
+    setDevice(StringView device);
 
     /**
      * @brief Build a Windows path string from internal path data.
@@ -561,24 +442,65 @@ namespace geEngineSDK {
      * @brief Add new directory to the end of the path.
      */
     void
-    pushDirectory(const String& dir);
+    pushDirectory(StringView dir);
+
+    /**
+     * @brief Removes the last directory of the path.
+     */
+    void
+    popDirectory();
+
+    /**
+     * @brief Offset of the first character of the directories.
+     */
+    uint32
+    getDirectoriesStart() const {
+      return m_nodeLength + m_deviceLength;
+    }
+
+    /**
+     * @brief Offset of the first character of a directory.
+     */
+    uint32
+    getDirectoryStart(SIZE_T idx) const {
+      return 0 == idx ? getDirectoriesStart() :
+                        m_directoryEnds[static_cast<uint32>(idx - 1)];
+    }
+
+    /**
+     * @brief Offset of the first character of the filename.
+     */
+    uint32
+    getFilenameStart() const {
+      return m_directoryEnds.empty() ? getDirectoriesStart() : m_directoryEnds.back();
+    }
+
+    StringView
+    getView(uint32 start, uint32 end) const {
+      return StringView(m_buffer.data() + start, end - start);
+    }
+
+    /**
+     * @brief Replaces a range of the buffer with the provided text. Offsets
+     *        of the elements after the range must be updated by the caller.
+     */
+    void
+    replaceText(uint32 start, uint32 length, StringView text);
 
     /**
      * @brief Helper method that throws invalid path exception.
      */
     static void
-    throwInvalidPathException(const String& path);
+    throwInvalidPathException(const ANSICHAR* pathStr, SIZE_T numChars);
 
    public:
     static const Path BLANK;
 
    private:
-    friend struct ::std::hash<geEngineSDK::Path>;
-
-    Vector<String> m_directories;
-    String m_device;
-    String m_filename;
-    String m_node;
+    SmallVector<ANSICHAR, INLINE_CHARS> m_buffer;
+    SmallVector<uint32, INLINE_DIRECTORIES> m_directoryEnds;
+    uint32 m_nodeLength = 0;
+    uint32 m_deviceLength = 0;
     bool m_isAbsolute = false;
   };
 }
@@ -591,17 +513,8 @@ namespace std {
   struct hash<geEngineSDK::Path>
   {
     size_t
-      operator()(const geEngineSDK::Path& path) const {
-      size_t hashVal = 0;
-      geEngineSDK::ge_hash_combine(hashVal, path.m_filename);
-      geEngineSDK::ge_hash_combine(hashVal, path.m_device);
-      geEngineSDK::ge_hash_combine(hashVal, path.m_node);
-
-      for (const auto& dir : path.m_directories) {
-        geEngineSDK::ge_hash_combine(hashVal, dir);
-      }
-
-      return hashVal;
+    operator()(const geEngineSDK::Path& path) const {
+      return path.getHash();
     }
   };
 }
@@ -0,0 +1,100 @@
+/*****************************************************************************/
+/**
+ * @file    gePathID.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   An interned path identifier for very fast comparisons
+ *
+ * An interned path identifier that provides very fast comparisons and can be
+ * used as a map key.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geStringID.h"
+
+namespace geEngineSDK {
+  /**
+   * @class PathID
+   * @brief Identifier of a path, interned on the StringID table using the
+   *        canonical (lower case, '/' separated) form of the path. Two ids
+   *        compare equal when the paths would be equal by Path::equals(), and
+   *        the comparison and the hash are a single integer operation.
+   * @note  Thread safe. Interning a path costs a hash and a table lookup, so
+   *        create the ids once (e.g. when indexing files) and keep them.
+   */
+  class GE_UTILITIES_EXPORT PathID
+  {
+   public:
+    PathID() = default;
+
+    explicit PathID(const Path& path);
+
+    bool
+    operator==(const PathID& rhs) const {
+      return m_id == rhs.m_id;
+    }
+
+    bool
+    operator!=(const PathID& rhs) const {
+      return m_id != rhs.m_id;
+    }
+
+    /**
+     * @brief Returns true if the id has no path assigned.
+     */
+    bool
+    empty() const {
+      return m_id.empty();
+    }
+
+    /**
+     * @brief Returns the unique identifier of the path.
+     */
+    uint32
+    id() const {
+      return m_id.id();
+    }
+
+    /**
+     * @brief Returns the canonical form of the path the id was created from.
+     */
+    const ANSICHAR*
+    c_str() const {
+      return m_id.c_str();
+    }
+
+    /**
+     * @brief Returns a path parsed from the canonical form. The elements are
+     *        lower case, so it only matches the original path on case
+     *        insensitive file systems.
+     */
+    Path
+    toPath() const;
+
+   private:
+    StringID m_id;
+  };
+}
+
+namespace std {
+  /**
+   * Hash value generator for PathID.
+   */
+  template<>
+  struct hash<geEngineSDK::PathID>
+  {
+    size_t
+    operator()(const geEngineSDK::PathID& value) const {
+      return static_cast<size_t>(value.id());
+    }
+  };
+}
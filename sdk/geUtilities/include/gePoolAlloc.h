@@ -139,6 +139,9 @@ namespace geEngineSDK {
       ++m_totalNumElems;
       byte* output = m_freeBlock->alloc();
 
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+      MemoryCounter::trackAlloc(output, ElemSize, MEMORY_SOURCE::kPool);
+#endif
       return output;
     }
 
@@ -147,6 +150,9 @@ namespace geEngineSDK {
      */
     void
     free(void* data) {
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+      MemoryCounter::trackFree(data, MEMORY_SOURCE::kPool);
+#endif
       ScopedLock<Lock> lock(m_lockPolicy);
 
       MemBlock* curBlock = m_freeBlock;
@@ -0,0 +1,230 @@
+/*****************************************************************************/
+/**
+ * @file    geProfiler.h
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Hierarchical CPU profiler.
+ *
+ * Hierarchical CPU profiler. Code marks zones with GE_PROFILE_SCOPE("name"),
+ * every thread writes the zones it closes to its own ring buffer without
+ * locks, and at the end of each frame the buffers are collected into a tree
+ * of zones per thread. The zones of the last frames can be exported in the
+ * Chrome trace format, which chrome://tracing and Perfetto open.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+#pragma once
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePrerequisitesUtilities.h"
+#include "geModule.h"
+
+namespace geEngineSDK {
+  /**
+   * @brief A zone closed by a thread. Times are in nanoseconds of
+   *        Profiler::now().
+   */
+  struct ProfileEvent
+  {
+    const char* name;
+    uint64 begin;
+    uint64 end;
+    uint32 depth;
+  };
+
+  /**
+   * @brief The zones with the same name and parent that a thread closed in a
+   *        frame, merged.
+   */
+  struct ProfileNode
+  {
+    const char* name = nullptr;
+
+    /**
+     * Index of the parent in ProfileFrame::nodes, NumLimit::MAX_UINT32 for
+     * the root of a thread.
+     */
+    uint32 parent = NumLimit::MAX_UINT32;
+
+    /**
+     * Index of the thread in Profiler::getThreadNames().
+     */
+    uint32 thread = 0;
+
+    uint32 calls = 0;
+    uint64 totalTime = 0;
+
+    /**
+     * Time not spent in the child zones.
+     */
+    uint64 selfTime = 0;
+  };
+
+  struct ProfileFrame
+  {
+    uint64 index = 0;
+    uint64 begin = 0;
+    uint64 end = 0;
+
+    /**
+     * One root per thread that closed zones in the frame, and the parents
+     * always before their children.
+     */
+    Vector<ProfileNode> nodes;
+  };
+
+  class GE_UTILITIES_EXPORT Profiler : public Module<Profiler>
+  {
+   public:
+    /**
+     * @brief Zones a thread can close between two frames. The ones past it
+     *        are dropped and counted.
+     */
+    static CONSTEXPR uint32 RING_SIZE = 8192;
+
+    /**
+     * @brief Zones deeper than this are not recorded.
+     */
+    static CONSTEXPR uint32 MAX_DEPTH = 64;
+
+    Profiler();
+    ~Profiler();
+
+    /**
+     * @brief Opens a zone on the calling thread. The name must stay alive
+     *        while the profiler runs, use internName() for the ones that
+     *        don't.
+     */
+    static void
+    beginZone(const char* name);
+
+    /**
+     * @brief Closes the last zone opened by the calling thread.
+     */
+    static void
+    endZone();
+
+    /**
+     * @brief Nanoseconds of the clock used for the zones.
+     */
+    static uint64
+    now();
+
+    /**
+     * @brief Collects the zones closed by every thread since the last call
+     *        into the frame returned by getLastFrame(). Called once per frame
+     *        by the main loop.
+     */
+    void
+    endFrame();
+
+    const ProfileFrame&
+    getLastFrame() const {
+      return m_lastFrame;
+    }
+
+    /**
+     * @brief Keeps the zones of the last numFrames frames for
+     *        exportChromeTrace(), 0 keeps none.
+     */
+    void
+    setCapturedFrames(uint32 numFrames);
+
+    /**
+     * @brief The captured frames in the Chrome trace event format (JSON).
+     */
+    String
+    exportChromeTrace() const;
+
+    /**
+     * @brief Names the calling thread in the frames and in the exports.
+     */
+    void
+    setThreadName(const String& name);
+
+    /**
+     * @brief Names of the threads that recorded zones, by thread index.
+     */
+    Vector<String>
+    getThreadNames() const;
+
+    /**
+     * @brief A copy of the name that lives as long as the profiler, the same
+     *        pointer for the same name.
+     */
+    const char*
+    internName(const String& name);
+
+    /**
+     * @brief Zones dropped because a ring buffer was full.
+     */
+    uint64
+    getNumDroppedZones() const;
+
+   private:
+    struct ThreadState;
+
+    struct CapturedEvent
+    {
+      ProfileEvent event;
+      uint32 thread;
+    };
+
+    ThreadState&
+    getThreadState();
+
+    void
+    buildFrameTree(uint32 thread, Vector<ProfileEvent>& events);
+
+    //Tells the states of this instance from the ones of a restarted module
+    uint64 m_instanceId;
+
+    mutable Mutex m_mutex;
+    Vector<ThreadState*> m_threads;
+
+    Mutex m_namesMutex;
+    UnorderedSet<String> m_names;
+
+    uint64 m_frameIndex = 0;
+    uint64 m_frameBegin = 0;
+    ProfileFrame m_lastFrame;
+    Vector<ProfileEvent> m_drained;
+
+    uint32 m_capturedFrames = 0;
+    Deque<Vector<CapturedEvent>> m_captured;
+  };
+
+  /**
+   * @brief Opens a zone for the life of the object.
+   */
+  class ProfileScope
+  {
+   public:
+    explicit ProfileScope(const char* name) {
+      Profiler::beginZone(name);
+    }
+
+    ~ProfileScope() {
+      Profiler::endZone();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+
+    ProfileScope&
+    operator=(const ProfileScope&) = delete;
+  };
+}
+
+#define GE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GE_PROFILE_CONCAT(a, b) GE_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Profiles the rest of the enclosing scope as a zone.
+ */
+#define GE_PROFILE_SCOPE(name)                                                 \
+  geEngineSDK::ProfileScope GE_PROFILE_CONCAT(_geProfileScope, __LINE__)(name)
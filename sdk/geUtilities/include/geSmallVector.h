@@ -516,7 +516,7 @@ namespace geEngineSDK {
      */
     bool
     isSmall() const {
-      return m_elements == reinterpret_cast<Type*>(m_storage);
+      return m_elements == reinterpret_cast<const Type*>(m_storage);
     }
 
     void
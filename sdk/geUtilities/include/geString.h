@@ -22,6 +22,7 @@
 #include "geMemoryAllocator.h"
 #include "geFwdDeclUtil.h"
 #include <string>
+#include <string_view>
 
 namespace geEngineSDK {
   enum class LogVerbosity;
@@ -102,6 +103,16 @@ namespace geEngineSDK {
    */
   using U32StringStream = BasicStringStream<char32_t>;
 
+  /**
+   * @brief Non owning view of a narrow string.
+   */
+  using StringView = std::basic_string_view<ANSICHAR>;
+
+  /**
+   * @brief Non owning view of a wide string.
+   */
+  using WStringView = std::basic_string_view<UNICHAR>;
+
   /**
    * @brief Equivalent to String, except it avoids any dynamic allocations
    *        until the number of elements exceeds @p Count.
@@ -841,12 +852,31 @@ namespace geEngineSDK {
     /**
      * @copydoc StringFormat::format
      */
-    template<class T, class... Args>
-    GE_NODISCARD static BasicString<T>
-    format(const T* source, Args&&... args) {
+    template<class S, class... Args>
+    requires std::is_pointer_v<S>
+    GE_NODISCARD static auto
+    format(const S& source, Args&&... args) {
       return StringFormat::format(source, std::forward<Args>(args)...);
     }
 
+    /**
+     * @copydoc StringFormat::format
+     */
+    template<class... Args>
+    GE_NODISCARD static String
+    format(FormatString<Args...> fmt, Args&&... args) {
+      return StringFormat::format(fmt, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @copydoc StringFormat::format
+     */
+    template<class... Args>
+    GE_NODISCARD static WString
+    format(WFormatString<Args...> fmt, Args&&... args) {
+      return StringFormat::format(fmt, std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Constant blank string, useful for returning by ref where local does not exist.
      */
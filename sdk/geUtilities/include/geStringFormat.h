@@ -18,6 +18,7 @@
  */
 /*****************************************************************************/
 #include "geNumericLimits.h"
+#include <charconv>
 
 namespace geEngineSDK {
   using std::forward;
@@ -29,381 +30,686 @@ namespace geEngineSDK {
   using std::is_same;
 
   /**
-   * @class StringFormat
-   * @brief Helper class used for string formatting operations
+   * @brief Destination of a formatting operation: a buffer provided by the
+   *        caller. Characters that don't fit are dropped, but still counted,
+   *        so the caller can find out the size it needs.
    */
-  class StringFormat
+  template<class T>
+  class BasicFormatBuffer
   {
-   private:
+   public:
+    BasicFormatBuffer(T* data, SIZE_T capacity)
+      : m_data(data),
+        m_capacity(capacity)
+    {}
+
+    void
+    append(const T* str, SIZE_T count) {
+      if (m_size < m_capacity) {
+        const SIZE_T numToCopy = std::min(count, m_capacity - m_size);
+        memcpy(m_data + m_size, str, numToCopy * sizeof(T));
+      }
+      m_size += count;
+    }
+
     /**
-     * @brief Data structure used during string formatting. It holds information
-     *        about parameter identifiers to replace with actual parameters.
+     * @brief Appends narrow characters, widening them if needed. Only meant
+     *        for the ASCII output of number conversions.
      */
-    struct FormatParamRange
-    {
-      FormatParamRange() = default;
-      FormatParamRange(SIZE_T start, uint32 identifierSize, uint32 paramIdx) :
-        m_start(start), m_identifierSize(identifierSize), m_paramIdx(paramIdx) {}
+    void
+    appendASCII(const ANSICHAR* str, SIZE_T count) {
+      if CONSTEXPR(is_same<T, ANSICHAR>::value) {
+        append(str, count);
+      }
+      else {
+        for (SIZE_T i = 0; i < count; ++i) {
+          if (m_size < m_capacity) {
+            m_data[m_size] = static_cast<T>(str[i]);
+          }
+          ++m_size;
+        }
+      }
+    }
 
-      SIZE_T m_start = 0;
-      uint32 m_identifierSize = 0;
-      uint32 m_paramIdx = 0;
+    /**
+     * @brief Number of characters written so far, including the ones that
+     *        didn't fit.
+     */
+    SIZE_T
+    size() const {
+      return m_size;
+    }
+
+    bool
+    isTruncated() const {
+      return m_size > m_capacity;
+    }
+
+   private:
+    T* m_data;
+    SIZE_T m_capacity;
+    SIZE_T m_size = 0;
+  };
+
+  /**
+   * @brief A single argument of a formatting operation. Numbers and strings
+   *        are written directly to the output, anything else goes through
+   *        toString() / toWString().
+   */
+  template<class T>
+  struct FormatArg
+  {
+    enum class TYPE : uint8 {
+      kNone,
+      kBool,
+      kInt,
+      kUInt,
+      kDouble,
+      kString,
+      kCustom
     };
 
+    using CustomFn = void(*)(BasicFormatBuffer<T>&, const void*);
+
+    TYPE m_type = TYPE::kNone;
+    union {
+      bool m_bool;
+      int64 m_int;
+      uint64 m_uint;
+      double m_double;
+      struct {
+        const T* m_data;
+        SIZE_T m_size;
+      } m_string;
+      struct {
+        const void* m_value;
+        CustomFn m_fn;
+      } m_custom;
+    };
+  };
+
+  /**
+   * @brief A format string parsed at compile time. The identifiers are
+   *        validated against the number of arguments, so referencing a
+   *        parameter that is not passed doesn't compile.
+   * @note  Constructed implicitly from string literals. Strings only known at
+   *        run time are wrapped with StringFormat::runtime().
+   */
+  template<class T, class... Args>
+  class BasicFormatString
+  {
+   public:
+    using CharType = T;
+
     /**
-     * @brief Structure that holds value of a parameter during string formatting.
+     * @brief Pre-parsed piece of the format string: a run of literal text
+     *        followed by a parameter (or NO_PARAM).
      */
-    template<class T>
-    struct ParamData
+    struct Op
     {
-      T* m_buffer = nullptr;
-      SIZE_T m_size = 0;
+      uint16 m_start = 0;
+      uint16 m_length = 0;
+      uint16 m_paramIdx = 0;
     };
 
-   public:
+    static CONSTEXPR uint16 NO_PARAM = 0xFFFF;
+
     /**
-     * @brief	Formats the provided string by replacing the identifiers with the
-     *        provided parameters. The identifiers are represented like "{0}, {1}"
-     *        in the source string, where the number represents the position of the
-     *        parameter that will be used for replacing the identifier.
-     *
-     * @note  You may use "\" to escape ID brackets.
-     * @note  Maximum ID number is 19 (for a total of 20 unique IDs.
-     *        e.g. {20} won't be recognized as an Identifier).
-     * @note  Total number of parameters that can be referenced is 200.
+     * @brief Maximum number of operations stored. Longer strings are
+     *        validated anyway, and parsed again at run time.
      */
-    template<class T, class... Args>
-    static BasicString<T>
-    format(const T* source, Args&&... args) {
-      //Get the length of the string
-      SIZE_T strLength = getLength(source);
+    static CONSTEXPR uint32 MAX_OPS = 16;
+
+    template<SIZE_T N>
+    consteval BasicFormatString(const T (&source)[N])
+      : m_source(source),
+        m_length(N - 1) {
+      OpRecorder recorder{ this };
+      parse(m_source, m_length, recorder);
+
+      m_bParsed = !recorder.m_bOverflow && m_length <= NO_PARAM;
+      if (!m_bParsed) {
+        m_numOps = 0;
+      }
+    }
 
-      //Create an array to store the parameters and fill it with the parameters sent
-      ParamData<T> parameters[MAX_PARAMS]{};
-      getParams(parameters, 0U, std::forward<Args>(args)...);
+    static CONSTEXPR BasicFormatString
+    runtime(const T* source, SIZE_T length) {
+      return BasicFormatString(source, length, RuntimeTag{});
+    }
 
-      //Brackets characters plus NULL terminator
-      T bracketChars[MAX_IDENTIFIER_SIZE + 1];
-      uint32 bracketWriteIdx = 0;
+    const T*
+    getSource() const {
+      return m_source;
+    }
 
-      FormatParamRange paramRanges[MAX_PARAM_REFERENCES]{};
-      SIZE_T paramRangeWriteIdx = 0;
+    SIZE_T
+    getLength() const {
+      return m_length;
+    }
 
-      //Determine parameter positions
-      int32 lastBracket = -1;
-      SIZE_T charWriteIdx = 0;
+    /**
+     * @brief Walks the pieces of the string: calls onLiteral(start, length)
+     *        for literal text and onParam(idx) for the identifiers.
+     */
+    template<class Handler>
+    void
+    visit(Handler& handler) const {
+      if (!m_bParsed) {
+        parse(m_source, m_length, handler);
+        return;
+      }
 
-      for (SIZE_T i = 0; i < strLength; ++i) {
-        //Brace escaping: "{{" -> "{", "}}" -> "}"
-        if (lastBracket == -1 && (i + 1) < strLength &&
-            paramRangeWriteIdx < MAX_PARAM_REFERENCES) {
-          if (source[i] == '{' && source[i + 1] == '{') {
-            //Remove one '{' from output
-            paramRanges[paramRangeWriteIdx++] =
-              FormatParamRange(charWriteIdx, 1, NumLimit::MAX_UINT32);
-
-            ++charWriteIdx; //one literal '{' remains
-            ++i;            //skip the second '{'
-            continue;
-          }
+      for (uint32 i = 0; i < m_numOps; ++i) {
+        const Op& op = m_ops[i];
+        if (0 < op.m_length) {
+          handler.onLiteral(op.m_start, op.m_length);
+        }
+        if (NO_PARAM != op.m_paramIdx) {
+          handler.onParam(op.m_paramIdx);
+        }
+      }
+    }
 
-          if (source[i] == '}' && source[i + 1] == '}') {
-            //Remove one '}' from output
-            paramRanges[paramRangeWriteIdx++] =
-              FormatParamRange(charWriteIdx, 1, NumLimit::MAX_UINT32);
+    /**
+     * @brief Parses a format string. Shared by the compile time and the run
+     *        time paths so both give the same result.
+     */
+    template<class Handler>
+    static CONSTEXPR void
+    parse(const T* source, SIZE_T length, Handler& handler) {
+      SIZE_T runStart = 0;
+      SIZE_T i = 0;
+      while (i < length) {
+        const T ch = source[i];
 
-            ++charWriteIdx; //one literal '}' remains
-            ++i;            //skip the second '}'
-            continue;
-          }
+        //Brace escaping: "{{" -> "{", "}}" -> "}"
+        if (('{' == ch || '}' == ch) && (i + 1) < length && ch == source[i + 1]) {
+          handler.onLiteral(runStart, i + 1 - runStart);
+          i += 2;
+          runStart = i;
+          continue;
         }
 
-        if (-1 == lastBracket) {
-          //If current char is non-escaped opening bracket start parameter definition
-          if ('{' == source[i]) {
-            lastBracket = static_cast<int32>(i);
+        if ('{' == ch) {
+          SIZE_T j = i + 1;
+          uint32 paramIdx = 0;
+          uint32 numDigits = 0;
+          while (j < length && '0' <= source[j] && '9' >= source[j] &&
+                 numDigits < MAX_IDENTIFIER_SIZE) {
+            paramIdx = paramIdx * 10 + static_cast<uint32>(source[j] - '0');
+            ++numDigits;
+            ++j;
           }
-          else {
-            ++charWriteIdx;
-          }
-        }
-        else {
-          if (isdigit(source[i]) && bracketWriteIdx < MAX_IDENTIFIER_SIZE) {
-            bracketChars[bracketWriteIdx++] = source[i];
-          }
-          else {
-            //If current char is non-escaped closing bracket end parameter definition
-            const uint32 numParamChars = bracketWriteIdx;
-            bool processedBracket = false;
-            if ('}' == source[i] && 0 < numParamChars) {
-              bracketChars[bracketWriteIdx] = '\0';
-              const uint32 paramIdx = strToInt(bracketChars);
-
-              //Check if exceeded maximum parameter limit
-              if (MAX_PARAMS > paramIdx && MAX_PARAM_REFERENCES > paramRangeWriteIdx) {
-                paramRanges[paramRangeWriteIdx++] =
-                  FormatParamRange(charWriteIdx, numParamChars + 2, paramIdx);
-                charWriteIdx += parameters[paramIdx].m_size;
-                processedBracket = true;
-              }
-            }
-
-            if (!processedBracket) {
-              //Last bracket wasn't really a parameter
-              for (auto j = static_cast<uint32>(lastBracket); j <= i; ++j) {
-                ++charWriteIdx;
-              }
-            }
-
-            lastBracket = -1;
-            bracketWriteIdx = 0;
+
+          if (j < length && '}' == source[j] && 0 < numDigits && MAX_PARAMS > paramIdx) {
+            handler.onLiteral(runStart, i - runStart);
+            handler.onParam(paramIdx);
+            i = j + 1;
+            runStart = i;
+            continue;
           }
+
+          //Last bracket wasn't really a parameter, the text is kept as is
+          i = j + 1;
+          continue;
         }
+
+        ++i;
       }
 
-      if (lastBracket != -1) {
-        for (auto j = static_cast<uint32>(lastBracket); j < strLength; ++j) {
-          ++charWriteIdx;
-        }
+      if (runStart < length) {
+        handler.onLiteral(runStart, length - runStart);
       }
+    }
 
-      //Copy the clean string into output buffer +1 for null terminator
-      SIZE_T finalStringSize = charWriteIdx + 1;
+    static CONSTEXPR const uint32 MAX_PARAMS = 20;
+    static CONSTEXPR const uint32 MAX_IDENTIFIER_SIZE = 2;
 
-      auto outputBuffer = reinterpret_cast<T*>(ge_alloc(finalStringSize * sizeof(T)));
-      SIZE_T copySourceIdx = 0;
-      SIZE_T copyDestIdx = 0;
+   private:
+    struct RuntimeTag {};
 
-      for (SIZE_T i = 0; i < paramRangeWriteIdx; ++i) {
-        const FormatParamRange& rangeInfo = paramRanges[i];
-        const SIZE_T copySize = rangeInfo.m_start - copyDestIdx;
+    CONSTEXPR BasicFormatString(const T* source, SIZE_T length, RuntimeTag)
+      : m_source(source),
+        m_length(length),
+        m_bParsed(false)
+    {}
 
-        memcpy(outputBuffer + copyDestIdx, source + copySourceIdx, copySize * sizeof(T));
-        copySourceIdx += copySize + rangeInfo.m_identifierSize;
-        copyDestIdx += copySize;
+    /**
+     * @brief Called at compile time when an identifier references a
+     *        parameter that was not passed to the format function.
+     *        Not being constexpr is what makes the compilation fail.
+     */
+    static void
+    formatStringReferencesAMissingArgument() {}
 
-        if (NumLimit::MAX_UINT32 == rangeInfo.m_paramIdx) {
-          continue;
+    struct OpRecorder
+    {
+      constexpr void
+      onLiteral(SIZE_T start, SIZE_T length) {
+        if (0 == length) {
+          return;
         }
-
-        const SIZE_T paramSize = parameters[rangeInfo.m_paramIdx].m_size;
-        memcpy(outputBuffer + copyDestIdx,
-               parameters[rangeInfo.m_paramIdx].m_buffer,
-               paramSize * sizeof(T));
-        copyDestIdx += paramSize;
+        if (!push()) {
+          return;
+        }
+        auto& op = m_pOwner->m_ops[m_pOwner->m_numOps - 1];
+        op.m_start = static_cast<uint16>(start);
+        op.m_length = static_cast<uint16>(length);
+        op.m_paramIdx = NO_PARAM;
       }
 
-      const SIZE_T tailCount = (strLength - copySourceIdx) + 1;
-      memcpy(outputBuffer + copyDestIdx, 
-             source + copySourceIdx, 
-             tailCount * sizeof(T));
+      constexpr void
+      onParam(uint32 paramIdx) {
+        if (paramIdx >= sizeof...(Args)) {
+          formatStringReferencesAMissingArgument();
+        }
 
-      BasicString<T> outputStr(outputBuffer);
-      ge_free(outputBuffer);
+        //Attach the parameter to the preceding literal if it has none
+        auto& owner = *m_pOwner;
+        if (0 < owner.m_numOps && NO_PARAM == owner.m_ops[owner.m_numOps - 1].m_paramIdx) {
+          owner.m_ops[owner.m_numOps - 1].m_paramIdx = static_cast<uint16>(paramIdx);
+          return;
+        }
+        if (push()) {
+          owner.m_ops[owner.m_numOps - 1].m_paramIdx = static_cast<uint16>(paramIdx);
+        }
+      }
 
-      //Free the memory of all the parameters buffers
-      for (auto& param : parameters) {
-        if (nullptr != param.m_buffer) {
-          ge_free(param.m_buffer);
+      constexpr bool
+      push() {
+        if (MAX_OPS == m_pOwner->m_numOps) {
+          m_bOverflow = true;
+          return false;
         }
+        m_pOwner->m_ops[m_pOwner->m_numOps++] = Op{};
+        return true;
       }
 
-      return outputStr;
-    }
+      BasicFormatString* m_pOwner;
+      bool m_bOverflow = false;
+    };
 
-   private:
+    const T* m_source = nullptr;
+    SIZE_T m_length = 0;
+    Op m_ops[MAX_OPS]{};
+    uint32 m_numOps = 0;
+    bool m_bParsed = false;
+  };
+
+  template<class... Args>
+  using FormatString = BasicFormatString<ANSICHAR, std::type_identity_t<Args>...>;
+
+  template<class... Args>
+  using WFormatString = BasicFormatString<UNICHAR, std::type_identity_t<Args>...>;
+
+  /**
+   * @class StringFormat
+   * @brief Helper class used for string formatting operations
+   */
+  class StringFormat
+  {
+   public:
     /**
-     * @brief Set of methods that can be specialized so we have a generalized
-     *        way for retrieving length of strings of different types.
+     * @brief	Formats the provided string by replacing the identifiers with the
+     *        provided parameters. The identifiers are represented like "{0}, {1}"
+     *        in the source string, where the number represents the position of the
+     *        parameter that will be used for replacing the identifier.
+     *
+     * @note  Use "{{" and "}}" to write literal brackets.
+     * @note  Maximum ID number is 19 (for a total of 20 unique IDs.
+     *        e.g. {20} won't be recognized as an Identifier).
+     * @note  String literals are parsed and validated at compile time.
      */
-    static SIZE_T
-    getLength(const ANSICHAR* source) {
-      return strlen(source);
+    template<class... Args>
+    static String
+    format(FormatString<Args...> fmt, Args&&... args) {
+      return formatToString(fmt, args...);
     }
 
     /**
-     * @brief Set of methods that can be specialized so we have a generalized
-     *        way for retrieving length of strings of different types.
+     * @copydoc StringFormat::format(FormatString<Args...>, Args&&...)
      */
-    static SIZE_T
-    getLength(const UNICHAR* source) {
-      return wcslen(source);
+    template<class... Args>
+    static WString
+    format(WFormatString<Args...> fmt, Args&&... args) {
+      return formatToString(fmt, args...);
     }
 
     /**
-     * @brief Parses the string and returns an integer value extracted from string characters.
+     * @brief Formats a string only known at run time. Identifiers that
+     *        reference missing parameters are replaced with nothing.
      */
-    static uint32
-    strToInt(const ANSICHAR* buffer) {
-      return static_cast<uint32>(strtoul(buffer, nullptr, 10));
+    template<class S, class... Args>
+    requires std::is_pointer_v<S>
+    static auto
+    format(const S& source, Args&&... args) {
+      using CharType = std::remove_cv_t<std::remove_pointer_t<S>>;
+      return formatToString(runtime<CharType, Args...>(source), args...);
     }
 
     /**
-     * @brief Parses the string and returns an integer value extracted from string characters.
+     * @brief Wraps a string only known at run time so it can be used where a
+     *        format string is expected.
      */
-    static uint32
-    strToInt(const UNICHAR* buffer) {
-      return static_cast<uint32>(wcstoul(buffer, nullptr, 10));
+    template<class T, class... Args>
+    static BasicFormatString<T, std::type_identity_t<Args>...>
+    runtime(const T* source) {
+      const SIZE_T length = nullptr != source ? getLength(source) : 0;
+      return BasicFormatString<T, std::type_identity_t<Args>...>::runtime(source, length);
     }
 
     /**
-     * @brief Helper method for converting any data type to a narrow string.
+     * @brief Formats into a buffer provided by the caller, without allocating
+     *        memory for numbers and strings. The output is truncated if it
+     *        doesn't fit and is always null terminated (if capacity > 0).
+     * @return The number of characters of the full output, without the null
+     *         terminator. The output was truncated if it's >= capacity.
      */
-    template<class T>
-    static String
-    toString(const T& param) {
-      return geEngineSDK::toString(param);
+    template<class T, class... Args>
+    static SIZE_T
+    formatTo(T* buffer,
+             SIZE_T capacity,
+             BasicFormatString<std::type_identity_t<T>, std::type_identity_t<Args>...> fmt,
+             Args&&... args) {
+      BasicFormatBuffer<T> out(buffer, capacity > 0 ? capacity - 1 : 0);
+      formatImpl(out, fmt, args...);
+      if (capacity > 0) {
+        buffer[std::min(out.size(), capacity - 1)] = T(0);
+      }
+      return out.size();
     }
 
     /**
-     * @brief Helper method that "converts" a narrow string to a narrow string
-     *        (simply a pass through).
+     * @copydoc StringFormat::formatTo
      */
-    static String
-    toString(const String& param) {
-      return param;
+    template<class T, SIZE_T N, class... Args>
+    static SIZE_T
+    formatTo(T (&buffer)[N],
+             BasicFormatString<std::type_identity_t<T>, std::type_identity_t<Args>...> fmt,
+             Args&&... args) {
+      return formatTo(static_cast<T*>(buffer), N, fmt, std::forward<Args>(args)...);
     }
 
     /**
-     * @brief Helper method that converts a narrow character array to a narrow string.
+     * @brief Formats into memory from the frame allocator of the calling
+     *        thread. The string is valid until the frame is cleared.
      */
-    template<class T>
-    static String
-    toString(T* /*param*/) {
-      static_assert(!is_same<T, T>::value, "Invalid pointer type.");
-      return "";
+    template<class... Args>
+    static const ANSICHAR*
+    formatToFrame(FormatString<Args...> fmt, Args&&... args) {
+      return formatToFrameImpl(fmt, args...);
     }
 
     /**
-     * @brief Helper method that converts a narrow character array to a narrow string.
+     * @copydoc StringFormat::formatToFrame
      */
-    static String
-    toString(const char* param) {
-      if (nullptr == param) {
-        return String();
-      }
-      return String(param);
+    template<class... Args>
+    static const UNICHAR*
+    formatToFrame(WFormatString<Args...> fmt, Args&&... args) {
+      return formatToFrameImpl(fmt, args...);
     }
 
+   private:
+    static CONSTEXPR SIZE_T STACK_BUFFER_SIZE = 512;
+
+    template<class T>
+    struct ArgWriter
+    {
+      void
+      onLiteral(SIZE_T start, SIZE_T length) {
+        m_out.append(m_source + start, length);
+      }
+
+      void
+      onParam(uint32 paramIdx) {
+        if (paramIdx < m_numParams) {
+          writeArg(m_out, m_params[paramIdx]);
+        }
+      }
+
+      BasicFormatBuffer<T>& m_out;
+      const T* m_source;
+      const FormatArg<T>* m_params;
+      SIZE_T m_numParams;
+    };
+
     /**
-     * @brief Helper method that converts a narrow character array to a narrow string.
+     * @brief Writes the formatted output to a format buffer. The number of
+     *        arguments was validated when the format string was built.
      */
-    static String
-    toString(char* param) {
-      if (nullptr == param) {
-        return String();
-      }
-      return String(param);
+    template<class T, class Fmt, class... Args>
+    static void
+    formatImpl(BasicFormatBuffer<T>& out, const Fmt& fmt, const Args&... args) {
+      FormatArg<T> params[sizeof...(Args) > 0 ? sizeof...(Args) : 1];
+      [[maybe_unused]] SIZE_T idx = 0;
+      ((params[idx++] = makeArg<T>(args)), ...);
+
+      ArgWriter<T> writer{ out, fmt.getSource(), params, sizeof...(Args) };
+      fmt.visit(writer);
     }
 
     /**
-     * @brief Helper method for converting any data type to a wide string.
+     * @brief Formats to a stack buffer, and only goes to the heap once for
+     *        the final string (or twice if the stack buffer was too small).
      */
+    template<class Fmt, class... Args>
+    static BasicString<typename Fmt::CharType>
+    formatToString(const Fmt& fmt, const Args&... args) {
+      using T = typename Fmt::CharType;
+
+      T stackBuffer[STACK_BUFFER_SIZE];
+      BasicFormatBuffer<T> out(stackBuffer, STACK_BUFFER_SIZE);
+      formatImpl(out, fmt, args...);
+
+      if (!out.isTruncated()) {
+        return BasicString<T>(stackBuffer, out.size());
+      }
+
+      BasicString<T> outputStr(out.size(), T(0));
+      BasicFormatBuffer<T> fullOut(outputStr.data(), outputStr.size());
+      formatImpl(fullOut, fmt, args...);
+      return outputStr;
+    }
+
+    template<class Fmt, class... Args>
+    static const typename Fmt::CharType*
+    formatToFrameImpl(const Fmt& fmt, const Args&... args) {
+      using T = typename Fmt::CharType;
+
+      T stackBuffer[STACK_BUFFER_SIZE];
+      BasicFormatBuffer<T> out(stackBuffer, STACK_BUFFER_SIZE);
+      formatImpl(out, fmt, args...);
+
+      const SIZE_T size = out.size();
+      T* output = ge_frame_alloc<T>(size + 1);
+      if (!out.isTruncated()) {
+        memcpy(output, stackBuffer, size * sizeof(T));
+      }
+      else {
+        BasicFormatBuffer<T> fullOut(output, size);
+        formatImpl(fullOut, fmt, args...);
+      }
+      output[size] = T(0);
+      return output;
+    }
+
     template<class T>
-    static WString
-    toWString(const T& param) {
-      return geEngineSDK::toWString(param);
+    static void
+    writeArg(BasicFormatBuffer<T>& out, const FormatArg<T>& arg) {
+      using TYPE = typename FormatArg<T>::TYPE;
+
+      ANSICHAR numBuffer[64];
+      std::to_chars_result result{ numBuffer, std::errc() };
+      switch (arg.m_type) {
+      case TYPE::kBool:
+        if (arg.m_bool) {
+          out.appendASCII("true", 4);
+        }
+        else {
+          out.appendASCII("false", 5);
+        }
+        return;
+      case TYPE::kInt:
+        result = std::to_chars(numBuffer, numBuffer + sizeof(numBuffer), arg.m_int);
+        break;
+      case TYPE::kUInt:
+        result = std::to_chars(numBuffer, numBuffer + sizeof(numBuffer), arg.m_uint);
+        break;
+      case TYPE::kDouble:
+        //Same output as the default stream formatting used by toString()
+        result = std::to_chars(numBuffer,
+                               numBuffer + sizeof(numBuffer),
+                               arg.m_double,
+                               std::chars_format::general,
+                               6);
+        break;
+      case TYPE::kString:
+        out.append(arg.m_string.m_data, arg.m_string.m_size);
+        return;
+      case TYPE::kCustom:
+        arg.m_custom.m_fn(out, arg.m_custom.m_value);
+        return;
+      default:
+        return;
+      }
+
+      out.appendASCII(numBuffer, static_cast<SIZE_T>(result.ptr - numBuffer));
     }
 
     /**
-     * @brief Helper method that "converts" a wide string to a wide string
-     *        (simply a pass through).
+     * @brief Captures an argument without converting it yet.
      */
-    static WString
-    toWString(const WString& param) {
-      return param;
+    template<class T, class P>
+    static FormatArg<T>
+    makeArg(const P& param) {
+      using TYPE = typename FormatArg<T>::TYPE;
+      using ParamType = std::decay_t<P>;
+
+      FormatArg<T> arg;
+      if CONSTEXPR(is_same<ParamType, bool>::value) {
+        arg.m_type = TYPE::kBool;
+        arg.m_bool = param;
+      }
+      else if CONSTEXPR(std::is_integral<ParamType>::value &&
+                        std::is_signed<ParamType>::value) {
+        arg.m_type = TYPE::kInt;
+        arg.m_int = static_cast<int64>(param);
+      }
+      else if CONSTEXPR(std::is_integral<ParamType>::value) {
+        arg.m_type = TYPE::kUInt;
+        arg.m_uint = static_cast<uint64>(param);
+      }
+      else if CONSTEXPR(std::is_floating_point<ParamType>::value) {
+        arg.m_type = TYPE::kDouble;
+        arg.m_double = static_cast<double>(param);
+      }
+      else if CONSTEXPR(is_same<ParamType, BasicString<T>>::value ||
+                        is_same<ParamType, std::basic_string_view<T>>::value) {
+        arg.m_type = TYPE::kString;
+        arg.m_string.m_data = param.data();
+        arg.m_string.m_size = param.size();
+      }
+      else if CONSTEXPR(is_same<ParamType, const T*>::value ||
+                        is_same<ParamType, T*>::value) {
+        arg.m_type = TYPE::kString;
+        arg.m_string.m_data = param;
+        if CONSTEXPR(std::is_array<P>::value) {
+          arg.m_string.m_size = getLength(param);
+        }
+        else {
+          arg.m_string.m_size = nullptr != param ? getLength(param) : 0;
+        }
+      }
+      else {
+        static_assert(!std::is_pointer<ParamType>::value ||
+                      is_same<ParamType, const ANSICHAR*>::value ||
+                      is_same<ParamType, ANSICHAR*>::value ||
+                      is_same<ParamType, const UNICHAR*>::value ||
+                      is_same<ParamType, UNICHAR*>::value,
+                      "Invalid pointer type.");
+
+        arg.m_type = TYPE::kCustom;
+        arg.m_custom.m_value = &param;
+        arg.m_custom.m_fn = &writeCustom<T, P>;
+      }
+      return arg;
     }
 
     /**
-     * @brief Helper method that converts a wide character array to a wide string.
+     * @brief Writes the arguments that don't have a direct conversion, using
+     *        the toString() / toWString() overloads.
      */
-    template<class T>
-    static WString toWString(T* /*param*/) {
-      static_assert(!is_same<T, T>::value, "Invalid pointer type.");
-      return L"";
+    template<class T, class P>
+    static void
+    writeCustom(BasicFormatBuffer<T>& out, const void* value) {
+      const P& param = *static_cast<const P*>(value);
+      if CONSTEXPR(is_same<T, ANSICHAR>::value) {
+        const String str = toString(param);
+        out.append(str.data(), str.size());
+      }
+      else {
+        const WString str = toWString(param);
+        out.append(str.data(), str.size());
+      }
     }
 
     /**
-     * @brief Helper method that converts a wide character array to a wide string.
+     * @brief Helper method for converting any data type to a narrow string.
      */
-    static WString
-    toWString(const wchar_t* param) {
-      if (nullptr == param) {
-        return WString();
-      }
-      return WString(param);
+    template<class P>
+    static String
+    toString(const P& param) {
+      return geEngineSDK::toString(param);
     }
 
     /**
-     * @brief Helper method that converts a wide character array to a wide string.
+     * @brief Helper method that converts a wide character array to a narrow string.
      */
-    static WString
-    toWString(wchar_t* param) {
+    static String
+    toString(const UNICHAR* param) {
       if (nullptr == param) {
-        return WString();
+        return String();
       }
-      return WString(param);
+      return geEngineSDK::toString(param);
     }
 
     /**
-     * @brief Converts all the provided parameters into string representations
-     *        and populates the provided @p parameters array.
+     * @brief Helper method for converting any data type to a wide string.
      */
-    template<class P, class... Args>
-    static void
-    getParams(ParamData<char>* parameters, uint32 idx, P&& param, Args&&... args) {
-      if (MAX_PARAMS <= idx) {
-        return;
-      }
-
-      BasicString<char> sourceParam = toString(param);
-      parameters[idx].m_buffer = reinterpret_cast<char*>(ge_alloc(sourceParam.size()
-                                                                    * sizeof(char)));
-      parameters[idx].m_size = sourceParam.size();
-      sourceParam.copy(parameters[idx].m_buffer, parameters[idx].m_size, 0);
-      getParams(parameters, idx + 1, std::forward<Args>(args)...);
+    template<class P>
+    static WString
+    toWString(const P& param) {
+      return geEngineSDK::toWString(param);
     }
 
     /**
-     * @brief Converts all the provided parameters into string representations
-     *        and populates the provided @p parameters array.
+     * @brief Helper method that converts a narrow character array to a wide string.
      */
-    template<class P, class... Args>
-    static void
-    getParams(ParamData<UNICHAR>* parameters, uint32 idx, P&& param, Args&&... args) {
-      if (MAX_PARAMS <= idx) {
-        return;
+    static WString
+    toWString(const ANSICHAR* param) {
+      if (nullptr == param) {
+        return WString();
       }
-
-      BasicString<UNICHAR> sourceParam = toWString(param);
-      parameters[idx].m_buffer = reinterpret_cast<UNICHAR*>(ge_alloc(sourceParam.size()
-                                                                   * sizeof(UNICHAR)));
-      parameters[idx].m_size = sourceParam.size();
-      sourceParam.copy(parameters[idx].m_buffer, parameters[idx].m_size, 0);
-      getParams(parameters, idx + 1, forward<Args>(args)...);
+      return geEngineSDK::toWString(String(param));
     }
 
     /**
-     * @brief Helper method used for parameter size calculation.
-     *        Used as a stopping point in template recursion.
+     * @brief Set of methods that can be specialized so we have a generalized
+     *        way for retrieving length of strings of different types.
      */
-    static void
-    getParams(ParamData<ANSICHAR>*, uint32) {
-      // Do nothing
+    static SIZE_T
+    getLength(const ANSICHAR* source) {
+      return strlen(source);
     }
 
     /**
-     * @brief Helper method used for parameter size calculation.
-     *        Used as a stopping point in template recursion.
+     * @brief Set of methods that can be specialized so we have a generalized
+     *        way for retrieving length of strings of different types.
      */
-    static void
-    getParams(ParamData<UNICHAR>*, uint32) {
-      // Do nothing
+    static SIZE_T
+    getLength(const UNICHAR* source) {
+      return wcslen(source);
     }
-
-   private:
-    static CONSTEXPR const uint32 MAX_PARAMS = 20;
-    static CONSTEXPR const uint32 MAX_IDENTIFIER_SIZE = 2;
-    static CONSTEXPR const uint32 MAX_PARAM_REFERENCES = 200;
   };
 }
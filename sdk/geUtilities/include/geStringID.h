@@ -27,7 +27,9 @@ namespace geEngineSDK {
    * @brief A string identifier that provides very fast comparisons to other string ids.
    * @note  Essentially a unique ID is generated for each string and then the ID is used
    *        for comparisons as if you were using an integer or an enum.
-   * @note  Thread safe.
+   * @note  Thread safe. Names are interned on a sharded open addressing table
+   *        that is read without locks, so only the first construction of a
+   *        given name takes a (per shard) lock.
    */
   /***************************************************************************/
   class GE_UTILITIES_EXPORT StringID
@@ -35,65 +37,57 @@ namespace geEngineSDK {
    public:
     static const StringID NONE;
 
-   private:
-    static CONSTEXPR const int32 HASH_TABLE_SIZE = 4096;
-    static CONSTEXPR const int32 MAX_CHUNK_COUNT = 50;
-    static CONSTEXPR const int32 ELEMENTS_PER_CHUNK = 256;
-    static CONSTEXPR const int32 STRING_SIZE = 256;
-
-   private:
     /**
-     * @brief	Helper class that performs string actions on both null terminated
-     *        character arrays and standard strings.
+     * @brief A string literal with its hash already calculated.
+     *        Created by GE_STRING_ID so the hash is computed at compile time.
      */
-    template<class T>
-    class StringIDUtil
+    struct Literal
     {
-     public:
-      static uint32
-      size(T const&) {
-        return 0;
-      }
-
-      static void
-      copy(T const&, ANSICHAR*) {}
-      
-      static bool
-      compare(T const&, ANSICHAR*) {
-        return false;
-      }
+      const ANSICHAR* m_str;
+      SIZE_T m_size;
+      uint32 m_hash;
     };
 
-    /**	Internal data that is shared by all instances for a specific string. */
+   private:
+    /**
+     * @brief Internal data that is shared by all instances for a specific
+     *        string. The characters are stored right after this header, in
+     *        the same allocation.
+     */
     struct InternalData
     {
       uint32 m_id;
-      InternalData* m_next;
-      ANSICHAR m_chars[STRING_SIZE];
+      uint32 m_hash;
+      uint32 m_size;
+
+      const ANSICHAR*
+      chars() const {
+        return reinterpret_cast<const ANSICHAR*>(this + 1);
+      }
     };
 
     /**
-     * @brief	Performs initialization of static members as soon as the library is loaded.
+     * @brief Part of the intern table. Defined on the source file.
      */
-    struct InitStatics
-    {
-      InitStatics();
-    };
+    struct Shard;
 
    public:
     StringID() = default;
 
     StringID(const ANSICHAR* name) {
-      construct(name);
+      construct(name, std::char_traits<ANSICHAR>::length(name));
     }
 
     StringID(const String& name) {
-      construct(name);
+      construct(name.data(), name.size());
     }
 
-    template<SIZE_T N>
-    StringID(const ANSICHAR name[N]) {
-      construct(static_cast<const ANSICHAR*>(name));
+    StringID(const ANSICHAR* name, SIZE_T size) {
+      construct(name, size);
+    }
+
+    explicit StringID(const Literal& literal) {
+      construct(literal.m_str, literal.m_size, literal.m_hash);
     }
 
     /**
@@ -129,7 +123,15 @@ namespace geEngineSDK {
         return "";
       }
 
-      return m_data->m_chars;
+      return m_data->chars();
+    }
+
+    /**
+     * @brief Returns the length of the name, not counting the terminator.
+     */
+    uint32
+    size() const {
+      return m_data ? m_data->m_size : 0;
     }
 
     /** Returns the unique identifier of the string. */
@@ -138,42 +140,61 @@ namespace geEngineSDK {
       return m_data ? m_data->m_id : NumLimit::MAX_UINT32;
     }
 
-   private:
     /**
-     * @brief Constructs a StringID object in a way that works for pointers to
-     *        character arrays and standard strings.
+     * @brief Calculates the hash used to intern a string (FNV-1a with a final
+     *        avalanche so both the low and high bits can be used).
+     *        Usable on constant expressions.
      */
-    template<class T>
+    static CONSTEXPR uint32
+    calcHash(const ANSICHAR* input, SIZE_T size) {
+      uint32 hash = 2166136261u;
+      for (SIZE_T i = 0; i < size; ++i) {
+        hash ^= static_cast<uint32>(static_cast<uint8>(input[i]));
+        hash *= 16777619u;
+      }
+
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6bu;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35u;
+      hash ^= hash >> 16;
+      return hash;
+    }
+
+   private:
     void
-    construct(T const& name);
+    construct(const ANSICHAR* name, SIZE_T size) {
+      construct(name, size, calcHash(name, size));
+    }
 
     /**
-     * @brief	Calculates a hash value for the provided null-terminated string.
+     * @brief Finds the entry for the string, or adds it if it's not interned.
+     *        Lookups of existing strings don't take any locks.
      */
-    template<class T>
-    uint32
-    calcHash(T const& input) const;
+    void
+    construct(const ANSICHAR* name, SIZE_T size, uint32 hash);
 
     /**
-     * @brief Allocates a new string entry and assigns it a unique ID.
-     *        Optionally expands the chunks buffer if the new entry doesn't fit.
+     * @brief Returns the shards of the intern table. Created on first use so
+     *        StringIDs can be constructed during static initialization.
      */
-    InternalData*
-    allocEntry();
-
-   private:
-    static volatile InitStatics m_initStatics;
-    static InternalData* m_stringHashTable[HASH_TABLE_SIZE];
-    static InternalData* m_chunks[MAX_CHUNK_COUNT];
-
-    static uint32 m_nextId;
-    static uint32 m_numChunks;
-    static SpinLock m_sync;
+    static Shard*
+    getShards();
 
     InternalData* m_data = nullptr;
   };
 }
 
+/**
+ * @brief Creates a StringID from a string literal, hashing it at compile time.
+ */
+#define GE_STRING_ID(literal)                                                 \
+  ::geEngineSDK::StringID(::geEngineSDK::StringID::Literal{                   \
+    literal,                                                                  \
+    sizeof(literal) - 1,                                                      \
+    std::integral_constant<::geEngineSDK::uint32,                             \
+      ::geEngineSDK::StringID::calcHash(literal, sizeof(literal) - 1)>::value})
+
 namespace std {
   /**
    * Hash value generator for StringID.
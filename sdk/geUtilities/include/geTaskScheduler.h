@@ -285,4 +285,25 @@ namespace geEngineSDK {
     Signal m_taskReadyCond;
     Signal m_taskCompleteCond;
   };
+
+  /**
+   * @brief Calls func(begin, end) for every chunk of [0, count), of at most
+   *        chunkSize items. The TaskScheduler workers pull the next chunk
+   *        from a shared counter, so the chunks that take longer don't hold
+   *        the rest back. Returns once all the chunks are done.
+   * @param[in] name      Name of the task group that runs the chunks.
+   * @param[in] count     Number of items.
+   * @param[in] chunkSize Items per chunk. Pick it so a chunk is worth a task.
+   * @param[in] func      Called once per chunk, from any thread.
+   * @param[in] bParallel (optional) Set it to false to run all the chunks on
+   *                      the calling thread.
+   * @note  The chunks also run on the calling thread when the scheduler is
+   *        not started or there is a single chunk.
+   */
+  GE_UTILITIES_EXPORT void
+  parallelForChunks(const String& name,
+                    uint32 count,
+                    uint32 chunkSize,
+                    const function<void(uint32, uint32)>& func,
+                    bool bParallel = true);
 }
@@ -35,8 +35,8 @@ namespace geEngineSDK {
      * @brief Indices pointing to neighbor tetrahedrons. Each neighbor index maps to the
      *        @p vertices array, so neighbor/vertex pair at the same location will be the only
      *        neighbor not containing that vertex (i.e. neighbor opposite to the vertex). If a
-     *        tetrahedron is on the volume edge, it has only three neighbors and its last
-     *        neighbor will be set to -1.
+     *        tetrahedron is on the volume edge, the neighbors across its outer faces will be
+     *        set to -1.
      */
     int32 neighbors[4];
   };
@@ -46,7 +46,15 @@ namespace geEngineSDK {
    */
   struct TetrahedronFace
   {
+    /**
+     * @brief Indices of the face vertices pointing to an external point array.
+     *        Vertices are wound counter clockwise when seen from outside the volume.
+     */
     int32 vertices[3];
+
+    /**
+     * @brief Index of the tetrahedron the face belongs to.
+     */
     int32 tetrahedron;
   };
 
@@ -69,6 +77,9 @@ namespace geEngineSDK {
      * @brief Converts a set of input points into a set of tetrahedrons generated using
      *        Delaunay tetrahedralization algorithm. Minimum of 4 points must be provided in
      *        order for the process to work.
+     * @note  Duplicated points are ignored. If the TaskScheduler is running, large point
+     *        sets are processed in parallel on its workers. The output doesn't depend on
+     *        the number of workers used.
      */
     static TetrahedronVolume
     tetrahedralize(const Vector<Vector3>& points);
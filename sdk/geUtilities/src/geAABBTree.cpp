@@ -0,0 +1,456 @@
+/*****************************************************************************/
+/**
+ * @file    geAABBTree.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Dynamic bounding volume hierarchy of axis aligned boxes.
+ *
+ * Insertion, removal and the tree rotations of the dynamic AABB tree.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geAABBTree.h"
+
+namespace geEngineSDK {
+  namespace {
+    /**
+     * Half the surface area of a box, the cost of visiting a node.
+     */
+    float
+    getArea(const AABox& box) {
+      const Vector3 size = box.m_max - box.m_min;
+      return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    bool
+    contains(const AABox& outer, const AABox& inner) {
+      return outer.m_min.x <= inner.m_min.x &&
+             outer.m_min.y <= inner.m_min.y &&
+             outer.m_min.z <= inner.m_min.z &&
+             inner.m_max.x <= outer.m_max.x &&
+             inner.m_max.y <= outer.m_max.y &&
+             inner.m_max.z <= outer.m_max.z;
+    }
+
+    AABox
+    grow(const AABox& box, float amount) {
+      const Vector3 margin(amount, amount, amount);
+      return AABox(box.m_min - margin, box.m_max + margin);
+    }
+  }
+
+  AABBTree::AABBTree(float margin)
+    : m_margin(margin)
+  {}
+
+  int32
+  AABBTree::createProxy(const AABox& box, void* userData) {
+    const int32 proxyId = allocateNode();
+
+    AABBTreeNode& node = m_nodes[proxyId];
+    node.box = grow(box, m_margin);
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(proxyId);
+    ++m_proxyCount;
+
+    return proxyId;
+  }
+
+  void
+  AABBTree::destroyProxy(int32 proxyId) {
+    GE_ASSERT(proxyId >= 0 && proxyId < cast::st<int32>(m_nodes.size()));
+    GE_ASSERT(m_nodes[proxyId].isLeaf() && 0 == m_nodes[proxyId].height);
+
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --m_proxyCount;
+  }
+
+  bool
+  AABBTree::moveProxy(int32 proxyId, const AABox& box, const Vector3& displacement) {
+    GE_ASSERT(proxyId >= 0 && proxyId < cast::st<int32>(m_nodes.size()));
+    GE_ASSERT(m_nodes[proxyId].isLeaf() && 0 == m_nodes[proxyId].height);
+
+    AABox fatBox = grow(box, m_margin);
+    for (uint32 axis = 0; axis < 3; ++axis) {
+      if (displacement[axis] < 0.0f) {
+        fatBox.m_min[axis] += displacement[axis];
+      }
+      else {
+        fatBox.m_max[axis] += displacement[axis];
+      }
+    }
+
+    //Keep the current box while it still covers the object, unless it got
+    //much bigger than needed (after a fast movement that stopped)
+    const AABox& treeBox = m_nodes[proxyId].box;
+    if (contains(treeBox, box) && contains(grow(fatBox, m_margin * 4.0f), treeBox)) {
+      return false;
+    }
+
+    removeLeaf(proxyId);
+    m_nodes[proxyId].box = fatBox;
+    insertLeaf(proxyId);
+    return true;
+  }
+
+  void
+  AABBTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_proxyCount = 0;
+  }
+
+  float
+  AABBTree::getAreaRatio() const {
+    if (NULL_NODE == m_root) {
+      return 0.0f;
+    }
+
+    const float rootArea = getArea(m_nodes[m_root].box);
+    if (rootArea <= 0.0f) {
+      return 0.0f;
+    }
+
+    float totalArea = 0.0f;
+    for (const auto& node : m_nodes) {
+      if (node.height >= 0) {
+        totalArea += getArea(node.box);
+      }
+    }
+    return totalArea / rootArea;
+  }
+
+  bool
+  AABBTree::validate() const {
+    uint32 freeCount = 0;
+    for (int32 nodeId = m_freeList; NULL_NODE != nodeId; nodeId = m_nodes[nodeId].parent) {
+      if (m_nodes[nodeId].height != -1) {
+        return false;
+      }
+      ++freeCount;
+    }
+
+    if (NULL_NODE == m_root) {
+      return 0 == m_proxyCount && freeCount == m_nodes.size();
+    }
+
+    if (NULL_NODE != m_nodes[m_root].parent) {
+      return false;
+    }
+
+    uint32 nodeCount = 0;
+    uint32 leafCount = 0;
+    Vector<int32> stack = { m_root };
+    while (!stack.empty()) {
+      const int32 nodeId = stack.back();
+      stack.pop_back();
+      ++nodeCount;
+
+      const AABBTreeNode& node = m_nodes[nodeId];
+      if (node.isLeaf()) {
+        if (0 != node.height) {
+          return false;
+        }
+        ++leafCount;
+        continue;
+      }
+
+      const AABBTreeNode& child1 = m_nodes[node.child1];
+      const AABBTreeNode& child2 = m_nodes[node.child2];
+      if (child1.parent != nodeId || child2.parent != nodeId) {
+        return false;
+      }
+
+      if (node.height != 1 + Math::max(child1.height, child2.height)) {
+        return false;
+      }
+
+      if (!(node.box == child1.box + child2.box)) {
+        return false;
+      }
+
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+
+    return leafCount == m_proxyCount && nodeCount + freeCount == m_nodes.size();
+  }
+
+  int32
+  AABBTree::allocateNode() {
+    if (NULL_NODE == m_freeList) {
+      m_nodes.emplace_back();
+      return cast::st<int32>(m_nodes.size() - 1);
+    }
+
+    const int32 nodeId = m_freeList;
+    m_freeList = m_nodes[nodeId].parent;
+    m_nodes[nodeId] = AABBTreeNode();
+    return nodeId;
+  }
+
+  void
+  AABBTree::freeNode(int32 nodeId) {
+    AABBTreeNode& node = m_nodes[nodeId];
+    node = AABBTreeNode();
+    node.parent = m_freeList;
+    m_freeList = nodeId;
+  }
+
+  void
+  AABBTree::insertLeaf(int32 leafId) {
+    if (NULL_NODE == m_root) {
+      m_root = leafId;
+      m_nodes[leafId].parent = NULL_NODE;
+      return;
+    }
+
+    //Walk down to the sibling that makes the tree grow the least
+    const AABox leafBox = m_nodes[leafId].box;
+    int32 siblingId = m_root;
+    while (!m_nodes[siblingId].isLeaf()) {
+      const AABBTreeNode& node = m_nodes[siblingId];
+      const float area = getArea(node.box);
+      const float combinedArea = getArea(node.box + leafBox);
+
+      //Cost of making a new parent for this node and the leaf, and the cost
+      //that every deeper option pays for growing this node
+      const float cost = 2.0f * combinedArea;
+      const float inheritanceCost = 2.0f * (combinedArea - area);
+
+      auto getDescendCost = [&](int32 childId) {
+        const AABBTreeNode& child = m_nodes[childId];
+        const float newArea = getArea(child.box + leafBox);
+        return (child.isLeaf() ? newArea : newArea - getArea(child.box)) +
+               inheritanceCost;
+      };
+
+      const float cost1 = getDescendCost(node.child1);
+      const float cost2 = getDescendCost(node.child2);
+      if (cost < cost1 && cost < cost2) {
+        break;
+      }
+
+      siblingId = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int32 oldParentId = m_nodes[siblingId].parent;
+    const int32 newParentId = allocateNode();
+
+    AABBTreeNode& newParent = m_nodes[newParentId];
+    newParent.parent = oldParentId;
+    newParent.box = leafBox + m_nodes[siblingId].box;
+    newParent.height = m_nodes[siblingId].height + 1;
+    newParent.child1 = siblingId;
+    newParent.child2 = leafId;
+
+    m_nodes[siblingId].parent = newParentId;
+    m_nodes[leafId].parent = newParentId;
+
+    if (NULL_NODE == oldParentId) {
+      m_root = newParentId;
+    }
+    else {
+      AABBTreeNode& oldParent = m_nodes[oldParentId];
+      if (oldParent.child1 == siblingId) {
+        oldParent.child1 = newParentId;
+      }
+      else {
+        oldParent.child2 = newParentId;
+      }
+    }
+
+    refitAncestors(newParentId);
+  }
+
+  void
+  AABBTree::removeLeaf(int32 leafId) {
+    if (leafId == m_root) {
+      m_root = NULL_NODE;
+      return;
+    }
+
+    const int32 parentId = m_nodes[leafId].parent;
+    const int32 grandParentId = m_nodes[parentId].parent;
+    const int32 siblingId = m_nodes[parentId].child1 == leafId ?
+                            m_nodes[parentId].child2 :
+                            m_nodes[parentId].child1;
+
+    m_nodes[siblingId].parent = grandParentId;
+    m_nodes[leafId].parent = NULL_NODE;
+    freeNode(parentId);
+
+    if (NULL_NODE == grandParentId) {
+      m_root = siblingId;
+      return;
+    }
+
+    AABBTreeNode& grandParent = m_nodes[grandParentId];
+    if (grandParent.child1 == parentId) {
+      grandParent.child1 = siblingId;
+    }
+    else {
+      grandParent.child2 = siblingId;
+    }
+
+    refitAncestors(grandParentId);
+  }
+
+  void
+  AABBTree::refitAncestors(int32 nodeId) {
+    while (NULL_NODE != nodeId) {
+      //The children are already refit, so the rotation sees their real boxes
+      rotate(nodeId);
+      refitNode(nodeId);
+      nodeId = m_nodes[nodeId].parent;
+    }
+  }
+
+  void
+  AABBTree::rotate(int32 nodeId) {
+    const AABBTreeNode& node = m_nodes[nodeId];
+    const int32 b = node.child1;
+    const int32 c = node.child2;
+    const AABBTreeNode& nodeB = m_nodes[b];
+    const AABBTreeNode& nodeC = m_nodes[c];
+
+    //The height of the node isn't refit yet, so look at the children
+    if (nodeB.isLeaf() && nodeC.isLeaf()) {
+      return;
+    }
+
+    //Each option swaps a child with a grandchild on the other side (or two
+    //grandchildren) and costs the change in area of the nodes below this one
+    if (nodeB.isLeaf()) {
+      const int32 f = nodeC.child1;
+      const int32 g = nodeC.child2;
+      const float areaC = getArea(nodeC.box);
+      const float costBF = getArea(nodeB.box + m_nodes[g].box) - areaC;
+      const float costBG = getArea(nodeB.box + m_nodes[f].box) - areaC;
+      if (costBF >= 0.0f && costBG >= 0.0f) {
+        return;
+      }
+
+      swapChildren(nodeId, b, c, costBF < costBG ? f : g);
+      refitNode(c);
+      return;
+    }
+
+    if (nodeC.isLeaf()) {
+      const int32 d = nodeB.child1;
+      const int32 e = nodeB.child2;
+      const float areaB = getArea(nodeB.box);
+      const float costCD = getArea(nodeC.box + m_nodes[e].box) - areaB;
+      const float costCE = getArea(nodeC.box + m_nodes[d].box) - areaB;
+      if (costCD >= 0.0f && costCE >= 0.0f) {
+        return;
+      }
+
+      swapChildren(nodeId, c, b, costCD < costCE ? d : e);
+      refitNode(b);
+      return;
+    }
+
+    const int32 d = nodeB.child1;
+    const int32 e = nodeB.child2;
+    const int32 f = nodeC.child1;
+    const int32 g = nodeC.child2;
+    const AABox& boxD = m_nodes[d].box;
+    const AABox& boxE = m_nodes[e].box;
+    const AABox& boxF = m_nodes[f].box;
+    const AABox& boxG = m_nodes[g].box;
+    const float areaB = getArea(nodeB.box);
+    const float areaC = getArea(nodeC.box);
+
+    enum ROTATION { kNone, kBF, kBG, kCD, kCE, kDF, kDG };
+    const float costs[] = {
+      0.0f,
+      getArea(nodeB.box + boxG) - areaC,
+      getArea(nodeB.box + boxF) - areaC,
+      getArea(nodeC.box + boxE) - areaB,
+      getArea(nodeC.box + boxD) - areaB,
+      getArea(boxF + boxE) + getArea(boxD + boxG) - areaB - areaC,
+      getArea(boxG + boxE) + getArea(boxF + boxD) - areaB - areaC
+    };
+
+    uint32 best = kNone;
+    for (uint32 i = 1; i < sizeof(costs) / sizeof(costs[0]); ++i) {
+      if (costs[i] < costs[best]) {
+        best = i;
+      }
+    }
+
+    switch (best) {
+    case kBF:
+      swapChildren(nodeId, b, c, f);
+      refitNode(c);
+      break;
+    case kBG:
+      swapChildren(nodeId, b, c, g);
+      refitNode(c);
+      break;
+    case kCD:
+      swapChildren(nodeId, c, b, d);
+      refitNode(b);
+      break;
+    case kCE:
+      swapChildren(nodeId, c, b, e);
+      refitNode(b);
+      break;
+    case kDF:
+      swapChildren(b, d, c, f);
+      refitNode(b);
+      refitNode(c);
+      break;
+    case kDG:
+      swapChildren(b, d, c, g);
+      refitNode(b);
+      refitNode(c);
+      break;
+    default:
+      break;
+    }
+  }
+
+  void
+  AABBTree::swapChildren(int32 parentA, int32 childA, int32 parentB, int32 childB) {
+    AABBTreeNode& nodeA = m_nodes[parentA];
+    if (nodeA.child1 == childA) {
+      nodeA.child1 = childB;
+    }
+    else {
+      nodeA.child2 = childB;
+    }
+
+    AABBTreeNode& nodeB = m_nodes[parentB];
+    if (nodeB.child1 == childB) {
+      nodeB.child1 = childA;
+    }
+    else {
+      nodeB.child2 = childA;
+    }
+
+    m_nodes[childA].parent = parentB;
+    m_nodes[childB].parent = parentA;
+  }
+
+  void
+  AABBTree::refitNode(int32 nodeId) {
+    AABBTreeNode& node = m_nodes[nodeId];
+    const AABBTreeNode& child1 = m_nodes[node.child1];
+    const AABBTreeNode& child2 = m_nodes[node.child2];
+    node.box = child1.box + child2.box;
+    node.height = 1 + Math::max(child1.height, child2.height);
+  }
+}
@@ -0,0 +1,898 @@
+/*****************************************************************************/
+/**
+ * @file    geBlockCompression.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   CPU encoder and decoder for the BCn texture formats.
+ *
+ * CPU encoder and decoder for the block compressed texture formats BC1, BC3,
+ * BC5 and BC7. Images are encoded in blocks of 4x4 pixels.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geBlockCompression.h"
+#include "geTaskScheduler.h"
+
+namespace geEngineSDK {
+  namespace {
+    CONSTEXPR uint32 BLOCK_PIXELS = 16;
+
+    /**
+     * @brief Minimum number of blocks worth giving to a task.
+     */
+    CONSTEXPR uint32 MIN_BLOCKS_PER_TASK = 1024;
+
+    /**
+     * @brief Number of fit / least squares rounds done per block.
+     */
+    CONSTEXPR uint32 REFINE_ITERATIONS = 2;
+
+    /**
+     * @brief Interpolation weights (out of 64) of the 4 bit BC7 indices.
+     */
+    CONSTEXPR uint32 BC7_WEIGHTS[16] = {
+      0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64
+    };
+
+    FORCEINLINE float
+    clamp255(float v) {
+      return v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+    }
+
+    FORCEINLINE int32
+    roundToInt(float v) {
+      return static_cast<int32>(v + 0.5f);
+    }
+
+    /**
+     * @brief Sequential bit access on a block, LSB first.
+     */
+    struct BitWriter
+    {
+      explicit BitWriter(uint8* data) : m_data(data) {}
+
+      void
+      write(uint32 value, uint32 numBits) {
+        for (uint32 i = 0; i < numBits; ++i, ++m_pos) {
+          if ((value >> i) & 1) {
+            m_data[m_pos >> 3] |= static_cast<uint8>(1u << (m_pos & 7));
+          }
+        }
+      }
+
+      uint8* m_data;
+      uint32 m_pos = 0;
+    };
+
+    struct BitReader
+    {
+      explicit BitReader(const uint8* data) : m_data(data) {}
+
+      uint32
+      read(uint32 numBits) {
+        uint32 value = 0;
+        for (uint32 i = 0; i < numBits; ++i, ++m_pos) {
+          value |= static_cast<uint32>((m_data[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+        }
+        return value;
+      }
+
+      const uint8* m_data;
+      uint32 m_pos = 0;
+    };
+
+    /**
+     * @brief Finds the direction of greatest variance of a set of points with
+     *        NUM channels, using a few rounds of power iteration.
+     */
+    template<uint32 NUM>
+    void
+    principalAxis(const float (*points)[4],
+                  const float* mean,
+                  const float* minValues,
+                  const float* maxValues,
+                  float* outAxis) {
+      float cov[NUM][NUM] = {};
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        float d[NUM];
+        for (uint32 c = 0; c < NUM; ++c) {
+          d[c] = points[i][c] - mean[c];
+        }
+        for (uint32 r = 0; r < NUM; ++r) {
+          for (uint32 c = 0; c < NUM; ++c) {
+            cov[r][c] += d[r] * d[c];
+          }
+        }
+      }
+
+      //Start from the diagonal of the bounding box, which is usually close
+      float axis[NUM];
+      for (uint32 c = 0; c < NUM; ++c) {
+        axis[c] = maxValues[c] - minValues[c];
+      }
+
+      for (uint32 iter = 0; iter < 8; ++iter) {
+        float next[NUM] = {};
+        float maxComponent = 0.0f;
+        for (uint32 r = 0; r < NUM; ++r) {
+          for (uint32 c = 0; c < NUM; ++c) {
+            next[r] += cov[r][c] * axis[c];
+          }
+          maxComponent = std::max(maxComponent, std::abs(next[r]));
+        }
+
+        if (maxComponent < 1e-6f) {
+          break;
+        }
+        for (uint32 c = 0; c < NUM; ++c) {
+          axis[c] = next[c] / maxComponent;
+        }
+      }
+
+      float length = 0.0f;
+      for (uint32 c = 0; c < NUM; ++c) {
+        length += axis[c] * axis[c];
+      }
+      length = std::sqrt(length);
+      for (uint32 c = 0; c < NUM; ++c) {
+        outAxis[c] = length > 1e-6f ? axis[c] / length : 0.0f;
+      }
+    }
+
+    /**
+     * @brief Gets the end points of the segment that covers the projection
+     *        of the points on their principal axis.
+     */
+    template<uint32 NUM>
+    void
+    fitEndPoints(const float (*points)[4], float* outEnd0, float* outEnd1) {
+      float mean[NUM] = {};
+      float minValues[NUM];
+      float maxValues[NUM];
+      for (uint32 c = 0; c < NUM; ++c) {
+        minValues[c] = 255.0f;
+        maxValues[c] = 0.0f;
+      }
+
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        for (uint32 c = 0; c < NUM; ++c) {
+          mean[c] += points[i][c];
+          minValues[c] = std::min(minValues[c], points[i][c]);
+          maxValues[c] = std::max(maxValues[c], points[i][c]);
+        }
+      }
+      for (uint32 c = 0; c < NUM; ++c) {
+        mean[c] /= static_cast<float>(BLOCK_PIXELS);
+      }
+
+      float axis[NUM];
+      principalAxis<NUM>(points, mean, minValues, maxValues, axis);
+
+      float minT = 0.0f;
+      float maxT = 0.0f;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        float t = 0.0f;
+        for (uint32 c = 0; c < NUM; ++c) {
+          t += (points[i][c] - mean[c]) * axis[c];
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+      }
+
+      for (uint32 c = 0; c < NUM; ++c) {
+        outEnd0[c] = clamp255(mean[c] + axis[c] * minT);
+        outEnd1[c] = clamp255(mean[c] + axis[c] * maxT);
+      }
+    }
+
+    /**
+     * @brief Solves the end points that minimize the squared error for the
+     *        given interpolation weights (the weight of end1 for each pixel).
+     * @return false if the system is degenerate (all weights equal).
+     */
+    template<uint32 NUM>
+    bool
+    leastSquaresEndPoints(const float (*points)[4],
+                          const float* weights,
+                          float* outEnd0,
+                          float* outEnd1) {
+      float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+      float ax[NUM] = {};
+      float bx[NUM] = {};
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        const float b = weights[i];
+        const float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (uint32 c = 0; c < NUM; ++c) {
+          ax[c] += a * points[i][c];
+          bx[c] += b * points[i][c];
+        }
+      }
+
+      const float det = aa * bb - ab * ab;
+      if (std::abs(det) < 1e-6f) {
+        return false;
+      }
+
+      const float invDet = 1.0f / det;
+      for (uint32 c = 0; c < NUM; ++c) {
+        outEnd0[c] = clamp255((bb * ax[c] - ab * bx[c]) * invDet);
+        outEnd1[c] = clamp255((aa * bx[c] - ab * ax[c]) * invDet);
+      }
+      return true;
+    }
+
+    /*************************************************************************/
+    /**
+     * BC1 color blocks
+     */
+    /*************************************************************************/
+    FORCEINLINE uint16
+    pack565(const float* color) {
+      const uint32 r = static_cast<uint32>(roundToInt(color[0] * 31.0f / 255.0f));
+      const uint32 g = static_cast<uint32>(roundToInt(color[1] * 63.0f / 255.0f));
+      const uint32 b = static_cast<uint32>(roundToInt(color[2] * 31.0f / 255.0f));
+      return static_cast<uint16>((r << 11) | (g << 5) | b);
+    }
+
+    FORCEINLINE void
+    unpack565(uint16 color, int32* outColor) {
+      const int32 r = (color >> 11) & 0x1F;
+      const int32 g = (color >> 5) & 0x3F;
+      const int32 b = color & 0x1F;
+      outColor[0] = (r << 3) | (r >> 2);
+      outColor[1] = (g << 2) | (g >> 4);
+      outColor[2] = (b << 3) | (b >> 2);
+    }
+
+    /**
+     * @brief Builds the palette of a color block. In three color mode the
+     *        last entry is transparent black.
+     */
+    void
+    colorPalette(uint16 color0, uint16 color1, bool bFourColors, int32 (*outPalette)[4]) {
+      unpack565(color0, outPalette[0]);
+      unpack565(color1, outPalette[1]);
+      outPalette[0][3] = 255;
+      outPalette[1][3] = 255;
+      outPalette[2][3] = 255;
+
+      if (bFourColors || color0 > color1) {
+        outPalette[3][3] = 255;
+        for (uint32 c = 0; c < 3; ++c) {
+          outPalette[2][c] = (2 * outPalette[0][c] + outPalette[1][c]) / 3;
+          outPalette[3][c] = (outPalette[0][c] + 2 * outPalette[1][c]) / 3;
+        }
+      }
+      else {
+        outPalette[3][3] = 0;
+        for (uint32 c = 0; c < 3; ++c) {
+          outPalette[2][c] = (outPalette[0][c] + outPalette[1][c]) / 2;
+          outPalette[3][c] = 0;
+        }
+      }
+    }
+
+    /**
+     * @brief Picks the closest palette entry for each pixel.
+     * @return The squared error of the block.
+     */
+    float
+    selectColorIndices(const float (*points)[4],
+                       uint16 color0,
+                       uint16 color1,
+                       uint32* outIndices) {
+      int32 palette[4][4];
+      colorPalette(color0, color1, true, palette);
+
+      float totalError = 0.0f;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        float bestError = NumLimit::MAX_FLOAT;
+        for (uint32 k = 0; k < 4; ++k) {
+          float error = 0.0f;
+          for (uint32 c = 0; c < 3; ++c) {
+            const float d = points[i][c] - static_cast<float>(palette[k][c]);
+            error += d * d;
+          }
+          if (error < bestError) {
+            bestError = error;
+            outIndices[i] = k;
+          }
+        }
+        totalError += bestError;
+      }
+      return totalError;
+    }
+
+    /**
+     * @brief Encodes the color of a block in four color mode, which is also
+     *        the only mode BC3 understands.
+     */
+    void
+    encodeColorBlock(const uint8* pixels, uint8* outBlock) {
+      //Weight of color1 for each of the four color mode indices
+      CONSTEXPR float INDEX_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+      float points[BLOCK_PIXELS][4];
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        for (uint32 c = 0; c < 4; ++c) {
+          points[i][c] = static_cast<float>(pixels[i * 4 + c]);
+        }
+      }
+
+      float end0[3], end1[3];
+      fitEndPoints<3>(points, end0, end1);
+
+      //Inset the end points a bit, the extremes are rarely the best fit
+      for (uint32 c = 0; c < 3; ++c) {
+        const float inset = (end1[c] - end0[c]) / 16.0f;
+        end0[c] = clamp255(end0[c] + inset);
+        end1[c] = clamp255(end1[c] - inset);
+      }
+
+      uint16 bestColor0 = 0, bestColor1 = 0;
+      uint32 bestIndices[BLOCK_PIXELS] = {};
+      float bestError = NumLimit::MAX_FLOAT;
+
+      for (uint32 iter = 0; iter < REFINE_ITERATIONS + 1; ++iter) {
+        const uint16 color0 = pack565(end0);
+        const uint16 color1 = pack565(end1);
+
+        uint32 indices[BLOCK_PIXELS];
+        const float error = selectColorIndices(points, color0, color1, indices);
+        if (error < bestError) {
+          bestError = error;
+          bestColor0 = color0;
+          bestColor1 = color1;
+          std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+        }
+
+        if (iter == REFINE_ITERATIONS || bestError == 0.0f) {
+          break;
+        }
+
+        float weights[BLOCK_PIXELS];
+        for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+          weights[i] = INDEX_WEIGHTS[indices[i]];
+        }
+        if (!leastSquaresEndPoints<3>(points, weights, end0, end1)) {
+          break;
+        }
+      }
+
+      //Four color mode needs color0 > color1. Swapping the end points swaps
+      //the meaning of the indices 0 <-> 1 and 2 <-> 3.
+      if (bestColor0 < bestColor1) {
+        std::swap(bestColor0, bestColor1);
+        for (auto& index : bestIndices) {
+          index ^= 1;
+        }
+      }
+      else if (bestColor0 == bestColor1) {
+        for (auto& index : bestIndices) {
+          index = 0;
+        }
+      }
+
+      uint32 packedIndices = 0;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        packedIndices |= bestIndices[i] << (i * 2);
+      }
+
+      outBlock[0] = static_cast<uint8>(bestColor0 & 0xFF);
+      outBlock[1] = static_cast<uint8>(bestColor0 >> 8);
+      outBlock[2] = static_cast<uint8>(bestColor1 & 0xFF);
+      outBlock[3] = static_cast<uint8>(bestColor1 >> 8);
+      for (uint32 i = 0; i < 4; ++i) {
+        outBlock[4 + i] = static_cast<uint8>(packedIndices >> (i * 8));
+      }
+    }
+
+    void
+    decodeColorBlock(const uint8* block, bool bFourColors, uint8* outPixels) {
+      const uint16 color0 = static_cast<uint16>(block[0] | (block[1] << 8));
+      const uint16 color1 = static_cast<uint16>(block[2] | (block[3] << 8));
+
+      int32 palette[4][4];
+      colorPalette(color0, color1, bFourColors, palette);
+
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        const uint32 index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+        for (uint32 c = 0; c < 4; ++c) {
+          outPixels[i * 4 + c] = static_cast<uint8>(palette[index][c]);
+        }
+      }
+    }
+
+    /*************************************************************************/
+    /**
+     * BC4 style single channel blocks (BC3 alpha, BC5 red and green)
+     */
+    /*************************************************************************/
+    void
+    channelPalette(int32 value0, int32 value1, int32* outPalette) {
+      outPalette[0] = value0;
+      outPalette[1] = value1;
+      if (value0 > value1) {
+        for (int32 i = 1; i < 7; ++i) {
+          outPalette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+        }
+      }
+      else {
+        for (int32 i = 1; i < 5; ++i) {
+          outPalette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+        }
+        outPalette[6] = 0;
+        outPalette[7] = 255;
+      }
+    }
+
+    int32
+    selectChannelIndices(const uint8* values,
+                         uint32 stride,
+                         int32 value0,
+                         int32 value1,
+                         uint64& outPackedIndices) {
+      int32 palette[8];
+      channelPalette(value0, value1, palette);
+
+      int32 totalError = 0;
+      outPackedIndices = 0;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        const int32 value = values[i * stride];
+        int32 bestError = NumLimit::MAX_INT32;
+        uint64 bestIndex = 0;
+        for (uint32 k = 0; k < 8; ++k) {
+          const int32 error = (value - palette[k]) * (value - palette[k]);
+          if (error < bestError) {
+            bestError = error;
+            bestIndex = k;
+          }
+        }
+        totalError += bestError;
+        outPackedIndices |= bestIndex << (i * 3);
+      }
+      return totalError;
+    }
+
+    /**
+     * @brief Encodes one channel of the pixels (values[i * stride]) as an
+     *        interpolated BC4 block. Tries both block modes when the six
+     *        value mode can represent exact 0 and 255.
+     */
+    void
+    encodeChannelBlock(const uint8* values, uint32 stride, uint8* outBlock) {
+      int32 minValue = 255, maxValue = 0;
+      int32 minInner = 255, maxInner = 0;
+      bool bHasExtremes = false;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        const int32 value = values[i * stride];
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        if (value == 0 || value == 255) {
+          bHasExtremes = true;
+        }
+        else {
+          minInner = std::min(minInner, value);
+          maxInner = std::max(maxInner, value);
+        }
+      }
+
+      int32 value0 = maxValue;
+      int32 value1 = minValue;
+      uint64 packedIndices = 0;
+      int32 error = selectChannelIndices(values, stride, value0, value1, packedIndices);
+
+      if (bHasExtremes && minValue != maxValue && error > 0) {
+        if (minInner > maxInner) {
+          minInner = maxInner = 0;
+        }
+
+        uint64 innerIndices = 0;
+        const int32 innerError =
+          selectChannelIndices(values, stride, minInner, maxInner, innerIndices);
+        if (innerError < error) {
+          value0 = minInner;
+          value1 = maxInner;
+          packedIndices = innerIndices;
+        }
+      }
+
+      outBlock[0] = static_cast<uint8>(value0);
+      outBlock[1] = static_cast<uint8>(value1);
+      for (uint32 i = 0; i < 6; ++i) {
+        outBlock[2 + i] = static_cast<uint8>(packedIndices >> (i * 8));
+      }
+    }
+
+    void
+    decodeChannelBlock(const uint8* block, uint8* outValues, uint32 stride) {
+      int32 palette[8];
+      channelPalette(block[0], block[1], palette);
+
+      uint64 packedIndices = 0;
+      for (uint32 i = 0; i < 6; ++i) {
+        packedIndices |= static_cast<uint64>(block[2 + i]) << (i * 8);
+      }
+
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        outValues[i * stride] = static_cast<uint8>(palette[(packedIndices >> (i * 3)) & 7]);
+      }
+    }
+
+    /*************************************************************************/
+    /**
+     * BC7 mode 6 blocks
+     */
+    /*************************************************************************/
+
+    /**
+     * @brief Quantizes an end point to 7 bits per channel plus the shared
+     *        p-bit, picking the p-bit that gives the lowest error.
+     */
+    void
+    quantizeBC7EndPoint(const float* endPoint, uint32* outValues, uint32& outPBit) {
+      float bestError = NumLimit::MAX_FLOAT;
+      for (uint32 pBit = 0; pBit < 2; ++pBit) {
+        uint32 values[4];
+        float error = 0.0f;
+        for (uint32 c = 0; c < 4; ++c) {
+          const int32 q = roundToInt((endPoint[c] - static_cast<float>(pBit)) * 0.5f);
+          values[c] = static_cast<uint32>(std::min(std::max(q, 0), 127));
+          const float d = static_cast<float>((values[c] << 1) | pBit) - endPoint[c];
+          error += d * d;
+        }
+
+        if (error < bestError) {
+          bestError = error;
+          outPBit = pBit;
+          std::copy(values, values + 4, outValues);
+        }
+      }
+    }
+
+    void
+    bc7Palette(const uint32* values0,
+               uint32 pBit0,
+               const uint32* values1,
+               uint32 pBit1,
+               int32 (*outPalette)[4]) {
+      for (uint32 c = 0; c < 4; ++c) {
+        const int32 e0 = static_cast<int32>((values0[c] << 1) | pBit0);
+        const int32 e1 = static_cast<int32>((values1[c] << 1) | pBit1);
+        for (uint32 k = 0; k < 16; ++k) {
+          const int32 w = static_cast<int32>(BC7_WEIGHTS[k]);
+          outPalette[k][c] = ((64 - w) * e0 + w * e1 + 32) >> 6;
+        }
+      }
+    }
+
+    float
+    selectBC7Indices(const float (*points)[4],
+                     const int32 (*palette)[4],
+                     uint32* outIndices) {
+      //Project on the palette line to find the two candidates around each
+      //pixel instead of testing all sixteen entries.
+      float dir[4];
+      float dirLength2 = 0.0f;
+      for (uint32 c = 0; c < 4; ++c) {
+        dir[c] = static_cast<float>(palette[15][c] - palette[0][c]);
+        dirLength2 += dir[c] * dir[c];
+      }
+
+      float totalError = 0.0f;
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        uint32 first = 0;
+        uint32 last = 0;
+        if (dirLength2 > 0.0f) {
+          float t = 0.0f;
+          for (uint32 c = 0; c < 4; ++c) {
+            t += (points[i][c] - static_cast<float>(palette[0][c])) * dir[c];
+          }
+          t = t / dirLength2 * 64.0f;
+
+          uint32 k = 0;
+          while (k < 15 && static_cast<float>(BC7_WEIGHTS[k]) < t) {
+            ++k;
+          }
+          first = k > 0 ? k - 1 : 0;
+          last = k;
+        }
+
+        float bestError = NumLimit::MAX_FLOAT;
+        for (uint32 k = first; k <= last; ++k) {
+          float error = 0.0f;
+          for (uint32 c = 0; c < 4; ++c) {
+            const float d = points[i][c] - static_cast<float>(palette[k][c]);
+            error += d * d;
+          }
+          if (error < bestError) {
+            bestError = error;
+            outIndices[i] = k;
+          }
+        }
+        totalError += bestError;
+      }
+      return totalError;
+    }
+
+    void
+    encodeBC7Block(const uint8* pixels, uint8* outBlock) {
+      float points[BLOCK_PIXELS][4];
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        for (uint32 c = 0; c < 4; ++c) {
+          points[i][c] = static_cast<float>(pixels[i * 4 + c]);
+        }
+      }
+
+      float end0[4], end1[4];
+      fitEndPoints<4>(points, end0, end1);
+
+      uint32 bestValues0[4] = {}, bestValues1[4] = {};
+      uint32 bestPBit0 = 0, bestPBit1 = 0;
+      uint32 bestIndices[BLOCK_PIXELS] = {};
+      float bestError = NumLimit::MAX_FLOAT;
+
+      for (uint32 iter = 0; iter < REFINE_ITERATIONS + 1; ++iter) {
+        uint32 values0[4], values1[4];
+        uint32 pBit0 = 0, pBit1 = 0;
+        quantizeBC7EndPoint(end0, values0, pBit0);
+        quantizeBC7EndPoint(end1, values1, pBit1);
+
+        int32 palette[16][4];
+        bc7Palette(values0, pBit0, values1, pBit1, palette);
+
+        uint32 indices[BLOCK_PIXELS];
+        const float error = selectBC7Indices(points, palette, indices);
+        if (error < bestError) {
+          bestError = error;
+          std::copy(values0, values0 + 4, bestValues0);
+          std::copy(values1, values1 + 4, bestValues1);
+          bestPBit0 = pBit0;
+          bestPBit1 = pBit1;
+          std::copy(indices, indices + BLOCK_PIXELS, bestIndices);
+        }
+
+        if (iter == REFINE_ITERATIONS || bestError == 0.0f) {
+          break;
+        }
+
+        float weights[BLOCK_PIXELS];
+        for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+          weights[i] = static_cast<float>(BC7_WEIGHTS[indices[i]]) / 64.0f;
+        }
+        if (!leastSquaresEndPoints<4>(points, weights, end0, end1)) {
+          break;
+        }
+      }
+
+      //The most significant bit of the first index is implicit (zero), so
+      //flip the end points if the first pixel needs it.
+      if (bestIndices[0] >= 8) {
+        std::swap(bestValues0, bestValues1);
+        std::swap(bestPBit0, bestPBit1);
+        for (auto& index : bestIndices) {
+          index = 15 - index;
+        }
+      }
+
+      std::fill(outBlock, outBlock + 16, static_cast<uint8>(0));
+      BitWriter writer(outBlock);
+      writer.write(1u << 6, 7); //Mode 6
+      for (uint32 c = 0; c < 4; ++c) {
+        writer.write(bestValues0[c], 7);
+        writer.write(bestValues1[c], 7);
+      }
+      writer.write(bestPBit0, 1);
+      writer.write(bestPBit1, 1);
+      writer.write(bestIndices[0], 3);
+      for (uint32 i = 1; i < BLOCK_PIXELS; ++i) {
+        writer.write(bestIndices[i], 4);
+      }
+    }
+
+    void
+    decodeBC7Block(const uint8* block, uint8* outPixels) {
+      if ((block[0] & 0x7F) != (1u << 6)) {
+        //Only mode 6 is supported, flag anything else as an error color
+        for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+          outPixels[i * 4 + 0] = 255;
+          outPixels[i * 4 + 1] = 0;
+          outPixels[i * 4 + 2] = 255;
+          outPixels[i * 4 + 3] = 255;
+        }
+        return;
+      }
+
+      BitReader reader(block);
+      reader.read(7);
+
+      uint32 values0[4], values1[4];
+      for (uint32 c = 0; c < 4; ++c) {
+        values0[c] = reader.read(7);
+        values1[c] = reader.read(7);
+      }
+      const uint32 pBit0 = reader.read(1);
+      const uint32 pBit1 = reader.read(1);
+
+      int32 palette[16][4];
+      bc7Palette(values0, pBit0, values1, pBit1, palette);
+
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        const uint32 index = reader.read(i == 0 ? 3 : 4);
+        for (uint32 c = 0; c < 4; ++c) {
+          outPixels[i * 4 + c] = static_cast<uint8>(palette[index][c]);
+        }
+      }
+    }
+  }
+
+  uint32
+  BlockCompression::getBlockSize(BLOCK_FORMAT::E format) {
+    return BLOCK_FORMAT::kBC1 == format ? 8 : 16;
+  }
+
+  uint32
+  BlockCompression::calcRowPitch(BLOCK_FORMAT::E format, uint32 width) {
+    return std::max((width + 3) / 4, 1u) * getBlockSize(format);
+  }
+
+  SIZE_T
+  BlockCompression::calcImageSize(BLOCK_FORMAT::E format, uint32 width, uint32 height) {
+    return static_cast<SIZE_T>(calcRowPitch(format, width)) * std::max((height + 3) / 4, 1u);
+  }
+
+  void
+  BlockCompression::encodeBlock(BLOCK_FORMAT::E format,
+                                const uint8* pixels,
+                                uint8* outBlock) {
+    switch (format) {
+    case BLOCK_FORMAT::kBC1:
+      encodeColorBlock(pixels, outBlock);
+      break;
+    case BLOCK_FORMAT::kBC3:
+      encodeChannelBlock(pixels + 3, 4, outBlock);
+      encodeColorBlock(pixels, outBlock + 8);
+      break;
+    case BLOCK_FORMAT::kBC5:
+      encodeChannelBlock(pixels + 0, 4, outBlock);
+      encodeChannelBlock(pixels + 1, 4, outBlock + 8);
+      break;
+    case BLOCK_FORMAT::kBC7:
+      encodeBC7Block(pixels, outBlock);
+      break;
+    }
+  }
+
+  void
+  BlockCompression::decodeBlock(BLOCK_FORMAT::E format,
+                                const uint8* block,
+                                uint8* outPixels) {
+    switch (format) {
+    case BLOCK_FORMAT::kBC1:
+      decodeColorBlock(block, false, outPixels);
+      break;
+    case BLOCK_FORMAT::kBC3:
+      decodeColorBlock(block + 8, true, outPixels);
+      decodeChannelBlock(block, outPixels + 3, 4);
+      break;
+    case BLOCK_FORMAT::kBC5:
+      decodeChannelBlock(block, outPixels + 0, 4);
+      decodeChannelBlock(block + 8, outPixels + 1, 4);
+      for (uint32 i = 0; i < BLOCK_PIXELS; ++i) {
+        outPixels[i * 4 + 2] = 0;
+        outPixels[i * 4 + 3] = 255;
+      }
+      break;
+    case BLOCK_FORMAT::kBC7:
+      decodeBC7Block(block, outPixels);
+      break;
+    }
+  }
+
+  void
+  BlockCompression::compress(BLOCK_FORMAT::E format,
+                             const uint8* pixels,
+                             uint32 width,
+                             uint32 height,
+                             uint8* outData,
+                             bool bParallel) {
+    if (0 == width || 0 == height) {
+      return;
+    }
+
+    const uint32 blocksWide = (width + 3) / 4;
+    const uint32 blocksHigh = (height + 3) / 4;
+    const uint32 blockSize = getBlockSize(format);
+    const uint32 rowPitch = calcRowPitch(format, width);
+    const uint32 minRowsPerTask = std::max(MIN_BLOCKS_PER_TASK / blocksWide, 1u);
+
+    auto encodeRows = [&](uint32 begin, uint32 end) {
+      uint8 blockPixels[BLOCK_PIXELS * 4];
+      for (uint32 by = begin; by < end; ++by) {
+        uint8* pRowOut = outData + static_cast<SIZE_T>(by) * rowPitch;
+        for (uint32 bx = 0; bx < blocksWide; ++bx) {
+          //Replicate the last row / column on the partial blocks
+          for (uint32 y = 0; y < 4; ++y) {
+            const uint32 srcY = std::min(by * 4 + y, height - 1);
+            const uint8* pSrcRow = pixels + static_cast<SIZE_T>(srcY) * width * 4;
+            for (uint32 x = 0; x < 4; ++x) {
+              const uint32 srcX = std::min(bx * 4 + x, width - 1);
+              std::memcpy(&blockPixels[(y * 4 + x) * 4], pSrcRow + srcX * 4, 4);
+            }
+          }
+
+          encodeBlock(format, blockPixels, pRowOut + bx * blockSize);
+        }
+      }
+    };
+
+    parallelForChunks("BlockCompression", blocksHigh, minRowsPerTask, encodeRows, bParallel);
+  }
+
+  void
+  BlockCompression::decompress(BLOCK_FORMAT::E format,
+                               const uint8* data,
+                               uint32 width,
+                               uint32 height,
+                               uint8* outPixels) {
+    const uint32 blocksWide = (width + 3) / 4;
+    const uint32 blocksHigh = (height + 3) / 4;
+    const uint32 blockSize = getBlockSize(format);
+
+    uint8 blockPixels[BLOCK_PIXELS * 4];
+    for (uint32 by = 0; by < blocksHigh; ++by) {
+      for (uint32 bx = 0; bx < blocksWide; ++bx) {
+        const SIZE_T blockIndex = static_cast<SIZE_T>(by) * blocksWide + bx;
+        decodeBlock(format, data + blockIndex * blockSize, blockPixels);
+
+        for (uint32 y = 0; y < 4 && by * 4 + y < height; ++y) {
+          for (uint32 x = 0; x < 4 && bx * 4 + x < width; ++x) {
+            const SIZE_T dst = (static_cast<SIZE_T>(by * 4 + y) * width + bx * 4 + x) * 4;
+            std::memcpy(outPixels + dst, &blockPixels[(y * 4 + x) * 4], 4);
+          }
+        }
+      }
+    }
+  }
+
+  MipChain
+  BlockCompression::compressChain(BLOCK_FORMAT::E format,
+                                  const MipChain& chain,
+                                  bool bParallel) {
+    MipChain result;
+    result.levels.resize(chain.levels.size());
+
+    SIZE_T totalSize = 0;
+    for (SIZE_T i = 0; i < chain.levels.size(); ++i) {
+      auto& level = result.levels[i];
+      level.width = chain.levels[i].width;
+      level.height = chain.levels[i].height;
+      level.rowPitch = calcRowPitch(format, level.width);
+      level.offset = totalSize;
+      totalSize += calcImageSize(format, level.width, level.height);
+    }
+    result.data.resize(totalSize);
+
+    for (uint32 i = 0; i < cast::st<uint32>(chain.levels.size()); ++i) {
+      const auto& level = result.levels[i];
+      compress(format,
+               chain.getLevelData(i),
+               level.width,
+               level.height,
+               result.data.data() + level.offset,
+               bParallel);
+    }
+
+    return result;
+  }
+}
@@ -18,117 +18,598 @@
 /*****************************************************************************/
 #include "geCompression.h"
 #include "geDataStream.h"
+#include "geTaskScheduler.h"
+#include "geMath.h"
 #include "geDebug.h"
 #include <lz4.h>
+#include <lz4hc.h>
 
 namespace geEngineSDK {
   using std::static_pointer_cast;
 
-  SPtr<MemoryDataStream>
-  Compression::compress(SPtr<DataStream>& input,
-                        function<void(float)> reportProgress) {
-    //LZ4 provides a function that will tell you the maximum size of compressed
-    //output based on input data via LZ4_compressBound().
-    const auto maxDstSize = static_cast<SIZE_T>(LZ4_compressBound(
-                                                static_cast<int32>(input->size())));
+  namespace {
+    /**
+     * "GELZ4BLK", an original size no stream written by the first version of
+     * the format (a uint64 size and a single LZ4 block) can have.
+     */
+    CONSTEXPR uint64 BLOCK_MAGIC = 0x4B4C42345A4C4547ULL;
+    CONSTEXPR uint32 BLOCK_VERSION = 1;
+
+    /**
+     * Set in the packed size of the blocks stored without compression,
+     * because LZ4 couldn't make them smaller.
+     */
+    CONSTEXPR uint32 RAW_BLOCK_FLAG = 0x80000000u;
+
+    /**
+     * Only the last 64 KB of a dictionary can be referenced by LZ4.
+     */
+    CONSTEXPR SIZE_T MAX_DICTIONARY_SIZE = 64 * 1024;
 
-    //We will use that size for our destination boundary when allocating space.
-    MemoryDataStream compData(maxDstSize);
+    /**
+     * Followed by the packed size of every block, and then the blocks.
+     */
+    struct BlockHeader
+    {
+      uint64 magic;
+      uint32 version;
+      uint32 blockSize;
+      uint64 originalSize;
+      uint32 numBlocks;
+      uint32 dictionaryHash;
+    };
+    static_assert(sizeof(BlockHeader) == 32, "The header is written as is.");
 
-    int32 compSize = -1; //Initially set to error
-    {//Make a local copy of the input data
-      MemoryDataStream inputData(input);
+    struct Dictionary
+    {
+      const char* data = nullptr;
+      int32 size = 0;
+      uint32 hash = 0;
+    };
 
-      //Invoke LZ4_compress_default
-      compSize = LZ4_compress_default(reinterpret_cast<char*>(inputData.getPtr()),
-                                      reinterpret_cast<char*>(compData.getPtr()),
-                                      static_cast<int32>(inputData.size()),
-                                      static_cast<int32>(maxDstSize));
+    Dictionary
+    getDictionary(const SPtr<MemoryDataStream>& dictionary) {
+      Dictionary out;
+      if (!dictionary || 0 == dictionary->size()) {
+        return out;
+      }
+
+      const SIZE_T size = std::min(dictionary->size(), MAX_DICTIONARY_SIZE);
+      out.data = reinterpret_cast<const char*>(dictionary->getPtr()) +
+                 (dictionary->size() - size);
+      out.size = cast::st<int32>(size);
+
+      //FNV-1a, never 0 so 0 means no dictionary
+      out.hash = 2166136261u;
+      for (int32 i = 0; i < out.size; ++i) {
+        out.hash = (out.hash ^ cast::st<uint8>(out.data[i])) * 16777619u;
+      }
+      out.hash |= 1;
+      return out;
     }
 
-    //Check return_value to determine what happened.
-    if (compSize < 0) {
-      if (reportProgress) reportProgress(1.0f);
-      GE_LOG(kError, Generic, "Failure trying to compress the data.");
-      return nullptr;
+    SIZE_T
+    getRawBlockSize(const BlockHeader& header, uint32 block) {
+      const uint64 begin = cast::st<uint64>(block) * header.blockSize;
+      return cast::st<SIZE_T>(std::min<uint64>(header.blockSize,
+                                               header.originalSize - begin));
+    }
+
+    /**
+     * Reads the header after the magic, and the block index.
+     */
+    bool
+    readBlockIndex(DataStream& stream,
+                   BlockHeader& header,
+                   Vector<uint32>& blockSizes,
+                   const Dictionary& dictionary) {
+      const SIZE_T restSize = sizeof(BlockHeader) - sizeof(uint64);
+      if (stream.read(&header.version, restSize) != restSize) {
+        GE_LOG(kError, Generic, "Compressed data is truncated.");
+        return false;
+      }
+
+      const uint64 expectedBlocks = 0 == header.blockSize ? 0 :
+        (header.originalSize + header.blockSize - 1) / header.blockSize;
+      if (BLOCK_VERSION != header.version ||
+          header.blockSize < Compression::MIN_BLOCK_SIZE ||
+          header.blockSize > Compression::MAX_BLOCK_SIZE ||
+          expectedBlocks != header.numBlocks) {
+        GE_LOG(kError, Generic, "Unsupported compressed data header.");
+        return false;
+      }
+
+      if (header.dictionaryHash != dictionary.hash) {
+        GE_LOG(kError,
+               Generic,
+               0 == header.dictionaryHash ?
+                 "Compressed data doesn't use a dictionary." :
+                 "Compressed data needs a different dictionary.");
+        return false;
+      }
+
+      blockSizes.resize(header.numBlocks);
+      const SIZE_T indexSize = blockSizes.size() * sizeof(uint32);
+      if (stream.read(blockSizes.data(), indexSize) != indexSize) {
+        GE_LOG(kError, Generic, "Compressed data is truncated.");
+        return false;
+      }
+      return true;
+    }
+
+    /**
+     * Checks the packed sizes of the index before anything is allocated
+     * from them: a block can't be bigger than LZ4 makes it, nor than the
+     * data left after the index.
+     */
+    bool
+    validateBlockIndex(const BlockHeader& header,
+                       const Vector<uint32>& blockSizes,
+                       SIZE_T availableSize) {
+      const auto maxPackedSize = cast::st<SIZE_T>(
+                                   LZ4_compressBound(cast::st<int32>(header.blockSize)));
+
+      uint64 totalSize = 0;
+      for (uint32 block = 0; block < header.numBlocks; ++block) {
+        const SIZE_T packedSize = blockSizes[block] & ~RAW_BLOCK_FLAG;
+        const bool bRaw = 0 != (blockSizes[block] & RAW_BLOCK_FLAG);
+        totalSize += packedSize;
+        if (packedSize > maxPackedSize ||
+            (bRaw && packedSize != getRawBlockSize(header, block)) ||
+            totalSize > availableSize) {
+          GE_LOG(kError, Generic, "Compressed data has a corrupt block index.");
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @return The packed size, with RAW_BLOCK_FLAG if it's a copy.
+     */
+    uint32
+    compressBlock(const uint8* src,
+                  SIZE_T srcSize,
+                  uint8* dst,
+                  int32 level,
+                  const Dictionary& dictionary) {
+      const auto inSize = cast::st<int32>(srcSize);
+      auto source = reinterpret_cast<const char*>(src);
+      auto dest = reinterpret_cast<char*>(dst);
+      const int32 capacity = LZ4_compressBound(inSize);
+
+      int32 packedSize = 0;
+      if (0 == level) {
+        if (dictionary.data) {
+          LZ4_stream_t stream;
+          LZ4_initStream(&stream, sizeof(stream));
+          LZ4_loadDict(&stream, dictionary.data, dictionary.size);
+          packedSize = LZ4_compress_fast_continue(&stream, source, dest, inSize, capacity, 1);
+        }
+        else {
+          packedSize = LZ4_compress_default(source, dest, inSize, capacity);
+        }
+      }
+      else {
+        if (dictionary.data) {
+          LZ4_streamHC_t* stream = LZ4_createStreamHC();
+          LZ4_resetStreamHC_fast(stream, level);
+          LZ4_loadDictHC(stream, dictionary.data, dictionary.size);
+          packedSize = LZ4_compress_HC_continue(stream, source, dest, inSize, capacity);
+          LZ4_freeStreamHC(stream);
+        }
+        else {
+          packedSize = LZ4_compress_HC(source, dest, inSize, capacity, level);
+        }
+      }
+
+      if (packedSize <= 0 || cast::st<SIZE_T>(packedSize) >= srcSize) {
+        memcpy(dst, src, srcSize);
+        return cast::st<uint32>(srcSize) | RAW_BLOCK_FLAG;
+      }
+      return cast::st<uint32>(packedSize);
+    }
+
+    bool
+    decompressBlock(const uint8* src,
+                    uint32 packedSize,
+                    uint8* dst,
+                    SIZE_T dstSize,
+                    const Dictionary& dictionary) {
+      const uint32 srcSize = packedSize & ~RAW_BLOCK_FLAG;
+      if (packedSize & RAW_BLOCK_FLAG) {
+        if (srcSize != dstSize) {
+          return false;
+        }
+        memcpy(dst, src, dstSize);
+        return true;
+      }
+
+      auto source = reinterpret_cast<const char*>(src);
+      auto dest = reinterpret_cast<char*>(dst);
+      const int32 size = dictionary.data ?
+        LZ4_decompress_safe_usingDict(source,
+                                      dest,
+                                      cast::st<int32>(srcSize),
+                                      cast::st<int32>(dstSize),
+                                      dictionary.data,
+                                      dictionary.size) :
+        LZ4_decompress_safe(source,
+                            dest,
+                            cast::st<int32>(srcSize),
+                            cast::st<int32>(dstSize));
+      return cast::st<SIZE_T>(size) == dstSize;
+    }
+
+    /**
+     * Blocks read from the stream at a time, so there is work for every
+     * worker without holding all the data in memory.
+     */
+    uint32
+    getBlocksPerBatch(bool bParallel) {
+      if (bParallel && TaskScheduler::isStarted()) {
+        return std::max(TaskScheduler::instance().getNumWorkers(), 1u) * 4;
+      }
+      return 1;
+    }
+
+    /**
+     * The first version of the format: the original size and a single LZ4
+     * block, with the size already read.
+     */
+    SPtr<MemoryDataStream>
+    decompressSingleBlock(DataStream& input, uint64 originalDataSize) {
+      if (!originalDataSize) {
+        auto out = ge_shared_ptr_new<MemoryDataStream>(0u);
+        out->seek(0u);
+        return out;
+      }
+
+      if (originalDataSize > cast::st<uint64>(NumLimit::MAX_INT32)) {
+        GE_LOG(kError, Generic, "Failure trying to decompress the data.");
+        return nullptr;
+      }
+
+      const SIZE_T srcSize = input.size() - input.tell();
+      Vector<uint8> src(srcSize);
+      const SIZE_T readSize = input.read(src.data(), srcSize);
+
+      //Create a buffer the size of the original data
+      SPtr<MemoryDataStream> decompData = ge_shared_ptr_new<MemoryDataStream>
+                                          (cast::st<SIZE_T>(originalDataSize));
+
+      int32 decompSize = LZ4_decompress_safe(reinterpret_cast<char*>(src.data()),
+                                             reinterpret_cast<char*>(decompData->getPtr()),
+                                             cast::st<int32>(readSize),
+                                             cast::st<int32>(originalDataSize));
+      if (decompSize < 0) {
+        GE_LOG(kError, Generic, "Failure trying to decompress the data.");
+        return nullptr;
+      }
+
+      if (decompSize != cast::st<int32>(originalDataSize)) { //This should never happen
+        GE_LOG(kError, Generic, "Difference in data compressed and decompressed.");
+        return nullptr;
+      }
+
+      decompData->seek(0);
+      return decompData;
     }
-    else if (compSize == 0) {
+  }
+
+  SPtr<MemoryDataStream>
+  Compression::compress(SPtr<DataStream>& input,
+                        function<void(float)> reportProgress) {
+    return compress(input, CompressionOptions(), reportProgress);
+  }
+
+  SPtr<MemoryDataStream>
+  Compression::compress(SPtr<DataStream>& input,
+                        const CompressionOptions& options,
+                        function<void(float)> reportProgress) {
+    const Dictionary dictionary = getDictionary(options.dictionary);
+
+    BlockHeader header;
+    header.magic = BLOCK_MAGIC;
+    header.version = BLOCK_VERSION;
+    header.blockSize = Math::clamp(options.blockSize, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+    header.originalSize = input->size() - input->tell();
+    header.dictionaryHash = dictionary.hash;
+
+    const uint64 numBlocks = (header.originalSize + header.blockSize - 1) / header.blockSize;
+    if (numBlocks > NumLimit::MAX_UINT32) {
       if (reportProgress) reportProgress(1.0f);
-      GE_LOG(kError, Generic, "Destination buffer couldn't hold all the information.");
+      GE_LOG(kError, Generic, "Data is too large to compress.");
       return nullptr;
     }
+    header.numBlocks = cast::st<uint32>(numBlocks);
+
+    const int32 level = Math::clamp(options.level, 0, LZ4HC_CLEVEL_MAX);
+    const uint32 blocksPerBatch = getBlocksPerBatch(options.bParallel);
+    const auto maxPackedSize = cast::st<SIZE_T>(
+                                 LZ4_compressBound(cast::st<int32>(header.blockSize)));
 
-    //Create the return buffer set to the real size of the compression
-    //We will save the first the size of the real data, and then the data
-    const SIZE_T compSizeBytes = static_cast<SIZE_T>(compSize);
-    const SIZE_T totalSize = compSizeBytes + sizeof(uint64);
-    SPtr<MemoryDataStream> realComp_data = ge_shared_ptr_new<MemoryDataStream>(totalSize);
+    //A block that doesn't get smaller is stored as is, so the output is
+    //never bigger than the header, the index and the original data
+    const SIZE_T indexOffset = sizeof(BlockHeader);
+    const SIZE_T blocksOffset = indexOffset + header.numBlocks * sizeof(uint32);
+    auto compData = ge_shared_ptr_new<MemoryDataStream>(
+                      blocksOffset + cast::st<SIZE_T>(header.originalSize));
+    compData->write(&header, sizeof(BlockHeader));
 
-    //This value indicates the real size of the data,
-    //we need to save this for decompression purposes
-    uint64 headerSizeData = input->size();
+    //The index is filled as the blocks are compressed
+    auto index = reinterpret_cast<uint32*>(compData->getPtr() + indexOffset);
+    compData->seek(blocksOffset);
+
+    Vector<uint8> rawBatch(cast::st<SIZE_T>(std::min<uint64>(
+                             cast::st<uint64>(blocksPerBatch) * header.blockSize,
+                             header.originalSize)));
+    Vector<uint8> packedBatch(std::min(blocksPerBatch, header.numBlocks) * maxPackedSize);
+    Vector<uint32> packedSizes(blocksPerBatch);
+
+    for (uint32 first = 0; first < header.numBlocks; first += blocksPerBatch) {
+      const uint32 count = std::min(blocksPerBatch, header.numBlocks - first);
+      const uint64 batchBegin = cast::st<uint64>(first) * header.blockSize;
+      const auto batchSize = cast::st<SIZE_T>(std::min<uint64>(
+                               cast::st<uint64>(count) * header.blockSize,
+                               header.originalSize - batchBegin));
+
+      if (input->read(rawBatch.data(), batchSize) != batchSize) {
+        if (reportProgress) reportProgress(1.0f);
+        GE_LOG(kError, Generic, "Failure trying to read the data to compress.");
+        return nullptr;
+      }
 
-    realComp_data->write(&headerSizeData, sizeof(uint64));
-    realComp_data->write(compData.getPtr(), compSizeBytes);
+      //Blocks take different times, the workers take them one by one
+      auto compressBlocks = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+          packedSizes[i] = compressBlock(&rawBatch[i * SIZE_T(header.blockSize)],
+                                         getRawBlockSize(header, first + i),
+                                         &packedBatch[i * maxPackedSize],
+                                         level,
+                                         dictionary);
+        }
+      };
+      parallelForChunks("Compression", count, 1, compressBlocks, options.bParallel);
+
+      for (uint32 i = 0; i < count; ++i) {
+        compData->write(&packedBatch[i * maxPackedSize], packedSizes[i] & ~RAW_BLOCK_FLAG);
+      }
+      memcpy(index + first, packedSizes.data(), count * sizeof(uint32));
+
+      if (reportProgress) {
+        reportProgress(float(first + count) / float(header.numBlocks));
+      }
+    }
 
     //Set the buffer to the starting point
-    realComp_data->seek(0);
+    compData->truncate(compData->tell());
+    compData->seek(0);
 
-    if (reportProgress) {
+    if (reportProgress && 0 == header.numBlocks) {
       reportProgress(1.0f);
     }
 
-    return realComp_data;
+    return compData;
   }
 
   SPtr<MemoryDataStream>
   Compression::decompress(SPtr<DataStream>& input,
                           function<void(float)> reportProgress) {
-    MemoryDataStream src(input);
-    
-    //Read the original size of the data from the compressed buffer
-    uint64 originalDataSize = 0;
-    src >> originalDataSize;
+    return decompress(input, nullptr, true, reportProgress);
+  }
 
-    if (!originalDataSize) {
+  SPtr<MemoryDataStream>
+  Compression::decompress(SPtr<DataStream>& input,
+                          const SPtr<MemoryDataStream>& dictionary,
+                          bool bParallel,
+                          function<void(float)> reportProgress) {
+    auto finish = [&reportProgress](SPtr<MemoryDataStream> out) {
       if (reportProgress) {
         reportProgress(1.0f);
       }
-      auto out = ge_shared_ptr_new<MemoryDataStream>(0u);
-      out->seek(0u);
       return out;
+    };
+
+    uint64 magic = 0;
+    if (input->read(&magic, sizeof(magic)) != sizeof(magic)) {
+      GE_LOG(kError, Generic, "Compressed data is truncated.");
+      return finish(nullptr);
     }
 
-    //Create a buffer the size of the original data
-    SPtr<MemoryDataStream> decompData = ge_shared_ptr_new<MemoryDataStream>
-                                        (static_cast<SIZE_T>(originalDataSize));
+    if (BLOCK_MAGIC != magic) {
+      return finish(decompressSingleBlock(*input, magic));
+    }
 
-    int32 decompSize = LZ4_decompress_safe(reinterpret_cast<char*>(src.getCurrentPtr()),
-                                           reinterpret_cast<char*>(decompData->getPtr()),
-                                           static_cast<int32>(src.size() - sizeof(uint64)),
-                                           static_cast<int32>(originalDataSize));
-    //Set the buffer to the starting point
-    decompData->seek(0);
+    const Dictionary dict = getDictionary(dictionary);
+    BlockHeader header;
+    header.magic = magic;
+    Vector<uint32> blockSizes;
+    if (!readBlockIndex(*input, header, blockSizes, dict) ||
+        !validateBlockIndex(header, blockSizes, input->size() - input->tell())) {
+      return finish(nullptr);
+    }
+
+    if (cast::st<uint64>(cast::st<SIZE_T>(header.originalSize)) != header.originalSize) {
+      GE_LOG(kError, Generic, "Data is too large to decompress.");
+      return finish(nullptr);
+    }
+
+    auto decompData = ge_shared_ptr_new<MemoryDataStream>(
+                        cast::st<SIZE_T>(header.originalSize));
+    uint8* outData = decompData->getPtr();
+
+    const uint32 blocksPerBatch = getBlocksPerBatch(bParallel);
+    Vector<SIZE_T> packedOffsets(blocksPerBatch + 1);
+    Vector<uint8> packedBatch;
+
+    for (uint32 first = 0; first < header.numBlocks; first += blocksPerBatch) {
+      const uint32 count = std::min(blocksPerBatch, header.numBlocks - first);
+
+      //The blocks of a batch are next to each other
+      packedOffsets[0] = 0;
+      for (uint32 i = 0; i < count; ++i) {
+        packedOffsets[i + 1] = packedOffsets[i] + (blockSizes[first + i] & ~RAW_BLOCK_FLAG);
+      }
+
+      packedBatch.resize(packedOffsets[count]);
+      if (input->read(packedBatch.data(), packedBatch.size()) != packedBatch.size()) {
+        GE_LOG(kError, Generic, "Compressed data is truncated.");
+        return finish(nullptr);
+      }
+
+      atomic<bool> bFailed(false);
+      auto decompressBlocks = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i) {
+          const uint32 block = first + i;
+          if (!decompressBlock(&packedBatch[packedOffsets[i]],
+                               blockSizes[block],
+                               outData + cast::st<SIZE_T>(block) * header.blockSize,
+                               getRawBlockSize(header, block),
+                               dict)) {
+            bFailed = true;
+          }
+        }
+      };
+      parallelForChunks("Compression", count, 1, decompressBlocks, bParallel);
+
+      if (bFailed) {
+        GE_LOG(kError, Generic, "Failure trying to decompress the data.");
+        return finish(nullptr);
+      }
 
-    if (decompSize < 0) {
       if (reportProgress) {
-        reportProgress(1.0f);
+        reportProgress(float(first + count) / float(header.numBlocks));
       }
+    }
+
+    //Set the buffer to the starting point
+    decompData->seek(0);
+    return finish(decompData);
+  }
+
+  CompressedDataStream::CompressedDataStream(const SPtr<DataStream>& source,
+                                             const SPtr<MemoryDataStream>& dictionary)
+    : DataStream(source->getName(), ACCESS_MODE::kREAD),
+      m_source(source),
+      m_dictionary(dictionary),
+      m_sourceStart(source->tell()) {
+    uint64 magic = 0;
+    if (m_source->read(&magic, sizeof(magic)) != sizeof(magic) || BLOCK_MAGIC != magic) {
+      GE_LOG(kError, Generic, "Stream doesn't hold compressed blocks.");
+      return;
+    }
+
+    BlockHeader header;
+    header.magic = magic;
+    if (!readBlockIndex(*m_source, header, m_blockSizes, getDictionary(m_dictionary)) ||
+        !validateBlockIndex(header, m_blockSizes, m_source->size() - m_source->tell())) {
+      m_blockSizes.clear();
+      return;
+    }
+
+    m_blockOffsets.resize(m_blockSizes.size());
+    uint64 offset = m_source->tell();
+    for (SIZE_T i = 0; i < m_blockSizes.size(); ++i) {
+      m_blockOffsets[i] = offset;
+      offset += m_blockSizes[i] & ~RAW_BLOCK_FLAG;
+    }
+
+    m_blockSize = header.blockSize;
+    m_size = cast::st<SIZE_T>(header.originalSize);
+    m_bValid = true;
+  }
+
+  bool
+  CompressedDataStream::loadBlock(uint32 block) {
+    if (block == m_loadedBlock) {
+      return true;
+    }
+
+    const uint32 packedSize = m_blockSizes[block] & ~RAW_BLOCK_FLAG;
+    const SIZE_T rawSize = std::min<SIZE_T>(m_blockSize,
+                                            m_size - SIZE_T(block) * m_blockSize);
+
+    m_packed.resize(packedSize);
+    m_block.resize(rawSize);
+    m_source->seek(cast::st<SIZE_T>(m_blockOffsets[block]));
+    if (m_source->read(m_packed.data(), packedSize) != packedSize ||
+        !decompressBlock(m_packed.data(),
+                         m_blockSizes[block],
+                         m_block.data(),
+                         rawSize,
+                         getDictionary(m_dictionary))) {
       GE_LOG(kError, Generic, "Failure trying to decompress the data.");
-      return nullptr;
+      m_loadedBlock = NumLimit::MAX_UINT32;
+      return false;
     }
-    
-    if (decompSize != static_cast<int32>(originalDataSize)) { //This should never happen
-      if (reportProgress) {
-        reportProgress(1.0f);
+
+    m_loadedBlock = block;
+    return true;
+  }
+
+  SIZE_T
+  CompressedDataStream::read(void* buf, SIZE_T count) {
+    auto out = static_cast<uint8*>(buf);
+    SIZE_T numRead = 0;
+    while (numRead < count && m_pos < m_size) {
+      const auto block = cast::st<uint32>(m_pos / m_blockSize);
+      if (!loadBlock(block)) {
+        break;
       }
-      GE_LOG(kError, Generic, "Difference in data compressed and decompressed.");
-      return nullptr;
-    }
 
-    if (reportProgress) {
-      reportProgress(1.0f);
+      const SIZE_T inBlock = m_pos - SIZE_T(block) * m_blockSize;
+      const SIZE_T copySize = std::min(count - numRead, m_block.size() - inBlock);
+      memcpy(out + numRead, &m_block[inBlock], copySize);
+      numRead += copySize;
+      m_pos += copySize;
     }
-    return decompData;
+    return numRead;
+  }
+
+  void
+  CompressedDataStream::skip(SIZE_T count) {
+    m_pos += std::min(count, m_size - m_pos);
+  }
+
+  void
+  CompressedDataStream::seek(SIZE_T pos) {
+    m_pos = std::min(pos, m_size);
+  }
+
+  SIZE_T
+  CompressedDataStream::tell() const {
+    return m_pos;
+  }
+
+  bool
+  CompressedDataStream::isEOF() const {
+    return m_pos >= m_size;
+  }
+
+  SPtr<DataStream>
+  CompressedDataStream::clone(bool copyData) const {
+    //A copy of a memory stream starts at the current position, so the whole
+    //source is copied to keep the compressed data at the same offset
+    m_source->seek(0);
+    SPtr<DataStream> source = m_source->clone(copyData);
+    source->seek(m_sourceStart);
+
+    auto stream = ge_shared_ptr_new<CompressedDataStream>(source, m_dictionary);
+    stream->seek(m_pos);
+    return stream;
+  }
+
+  void
+  CompressedDataStream::close() {
+    m_source->close();
+    m_blockSizes.clear();
+    m_blockOffsets.clear();
+    m_block.clear();
+    m_packed.clear();
+    m_loadedBlock = NumLimit::MAX_UINT32;
+    m_size = 0;
+    m_pos = 0;
+    m_bValid = false;
   }
 }
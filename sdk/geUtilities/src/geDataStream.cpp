@@ -363,6 +363,16 @@ namespace geEngineSDK {
     m_pos += count;
   }
 
+  void
+  MemoryDataStream::truncate(SIZE_T newSize) {
+    GE_ASSERT(newSize <= m_size);
+    m_size = newSize;
+    m_end = m_data + m_size;
+    if (m_pos > m_end) {
+      m_pos = m_end;
+    }
+  }
+
   void
   MemoryDataStream::seek(SIZE_T pos) {
     GE_ASSERT(m_data + pos <= m_end);
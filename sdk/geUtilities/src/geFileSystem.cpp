@@ -43,6 +43,10 @@ namespace fileSys = std::filesystem;
 #include <sys/types.h>
 #include <pwd.h>
 #include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include "geFileSystem.h"
 #endif
 
@@ -127,9 +131,9 @@ namespace geEngineSDK {
   sys_getLastModifiedTime(const WString& path) {
     fileSys::path filePath = path;
 
-    //Check if the path exists and is a regular file
+    //Check if the path exists and is a regular file or a folder
     fileSys::file_status status = fileSys::status(filePath);
-    if (fileSys::exists(status) && fileSys::is_regular_file(status)) {
+    if (fileSys::is_regular_file(status) || fileSys::is_directory(status)) {
       //Get last write time
       auto ftime = fileSys::last_write_time(filePath);
 
@@ -256,6 +260,107 @@ namespace geEngineSDK {
     }
   }
 
+#if USING(GE_PLATFORM_LINUX)
+  namespace {
+    /**
+     * @brief Layout of the records returned by the getdents64 system call.
+     */
+    struct LinuxDirent64
+    {
+      uint64 d_ino;
+      int64 d_off;
+      uint16 d_reclen;
+      uint8 d_type;
+      ANSICHAR d_name[1];
+    };
+  }
+
+  bool
+  FileSystem::readDirectory(const Path& dirPath,
+                            Vector<String>& files,
+                            Vector<String>& directories,
+                            time_t& lastModifiedTime) {
+    const int32 dirFd = open(dirPath.toString().c_str(),
+                             O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      return false;
+    }
+
+    struct stat dirStat;
+    lastModifiedTime = 0 == fstat(dirFd, &dirStat) ? dirStat.st_mtime : 0;
+
+    //readdir() asks for a few entries at a time, on large folders it's
+    //cheaper to fill a big buffer per system call
+    alignas(8) ANSICHAR buffer[32 * 1024];
+    while (true) {
+      const auto bytesRead = syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+      if (bytesRead <= 0) {
+        break;
+      }
+
+      for (int64 offset = 0; offset < bytesRead;) {
+        const auto* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+        offset += entry->d_reclen;
+
+        const ANSICHAR* name = entry->d_name;
+        if ('.' == name[0] && ('\0' == name[1] || ('.' == name[1] && '\0' == name[2]))) {
+          continue;
+        }
+
+        uint8 type = entry->d_type;
+        if (DT_UNKNOWN == type || DT_LNK == type) {
+          //Not every file system fills the type, and links count as what
+          //they point to, same as on getChildren()
+          struct stat entryStat;
+          if (0 != fstatat(dirFd, name, &entryStat, 0)) {
+            continue;
+          }
+          type = S_ISDIR(entryStat.st_mode) ? DT_DIR :
+                 (S_ISREG(entryStat.st_mode) ? DT_REG : DT_UNKNOWN);
+        }
+
+        if (DT_DIR == type) {
+          directories.emplace_back(name);
+        }
+        else if (DT_REG == type) {
+          files.emplace_back(name);
+        }
+      }
+    }
+
+    close(dirFd);
+    return true;
+  }
+#else
+  bool
+  FileSystem::readDirectory(const Path& dirPath,
+                            Vector<String>& files,
+                            Vector<String>& directories,
+                            time_t& lastModifiedTime) {
+    const fileSys::path findPath = UTF8::toWide(dirPath.toString());
+
+    error_code ec;
+    if (!fileSys::is_directory(findPath, ec)) {
+      return false;
+    }
+
+    lastModifiedTime = getLastModifiedTime(dirPath);
+
+    for (const auto& entry : fileSys::directory_iterator(findPath, ec)) {
+      String name = UTF8::fromWide(WString(entry.path().filename().wstring()));
+
+      if (entry.is_directory(ec)) {
+        directories.push_back(std::move(name));
+      }
+      else if (entry.is_regular_file(ec)) {
+        files.push_back(std::move(name));
+      }
+    }
+
+    return !ec;
+  }
+#endif
+
   bool
   FileSystem::iterate(const Path& dirPath,
                       const function<bool(const Path&)>& fileCallback,
@@ -305,7 +410,17 @@ namespace geEngineSDK {
 
   time_t
   FileSystem::getLastModifiedTime(const Path& fullPath) {
+#if USING(GE_PLATFORM_LINUX)
+    //Same source as readDirectory(), so both report the same time
+    struct stat pathStat;
+    if (0 == stat(fullPath.toString().c_str(), &pathStat) &&
+        (S_ISREG(pathStat.st_mode) || S_ISDIR(pathStat.st_mode))) {
+      return pathStat.st_mtime;
+    }
+    return 0;
+#else
     return sys_getLastModifiedTime(UTF8::toWide(fullPath.toString()));
+#endif
   }
 
   void
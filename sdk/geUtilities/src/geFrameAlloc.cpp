@@ -60,8 +60,11 @@ namespace geEngineSDK {
 
   byte*
   FrameAlloc::alloc(SIZE_T amount) {
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+    MemoryCounter::trackAlloc(nullptr, amount, MEMORY_SOURCE::kFrame);
+#endif
     if (!m_freeBlock) {
-      return nullptr;
+      allocBlock(m_blockSize);
     }
     GE_DEBUG_ONLY(amount += sizeof(SIZE_T));
 
@@ -88,8 +91,11 @@ namespace geEngineSDK {
 
   byte*
   FrameAlloc::allocAligned(SIZE_T amount, SIZE_T alignment) {
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+    MemoryCounter::trackAlloc(nullptr, amount, MEMORY_SOURCE::kFrame);
+#endif
     if (!m_freeBlock) {
-      return nullptr;
+      allocBlock(m_blockSize);
     }
     GE_DEBUG_ONLY(amount += sizeof(SIZE_T));
 
@@ -137,6 +143,10 @@ namespace geEngineSDK {
 
   void
   FrameAlloc::free(byte* data) {
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+    MemoryCounter::trackFree(data, MEMORY_SOURCE::kFrame);
+#endif
+
     //Dealloc is only used for debug and can be removed if needed.
     //All the actual deallocation happens in clear()
 #if USING(GE_DEBUG_MODE)
@@ -0,0 +1,617 @@
+/*****************************************************************************/
+/**
+ * @file    geMemorySerializer.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Encodes/decodes a reflected object from/to memory.
+ *
+ * Encodes/decodes a reflected object from/to memory.
+ *
+ * The records start with a 16 bytes header: MAGIC, VERSION, 16 bits of flags
+ * and the size of the records. It's followed by the value of the object.
+ *
+ * Every value starts with a byte of VALUE_KIND::E:
+ *   kArithmetic: the index of the type in the arithmetic codecs (uint8) and
+ *                the value, aligned to its size.
+ *   kEnum:       the value as int64.
+ *   kString:     the length (uint32) and the characters.
+ *   kBlock:      the index of the element type (uint8), the number of
+ *                elements (uint32) and all the elements, aligned to 16 bytes.
+ *   kArray:      the number of elements (uint32) and their values.
+ *   kObject:     the type name, the number of properties (uint32) and the
+ *                properties. Each one is the hash of its name (uint32), the
+ *                size of the rest of the property (uint32) and its value, so
+ *                the ones a type doesn't know can be skipped.
+ *   kNone:       nothing, for what can't be serialized.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geMemorySerializer.h"
+#include "geDebug.h"
+#include "geMath.h"
+
+namespace geEngineSDK {
+  void
+  MemoryRecordWriter::writeString(const String& value) {
+    write(cast::st<uint32>(value.size()));
+    writeBytes(value.data(), value.size());
+  }
+
+  void
+  MemoryRecordWriter::writeBytes(const void* data, SIZE_T size, SIZE_T alignment) {
+    const SIZE_T start = Math::divideAndRoundUp(m_buffer.size(), alignment) * alignment;
+    m_buffer.resize(start + size);
+    if (size > 0) {
+      memcpy(&m_buffer[start], data, size);
+    }
+  }
+
+  bool
+  MemoryRecordReader::readString(String& value) {
+    uint32 length = 0;
+    if (!read(length)) {
+      return false;
+    }
+    const uint8* data = readBlock(length);
+    if (nullptr == data) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data), length);
+    return true;
+  }
+
+  const uint8*
+  MemoryRecordReader::readBlock(SIZE_T size, SIZE_T alignment) {
+    const SIZE_T start = Math::divideAndRoundUp(m_pos, alignment) * alignment;
+    if (start > m_size || size > m_size - start) {
+      return nullptr;
+    }
+    m_pos = start + size;
+    return m_data + start;
+  }
+
+  bool
+  MemoryRecordReader::seek(SIZE_T pos) {
+    if (pos > m_size) {
+      return false;
+    }
+    m_pos = pos;
+    return true;
+  }
+
+#if USING(GE_REFLECTION)
+  namespace {
+    namespace VALUE_KIND {
+      enum E : uint8 {
+        kNone = 0,
+        kArithmetic,
+        kEnum,
+        kString,
+        kBlock,
+        kArray,
+        kObject
+      };
+    }
+
+    struct RecordHeader
+    {
+      uint32 magic;
+      uint16 version;
+      uint16 flags;
+      uint64 size;
+    };
+
+    struct ArithmeticCodec
+    {
+      rttr::type type;
+      void (*write)(MemoryRecordWriter&, const rttr::variant&);
+      bool (*read)(MemoryRecordReader&, rttr::variant&);
+    };
+
+    /**
+     * Arrays of numbers, written as one block from a Vector or a std::span.
+     */
+    struct BlockCodec
+    {
+      uint8 element;
+      rttr::type vectorType;
+      rttr::type spanType;
+      void (*write)(MemoryRecordWriter&, const rttr::variant&);
+
+      /**
+       * Copies to a Vector or points a std::span to the data, depending on
+       * the type of the value.
+       */
+      bool (*read)(MemoryRecordReader&, rttr::variant&);
+    };
+
+    template<typename T>
+    ArithmeticCodec
+    arithmeticCodec() {
+      return {
+        rttr::type::get<T>(),
+        [](MemoryRecordWriter& writer, const rttr::variant& value) {
+          writer.write(value.get_value<T>());
+        },
+        [](MemoryRecordReader& reader, rttr::variant& value) {
+          T result{};
+          if (!reader.read(result)) {
+            return false;
+          }
+          value = result;
+          return true;
+        }
+      };
+    }
+
+    template<typename T>
+    BlockCodec
+    blockCodec(uint8 element) {
+      return {
+        element,
+        rttr::type::get<Vector<T>>(),
+        rttr::type::get<std::span<const T>>(),
+        [](MemoryRecordWriter& writer, const rttr::variant& value) {
+          if (value.is_type<Vector<T>>()) {
+            const auto& values = value.get_value<Vector<T>>();
+            writer.writeArray(values.data(), cast::st<uint32>(values.size()));
+          }
+          else {
+            const auto& values = value.get_value<std::span<const T>>();
+            writer.writeArray(values.data(), cast::st<uint32>(values.size()));
+          }
+        },
+        [](MemoryRecordReader& reader, rttr::variant& value) {
+          if (value.is_type<Vector<T>>()) {
+            Vector<T> values;
+            if (!reader.readArray(values)) {
+              return false;
+            }
+            value = std::move(values);
+            return true;
+          }
+
+          std::span<const T> values;
+          if (!reader.readArrayInPlace(values)) {
+            return false;
+          }
+          value = values;
+          return true;
+        }
+      };
+    }
+
+    /**
+     * The index of a type in this table is stored in the records, so new
+     * types can only be added at the end.
+     */
+    const Vector<ArithmeticCodec>&
+    getArithmeticCodecs() {
+      static const Vector<ArithmeticCodec> codecs = {
+        arithmeticCodec<bool>(),
+        arithmeticCodec<char>(),
+        arithmeticCodec<int8>(),
+        arithmeticCodec<uint8>(),
+        arithmeticCodec<int16>(),
+        arithmeticCodec<uint16>(),
+        arithmeticCodec<int32>(),
+        arithmeticCodec<uint32>(),
+        arithmeticCodec<int64>(),
+        arithmeticCodec<uint64>(),
+        arithmeticCodec<float>(),
+        arithmeticCodec<double>()
+      };
+      return codecs;
+    }
+
+    /**
+     * Vector<bool> isn't contiguous, so there are no blocks of bools.
+     */
+    const Vector<BlockCodec>&
+    getBlockCodecs() {
+      static const Vector<BlockCodec> codecs = {
+        blockCodec<char>(1),
+        blockCodec<int8>(2),
+        blockCodec<uint8>(3),
+        blockCodec<int16>(4),
+        blockCodec<uint16>(5),
+        blockCodec<int32>(6),
+        blockCodec<uint32>(7),
+        blockCodec<int64>(8),
+        blockCodec<uint64>(9),
+        blockCodec<float>(10),
+        blockCodec<double>(11)
+      };
+      return codecs;
+    }
+
+    uint32
+    findArithmeticCodec(const rttr::type& type) {
+      const auto& codecs = getArithmeticCodecs();
+      for (uint32 i = 0; i < codecs.size(); ++i) {
+        if (codecs[i].type == type) {
+          return i;
+        }
+      }
+      return NumLimit::MAX_UINT32;
+    }
+
+    const BlockCodec*
+    findBlockCodec(const rttr::type& type) {
+      for (const auto& codec : getBlockCodecs()) {
+        if (codec.vectorType == type || codec.spanType == type) {
+          return &codec;
+        }
+      }
+      return nullptr;
+    }
+
+    uint32
+    hashName(rttr::string_view name) {
+      uint32 hash = 2166136261u;
+      for (char c : name) {
+        hash = (hash ^ static_cast<uint8>(c)) * 16777619u;
+      }
+      return hash;
+    }
+
+    String
+    getTypeName(const rttr::type& type) {
+      const rttr::string_view name = type.get_name();
+      return String(name.data(), name.size());
+    }
+
+    rttr::instance
+    unwrap(const rttr::instance& object) {
+      return object.get_type().get_raw_type().is_wrapper() ?
+               object.get_wrapped_instance() : object;
+    }
+
+    void
+    writeValue(MemoryRecordWriter& writer, const rttr::variant& value);
+
+    void
+    writeObject(MemoryRecordWriter& writer, const rttr::instance& wrapped) {
+      const rttr::instance object = unwrap(wrapped);
+      const rttr::type type = object.get_derived_type();
+
+      writer.write(VALUE_KIND::kObject);
+      writer.writeString(getTypeName(type));
+      const SIZE_T numPropertiesOffset = writer.reserve<uint32>();
+
+      uint32 numProperties = 0;
+      for (const auto& prop : type.get_properties()) {
+        if (prop.is_static() || prop.is_readonly()) {
+          continue;
+        }
+
+        const rttr::variant value = prop.get_value(object);
+        if (!value.is_valid()) {
+          continue;
+        }
+
+        writer.write(hashName(prop.get_name()));
+        const SIZE_T sizeOffset = writer.reserve<uint32>();
+        const SIZE_T start = writer.size();
+        writeValue(writer, value);
+        writer.patch(sizeOffset, cast::st<uint32>(writer.size() - start));
+        ++numProperties;
+      }
+
+      writer.patch(numPropertiesOffset, numProperties);
+    }
+
+    void
+    writeValue(MemoryRecordWriter& writer, const rttr::variant& wrapped) {
+      const rttr::variant value = wrapped.get_type().is_wrapper() ?
+                                    wrapped.extract_wrapped_value() : wrapped;
+      const rttr::type type = value.get_type();
+
+      if (type.is_pointer()) {
+        writer.write(VALUE_KIND::kNone);
+        return;
+      }
+
+      if (type.is_arithmetic()) {
+        const uint32 codec = findArithmeticCodec(type);
+        if (NumLimit::MAX_UINT32 != codec) {
+          writer.write(VALUE_KIND::kArithmetic);
+          writer.write(cast::st<uint8>(codec));
+          getArithmeticCodecs()[codec].write(writer, value);
+          return;
+        }
+      }
+      else if (type.is_enumeration()) {
+        bool bOk = false;
+        const int64 number = value.to_int64(&bOk);
+        if (bOk) {
+          writer.write(VALUE_KIND::kEnum);
+          writer.write(number);
+          return;
+        }
+      }
+      else if (rttr::type::get<String>() == type) {
+        writer.write(VALUE_KIND::kString);
+        writer.writeString(value.get_value<String>());
+        return;
+      }
+      else if (const BlockCodec* codec = findBlockCodec(type)) {
+        writer.write(VALUE_KIND::kBlock);
+        writer.write(codec->element);
+        codec->write(writer, value);
+        return;
+      }
+      else if (type.is_sequential_container()) {
+        const rttr::variant_sequential_view view = value.create_sequential_view();
+        writer.write(VALUE_KIND::kArray);
+        writer.write(cast::st<uint32>(view.get_size()));
+        for (const auto& item : view) {
+          writeValue(writer, item);
+        }
+        return;
+      }
+      else if (type.is_class()) {
+        writeObject(writer, value);
+        return;
+      }
+
+      writer.write(VALUE_KIND::kNone);
+    }
+
+    /**
+     * The reads return false when the data is corrupted or doesn't fit the
+     * type of the value, which then keeps what it had.
+     */
+    bool
+    readValue(MemoryRecordReader& reader, rttr::variant& value);
+
+    bool
+    readObject(MemoryRecordReader& reader, const rttr::instance& wrapped) {
+      const rttr::instance object = unwrap(wrapped);
+      const rttr::type type = object.get_derived_type();
+
+      String typeName;
+      uint32 numProperties = 0;
+      if (!reader.readString(typeName) || !reader.read(numProperties)) {
+        return false;
+      }
+      if (getTypeName(type) != typeName) {
+        return false;
+      }
+
+      UnorderedMap<uint32, rttr::property> properties;
+      for (const auto& prop : type.get_properties()) {
+        if (!prop.is_static() && !prop.is_readonly()) {
+          properties.emplace(hashName(prop.get_name()), prop);
+        }
+      }
+
+      for (uint32 i = 0; i < numProperties; ++i) {
+        uint32 nameHash = 0;
+        uint32 size = 0;
+        if (!reader.read(nameHash) || !reader.read(size)) {
+          return false;
+        }
+
+        const SIZE_T end = reader.tell() + size;
+        auto it = properties.find(nameHash);
+        if (it != properties.end()) {
+          rttr::variant value = it->second.get_value(object);
+          if (readValue(reader, value)) {
+            it->second.set_value(object, value);
+          }
+        }
+
+        //Skips what wasn't read, or fails if the size was wrong
+        if (!reader.seek(end)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool
+    readArray(MemoryRecordReader& reader, rttr::variant& value) {
+      uint32 count = 0;
+      if (!reader.read(count)) {
+        return false;
+      }
+
+      //Every element takes at least its kind byte, a bigger count is corrupt
+      if (count > reader.size() - reader.tell()) {
+        return false;
+      }
+
+      rttr::variant_sequential_view view = value.create_sequential_view();
+      if (!view.is_valid() || !view.set_size(count)) {
+        return false;
+      }
+
+      for (uint32 i = 0; i < count; ++i) {
+        rttr::variant item = view.get_value(i).extract_wrapped_value();
+        if (!readValue(reader, item) || !view.set_value(i, item)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool
+    readValue(MemoryRecordReader& reader, rttr::variant& value) {
+      uint8 kind = VALUE_KIND::kNone;
+      if (!reader.read(kind)) {
+        return false;
+      }
+
+      const rttr::type type = value.get_type();
+      switch (kind) {
+        case VALUE_KIND::kArithmetic:
+        {
+          uint8 index = 0;
+          if (!reader.read(index) || index >= getArithmeticCodecs().size()) {
+            return false;
+          }
+
+          rttr::variant result;
+          if (!getArithmeticCodecs()[index].read(reader, result)) {
+            return false;
+          }
+
+          //Numbers stored as another type are converted when they can be
+          if (result.get_type() != type && !result.convert(type)) {
+            return false;
+          }
+          value = result;
+          return true;
+        }
+        case VALUE_KIND::kEnum:
+        {
+          int64 number = 0;
+          if (!reader.read(number) || !type.is_enumeration()) {
+            return false;
+          }
+
+          for (const auto& enumValue : type.get_enumeration().get_values()) {
+            if (enumValue.to_int64() == number) {
+              value = enumValue;
+              return true;
+            }
+          }
+          return false;
+        }
+        case VALUE_KIND::kString:
+        {
+          String text;
+          if (!reader.readString(text) || rttr::type::get<String>() != type) {
+            return false;
+          }
+          value = std::move(text);
+          return true;
+        }
+        case VALUE_KIND::kBlock:
+        {
+          uint8 element = 0;
+          if (!reader.read(element)) {
+            return false;
+          }
+
+          const BlockCodec* codec = findBlockCodec(type);
+          if (nullptr == codec || codec->element != element) {
+            return false;
+          }
+          return codec->read(reader, value);
+        }
+        case VALUE_KIND::kArray:
+          return type.is_sequential_container() && readArray(reader, value);
+        case VALUE_KIND::kObject:
+          return type.is_class() && readObject(reader, value);
+        default:
+          return false;
+      }
+    }
+
+    const uint8*
+    readHeader(const uint8* buffer, SIZE_T bufferSize, SIZE_T& size) {
+      RecordHeader header;
+      if (bufferSize < sizeof(RecordHeader)) {
+        return nullptr;
+      }
+
+      MemoryRecordReader reader(buffer, bufferSize);
+      reader.read(header.magic);
+      reader.read(header.version);
+      reader.read(header.flags);
+      reader.read(header.size);
+      if (MemorySerializer::MAGIC != header.magic ||
+          header.version > MemorySerializer::VERSION ||
+          header.size > bufferSize - sizeof(RecordHeader)) {
+        return nullptr;
+      }
+
+      size = cast::st<SIZE_T>(header.size);
+      return buffer + sizeof(RecordHeader);
+    }
+  }
+
+  uint8*
+  MemorySerializer::encode(const rttr::instance& object,
+                           uint32& bytesWritten,
+                           const function<void*(SIZE_T)>& allocator) {
+    m_writer.clear();
+    m_writer.write(MAGIC);
+    m_writer.write(VERSION);
+    m_writer.write(uint16(0));
+    const SIZE_T sizeOffset = m_writer.reserve<uint64>();
+    GE_ASSERT(sizeof(RecordHeader) == m_writer.size());
+
+    writeObject(m_writer, object);
+    m_writer.patch(sizeOffset, uint64(m_writer.size() - sizeof(RecordHeader)));
+
+    bytesWritten = cast::st<uint32>(m_writer.size());
+    auto buffer = reinterpret_cast<uint8*>(allocator ? allocator(bytesWritten) :
+                                                       ge_alloc(bytesWritten));
+    memcpy(buffer, m_writer.data(), bytesWritten);
+    return buffer;
+  }
+
+  bool
+  MemorySerializer::decode(const uint8* buffer,
+                           SIZE_T bufferSize,
+                           const rttr::instance& object) {
+    //The records are aligned from the start of the buffer, so the reader
+    //starts there too
+    SIZE_T size = 0;
+    if (nullptr == readHeader(buffer, bufferSize, size)) {
+      GE_LOG(kError, Generic, "The data doesn't hold serialized records.");
+      return false;
+    }
+
+    MemoryRecordReader reader(buffer, sizeof(RecordHeader) + size);
+    uint8 kind = VALUE_KIND::kNone;
+    reader.seek(sizeof(RecordHeader));
+    if (!reader.read(kind) || VALUE_KIND::kObject != kind || !readObject(reader, object)) {
+      GE_LOG(kError, Generic, "Failure trying to decode the serialized object.");
+      return false;
+    }
+    return true;
+  }
+
+  rttr::variant
+  MemorySerializer::decode(const uint8* buffer, SIZE_T bufferSize) {
+    SIZE_T size = 0;
+    const uint8* records = readHeader(buffer, bufferSize, size);
+    if (nullptr == records) {
+      GE_LOG(kError, Generic, "The data doesn't hold serialized records.");
+      return rttr::variant();
+    }
+
+    MemoryRecordReader reader(records, size);
+    uint8 kind = VALUE_KIND::kNone;
+    String typeName;
+    if (!reader.read(kind) || VALUE_KIND::kObject != kind || !reader.readString(typeName)) {
+      GE_LOG(kError, Generic, "Failure trying to decode the serialized object.");
+      return rttr::variant();
+    }
+
+    const rttr::type type =
+      rttr::type::get_by_name(rttr::string_view(typeName.data(), typeName.size()));
+    rttr::variant object = type.is_valid() ? type.create() : rttr::variant();
+    if (!object.is_valid()) {
+      GE_LOG(kError, Generic, "Can't create an object of type " + typeName + ".");
+      return rttr::variant();
+    }
+
+    if (!decode(buffer, bufferSize, object)) {
+      return rttr::variant();
+    }
+    return object;
+  }
+#endif
+}
@@ -0,0 +1,533 @@
+/*****************************************************************************/
+/**
+ * @file    geMemoryTracker.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Tracks the live allocations of the engine allocators.
+ *
+ * Tracks the live allocations of the engine allocators.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geMemoryTracker.h"
+#include "geSpinLock.h"
+#include "geDebug.h"
+
+#if USING(GE_PLATFORM_WINDOWS)
+# include "Win32/geMinWindows.h"
+#elif defined(__unix__) || defined(__APPLE__)
+# include <execinfo.h>
+# include <dlfcn.h>
+#endif
+
+namespace geEngineSDK {
+  using std::memory_order_relaxed;
+
+  namespace {
+    /**
+     * Set while the tracker itself runs on the thread, so its own allocations
+     * are not reported back to it.
+     */
+    GE_THREADLOCAL bool t_inTracker = false;
+    GE_THREADLOCAL uint32 t_tag = 0;
+
+    struct TrackerGuard
+    {
+      TrackerGuard() : m_previous(t_inTracker) {
+        t_inTracker = true;
+      }
+
+      ~TrackerGuard() {
+        t_inTracker = m_previous;
+      }
+
+      bool m_previous;
+    };
+
+    struct AtomicStats
+    {
+      atomic<int64> liveBytes{ 0 };
+      atomic<int64> liveAllocs{ 0 };
+      atomic<int64> peakBytes{ 0 };
+      atomic<int64> totalAllocs{ 0 };
+      atomic<int64> totalFrees{ 0 };
+      atomic<int64> totalBytes{ 0 };
+      atomic<int64> frameAllocs{ 0 };
+      atomic<int64> frameFrees{ 0 };
+      atomic<int64> frameBytes{ 0 };
+    };
+
+    void
+    addAlloc(AtomicStats& stats, int64 bytes, bool bLive) {
+      stats.totalAllocs.fetch_add(1, memory_order_relaxed);
+      stats.totalBytes.fetch_add(bytes, memory_order_relaxed);
+      stats.frameAllocs.fetch_add(1, memory_order_relaxed);
+      stats.frameBytes.fetch_add(bytes, memory_order_relaxed);
+      if (!bLive) {
+        return;
+      }
+
+      stats.liveAllocs.fetch_add(1, memory_order_relaxed);
+      const int64 live = stats.liveBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+      int64 peak = stats.peakBytes.load(memory_order_relaxed);
+      while (live > peak &&
+             !stats.peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+    }
+
+    void
+    addFree(AtomicStats& stats, int64 bytes, bool bLive) {
+      stats.totalFrees.fetch_add(1, memory_order_relaxed);
+      stats.frameFrees.fetch_add(1, memory_order_relaxed);
+      if (bLive) {
+        stats.liveAllocs.fetch_sub(1, memory_order_relaxed);
+        stats.liveBytes.fetch_sub(bytes, memory_order_relaxed);
+      }
+    }
+
+    MemoryStats
+    loadStats(const AtomicStats& stats) {
+      MemoryStats out;
+      out.liveBytes = stats.liveBytes.load(memory_order_relaxed);
+      out.liveAllocs = stats.liveAllocs.load(memory_order_relaxed);
+      out.peakBytes = stats.peakBytes.load(memory_order_relaxed);
+      out.totalAllocs = stats.totalAllocs.load(memory_order_relaxed);
+      out.totalFrees = stats.totalFrees.load(memory_order_relaxed);
+      out.totalBytes = stats.totalBytes.load(memory_order_relaxed);
+      return out;
+    }
+
+    MemoryStats
+    subtractStats(const MemoryStats& from, const MemoryStats& to) {
+      MemoryStats out;
+      out.liveBytes = to.liveBytes - from.liveBytes;
+      out.liveAllocs = to.liveAllocs - from.liveAllocs;
+      out.peakBytes = to.peakBytes;
+      out.totalAllocs = to.totalAllocs - from.totalAllocs;
+      out.totalFrees = to.totalFrees - from.totalFrees;
+      out.totalBytes = to.totalBytes - from.totalBytes;
+      return out;
+    }
+
+    uint32
+    captureCallstack(Array<void*, MemoryCallsiteStats::MAX_FRAMES>& frames) {
+#if USING(GE_PLATFORM_WINDOWS)
+      return RtlCaptureStackBackTrace(0, MemoryCallsiteStats::MAX_FRAMES, frames.data(), nullptr);
+#elif defined(__unix__) || defined(__APPLE__)
+      const int32 numFrames = ::backtrace(frames.data(), MemoryCallsiteStats::MAX_FRAMES);
+      return numFrames > 0 ? cast::st<uint32>(numFrames) : 0;
+#else
+      GE_UNREFERENCED_PARAMETER(frames);
+      return 0;
+#endif
+    }
+
+    uint64
+    hashCallstack(const Array<void*, MemoryCallsiteStats::MAX_FRAMES>& frames,
+                  uint32 numFrames) {
+      //FNV-1a over the return addresses
+      uint64 hash = 14695981039346656037ULL;
+      for (uint32 i = 0; i < numFrames; ++i) {
+        hash ^= cast::st<uint64>(reinterpret_cast<uintptr_t>(frames[i]));
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    String
+    describeFrame(void* address) {
+      StringStream stream;
+      stream << address;
+#if !USING(GE_PLATFORM_WINDOWS) && (defined(__unix__) || defined(__APPLE__))
+      Dl_info info{};
+      if (0 != ::dladdr(address, &info)) {
+        if (info.dli_sname) {
+          stream << "  " << info.dli_sname;
+        }
+        if (info.dli_fname) {
+          stream << "  (" << info.dli_fname << ")";
+        }
+      }
+#endif
+      return stream.str();
+    }
+  }
+
+  struct MemoryTracker::Impl
+  {
+    static CONSTEXPR uint32 NUM_SHARDS = 64;
+
+    struct AllocRecord
+    {
+      SIZE_T bytes;
+      uint64 callsite;
+      uint32 tag;
+    };
+
+    template<class K, class V>
+    using TrackerMap = UnorderedMap<K,
+                                    V,
+                                    std::hash<K>,
+                                    std::equal_to<K>,
+                                    StdAlloc<std::pair<const K, V>, ProfilerAlloc>>;
+
+    /**
+     * The live allocations, split by address so the threads rarely wait on
+     * each other.
+     */
+    struct Shard
+    {
+      SpinLock lock;
+      TrackerMap<void*, AllocRecord> records;
+    };
+
+    struct Callsite
+    {
+      uint32 tag = 0;
+      uint32 numFrames = 0;
+      Array<void*, MemoryCallsiteStats::MAX_FRAMES> frames{};
+      MemoryStats stats;
+    };
+
+    Shard&
+    getShard(void* ptr) {
+      const uint64 key = cast::st<uint64>(reinterpret_cast<uintptr_t>(ptr)) >> 4;
+      return shards[(key * 0x9E3779B97F4A7C15ULL) >> 58];
+    }
+
+    bool captureCallsites = false;
+
+    Array<Shard, NUM_SHARDS> shards;
+    Array<AtomicStats, MEMORY_SOURCE::kCount> sources;
+    Array<AtomicStats, MAX_TAGS> tags;
+
+    //Names are published before the count that makes them visible
+    Array<atomic<const char*>, MAX_TAGS> tagNames{};
+    atomic<uint32> numTags{ 1 };
+    Mutex tagMutex;
+
+    mutable Mutex frameMutex;
+    uint64 frame = 0;
+    Array<MemoryFrameStats, MAX_TAGS> lastFrame{};
+
+    mutable Mutex callsiteMutex;
+    TrackerMap<uint64, Callsite> callsites;
+  };
+
+  void
+  MemoryCounter::trackAlloc(void* ptr, size_t bytes, MEMORY_SOURCE::E source) {
+    if (t_inTracker || !MemoryTracker::isStarted()) {
+      return;
+    }
+    MemoryTracker::instance().recordAlloc(ptr, bytes, source);
+  }
+
+  void
+  MemoryCounter::trackFree(void* ptr, MEMORY_SOURCE::E source) {
+    if (t_inTracker || !MemoryTracker::isStarted()) {
+      return;
+    }
+    MemoryTracker::instance().recordFree(ptr, source);
+  }
+
+  MemoryTracker::MemoryTracker(bool captureCallsites) {
+    TrackerGuard guard;
+    m_impl = ge_new<Impl, ProfilerAlloc>();
+    m_impl->captureCallsites = captureCallsites;
+    m_impl->tagNames[0].store("Untagged");
+  }
+
+  MemoryTracker::~MemoryTracker() {
+    TrackerGuard guard;
+    ge_delete<Impl, ProfilerAlloc>(m_impl);
+  }
+
+  void
+  MemoryTracker::onShutDown() {
+    const MemorySnapshot current = snapshot();
+
+    int64 liveAllocs = 0;
+    for (const auto& source : current.sources) {
+      liveAllocs += source.liveAllocs;
+    }
+
+    if (0 < liveAllocs) {
+      GE_LOG(kWarning,
+             Generic,
+             "Memory still allocated at shut down:\n" + getLeakReport());
+    }
+  }
+
+  void
+  MemoryTracker::recordAlloc(void* ptr, SIZE_T bytes, MEMORY_SOURCE::E source) {
+    TrackerGuard guard;
+
+    //Frame allocations are released in bulk, so they are never live
+    const bool bLive = MEMORY_SOURCE::kFrame != source && nullptr != ptr;
+    const uint32 tag = t_tag;
+    const auto size = cast::st<int64>(bytes);
+
+    addAlloc(m_impl->sources[source], size, bLive);
+    addAlloc(m_impl->tags[tag], size, bLive);
+
+    uint64 callsite = 0;
+    if (m_impl->captureCallsites) {
+      Impl::Callsite site;
+      site.numFrames = captureCallstack(site.frames);
+      callsite = hashCallstack(site.frames, site.numFrames);
+
+      Lock lock(m_impl->callsiteMutex);
+      auto it = m_impl->callsites.try_emplace(callsite, site).first;
+      auto& stats = it->second.stats;
+      it->second.tag = tag;
+      stats.totalAllocs += 1;
+      stats.totalBytes += size;
+      if (bLive) {
+        stats.liveAllocs += 1;
+        stats.liveBytes += size;
+        stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+      }
+    }
+
+    if (!bLive) {
+      return;
+    }
+
+    Impl::Shard& shard = m_impl->getShard(ptr);
+    ScopedSpinLock lock(shard.lock);
+    shard.records[ptr] = { bytes, callsite, tag };
+  }
+
+  void
+  MemoryTracker::recordFree(void* ptr, MEMORY_SOURCE::E source) {
+    if (nullptr == ptr) {
+      return;
+    }
+
+    TrackerGuard guard;
+
+    if (MEMORY_SOURCE::kFrame == source) {
+      addFree(m_impl->sources[source], 0, false);
+      addFree(m_impl->tags[t_tag], 0, false);
+      return;
+    }
+
+    Impl::AllocRecord record;
+    {
+      Impl::Shard& shard = m_impl->getShard(ptr);
+      ScopedSpinLock lock(shard.lock);
+      auto it = shard.records.find(ptr);
+      if (shard.records.end() == it) {
+        return;
+      }
+      record = it->second;
+      shard.records.erase(it);
+    }
+
+    //Counted against the tag and call site that allocated it
+    const auto size = cast::st<int64>(record.bytes);
+    addFree(m_impl->sources[source], size, true);
+    addFree(m_impl->tags[record.tag], size, true);
+
+    if (0 != record.callsite) {
+      Lock lock(m_impl->callsiteMutex);
+      auto it = m_impl->callsites.find(record.callsite);
+      if (m_impl->callsites.end() != it) {
+        it->second.stats.totalFrees += 1;
+        it->second.stats.liveAllocs -= 1;
+        it->second.stats.liveBytes -= size;
+      }
+    }
+  }
+
+  void
+  MemoryTracker::endFrame() {
+    TrackerGuard guard;
+    Lock lock(m_impl->frameMutex);
+
+    const uint32 numTags = m_impl->numTags.load(std::memory_order_acquire);
+    for (uint32 i = 0; i < numTags; ++i) {
+      AtomicStats& stats = m_impl->tags[i];
+      m_impl->lastFrame[i].allocs = stats.frameAllocs.exchange(0, memory_order_relaxed);
+      m_impl->lastFrame[i].frees = stats.frameFrees.exchange(0, memory_order_relaxed);
+      m_impl->lastFrame[i].bytes = stats.frameBytes.exchange(0, memory_order_relaxed);
+    }
+    for (auto& stats : m_impl->sources) {
+      stats.frameAllocs.store(0, memory_order_relaxed);
+      stats.frameFrees.store(0, memory_order_relaxed);
+      stats.frameBytes.store(0, memory_order_relaxed);
+    }
+    ++m_impl->frame;
+  }
+
+  uint32
+  MemoryTracker::getTagIndex(const char* name) {
+    //Scopes reuse the same literal, most lookups end here
+    uint32 numTags = m_impl->numTags.load(std::memory_order_acquire);
+    for (uint32 i = 0; i < numTags; ++i) {
+      if (m_impl->tagNames[i].load(memory_order_relaxed) == name) {
+        return i;
+      }
+    }
+
+    TrackerGuard guard;
+    Lock lock(m_impl->tagMutex);
+    numTags = m_impl->numTags.load(memory_order_relaxed);
+    for (uint32 i = 0; i < numTags; ++i) {
+      if (0 == strcmp(m_impl->tagNames[i].load(memory_order_relaxed), name)) {
+        return i;
+      }
+    }
+
+    if (MAX_TAGS == numTags) {
+      GE_LOG(kWarning, Generic, "Too many memory tags, counting as untagged: " + String(name));
+      return 0;
+    }
+
+    m_impl->tagNames[numTags].store(name, memory_order_relaxed);
+    m_impl->numTags.store(numTags + 1, std::memory_order_release);
+    return numTags;
+  }
+
+  uint32
+  MemoryTracker::getThreadTag() {
+    return t_tag;
+  }
+
+  void
+  MemoryTracker::setThreadTag(uint32 tag) {
+    GE_ASSERT(tag < MAX_TAGS);
+    t_tag = tag;
+  }
+
+  MemorySnapshot
+  MemoryTracker::snapshot() const {
+    TrackerGuard guard;
+
+    MemorySnapshot out;
+    for (uint32 i = 0; i < MEMORY_SOURCE::kCount; ++i) {
+      out.sources[i] = loadStats(m_impl->sources[i]);
+    }
+
+    {
+      Lock lock(m_impl->frameMutex);
+      out.frame = m_impl->frame;
+
+      const uint32 numTags = m_impl->numTags.load(std::memory_order_acquire);
+      out.tags.resize(numTags);
+      for (uint32 i = 0; i < numTags; ++i) {
+        out.tags[i].name = m_impl->tagNames[i].load(memory_order_relaxed);
+        out.tags[i].stats = loadStats(m_impl->tags[i]);
+        out.tags[i].lastFrame = m_impl->lastFrame[i];
+      }
+    }
+
+    Lock lock(m_impl->callsiteMutex);
+    out.callsites.reserve(m_impl->callsites.size());
+    for (const auto& pair : m_impl->callsites) {
+      MemoryCallsiteStats site;
+      site.hash = pair.first;
+      site.tag = pair.second.tag;
+      site.numFrames = pair.second.numFrames;
+      site.frames = pair.second.frames;
+      site.stats = pair.second.stats;
+      out.callsites.push_back(site);
+    }
+    return out;
+  }
+
+  MemorySnapshot
+  MemoryTracker::diff(const MemorySnapshot& from, const MemorySnapshot& to) {
+    TrackerGuard guard;
+
+    MemorySnapshot out = to;
+    for (uint32 i = 0; i < MEMORY_SOURCE::kCount; ++i) {
+      out.sources[i] = subtractStats(from.sources[i], to.sources[i]);
+    }
+
+    //Tags are only added, the old ones keep their index
+    for (SIZE_T i = 0; i < from.tags.size() && i < out.tags.size(); ++i) {
+      out.tags[i].stats = subtractStats(from.tags[i].stats, to.tags[i].stats);
+    }
+
+    UnorderedMap<uint64, const MemoryStats*> previous;
+    for (const auto& site : from.callsites) {
+      previous[site.hash] = &site.stats;
+    }
+
+    for (auto& site : out.callsites) {
+      auto it = previous.find(site.hash);
+      if (previous.end() != it) {
+        site.stats = subtractStats(*it->second, site.stats);
+      }
+    }
+
+    out.callsites.erase(std::remove_if(out.callsites.begin(),
+                                       out.callsites.end(),
+                                       [](const MemoryCallsiteStats& site) {
+                                         return 0 == site.stats.totalAllocs &&
+                                                0 == site.stats.totalFrees;
+                                       }),
+                        out.callsites.end());
+
+    std::sort(out.callsites.begin(),
+              out.callsites.end(),
+              [](const MemoryCallsiteStats& a, const MemoryCallsiteStats& b) {
+                return a.stats.totalAllocs > b.stats.totalAllocs;
+              });
+    return out;
+  }
+
+  String
+  MemoryTracker::getLeakReport(uint32 maxCallsites) const {
+    MemorySnapshot current = snapshot();
+
+    TrackerGuard guard;
+    StringStream stream;
+    for (const auto& tag : current.tags) {
+      if (0 < tag.stats.liveAllocs) {
+        stream << "  " << tag.name << ": " << tag.stats.liveBytes << " bytes in "
+               << tag.stats.liveAllocs << " allocations\n";
+      }
+    }
+
+    std::sort(current.callsites.begin(),
+              current.callsites.end(),
+              [](const MemoryCallsiteStats& a, const MemoryCallsiteStats& b) {
+                return a.stats.liveBytes > b.stats.liveBytes;
+              });
+
+    uint32 numReported = 0;
+    for (const auto& site : current.callsites) {
+      if (numReported == maxCallsites || 0 >= site.stats.liveAllocs) {
+        break;
+      }
+      ++numReported;
+
+      stream << "  " << site.stats.liveBytes << " bytes in " << site.stats.liveAllocs
+             << " allocations (" << current.tags[site.tag].name << ") from:\n";
+      for (uint32 i = 0; i < site.numFrames; ++i) {
+        stream << "    " << describeFrame(site.frames[i]) << "\n";
+      }
+    }
+
+    return stream.str();
+  }
+
+  MemoryTagScope::MemoryTagScope(const char* name)
+    : m_previousTag(MemoryTracker::getThreadTag()) {
+    if (MemoryTracker::isStarted()) {
+      MemoryTracker::setThreadTag(MemoryTracker::instance().getTagIndex(name));
+    }
+  }
+
+  MemoryTagScope::~MemoryTagScope() {
+    MemoryTracker::setThreadTag(m_previousTag);
+  }
+}
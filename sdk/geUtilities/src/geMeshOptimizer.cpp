@@ -0,0 +1,458 @@
+/*****************************************************************************/
+/**
+ * @file    geMeshOptimizer.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Reorders indexed triangle meshes for the GPU.
+ *
+ * Welds duplicated vertices and reorders the triangles and vertices of
+ * indexed triangle lists for the post-transform vertex cache, overdraw and
+ * vertex fetch. Meant to run when meshes are imported, not per frame.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geMeshOptimizer.h"
+#include "geNumericLimits.h"
+#include "geVector3.h"
+
+namespace geEngineSDK {
+  namespace {
+    CONSTEXPR uint32 INVALID_INDEX = NumLimit::MAX_UINT32;
+
+    uint32
+    hashVertex(const uint8* data, uint32 size) {
+      //FNV-1a, four bytes per step when the vertex allows it
+      uint32 hash = 2166136261u;
+      uint32 i = 0;
+      for (; i + 4 <= size; i += 4) {
+        uint32 block;
+        std::memcpy(&block, data + i, sizeof(block));
+        hash = (hash ^ block) * 16777619u;
+      }
+      for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+      }
+      return hash ^ (hash >> 15);
+    }
+
+    /**
+     * @brief Triangles that use each vertex, as a compressed list.
+     */
+    struct TriangleAdjacency
+    {
+      Vector<uint32> offsets;
+      Vector<uint32> triangles;
+
+      TriangleAdjacency(const Vector<uint32>& indices, uint32 vertexCount)
+        : offsets(vertexCount + 1, 0),
+          triangles(indices.size()) {
+        for (auto index : indices) {
+          ++offsets[index + 1];
+        }
+        for (uint32 v = 0; v < vertexCount; ++v) {
+          offsets[v + 1] += offsets[v];
+        }
+
+        Vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (SIZE_T i = 0; i < indices.size(); ++i) {
+          triangles[fill[indices[i]]++] = cast::st<uint32>(i / 3);
+        }
+      }
+
+      uint32
+      count(uint32 vertex) const {
+        return offsets[vertex + 1] - offsets[vertex];
+      }
+    };
+
+    /**
+     * @brief Adds a triangle to a FIFO cache simulated with time stamps: a
+     *        vertex is on the cache if it was added less than cacheSize
+     *        misses ago.
+     * @return The number of misses.
+     */
+    FORCEINLINE uint32
+    updateCache(const uint32* triangle,
+                uint32 cacheSize,
+                Vector<uint32>& timeStamps,
+                uint32& time) {
+      uint32 misses = 0;
+      for (uint32 j = 0; j < 3; ++j) {
+        const uint32 vertex = triangle[j];
+        if (time - timeStamps[vertex] > cacheSize) {
+          timeStamps[vertex] = time++;
+          ++misses;
+        }
+      }
+      return misses;
+    }
+
+    /**
+     * @brief Tipsify. Fans around a vertex at a time, and picks as the next
+     *        one the vertex of the last triangles that will still be on the
+     *        cache after its remaining triangles are emitted.
+     */
+    Vector<uint32>
+    tipsify(const Vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize) {
+      const uint32 triangleCount = cast::st<uint32>(indices.size() / 3);
+      const TriangleAdjacency adjacency(indices, vertexCount);
+
+      Vector<uint32> liveTriangles(vertexCount);
+      for (uint32 v = 0; v < vertexCount; ++v) {
+        liveTriangles[v] = adjacency.count(v);
+      }
+
+      Vector<uint32> timeStamps(vertexCount, 0);
+      Vector<uint8> emitted(triangleCount, 0);
+      Vector<uint32> deadEnds;
+      Vector<uint32> candidates;
+      deadEnds.reserve(indices.size());
+
+      Vector<uint32> output;
+      output.reserve(indices.size());
+
+      //Starts past the cache size so no vertex is on the cache at first
+      uint32 time = cacheSize + 1;
+      uint32 cursor = 0;
+      uint32 fanning = 0;
+
+      while (INVALID_INDEX != fanning) {
+        candidates.clear();
+        const uint32 end = adjacency.offsets[fanning + 1];
+        for (uint32 a = adjacency.offsets[fanning]; a < end; ++a) {
+          const uint32 triangle = adjacency.triangles[a];
+          if (emitted[triangle]) {
+            continue;
+          }
+          emitted[triangle] = 1;
+
+          for (uint32 j = 0; j < 3; ++j) {
+            const uint32 vertex = indices[triangle * 3 + j];
+            output.push_back(vertex);
+            deadEnds.push_back(vertex);
+            candidates.push_back(vertex);
+            --liveTriangles[vertex];
+
+            if (time - timeStamps[vertex] > cacheSize) {
+              timeStamps[vertex] = time++;
+            }
+          }
+        }
+
+        //Best candidate: the oldest vertex on the cache that will still be
+        //there after emitting all of its triangles
+        uint32 next = INVALID_INDEX;
+        int32 bestPriority = -1;
+        for (auto vertex : candidates) {
+          if (0 == liveTriangles[vertex]) {
+            continue;
+          }
+
+          int32 priority = 0;
+          const uint32 age = time - timeStamps[vertex];
+          if (age + 2 * liveTriangles[vertex] <= cacheSize) {
+            priority = cast::st<int32>(age);
+          }
+
+          if (priority > bestPriority) {
+            bestPriority = priority;
+            next = vertex;
+          }
+        }
+
+        if (INVALID_INDEX == next) {
+          //Dead end, go back to a recently used vertex, or the next one in
+          //input order that still has triangles
+          while (!deadEnds.empty() && INVALID_INDEX == next) {
+            const uint32 vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[vertex] > 0) {
+              next = vertex;
+            }
+          }
+
+          while (cursor < vertexCount && INVALID_INDEX == next) {
+            if (liveTriangles[cursor] > 0) {
+              next = cursor;
+            }
+            ++cursor;
+          }
+        }
+
+        fanning = next;
+      }
+
+      return output;
+    }
+  }
+
+  uint32
+  MeshOptimizer::weldVertices(Vector<uint8>& vertices,
+                              uint32 vertexSize,
+                              Vector<uint32>& indices) {
+    GE_ASSERT(vertexSize > 0 && vertices.size() % vertexSize == 0);
+
+    const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+    if (0 == vertexCount) {
+      return 0;
+    }
+
+    //Open addressing table at most half full, with the index of the first
+    //vertex seen with each value
+    uint32 tableSize = 1;
+    while (tableSize < vertexCount * 2) {
+      tableSize <<= 1;
+    }
+    const uint32 tableMask = tableSize - 1;
+    Vector<uint32> table(tableSize, INVALID_INDEX);
+
+    Vector<uint32> remap(vertexCount);
+    uint32 uniqueCount = 0;
+    for (uint32 v = 0; v < vertexCount; ++v) {
+      const uint8* vertex = &vertices[SIZE_T(v) * vertexSize];
+
+      uint32 slot = hashVertex(vertex, vertexSize) & tableMask;
+      for (uint32 probe = 1; ; ++probe) {
+        const uint32 entry = table[slot];
+        if (INVALID_INDEX == entry) {
+          //New value, it moves down to its final position right away
+          table[slot] = uniqueCount;
+          if (uniqueCount != v) {
+            std::memcpy(&vertices[SIZE_T(uniqueCount) * vertexSize], vertex, vertexSize);
+          }
+          remap[v] = uniqueCount++;
+          break;
+        }
+
+        if (0 == std::memcmp(&vertices[SIZE_T(entry) * vertexSize], vertex, vertexSize)) {
+          remap[v] = entry;
+          break;
+        }
+
+        slot = (slot + probe) & tableMask;
+      }
+    }
+
+    for (auto& index : indices) {
+      index = remap[index];
+    }
+
+    vertices.resize(SIZE_T(uniqueCount) * vertexSize);
+    return uniqueCount;
+  }
+
+  void
+  MeshOptimizer::optimizeVertexCache(Vector<uint32>& indices,
+                                     uint32 vertexCount,
+                                     uint32 cacheSize) {
+    GE_ASSERT(indices.size() % 3 == 0);
+    if (indices.empty()) {
+      return;
+    }
+
+    indices = tipsify(indices, vertexCount, cacheSize);
+  }
+
+  void
+  MeshOptimizer::optimizeOverdraw(Vector<uint32>& indices,
+                                  const Vector<uint8>& vertices,
+                                  uint32 vertexSize,
+                                  uint32 positionOffset,
+                                  float threshold,
+                                  uint32 cacheSize) {
+    GE_ASSERT(indices.size() % 3 == 0);
+    GE_ASSERT(positionOffset + sizeof(Vector3) <= vertexSize);
+
+    const uint32 triangleCount = cast::st<uint32>(indices.size() / 3);
+    const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+    if (triangleCount < 2) {
+      return;
+    }
+
+    //Hard boundaries: triangles where the cache starts over with three misses
+    Vector<uint32> timeStamps(vertexCount, 0);
+    uint32 time = cacheSize + 1;
+    Vector<uint32> hardClusters;
+    for (uint32 t = 0; t < triangleCount; ++t) {
+      const uint32 misses = updateCache(&indices[t * 3], cacheSize, timeStamps, time);
+      if (0 == t || 3 == misses) {
+        hardClusters.push_back(t);
+      }
+    }
+
+    //Soft boundaries: split each hard cluster every time the miss ratio of
+    //the current piece gets within the threshold of the whole cluster one
+    Vector<uint32> clusters;
+    for (SIZE_T c = 0; c < hardClusters.size(); ++c) {
+      const uint32 start = hardClusters[c];
+      const uint32 end = c + 1 < hardClusters.size() ? hardClusters[c + 1] : triangleCount;
+
+      time += cacheSize + 1;
+      uint32 clusterMisses = 0;
+      for (uint32 t = start; t < end; ++t) {
+        clusterMisses += updateCache(&indices[t * 3], cacheSize, timeStamps, time);
+      }
+      const float clusterThreshold = threshold * clusterMisses / (end - start);
+
+      clusters.push_back(start);
+      time += cacheSize + 1;
+      uint32 runningMisses = 0;
+      uint32 runningTriangles = 0;
+      for (uint32 t = start; t < end; ++t) {
+        runningMisses += updateCache(&indices[t * 3], cacheSize, timeStamps, time);
+        ++runningTriangles;
+
+        if (t + 1 < end &&
+            cast::st<float>(runningMisses) / runningTriangles <= clusterThreshold) {
+          clusters.push_back(t + 1);
+          time += cacheSize + 1;
+          runningMisses = 0;
+          runningTriangles = 0;
+        }
+      }
+    }
+
+    auto getPosition = [&](uint32 vertex) {
+      Vector3 position;
+      std::memcpy(&position,
+                  &vertices[SIZE_T(vertex) * vertexSize + positionOffset],
+                  sizeof(Vector3));
+      return position;
+    };
+
+    Vector3 meshCentroid(0.0f, 0.0f, 0.0f);
+    for (auto index : indices) {
+      meshCentroid += getPosition(index);
+    }
+    meshCentroid /= cast::st<float>(indices.size());
+
+    //Clusters whose area weighted normal points away from the center are on
+    //the outside of the mesh, so they should be drawn first
+    const uint32 clusterCount = cast::st<uint32>(clusters.size());
+    Vector<float> sortKeys(clusterCount);
+    for (uint32 c = 0; c < clusterCount; ++c) {
+      const uint32 start = clusters[c];
+      const uint32 end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+
+      Vector3 centroid(0.0f, 0.0f, 0.0f);
+      Vector3 normal(0.0f, 0.0f, 0.0f);
+      float area = 0.0f;
+      for (uint32 t = start; t < end; ++t) {
+        const Vector3 p0 = getPosition(indices[t * 3 + 0]);
+        const Vector3 p1 = getPosition(indices[t * 3 + 1]);
+        const Vector3 p2 = getPosition(indices[t * 3 + 2]);
+
+        const Vector3 triangleNormal = (p1 - p0) ^ (p2 - p0);
+        const float triangleArea = triangleNormal.size();
+
+        centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+        normal += triangleNormal;
+        area += triangleArea;
+      }
+
+      if (area > 0.0f) {
+        centroid /= area;
+      }
+
+      const float normalLength = normal.size();
+      sortKeys[c] = normalLength > 0.0f ?
+                      ((centroid - meshCentroid) | normal) / normalLength : 0.0f;
+    }
+
+    Vector<uint32> order(clusterCount);
+    for (uint32 c = 0; c < clusterCount; ++c) {
+      order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32 lhs, uint32 rhs) {
+      return sortKeys[lhs] > sortKeys[rhs];
+    });
+
+    Vector<uint32> output;
+    output.reserve(indices.size());
+    for (auto c : order) {
+      const uint32 start = clusters[c];
+      const uint32 end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+      output.insert(output.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+    }
+
+    indices = std::move(output);
+  }
+
+  uint32
+  MeshOptimizer::optimizeVertexFetch(Vector<uint8>& vertices,
+                                     uint32 vertexSize,
+                                     Vector<uint32>& indices) {
+    GE_ASSERT(vertexSize > 0 && vertices.size() % vertexSize == 0);
+
+    const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+    Vector<uint32> remap(vertexCount, INVALID_INDEX);
+    Vector<uint8> output(vertices.size());
+
+    uint32 newCount = 0;
+    for (auto& index : indices) {
+      uint32& newIndex = remap[index];
+      if (INVALID_INDEX == newIndex) {
+        std::memcpy(&output[SIZE_T(newCount) * vertexSize],
+                    &vertices[SIZE_T(index) * vertexSize],
+                    vertexSize);
+        newIndex = newCount++;
+      }
+      index = newIndex;
+    }
+
+    output.resize(SIZE_T(newCount) * vertexSize);
+    vertices = std::move(output);
+    return newCount;
+  }
+
+  VertexCacheStatistics
+  MeshOptimizer::analyzeVertexCache(const Vector<uint32>& indices,
+                                    uint32 vertexCount,
+                                    uint32 cacheSize) {
+    GE_ASSERT(indices.size() % 3 == 0);
+
+    VertexCacheStatistics stats;
+    if (indices.empty()) {
+      return stats;
+    }
+
+    Vector<uint32> timeStamps(vertexCount, 0);
+    Vector<uint8> referenced(vertexCount, 0);
+    uint32 time = cacheSize + 1;
+    uint32 uniqueVertices = 0;
+    for (SIZE_T i = 0; i < indices.size(); i += 3) {
+      stats.vertexTransforms += updateCache(&indices[i], cacheSize, timeStamps, time);
+
+      for (SIZE_T j = i; j < i + 3; ++j) {
+        if (!referenced[indices[j]]) {
+          referenced[indices[j]] = 1;
+          ++uniqueVertices;
+        }
+      }
+    }
+
+    stats.acmr = cast::st<float>(stats.vertexTransforms) / (indices.size() / 3);
+    stats.atvr = cast::st<float>(stats.vertexTransforms) / uniqueVertices;
+    return stats;
+  }
+
+  uint32
+  MeshOptimizer::optimize(Vector<uint8>& vertices,
+                          uint32 vertexSize,
+                          uint32 positionOffset,
+                          Vector<uint32>& indices) {
+    const uint32 vertexCount = weldVertices(vertices, vertexSize, indices);
+    optimizeVertexCache(indices, vertexCount);
+    if (INVALID_INDEX != positionOffset) {
+      optimizeOverdraw(indices, vertices, vertexSize, positionOffset);
+    }
+    return optimizeVertexFetch(vertices, vertexSize, indices);
+  }
+}
@@ -0,0 +1,461 @@
+/*****************************************************************************/
+/**
+ * @file    geMeshSimplifier.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Quadric error mesh simplification for LOD generation.
+ *
+ * Reduces the triangle count of indexed triangle lists by collapsing edges
+ * in the order of their quadric error. The simplified index buffers keep
+ * using the original vertices, so all the LODs of a mesh can share them.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geMeshSimplifier.h"
+#include "geMeshOptimizer.h"
+
+namespace geEngineSDK {
+  namespace {
+    CONSTEXPR uint32 INVALID_INDEX = NumLimit::MAX_UINT32;
+
+    /**
+     * Sum of the squared distances to a set of planes, weighted by their
+     * area, stored as the symmetric matrix [A b; b c].
+     */
+    struct Quadric
+    {
+      double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+      double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+      double c = 0.0;
+      double weight = 0.0;
+
+      void
+      addPlane(const Vector3& normal, float distance, float planeWeight) {
+        const double nx = normal.x, ny = normal.y, nz = normal.z;
+        const double d = distance;
+        const double w = planeWeight;
+
+        a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz;
+        a11 += w * ny * ny; a12 += w * ny * nz; a22 += w * nz * nz;
+        b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+        c += w * d * d;
+        weight += w;
+      }
+
+      Quadric&
+      operator+=(const Quadric& other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02;
+        a11 += other.a11; a12 += other.a12; a22 += other.a22;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+        return *this;
+      }
+
+      double
+      evaluate(const Vector3& p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return a00 * x * x + a11 * y * y + a22 * z * z +
+               2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+               2.0 * (b0 * x + b1 * y + b2 * z) + c;
+      }
+    };
+
+    struct Collapse
+    {
+      uint32 from;
+      uint32 to;
+      double cost;
+    };
+
+    FORCEINLINE uint64
+    edgeKey(uint32 a, uint32 b) {
+      return (cast::st<uint64>(a) << 32) | b;
+    }
+  }
+
+  Vector<uint32>
+  MeshSimplifier::simplify(const Vector<uint32>& indices,
+                           const Vector<uint8>& vertices,
+                           uint32 vertexSize,
+                           uint32 positionOffset,
+                           const Vector<SimplifyAttribute>& attributes,
+                           uint32 targetIndexCount,
+                           float maxError,
+                           float* outError) {
+    GE_ASSERT(indices.size() % 3 == 0);
+    GE_ASSERT(positionOffset + sizeof(Vector3) <= vertexSize);
+
+    Vector<uint32> result = indices;
+    if (nullptr != outError) {
+      *outError = 0.0f;
+    }
+
+    const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+    const SIZE_T targetIndices = SIZE_T(targetIndexCount / 3) * 3;
+    if (result.size() <= targetIndices || 0 == vertexCount) {
+      return result;
+    }
+
+    Vector<Vector3> positions(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v) {
+      std::memcpy(&positions[v],
+                  &vertices[SIZE_T(v) * vertexSize + positionOffset],
+                  sizeof(Vector3));
+    }
+
+    Vector3 minPosition = positions[0];
+    Vector3 maxPosition = positions[0];
+    for (const auto& position : positions) {
+      for (uint32 axis = 0; axis < 3; ++axis) {
+        minPosition[axis] = Math::min(minPosition[axis], position[axis]);
+        maxPosition[axis] = Math::max(maxPosition[axis], position[axis]);
+      }
+    }
+
+    const Vector3 size = maxPosition - minPosition;
+    const double extent = Math::max(size.x, size.y, size.z);
+    if (extent <= 0.0) {
+      return result;
+    }
+
+    //Vertices with the same position (attribute seams) map to the first one
+    Vector<uint32> positionRemap(vertexCount);
+    Vector<uint32> wedgeCount(vertexCount, 0);
+    {
+      Vector<uint32> order(vertexCount);
+      for (uint32 v = 0; v < vertexCount; ++v) {
+        order[v] = v;
+      }
+      std::sort(order.begin(), order.end(), [&](uint32 lhs, uint32 rhs) {
+        const int32 cmp = std::memcmp(&positions[lhs], &positions[rhs], sizeof(Vector3));
+        return cmp < 0 || (0 == cmp && lhs < rhs);
+      });
+
+      for (uint32 i = 0; i < vertexCount; ++i) {
+        const uint32 v = order[i];
+        const bool bSameAsPrevious = i > 0 &&
+          0 == std::memcmp(&positions[v], &positions[order[i - 1]], sizeof(Vector3));
+        positionRemap[v] = bSameAsPrevious ? positionRemap[order[i - 1]] : v;
+        ++wedgeCount[positionRemap[v]];
+      }
+    }
+
+    //An edge that isn't matched by exactly one edge going the other way is
+    //on an open border or non manifold, its vertices stay where they are
+    Vector<uint8> locked(vertexCount, 0);
+    {
+      UnorderedMap<uint64, uint32> directedEdges;
+      directedEdges.reserve(result.size());
+      for (SIZE_T i = 0; i < result.size(); i += 3) {
+        for (uint32 e = 0; e < 3; ++e) {
+          const uint32 a = positionRemap[result[i + e]];
+          const uint32 b = positionRemap[result[i + (e + 1) % 3]];
+          if (a != b) {
+            ++directedEdges[edgeKey(a, b)];
+          }
+        }
+      }
+
+      for (const auto& edge : directedEdges) {
+        const uint32 a = cast::st<uint32>(edge.first >> 32);
+        const uint32 b = cast::st<uint32>(edge.first & 0xFFFFFFFFu);
+        const auto reverse = directedEdges.find(edgeKey(b, a));
+        if (1 != edge.second || directedEdges.end() == reverse || 1 != reverse->second) {
+          locked[a] = 1;
+          locked[b] = 1;
+        }
+      }
+
+      for (uint32 v = 0; v < vertexCount; ++v) {
+        if (locked[positionRemap[v]] || wedgeCount[positionRemap[v]] > 1) {
+          locked[v] = 1;
+        }
+      }
+    }
+
+    //Quadrics of the planes around each position
+    Vector<Quadric> quadrics(vertexCount);
+    for (SIZE_T i = 0; i < result.size(); i += 3) {
+      const Vector3& p0 = positions[result[i + 0]];
+      const Vector3& p1 = positions[result[i + 1]];
+      const Vector3& p2 = positions[result[i + 2]];
+
+      Vector3 normal = (p1 - p0) ^ (p2 - p0);
+      const float doubleArea = normal.size();
+      if (doubleArea <= 0.0f) {
+        continue;
+      }
+      normal /= doubleArea;
+
+      Quadric quadric;
+      quadric.addPlane(normal, -(normal | p0), doubleArea * 0.5f);
+      for (uint32 e = 0; e < 3; ++e) {
+        quadrics[positionRemap[result[i + e]]] += quadric;
+      }
+    }
+
+    const double extentSquared = extent * extent;
+    auto attributeCost = [&](uint32 a, uint32 b) {
+      double cost = 0.0;
+      for (const auto& attribute : attributes) {
+        for (uint32 c = 0; c < attribute.components; ++c) {
+          float valueA, valueB;
+          const SIZE_T offset = attribute.offset + c * sizeof(float);
+          std::memcpy(&valueA, &vertices[SIZE_T(a) * vertexSize + offset], sizeof(float));
+          std::memcpy(&valueB, &vertices[SIZE_T(b) * vertexSize + offset], sizeof(float));
+          const double delta = valueA - valueB;
+          cost += attribute.weight * delta * delta;
+        }
+      }
+      return cost * extentSquared;
+    };
+
+    const double maxCost = maxError < NumLimit::MAX_FLOAT ?
+                             cast::st<double>(maxError) * maxError :
+                             cast::st<double>(NumLimit::POS_INFINITY);
+    double worstCost = 0.0;
+
+    Vector<uint32> triangleOffsets;
+    Vector<uint32> vertexTriangles;
+    Vector<Collapse> bestCollapses;
+    Vector<Collapse> collapses;
+    Vector<uint32> collapseTarget(vertexCount);
+    Vector<uint8> touched(vertexCount);
+
+    while (result.size() > targetIndices) {
+      const uint32 triangleCount = cast::st<uint32>(result.size() / 3);
+
+      //Triangles around each vertex
+      triangleOffsets.assign(vertexCount + 1, 0);
+      for (auto index : result) {
+        ++triangleOffsets[index + 1];
+      }
+      for (uint32 v = 0; v < vertexCount; ++v) {
+        triangleOffsets[v + 1] += triangleOffsets[v];
+      }
+      vertexTriangles.resize(result.size());
+      {
+        Vector<uint32> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (SIZE_T i = 0; i < result.size(); ++i) {
+          vertexTriangles[cursor[result[i]]++] = cast::st<uint32>(i / 3);
+        }
+      }
+
+      //Moving a vertex must not flip or squash the triangles that remain
+      auto isCollapseValid = [&](uint32 from, uint32 to) {
+        const Vector3& target = positions[to];
+        for (uint32 i = triangleOffsets[from]; i < triangleOffsets[from + 1]; ++i) {
+          const uint32* triangle = &result[SIZE_T(vertexTriangles[i]) * 3];
+          if (positionRemap[triangle[0]] == positionRemap[to] ||
+              positionRemap[triangle[1]] == positionRemap[to] ||
+              positionRemap[triangle[2]] == positionRemap[to]) {
+            continue;
+          }
+
+          Vector3 before[3], after[3];
+          for (uint32 e = 0; e < 3; ++e) {
+            before[e] = positions[triangle[e]];
+            after[e] = triangle[e] == from ? target : before[e];
+          }
+
+          const Vector3 normalBefore = (before[1] - before[0]) ^ (before[2] - before[0]);
+          const Vector3 normalAfter = (after[1] - after[0]) ^ (after[2] - after[0]);
+          if ((normalBefore | normalAfter) <= 0.0f) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+      //The cheapest valid collapse of each vertex
+      bestCollapses.assign(vertexCount, Collapse{ INVALID_INDEX, INVALID_INDEX, 0.0 });
+      for (SIZE_T i = 0; i < result.size(); i += 3) {
+        for (uint32 e = 0; e < 3; ++e) {
+          const uint32 from = result[i + e];
+          if (locked[from]) {
+            continue;
+          }
+
+          for (uint32 o = 1; o < 3; ++o) {
+            const uint32 to = result[i + (e + o) % 3];
+            Quadric merged = quadrics[from];
+            merged += quadrics[positionRemap[to]];
+
+            const double cost = Math::max(merged.evaluate(positions[to]), 0.0) /
+                                  Math::max(merged.weight, 1e-20) +
+                                attributeCost(from, to);
+
+            Collapse& best = bestCollapses[from];
+            if ((INVALID_INDEX == best.to || cost < best.cost) && isCollapseValid(from, to)) {
+              best = Collapse{ from, to, cost };
+            }
+          }
+        }
+      }
+
+      collapses.clear();
+      for (const auto& collapse : bestCollapses) {
+        if (INVALID_INDEX != collapse.to) {
+          collapses.push_back(collapse);
+        }
+      }
+      if (collapses.empty()) {
+        break;
+      }
+      std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+        return lhs.cost < rhs.cost;
+      });
+
+      //Each collapse removes about two triangles. The pass doesn't go past
+      //half again the ones needed, so the cheap collapses it opens up get
+      //picked before the expensive ones that are left
+      const uint32 targetTriangles = cast::st<uint32>(targetIndices / 3);
+      const SIZE_T goal = (triangleCount - targetTriangles + 1) / 2;
+      const double passLimit = collapses[Math::min(collapses.size() - 1, goal + goal / 2)].cost;
+
+      for (uint32 v = 0; v < vertexCount; ++v) {
+        collapseTarget[v] = v;
+      }
+      touched.assign(vertexCount, 0);
+
+      uint32 remaining = triangleCount;
+      uint32 collapsed = 0;
+      bool bReachedMaxError = false;
+      for (const auto& collapse : collapses) {
+        if (remaining <= targetTriangles || collapse.cost > passLimit) {
+          break;
+        }
+        if (collapse.cost > maxCost) {
+          bReachedMaxError = true;
+          break;
+        }
+        if (touched[collapse.from] || touched[collapse.to]) {
+          continue;
+        }
+
+        const uint32 toPosition = positionRemap[collapse.to];
+        for (uint32 i = triangleOffsets[collapse.from];
+             i < triangleOffsets[collapse.from + 1];
+             ++i) {
+          const uint32* triangle = &result[SIZE_T(vertexTriangles[i]) * 3];
+          bool bRemoved = false;
+          for (uint32 e = 0; e < 3; ++e) {
+            touched[triangle[e]] = 1;
+            bRemoved |= positionRemap[triangle[e]] == toPosition;
+          }
+          remaining -= bRemoved ? 1 : 0;
+        }
+
+        collapseTarget[collapse.from] = collapse.to;
+        quadrics[toPosition] += quadrics[collapse.from];
+        worstCost = Math::max(worstCost, collapse.cost);
+        ++collapsed;
+      }
+
+      if (0 == collapsed) {
+        break;
+      }
+
+      SIZE_T write = 0;
+      for (SIZE_T i = 0; i < result.size(); i += 3) {
+        const uint32 a = collapseTarget[result[i + 0]];
+        const uint32 b = collapseTarget[result[i + 1]];
+        const uint32 c = collapseTarget[result[i + 2]];
+        if (positionRemap[a] == positionRemap[b] ||
+            positionRemap[b] == positionRemap[c] ||
+            positionRemap[a] == positionRemap[c]) {
+          continue;
+        }
+        result[write + 0] = a;
+        result[write + 1] = b;
+        result[write + 2] = c;
+        write += 3;
+      }
+      result.resize(write);
+
+      if (bReachedMaxError) {
+        break;
+      }
+    }
+
+    if (nullptr != outError) {
+      *outError = cast::st<float>(std::sqrt(worstCost));
+    }
+    return result;
+  }
+
+  Vector<SimplifiedLod>
+  MeshSimplifier::generateLods(const Vector<uint32>& indices,
+                               const Vector<uint8>& vertices,
+                               uint32 vertexSize,
+                               uint32 positionOffset,
+                               const Vector<SimplifyAttribute>& attributes,
+                               uint32 lodCount,
+                               float reduction) {
+    GE_ASSERT(reduction > 0.0f && reduction < 1.0f);
+
+    const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+    Vector<SimplifiedLod> lods;
+    SIZE_T previousCount = indices.size();
+    float ratio = 1.0f;
+    for (uint32 lod = 0; lod < lodCount; ++lod) {
+      ratio *= reduction;
+      const uint32 target = cast::st<uint32>(indices.size() / 3 * ratio) * 3;
+
+      SimplifiedLod simplified;
+      simplified.indices = simplify(indices,
+                                    vertices,
+                                    vertexSize,
+                                    positionOffset,
+                                    attributes,
+                                    target,
+                                    NumLimit::MAX_FLOAT,
+                                    &simplified.error);
+
+      //Mostly locked meshes stop reducing, more levels would be copies
+      if (simplified.indices.empty() || simplified.indices.size() * 10 >= previousCount * 9) {
+        break;
+      }
+
+      previousCount = simplified.indices.size();
+      MeshOptimizer::optimizeVertexCache(simplified.indices, vertexCount);
+      lods.push_back(std::move(simplified));
+    }
+
+    return lods;
+  }
+
+  void
+  MeshSimplifier::extractPositions(const Vector<uint32>& indices,
+                                   const Vector<uint8>& vertices,
+                                   uint32 vertexSize,
+                                   uint32 positionOffset,
+                                   Vector<Vector3>& outPositions,
+                                   Vector<uint32>& outIndices) {
+    outPositions.clear();
+    outIndices.clear();
+    outIndices.reserve(indices.size());
+
+    Vector<uint32> remap(vertices.size() / vertexSize, INVALID_INDEX);
+    for (uint32 index : indices) {
+      if (INVALID_INDEX == remap[index]) {
+        remap[index] = cast::st<uint32>(outPositions.size());
+
+        Vector3 position;
+        memcpy(&position.x,
+               &vertices[SIZE_T(index) * vertexSize + positionOffset],
+               sizeof(float) * 3);
+        outPositions.push_back(position);
+      }
+      outIndices.push_back(remap[index]);
+    }
+  }
+}
@@ -0,0 +1,472 @@
+/*****************************************************************************/
+/**
+ * @file    geMipMapGenerator.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Generates mip map chains for images on the CPU.
+ *
+ * Generates mip map chains for images on the CPU, filtering in linear space
+ * so sRGB images don't get darker on the lower levels.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geMipMapGenerator.h"
+#include "geTaskScheduler.h"
+#include "geMath.h"
+
+namespace geEngineSDK {
+  namespace {
+    /**
+     * @brief Width of the Kaiser filter, in destination pixels, on each side.
+     */
+    CONSTEXPR float KAISER_WIDTH = 3.0f;
+    CONSTEXPR float KAISER_ALPHA = 4.0f;
+
+    /**
+     * @brief Minimum number of destination pixels worth giving to a task.
+     */
+    CONSTEXPR uint32 MIN_PIXELS_PER_TASK = 64 * 1024;
+
+    CONSTEXPR uint32 NUM_CHANNELS = 4;
+
+    /**
+     * @brief Lookup tables to move 8 bit channels in and out of linear space.
+     *        The encoding table is indexed with the linear value scaled to
+     *        16 bits, which is precise enough for the darkest sRGB steps.
+     */
+    struct ColorTables
+    {
+      ColorTables() {
+        for (uint32 i = 0; i < 256; ++i) {
+          const float v = static_cast<float>(i) / 255.0f;
+          sRGBToLinear[i] = v <= 0.04045f ? v / 12.92f :
+                                            std::pow((v + 0.055f) / 1.055f, 2.4f);
+          unormToFloat[i] = v;
+        }
+
+        linearToSRGB.resize(65536);
+        for (uint32 i = 0; i < 65536; ++i) {
+          const double lin = static_cast<double>(i) / 65535.0;
+          const double srgb = lin <= 0.0031308 ? lin * 12.92 :
+                                                 1.055 * std::pow(lin, 1.0 / 2.4) - 0.055;
+          linearToSRGB[i] = static_cast<uint8>(srgb * 255.0 + 0.5);
+        }
+      }
+
+      float sRGBToLinear[256];
+      float unormToFloat[256];
+      Vector<uint8> linearToSRGB;
+    };
+
+    const ColorTables&
+    getColorTables() {
+      static const ColorTables s_tables;
+      return s_tables;
+    }
+
+    FORCEINLINE float
+    saturate(float v) {
+      return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    }
+
+    float
+    besselI0(float x) {
+      //Power series, converges quickly for the alphas used here
+      const float halfX = x * 0.5f;
+      float sum = 1.0f;
+      float term = 1.0f;
+      for (uint32 k = 1; k < 64; ++k) {
+        const float f = halfX / static_cast<float>(k);
+        term *= f * f;
+        sum += term;
+        if (term < sum * 1e-8f) {
+          break;
+        }
+      }
+      return sum;
+    }
+
+    float
+    kaiserSinc(float t) {
+      const float x = t / KAISER_WIDTH;
+      if (Math::abs(x) >= 1.0f) {
+        return 0.0f;
+      }
+
+      const float window = besselI0(KAISER_ALPHA * std::sqrt(1.0f - x * x)) /
+                           besselI0(KAISER_ALPHA);
+      if (Math::abs(t) < 1e-6f) {
+        return window;
+      }
+
+      const float piT = Math::PI * t;
+      return window * std::sin(piT) / piT;
+    }
+
+    /**
+     * @brief Precomputed weights to resample one axis. Destination pixel i
+     *        reads count[i] consecutive source pixels starting at first[i],
+     *        with the weights at weights[i * stride].
+     */
+    struct AxisTaps
+    {
+      uint32 stride = 0;
+      Vector<uint32> first;
+      Vector<uint32> count;
+      Vector<float> weights;
+    };
+
+    AxisTaps
+    buildTaps(uint32 srcSize, uint32 dstSize, MIP_FILTER::E filter) {
+      AxisTaps taps;
+      taps.first.resize(dstSize);
+      taps.count.resize(dstSize);
+
+      //An axis that doesn't shrink is copied as is
+      if (srcSize == dstSize) {
+        taps.stride = 1;
+        taps.weights.assign(dstSize, 1.0f);
+        for (uint32 i = 0; i < dstSize; ++i) {
+          taps.first[i] = i;
+          taps.count[i] = 1;
+        }
+        return taps;
+      }
+
+      const float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+      const float radius = MIP_FILTER::kKaiser == filter ? KAISER_WIDTH * scale :
+                                                           scale * 0.5f;
+      taps.stride = static_cast<uint32>(Math::ceil(radius * 2.0f)) + 2;
+      taps.weights.assign(static_cast<SIZE_T>(dstSize) * taps.stride, 0.0f);
+
+      const int32 lastSrc = static_cast<int32>(srcSize) - 1;
+      for (uint32 i = 0; i < dstSize; ++i) {
+        const float center = (static_cast<float>(i) + 0.5f) * scale;
+        const int32 lo = static_cast<int32>(Math::floor(center - radius));
+        const int32 hi = static_cast<int32>(Math::ceil(center + radius));
+        const int32 first = Math::clamp(lo, 0, lastSrc);
+        const int32 last = Math::clamp(hi, 0, lastSrc);
+
+        float* weights = &taps.weights[static_cast<SIZE_T>(i) * taps.stride];
+        float sum = 0.0f;
+        for (int32 s = lo; s <= hi; ++s) {
+          float w;
+          if (MIP_FILTER::kKaiser == filter) {
+            w = kaiserSinc((static_cast<float>(s) + 0.5f - center) / scale);
+          }
+          else {
+            //Overlap of the source pixel with the destination footprint
+            const float begin = std::max(static_cast<float>(s), center - radius);
+            const float end = std::min(static_cast<float>(s + 1), center + radius);
+            w = std::max(end - begin, 0.0f);
+          }
+
+          //Samples outside of the image are clamped to the edge
+          weights[Math::clamp(s, 0, lastSrc) - first] += w;
+          sum += w;
+        }
+
+        if (sum != 0.0f) {
+          const float invSum = 1.0f / sum;
+          for (int32 k = 0; k <= last - first; ++k) {
+            weights[k] *= invSum;
+          }
+        }
+
+        taps.first[i] = static_cast<uint32>(first);
+        taps.count[i] = static_cast<uint32>(last - first + 1);
+      }
+
+      return taps;
+    }
+
+    /**
+     * @brief Returns a row of the source level as linear float RGBA. May use
+     *        the scratch buffer (srcWidth pixels) to convert it.
+     */
+    using RowFetcher = function<const float*(uint32 row, float* scratch)>;
+
+    /**
+     * @brief Resamples a whole level. Each task walks its destination rows
+     *        keeping the horizontally filtered source rows in a ring, so
+     *        every source row is filtered once per task.
+     */
+    void
+    resampleLevel(uint32 srcWidth,
+                  uint32 srcHeight,
+                  uint32 dstWidth,
+                  uint32 dstHeight,
+                  const RowFetcher& fetchRow,
+                  float* dst,
+                  MIP_FILTER::E filter,
+                  bool bParallel) {
+      const AxisTaps tapsX = buildTaps(srcWidth, dstWidth, filter);
+      const AxisTaps tapsY = buildTaps(srcHeight, dstHeight, filter);
+      const SIZE_T dstRowSize = static_cast<SIZE_T>(dstWidth) * NUM_CHANNELS;
+
+      //The ring of filtered rows starts empty on every chunk, so each worker
+      //gets a single contiguous chunk
+      const uint32 numWorkers = TaskScheduler::isStarted() ?
+                                  TaskScheduler::instance().getNumWorkers() : 1;
+      const uint32 rowsPerChunk = std::max(MIN_PIXELS_PER_TASK / dstWidth,
+                                           (dstHeight + numWorkers - 1) / numWorkers);
+      auto resampleRows = [&](uint32 begin, uint32 end) {
+        const uint32 ringSize = tapsY.stride;
+        Vector<float> ring(ringSize * dstRowSize);
+        Vector<int32> ringRows(ringSize, -1);
+        Vector<float> scratch(static_cast<SIZE_T>(srcWidth) * NUM_CHANNELS);
+
+        for (uint32 y = begin; y < end; ++y) {
+          float* out = dst + y * dstRowSize;
+          std::fill(out, out + dstRowSize, 0.0f);
+
+          const uint32 firstRow = tapsY.first[y];
+          const float* weightsY = &tapsY.weights[static_cast<SIZE_T>(y) * tapsY.stride];
+          for (uint32 k = 0; k < tapsY.count[y]; ++k) {
+            const uint32 srcRow = firstRow + k;
+            const uint32 slot = srcRow % ringSize;
+            float* filtered = &ring[slot * dstRowSize];
+
+            if (ringRows[slot] != static_cast<int32>(srcRow)) {
+              const float* src = fetchRow(srcRow, scratch.data());
+              for (uint32 x = 0; x < dstWidth; ++x) {
+                const float* weightsX = &tapsX.weights[static_cast<SIZE_T>(x) * tapsX.stride];
+                const float* srcPx = src + static_cast<SIZE_T>(tapsX.first[x]) * NUM_CHANNELS;
+                float acc[NUM_CHANNELS] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (uint32 t = 0; t < tapsX.count[x]; ++t) {
+                  const float w = weightsX[t];
+                  acc[0] += w * srcPx[0];
+                  acc[1] += w * srcPx[1];
+                  acc[2] += w * srcPx[2];
+                  acc[3] += w * srcPx[3];
+                  srcPx += NUM_CHANNELS;
+                }
+                float* outPx = filtered + x * NUM_CHANNELS;
+                outPx[0] = acc[0];
+                outPx[1] = acc[1];
+                outPx[2] = acc[2];
+                outPx[3] = acc[3];
+              }
+              ringRows[slot] = static_cast<int32>(srcRow);
+            }
+
+            const float w = weightsY[k];
+            for (SIZE_T i = 0; i < dstRowSize; ++i) {
+              out[i] += w * filtered[i];
+            }
+          }
+        }
+      };
+
+      parallelForChunks("MipMapGenerator", dstHeight, rowsPerChunk, resampleRows, bParallel);
+    }
+
+    /**
+     * @brief Stores a linear float level on the output chain, undoing the
+     *        alpha weighting and encoding it as RGBA8 or RGBA32F.
+     */
+    void
+    storeLevel(const float* level,
+               uint32 width,
+               uint32 height,
+               bool bFloatOutput,
+               const MipMapOptions& options,
+               uint8* dst) {
+      const ColorTables& tables = getColorTables();
+      const uint32 minRows = std::max(MIN_PIXELS_PER_TASK / width, 1u);
+
+      auto storeRows = [&](uint32 begin, uint32 end) {
+        for (uint32 y = begin; y < end; ++y) {
+          for (uint32 x = 0; x < width; ++x) {
+            const SIZE_T px = (static_cast<SIZE_T>(y) * width + x) * NUM_CHANNELS;
+            float r = level[px + 0];
+            float g = level[px + 1];
+            float b = level[px + 2];
+            const float a = bFloatOutput ? std::max(level[px + 3], 0.0f) :
+                                           saturate(level[px + 3]);
+
+            if (options.bAlphaWeighted) {
+              const float invAlpha = a > 0.0f ? 1.0f / a : 0.0f;
+              r *= invAlpha;
+              g *= invAlpha;
+              b *= invAlpha;
+            }
+
+            if (bFloatOutput) {
+              float* out = reinterpret_cast<float*>(dst) + px;
+              out[0] = std::max(r, 0.0f);
+              out[1] = std::max(g, 0.0f);
+              out[2] = std::max(b, 0.0f);
+              out[3] = a;
+            }
+            else {
+              uint8* out = dst + px;
+              if (options.bSRGB) {
+                out[0] = tables.linearToSRGB[static_cast<uint32>(saturate(r) * 65535.0f + 0.5f)];
+                out[1] = tables.linearToSRGB[static_cast<uint32>(saturate(g) * 65535.0f + 0.5f)];
+                out[2] = tables.linearToSRGB[static_cast<uint32>(saturate(b) * 65535.0f + 0.5f)];
+              }
+              else {
+                out[0] = static_cast<uint8>(saturate(r) * 255.0f + 0.5f);
+                out[1] = static_cast<uint8>(saturate(g) * 255.0f + 0.5f);
+                out[2] = static_cast<uint8>(saturate(b) * 255.0f + 0.5f);
+              }
+              out[3] = static_cast<uint8>(a * 255.0f + 0.5f);
+            }
+          }
+        }
+      };
+
+      parallelForChunks("MipMapGenerator", height, minRows, storeRows, options.bParallel);
+    }
+
+    /**
+     * @brief Builds the chain. fetchSourceRow converts the rows of level 0,
+     *        every other level is read from the float buffer of the previous.
+     */
+    MipChain
+    generateChain(const void* pixels,
+                  uint32 width,
+                  uint32 height,
+                  uint32 bytesPerPixel,
+                  const RowFetcher& fetchSourceRow,
+                  const MipMapOptions& options) {
+      MipChain chain;
+      if (nullptr == pixels || 0 == width || 0 == height) {
+        return chain;
+      }
+
+      uint32 numLevels = MipMapGenerator::calcMipCount(width, height);
+      if (options.maxLevels > 0) {
+        numLevels = std::min(numLevels, options.maxLevels);
+      }
+
+      SIZE_T totalSize = 0;
+      chain.levels.resize(numLevels);
+      for (uint32 i = 0; i < numLevels; ++i) {
+        MipLevel& level = chain.levels[i];
+        level.width = std::max(width >> i, 1u);
+        level.height = std::max(height >> i, 1u);
+        level.rowPitch = level.width * bytesPerPixel;
+        level.offset = totalSize;
+        totalSize += static_cast<SIZE_T>(level.rowPitch) * level.height;
+      }
+
+      chain.data.resize(totalSize);
+      memcpy(chain.data.data(), pixels, static_cast<SIZE_T>(chain.levels[0].rowPitch) * height);
+
+      const bool bFloatOutput = bytesPerPixel == NUM_CHANNELS * sizeof(float);
+      Vector<float> prevLevel;
+      Vector<float> curLevel;
+      for (uint32 i = 1; i < numLevels; ++i) {
+        const MipLevel& src = chain.levels[i - 1];
+        const MipLevel& dst = chain.levels[i];
+        curLevel.resize(static_cast<SIZE_T>(dst.width) * dst.height * NUM_CHANNELS);
+
+        const float* prevData = prevLevel.data();
+        const SIZE_T prevRowSize = static_cast<SIZE_T>(src.width) * NUM_CHANNELS;
+        RowFetcher fetchPrevRow = [prevData, prevRowSize](uint32 row, float*) {
+          return prevData + row * prevRowSize;
+        };
+
+        resampleLevel(src.width,
+                      src.height,
+                      dst.width,
+                      dst.height,
+                      1 == i ? fetchSourceRow : fetchPrevRow,
+                      curLevel.data(),
+                      options.filter,
+                      options.bParallel);
+
+        storeLevel(curLevel.data(),
+                   dst.width,
+                   dst.height,
+                   bFloatOutput,
+                   options,
+                   chain.data.data() + dst.offset);
+
+        prevLevel.swap(curLevel);
+      }
+
+      return chain;
+    }
+  }
+
+  uint32
+  MipMapGenerator::calcMipCount(uint32 width, uint32 height) {
+    uint32 size = std::max(width, height);
+    uint32 count = 1;
+    while (size > 1) {
+      size >>= 1;
+      ++count;
+    }
+    return count;
+  }
+
+  MipChain
+  MipMapGenerator::generateRGBA8(const uint8* pixels,
+                                 uint32 width,
+                                 uint32 height,
+                                 const MipMapOptions& options) {
+    const ColorTables& tables = getColorTables();
+    const float* toLinear = options.bSRGB ? tables.sRGBToLinear : tables.unormToFloat;
+    const bool bAlphaWeighted = options.bAlphaWeighted;
+    const SIZE_T rowSize = static_cast<SIZE_T>(width) * NUM_CHANNELS;
+
+    RowFetcher fetchSourceRow = [&](uint32 row, float* scratch) {
+      const uint8* src = pixels + row * rowSize;
+      for (uint32 x = 0; x < width; ++x, src += NUM_CHANNELS) {
+        const float a = tables.unormToFloat[src[3]];
+        const float weight = bAlphaWeighted ? a : 1.0f;
+        float* out = scratch + x * NUM_CHANNELS;
+        out[0] = toLinear[src[0]] * weight;
+        out[1] = toLinear[src[1]] * weight;
+        out[2] = toLinear[src[2]] * weight;
+        out[3] = a;
+      }
+      return const_cast<const float*>(scratch);
+    };
+
+    return generateChain(pixels, width, height, NUM_CHANNELS, fetchSourceRow, options);
+  }
+
+  MipChain
+  MipMapGenerator::generateRGBA32F(const float* pixels,
+                                   uint32 width,
+                                   uint32 height,
+                                   const MipMapOptions& options) {
+    const bool bAlphaWeighted = options.bAlphaWeighted;
+    const SIZE_T rowSize = static_cast<SIZE_T>(width) * NUM_CHANNELS;
+
+    RowFetcher fetchSourceRow = [&](uint32 row, float* scratch) {
+      const float* src = pixels + row * rowSize;
+      if (!bAlphaWeighted) {
+        return src;
+      }
+
+      for (uint32 x = 0; x < width; ++x, src += NUM_CHANNELS) {
+        const float a = std::max(src[3], 0.0f);
+        float* out = scratch + x * NUM_CHANNELS;
+        out[0] = src[0] * a;
+        out[1] = src[1] * a;
+        out[2] = src[2] * a;
+        out[3] = a;
+      }
+      return const_cast<const float*>(scratch);
+    };
+
+    return generateChain(pixels,
+                         width,
+                         height,
+                         NUM_CHANNELS * sizeof(float),
+                         fetchSourceRow,
+                         options);
+  }
+}
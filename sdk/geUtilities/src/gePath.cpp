@@ -24,6 +24,17 @@
 #include "geUnicode.h"
 
 namespace geEngineSDK {
+  namespace {
+    /**
+     * @brief ASCII only lower case, it matches tolower() on the "C" locale
+     *        and inlines on the comparison and hash loops.
+     */
+    FORCEINLINE ANSICHAR
+    toLowerPathChar(ANSICHAR ch) {
+      return ('A' <= ch && 'Z' >= ch) ? static_cast<ANSICHAR>(ch + ('a' - 'A')) : ch;
+    }
+  }
+
   const Path Path::BLANK = Path();
 
   Path::Path(const ANSICHAR* pathStr, PATH_TYPE::E type) {
@@ -34,13 +45,8 @@ namespace geEngineSDK {
     assign(pathStr, type);
   }
 
-  Path::Path(const Path& other) {
-    assign(other);
-  }
-
-  Path& Path::operator=(const Path& path) {
-    assign(path);
-    return *this;
+  Path::Path(StringView pathStr, PATH_TYPE::E type) {
+    assign(pathStr, type);
   }
 
   Path& Path::operator=(const String& pathStr) {
@@ -55,50 +61,46 @@ namespace geEngineSDK {
 
   void
   Path::swap(Path& path) _NOEXCEPT {
-    std::swap(m_directories, path.m_directories);
-    std::swap(m_filename, path.m_filename);
-    std::swap(m_device, path.m_device);
-    std::swap(m_node, path.m_node);
+    std::swap(m_buffer, path.m_buffer);
+    std::swap(m_directoryEnds, path.m_directoryEnds);
+    std::swap(m_nodeLength, path.m_nodeLength);
+    std::swap(m_deviceLength, path.m_deviceLength);
     std::swap(m_isAbsolute, path.m_isAbsolute);
   }
 
   void
   Path::assign(const Path& path) {
-    m_directories = path.m_directories;
-    m_filename = path.m_filename;
-    m_device = path.m_device;
-    m_node = path.m_node;
-    m_isAbsolute = path.m_isAbsolute;
+    *this = path;
   }
 
   void
   Path::assign(const ANSICHAR* pathStr, PATH_TYPE::E type) {
-    assign(pathStr, strlen(pathStr), type);
+    assign(StringView(pathStr), type);
   }
 
   void
   Path::assign(const String& pathStr, PATH_TYPE::E type) {
-    assign(pathStr.data(), pathStr.length(), type);
+    assign(StringView(pathStr), type);
   }
 
   void
-  Path::assign(const ANSICHAR* pathStr, SIZE_T numChars, PATH_TYPE::E type) {
+  Path::assign(StringView pathStr, PATH_TYPE::E type) {
     switch (type)
     {
       case PATH_TYPE::kWindows:
-        parseWindows(pathStr, numChars);
+        parseWindows(pathStr.data(), pathStr.size());
         break;
       case PATH_TYPE::kUnix:
-        parseUnix(pathStr, numChars);
+        parseUnix(pathStr.data(), pathStr.size());
         break;
       case PATH_TYPE::kDefault:
       default:
 #if USING(GE_PLATFORM_WINDOWS)
-        parseWindows(pathStr, numChars);
+        parseWindows(pathStr.data(), pathStr.size());
 #elif USING(GE_PLATFORM_OSX) || USING(GE_PLATFORM_LINUX) || \
       USING(GE_PLATFORM_PS4) || USING(GE_PLATFORM_PS5)
         //TODO: Test parsing with PS4
-        parseUnix(pathStr, numChars);
+        parseUnix(pathStr.data(), pathStr.size());
 #else
         static_assert(false, "Unsupported platform for path.");
 #endif
@@ -106,6 +108,126 @@ namespace geEngineSDK {
     }
   }
 
+  void
+  Path::parseWindows(const ANSICHAR* pathStr, SIZE_T numChars) {
+    clear();
+
+    SIZE_T idx = 0;
+
+    if (idx < numChars) {
+      if ('\\' == pathStr[idx] || '/' == pathStr[idx]) {
+        m_isAbsolute = true;
+        ++idx;
+      }
+    }
+
+    if (idx < numChars) { //Path starts with a node, a drive letter or is relative
+      if (m_isAbsolute && ('\\' == pathStr[idx] || '/' == pathStr[idx])) {//Node
+        ++idx;
+        const SIZE_T start = idx;
+        while (idx < numChars && '\\' != pathStr[idx] && '/' != pathStr[idx]) {
+          ++idx;
+        }
+
+        setNode(StringView(pathStr + start, idx - start));
+
+        if (idx < numChars) {
+          ++idx;
+        }
+      }
+      else {  //A drive letter or not absolute
+        ANSICHAR drive = pathStr[idx];
+        ++idx;
+
+        if (idx < numChars && ':' == pathStr[idx]) {
+          if (m_isAbsolute 
+              || !(('a' <= drive && 'z' >= drive) 
+              || ('A' <= drive && 'Z' >= drive))) {
+            //The drive letter is not valid
+            throwInvalidPathException(pathStr, numChars);
+          }
+
+          m_isAbsolute = true;
+          setDevice(StringView(&drive, 1));
+
+          ++idx;
+          if (idx >= numChars || ('\\' != pathStr[idx] && '/' != pathStr[idx])) {
+            //The path does not end with a trailing slash
+            throwInvalidPathException(pathStr, numChars);
+          }
+
+          ++idx;
+        }
+        else {
+          --idx;
+        }
+      }
+
+      while (idx < numChars) {
+        const SIZE_T start = idx;
+        while (idx < numChars && '\\' != pathStr[idx] && '/' != pathStr[idx]) {
+          ++idx;
+        }
+
+        if (idx < numChars) {
+          pushDirectory(StringView(pathStr + start, idx - start));
+        }
+        else {
+          setFilename(StringView(pathStr + start, idx - start));
+        }
+
+        ++idx;
+      }
+    }
+  }
+
+  void
+  Path::parseUnix(const ANSICHAR* pathStr, SIZE_T numChars) {
+    clear();
+
+    SIZE_T idx = 0;
+
+    if (idx < numChars) {
+      if (pathStr[idx] == '/') {
+        m_isAbsolute = true;
+        ++idx;
+      }
+      else if (pathStr[idx] == '~') {
+        ++idx;
+        if (idx >= numChars || '/' == pathStr[idx]) {
+          pushDirectory("~");
+          m_isAbsolute = true;
+        }
+        else {
+          --idx;
+        }
+      }
+
+      while (idx < numChars) {
+        const SIZE_T start = idx;
+        while (idx < numChars && '/' != pathStr[idx]) {
+          ++idx;
+        }
+
+        const StringView element(pathStr + start, idx - start);
+        if (idx < numChars) {
+          if (m_directoryEnds.empty() && !element.empty() && ':' == element.back()) {
+            setDevice(element.substr(0, element.size() - 1));
+            m_isAbsolute = true;
+          }
+          else {
+            pushDirectory(element);
+          }
+        }
+        else {
+          setFilename(element);
+        }
+
+        ++idx;
+      }
+    }
+  }
+
 #if USING(GE_PLATFORM_WINDOWS)
   WString
   Path::toPlatformString() const {
@@ -158,29 +280,30 @@ namespace geEngineSDK {
   Path
   Path::getDirectory() const {
     Path copy = *this;
-    copy.m_filename.clear();
+    copy.setFilename(StringView());
     return copy;
   }
 
   Path&
   Path::makeParent() {
-    if (m_filename.empty()) {
-      if (m_directories.empty()) {
+    if (isDirectory()) {
+      if (m_directoryEnds.empty()) {
         if (!m_isAbsolute) {
-          m_directories.emplace_back("..");
+          pushDirectory("..");
         }
       }
       else {
-        if (".." == m_directories.back()) {
-          m_directories.emplace_back("..");
+        const SIZE_T lastIdx = m_directoryEnds.size() - 1;
+        if (".." == getDirectory(lastIdx)) {
+          pushDirectory("..");
         }
         else {
-          m_directories.pop_back();
+          popDirectory();
         }
       }
     }
     else {
-      m_filename.clear();
+      setFilename(StringView());
     }
 
     return *this;
@@ -194,82 +317,90 @@ namespace geEngineSDK {
 
     Path absDir = base.getDirectory();
     if (base.isFile()) {
-      absDir.pushDirectory(base.m_filename);
+      absDir.pushDirectory(base.getFilename());
     }
 
-    for (auto& dir : m_directories) {
-      absDir.pushDirectory(dir);
+    for (SIZE_T i = 0; i < m_directoryEnds.size(); ++i) {
+      absDir.pushDirectory(getDirectory(i));
     }
 
-    absDir.setFilename(m_filename);
-    *this = absDir;
+    absDir.setFilename(getFilename());
+    *this = std::move(absDir);
     return *this;
   }
 
   Path&
   Path::makeRelative(const Path& base) {
-    const SIZE_T n = base.m_directories.size();
-    if (n > m_directories.size()) {
+    const uint32 n = static_cast<uint32>(base.m_directoryEnds.size());
+    if (n > m_directoryEnds.size()) {
       return *this;
     }
 
-    using Diff = decltype(m_directories)::difference_type;
-    m_directories.erase(m_directories.begin(), m_directories.begin() + static_cast<Diff>(n));
-
     /**
      * Sometimes a directory name can be interpreted as a file and we're okay with that.
      * Check for that special case.
      */
+    uint32 numToErase = n;
     if (base.isFile()) {
-      if (!m_directories.empty()) {
-        m_directories.erase(m_directories.begin());
+      if (m_directoryEnds.size() > n) {
+        ++numToErase;
       }
       else {
-        m_filename = "";
+        setFilename(StringView());
       }
     }
 
-    m_device = "";
-    m_node = "";
+    //Node, device and the first directories are all at the start of the buffer
+    const uint32 eraseEnd = 0 < numToErase ? m_directoryEnds[numToErase - 1] :
+                                             getDirectoriesStart();
+    replaceText(0, eraseEnd, StringView());
+
+    const uint32 numDirectories = m_directoryEnds.size();
+    for (uint32 i = numToErase; i < numDirectories; ++i) {
+      m_directoryEnds[i - numToErase] = m_directoryEnds[i] - eraseEnd;
+    }
+    m_directoryEnds.resize(numDirectories - numToErase);
+
+    m_nodeLength = 0;
+    m_deviceLength = 0;
     m_isAbsolute = false;
     return *this;
   }
 
   bool
   Path::includes(const Path& child) const {
-    if (m_device != child.m_device) {
+    if (getDevice() != child.getDevice()) {
       return false;
     }
 
-    if (m_node != child.m_node) {
+    if (getNode() != child.getNode()) {
       return false;
     }
 
-    auto iterParent = m_directories.begin();
-    auto iterChild = child.m_directories.begin();
-
-    for (; iterParent != m_directories.end(); ++iterChild, ++iterParent) {
-      if (iterChild == child.m_directories.end()) {
-        return false;
-      }
+    const SIZE_T numDirectories = m_directoryEnds.size();
+    const SIZE_T numChildDirectories = child.m_directoryEnds.size();
+    if (numDirectories > numChildDirectories) {
+      return false;
+    }
 
-      if (!comparePathElem(*iterChild, *iterParent)) {
+    for (SIZE_T i = 0; i < numDirectories; ++i) {
+      if (!comparePathElem(child.getDirectory(i), getDirectory(i))) {
         return false;
       }
     }
 
-    if (!m_filename.empty()) {
-      if (iterChild == child.m_directories.end()) {
-        if (child.m_filename.empty()) {
+    if (isFile()) {
+      if (numDirectories == numChildDirectories) {
+        if (child.isDirectory()) {
           return false;
         }
 
-        if (!comparePathElem(child.m_filename, m_filename)) {
+        if (!comparePathElem(child.getFilename(), getFilename())) {
           return false;
         }
       }
       else {
-        if (!comparePathElem(*iterChild, m_filename)) {
+        if (!comparePathElem(child.getDirectory(numDirectories), getFilename())) {
           return false;
         }
       }
@@ -285,207 +416,240 @@ namespace geEngineSDK {
     }
 
     if (m_isAbsolute) {
-      if (!comparePathElem(m_device, other.m_device)) {
+      if (!comparePathElem(getDevice(), other.getDevice())) {
         return false;
       }
     }
 
-    SIZE_T myNumElements = m_directories.size();
-    SIZE_T otherNumElements = other.m_directories.size();
-
-    if (!m_filename.empty()) {
-      ++myNumElements;
-    }
-
-    if (!other.m_filename.empty()) {
-      ++otherNumElements;
+    //A filename is treated the same as a last directory, so "a/b" matches "a/b/"
+    const SIZE_T myNumElements = m_directoryEnds.size() + (isFile() ? 1 : 0);
+    const SIZE_T otherNumElements = other.m_directoryEnds.size() + (other.isFile() ? 1 : 0);
+    if (myNumElements != otherNumElements) {
+      return false;
     }
 
-    if (myNumElements != otherNumElements) {
+    const uint32 myStart = getDirectoriesStart();
+    const uint32 otherStart = other.getDirectoriesStart();
+    if (m_buffer.size() - myStart != other.m_buffer.size() - otherStart) {
       return false;
     }
-    
-    if (0 < myNumElements) {
-      auto iterMe = m_directories.begin();
-      auto iterOther = other.m_directories.begin();
 
-      for (SIZE_T i = 0; i < (myNumElements - 1); ++i, ++iterMe, ++iterOther) {
-        if (!comparePathElem(*iterMe, *iterOther)) {
-          return false;
-        }
+    //Element boundaries must match too ("ab/c" against "a/bc"). The last
+    //one is the end of the buffer on both paths.
+    const uint32 numBoundaries = std::min(m_directoryEnds.size(),
+                                          other.m_directoryEnds.size());
+    for (uint32 i = 0; i < numBoundaries; ++i) {
+      if (m_directoryEnds[i] - myStart != other.m_directoryEnds[i] - otherStart) {
+        return false;
       }
+    }
 
-      if (!m_filename.empty()) {
-        if (!other.m_filename.empty()) {
-          if (!comparePathElem(m_filename, other.m_filename)) {
-            return false;
-          }
-        }
-        else {
-          if (!comparePathElem(m_filename, *iterOther)) {
-            return false;
-          }
-        }
+    return comparePathElem(getView(myStart, m_buffer.size()),
+                           other.getView(otherStart, other.m_buffer.size()));
+  }
+
+  SIZE_T
+  Path::getHash() const {
+    //FNV-1a over the lower case elements, with a separator between them
+    uint64 hash = 14695981039346656037ull;
+    auto hashChar = [&hash](uint8 value) {
+      hash ^= value;
+      hash *= 1099511628211ull;
+    };
+
+    hashChar(m_isAbsolute ? 1 : 0);
+    if (m_isAbsolute) {
+      for (auto ch : getDevice()) {
+        hashChar(static_cast<uint8>(toLowerPathChar(ch)));
       }
-      else {
-        if (!other.m_filename.empty()) {
-          if (!comparePathElem(*iterMe, other.m_filename)) {
-            return false;
-          }
-        }
-        else {
-          if (!comparePathElem(*iterMe, *iterOther)) {
-            return false;
-          }
-        }
+      hashChar('/');
+    }
+
+    const uint32 numDirectories = m_directoryEnds.size();
+    uint32 nextEnd = 0 < numDirectories ? m_directoryEnds[0] : 0;
+    uint32 dirIdx = 0;
+    for (uint32 i = getDirectoriesStart(); i < m_buffer.size(); ++i) {
+      while (dirIdx < numDirectories && i == nextEnd) {
+        hashChar('/');
+        ++dirIdx;
+        nextEnd = dirIdx < numDirectories ? m_directoryEnds[dirIdx] : 0;
       }
+      hashChar(static_cast<uint8>(toLowerPathChar(m_buffer[i])));
     }
 
-    return true;
+    return static_cast<SIZE_T>(hash);
   }
 
   Path&
   Path::append(const Path& path) {
-    if (!m_filename.empty()) {
-      pushDirectory(m_filename);
+    if (&path == this) {
+      const Path copy = path;
+      return append(copy);
+    }
+
+    if (isFile()) {
+      const StringView filename = getFilename();
+      if ("." != filename && ".." != filename) {
+        //The filename is already after the last directory, it only needs an
+        //entry on the table to become one
+        m_directoryEnds.add(m_buffer.size());
+      }
+      else {
+        const String filenameCopy(filename);
+        setFilename(StringView());
+        pushDirectory(filenameCopy);
+      }
     }
 
-    for (auto& dir : path.m_directories) {
-      pushDirectory(dir);
+    for (SIZE_T i = 0; i < path.m_directoryEnds.size(); ++i) {
+      pushDirectory(path.getDirectory(i));
     }
 
-    m_filename = path.m_filename;
+    setFilename(path.getFilename());
     return *this;
   }
 
   void
-  Path::setBasename(const String& basename) {
-    m_filename = basename + getExtension();
+  Path::setFilename(StringView filename) {
+    const uint32 start = getFilenameStart();
+    replaceText(start, m_buffer.size() - start, filename);
   }
 
   void
-  Path::setExtension(const String& extension) {
-    StringStream stream;
-    stream << getFilename(false);
-    stream << extension;
-    m_filename = stream.str();
+  Path::setBasename(StringView basename) {
+    String filename(basename);
+    filename += getExtension();
+    setFilename(filename);
+  }
+
+  void
+  Path::setExtension(StringView extension) {
+    String filename = getFilename(false);
+    filename.append(extension.data(), extension.size());
+    setFilename(filename);
   }
 
   String
   Path::getFilename(bool extension) const {
+    const StringView filename = getFilename();
     if (extension) {
-      return m_filename;
+      return String(filename);
     }
-    else {
-      WString::size_type pos = m_filename.rfind(L'.');
-      if (pos != WString::npos) {
-        return m_filename.substr(0, pos);
-      }
-      else {
-        return m_filename;
-      }
+
+    const SIZE_T pos = filename.rfind('.');
+    if (pos != StringView::npos) {
+      return String(filename.substr(0, pos));
     }
+
+    return String(filename);
   }
 
   String
   Path::getExtension() const {
-    WString::size_type pos = m_filename.rfind(L'.');
-    if (pos != WString::npos)
-      return m_filename.substr(pos);
-    else
-      return String();
+    const StringView filename = getFilename();
+    const SIZE_T pos = filename.rfind('.');
+    if (pos != StringView::npos) {
+      return String(filename.substr(pos));
+    }
+
+    return String();
   }
 
-  const String&
+  StringView
   Path::getDirectory(SIZE_T idx) const {
-    if (idx >= m_directories.size()) {
+    if (idx >= m_directoryEnds.size()) {
       GE_EXCEPT(InvalidParametersException,
                 "Index out of range: " + 
                 geEngineSDK::toString(static_cast<uint32>(idx)) +
                 ". Valid range: [0, " + 
-                geEngineSDK::toString(static_cast<uint32>(m_directories.size() - 1)) +
+                geEngineSDK::toString(static_cast<uint32>(m_directoryEnds.size() - 1)) +
                 "]");
     }
-    return m_directories[idx];
+
+    return getView(getDirectoryStart(idx), m_directoryEnds[static_cast<uint32>(idx)]);
   }
 
-  const String&
+  StringView
   Path::getTail() const {
     if (isFile()) {
-      return m_filename;
+      return getFilename();
     }
-    else if (!m_directories.empty()) {
-      return m_directories.back();
+    else if (!m_directoryEnds.empty()) {
+      return getDirectory(m_directoryEnds.size() - 1);
     }
     else {
-      return StringUtil::BLANK;
+      return StringView();
     }
   }
 
   void
   Path::clear() {
-    m_directories.clear();
-    m_device.clear();
-    m_filename.clear();
-    m_node.clear();
+    m_buffer.clear();
+    m_directoryEnds.clear();
+    m_nodeLength = 0;
+    m_deviceLength = 0;
     m_isAbsolute = false;
   }
 
   void
-  Path::throwInvalidPathException(const String& path) {
-    GE_EXCEPT(InvalidParametersException, "Incorrectly formatted path provided: " + path);
+  Path::throwInvalidPathException(const ANSICHAR* pathStr, SIZE_T numChars) {
+    GE_EXCEPT(InvalidParametersException,
+              "Incorrectly formatted path provided: " + String(pathStr, numChars));
   }
 
   String
   Path::buildWindows() const {
-    StringStream result;
-    if (!m_node.empty()) {
-      result << "\\\\";
-      result << m_node;
-      result << "\\";
+    String result;
+    result.reserve(m_buffer.size() + m_directoryEnds.size() + 4);
+
+    if (0 < m_nodeLength) {
+      result.append("\\\\");
+      result.append(getNode());
+      result.append("\\");
     }
-    else if (!m_device.empty()) {
-      result << m_device;
-      result << ":\\";
+    else if (0 < m_deviceLength) {
+      result.append(getDevice());
+      result.append(":\\");
     }
     else if (m_isAbsolute) {
-      result << "\\";
+      result.append("\\");
     }
 
-    for (auto& dir : m_directories) {
-      result << dir;
-      result << "\\";
+    for (SIZE_T i = 0; i < m_directoryEnds.size(); ++i) {
+      result.append(getDirectory(i));
+      result.append("\\");
     }
 
-    result << m_filename;
-    return result.str();
+    result.append(getFilename());
+    return result;
   }
 
   String
   Path::buildUnix() const {
-    StringStream result;
-    auto dirIter = m_directories.begin();
+    String result;
+    result.reserve(m_buffer.size() + m_directoryEnds.size() + 4);
 
-    if (!m_device.empty()) {
-      result << "/";
-      result << m_device;
-      result << ":/";
+    SIZE_T dirIdx = 0;
+    if (0 < m_deviceLength) {
+      result.append("/");
+      result.append(getDevice());
+      result.append(":/");
     }
     else if (m_isAbsolute) {
-      if (dirIter != m_directories.end() && "~" == *dirIter) {
-        result << "~";
-        dirIter++;
+      if (!m_directoryEnds.empty() && "~" == getDirectory(0)) {
+        result.append("~");
+        ++dirIdx;
       }
-      result << "/";
+      result.append("/");
     }
 
-    for (; dirIter != m_directories.end(); ++dirIter) {
-      result << *dirIter;
-      result << "/";
+    for (; dirIdx < m_directoryEnds.size(); ++dirIdx) {
+      result.append(getDirectory(dirIdx));
+      result.append("/");
     }
 
-    result << m_filename;
-    return result.str();
+    result.append(getFilename());
+    return result;
   }
 
   Path
@@ -499,14 +663,14 @@ namespace geEngineSDK {
   }
 
   bool
-  Path::comparePathElem(const String& left, const String& right) {
+  Path::comparePathElem(StringView left, StringView right) {
     if (left.size() != right.size()) {
       return false;
     }
 
     //TODO: Case sensitive/insensitive file path actually depends on used file-system
     for (SIZE_T i = 0; i<left.size(); ++i) {
-      if (tolower(left[i]) != tolower(right[i])) {
+      if (toLowerPathChar(left[i]) != toLowerPathChar(right[i])) {
         return false;
       }
     }
@@ -532,19 +696,87 @@ namespace geEngineSDK {
   }
 
   void
-  Path::pushDirectory(const String& dir) {
-    if (!dir.empty() && "." != dir) {
-      if (dir == "..") {
-        if (!m_directories.empty() && m_directories.back() != "..") {
-          m_directories.pop_back();
-        }
-        else {
-          m_directories.push_back(dir);
-        }
-      }
-      else {
-        m_directories.push_back(dir);
+  Path::setNode(StringView node) {
+    const int64 delta = static_cast<int64>(node.size()) - m_nodeLength;
+    replaceText(0, m_nodeLength, node);
+    m_nodeLength = static_cast<uint32>(node.size());
+    for (auto& end : m_directoryEnds) {
+      end = static_cast<uint32>(end + delta);
+    }
+  }
+
+  void
+  Path::setDevice(StringView device) {
+    const int64 delta = static_cast<int64>(device.size()) - m_deviceLength;
+    replaceText(m_nodeLength, m_deviceLength, device);
+    m_deviceLength = static_cast<uint32>(device.size());
+    for (auto& end : m_directoryEnds) {
+      end = static_cast<uint32>(end + delta);
+    }
+  }
+
+  void
+  Path::pushDirectory(StringView dir) {
+    if (dir.empty() || "." == dir) {
+      return;
+    }
+
+    if (".." == dir && !m_directoryEnds.empty() &&
+        ".." != getDirectory(m_directoryEnds.size() - 1)) {
+      popDirectory();
+      return;
+    }
+
+    //Directories go right before the filename
+    const uint32 start = getFilenameStart();
+    replaceText(start, 0, dir);
+    m_directoryEnds.add(start + static_cast<uint32>(dir.size()));
+  }
+
+  void
+  Path::popDirectory() {
+    GE_ASSERT(!m_directoryEnds.empty());
+    const uint32 lastIdx = m_directoryEnds.size() - 1;
+    const uint32 start = getDirectoryStart(lastIdx);
+    replaceText(start, m_directoryEnds[lastIdx] - start, StringView());
+    m_directoryEnds.pop();
+  }
+
+  void
+  Path::replaceText(uint32 start, uint32 length, StringView text) {
+    //The text can be a view of this same path
+    const ANSICHAR* bufferBegin = m_buffer.data();
+    if (!text.empty() &&
+        text.data() >= bufferBegin &&
+        text.data() < bufferBegin + m_buffer.size()) {
+      const String copy(text);
+      replaceText(start, length, copy);
+      return;
+    }
+
+    const uint32 oldSize = m_buffer.size();
+    const uint32 textSize = static_cast<uint32>(text.size());
+    const uint32 newSize = oldSize - length + textSize;
+    const uint32 tailStart = start + length;
+    const uint32 tailSize = oldSize - tailStart;
+
+    if (newSize > oldSize) {
+      if (newSize > m_buffer.capacity()) {
+        m_buffer.reserve(std::max(newSize, m_buffer.capacity() * 2));
       }
+      m_buffer.resize(newSize);
+    }
+
+    ANSICHAR* data = m_buffer.data();
+    if (0 < tailSize && textSize != length) {
+      memmove(data + start + textSize, data + tailStart, tailSize);
+    }
+    if (0 < textSize) {
+      memcpy(data + start, text.data(), textSize);
+    }
+
+    if (newSize < oldSize) {
+      m_buffer.resize(newSize);
     }
   }
 }
@@ -0,0 +1,71 @@
+/*****************************************************************************/
+/**
+ * @file    gePathID.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   An interned path identifier for very fast comparisons
+ *
+ * An interned path identifier that provides very fast comparisons and can be
+ * used as a map key.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "gePathID.h"
+
+namespace geEngineSDK {
+  namespace {
+    using CanonicalBuffer = SmallVector<ANSICHAR, 256>;
+
+    void
+    appendLower(CanonicalBuffer& output, StringView text) {
+      for (auto ch : text) {
+        output.add(static_cast<ANSICHAR>(tolower(ch)));
+      }
+    }
+  }
+
+  PathID::PathID(const Path& path) {
+    //Same rules as Path::equals(): the device only counts on absolute paths,
+    //the node is ignored and a filename is the same as a last directory
+    CanonicalBuffer canonical;
+    if (path.isAbsolute()) {
+      canonical.add('/');
+      if (!path.getDevice().empty()) {
+        appendLower(canonical, path.getDevice());
+        canonical.add(':');
+        canonical.add('/');
+      }
+    }
+
+    const SIZE_T numDirectories = path.getNumDirectories();
+    for (SIZE_T i = 0; i < numDirectories; ++i) {
+      if (0 < i) {
+        canonical.add('/');
+      }
+      appendLower(canonical, path.getDirectory(i));
+    }
+
+    if (path.isFile()) {
+      if (0 < numDirectories) {
+        canonical.add('/');
+      }
+      appendLower(canonical, path.getFilename());
+    }
+
+    if (!canonical.empty()) {
+      m_id = StringID(canonical.data(), canonical.size());
+    }
+  }
+
+  Path
+  PathID::toPath() const {
+    return Path(StringView(m_id.c_str(), m_id.size()), PATH_TYPE::kUnix);
+  }
+}
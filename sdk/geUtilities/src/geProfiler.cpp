@@ -0,0 +1,348 @@
+/*****************************************************************************/
+/**
+ * @file    geProfiler.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2026/10/18
+ * @brief   Hierarchical CPU profiler.
+ *
+ * Hierarchical CPU profiler.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geProfiler.h"
+#include "geTimer.h"
+
+namespace geEngineSDK {
+  /**
+   * Written only by its thread, except for the ring buffer that endFrame()
+   * reads up to the published write index.
+   */
+  struct Profiler::ThreadState
+  {
+    String name;
+    uint32 index = 0;
+
+    uint32 depth = 0;
+    Array<const char*, MAX_DEPTH> openNames;
+    Array<uint64, MAX_DEPTH> openBegins;
+
+    atomic<uint64> writeIndex{ 0 };
+    atomic<uint64> readIndex{ 0 };
+    atomic<uint64> dropped{ 0 };
+    Array<ProfileEvent, RING_SIZE> events;
+  };
+
+  namespace {
+    static_assert(0 == (Profiler::RING_SIZE & (Profiler::RING_SIZE - 1)),
+                  "The ring size must be a power of two.");
+
+    atomic<uint64> s_nextInstanceId(1);
+
+    //State of the calling thread, valid while the id matches the instance
+    GE_THREADLOCAL uint64 t_stateInstanceId = 0;
+    GE_THREADLOCAL void* t_state = nullptr;
+
+    void
+    appendJsonString(StringStream& stream, const char* text) {
+      stream << '"';
+      for (const char* c = text; *c; ++c) {
+        if ('"' == *c || '\\' == *c) {
+          stream << '\\' << *c;
+        }
+        else if (cast::st<uint8>(*c) < 0x20) {
+          stream << ' ';
+        }
+        else {
+          stream << *c;
+        }
+      }
+      stream << '"';
+    }
+  }
+
+  Profiler::Profiler()
+    : m_instanceId(s_nextInstanceId.fetch_add(1)) {
+    m_frameBegin = now();
+    m_lastFrame.begin = m_frameBegin;
+    m_lastFrame.end = m_frameBegin;
+
+    //Started from the main thread
+    getThreadState().name = "Main";
+  }
+
+  Profiler::~Profiler() {
+    for (ThreadState* state : m_threads) {
+      ge_delete<ThreadState, ProfilerAlloc>(state);
+    }
+  }
+
+  uint64
+  Profiler::now() {
+    using Clock = HighResOrSteadyClock;
+    return cast::st<uint64>(
+      duration_cast<nanoseconds>(Clock::now().time_since_epoch()).count());
+  }
+
+  Profiler::ThreadState&
+  Profiler::getThreadState() {
+    if (t_stateInstanceId == m_instanceId) {
+      return *static_cast<ThreadState*>(t_state);
+    }
+
+    Lock lock(m_mutex);
+    auto* state = ge_new<ThreadState, ProfilerAlloc>();
+    state->index = cast::st<uint32>(m_threads.size());
+    state->name = "Thread " + toString(state->index);
+    m_threads.push_back(state);
+
+    t_stateInstanceId = m_instanceId;
+    t_state = state;
+    return *state;
+  }
+
+  void
+  Profiler::beginZone(const char* name) {
+    if (!isStarted()) {
+      return;
+    }
+
+    ThreadState& state = _instance()->getThreadState();
+    if (state.depth < MAX_DEPTH) {
+      state.openNames[state.depth] = name;
+      state.openBegins[state.depth] = now();
+    }
+    ++state.depth;
+  }
+
+  void
+  Profiler::endZone() {
+    if (!isStarted()) {
+      return;
+    }
+
+    ThreadState& state = _instance()->getThreadState();
+
+    //Zones opened before the profiler started are not closed
+    if (0 == state.depth) {
+      return;
+    }
+
+    const uint32 depth = --state.depth;
+    if (depth >= MAX_DEPTH) {
+      return;
+    }
+
+    const uint64 end = now();
+    const uint64 write = state.writeIndex.load(std::memory_order_relaxed);
+    if (write - state.readIndex.load(std::memory_order_acquire) >= RING_SIZE) {
+      state.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    state.events[write & (RING_SIZE - 1)] =
+      { state.openNames[depth], state.openBegins[depth], end, depth };
+    state.writeIndex.store(write + 1, std::memory_order_release);
+  }
+
+  void
+  Profiler::endFrame() {
+    const uint64 frameEnd = now();
+
+    m_lastFrame.index = m_frameIndex++;
+    m_lastFrame.begin = m_frameBegin;
+    m_lastFrame.end = frameEnd;
+    m_lastFrame.nodes.clear();
+    m_frameBegin = frameEnd;
+
+    if (0 < m_capturedFrames) {
+      m_captured.emplace_back();
+      while (m_captured.size() > m_capturedFrames) {
+        m_captured.pop_front();
+      }
+    }
+
+    Lock lock(m_mutex);
+    for (ThreadState* state : m_threads) {
+      //Everything up to the published index is written, the thread keeps
+      //adding after it meanwhile
+      const uint64 read = state->readIndex.load(std::memory_order_relaxed);
+      const uint64 write = state->writeIndex.load(std::memory_order_acquire);
+
+      m_drained.clear();
+      for (uint64 i = read; i < write; ++i) {
+        m_drained.push_back(state->events[i & (RING_SIZE - 1)]);
+      }
+      state->readIndex.store(write, std::memory_order_release);
+
+      if (m_drained.empty()) {
+        continue;
+      }
+
+      if (0 < m_capturedFrames) {
+        for (const auto& event : m_drained) {
+          m_captured.back().push_back({ event, state->index });
+        }
+      }
+
+      buildFrameTree(state->index, m_drained);
+    }
+  }
+
+  void
+  Profiler::buildFrameTree(uint32 thread, Vector<ProfileEvent>& events) {
+    //Closed zones come out children first, sort them parents first
+    std::sort(events.begin(), events.end(),
+              [](const ProfileEvent& a, const ProfileEvent& b) {
+                return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+              });
+
+    auto& nodes = m_lastFrame.nodes;
+    const uint32 root = cast::st<uint32>(nodes.size());
+    ProfileNode rootNode;
+    rootNode.name = internName(m_threads[thread]->name);
+    rootNode.thread = thread;
+    nodes.push_back(rootNode);
+
+    //Zones still open at the end of the last frame leave their children
+    //without a parent, those go under the root
+    struct OpenZone
+    {
+      uint64 end;
+      uint32 node;
+    };
+    SmallVector<OpenZone, MAX_DEPTH> open;
+
+    for (const auto& event : events) {
+      while (!open.empty() && open.back().end < event.end) {
+        open.pop();
+      }
+      const uint32 parent = open.empty() ? root : open.back().node;
+
+      //Zones of the same name under the same parent are merged
+      uint32 node = cast::st<uint32>(nodes.size());
+      for (uint32 i = parent + 1; i < nodes.size(); ++i) {
+        if (nodes[i].parent == parent && nodes[i].name == event.name) {
+          node = i;
+          break;
+        }
+      }
+
+      if (node == nodes.size()) {
+        ProfileNode newNode;
+        newNode.name = event.name;
+        newNode.parent = parent;
+        newNode.thread = thread;
+        nodes.push_back(newNode);
+      }
+
+      const uint64 duration = event.end - event.begin;
+      nodes[node].calls += 1;
+      nodes[node].totalTime += duration;
+      nodes[node].selfTime += duration;
+      if (root == parent) {
+        nodes[root].totalTime += duration;
+      }
+      else {
+        nodes[parent].selfTime -= duration;
+      }
+
+      open.add({ event.end, node });
+    }
+  }
+
+  void
+  Profiler::setCapturedFrames(uint32 numFrames) {
+    m_capturedFrames = numFrames;
+    while (m_captured.size() > m_capturedFrames) {
+      m_captured.pop_front();
+    }
+  }
+
+  String
+  Profiler::exportChromeTrace() const {
+    StringStream stream;
+    stream << "{\"traceEvents\":[";
+
+    bool bFirst = true;
+    auto separator = [&stream, &bFirst]() {
+      if (!bFirst) {
+        stream << ",\n";
+      }
+      bFirst = false;
+    };
+
+    const Vector<String> threadNames = getThreadNames();
+    for (uint32 i = 0; i < threadNames.size(); ++i) {
+      separator();
+      stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << i
+             << R"(,"args":{"name":)";
+      appendJsonString(stream, threadNames[i].c_str());
+      stream << "}}";
+    }
+
+    //Complete events in microseconds, from the first captured zone
+    uint64 origin = NumLimit::MAX_UINT64;
+    for (const auto& frame : m_captured) {
+      for (const auto& captured : frame) {
+        origin = std::min(origin, captured.event.begin);
+      }
+    }
+
+    stream.precision(3);
+    stream << std::fixed;
+    for (const auto& frame : m_captured) {
+      for (const auto& captured : frame) {
+        separator();
+        stream << R"({"name":)";
+        appendJsonString(stream, captured.event.name);
+        stream << R"(,"ph":"X","pid":1,"tid":)" << captured.thread
+               << R"(,"ts":)" << (captured.event.begin - origin) / 1000.0
+               << R"(,"dur":)" << (captured.event.end - captured.event.begin) / 1000.0
+               << "}";
+      }
+    }
+
+    stream << "]}";
+    return stream.str();
+  }
+
+  void
+  Profiler::setThreadName(const String& name) {
+    ThreadState& state = getThreadState();
+    Lock lock(m_mutex);
+    state.name = name;
+  }
+
+  Vector<String>
+  Profiler::getThreadNames() const {
+    Lock lock(m_mutex);
+    Vector<String> names;
+    for (const ThreadState* state : m_threads) {
+      names.push_back(state->name);
+    }
+    return names;
+  }
+
+  const char*
+  Profiler::internName(const String& name) {
+    Lock lock(m_namesMutex);
+    return m_names.insert(name).first->c_str();
+  }
+
+  uint64
+  Profiler::getNumDroppedZones() const {
+    Lock lock(m_mutex);
+    uint64 dropped = 0;
+    for (const ThreadState* state : m_threads) {
+      dropped += state->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+  }
+}
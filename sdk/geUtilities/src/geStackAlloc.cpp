@@ -44,13 +44,20 @@ namespace geEngineSDK {
   MemStack::alloc(SIZE_T numBytes) {
     GE_ASSERT(nullptr != threadMemStack &&
               "Stack allocation failed. Did you call BeginThread?");
-    return threadMemStack->alloc(numBytes);
+    byte* data = threadMemStack->alloc(numBytes);
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+    MemoryCounter::trackAlloc(data, numBytes, MEMORY_SOURCE::kStack);
+#endif
+    return data;
   }
 
   void
   MemStack::deallocLast(byte* data) {
     GE_ASSERT(nullptr != threadMemStack&&
               "Stack deallocation failed. Did you call BeginThread?");
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+    MemoryCounter::trackFree(data, MEMORY_SOURCE::kStack);
+#endif
     threadMemStack->dealloc(data);
   }
 }
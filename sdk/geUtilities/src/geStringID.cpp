@@ -19,161 +19,191 @@
 #include "geStringID.h"
 
 namespace geEngineSDK {
-  const StringID StringID::NONE;
-
-  volatile StringID::InitStatics StringID::m_initStatics = StringID::InitStatics();
-  StringID::InternalData* StringID::m_stringHashTable[HASH_TABLE_SIZE];
-  StringID::InternalData* StringID::m_chunks[MAX_CHUNK_COUNT];
-
-  uint32 StringID::m_nextId = 0;
-  uint32 StringID::m_numChunks = 0;
-  SpinLock StringID::m_sync;
-
-  StringID::InitStatics::InitStatics() {
-    ScopedSpinLock lock(m_sync);
-    memset(m_stringHashTable, 0, sizeof(m_stringHashTable));
-    memset(m_chunks, 0, sizeof(m_chunks));
-    m_chunks[0] = reinterpret_cast<InternalData*>
-                    (ge_alloc(sizeof(InternalData) * ELEMENTS_PER_CHUNK));
-    memset(m_chunks[0], 0, sizeof(InternalData) * ELEMENTS_PER_CHUNK);
-    ++m_numChunks;
+  namespace {
+    /**
+     * @brief The top bits of the hash select the shard.
+     */
+    CONSTEXPR uint32 SHARD_BITS = 6;
+    CONSTEXPR uint32 NUM_SHARDS = 1u << SHARD_BITS;
+
+    CONSTEXPR uint32 INITIAL_CAPACITY = 64;
+    CONSTEXPR SIZE_T ARENA_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Strings bigger than this get their own allocation instead of
+     *        wasting the rest of an arena block.
+     */
+    CONSTEXPR SIZE_T MAX_ARENA_ENTRY_SIZE = ARENA_BLOCK_SIZE / 4;
+
+    std::atomic<uint32> s_nextId{0};
   }
 
-  template<class T>
-  void
-  StringID::construct(T const& name) {
-    GE_ASSERT(StringIDUtil<T>::size(name) <= STRING_SIZE);
-
-    uint32 hash = calcHash(name)
-                  & (sizeof(m_stringHashTable) / sizeof(m_stringHashTable[0]) - 1);
-    InternalData* existingEntry = m_stringHashTable[hash];
-
-    while (nullptr != existingEntry) {
-      if (StringIDUtil<T>::compare(name, existingEntry->m_chars)) {
-        m_data = existingEntry;
-        return;
+  struct StringID::Shard
+  {
+    /**
+     * @brief Open addressing table of a shard. Tables are only replaced (never
+     *        modified in place besides filling empty slots) when growing, and
+     *        the old ones are kept alive so readers never see freed memory.
+     */
+    struct Table
+    {
+      uint32 m_mask;
+      std::atomic<const InternalData*>* m_slots;
+      Table* m_previous;
+    };
+
+    SpinLock m_lock;
+    std::atomic<Table*> m_table{nullptr};
+    uint32 m_count = 0;
+
+    ANSICHAR* m_arenaCursor = nullptr;
+    SIZE_T m_arenaLeft = 0;
+
+    /**
+     * @brief Looks for the string on a table.
+     * @return The entry or nullptr and the first empty slot on the probe.
+     */
+    const InternalData*
+    find(const Table& table,
+         const ANSICHAR* name,
+         SIZE_T size,
+         uint32 hash,
+         uint32& emptySlot) const {
+      uint32 idx = hash & table.m_mask;
+      while (true) {
+        auto entry = table.m_slots[idx].load(std::memory_order_acquire);
+        if (nullptr == entry) {
+          emptySlot = idx;
+          return nullptr;
+        }
+
+        if (entry->m_hash == hash &&
+            entry->m_size == size &&
+            0 == memcmp(entry->chars(), name, size)) {
+          return entry;
+        }
+
+        idx = (idx + 1) & table.m_mask;
       }
-
-      existingEntry = existingEntry->m_next;
     }
 
-    ScopedSpinLock lock(m_sync);
-
-    //Search for the value again in case other thread just added it
-    existingEntry = m_stringHashTable[hash];
-    InternalData* lastEntry = nullptr;
-    while (nullptr != existingEntry) {
-      if (StringIDUtil<T>::compare(name, existingEntry->m_chars)) {
-        m_data = existingEntry;
-        return;
+    /**
+     * @brief Creates a table twice the size of the current one and moves all
+     *        the entries to it. Must be called with the lock taken.
+     */
+    Table*
+    grow(Table* oldTable) {
+      const uint32 capacity = oldTable ? (oldTable->m_mask + 1) * 2 : INITIAL_CAPACITY;
+
+      auto newTable = ge_new<Table>();
+      newTable->m_mask = capacity - 1;
+      newTable->m_slots = reinterpret_cast<std::atomic<const InternalData*>*>(
+                            ge_alloc(sizeof(std::atomic<const InternalData*>) * capacity));
+      for (uint32 i = 0; i < capacity; ++i) {
+        new (&newTable->m_slots[i]) std::atomic<const InternalData*>(nullptr);
+      }
+      newTable->m_previous = oldTable;
+
+      if (oldTable) {
+        for (uint32 i = 0; i <= oldTable->m_mask; ++i) {
+          auto entry = oldTable->m_slots[i].load(std::memory_order_relaxed);
+          if (nullptr == entry) {
+            continue;
+          }
+
+          uint32 idx = entry->m_hash & newTable->m_mask;
+          while (nullptr != newTable->m_slots[idx].load(std::memory_order_relaxed)) {
+            idx = (idx + 1) & newTable->m_mask;
+          }
+          newTable->m_slots[idx].store(entry, std::memory_order_relaxed);
+        }
       }
 
-      lastEntry = existingEntry;
-      existingEntry = existingEntry->m_next;
-    }
-
-    m_data = allocEntry();
-    StringIDUtil<T>::copy(name, m_data->m_chars);
-    if (nullptr == lastEntry) {
-      m_stringHashTable[hash] = m_data;
-    }
-    else {
-      lastEntry->m_next = m_data;
-    }
-  }
-
-  template<class T>
-  uint32
-  StringID::calcHash(T const& input) const {
-    uint32 size = StringIDUtil<T>::size(input);
-
-    uint32 hash = 0;
-    for (uint32 i = 0; i < size; ++i) {
-      using Elem = std::remove_cv_t<std::remove_reference_t<decltype(input[i])>>;
-      const uint32 v = static_cast<uint32>(static_cast<std::make_unsigned_t<Elem>>(input[i]));
-      hash = hash * 101u + v;
+      m_table.store(newTable, std::memory_order_release);
+      return newTable;
     }
-    return hash;
-  }
 
-  StringID::InternalData*
-  StringID::allocEntry() {
-    uint32 chunkIdx = m_nextId / ELEMENTS_PER_CHUNK;
+    /**
+     * @brief Allocates a new entry with the string stored after it.
+     *        Must be called with the lock taken.
+     */
+    InternalData*
+    allocEntry(const ANSICHAR* name, SIZE_T size, uint32 hash) {
+      GE_ASSERT(size < NumLimit::MAX_UINT32);
+
+      CONSTEXPR SIZE_T alignment = alignof(InternalData);
+      const SIZE_T entrySize = (sizeof(InternalData) + size + 1 + alignment - 1) &
+                               ~(alignment - 1);
+
+      ANSICHAR* memory = nullptr;
+      if (entrySize > MAX_ARENA_ENTRY_SIZE) {
+        memory = reinterpret_cast<ANSICHAR*>(ge_alloc(entrySize));
+      }
+      else {
+        if (entrySize > m_arenaLeft) {
+          m_arenaCursor = reinterpret_cast<ANSICHAR*>(ge_alloc(ARENA_BLOCK_SIZE));
+          m_arenaLeft = ARENA_BLOCK_SIZE;
+        }
+        memory = m_arenaCursor;
+        m_arenaCursor += entrySize;
+        m_arenaLeft -= entrySize;
+      }
 
-    GE_ASSERT(chunkIdx < MAX_CHUNK_COUNT);
-    GE_ASSERT(chunkIdx <= m_numChunks); //Can only increment sequentially
+      auto entry = new (memory) InternalData();
+      entry->m_id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+      entry->m_hash = hash;
+      entry->m_size = static_cast<uint32>(size);
 
-    if (chunkIdx >= m_numChunks) {
-      m_chunks[chunkIdx] = reinterpret_cast<InternalData*>
-                             (ge_alloc(sizeof(InternalData) * ELEMENTS_PER_CHUNK));
-      memset(m_chunks[chunkIdx], 0, sizeof(InternalData) * ELEMENTS_PER_CHUNK);
-      ++m_numChunks;
+      auto chars = reinterpret_cast<ANSICHAR*>(entry + 1);
+      memcpy(chars, name, size);
+      chars[size] = '\0';
+      return entry;
     }
+  };
 
-    InternalData* chunk = m_chunks[chunkIdx];
-    uint32 chunkSpecificIndex = m_nextId % ELEMENTS_PER_CHUNK;
-
-    InternalData* newEntry = &chunk[chunkSpecificIndex];
-    newEntry->m_id = m_nextId++;
-    newEntry->m_next = nullptr;
-
-    return newEntry;
+  StringID::Shard*
+  StringID::getShards() {
+    //Entries live for the whole execution, like the ids pointing to them, so
+    //the table is intentionally never destroyed.
+    static Shard* s_shards = ge_newN<Shard>(NUM_SHARDS);
+    return s_shards;
   }
 
-  template<>
-  class StringID::StringIDUtil<const ANSICHAR*>
-  {
-   public:
-    static uint32
-    size(const ANSICHAR* const& input) {
-      return static_cast<uint32>(strlen(input));
-    }
-
-    static void
-    copy(const ANSICHAR* const& input, ANSICHAR* dest) {
-      memcpy(dest, input, strlen(input) + 1);
-    }
+  const StringID StringID::NONE;
 
-    static bool
-    compare(const ANSICHAR* const& a,
-            ANSICHAR* b) {
-      return strcmp(a, b) == 0;
+  void
+  StringID::construct(const ANSICHAR* name, SIZE_T size, uint32 hash) {
+    Shard& shard = getShards()[hash >> (32 - SHARD_BITS)];
+    uint32 emptySlot = 0;
+
+    //Lock free lookup. A table being replaced by a bigger one might miss a
+    //string that was just added, which is handled on the locked path below.
+    if (auto table = shard.m_table.load(std::memory_order_acquire)) {
+      if (auto entry = shard.find(*table, name, size, hash, emptySlot)) {
+        m_data = const_cast<InternalData*>(entry);
+        return;
+      }
     }
-  };
 
-  template<>
-  class StringID::StringIDUtil<String>
-  {
-   public:
-    static uint32
-    size(String const& input) {
-      return static_cast<uint32>(input.length());
-    }
+    ScopedSpinLock lock(shard.m_lock);
 
-    static void
-    copy(String const& input, ANSICHAR* dest) {
-      auto len = static_cast<uint32>(input.length());
-      input.copy(dest, len);
-      dest[len] = '\0';
+    //Search for the value again in case other thread just added it
+    Shard::Table* table = shard.m_table.load(std::memory_order_relaxed);
+    if (table) {
+      if (auto entry = shard.find(*table, name, size, hash, emptySlot)) {
+        m_data = const_cast<InternalData*>(entry);
+        return;
+      }
     }
 
-    static bool
-    compare(String const& a, ANSICHAR* b) {
-      return a.compare(b) == 0;
+    //Keep the load factor under 1/2 so probe sequences stay short
+    if (nullptr == table || (shard.m_count + 1) * 2 > table->m_mask + 1) {
+      table = shard.grow(table);
+      shard.find(*table, name, size, hash, emptySlot);
     }
-  };
 
-  template
-  GE_UTILITIES_EXPORT void
-  StringID::construct(const ANSICHAR* const&);
-  
-  template
-  GE_UTILITIES_EXPORT void
-  StringID::construct(String const&);
-
-  template
-  GE_UTILITIES_EXPORT uint32 StringID::calcHash(const ANSICHAR* const&) const;
-  
-  template
-  GE_UTILITIES_EXPORT uint32 StringID::calcHash(String const&) const;
+    m_data = shard.allocEntry(name, size, hash);
+    table->m_slots[emptySlot].store(m_data, std::memory_order_release);
+    ++shard.m_count;
+  }
 }
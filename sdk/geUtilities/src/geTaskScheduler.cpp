@@ -348,4 +348,38 @@ namespace geEngineSDK {
     //Otherwise we go by smaller id, as that task was queued earlier than the other
     return lhs->m_priority > rhs->m_priority;
   }
+
+  void
+  parallelForChunks(const String& name,
+                    uint32 count,
+                    uint32 chunkSize,
+                    const function<void(uint32, uint32)>& func,
+                    bool bParallel) {
+    chunkSize = std::max(chunkSize, 1u);
+    const uint32 numChunks = count / chunkSize + (0 != count % chunkSize ? 1 : 0);
+
+    atomic<uint32> nextChunk(0);
+    auto worker = [&](uint32) {
+      for (uint32 chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+           chunk < numChunks;
+           chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+        const uint32 begin = chunk * chunkSize;
+        func(begin, begin + std::min(chunkSize, count - begin));
+      }
+    };
+
+    uint32 numTasks = 1;
+    if (bParallel && TaskScheduler::isStarted()) {
+      numTasks = std::min(TaskScheduler::instance().getNumWorkers(), numChunks);
+    }
+
+    if (numTasks <= 1) {
+      worker(0);
+      return;
+    }
+
+    auto group = TaskGroup::create(name, worker, numTasks);
+    TaskScheduler::instance().addTaskGroup(group);
+    group->wait();
+  }
 }
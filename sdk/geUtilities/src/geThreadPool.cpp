@@ -20,6 +20,7 @@
 #include "geThreadPool.h"
 #include "geDebug.h"
 #include "geMath.h"
+#include "geProfiler.h"
 
 #if USING(GE_PLATFORM_WINDOWS)
 # include "Win32/geMinWindows.h"
@@ -104,12 +105,18 @@ namespace geEngineSDK {
 
     while (true) {
       function<void()> worker = nullptr;
+      const char* zoneName = nullptr;
 
       {
         {
           Lock lock(m_mutex);
           m_readyCond.wait(lock, [this] { return m_threadReady; });
           worker = m_workerMethod;
+
+          //Every job is a profiler zone named after it, tasks included
+          if (nullptr != worker && Profiler::isStarted()) {
+            zoneName = Profiler::instance().internName(m_name);
+          }
         }
 
         if (nullptr == worker) {
@@ -118,7 +125,13 @@ namespace geEngineSDK {
         }
       }
 
-      workingMethodRun(worker);
+      if (nullptr != zoneName) {
+        ProfileScope zone(zoneName);
+        workingMethodRun(worker);
+      }
+      else {
+        workingMethodRun(worker);
+      }
 
       {
         Lock lock(m_mutex);
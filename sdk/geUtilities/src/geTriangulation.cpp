@@ -0,0 +1,1105 @@
+/*****************************************************************************/
+/**
+ * @file    geTriangulation.cpp
+ * @author  Samuel Prince (samuel.prince.quezada@gmail.com)
+ * @date    2017/10/15
+ * @brief   Contains helper methods that triangulate point data.
+ *
+ * Contains helper methods that triangulate point data.
+ *
+ * The tetrahedralizer is an incremental Bowyer-Watson implementation:
+ * - Points are inserted in BRIO order (biased randomized rounds, each round
+ *   sorted along a 3D Hilbert curve) so consecutive insertions are close in
+ *   space and the location walks stay short.
+ * - Points are located with a stochastic visibility walk over the neighbor
+ *   links, starting from the last tetrahedron created in the same region.
+ * - Orientation and in-sphere tests are filtered floating point predicates
+ *   that fall back to exact expansion arithmetic when the result is not
+ *   certain, so degenerate inputs never corrupt the mesh.
+ * - Once the mesh is large enough, batches of points spread over independent
+ *   regions compute their cavities in parallel. Cavities that don't touch are
+ *   committed in parallel, the rest are retried in the next batch.
+ *
+ * @bug     No known bugs.
+ */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+ * Includes
+ */
+/*****************************************************************************/
+#include "geTriangulation.h"
+#include "geVector3.h"
+#include "geRandom.h"
+#include "geTaskScheduler.h"
+#include "geDebug.h"
+
+namespace geEngineSDK {
+  namespace {
+    /*************************************************************************/
+    /**
+     * Exact arithmetic (Shewchuk style floating point expansions).
+     * Only used when the filtered predicates can't decide the sign.
+     */
+    /*************************************************************************/
+    using Expansion = Vector<double>;
+
+    const double s_epsilon = std::numeric_limits<double>::epsilon() * 0.5;
+    const double s_orientErrBound = (7.0 + 56.0 * s_epsilon) * s_epsilon;
+    const double s_inSphereErrBound = (16.0 + 224.0 * s_epsilon) * s_epsilon;
+
+    FORCEINLINE void
+    twoSum(double a, double b, double& x, double& y) {
+      const double sum = a + b;
+      const double bVirtual = sum - a;
+      const double aVirtual = sum - bVirtual;
+      y = (a - aVirtual) + (b - bVirtual);
+      x = sum;
+    }
+
+    FORCEINLINE void
+    twoProduct(double a, double b, double& x, double& y) {
+      const double product = a * b;
+      y = std::fma(a, b, -product);
+      x = product;
+    }
+
+    /**
+     * @brief Adds a scalar to a non-overlapping expansion. The output is a
+     *        non-overlapping expansion with its zero components removed.
+     */
+    void
+    growExpansion(const Expansion& e, double b, Expansion& h) {
+      h.clear();
+      double q = b;
+      for (const double component : e) {
+        double sum, err;
+        twoSum(q, component, sum, err);
+        if (0.0 != err) {
+          h.push_back(err);
+        }
+        q = sum;
+      }
+
+      if (0.0 != q || h.empty()) {
+        h.push_back(q);
+      }
+    }
+
+    Expansion
+    expSum(const Expansion& e, const Expansion& f) {
+      Expansion h = e;
+      Expansion tmp;
+      for (const double component : f) {
+        growExpansion(h, component, tmp);
+        h.swap(tmp);
+      }
+      return h;
+    }
+
+    Expansion
+    expNeg(Expansion e) {
+      for (double& component : e) {
+        component = -component;
+      }
+      return e;
+    }
+
+    Expansion
+    expSub(const Expansion& e, const Expansion& f) {
+      return expSum(e, expNeg(f));
+    }
+
+    Expansion
+    expMul(const Expansion& e, const Expansion& f) {
+      Expansion h{ 0.0 };
+      Expansion tmp;
+      for (const double fc : f) {
+        for (const double ec : e) {
+          double product, err;
+          twoProduct(ec, fc, product, err);
+          growExpansion(h, err, tmp);
+          growExpansion(tmp, product, h);
+        }
+      }
+      return h;
+    }
+
+    Expansion
+    expDiff(double a, double b) {
+      Expansion h{ 0.0 };
+      Expansion tmp;
+      growExpansion(h, a, tmp);
+      growExpansion(tmp, -b, h);
+      return h;
+    }
+
+    int32
+    expSign(const Expansion& e) {
+      //Components are sorted by increasing magnitude and zeroes are removed,
+      //so the last one dominates the sign of the whole expansion.
+      const double top = e.back();
+      return top > 0.0 ? 1 : (top < 0.0 ? -1 : 0);
+    }
+
+    struct DPoint
+    {
+      double x;
+      double y;
+      double z;
+    };
+
+    int32
+    orient3dExact(const DPoint& a, const DPoint& b, const DPoint& c, const DPoint& d) {
+      const Expansion adx = expDiff(a.x, d.x), ady = expDiff(a.y, d.y), adz = expDiff(a.z, d.z);
+      const Expansion bdx = expDiff(b.x, d.x), bdy = expDiff(b.y, d.y), bdz = expDiff(b.z, d.z);
+      const Expansion cdx = expDiff(c.x, d.x), cdy = expDiff(c.y, d.y), cdz = expDiff(c.z, d.z);
+
+      const Expansion t0 = expMul(adz, expSub(expMul(bdx, cdy), expMul(cdx, bdy)));
+      const Expansion t1 = expMul(bdz, expSub(expMul(cdx, ady), expMul(adx, cdy)));
+      const Expansion t2 = expMul(cdz, expSub(expMul(adx, bdy), expMul(bdx, ady)));
+      return expSign(expSum(expSum(t0, t1), t2));
+    }
+
+    /**
+     * @brief Returns a positive value if @p d lies below the plane passing
+     *        through @p a, @p b and @p c (the three points appear in counter
+     *        clockwise order when seen from above), negative if it lies above
+     *        and zero if the four points are coplanar.
+     */
+    int32
+    orient3d(const DPoint& a, const DPoint& b, const DPoint& c, const DPoint& d) {
+      const double adx = a.x - d.x, ady = a.y - d.y, adz = a.z - d.z;
+      const double bdx = b.x - d.x, bdy = b.y - d.y, bdz = b.z - d.z;
+      const double cdx = c.x - d.x, cdy = c.y - d.y, cdz = c.z - d.z;
+
+      const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+      const double cdxady = cdx * ady, adxcdy = adx * cdy;
+      const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+      const double det = adz * (bdxcdy - cdxbdy) +
+                         bdz * (cdxady - adxcdy) +
+                         cdz * (adxbdy - bdxady);
+
+      const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                               (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                               (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+      const double errBound = s_orientErrBound * permanent;
+      if (det > errBound) {
+        return 1;
+      }
+      if (-det > errBound) {
+        return -1;
+      }
+
+      return orient3dExact(a, b, c, d);
+    }
+
+    int32
+    inSphereExact(const DPoint& a,
+                  const DPoint& b,
+                  const DPoint& c,
+                  const DPoint& d,
+                  const DPoint& e) {
+      const Expansion aex = expDiff(a.x, e.x), aey = expDiff(a.y, e.y), aez = expDiff(a.z, e.z);
+      const Expansion bex = expDiff(b.x, e.x), bey = expDiff(b.y, e.y), bez = expDiff(b.z, e.z);
+      const Expansion cex = expDiff(c.x, e.x), cey = expDiff(c.y, e.y), cez = expDiff(c.z, e.z);
+      const Expansion dex = expDiff(d.x, e.x), dey = expDiff(d.y, e.y), dez = expDiff(d.z, e.z);
+
+      const Expansion ab = expSub(expMul(aex, bey), expMul(bex, aey));
+      const Expansion bc = expSub(expMul(bex, cey), expMul(cex, bey));
+      const Expansion cd = expSub(expMul(cex, dey), expMul(dex, cey));
+      const Expansion da = expSub(expMul(dex, aey), expMul(aex, dey));
+      const Expansion ac = expSub(expMul(aex, cey), expMul(cex, aey));
+      const Expansion bd = expSub(expMul(bex, dey), expMul(dex, bey));
+
+      const Expansion abc = expSum(expSub(expMul(aez, bc), expMul(bez, ac)), expMul(cez, ab));
+      const Expansion bcd = expSum(expSub(expMul(bez, cd), expMul(cez, bd)), expMul(dez, bc));
+      const Expansion cda = expSum(expSum(expMul(cez, da), expMul(dez, ac)), expMul(aez, cd));
+      const Expansion dab = expSum(expSum(expMul(dez, ab), expMul(aez, bd)), expMul(bez, da));
+
+      auto lift = [](const Expansion& x, const Expansion& y, const Expansion& z) {
+        return expSum(expSum(expMul(x, x), expMul(y, y)), expMul(z, z));
+      };
+
+      const Expansion alift = lift(aex, aey, aez);
+      const Expansion blift = lift(bex, bey, bez);
+      const Expansion clift = lift(cex, cey, cez);
+      const Expansion dlift = lift(dex, dey, dez);
+
+      const Expansion det = expSum(expSub(expMul(dlift, abc), expMul(clift, dab)),
+                                   expSub(expMul(blift, cda), expMul(alift, bcd)));
+      return expSign(det);
+    }
+
+    /**
+     * @brief Returns a positive value if @p e lies inside the sphere passing
+     *        through @p a, @p b, @p c and @p d, negative if it lies outside
+     *        and zero if the five points are cospherical. The first four
+     *        points must have a positive orient3d().
+     */
+    int32
+    inSphere(const DPoint& a,
+             const DPoint& b,
+             const DPoint& c,
+             const DPoint& d,
+             const DPoint& e) {
+      const double aex = a.x - e.x, aey = a.y - e.y, aez = a.z - e.z;
+      const double bex = b.x - e.x, bey = b.y - e.y, bez = b.z - e.z;
+      const double cex = c.x - e.x, cey = c.y - e.y, cez = c.z - e.z;
+      const double dex = d.x - e.x, dey = d.y - e.y, dez = d.z - e.z;
+
+      const double aexbey = aex * bey, bexaey = bex * aey;
+      const double bexcey = bex * cey, cexbey = cex * bey;
+      const double cexdey = cex * dey, dexcey = dex * cey;
+      const double dexaey = dex * aey, aexdey = aex * dey;
+      const double aexcey = aex * cey, cexaey = cex * aey;
+      const double bexdey = bex * dey, dexbey = dex * bey;
+
+      const double ab = aexbey - bexaey;
+      const double bc = bexcey - cexbey;
+      const double cd = cexdey - dexcey;
+      const double da = dexaey - aexdey;
+      const double ac = aexcey - cexaey;
+      const double bd = bexdey - dexbey;
+
+      const double abc = aez * bc - bez * ac + cez * ab;
+      const double bcd = bez * cd - cez * bd + dez * bc;
+      const double cda = cez * da + dez * ac + aez * cd;
+      const double dab = dez * ab + aez * bd + bez * da;
+
+      const double alift = aex * aex + aey * aey + aez * aez;
+      const double blift = bex * bex + bey * bey + bez * bez;
+      const double clift = cex * cex + cey * cey + cez * cez;
+      const double dlift = dex * dex + dey * dey + dez * dez;
+
+      const double det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+      const double aezp = std::abs(aez), bezp = std::abs(bez);
+      const double cezp = std::abs(cez), dezp = std::abs(dez);
+      const double aexbeyp = std::abs(aexbey), bexaeyp = std::abs(bexaey);
+      const double bexceyp = std::abs(bexcey), cexbeyp = std::abs(cexbey);
+      const double cexdeyp = std::abs(cexdey), dexceyp = std::abs(dexcey);
+      const double dexaeyp = std::abs(dexaey), aexdeyp = std::abs(aexdey);
+      const double aexceyp = std::abs(aexcey), cexaeyp = std::abs(cexaey);
+      const double bexdeyp = std::abs(bexdey), dexbeyp = std::abs(dexbey);
+
+      const double permanent =
+        ((cexdeyp + dexceyp) * bezp +
+         (dexbeyp + bexdeyp) * cezp +
+         (bexceyp + cexbeyp) * dezp) * alift +
+        ((dexaeyp + aexdeyp) * cezp +
+         (aexceyp + cexaeyp) * dezp +
+         (cexdeyp + dexceyp) * aezp) * blift +
+        ((aexbeyp + bexaeyp) * dezp +
+         (bexdeyp + dexbeyp) * aezp +
+         (dexaeyp + aexdeyp) * bezp) * clift +
+        ((bexceyp + cexbeyp) * aezp +
+         (cexaeyp + aexceyp) * bezp +
+         (aexbeyp + bexaeyp) * cezp) * dlift;
+
+      const double errBound = s_inSphereErrBound * permanent;
+      if (det > errBound) {
+        return 1;
+      }
+      if (-det > errBound) {
+        return -1;
+      }
+
+      return inSphereExact(a, b, c, d, e);
+    }
+
+    /*************************************************************************/
+    /**
+     * Spatial sorting
+     */
+    /*************************************************************************/
+
+    /**
+     * @brief Number of bits per axis used to quantize the points before
+     *        computing their position along the Hilbert curve.
+     */
+    const uint32 HILBERT_BITS = 16;
+
+    /**
+     * @brief Returns the position along a 3D Hilbert curve of a quantized
+     *        point (John Skilling, "Programming the Hilbert curve", 2004).
+     */
+    uint64
+    hilbertKey(uint32 x, uint32 y, uint32 z) {
+      uint32 axes[3] = { x, y, z };
+      const uint32 topBit = 1u << (HILBERT_BITS - 1);
+
+      //Inverse undo
+      for (uint32 q = topBit; q > 1; q >>= 1) {
+        const uint32 p = q - 1;
+        for (uint32 i = 0; i < 3; ++i) {
+          if (axes[i] & q) {
+            axes[0] ^= p;
+          }
+          else {
+            const uint32 t = (axes[0] ^ axes[i]) & p;
+            axes[0] ^= t;
+            axes[i] ^= t;
+          }
+        }
+      }
+
+      //Gray encode
+      axes[1] ^= axes[0];
+      axes[2] ^= axes[1];
+      uint32 t = 0;
+      for (uint32 q = topBit; q > 1; q >>= 1) {
+        if (axes[2] & q) {
+          t ^= q - 1;
+        }
+      }
+      for (uint32& axis : axes) {
+        axis ^= t;
+      }
+
+      //Interleave the transposed bits
+      uint64 key = 0;
+      for (int32 bit = static_cast<int32>(HILBERT_BITS) - 1; bit >= 0; --bit) {
+        for (const uint32 axis : axes) {
+          key = (key << 1) | ((axis >> bit) & 1u);
+        }
+      }
+      return key;
+    }
+
+    /*************************************************************************/
+    /**
+     * Tetrahedral mesh
+     */
+    /*************************************************************************/
+
+    /**
+     * @brief Vertex indices of the face opposite to each vertex of a
+     *        positively oriented tetrahedron, wound counter clockwise when
+     *        seen from outside the tetrahedron.
+     */
+    const int32 s_faceVertices[4][3] = { { 1, 3, 2 },
+                                         { 0, 2, 3 },
+                                         { 1, 0, 3 },
+                                         { 0, 1, 2 } };
+
+    /**
+     * @brief Minimum number of points of a round walked by each lane. Lanes
+     *        insert their points at the same time, so shorter lanes means
+     *        more parallelism but more cavities colliding with each other
+     *        and getting deferred.
+     */
+    const uint32 MIN_LANE_LENGTH = 512;
+
+    /**
+     * @brief Upper limit of points inserted in a single batch.
+     */
+    const uint32 MAX_BATCH_SIZE = 4096;
+
+    /**
+     * @brief Rounds smaller than this are merged into the first BRIO round.
+     */
+    const uint32 MIN_BRIO_ROUND = 256;
+
+    /**
+     * @brief Super tetrahedron size relative to the point set extent.
+     */
+    const double SUPER_TETRAHEDRON_SCALE = 1.0e5;
+
+    struct TetData
+    {
+      int32 v[4];
+      int32 n[4];
+    };
+
+    struct BoundaryFace
+    {
+      int32 v[4];         //Vertices of the new tetrahedron (face + new point)
+      int32 face;         //Index of the new point inside v (opposite outside)
+      int32 outside;      //Tetrahedron on the other side, or -1
+      int32 outsideFace;  //Index of the shared face inside the outside tet
+    };
+
+    struct InsertionJob
+    {
+      int32 point = -1;
+      int32 lane = 0;
+      int32 start = -1;
+      bool duplicate = false;
+      Vector<int32> cavity;
+      Vector<BoundaryFace> boundary;
+      Vector<int32> slots;
+    };
+
+    /**
+     * @brief Small open addressing set used to track the tetrahedrons visited
+     *        while growing a cavity. Entry state is 1 for tetrahedrons in the
+     *        cavity, 2 for tetrahedrons tested and rejected.
+     */
+    class VisitedSet
+    {
+     public:
+      void
+      reset() {
+        for (const uint32 slot : m_used) {
+          m_keys[slot] = -1;
+        }
+        m_used.clear();
+
+        if (m_keys.empty()) {
+          m_keys.resize(256, -1);
+          m_states.resize(256, 0);
+        }
+      }
+
+      uint8
+      get(int32 key) const {
+        const uint32 mask = static_cast<uint32>(m_keys.size()) - 1;
+        for (uint32 slot = hash(key) & mask; ; slot = (slot + 1) & mask) {
+          if (m_keys[slot] == key) {
+            return m_states[slot];
+          }
+          if (m_keys[slot] < 0) {
+            return 0;
+          }
+        }
+      }
+
+      void
+      set(int32 key, uint8 state) {
+        if ((m_used.size() + 1) * 2 > m_keys.size()) {
+          grow();
+        }
+
+        const uint32 mask = static_cast<uint32>(m_keys.size()) - 1;
+        for (uint32 slot = hash(key) & mask; ; slot = (slot + 1) & mask) {
+          if (m_keys[slot] == key) {
+            m_states[slot] = state;
+            return;
+          }
+          if (m_keys[slot] < 0) {
+            m_keys[slot] = key;
+            m_states[slot] = state;
+            m_used.push_back(slot);
+            return;
+          }
+        }
+      }
+
+     private:
+      static uint32
+      hash(int32 key) {
+        return static_cast<uint32>(key) * 2654435761u;
+      }
+
+      void
+      grow() {
+        Vector<int32> oldKeys;
+        Vector<uint8> oldStates;
+        oldKeys.swap(m_keys);
+        oldStates.swap(m_states);
+
+        const SIZE_T newSize = oldKeys.size() * 2;
+        m_keys.assign(newSize, -1);
+        m_states.assign(newSize, 0);
+        m_used.clear();
+        for (SIZE_T i = 0; i < oldKeys.size(); ++i) {
+          if (oldKeys[i] >= 0) {
+            set(oldKeys[i], oldStates[i]);
+          }
+        }
+      }
+
+      Vector<int32> m_keys;
+      Vector<uint8> m_states;
+      Vector<uint32> m_used;
+    };
+
+    class Tetrahedralizer
+    {
+     public:
+      explicit Tetrahedralizer(const Vector<Vector3>& points)
+        : m_numInputPoints(static_cast<int32>(points.size())) {
+        m_points.resize(points.size() + 4);
+        for (SIZE_T i = 0; i < points.size(); ++i) {
+          m_points[i] = { points[i].x, points[i].y, points[i].z };
+        }
+      }
+
+      void
+      run() {
+        Vector<uint32> levels;
+        m_inputIndex = computeInsertionOrder(levels);
+
+        //Keep the points in insertion order, so the points touched by the
+        //predicates are close in memory as well as in space.
+        Vector<DPoint> sorted(m_points.size());
+        for (SIZE_T i = 0; i < m_inputIndex.size(); ++i) {
+          sorted[i] = m_points[m_inputIndex[i]];
+        }
+        m_points.swap(sorted);
+
+        createSuperTetrahedron();
+
+        Vector<InsertionJob> jobs;
+        Vector<int32> laneHints;
+        Vector<std::pair<int32, int32>> batch; //(point, lane)
+        Vector<std::pair<int32, int32>> pending;
+
+        for (SIZE_T level = 0; level + 1 < levels.size(); ++level) {
+          const uint32 levelBegin = levels[level];
+          const uint32 levelEnd = levels[level + 1];
+          const uint32 levelSize = levelEnd - levelBegin;
+
+          const uint32 numLanes = std::clamp(levelSize / MIN_LANE_LENGTH, 1u, MAX_BATCH_SIZE);
+          const uint32 laneLength = (levelSize + numLanes - 1) / numLanes;
+
+          laneHints.assign(numLanes, m_lastTet);
+          for (auto& entry : pending) {
+            entry.second = 0;
+          }
+
+          //Each lane walks a contiguous piece of the Hilbert sorted round, so
+          //every batch gets points far apart from each other while every
+          //lane keeps a short walk from its previous insertion.
+          for (uint32 step = 0; step < laneLength; ++step) {
+            batch.swap(pending);
+            pending.clear();
+
+            for (uint32 lane = 0; lane < numLanes; ++lane) {
+              const uint32 idx = levelBegin + lane * laneLength + step;
+              if (idx < levelEnd) {
+                batch.emplace_back(static_cast<int32>(idx), static_cast<int32>(lane));
+              }
+            }
+
+            insertBatch(batch, jobs, laneHints, pending);
+          }
+
+          while (!pending.empty()) {
+            batch.swap(pending);
+            pending.clear();
+            insertBatch(batch, jobs, laneHints, pending);
+          }
+        }
+      }
+
+      void
+      extract(TetrahedronVolume& volume) const {
+        const int32 numTets = static_cast<int32>(m_tets.size());
+        Vector<int32> remap(m_tets.size(), -1);
+
+        int32 numOutput = 0;
+        for (int32 i = 0; i < numTets; ++i) {
+          const TetData& tet = m_tets[i];
+          if (tet.v[0] < 0) {
+            continue;
+          }
+
+          bool isSuper = false;
+          for (const int32 v : tet.v) {
+            isSuper |= v >= m_numInputPoints;
+          }
+
+          if (!isSuper) {
+            remap[i] = numOutput++;
+          }
+        }
+
+        volume.tetrahedra.resize(numOutput);
+        for (int32 i = 0; i < numTets; ++i) {
+          const int32 outIdx = remap[i];
+          if (outIdx < 0) {
+            continue;
+          }
+
+          const TetData& tet = m_tets[i];
+          Tetrahedron& output = volume.tetrahedra[outIdx];
+          for (int32 j = 0; j < 4; ++j) {
+            output.vertices[j] = m_inputIndex[tet.v[j]];
+            output.neighbors[j] = tet.n[j] < 0 ? -1 : remap[tet.n[j]];
+
+            if (output.neighbors[j] < 0) {
+              TetrahedronFace face;
+              for (int32 k = 0; k < 3; ++k) {
+                face.vertices[k] = m_inputIndex[tet.v[s_faceVertices[j][k]]];
+              }
+              face.tetrahedron = outIdx;
+              volume.outerFaces.push_back(face);
+            }
+          }
+        }
+      }
+
+     private:
+      /**
+       * @brief Builds the BRIO insertion order. @p levels receives the first
+       *        index of every round plus the total count as the last entry.
+       */
+      Vector<int32>
+      computeInsertionOrder(Vector<uint32>& levels) {
+        const uint32 count = static_cast<uint32>(m_numInputPoints);
+
+        DPoint minPt = m_points[0];
+        DPoint maxPt = m_points[0];
+        for (uint32 i = 1; i < count; ++i) {
+          const DPoint& pt = m_points[i];
+          minPt = { std::min(minPt.x, pt.x), std::min(minPt.y, pt.y), std::min(minPt.z, pt.z) };
+          maxPt = { std::max(maxPt.x, pt.x), std::max(maxPt.y, pt.y), std::max(maxPt.z, pt.z) };
+        }
+        m_boundsMin = minPt;
+        m_boundsMax = maxPt;
+
+        const double maxQuantized = static_cast<double>((1u << HILBERT_BITS) - 1);
+        auto axisScale = [maxQuantized](double extent) {
+          return extent > 0.0 ? maxQuantized / extent : 0.0;
+        };
+        const DPoint scale = { axisScale(maxPt.x - minPt.x),
+                               axisScale(maxPt.y - minPt.y),
+                               axisScale(maxPt.z - minPt.z) };
+
+        Vector<uint64> keys(count);
+        parallelForChunks("Triangulation", count, 16384, [&](uint32 begin, uint32 end) {
+          for (uint32 i = begin; i < end; ++i) {
+            const DPoint& pt = m_points[i];
+            keys[i] = hilbertKey(static_cast<uint32>((pt.x - minPt.x) * scale.x),
+                                 static_cast<uint32>((pt.y - minPt.y) * scale.y),
+                                 static_cast<uint32>((pt.z - minPt.z) * scale.z));
+          }
+        });
+
+        Vector<int32> order(count);
+        for (uint32 i = 0; i < count; ++i) {
+          order[i] = static_cast<int32>(i);
+        }
+
+        //Fixed seed so the output is deterministic for the same input
+        Random rnd(0x5EED);
+        for (uint32 i = count - 1; i > 0; --i) {
+          std::swap(order[i], order[rnd.get() % (i + 1)]);
+        }
+
+        //Every round holds half of the points not in the previous rounds
+        levels.clear();
+        uint32 end = count;
+        levels.push_back(end);
+        while (end / 2 >= MIN_BRIO_ROUND) {
+          end /= 2;
+          levels.push_back(end);
+        }
+        levels.push_back(0);
+        std::reverse(levels.begin(), levels.end());
+
+        for (SIZE_T i = 0; i + 1 < levels.size(); ++i) {
+          std::sort(order.begin() + levels[i],
+                    order.begin() + levels[i + 1],
+                    [&keys](int32 lhs, int32 rhs) {
+                      return keys[lhs] < keys[rhs];
+                    });
+        }
+
+        return order;
+      }
+
+      void
+      createSuperTetrahedron() {
+        const DPoint center = { (m_boundsMin.x + m_boundsMax.x) * 0.5,
+                                (m_boundsMin.y + m_boundsMax.y) * 0.5,
+                                (m_boundsMin.z + m_boundsMax.z) * 0.5 };
+        double extent = std::max({ m_boundsMax.x - m_boundsMin.x,
+                                   m_boundsMax.y - m_boundsMin.y,
+                                   m_boundsMax.z - m_boundsMin.z });
+        if (extent <= 0.0) {
+          extent = 1.0;
+        }
+
+        const double size = extent * SUPER_TETRAHEDRON_SCALE;
+        const int32 base = m_numInputPoints;
+        m_points[base + 0] = { center.x + size, center.y + size, center.z + size };
+        m_points[base + 1] = { center.x + size, center.y - size, center.z - size };
+        m_points[base + 2] = { center.x - size, center.y + size, center.z - size };
+        m_points[base + 3] = { center.x - size, center.y - size, center.z + size };
+
+        TetData tet = { { base, base + 1, base + 2, base + 3 }, { -1, -1, -1, -1 } };
+        if (orientTet(tet.v) < 0) {
+          std::swap(tet.v[0], tet.v[1]);
+        }
+
+        m_tets.push_back(tet);
+        m_marks.push_back(0);
+        m_lastTet = 0;
+      }
+
+      int32
+      orientTet(const int32 v[4]) const {
+        return orient3d(m_points[v[0]], m_points[v[1]], m_points[v[2]], m_points[v[3]]);
+      }
+
+      /**
+       * @brief Returns the orientation of a tetrahedron when its vertex
+       *        @p idx is replaced by the point @p p. This is the sign of the
+       *        barycentric coordinate of @p p relative to that vertex.
+       */
+      int32
+      orientReplaced(const TetData& tet, int32 idx, int32 p) const {
+        int32 v[4] = { tet.v[0], tet.v[1], tet.v[2], tet.v[3] };
+        v[idx] = p;
+        return orientTet(v);
+      }
+
+      bool
+      isInConflict(int32 tetIdx, int32 p) const {
+        const TetData& tet = m_tets[tetIdx];
+        return inSphere(m_points[tet.v[0]],
+                        m_points[tet.v[1]],
+                        m_points[tet.v[2]],
+                        m_points[tet.v[3]],
+                        m_points[p]) > 0;
+      }
+
+      /**
+       * @brief Finds the tetrahedron that contains the point @p p using a
+       *        stochastic visibility walk starting at @p start.
+       */
+      int32
+      locate(int32 p, int32 start, uint32& rng) const {
+        int32 current = (start >= 0 && m_tets[start].v[0] >= 0) ? start : m_lastTet;
+        int32 previous = -1;
+        const SIZE_T maxSteps = m_tets.size() + 64;
+
+        for (SIZE_T steps = 0; steps < maxSteps; ++steps) {
+          const TetData& tet = m_tets[current];
+
+          rng = rng * 1664525u + 1013904223u;
+          const int32 offset = static_cast<int32>(rng >> 30);
+
+          int32 next = -1;
+          for (int32 k = 0; k < 4; ++k) {
+            const int32 face = (offset + k) & 3;
+            const int32 neighbor = tet.n[face];
+            if (neighbor < 0 || neighbor == previous) {
+              continue;
+            }
+
+            if (orientReplaced(tet, face, p) < 0) {
+              next = neighbor;
+              break;
+            }
+          }
+
+          if (next < 0) {
+            return current;
+          }
+
+          previous = current;
+          current = next;
+        }
+
+        //The walk can't cycle with exact predicates, this is just a safe guard
+        for (int32 i = 0; i < static_cast<int32>(m_tets.size()); ++i) {
+          const TetData& tet = m_tets[i];
+          if (tet.v[0] < 0) {
+            continue;
+          }
+
+          bool inside = true;
+          for (int32 face = 0; face < 4 && inside; ++face) {
+            inside = orientReplaced(tet, face, p) >= 0;
+          }
+
+          if (inside) {
+            return i;
+          }
+        }
+
+        GE_ASSERT(false && "Point is outside of the super tetrahedron.");
+        return m_lastTet;
+      }
+
+      /**
+       * @brief Locates the job point and finds its conflict cavity and the
+       *        boundary faces that will be connected to it. Read only, so it
+       *        can run for many jobs at once.
+       */
+      void
+      buildCavity(InsertionJob& job, VisitedSet& visited) const {
+        job.cavity.clear();
+        job.boundary.clear();
+        job.duplicate = false;
+
+        const int32 p = job.point;
+        uint32 rng = static_cast<uint32>(p) * 747796405u + 2891336453u;
+        const int32 first = locate(p, job.start, rng);
+
+        const DPoint& pt = m_points[p];
+        for (const int32 v : m_tets[first].v) {
+          const DPoint& other = m_points[v];
+          if (other.x == pt.x && other.y == pt.y && other.z == pt.z) {
+            job.duplicate = true;
+            return;
+          }
+        }
+
+        visited.reset();
+        job.cavity.push_back(first);
+        visited.set(first, 1);
+
+        SIZE_T processed = 0;
+        bool grown = true;
+        while (grown) {
+          //Flood fill through the tetrahedrons whose circumsphere contains p
+          for (; processed < job.cavity.size(); ++processed) {
+            const TetData& tet = m_tets[job.cavity[processed]];
+            for (const int32 neighbor : tet.n) {
+              if (neighbor < 0 || 0 != visited.get(neighbor)) {
+                continue;
+              }
+
+              if (isInConflict(neighbor, p)) {
+                job.cavity.push_back(neighbor);
+                visited.set(neighbor, 1);
+              }
+              else {
+                visited.set(neighbor, 2);
+              }
+            }
+          }
+
+          //Collect the boundary. On degenerate inputs p may be coplanar with
+          //a boundary face, in that case the cavity absorbs the tetrahedron
+          //behind that face so no flat tetrahedrons get created.
+          grown = false;
+          job.boundary.clear();
+          for (SIZE_T i = 0; i < job.cavity.size() && !grown; ++i) {
+            const int32 tetIdx = job.cavity[i];
+            const TetData& tet = m_tets[tetIdx];
+
+            for (int32 face = 0; face < 4; ++face) {
+              const int32 neighbor = tet.n[face];
+              if (neighbor >= 0 && 1 == visited.get(neighbor)) {
+                continue;
+              }
+
+              if (neighbor >= 0 && orientReplaced(tet, face, p) <= 0) {
+                job.cavity.push_back(neighbor);
+                visited.set(neighbor, 1);
+                grown = true;
+                break;
+              }
+
+              BoundaryFace boundary;
+              for (int32 k = 0; k < 4; ++k) {
+                boundary.v[k] = tet.v[k];
+              }
+              boundary.v[face] = p;
+              boundary.face = face;
+              boundary.outside = neighbor;
+              boundary.outsideFace = -1;
+
+              if (neighbor >= 0) {
+                const TetData& outside = m_tets[neighbor];
+                for (int32 k = 0; k < 4; ++k) {
+                  if (outside.n[k] == tetIdx) {
+                    boundary.outsideFace = k;
+                    break;
+                  }
+                }
+              }
+
+              job.boundary.push_back(boundary);
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Checks that the cavity of @p job doesn't touch any cavity
+       *        already accepted in this batch and reserves the tetrahedron
+       *        slots for its new tetrahedrons.
+       */
+      bool
+      reserve(InsertionJob& job, SIZE_T& numTets) {
+        for (const int32 tetIdx : job.cavity) {
+          if (m_marks[tetIdx] == m_stamp) {
+            return false;
+          }
+        }
+        for (const BoundaryFace& face : job.boundary) {
+          if (face.outside >= 0 && m_marks[face.outside] == m_stamp) {
+            return false;
+          }
+        }
+
+        for (const int32 tetIdx : job.cavity) {
+          m_marks[tetIdx] = m_stamp;
+        }
+        for (const BoundaryFace& face : job.boundary) {
+          if (face.outside >= 0) {
+            m_marks[face.outside] = m_stamp;
+          }
+        }
+
+        job.slots.clear();
+        for (SIZE_T i = 0; i < job.boundary.size(); ++i) {
+          if (i < job.cavity.size()) {
+            job.slots.push_back(job.cavity[i]);
+          }
+          else if (!m_freeSlots.empty()) {
+            job.slots.push_back(m_freeSlots.back());
+            m_freeSlots.pop_back();
+          }
+          else {
+            job.slots.push_back(static_cast<int32>(numTets++));
+          }
+        }
+
+        for (SIZE_T i = job.boundary.size(); i < job.cavity.size(); ++i) {
+          m_tets[job.cavity[i]].v[0] = -1;
+          m_freeSlots.push_back(job.cavity[i]);
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Replaces the cavity of a reserved job by the tetrahedrons
+       *        connecting its boundary faces to the new point.
+       */
+      void
+      apply(const InsertionJob& job, Vector<std::pair<uint64, int32>>& edges) {
+        edges.clear();
+        for (SIZE_T i = 0; i < job.boundary.size(); ++i) {
+          const BoundaryFace& face = job.boundary[i];
+          const int32 slot = job.slots[i];
+
+          TetData& tet = m_tets[slot];
+          for (int32 k = 0; k < 4; ++k) {
+            tet.v[k] = face.v[k];
+            tet.n[k] = -1;
+          }
+          tet.n[face.face] = face.outside;
+          if (face.outside >= 0) {
+            m_tets[face.outside].n[face.outsideFace] = slot;
+          }
+
+          //The faces that contain p are shared with other new tetrahedrons,
+          //and they are identified by their edge on the cavity boundary.
+          for (int32 k = 0; k < 4; ++k) {
+            if (k == face.face) {
+              continue;
+            }
+
+            int32 edge[2];
+            int32 numEdgeVerts = 0;
+            for (int32 m = 0; m < 4; ++m) {
+              if (m != k && m != face.face) {
+                edge[numEdgeVerts++] = face.v[m];
+              }
+            }
+
+            const int32 a = std::min(edge[0], edge[1]);
+            const int32 b = std::max(edge[0], edge[1]);
+
+            const uint64 key = (static_cast<uint64>(a) << 32) | static_cast<uint32>(b);
+            edges.emplace_back(key, slot * 4 + k);
+          }
+        }
+
+        std::sort(edges.begin(), edges.end());
+        for (SIZE_T i = 0; i + 1 < edges.size(); i += 2) {
+          GE_ASSERT(edges[i].first == edges[i + 1].first);
+          const int32 lhs = edges[i].second;
+          const int32 rhs = edges[i + 1].second;
+          m_tets[lhs / 4].n[lhs % 4] = rhs / 4;
+          m_tets[rhs / 4].n[rhs % 4] = lhs / 4;
+        }
+      }
+
+      void
+      insertBatch(const Vector<std::pair<int32, int32>>& batch,
+                  Vector<InsertionJob>& jobs,
+                  Vector<int32>& laneHints,
+                  Vector<std::pair<int32, int32>>& deferred) {
+        const uint32 count = static_cast<uint32>(batch.size());
+        if (jobs.size() < count) {
+          jobs.resize(count);
+        }
+
+        for (uint32 i = 0; i < count; ++i) {
+          jobs[i].point = batch[i].first;
+          jobs[i].lane = batch[i].second;
+          jobs[i].start = laneHints[batch[i].second];
+        }
+
+        parallelForChunks("Triangulation", count, 32, [&](uint32 begin, uint32 end) {
+          VisitedSet visited;
+          for (uint32 i = begin; i < end; ++i) {
+            buildCavity(jobs[i], visited);
+          }
+        });
+
+        ++m_stamp;
+        SIZE_T numTets = m_tets.size();
+        Vector<uint32> accepted;
+        accepted.reserve(count);
+        for (uint32 i = 0; i < count; ++i) {
+          InsertionJob& job = jobs[i];
+          if (job.duplicate) {
+            continue;
+          }
+
+          if (reserve(job, numTets)) {
+            accepted.push_back(i);
+          }
+          else {
+            deferred.push_back(batch[i]);
+          }
+        }
+
+        m_tets.resize(numTets);
+        m_marks.resize(numTets, 0);
+
+        const uint32 numAccepted = static_cast<uint32>(accepted.size());
+        parallelForChunks("Triangulation", numAccepted, 32, [&](uint32 begin, uint32 end) {
+          Vector<std::pair<uint64, int32>> edges;
+          for (uint32 i = begin; i < end; ++i) {
+            apply(jobs[accepted[i]], edges);
+          }
+        });
+
+        for (const uint32 i : accepted) {
+          laneHints[jobs[i].lane] = jobs[i].slots[0];
+        }
+        if (numAccepted > 0) {
+          m_lastTet = jobs[accepted.back()].slots[0];
+        }
+      }
+
+      int32 m_numInputPoints;
+      Vector<DPoint> m_points;
+      Vector<int32> m_inputIndex;
+      Vector<TetData> m_tets;
+      Vector<uint32> m_marks;
+      Vector<int32> m_freeSlots;
+      DPoint m_boundsMin = { 0.0, 0.0, 0.0 };
+      DPoint m_boundsMax = { 0.0, 0.0, 0.0 };
+      int32 m_lastTet = 0;
+      uint32 m_stamp = 0;
+    };
+  }
+
+  TetrahedronVolume
+  Triangulation::tetrahedralize(const Vector<Vector3>& points) {
+    TetrahedronVolume volume;
+    if (points.size() < 4) {
+      return volume;
+    }
+
+    Tetrahedralizer tetrahedralizer(points);
+    tetrahedralizer.run();
+    tetrahedralizer.extract(volume);
+    return volume;
+  }
+}
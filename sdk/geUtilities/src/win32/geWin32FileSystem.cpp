@@ -356,6 +356,60 @@ namespace geEngineSDK {
     FindClose(fileHandle);
   }
 
+  bool
+  FileSystem::readDirectory(const Path& dirPath,
+                            Vector<String>& files,
+                            Vector<String>& directories,
+                            time_t& lastModifiedTime) {
+    WString findPath = UTF8::toWide(dirPath.toString());
+    if (!win32_pathExists(findPath) || !win32_isDirectory(findPath)) {
+      return false;
+    }
+
+    lastModifiedTime = win32_getLastModifiedTime(findPath);
+
+    if (!findPath.empty() && L'\\' != findPath.back() && L'/' != findPath.back()) {
+      findPath.append(L"\\");
+    }
+    findPath.append(L"*");
+
+    //Basic info skips the short 8.3 names, and the large fetch asks for more
+    //entries per call to the file system
+    WIN32_FIND_DATAW findData;
+    HANDLE fileHandle = FindFirstFileExW(findPath.c_str(),
+                                         FindExInfoBasic,
+                                         &findData,
+                                         FindExSearchNameMatch,
+                                         nullptr,
+                                         FIND_FIRST_EX_LARGE_FETCH);
+    if (INVALID_HANDLE_VALUE == fileHandle) {
+      win32_handleError(GetLastError(), findPath);
+      return false;
+    }
+
+    do {
+      const UNICHAR* name = findData.cFileName;
+      if (L'.' == name[0] &&
+          (L'\0' == name[1] || (L'.' == name[1] && L'\0' == name[2]))) {
+        continue;
+      }
+
+      if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+        directories.push_back(UTF8::fromWide(WString(name)));
+      }
+      else {
+        files.push_back(UTF8::fromWide(WString(name)));
+      }
+    } while (FALSE != FindNextFileW(fileHandle, &findData));
+
+    if (GetLastError() != ERROR_NO_MORE_FILES) {
+      win32_handleError(GetLastError(), findPath);
+    }
+
+    FindClose(fileHandle);
+    return true;
+  }
+
   bool
   FileSystem::iterate(const Path& dirPath,
                       const function<bool(const Path&)>& fileCallback,
@@ -2,6 +2,7 @@
 
 #include <geModel.h>
 #include <geVertexDeclaration.h>
+#include <geVertexPacker.h>
 
 namespace geEngineSDK {
 
@@ -25,6 +26,13 @@ namespace geEngineSDK {
 
     AABox bounds = AABox::EMPTY;
     Sphere boundingSphere;
+
+    //Simplified index ranges, placed after the indices of the submesh
+    Vector<SubMeshLod> lods;
+
+    //Coarsest LOD with its own compact positions, for occlusion culling
+    Vector<Vector3> occluderPositions;
+    Vector<uint32> occluderIndices;
   };
 
   struct ModelBuilderMeshGroup
@@ -113,6 +121,15 @@ namespace geEngineSDK {
 
     AABox m_bounds = AABox::EMPTY;
     Sphere m_boundingSphere;
+
+    //Quantization applied to the vertices of every mesh group on build()
+    VertexPackingOptions m_vertexPacking;
+
+    //LODs generated for each triangle list submesh as it gets appended, each
+    //one with m_lodReduction times the triangles of the previous. None by
+    //default, nothing draws them yet
+    uint32 m_lodCount = 0;
+    float m_lodReduction = 0.5f;
   };
 
 }
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include <geQuaternion.h>
 #include <geRenderAPI.h>
 #include <geMountManager.h>
+#include <geGameConfig.h>
+#include <geMeshOptimizer.h>
 
 #include <algorithm>
 
@@ -342,6 +344,37 @@ buildAnimationClipFromAssimp(const aiAnimation* anim,
   return clip;
 }
 
+/**
+ * @brief Welds and reorders a triangle list for the GPU, and logs the vertex
+ *        cache statistics before and after.
+ */
+static void
+optimizeTriangleList(const String& meshName,
+                     Vector<uint8>& vertices,
+                     uint32 vertexSize,
+                     uint32 positionOffset,
+                     Vector<uint32>& indices) {
+  const uint32 vertexCount = cast::st<uint32>(vertices.size() / vertexSize);
+  const auto before = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+
+  const uint32 newVertexCount = MeshOptimizer::optimize(vertices,
+                                                        vertexSize,
+                                                        positionOffset,
+                                                        indices);
+  const auto after = MeshOptimizer::analyzeVertexCache(indices, newVertexCount);
+
+  GE_LOG(kLog,
+         Generic,
+         "Optimized {0}: {1} -> {2} vertices, ACMR {3} -> {4}, ATVR {5} -> {6}",
+         meshName,
+         vertexCount,
+         newVertexCount,
+         before.acmr,
+         after.acmr,
+         before.atvr,
+         after.atvr);
+}
+
 static String CODEC_NAME = "Assimp Animation Loader Codec";
 static String CODEC_DESC = "This codec implements the Assimp Library "
                            "to load Animation Clips";
@@ -581,6 +614,10 @@ extern "C"
     }
 
     String meshName = mesh->mName.length > 0 ? String(mesh->mName.C_Str()) : String("Mesh");
+
+    if (PRIMITIVE_TOPOLOGY::TRIANGLELIST == topology) {
+      optimizeTriangleList(meshName, vertices, vertexSize, posOffset, indices);
+    }
     
     const uint32 meshGroupIndex = builder.findOrCreateStaticMeshGroup("StaticMeshGroup",
                                                                       vertexDecl,
@@ -778,6 +815,8 @@ extern "C"
     String meshName = mesh->mName.length > 0 ?
       String(mesh->mName.C_Str()) : String("SkinnedMesh");
 
+    optimizeTriangleList(meshName, vertices, vertexSize, posOffset, indices);
+
     const uint32 skinBindingIndex = builder.addSkinBinding(meshName + "_Skin", skinOffsets);
 
     const uint32 meshGroupIndex = builder.findOrCreateSkinnedMeshGroup("SkinnedMeshGroup",
@@ -885,6 +924,8 @@ extern "C"
     //flags |= aiProcess_PreTransformVertices;
     flags &= ~aiProcess_CalcTangentSpace;
     flags &= ~aiProcess_RemoveRedundantMaterials;
+    //Vertices are welded by the MeshOptimizer once they are in the final
+    //layout, which also catches the ones that only differed on dropped data
     flags &= ~aiProcess_JoinIdenticalVertices;
     
     HighResTimer profilingTimer;
@@ -899,6 +940,17 @@ extern "C"
     }
 
     ModelBuilder builder;
+
+    //Packed vertices need shaders that decode them, so they are opt-in
+    if (GameConfig::isStarted() &&
+        GameConfig::instance().getVar<bool>("MODELS", "PACKVERTICES", false).get()) {
+      builder.m_vertexPacking.packNormals = true;
+      builder.m_vertexPacking.packTexCoords = true;
+      builder.m_vertexPacking.packBlendWeights = true;
+    }
+    if (GameConfig::isStarted()) {
+      builder.m_lodCount = GameConfig::instance().getVar<uint32>("MODELS", "LODCOUNT", 0).get();
+    }
     SPtr<Skeleton> skeleton = buildSkeletonFromAssimpScene(pScene);
     if (nullptr != skeleton) {
       //skeleton->setName(filePath.getFilename(false) + "_Skeleton");
@@ -1,5 +1,6 @@
 #include "geModelBuilder.h"
 #include <geRenderAPI.h>
+#include <geMeshSimplifier.h>
 
 namespace geEngineSDK {
 
@@ -55,6 +56,76 @@ namespace geEngineSDK {
     m_boundingSphere = Sphere();
   }
 
+  /**
+   * Simplifies the indices of a triangle list submesh and appends every LOD
+   * after them in the indices of the group. The positions (and the normals
+   * and first uvs, when they are floats) must be in the vertices.
+   */
+  static void
+  appendSubMeshLods(ModelBuilderMeshGroup& group,
+                    ModelBuilderSubMesh& subMesh,
+                    const Vector<uint8>& vertices,
+                    const Vector<uint32>& indices,
+                    uint32 lodCount,
+                    float reduction) {
+    using VET = VERTEX_ELEMENT_TYPE::E;
+    using VES = VERTEX_ELEMENT_SEMANTIC::E;
+
+    if (0 == lodCount || PRIMITIVE_TOPOLOGY::TRIANGLELIST != group.topology) {
+      return;
+    }
+
+    const auto& props = group.vertexDecl->getProperties();
+    const VertexElement* position = props.findElementBySemantic(VES::POSITION);
+    if (nullptr == position || VET::FLOAT3 != position->getType()) {
+      return;
+    }
+
+    Vector<SimplifyAttribute> attributes;
+    const VertexElement* normal = props.findElementBySemantic(VES::NORMAL);
+    if (nullptr != normal && VET::FLOAT3 == normal->getType()) {
+      attributes.push_back(SimplifyAttribute{ normal->getOffset(), 3, 0.01f });
+    }
+
+    const VertexElement* texCoord = props.findElementBySemantic(VES::TEXCOORD);
+    if (nullptr != texCoord && VET::FLOAT2 == texCoord->getType()) {
+      attributes.push_back(SimplifyAttribute{ texCoord->getOffset(), 2, 0.01f });
+    }
+
+    auto lods = MeshSimplifier::generateLods(indices,
+                                             vertices,
+                                             group.vertexSize,
+                                             position->getOffset(),
+                                             attributes,
+                                             lodCount,
+                                             reduction);
+
+    for (const auto& lod : lods) {
+      SubMeshLod range;
+      range.m_firstIndex = cast::st<uint32>(group.indices.size());
+      range.m_indexCount = cast::st<uint32>(lod.indices.size());
+      range.m_error = lod.error;
+      subMesh.lods.push_back(range);
+
+      for (uint32 index : lod.indices) {
+        group.indices.push_back(subMesh.firstVertex + index);
+      }
+    }
+
+    //Skinned submeshes move away from their bind pose, they can't occlude
+    if (subMesh.isSkinned) {
+      return;
+    }
+
+    const Vector<uint32>& occluder = lods.empty() ? indices : lods.back().indices;
+    MeshSimplifier::extractPositions(occluder,
+                                     vertices,
+                                     group.vertexSize,
+                                     position->getOffset(),
+                                     subMesh.occluderPositions,
+                                     subMesh.occluderIndices);
+  }
+
   uint32
   ModelBuilder::addNode(const ModelNode& node) {
     m_nodes.push_back(node);
@@ -213,6 +284,8 @@ namespace geEngineSDK {
       group.indices.push_back(subMesh.firstVertex + index);
     }
 
+    appendSubMeshLods(group, subMesh, vertices, indices, m_lodCount, m_lodReduction);
+
     const uint32 subMeshIndex = cast::st<uint32>(group.subMeshes.size());
     group.subMeshes.push_back(subMesh);
 
@@ -286,6 +359,8 @@ namespace geEngineSDK {
       group.indices.push_back(subMesh.firstVertex + index);
     }
 
+    appendSubMeshLods(group, subMesh, vertices, indices, m_lodCount, m_lodReduction);
+
     const uint32 subMeshIndex = cast::st<uint32>(group.subMeshes.size());
     group.subMeshes.push_back(subMesh);
 
@@ -377,10 +452,56 @@ namespace geEngineSDK {
       const INDEX_BUFFER_FORMAT::E indexType = chooseIndexType(vertexCount);
       Vector<uint8> indexData = buildIndexBufferData(group.indices, indexType);
 
+      //The packed layout is chosen for the whole group, positions are
+      //normalized to the range of each submesh
+      const auto& srcElements = group.vertexDecl->getProperties().getElements();
+      const auto packedElements = VertexPacker::getPackedElements(srcElements,
+                                                                  group.vertices.data(),
+                                                                  vertexCount,
+                                                                  m_vertexPacking);
+      auto packedDecl = renderAPI.createVertexDeclaration(packedElements);
+      const auto& packedProps = packedDecl->getProperties();
+      const uint32 packedVertexSize = packedProps.getVertexSize(0);
+
+      const VertexElement* packedPosition =
+        packedProps.findElementBySemantic(VERTEX_ELEMENT_SEMANTIC::POSITION);
+      const bool bPackedPositions = nullptr != packedPosition &&
+        VERTEX_ELEMENT_TYPE::USHORT4_NORM == packedPosition->getType();
+
+      Vector<uint8> packedVertices(SIZE_T(vertexCount) * packedVertexSize);
+      Vector<AABox> positionRanges(group.subMeshes.size(), AABox::EMPTY);
+
+      for (SIZE_T i = 0; i < group.subMeshes.size(); ++i) {
+        const auto& builderSubMesh = group.subMeshes[i];
+        const uint8* srcVertices =
+          &group.vertices[SIZE_T(builderSubMesh.firstVertex) * group.vertexSize];
+
+        if (bPackedPositions) {
+          positionRanges[i] = VertexPacker::getPositionRange(srcElements,
+                                                             srcVertices,
+                                                             builderSubMesh.vertexCount);
+        }
+
+        VertexPacker::packVertices(srcElements,
+                                   srcVertices,
+                                   packedElements,
+                                   &packedVertices[SIZE_T(builderSubMesh.firstVertex) *
+                                                   packedVertexSize],
+                                   builderSubMesh.vertexCount,
+                                   positionRanges[i]);
+      }
+
+      GE_LOG(kLog,
+             Generic,
+             "Packed {0}: {1} -> {2} bytes per vertex",
+             group.name,
+             group.vertexSize,
+             packedVertexSize);
+
       //Vertex buffer creation
-      meshData.m_vertexBuffer = renderAPI.createVertexBuffer(group.vertexDecl,
-                                                             group.vertices.size(),
-                                                             group.vertices.data());
+      meshData.m_vertexBuffer = renderAPI.createVertexBuffer(packedDecl,
+                                                             packedVertices.size(),
+                                                             packedVertices.data());
 
       // Index buffer creation
       meshData.m_indexBuffer = renderAPI.createIndexBuffer(indexData.size(),
@@ -389,7 +510,9 @@ namespace geEngineSDK {
 
       meshData.m_subMeshes.reserve(group.subMeshes.size());
 
-      for (const auto& builderSubMesh : group.subMeshes) {
+      for (SIZE_T i = 0; i < group.subMeshes.size(); ++i) {
+        const auto& builderSubMesh = group.subMeshes[i];
+
         SubMesh subMesh;
         subMesh.m_name = builderSubMesh.name;
 
@@ -406,6 +529,15 @@ namespace geEngineSDK {
         subMesh.m_skinBindingIndex = builderSubMesh.skinBindingIndex;
         subMesh.m_bounds = builderSubMesh.bounds;
         subMesh.m_boundingSphere = builderSubMesh.boundingSphere;
+        subMesh.m_lods = builderSubMesh.lods;
+        subMesh.m_occluderPositions = builderSubMesh.occluderPositions;
+        subMesh.m_occluderIndices = builderSubMesh.occluderIndices;
+
+        if (positionRanges[i].m_isValid) {
+          subMesh.m_positionOffset = positionRanges[i].m_min;
+          subMesh.m_positionScale = positionRanges[i].m_max - positionRanges[i].m_min;
+        }
+
         meshData.m_subMeshes.push_back(subMesh);
       }
 
@@ -3,6 +3,7 @@
 #include <gePrerequisitesCore.h>
 #include <geGraphicsTypes.h>
 #include <geException.h>
+#include <geTaskScheduler.h>
 
 using namespace geEngineSDK;
 
@@ -40,6 +41,9 @@ struct SubresourceInfo
   uint32 slicePitch = 0;
   uint64 offset = 0;
   uint64 size = 0;
+
+  //Where the subresource is on the pixel data of the source
+  uint64 srcOffset = 0;
 };
 
 struct DdsTextureData
@@ -47,11 +51,39 @@ struct DdsTextureData
   TextureDesc desc;
   Vector<SubresourceInfo> subresources;
   Vector<uint8> blob;
+
+  //Pixel data of the source, null when only the header was read
+  const uint8* source = nullptr;
+
+  //Bytes of all the subresources packed one after the other
+  uint64 packedSize = 0;
+
+  //Bytes of the headers, where the pixel data starts on the file
+  uint64 headerSize = 0;
+
+  const uint8*
+  getData(const SubresourceInfo& s) const {
+    return blob.empty() ? source + s.srcOffset : blob.data() + s.offset;
+  }
 };
 
 struct LoadOptions
 {
   bool forceTightPacking = true;
+
+  //Levels above this one are skipped, the texture starts at firstMip
+  uint32 firstMip = 0;
+
+  //Only the description and the layout are read, the blob is left empty
+  bool headerOnly = false;
+
+  //The subresources are read from the source instead of copied to the blob.
+  //The source (a file in memory or mapped) has to outlive the texture data
+  bool inPlace = false;
+
+  //Bytes of pixel data left out at the start of every array slice, as when
+  //only the levels from firstMip on of each were read from the file
+  uint64 skippedSize = 0;
 };
 
 static inline uint32
@@ -303,10 +335,11 @@ mapLegacyPixelFormat(const DDS_PIXELFORMAT& p) {
 class DdsLoader
 {
  public:
+  //Bytes copied by each task of writeSubresources()
+  static constexpr uint64 BYTES_PER_CHUNK = 1024 * 1024;
+
   static DdsTextureData
   loadFromMemory(const void* data, size_t size, const LoadOptions& opt = {}) {
-    GE_UNREFERENCED_PARAMETER(opt);
-
     if (!data || size < 4 + sizeof(DDS_HEADER))
       throw std::runtime_error("DDS: buffer too small.");
 
@@ -393,26 +426,37 @@ class DdsLoader
       throw std::runtime_error("DDS: invalid dimensions.");
 
     // Now parse pixel data
-    if (offset >= size)
+    if (!opt.headerOnly && offset >= size)
       throw std::runtime_error("DDS: no pixel data.");
 
     const uint8* pixelData = bytes + offset;
-    const size_t pixelBytes = size - offset;
+    const size_t pixelBytes = offset < size ? size - offset : 0;
+
+    // The texture starts at firstMip, the finer levels are skipped
+    const uint32 firstMip = std::min(opt.firstMip, desc.mipCount - 1);
+
+    auto mipDim = [](uint32 base, uint32 mip) -> uint32 { return std::max(1u, base >> mip); };
 
     DdsTextureData out;
+    out.headerSize = offset;
     out.desc = desc;
+    out.desc.width = mipDim(desc.width, firstMip);
+    out.desc.height = mipDim(desc.height, firstMip);
+    out.desc.depth = mipDim(desc.depth, firstMip);
+    out.desc.mipCount = desc.mipCount - firstMip;
 
-    // Build subresource table + pack blob
+    // Build subresource table, the layout comes before any copy
     // Order: arraySlice major, then mip minor (common)
     uint64 running = 0;
-    out.subresources.reserve((size_t)desc.arraySize * (size_t)desc.mipCount);
-
-    auto mipDim = [](uint32 base, uint32 mip) -> uint32 { return std::max(1u, base >> mip); };
+    out.subresources.reserve((size_t)desc.arraySize * (size_t)out.desc.mipCount);
 
     // We will read sequentially from file data in same order
     size_t srcCursor = 0;
 
     for (uint32 a = 0; a < desc.arraySize; ++a) {
+      // Every slice up to this one left out the same levels
+      const uint64 skippedSize = opt.skippedSize * (a + 1);
+
       for (uint32 m = 0; m < desc.mipCount; ++m) {
         SubresourceInfo s{};
         s.arraySlice = a;
@@ -431,27 +475,63 @@ class DdsLoader
           subSize);
         s.size = subSize;
 
-        // Bounds check against file payload
-        if (srcCursor + (size_t)subSize > pixelBytes)
-          throw std::runtime_error("DDS: truncated pixel data.");
+        if (m >= firstMip) {
+          // The skipped levels are not in the data given
+          if (srcCursor < skippedSize)
+            throw std::runtime_error("DDS: the data given starts after firstMip.");
 
-        s.offset = running;
-        running += subSize;
+          // Bounds check against file payload
+          const uint64 srcOffset = srcCursor - skippedSize;
+          if (!opt.headerOnly && srcOffset + subSize > pixelBytes)
+            throw std::runtime_error("DDS: truncated pixel data.");
 
-        out.subresources.push_back(s);
+          s.mip = m - firstMip;
+          s.offset = running;
+          s.srcOffset = srcOffset;
+          running += subSize;
+
+          out.subresources.push_back(s);
+        }
         srcCursor += (size_t)subSize;
       }
     }
 
-    // Copy packed blob
-    out.blob.resize((size_t)running);
+    out.packedSize = running;
+    if (opt.headerOnly) {
+      return out;
+    }
 
-    srcCursor = 0;
-    for (const auto& s : out.subresources) {
-      std::memcpy(out.blob.data() + (size_t)s.offset, pixelData + srcCursor, (size_t)s.size);
-      srcCursor += (size_t)s.size;
+    out.source = pixelData;
+    if (!opt.inPlace) {
+      out.blob.resize((size_t)running);
+      writeSubresources(out, out.blob.data());
     }
 
     return out;
   }
+
+  /**
+   * Copies the subresources packed to dst, which holds packedSize bytes: the
+   * blob, or a staging buffer of the caller. Big textures are split in ranges
+   * of BYTES_PER_CHUNK bytes copied in parallel.
+   */
+  static void
+  writeSubresources(const DdsTextureData& data, uint8* dst) {
+    auto copyChunks = [&](uint32 beginChunk, uint32 endChunk) {
+      const uint64 begin = beginChunk * BYTES_PER_CHUNK;
+      const uint64 end = std::min(endChunk * BYTES_PER_CHUNK, data.packedSize);
+      for (const auto& s : data.subresources) {
+        const uint64 from = std::max(begin, s.offset);
+        const uint64 to = std::min(end, s.offset + s.size);
+        if (from < to) {
+          std::memcpy(dst + (size_t)from,
+                      data.source + (size_t)(s.srcOffset + from - s.offset),
+                      (size_t)(to - from));
+        }
+      }
+    };
+
+    const uint64 numChunks = (data.packedSize + BYTES_PER_CHUNK - 1) / BYTES_PER_CHUNK;
+    parallelForChunks("DdsLoader", (uint32)numChunks, 1, copyChunks);
+  }
 };
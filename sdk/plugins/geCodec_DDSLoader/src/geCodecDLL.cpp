@@ -21,6 +21,7 @@
 #include <geICodec.h>
 #include <geRenderAPI.h>
 #include <geMountManager.h>
+#include <geTextureStreamer.h>
 
 #include "geDDSLoader.h"
 
@@ -39,6 +40,45 @@ static Vector<String> CODEC_EXTENSIONS_EXPORT = {
   
 };
 
+//Magic, header and DX10 header
+static constexpr SIZE_T DDS_MAX_HEADER_SIZE = 4 + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+
+static SPtr<Texture>
+createTexture(const DdsTextureData& textureData) {
+  auto& renderAPI = RenderAPI::instance();
+
+  auto pTexture = renderAPI.createTexture(textureData.desc.width,
+                                          textureData.desc.height,
+                                          textureData.desc.format,
+                                          BIND_FLAG::SHADER_RESOURCE,
+                                          textureData.desc.mipCount,
+                                          RESOURCE_USAGE::DEFAULT,
+                                          0,
+                                          1,
+                                          false,
+                                          textureData.desc.isCubemap,
+                                          textureData.desc.arraySize);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  pTexture->setAlpha(textureData.desc.hasAlpha);
+
+  for (const auto& subResource : textureData.subresources) {
+    const uint32 srIndex = renderAPI.calcSubresource(subResource.mip,
+                                                     subResource.arraySlice,
+                                                     textureData.desc.mipCount);
+    renderAPI.writeToResource(pTexture,
+                              srIndex,
+                              nullptr,
+                              textureData.getData(subResource),
+                              subResource.rowPitch,
+                              subResource.slicePitch);
+  }
+
+  return pTexture;
+}
+
 extern "C"
 {
   GE_PLUGIN_EXPORT CODEC_TYPE::E
@@ -106,46 +146,86 @@ extern "C"
       return;
     }
 
-    auto& renderAPI = RenderAPI::instance();
     auto& mountman = MountManager::instance();
 
     auto pFileData = mountman.open(filePath);
     Vector<uint8>fileData;
     pFileData->getAllData(fileData);
-    auto textureData = DdsLoader::loadFromMemory(fileData.data(), fileData.size());
-
-    auto pTexture = renderAPI.createTexture(textureData.desc.width,
-                                            textureData.desc.height,
-                                            textureData.desc.format,
-                                            BIND_FLAG::SHADER_RESOURCE,
-                                            textureData.desc.mipCount,
-                                            RESOURCE_USAGE::DEFAULT,
-                                            0,
-                                            1,
-                                            false,
-                                            textureData.desc.isCubemap,
-                                            textureData.desc.arraySize);
-    if (!pTexture) {
-      return;
+
+    //The subresources are uploaded straight from the file data
+    LoadOptions options;
+    options.inPlace = true;
+    auto textureData = DdsLoader::loadFromMemory(fileData.data(), fileData.size(), options);
+
+    if (auto pTexture = createTexture(textureData)) {
+      outRes = pTexture;
     }
+  }
 
-    pTexture->setAlpha(textureData.desc.hasAlpha);
+  GE_PLUGIN_EXPORT bool
+  CodecReadMipChain(const Path& filePath, TextureMipChain& outChain) {
+    auto pFileData = MountManager::instance().open(filePath);
+    if (!pFileData) {
+      return false;
+    }
 
-    for (const auto& subResource : textureData.subresources) {
-      const uint32 srIndex = renderAPI.calcSubresource(subResource.mip,
-                                                       subResource.arraySlice,
-                                                       textureData.desc.mipCount);
-      const uint8* srcData = textureData.blob.data() + subResource.offset;
+    //Only the headers are read, the layout of the mips follows from them
+    Vector<uint8> header(std::min(DDS_MAX_HEADER_SIZE, pFileData->size()));
+    pFileData->read(header.data(), header.size());
 
-      renderAPI.writeToResource(pTexture,
-                                srIndex,
-                                nullptr,
-                                srcData,
-                                subResource.rowPitch,
-                                subResource.slicePitch);
+    LoadOptions options;
+    options.headerOnly = true;
+    DdsTextureData textureData;
+    try {
+      textureData = DdsLoader::loadFromMemory(header.data(), header.size(), options);
+    }
+    catch (const std::exception& e) {
+      GE_LOG(kError,
+             Generic,
+             String("Cannot read the mips of {0}: {1}"), filePath, e.what());
+      return false;
+    }
+
+    const TextureDesc& desc = textureData.desc;
+    outChain.desc.dimensions = cast::st<uint32>(desc.dimension) + 1;
+    outChain.desc.width = desc.width;
+    outChain.desc.height = desc.height;
+    outChain.desc.depth = desc.depth;
+    outChain.desc.mipLevels = desc.mipCount;
+    outChain.desc.arraySize = desc.arraySize;
+    outChain.desc.format = desc.format;
+
+    //The mips can be read without the rest of the file
+    outChain.setLayout(textureData.headerSize, textureData.subresources);
+    return true;
+  }
+
+  GE_PLUGIN_EXPORT void
+  CodecImportMips(const Path& filePath,
+                  const Vector<uint8>& fileData,
+                  uint64 skippedSize,
+                  uint32 firstMip,
+                  SPtr<Resource>& outRes) {
+    LoadOptions options;
+    options.firstMip = firstMip;
+    options.inPlace = true;
+
+    //Each slice holds its own chain, the same levels were left out of all
+    options.skippedSize = skippedSize;
+    DdsTextureData textureData;
+    try {
+      textureData = DdsLoader::loadFromMemory(fileData.data(), fileData.size(), options);
+    }
+    catch (const std::exception& e) {
+      GE_LOG(kError,
+             Generic,
+             String("Cannot import the mips of {0}: {1}"), filePath, e.what());
+      return;
     }
 
-    outRes = pTexture;
+    if (auto pTexture = createTexture(textureData)) {
+      outRes = pTexture;
+    }
   }
 
   GE_PLUGIN_EXPORT bool
@@ -3,6 +3,7 @@
 #include <gePrerequisitesCore.h>
 #include <geGraphicsTypes.h>
 #include <geException.h>
+#include <geTaskScheduler.h>
 #include <ktx.h>
 
 using namespace geEngineSDK;
@@ -325,6 +326,9 @@ struct SubresourceInfo
   uint64 slicePitch = 0;
   uint64 offset = 0;
   uint64 size = 0;
+
+  //Where the subresource is on the image data of the source
+  uint64 srcOffset = 0;
 };
 
 struct TextureData
@@ -332,6 +336,20 @@ struct TextureData
   TextureDesc desc;
   Vector<SubresourceInfo> subresources;
   Vector<uint8> blob;
+
+  //Image data of the source, null when only the header was read
+  const uint8* source = nullptr;
+
+  //Bytes of all the subresources packed one after the other
+  uint64 packedSize = 0;
+
+  //Keeps the data loaded by libktx alive while it's read in place
+  SPtr<ktxTexture> owner;
+
+  const uint8*
+  getData(const SubresourceInfo& s) const {
+    return blob.empty() ? source + s.srcOffset : blob.data() + s.offset;
+  }
 };
 
 struct LoadOptions
@@ -351,6 +369,19 @@ struct LoadOptions
 
   //For KTX2: allows the transcoding if its required
   ktx_transcode_flags transcodeFlags = KTX_TF_HIGH_QUALITY;
+
+  //Levels above this one are skipped, the texture starts at firstMip
+  uint32 firstMip = 0;
+
+  //Only the description and the layout are read, the blob is left empty.
+  //Supercompressed textures can't be read this way, as their layout is only
+  //known once transcoded
+  bool headerOnly = false;
+
+  //The subresources are read from the source instead of copied to the blob.
+  //KTX2 files without supercompression are read from the file itself, which
+  //has to outlive the texture data; the rest from the data libktx loaded
+  bool inPlace = false;
 };
 
 // ---------------------------------------------
@@ -456,20 +487,110 @@ mipDim(uint32 base, uint32 mip) {
   return std::max(1u, base >> mip);
 }
 
+//Where the image data starts on a KTX2 file without supercompression, the
+//offsets of ktxTexture_GetImageOffset() count from there. 0 if the data has
+//to be loaded by libktx
+static inline uint64
+ktx2ImageDataOffset(const uint8* bytes, size_t size) {
+  static constexpr uint8 KTX2_IDENTIFIER[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+  };
+  static constexpr size_t LEVEL_COUNT_OFFSET = 40;
+  static constexpr size_t SUPERCOMPRESSION_OFFSET = 44;
+  static constexpr size_t LEVEL_INDEX_OFFSET = 80;
+  static constexpr size_t LEVEL_INDEX_ENTRY_SIZE = 24;
+
+  if (size < LEVEL_INDEX_OFFSET || std::memcmp(bytes, KTX2_IDENTIFIER, 12) != 0) {
+    return 0;
+  }
+
+  uint32 levelCount = 0;
+  uint32 scheme = 0;
+  std::memcpy(&levelCount, bytes + LEVEL_COUNT_OFFSET, 4);
+  std::memcpy(&scheme, bytes + SUPERCOMPRESSION_OFFSET, 4);
+  if (scheme != KTX_SS_NONE) {
+    return 0;
+  }
+
+  //The smallest level is the first one on the file
+  const size_t lastLevel = LEVEL_INDEX_OFFSET +
+                           (size_t)(std::max(levelCount, 1u) - 1) * LEVEL_INDEX_ENTRY_SIZE;
+  if (lastLevel + 8 > size) {
+    return 0;
+  }
+
+  uint64 offset = 0;
+  std::memcpy(&offset, bytes + lastLevel, 8);
+  return offset <= size ? offset : 0;
+}
+
+//Bytes at the start of a KTX2 file that hold its headers, level index and
+//metadata, up to where the image data starts. With only the first bytes of
+//the file, as many as those say are needed to know more. 0 if it isn't a
+//KTX2 file
+static inline uint64
+ktx2HeaderSize(const uint8* bytes, size_t size) {
+  static constexpr uint8 KTX2_IDENTIFIER[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+  };
+  static constexpr size_t LEVEL_COUNT_OFFSET = 40;
+  static constexpr size_t INDEX_OFFSET = 48;
+  static constexpr size_t LEVEL_INDEX_OFFSET = 80;
+  static constexpr size_t LEVEL_INDEX_ENTRY_SIZE = 24;
+
+  if (size < LEVEL_INDEX_OFFSET || std::memcmp(bytes, KTX2_IDENTIFIER, 12) != 0) {
+    return 0;
+  }
+
+  //Offsets and lengths of the data format descriptor, the key/value data
+  //and the supercompression global data
+  uint32 levelCount = 0;
+  uint32 dfdKvd[4] = {};
+  uint64 sgd[2] = {};
+  std::memcpy(&levelCount, bytes + LEVEL_COUNT_OFFSET, 4);
+  std::memcpy(dfdKvd, bytes + INDEX_OFFSET, sizeof(dfdKvd));
+  std::memcpy(sgd, bytes + INDEX_OFFSET + sizeof(dfdKvd), sizeof(sgd));
+
+  const uint64 levelIndexEnd = LEVEL_INDEX_OFFSET +
+                               uint64(std::max(levelCount, 1u)) * LEVEL_INDEX_ENTRY_SIZE;
+  uint64 headerSize = std::max({ levelIndexEnd,
+                                 uint64(dfdKvd[0]) + dfdKvd[1],
+                                 uint64(dfdKvd[2]) + dfdKvd[3],
+                                 sgd[0] + sgd[1] });
+
+  //The smallest level is the first one on the file
+  if (levelIndexEnd <= size) {
+    uint64 offset = 0;
+    std::memcpy(&offset, bytes + levelIndexEnd - LEVEL_INDEX_ENTRY_SIZE, 8);
+    headerSize = std::max(headerSize, offset);
+  }
+  return headerSize;
+}
+
 class KtxLoader
 {
  public:
+  //Bytes copied by each task of writeSubresources()
+  static constexpr uint64 BYTES_PER_CHUNK = 1024 * 1024;
+
   static TextureData
   loadFromMemory(const void* data, size_t size, const LoadOptions& opt = {}) {
     if (!data || size < 12) {
       throw std::runtime_error("KTX: buffer too small.");
     }
 
+    const uint8* bytes = reinterpret_cast<const uint8*>(data);
+
+    //When it can, the image data is read where it is instead of loaded
+    const uint64 fileDataOffset = (opt.inPlace && !opt.headerOnly) ?
+      ktx2ImageDataOffset(bytes, size) : 0;
+    const bool bLoadData = !opt.headerOnly && 0 == fileDataOffset;
+
     ktxTexture* tex = nullptr;
     const KTX_error_code ec = ktxTexture_CreateFromMemory(
       reinterpret_cast<const ktx_uint8_t*>(data),
       static_cast<ktx_size_t>(size),
-      KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+      bLoadData ? KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT : KTX_TEXTURE_CREATE_NO_FLAGS,
       &tex
     );
 
@@ -477,20 +598,17 @@ class KtxLoader
       throw std::runtime_error("KTX: failed to parse texture.");
     }
 
-    //Ensures destroy even in case of a throw
-    struct Guard
-    {
-      ktxTexture* t;
-      ~Guard() {
-        if (t) {
-          ktxTexture_Destroy(t);
-        }
-      }
-    }guard{ tex };
+    //Ensures destroy even in case of a throw, or once the loaded data isn't
+    //read anymore
+    SPtr<ktxTexture> pTex(tex, [](ktxTexture* t) { ktxTexture_Destroy(t); });
 
     if (tex->classId == ktxTexture2_c) {
       ktxTexture2* t2 = reinterpret_cast<ktxTexture2*>(tex);
 
+      if (t2->supercompressionScheme == KTX_SS_BASIS_LZ && opt.headerOnly) {
+        throw std::runtime_error("KTX2: supercompressed textures need their data.");
+      }
+
       //Only if it's supercompressed (Basis / UASTC)
       if (t2->supercompressionScheme == KTX_SS_BASIS_LZ) {
         if (opt.transcodeBasisToBC) {
@@ -572,13 +690,24 @@ class KtxLoader
     out.desc.hasAlpha = alpha;
 
     //Payload pointer
-    const uint8* src = reinterpret_cast<const uint8*>(ktxTexture_GetData(tex));
-    const ktx_size_t srcSize = ktxTexture_GetDataSize(tex);
-    if (!src || srcSize == 0) {
+    const uint8* src = bLoadData ?
+      reinterpret_cast<const uint8*>(ktxTexture_GetData(tex)) : bytes + fileDataOffset;
+    const ktx_size_t srcSize = bLoadData ?
+      ktxTexture_GetDataSize(tex) : static_cast<ktx_size_t>(size - fileDataOffset);
+    if (!opt.headerOnly && (!src || srcSize == 0)) {
       throw std::runtime_error("KTX: no image data.");
     }
 
-    //Builds subresources y pack the blob tight
+    //The texture starts at firstMip, the finer levels are skipped
+    const uint32 numLevels = out.desc.mipCount;
+    const uint32 firstMip = std::min(opt.firstMip, numLevels - 1);
+    const TextureDesc baseDesc = out.desc;
+    out.desc.width = mipDim(baseDesc.width, firstMip);
+    out.desc.height = mipDim(baseDesc.height, firstMip);
+    out.desc.depth = mipDim(baseDesc.depth, firstMip);
+    out.desc.mipCount = numLevels - firstMip;
+
+    //Builds the subresources, the layout comes before any copy
     out.subresources.reserve(static_cast<size_t>(effectiveArray) * out.desc.mipCount);
 
     uint64 running = 0;
@@ -588,18 +717,18 @@ class KtxLoader
       for (uint32 face = 0; face < faces; ++face) {
         const uint32 arraySlice = layer * faces + face;
 
-        for (uint32 level = 0; level < out.desc.mipCount; ++level) {
+        for (uint32 level = firstMip; level < numLevels; ++level) {
           ktx_size_t off = 0;
           KTX_error_code oec = ktxTexture_GetImageOffset(tex, level, layer, face, &off);
           if (oec != KTX_SUCCESS) {
             throw std::runtime_error("KTX: GetImageOffset failed.");
           }
 
-          const uint32 w = mipDim(out.desc.width, level);
-          const uint32 h = (out.desc.dimension == TextureDimension::Tex1D) ?
-            1u : mipDim(out.desc.height, level);
-          const uint32 d = (out.desc.dimension == TextureDimension::Tex3D) ?
-            mipDim(out.desc.depth, level) : 1u;
+          const uint32 w = mipDim(baseDesc.width, level);
+          const uint32 h = (baseDesc.dimension == TextureDimension::Tex1D) ?
+            1u : mipDim(baseDesc.height, level);
+          const uint32 d = (baseDesc.dimension == TextureDimension::Tex3D) ?
+            mipDim(baseDesc.depth, level) : 1u;
 
           const ktx_size_t imageBytesPerSlice = ktxTexture_GetImageSize(tex, level); // <-- clave :contentReference[oaicite:1]{index=1}
           const uint32 rowPitch = ktxTexture_GetRowPitch(tex, level);
@@ -613,18 +742,19 @@ class KtxLoader
 
           const uint64 imageBytes = (uint64)imageBytesPerSlice * (uint64)mipDepth;
 
-          if (off + (ktx_size_t)imageBytes > srcSize) {
+          if (!opt.headerOnly && off + (ktx_size_t)imageBytes > srcSize) {
             throw std::runtime_error("KTX: truncated image data.");
           }
 
           SubresourceInfo s{};
-          s.mip = level;
+          s.mip = level - firstMip;
           s.arraySlice = arraySlice;
           s.width = w; s.height = h; s.depth = d;
           s.rowPitch = rowPitch;
           s.slicePitch = imageBytesPerSlice;
           s.offset = running;
           s.size = imageBytes;
+          s.srcOffset = off;
 
           out.subresources.push_back(s);
           running += imageBytes;
@@ -632,25 +762,45 @@ class KtxLoader
       }
     }
 
-    out.blob.resize(static_cast<size_t>(running));
-
-    //Efective copy
-    for (const auto& s : out.subresources) {
-      ktx_size_t off = 0;
-      //Note: we need to recompute the offset with (level, layer, face).
-      //Re-derive layer/face from arraySlice:
-      const uint32 layer = s.arraySlice / faces;
-      const uint32 face = s.arraySlice % faces;
-
-      if (ktxTexture_GetImageOffset(tex, s.mip, layer, face, &off) != KTX_SUCCESS) {
-        throw std::runtime_error("KTX: GetImageOffset failed (copy).");
-      }
+    out.packedSize = running;
+    if (opt.headerOnly) {
+      return out;
+    }
 
-      std::memcpy(out.blob.data() + static_cast<size_t>(s.offset),
-                  src + off,
-                  static_cast<size_t>(s.size));
+    out.source = src;
+    if (!opt.inPlace) {
+      out.blob.resize(static_cast<size_t>(running));
+      writeSubresources(out, out.blob.data());
+    }
+    else if (bLoadData) {
+      out.owner = pTex;
     }
 
     return out;
   }
+
+  /**
+   * Copies the subresources packed to dst, which holds packedSize bytes: the
+   * blob, or a staging buffer of the caller. Big textures are split in ranges
+   * of BYTES_PER_CHUNK bytes copied in parallel.
+   */
+  static void
+  writeSubresources(const TextureData& data, uint8* dst) {
+    auto copyChunks = [&](uint32 beginChunk, uint32 endChunk) {
+      const uint64 begin = beginChunk * BYTES_PER_CHUNK;
+      const uint64 end = std::min(endChunk * BYTES_PER_CHUNK, data.packedSize);
+      for (const auto& s : data.subresources) {
+        const uint64 from = std::max(begin, s.offset);
+        const uint64 to = std::min(end, s.offset + s.size);
+        if (from < to) {
+          std::memcpy(dst + static_cast<size_t>(from),
+                      data.source + static_cast<size_t>(s.srcOffset + from - s.offset),
+                      static_cast<size_t>(to - from));
+        }
+      }
+    };
+
+    const uint64 numChunks = (data.packedSize + BYTES_PER_CHUNK - 1) / BYTES_PER_CHUNK;
+    parallelForChunks("KtxLoader", static_cast<uint32>(numChunks), 1, copyChunks);
+  }
 };
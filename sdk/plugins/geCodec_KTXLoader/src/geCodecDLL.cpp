@@ -21,6 +21,7 @@
 #include <geICodec.h>
 #include <geRenderAPI.h>
 #include <geMountManager.h>
+#include <geTextureStreamer.h>
 
 #include "geKTXLoader.h"
 
@@ -39,6 +40,53 @@ static Vector<String> CODEC_EXTENSIONS_EXPORT = {
   
 };
 
+//Identifier, header and index of a KTX2 file
+static constexpr uint64 KTX2_HEADER_SIZE = 80;
+
+static SPtr<Texture>
+createTexture(const TextureData& textureData) {
+  auto& renderAPI = RenderAPI::instance();
+
+  auto pTexture = renderAPI.createTexture(textureData.desc.width,
+                                          textureData.desc.height,
+                                          textureData.desc.format,
+                                          BIND_FLAG::SHADER_RESOURCE,
+                                          textureData.desc.mipCount,
+                                          RESOURCE_USAGE::DEFAULT,
+                                          0,
+                                          1,
+                                          false,
+                                          textureData.desc.isCubemap,
+                                          textureData.desc.arraySize);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  pTexture->setAlpha(textureData.desc.hasAlpha);
+
+  for (const auto& subResource : textureData.subresources) {
+    const uint32 srIndex = renderAPI.calcSubresource(subResource.mip,
+                                                     subResource.arraySlice,
+                                                     textureData.desc.mipCount);
+
+    if (subResource.slicePitch > NumLimit::MAX_UINT32) {
+      GE_LOG(kError,
+             Generic,
+             String("Subresource slice pitch is too large. Cannot import texture."));
+      return nullptr;
+    }
+
+    renderAPI.writeToResource(pTexture,
+                              srIndex,
+                              nullptr,
+                              textureData.getData(subResource),
+                              subResource.rowPitch,
+                              cast::st<uint32>(subResource.slicePitch));
+  }
+
+  return pTexture;
+}
+
 extern "C"
 {
   GE_PLUGIN_EXPORT CODEC_TYPE::E
@@ -106,53 +154,112 @@ extern "C"
       return;
     }
 
-    auto& renderAPI = RenderAPI::instance();
     auto& mountman = MountManager::instance();
 
     auto pFileData = mountman.open(filePath);
     Vector<uint8>fileData;
     pFileData->getAllData(fileData);
-    auto textureData = KtxLoader::loadFromMemory(fileData.data(), fileData.size());
-
-    auto pTexture = renderAPI.createTexture(textureData.desc.width,
-                                            textureData.desc.height,
-                                            textureData.desc.format,
-                                            BIND_FLAG::SHADER_RESOURCE,
-                                            textureData.desc.mipCount,
-                                            RESOURCE_USAGE::DEFAULT,
-                                            0,
-                                            1,
-                                            false,
-                                            textureData.desc.isCubemap,
-                                            textureData.desc.arraySize);
-    if (!pTexture) {
-      return;
-    }
 
-    pTexture->setAlpha(textureData.desc.hasAlpha);
+    //The subresources are uploaded straight from the file data
+    LoadOptions options;
+    options.inPlace = true;
+    auto textureData = KtxLoader::loadFromMemory(fileData.data(), fileData.size(), options);
 
-    for (const auto& subResource : textureData.subresources) {
-      const uint32 srIndex = renderAPI.calcSubresource(subResource.mip,
-                                                       subResource.arraySlice,
-                                                       textureData.desc.mipCount);
-      const uint8* srcData = textureData.blob.data() + subResource.offset;
+    if (auto pTexture = createTexture(textureData)) {
+      outRes = pTexture;
+    }
+  }
 
-      if (subResource.slicePitch > NumLimit::MAX_UINT32) {
-        GE_LOG(kError,
-               Generic,
-               String("Subresource slice pitch is too large. Cannot import texture."));
-        return;
+  GE_PLUGIN_EXPORT bool
+  CodecReadMipChain(const Path& filePath, TextureMipChain& outChain) {
+    auto pFileData = MountManager::instance().open(filePath);
+    if (!pFileData) {
+      return false;
+    }
+
+    //The first bytes of a KTX2 file say where its level index and metadata
+    //end, the images after them aren't read
+    Vector<uint8> fileData;
+    uint64 headerSize = KTX2_HEADER_SIZE;
+    while (headerSize > fileData.size() && headerSize <= pFileData->size()) {
+      const SIZE_T readSize = fileData.size();
+      fileData.resize(cast::st<SIZE_T>(headerSize));
+      if (pFileData->read(fileData.data() + readSize, fileData.size() - readSize) !=
+          fileData.size() - readSize) {
+        return false;
       }
+      headerSize = ktx2HeaderSize(fileData.data(), fileData.size());
+    }
 
-      renderAPI.writeToResource(pTexture,
-                                srIndex,
-                                nullptr,
-                                srcData,
-                                subResource.rowPitch,
-                                cast::st<uint32>(subResource.slicePitch));
+    //Any other file is read whole
+    if (headerSize != fileData.size()) {
+      pFileData->seek(0);
+      pFileData->getAllData(fileData);
     }
 
-    outRes = pTexture;
+    LoadOptions options;
+    options.headerOnly = true;
+    TextureData textureData;
+    try {
+      textureData = KtxLoader::loadFromMemory(fileData.data(), fileData.size(), options);
+    }
+    catch (const std::exception& e) {
+      GE_LOG(kError,
+             Generic,
+             String("Cannot read the mips of {0}: {1}"), filePath, e.what());
+      return false;
+    }
+
+    const TextureDesc& desc = textureData.desc;
+    outChain.desc.dimensions = cast::st<uint32>(desc.dimension) + 1;
+    outChain.desc.width = desc.width;
+    outChain.desc.height = desc.height;
+    outChain.desc.depth = desc.depth;
+    outChain.desc.mipLevels = desc.mipCount;
+    outChain.desc.arraySize = desc.arraySize;
+    outChain.desc.format = desc.format;
+
+    //The smallest level comes first on a KTX2 file, so the levels from a mip
+    //on are read with the headers. The rest of the files are read whole.
+    const uint64 imageDataOffset = ktx2ImageDataOffset(fileData.data(), fileData.size());
+    outChain.setLayout(imageDataOffset, textureData.subresources);
+    if (0 == imageDataOffset) {
+      outChain.mipDataRanges.clear();
+    }
+    return true;
+  }
+
+  GE_PLUGIN_EXPORT void
+  CodecImportMips(const Path& filePath,
+                  const Vector<uint8>& fileData,
+                  uint64 skippedSize,
+                  uint32 firstMip,
+                  SPtr<Resource>& outRes) {
+    //The levels from firstMip on follow the headers, nothing is skipped
+    if (0 != skippedSize) {
+      GE_LOG(kError,
+             Generic,
+             String("Cannot import the mips of {0}: unexpected layout."), filePath);
+      return;
+    }
+
+    LoadOptions options;
+    options.firstMip = firstMip;
+    options.inPlace = true;
+    TextureData textureData;
+    try {
+      textureData = KtxLoader::loadFromMemory(fileData.data(), fileData.size(), options);
+    }
+    catch (const std::exception& e) {
+      GE_LOG(kError,
+             Generic,
+             String("Cannot import the mips of {0}: {1}"), filePath, e.what());
+      return;
+    }
+
+    if (auto pTexture = createTexture(textureData)) {
+      outRes = pTexture;
+    }
   }
 
   GE_PLUGIN_EXPORT bool
@@ -22,6 +22,11 @@
 #include <geRenderAPI.h>
 #include <geFloat16Color.h>
 #include <geMountManager.h>
+#include <geCodecManager.h>
+#include <geGameConfig.h>
+#include <geMipMapGenerator.h>
+#include <geTextureCooker.h>
+#include <geTaskScheduler.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_ASSERT(x) GE_ASSERT(x)
@@ -44,6 +49,223 @@ static Vector<String> CODEC_EXTENSIONS_EXPORT = {
   ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".hdr"
 };
 
+/**
+ * @brief An image on its way from the file to the GPU.
+ */
+struct DecodedImage
+{
+  Path filePath;
+  Vector<uint8> fileData;
+  bool isHDR = false;
+  bool hasAlpha = false;
+  GRAPHICS_FORMAT::E format = GRAPHICS_FORMAT::kUNKNOWN;
+  MipChain mips;
+
+  //Where to write the cooked version, empty if it shouldn't be cooked
+  Path cachePath;
+
+  //The cooked version already exists, the file doesn't need to be decoded
+  bool bCooked = false;
+};
+
+/**
+ * @brief Reads the mip filter to use from the config, [TEXTURES] MIPFILTER.
+ *        Resolved on every import, so it's always read from the running
+ *        GameConfig.
+ */
+static MIP_FILTER::E
+getMipFilter() {
+  if (!GameConfig::isStarted()) {
+    return MIP_FILTER::kBox;
+  }
+
+  const ConfigVar<String> mipFilter =
+    GameConfig::instance().getVar<String>("TEXTURES", "MIPFILTER", "BOX");
+  return StringUtil::match(mipFilter.get(), "KAISER", false) ? MIP_FILTER::kKaiser :
+                                                               MIP_FILTER::kBox;
+}
+
+/**
+ * @brief Reads the file data. Must be called from a single thread as the
+ *        mounted file systems are not thread safe.
+ */
+static bool
+readImageFile(const Path& filePath,
+              bool bCook,
+              const TextureCooker& cooker,
+              DecodedImage& image) {
+  image.filePath = filePath;
+
+  //Check if this is a HDR image, it needs to be loaded as a float image
+  image.isHDR = StringUtil::match(filePath.getExtension(), ".HDR", false);
+
+  auto pFileData = MountManager::instance().open(filePath);
+  if (!pFileData) {
+    GE_LOG(kError, Generic, "Failed to open image: {0}", filePath.toString());
+    return false;
+  }
+
+  pFileData->getAllData(image.fileData);
+
+  //There's no float block format to cook HDR images to. The cooked version
+  //is named after the data that was just read, so the lookup is free.
+  if (bCook && !image.isHDR) {
+    image.cachePath = cooker.getCachePath(image.fileData.data(), image.fileData.size());
+    image.bCooked = MountManager::instance().exists(image.cachePath);
+  }
+  return true;
+}
+
+/**
+ * @brief Imports the cooked version of an image through the DDS codec. Must
+ *        be called from the thread that owns the RenderAPI context.
+ */
+static SPtr<Resource>
+importCooked(const DecodedImage& image) {
+  auto pDDSCodec = CodecManager::instance().getImportCodec(CODEC_TYPE::IMAGE, ".dds");
+  if (!pDDSCodec) {
+    return nullptr;
+  }
+
+  SPtr<Resource> pTexture;
+  pDDSCodec->importResource(image.cachePath, false, pTexture);
+  if (pTexture) {
+    pTexture->setCookedPath(image.cachePath);
+  }
+  return pTexture;
+}
+
+/**
+ * @brief Decodes the file data and generates the mip chain. Thread safe.
+ */
+static bool
+decodeImage(DecodedImage& image, const TextureCooker& cooker, MipMapOptions options) {
+  int width, height, channels;
+  const int32 dataSize = cast::st<int32>(image.fileData.size());
+
+  if (image.isHDR) {
+    float* pImageData = stbi_loadf_from_memory(image.fileData.data(),
+                                               dataSize,
+                                               &width,
+                                               &height,
+                                               &channels,
+                                               4);
+    if (!pImageData) {
+      GE_LOG(kError,
+             Generic,
+             "Failed to load HDR image: {0}. Error: {1}",
+             image.filePath.toString(),
+             stbi_failure_reason());
+      return false;
+    }
+
+    //The alpha is not needed for HDR textures
+    image.hasAlpha = false;
+    image.format = GRAPHICS_FORMAT::kR32G32B32A32_FLOAT;
+    options.bAlphaWeighted = false;
+    image.mips = MipMapGenerator::generateRGBA32F(pImageData,
+                                                  cast::st<uint32>(width),
+                                                  cast::st<uint32>(height),
+                                                  options);
+    stbi_image_free(pImageData);
+  }
+  else {
+    uint8* pImageData = stbi_load_from_memory(image.fileData.data(),
+                                              dataSize,
+                                              &width,
+                                              &height,
+                                              &channels,
+                                              4);
+    if (!pImageData) {
+      GE_LOG(kError,
+             Generic,
+             "Failed to load image: {0}. Error: {1}",
+             image.filePath.toString(),
+             stbi_failure_reason());
+      return false;
+    }
+
+    //Check for alpha channel
+    image.hasAlpha = (channels == 4);
+    if (image.hasAlpha) {
+      //Make sure to check if the alpha channel is actually used
+      image.hasAlpha = false;
+      for (int32 i = 3; i < width * height * 4; i += 4) {
+        if (pImageData[i] < 255) {
+          image.hasAlpha = true;
+          break;
+        }
+      }
+    }
+
+    options.bAlphaWeighted = image.hasAlpha;
+    image.format = GRAPHICS_FORMAT::kR8G8B8A8_UNORM;
+    image.mips = MipMapGenerator::generateRGBA8(pImageData,
+                                                cast::st<uint32>(width),
+                                                cast::st<uint32>(height),
+                                                options);
+    stbi_image_free(pImageData);
+
+    //The top level of block compressed textures must be a multiple of 4
+    if (!image.cachePath.isEmpty()) {
+      const auto cookFormat = cooker.selectFormat(image.hasAlpha);
+      if (GRAPHICS_FORMAT::kUNKNOWN != cookFormat &&
+          0 == (width % 4) && 0 == (height % 4)) {
+        image.mips = TextureCooker::compress(image.mips, cookFormat, options.bParallel);
+        image.format = cookFormat;
+      }
+      else {
+        image.cachePath = Path();
+      }
+    }
+  }
+
+  //The encoded data is not needed anymore
+  image.fileData = Vector<uint8>();
+  return true;
+}
+
+/**
+ * @brief Creates the texture and writes all of its levels, then saves the
+ *        cooked version if there's one. Must be called from the thread that
+ *        owns the RenderAPI context.
+ */
+static SPtr<Texture>
+uploadImage(const DecodedImage& image) {
+  auto& renderAPI = RenderAPI::instance();
+  const auto& levels = image.mips.levels;
+  const uint32 numLevels = cast::st<uint32>(levels.size());
+
+  auto pTexture = renderAPI.createTexture(levels[0].width,
+                                          levels[0].height,
+                                          image.format,
+                                          BIND_FLAG::SHADER_RESOURCE,
+                                          numLevels);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  pTexture->setAlpha(image.hasAlpha);
+
+  for (uint32 i = 0; i < numLevels; ++i) {
+    const auto& level = levels[i];
+    const SIZE_T levelEnd = i + 1 < numLevels ? levels[i + 1].offset :
+                                                image.mips.data.size();
+    renderAPI.writeToResource(pTexture,
+                              renderAPI.calcSubresource(i, 0, numLevels),
+                              nullptr,
+                              image.mips.getLevelData(i),
+                              level.rowPitch,
+                              cast::st<uint32>(levelEnd - level.offset));
+  }
+
+  if (!image.cachePath.isEmpty()) {
+    TextureCooker::writeDDS(image.cachePath, image.mips, image.format);
+  }
+
+  return pTexture;
+}
+
 extern "C"
 {
   GE_PLUGIN_EXPORT CODEC_TYPE::E
@@ -101,8 +323,6 @@ extern "C"
 
   GE_PLUGIN_EXPORT void
   CodecImport(const Path& filePath, bool useCacheIfAvailable, SPtr<Resource>& outRes) {
-    GE_UNREFERENCED_PARAMETER(useCacheIfAvailable);
-
     //Import the image using stb_image
     if (!CodecCanImport(filePath)) {
       GE_LOG(kError,
@@ -111,104 +331,103 @@ extern "C"
       return;
     }
 
-    //Check if this is a HDR image
-    bool isHDR = false;
-    if (StringUtil::match(filePath.getExtension(), ".HDR", false)) {
-      //This means we need to load it as a float image
-      isHDR = true;
+    TextureCooker cooker;
+    DecodedImage image;
+    if (!readImageFile(filePath, useCacheIfAvailable, cooker, image)) {
+      return;
     }
 
-    auto& renderAPI = RenderAPI::instance();
-    int width, height, channels;
-
-    auto& mountman = MountManager::instance();
-    auto pFileData = mountman.open(filePath);
-    Vector<uint8>fileData;
-    pFileData->getAllData(fileData);
-
-    if(isHDR) {
-      float* pImageData = stbi_loadf_from_memory(fileData.data(),
-                                                 cast::st<int32>(fileData.size()),
-                                                 &width,
-                                                 &height,
-                                                 &channels,
-                                                 4);
-      if (!pImageData) {
-        GE_LOG(kError,
-               Generic,
-               "Failed to load HDR image: {0}. Error: {1}",
-               filePath.toString(),
-               stbi_failure_reason());
+    if (image.bCooked) {
+      outRes = importCooked(image);
+      if (outRes) {
         return;
       }
+    }
 
-      //Use the RenderAPI to create a texture resource
-      auto pTexture = renderAPI.createTexture(width,
-                                              height,
-                                              GRAPHICS_FORMAT::kR32G32B32A32_FLOAT,
-                                              BIND_FLAG::SHADER_RESOURCE,
-                                              0);
-
-      //The alpha is not needed for HDR textures
-      pTexture->setAlpha(false);
-
-      //Write the data
-      renderAPI.writeToResource(pTexture, 0, nullptr, pImageData, width * 16, 0, 0);
+    //A single image splits the rows of its mips across the workers
+    MipMapOptions options;
+    options.filter = getMipFilter();
+    if (!decodeImage(image, cooker, options)) {
+      return;
+    }
 
-      //Free the image data
-      stbi_image_free(pImageData);
+    outRes = uploadImage(image);
+  }
 
-      //Set the output resource
-      outRes = pTexture;
-    }
-    else {
-      uint8* pImageData = stbi_load_from_memory(fileData.data(),
-                                                cast::st<int32>(fileData.size()),
-                                                &width,
-                                                &height,
-                                                &channels,
-                                                4);
-      if (!pImageData) {
-        GE_LOG(kError,
-               Generic,
-               "Failed to load image: {0}. Error: {1}",
-               filePath.toString(),
-               stbi_failure_reason());
-        return;
+  GE_PLUGIN_EXPORT void
+  CodecImportBatch(const Vector<Path>& filePaths,
+                   bool useCacheIfAvailable,
+                   Vector<SPtr<Resource>>& outRes) {
+    const uint32 numFiles = cast::st<uint32>(filePaths.size());
+    outRes.clear();
+    outRes.resize(numFiles);
+
+    //Each image is decoded by a single worker, so the batch runs in parallel
+    MipMapOptions options;
+    options.filter = getMipFilter();
+    options.bParallel = false;
+    TextureCooker cooker;
+
+    //Images are processed in windows to bound the memory in flight. The
+    //calling thread reads the files of a window and uploads the previous one
+    //while the workers decode.
+    const bool bUseTasks = TaskScheduler::isStarted();
+    const uint32 windowSize = bUseTasks ?
+      std::max(TaskScheduler::instance().getNumWorkers() * 2, 1u) : 1;
+
+    Vector<DecodedImage> images(numFiles);
+    Vector<uint8> decoded(numFiles, 0);
+
+    auto uploadWindow = [&](uint32 begin, uint32 end) {
+      for (uint32 i = begin; i < end; ++i) {
+        if (decoded[i]) {
+          outRes[i] = uploadImage(images[i]);
+        }
+        images[i] = DecodedImage();
       }
-
-      //Use the RenderAPI to create a texture resource
-      auto pTexture = renderAPI.createTexture(width,
-                                              height,
-                                              GRAPHICS_FORMAT::kR8G8B8A8_UNORM,
-                                              BIND_FLAG::SHADER_RESOURCE,
-                                              0);
-
-      //Check for alpha channel
-      bool hasAlpha = (channels == 4);
-      if(hasAlpha) {
-        //Make sure to check if the alpha channel is actually used
-        hasAlpha = false;
-        for (int32 i = 3; i < width * height * 4; i += 4) {
-          if (pImageData[i] < 255) {
-            hasAlpha = true;
-            break;
-          }
+    };
+
+    uint32 prevBegin = 0;
+    uint32 prevEnd = 0;
+    for (uint32 begin = 0; begin < numFiles; begin += windowSize) {
+      const uint32 end = std::min(begin + windowSize, numFiles);
+      for (uint32 i = begin; i < end; ++i) {
+        decoded[i] = CodecCanImport(filePaths[i]) &&
+                     readImageFile(filePaths[i], useCacheIfAvailable, cooker, images[i]);
+        if (decoded[i] && images[i].bCooked) {
+          outRes[i] = importCooked(images[i]);
+          decoded[i] = !outRes[i];
         }
       }
-      pTexture->setAlpha(hasAlpha);
 
-      //Write the data
-      renderAPI.writeToResource(pTexture, 0, nullptr, pImageData, width * 4, 0, 0);
+      auto decodeFn = [&, begin](uint32 idx) {
+        const uint32 i = begin + idx;
+        if (decoded[i]) {
+          decoded[i] = decodeImage(images[i], cooker, options);
+        }
+      };
 
-      //Free the image data
-      stbi_image_free(pImageData);
+      SPtr<TaskGroup> decodeGroup;
+      if (bUseTasks && end - begin > 1) {
+        decodeGroup = TaskGroup::create("StbImageDecode", decodeFn, end - begin);
+        TaskScheduler::instance().addTaskGroup(decodeGroup);
+      }
+      else {
+        for (uint32 idx = 0; idx < end - begin; ++idx) {
+          decodeFn(idx);
+        }
+      }
 
-      renderAPI.generateMips(pTexture);
+      uploadWindow(prevBegin, prevEnd);
 
-      //Set the output resource
-      outRes = pTexture;
+      if (decodeGroup) {
+        decodeGroup->wait();
+      }
+      prevBegin = begin;
+      prevEnd = end;
     }
+
+    uploadWindow(prevBegin, prevEnd);
   }
 
   GE_PLUGIN_EXPORT bool
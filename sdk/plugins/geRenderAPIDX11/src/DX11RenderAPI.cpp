@@ -1235,14 +1235,15 @@ namespace geEngineSDK {
     if (!mountMan.exists(fileName)) {
       GE_LOG(kError,
              RenderAPI,
-             "Couldn't find shader file: {1}", fileName);
+             "Couldn't find shader file: {0}", fileName);
       safeRelease(pErrorBlob);
     }
 
     auto pFileStream = mountMan.open(fileName);
     Vector<uint8> fileData;
     pFileStream->getAllData(fileData);
-    const char* pSourceName = fileName.getFilename().c_str();
+    const String sourceName(fileName.getFilename());
+    const char* pSourceName = sourceName.c_str();
 
     hr = D3DCompile(fileData.data(),
                     fileData.size(),
@@ -1280,7 +1281,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile VertexShader Shader from {1}", fileName);
+             "Could not compile VertexShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1291,7 +1292,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create VertexShader Shader '{1}' from '{2}'",
+             "Failed to create VertexShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1308,7 +1309,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile PixelShader Shader from {1}", fileName);
+             "Could not compile PixelShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1319,7 +1320,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create PixelShader Shader '{1}' from '{2}'",
+             "Failed to create PixelShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1336,7 +1337,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile GeometryShader Shader from {1}", fileName);
+             "Could not compile GeometryShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1347,7 +1348,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create GeometryShader Shader '{1}' from '{2}'",
+             "Failed to create GeometryShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1383,7 +1384,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
         RenderAPI,
-        "Could not compile GeometryShader Shader from {1}", fileName);
+        "Could not compile GeometryShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1402,7 +1403,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed CreateGeometryShaderWithStreamOutput '{1}' from '{2}'",
+             "Failed CreateGeometryShaderWithStreamOutput '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1420,7 +1421,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile HullShader Shader from {1}", fileName);
+             "Could not compile HullShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1431,7 +1432,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create GeometryShader Shader '{1}' from '{2}'",
+             "Failed to create GeometryShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1448,7 +1449,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile DomainShader Shader from {1}", fileName);
+             "Could not compile DomainShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1459,7 +1460,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create DomainShader Shader '{1}' from '{2}'",
+             "Failed to create DomainShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -1476,7 +1477,7 @@ namespace geEngineSDK {
     if (!_compileFromFile(fileName, pMacro, szEntryPoint, szShaderModel, &vShader->m_pBlob)) {
       GE_LOG(kError,
              RenderAPI,
-             "Could not compile ComputeShader Shader from {1}", fileName);
+             "Could not compile ComputeShader Shader from {0}", fileName);
       return nullptr;
     }
 
@@ -1487,7 +1488,7 @@ namespace geEngineSDK {
     if (FAILED(hr)) {
       GE_LOG(kError,
              RenderAPI,
-             "Failed to create ComputeShader Shader '{1}' from '{2}'",
+             "Failed to create ComputeShader Shader '{0}' from '{1}'",
              szEntryPoint,
              fileName);
       return nullptr;
@@ -900,6 +900,18 @@ namespace geEngineSDK {
         return DXGI_FORMAT_R32G32B32A32_SINT;
       case VERTEX_ELEMENT_TYPE::UBYTE4:
         return DXGI_FORMAT_R8G8B8A8_UINT;
+      case VERTEX_ELEMENT_TYPE::HALF2:
+        return DXGI_FORMAT_R16G16_FLOAT;
+      case VERTEX_ELEMENT_TYPE::HALF4:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+      case VERTEX_ELEMENT_TYPE::SHORT2_NORM:
+        return DXGI_FORMAT_R16G16_SNORM;
+      case VERTEX_ELEMENT_TYPE::SHORT4_NORM:
+        return DXGI_FORMAT_R16G16B16A16_SNORM;
+      case VERTEX_ELEMENT_TYPE::USHORT2_NORM:
+        return DXGI_FORMAT_R16G16_UNORM;
+      case VERTEX_ELEMENT_TYPE::USHORT4_NORM:
+        return DXGI_FORMAT_R16G16B16A16_UNORM;
       default:
         break;
       }
@@ -0,0 +1,207 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geDDSLoader.h"
+
+#include <geTaskScheduler.h>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+
+  uint8
+  patternByte(uint32 arraySlice, uint32 mip, uint64 i) {
+    return cast::st<uint8>(arraySlice * 31 + mip * 7 + i + i / 251);
+  }
+
+  uint64
+  mipBytes(uint32 size, uint32 mip) {
+    const uint64 mipSize = std::max(1u, size >> mip);
+    return mipSize * mipSize * 4;
+  }
+
+  /**
+   * A DX10 file of RGBA8 cubemaps. Every subresource has its own pattern, so
+   * a byte copied to the wrong place shows.
+   */
+  Vector<uint8>
+  makeCubemapArrayDds(uint32 size, uint32 mipCount, uint32 numCubes) {
+    DDS_HEADER header{};
+    header.size = 124;
+    header.width = size;
+    header.height = size;
+    header.mipMapCount = mipCount;
+    header.ddspf.size = 32;
+    header.ddspf.flags = DDS_FOURCC;
+    header.ddspf.fourCC = FOURCC_DX10;
+    header.caps2 = DDSCAPS2_CUBEMAP;
+
+    DDS_HEADER_DXT10 dx10{};
+    dx10.dxgiFormat = GRAPHICS_FORMAT::kR8G8B8A8_UNORM;
+    dx10.resourceDimension = 3;
+    dx10.miscFlag = 0x4;
+    dx10.arraySize = numCubes;
+
+    const uint32 magic = DDS_MAGIC;
+    Vector<uint8> file(4 + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10));
+    std::memcpy(file.data(), &magic, 4);
+    std::memcpy(file.data() + 4, &header, sizeof(DDS_HEADER));
+    std::memcpy(file.data() + 4 + sizeof(DDS_HEADER), &dx10, sizeof(DDS_HEADER_DXT10));
+
+    for (uint32 slice = 0; slice < numCubes * 6; ++slice) {
+      for (uint32 mip = 0; mip < mipCount; ++mip) {
+        const SIZE_T begin = file.size();
+        file.resize(begin + cast::st<SIZE_T>(mipBytes(size, mip)));
+        for (SIZE_T i = begin; i < file.size(); ++i) {
+          file[i] = patternByte(slice, mip, i - begin);
+        }
+      }
+    }
+    return file;
+  }
+
+  /**
+   * Whether data holds the pattern of the subresource, which belongs to the
+   * level s.mip + firstMip of the file.
+   */
+  bool
+  hasPattern(const uint8* data, const SubresourceInfo& s, uint32 firstMip) {
+    for (uint64 i = 0; i < s.size; ++i) {
+      if (data[i] != patternByte(s.arraySlice, s.mip + firstMip, i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Vector<uint8>
+  packSequentially(const DdsTextureData& data) {
+    Vector<uint8> packed(cast::st<SIZE_T>(data.packedSize));
+    for (const auto& s : data.subresources) {
+      std::memcpy(packed.data() + s.offset, data.source + s.srcOffset, cast::st<SIZE_T>(s.size));
+    }
+    return packed;
+  }
+}
+
+TEST_CASE("DdsLoader: copies and reads in place the same subresources", "[DdsLoader]")
+{
+  const Vector<uint8> file = makeCubemapArrayDds(64, 7, 2);
+
+  for (uint32 firstMip : { 0u, 2u }) {
+    LoadOptions options;
+    options.firstMip = firstMip;
+    const DdsTextureData copied = DdsLoader::loadFromMemory(file.data(), file.size(), options);
+
+    options.inPlace = true;
+    const DdsTextureData inPlace = DdsLoader::loadFromMemory(file.data(), file.size(), options);
+
+    REQUIRE(copied.desc.width == (64u >> firstMip));
+    REQUIRE(copied.desc.mipCount == 7 - firstMip);
+    REQUIRE(copied.desc.arraySize == 12);
+    REQUIRE(copied.desc.isCubemap);
+    REQUIRE(copied.subresources.size() == 12 * (7 - firstMip));
+    REQUIRE(copied.blob.size() == copied.packedSize);
+
+    REQUIRE(inPlace.blob.empty());
+    REQUIRE(inPlace.source == file.data() + inPlace.headerSize);
+    REQUIRE(inPlace.packedSize == copied.packedSize);
+
+    for (const auto& s : copied.subresources) {
+      REQUIRE(copied.getData(s) == copied.blob.data() + s.offset);
+      REQUIRE(inPlace.getData(s) == inPlace.source + s.srcOffset);
+      REQUIRE(hasPattern(copied.getData(s), s, firstMip));
+      REQUIRE(hasPattern(inPlace.getData(s), s, firstMip));
+    }
+  }
+}
+
+TEST_CASE("DdsLoader: reads the headers alone or with the levels it keeps", "[DdsLoader]")
+{
+  const Vector<uint8> file = makeCubemapArrayDds(64, 7, 2);
+  const uint32 firstMip = 2;
+
+  LoadOptions options;
+  options.firstMip = firstMip;
+  const DdsTextureData copied = DdsLoader::loadFromMemory(file.data(), file.size(), options);
+
+  //The layout comes from the headers
+  LoadOptions headerOptions;
+  headerOptions.firstMip = firstMip;
+  headerOptions.headerOnly = true;
+  const DdsTextureData header = DdsLoader::loadFromMemory(file.data(),
+                                                          cast::st<SIZE_T>(copied.headerSize),
+                                                          headerOptions);
+  REQUIRE(header.source == nullptr);
+  REQUIRE(header.blob.empty());
+  REQUIRE(header.packedSize == copied.packedSize);
+  REQUIRE(header.subresources.size() == copied.subresources.size());
+  for (SIZE_T i = 0; i < header.subresources.size(); ++i) {
+    REQUIRE(header.subresources[i].offset == copied.subresources[i].offset);
+    REQUIRE(header.subresources[i].srcOffset == copied.subresources[i].srcOffset);
+  }
+
+  //The headers followed by the levels kept of every slice
+  const uint64 skippedSize = mipBytes(64, 0) + mipBytes(64, 1);
+  uint64 sliceSize = 0;
+  for (uint32 mip = 0; mip < 7; ++mip) {
+    sliceSize += mipBytes(64, mip);
+  }
+  Vector<uint8> range(file.begin(), file.begin() + cast::st<SIZE_T>(copied.headerSize));
+  for (uint32 slice = 0; slice < 12; ++slice) {
+    const uint64 sliceBegin = copied.headerSize + slice * sliceSize;
+    range.insert(range.end(),
+                 file.begin() + cast::st<SIZE_T>(sliceBegin + skippedSize),
+                 file.begin() + cast::st<SIZE_T>(sliceBegin + sliceSize));
+  }
+
+  options.inPlace = true;
+  options.skippedSize = skippedSize;
+  const DdsTextureData ranged = DdsLoader::loadFromMemory(range.data(), range.size(), options);
+  REQUIRE(ranged.packedSize == copied.packedSize);
+  for (const auto& s : ranged.subresources) {
+    REQUIRE(hasPattern(ranged.getData(s), s, firstMip));
+  }
+
+  //More skipped than the levels left out
+  options.skippedSize = skippedSize + 4;
+  REQUIRE_THROWS(DdsLoader::loadFromMemory(range.data(), range.size(), options));
+}
+
+TEST_CASE("DdsLoader: parallel copy matches a sequential one", "[DdsLoader]")
+{
+  ensureTaskSchedulerStartedForTests();
+
+  const Vector<uint8> file = makeCubemapArrayDds(512, 10, 2);
+
+  for (uint32 firstMip : { 0u, 1u }) {
+    LoadOptions options;
+    options.firstMip = firstMip;
+    options.inPlace = true;
+    const DdsTextureData data = DdsLoader::loadFromMemory(file.data(), file.size(), options);
+
+    //Some chunks end in the middle of a subresource
+    REQUIRE(data.packedSize > DdsLoader::BYTES_PER_CHUNK * 2);
+    const bool bSplitsSubresource = std::any_of(data.subresources.begin(),
+                                                data.subresources.end(),
+      [](const SubresourceInfo& s) {
+        const uint64 boundary = (s.offset / DdsLoader::BYTES_PER_CHUNK + 1) *
+                                DdsLoader::BYTES_PER_CHUNK;
+        return boundary < s.offset + s.size;
+      });
+    REQUIRE(bSplitsSubresource);
+
+    Vector<uint8> staging(cast::st<SIZE_T>(data.packedSize));
+    DdsLoader::writeSubresources(data, staging.data());
+    REQUIRE(staging == packSequentially(data));
+  }
+}
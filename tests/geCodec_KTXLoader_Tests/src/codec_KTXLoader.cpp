@@ -0,0 +1,236 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geKTXLoader.h"
+
+#include <geTaskScheduler.h>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+
+  uint8
+  patternByte(uint32 arraySlice, uint32 mip, uint64 i) {
+    return cast::st<uint8>(arraySlice * 31 + mip * 7 + i + i / 251);
+  }
+
+  /**
+   * A KTX2 file of RGBA8 cubemaps, written by libktx. Every image has its own
+   * pattern, so a byte copied to the wrong place shows.
+   */
+  Vector<uint8>
+  makeCubemapArrayKtx2(uint32 size, uint32 mipCount, uint32 numCubes) {
+    ktxTextureCreateInfo createInfo{};
+    createInfo.vkFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    createInfo.baseWidth = size;
+    createInfo.baseHeight = size;
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = 2;
+    createInfo.numLevels = mipCount;
+    createInfo.numLayers = numCubes;
+    createInfo.numFaces = 6;
+    createInfo.isArray = numCubes > 1;
+    createInfo.generateMipmaps = false;
+
+    ktxTexture2* texture2 = nullptr;
+    REQUIRE(KTX_SUCCESS == ktxTexture2_Create(&createInfo,
+                                              KTX_TEXTURE_CREATE_ALLOC_STORAGE,
+                                              &texture2));
+    SPtr<ktxTexture> texture(reinterpret_cast<ktxTexture*>(texture2),
+                             [](ktxTexture* t) { ktxTexture_Destroy(t); });
+
+    Vector<uint8> image;
+    for (uint32 layer = 0; layer < numCubes; ++layer) {
+      for (uint32 face = 0; face < 6; ++face) {
+        for (uint32 level = 0; level < mipCount; ++level) {
+          const SIZE_T mipSize = std::max(1u, size >> level);
+          image.resize(mipSize * mipSize * 4);
+          for (SIZE_T i = 0; i < image.size(); ++i) {
+            image[i] = patternByte(layer * 6 + face, level, i);
+          }
+          REQUIRE(KTX_SUCCESS == ktxTexture_SetImageFromMemory(texture.get(),
+                                                               level,
+                                                               layer,
+                                                               face,
+                                                               image.data(),
+                                                               image.size()));
+        }
+      }
+    }
+
+    ktx_uint8_t* bytes = nullptr;
+    ktx_size_t numBytes = 0;
+    REQUIRE(KTX_SUCCESS == ktxTexture_WriteToMemory(texture.get(), &bytes, &numBytes));
+    Vector<uint8> file(bytes, bytes + numBytes);
+    free(bytes);
+    return file;
+  }
+
+  /**
+   * Whether data holds the pattern of the subresource, which belongs to the
+   * level s.mip + firstMip of the file.
+   */
+  bool
+  hasPattern(const uint8* data, const SubresourceInfo& s, uint32 firstMip) {
+    for (uint64 i = 0; i < s.size; ++i) {
+      if (data[i] != patternByte(s.arraySlice, s.mip + firstMip, i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Vector<uint8>
+  packSequentially(const TextureData& data) {
+    Vector<uint8> packed(cast::st<SIZE_T>(data.packedSize));
+    for (const auto& s : data.subresources) {
+      std::memcpy(packed.data() + s.offset, data.source + s.srcOffset, cast::st<SIZE_T>(s.size));
+    }
+    return packed;
+  }
+}
+
+TEST_CASE("KtxLoader: copies and reads in place the same subresources", "[KtxLoader]")
+{
+  const Vector<uint8> file = makeCubemapArrayKtx2(64, 7, 2);
+
+  for (uint32 firstMip : { 0u, 2u }) {
+    LoadOptions options;
+    options.firstMip = firstMip;
+    const TextureData copied = KtxLoader::loadFromMemory(file.data(), file.size(), options);
+
+    options.inPlace = true;
+    const TextureData inPlace = KtxLoader::loadFromMemory(file.data(), file.size(), options);
+
+    REQUIRE(copied.desc.format == GRAPHICS_FORMAT::kR8G8B8A8_UNORM);
+    REQUIRE(copied.desc.width == (64u >> firstMip));
+    REQUIRE(copied.desc.mipCount == 7 - firstMip);
+    REQUIRE(copied.desc.arraySize == 12);
+    REQUIRE(copied.desc.isCubemap);
+    REQUIRE(copied.subresources.size() == 12 * (7 - firstMip));
+    REQUIRE(copied.blob.size() == copied.packedSize);
+
+    //An uncompressed KTX2 is read from the file itself
+    REQUIRE(inPlace.blob.empty());
+    REQUIRE(inPlace.owner == nullptr);
+    REQUIRE(inPlace.source == file.data() + ktx2ImageDataOffset(file.data(), file.size()));
+    REQUIRE(inPlace.packedSize == copied.packedSize);
+
+    for (const auto& s : copied.subresources) {
+      REQUIRE(copied.getData(s) == copied.blob.data() + s.offset);
+      REQUIRE(inPlace.getData(s) == inPlace.source + s.srcOffset);
+      REQUIRE(hasPattern(copied.getData(s), s, firstMip));
+      REQUIRE(hasPattern(inPlace.getData(s), s, firstMip));
+    }
+  }
+}
+
+TEST_CASE("KtxLoader: reads the headers alone or with the levels it keeps", "[KtxLoader]")
+{
+  const Vector<uint8> file = makeCubemapArrayKtx2(64, 7, 2);
+  const uint32 firstMip = 2;
+
+  LoadOptions options;
+  options.firstMip = firstMip;
+  options.inPlace = true;
+  const TextureData inPlace = KtxLoader::loadFromMemory(file.data(), file.size(), options);
+
+  //The layout comes from the headers
+  LoadOptions headerOptions;
+  headerOptions.firstMip = firstMip;
+  headerOptions.headerOnly = true;
+  const TextureData header = KtxLoader::loadFromMemory(file.data(), file.size(), headerOptions);
+  REQUIRE(header.source == nullptr);
+  REQUIRE(header.blob.empty());
+  REQUIRE(header.packedSize == inPlace.packedSize);
+  REQUIRE(header.subresources.size() == inPlace.subresources.size());
+  for (SIZE_T i = 0; i < header.subresources.size(); ++i) {
+    REQUIRE(header.subresources[i].offset == inPlace.subresources[i].offset);
+    REQUIRE(header.subresources[i].srcOffset == inPlace.subresources[i].srcOffset);
+  }
+
+  //The smallest level goes first, the file up to the end of firstMip holds
+  //every level kept
+  static constexpr SIZE_T LEVEL_INDEX_OFFSET = 80;
+  static constexpr SIZE_T LEVEL_INDEX_ENTRY_SIZE = 24;
+  uint64 levelOffset = 0;
+  uint64 levelLength = 0;
+  const uint8* levelEntry = file.data() + LEVEL_INDEX_OFFSET + firstMip * LEVEL_INDEX_ENTRY_SIZE;
+  std::memcpy(&levelOffset, levelEntry, 8);
+  std::memcpy(&levelLength, levelEntry + 8, 8);
+  REQUIRE(levelOffset + levelLength < file.size());
+
+  const Vector<uint8> prefix(file.begin(),
+                             file.begin() + cast::st<SIZE_T>(levelOffset + levelLength));
+  const TextureData ranged = KtxLoader::loadFromMemory(prefix.data(), prefix.size(), options);
+  REQUIRE(ranged.packedSize == inPlace.packedSize);
+  for (const auto& s : ranged.subresources) {
+    REQUIRE(hasPattern(ranged.getData(s), s, firstMip));
+  }
+}
+
+TEST_CASE("KtxLoader: finds the headers from the start of the file", "[KtxLoader]")
+{
+  const Vector<uint8> file = makeCubemapArrayKtx2(64, 7, 2);
+
+  //The first 80 bytes say where the level index and the metadata end, and
+  //the level index where the images start
+  const uint64 indexSize = ktx2HeaderSize(file.data(), 80);
+  REQUIRE(indexSize >= 80 + 7 * 24);
+  const uint64 headerSize = ktx2HeaderSize(file.data(), cast::st<SIZE_T>(indexSize));
+  REQUIRE(headerSize == ktx2ImageDataOffset(file.data(), file.size()));
+  REQUIRE(ktx2HeaderSize(file.data(), cast::st<SIZE_T>(headerSize)) == headerSize);
+  REQUIRE(ktx2ImageDataOffset(file.data(), cast::st<SIZE_T>(headerSize)) == headerSize);
+  REQUIRE(0 == ktx2HeaderSize(file.data() + 1, 80));
+
+  //The same layout without the images
+  LoadOptions options;
+  options.headerOnly = true;
+  const TextureData whole = KtxLoader::loadFromMemory(file.data(), file.size(), options);
+  const TextureData header = KtxLoader::loadFromMemory(file.data(),
+                                                       cast::st<SIZE_T>(headerSize),
+                                                       options);
+  REQUIRE(header.packedSize == whole.packedSize);
+  REQUIRE(header.subresources.size() == whole.subresources.size());
+  for (SIZE_T i = 0; i < header.subresources.size(); ++i) {
+    REQUIRE(header.subresources[i].srcOffset == whole.subresources[i].srcOffset);
+  }
+}
+
+TEST_CASE("KtxLoader: parallel copy matches a sequential one", "[KtxLoader]")
+{
+  ensureTaskSchedulerStartedForTests();
+
+  const Vector<uint8> file = makeCubemapArrayKtx2(512, 10, 2);
+
+  for (uint32 firstMip : { 0u, 1u }) {
+    LoadOptions options;
+    options.firstMip = firstMip;
+    options.inPlace = true;
+    const TextureData data = KtxLoader::loadFromMemory(file.data(), file.size(), options);
+
+    //Some chunks end in the middle of a subresource
+    REQUIRE(data.packedSize > KtxLoader::BYTES_PER_CHUNK * 2);
+    const bool bSplitsSubresource = std::any_of(data.subresources.begin(),
+                                                data.subresources.end(),
+      [](const SubresourceInfo& s) {
+        const uint64 boundary = (s.offset / KtxLoader::BYTES_PER_CHUNK + 1) *
+                                KtxLoader::BYTES_PER_CHUNK;
+        return boundary < s.offset + s.size;
+      });
+    REQUIRE(bSplitsSubresource);
+
+    Vector<uint8> staging(cast::st<SIZE_T>(data.packedSize));
+    KtxLoader::writeSubresources(data, staging.data());
+    REQUIRE(staging == packSequentially(data));
+  }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geDebugDraw.h"
+#include "geRenderAPI.h"
+
+#include <geBox.h>
+#include <geDynLib.h>
+#include <geDynLibManager.h>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  /**
+   * Loads the Null render API the same way the app loads its driver.
+   */
+  void
+  ensureNullRenderAPIStarted() {
+    if (RenderAPI::isStarted()) {
+      return;
+    }
+    if (!DynLibManager::isStarted()) {
+      DynLibManager::startUp();
+    }
+
+    auto renderAPIDll = g_dynLibManager().load("geRenderAPINull");
+    REQUIRE(nullptr != renderAPIDll);
+
+    typedef void (*InitFnPtr)(void);
+    auto initPluginFn = reinterpret_cast<InitFnPtr>(renderAPIDll->getSymbol("InitPlugin"));
+    REQUIRE(nullptr != initPluginFn);
+    initPluginFn();
+
+    REQUIRE(RenderAPI::isStarted());
+    RenderAPI::instance().initRenderAPI(WindowHandle(), false);
+  }
+
+  void
+  addLines(DebugDraw& debugDraw, uint32 numLines, float duration = 0.0f) {
+    for (uint32 i = 0; i < numLines; ++i) {
+      debugDraw.addLine(Vector3(0.0f, 0.0f, 0.0f),
+                        Vector3(1.0f, cast::st<float>(i), 0.0f),
+                        Color::Red,
+                        duration);
+    }
+  }
+}
+
+TEST_CASE("DebugDraw: lines from many threads reach the next update", "[DebugDraw]")
+{
+  ensureNullRenderAPIStarted();
+
+  DebugDraw first;
+  DebugDraw second;
+
+  //Every thread alternates between both instances
+  const uint32 NUM_THREADS = 4;
+  const uint32 LINES_PER_THREAD = 500;
+  Vector<Thread> threads;
+  for (uint32 t = 0; t < NUM_THREADS; ++t) {
+    threads.emplace_back([&first, &second]() {
+      for (uint32 i = 0; i < LINES_PER_THREAD; ++i) {
+        addLines((i & 1) ? second : first, 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  first.update();
+  second.update();
+  REQUIRE(first.getNumVertices() == NUM_THREADS * LINES_PER_THREAD);
+  REQUIRE(second.getNumVertices() == NUM_THREADS * LINES_PER_THREAD);
+
+  //The lines were taken by the update
+  first.reset();
+  first.update();
+  REQUIRE(first.getNumVertices() == 0);
+}
+
+TEST_CASE("DebugDraw: timed lines expire", "[DebugDraw]")
+{
+  ensureNullRenderAPIStarted();
+
+  DebugDraw debugDraw;
+  addLines(debugDraw, 1, 1.0f);
+  debugDraw.addBox(AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)));
+
+  debugDraw.update(0.0f);
+  REQUIRE(debugDraw.getNumVertices() == 26);
+  REQUIRE(debugDraw.getNumPersistentLines() == 1);
+
+  //The box was for a single frame, the line stays for its second
+  debugDraw.reset();
+  debugDraw.update(0.5f);
+  REQUIRE(debugDraw.getNumVertices() == 2);
+
+  debugDraw.update(0.6f);
+  REQUIRE(debugDraw.getNumVertices() == 0);
+  REQUIRE(debugDraw.getNumPersistentLines() == 0);
+
+  //Deep into a session the clock still advances by small steps
+  debugDraw.update(16777216.0f);
+  addLines(debugDraw, 1, 0.5f);
+  debugDraw.update(0.25f);
+  debugDraw.update(0.25f);
+  REQUIRE(debugDraw.getNumPersistentLines() == 1);
+  debugDraw.update(0.3f);
+  REQUIRE(debugDraw.getNumPersistentLines() == 0);
+}
+
+TEST_CASE("DebugDraw: frames append to the ring buffer", "[DebugDraw]")
+{
+  ensureNullRenderAPIStarted();
+
+  DebugDraw debugDraw;
+  REQUIRE(debugDraw.getVertexCapacity() == DebugDraw::VERTEX_CHUNK_SIZE);
+
+  auto drawFrame = [&debugDraw](uint32 numLines) {
+    addLines(debugDraw, numLines);
+    debugDraw.update();
+    debugDraw.reset();
+    return debugDraw.getFirstVertex();
+  };
+
+  //Each frame goes after the previous one until it doesn't fit
+  REQUIRE(drawFrame(1000) == 0);
+  REQUIRE(drawFrame(1000) == 2000);
+  REQUIRE(drawFrame(1000) == 0);
+  REQUIRE(debugDraw.getVertexCapacity() == DebugDraw::VERTEX_CHUNK_SIZE);
+
+  //A bigger frame grows the buffer in whole chunks, for a few frames
+  REQUIRE(drawFrame(3000) == 0);
+  const uint32 capacity = debugDraw.getVertexCapacity();
+  REQUIRE(capacity >= 6000 * DebugDraw::RING_FRAMES);
+  REQUIRE(capacity % DebugDraw::VERTEX_CHUNK_SIZE == 0);
+
+  REQUIRE(drawFrame(3000) == 6000);
+  REQUIRE(drawFrame(3000) == 12000);
+  REQUIRE(drawFrame(3000) == 0);
+  REQUIRE(debugDraw.getVertexCapacity() == capacity);
+}
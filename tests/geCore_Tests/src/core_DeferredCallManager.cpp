@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geDeferredCallManager.h"
+
+using namespace geEngineSDK;
+
+TEST_CASE("DeferredCallManager: calls run in order, by priority", "[DeferredCallManager]")
+{
+  DeferredCallManager calls;
+
+  Vector<int32> order;
+  auto record = [&order](int32 value) { order.push_back(value); };
+  calls.queueDeferredCall(record, 1);
+  calls.queueDeferredCall(record, 2);
+  calls.queuePrioritizedCall(DEFERRED_PRIORITY::kLow, record, 10);
+  calls.queuePrioritizedCall(DEFERRED_PRIORITY::kHigh, record, -1);
+  calls.queueDeferredCall(record, 3);
+  REQUIRE(calls.size() == 5);
+
+  REQUIRE(calls.pumpFor(1000000) == 5);
+  REQUIRE(order == Vector<int32>{ -1, 1, 2, 3, 10 });
+  REQUIRE(calls.empty());
+
+  const DeferredCallStats& stats = calls.getLastFrameStats();
+  REQUIRE(stats.numExecuted == 5);
+  REQUIRE(stats.numRemaining == 0);
+  REQUIRE(stats.budgetUs == 1000000);
+}
+
+TEST_CASE("DeferredCallManager: large callables and dropped calls", "[DeferredCallManager]")
+{
+  DeferredCallManager calls;
+
+  auto shared = ge_shared_ptr_new<int32>(0);
+  Array<uint64, 64> big{};
+  big[63] = 7;
+  calls.queueDeferredCall([shared, big]() { *shared += cast::st<int32>(big[63]); });
+  calls.queueDeferredCall([shared]() { *shared += 1; });
+  REQUIRE(shared.use_count() == 3);
+
+  REQUIRE(calls.pumpFor(1000000) == 2);
+  REQUIRE(*shared == 8);
+  REQUIRE(shared.use_count() == 1);
+
+  //Dropped calls release their captures without running
+  calls.queueDeferredCall([shared, big]() { *shared = -1; });
+  calls.queueDeferredCall([shared]() { *shared = -1; });
+  calls.clear();
+  REQUIRE(calls.empty());
+  REQUIRE(*shared == 8);
+  REQUIRE(shared.use_count() == 1);
+
+  //Destroying the manager drops them too
+  {
+    DeferredCallManager other;
+    other.queueDeferredCall([shared]() { *shared = -1; });
+    REQUIRE(shared.use_count() == 2);
+  }
+  REQUIRE(*shared == 8);
+  REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("DeferredCallManager: the budget leaves calls for the next frames", "[DeferredCallManager]")
+{
+  DeferredCallManager calls;
+
+  uint32 numRun = 0;
+  for (uint32 i = 0; i < 50; ++i) {
+    calls.queueDeferredCall([&numRun]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      ++numRun;
+    });
+  }
+
+  const uint32 executed = calls.pumpFor(1000);
+  REQUIRE(executed > 0);
+  REQUIRE(executed < 50);
+  REQUIRE(calls.getLastFrameStats().numRemaining == 50 - executed);
+
+  while (!calls.empty()) {
+    calls.pumpFor(1000);
+  }
+  REQUIRE(numRun == 50);
+
+  //A single call longer than the budget is an overrun
+  const uint64 overruns = calls.getLastFrameStats().totalOverruns;
+  calls.queueDeferredCall([]() {
+    std::this_thread::sleep_for(std::chrono::microseconds(3000));
+  });
+  REQUIRE(calls.pumpFor(1000) == 1);
+  REQUIRE(calls.getLastFrameStats().overrunUs > 0);
+  REQUIRE(calls.getLastFrameStats().totalOverruns == overruns + 1);
+}
+
+TEST_CASE("DeferredCallManager: calls queued from many threads", "[DeferredCallManager]")
+{
+  DeferredCallManager calls;
+
+  CONSTEXPR uint32 NUM_THREADS = 4;
+  CONSTEXPR uint32 NUM_CALLS = 5000;
+
+  //The calls of each thread and priority must run in the order queued
+  Array<Array<int64, 2>, NUM_THREADS> lastRun;
+  for (auto& last : lastRun) {
+    last = { -1, -1 };
+  }
+  uint32 numOutOfOrder = 0;
+  std::atomic<uint32> numDone{ 0 };
+
+  Vector<Thread> producers;
+  for (uint32 t = 0; t < NUM_THREADS; ++t) {
+    producers.emplace_back([&, t]() {
+      for (uint32 i = 0; i < NUM_CALLS; ++i) {
+        const auto priority = cast::st<DEFERRED_PRIORITY::E>(i % 2);
+        calls.queuePrioritizedCall(priority, [&, t, i, priority]() {
+          int64& last = lastRun[t][priority];
+          numOutOfOrder += cast::st<int64>(i) <= last ? 1U : 0U;
+          last = i;
+        });
+      }
+      ++numDone;
+    });
+  }
+
+  while (numDone < NUM_THREADS || !calls.empty()) {
+    calls.pumpFor(100);
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  REQUIRE(numOutOfOrder == 0);
+  for (uint32 t = 0; t < NUM_THREADS; ++t) {
+    REQUIRE(lastRun[t][0] == NUM_CALLS - 2);
+    REQUIRE(lastRun[t][1] == NUM_CALLS - 1);
+  }
+}
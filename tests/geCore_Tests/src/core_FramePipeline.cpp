@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geFramePipeline.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  struct FrameState
+  {
+    uint64 frame = 0;
+    Vector<uint32> values;
+  };
+}
+
+TEST_CASE("FramePipeline: without latency renders on submit", "[FramePipeline]")
+{
+  FramePipeline pipeline(0);
+  REQUIRE(pipeline.getNumSlots() == 1);
+
+  const auto callerId = std::this_thread::get_id();
+  Vector<int32> order;
+  pipeline.enqueue([&]() { order.push_back(1); });
+  pipeline.enqueue([&]() {
+    order.push_back(2);
+    REQUIRE(std::this_thread::get_id() == callerId);
+  });
+  REQUIRE(order.empty());
+
+  pipeline.submitFrame();
+  REQUIRE(order == Vector<int32>{ 1, 2 });
+  REQUIRE(pipeline.getSimFrame() == 1);
+  REQUIRE(pipeline.getNumRenderedFrames() == 1);
+}
+
+TEST_CASE("FramePipeline: the render thread replays the frames in order", "[FramePipeline]")
+{
+  FramePipeline pipeline(2);
+  FrameSnapshot<FrameState> snapshot(pipeline);
+
+  std::atomic<uint32> numMismatches{ 0 };
+  std::atomic<bool> bOnCaller{ false };
+  Vector<uint64> rendered;
+  const auto callerId = std::this_thread::get_id();
+
+  for (uint64 frame = 0; frame < 200; ++frame) {
+    //The simulation fills the state of this frame
+    FrameState& state = snapshot.getSimState();
+    state.frame = frame;
+    state.values.assign(16, cast::st<uint32>(frame));
+
+    pipeline.enqueue([&, frame]() {
+      const FrameState& renderState = snapshot.getRenderState();
+      if (renderState.frame != frame ||
+          renderState.values != Vector<uint32>(16, cast::st<uint32>(frame))) {
+        ++numMismatches;
+      }
+      if (std::this_thread::get_id() == callerId) {
+        bOnCaller = true;
+      }
+      rendered.push_back(frame);
+
+      //A render slower than the simulation
+      if (0 == frame % 8) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+      }
+    });
+    pipeline.submitFrame();
+
+    REQUIRE(pipeline.getSimFrame() - pipeline.getNumRenderedFrames() <= 2);
+  }
+
+  pipeline.flush();
+  REQUIRE(pipeline.getNumRenderedFrames() == 200);
+  REQUIRE(numMismatches == 0);
+  REQUIRE_FALSE(bOnCaller);
+  REQUIRE(rendered.size() == 200);
+  for (uint64 i = 0; i < rendered.size(); ++i) {
+    REQUIRE(rendered[i] == i);
+  }
+}
+
+TEST_CASE("FramePipeline: renders the submitted frames before stopping", "[FramePipeline]")
+{
+  std::atomic<uint32> numCommands{ 0 };
+  {
+    FramePipeline pipeline(FramePipeline::MAX_LATENCY + 5);
+    REQUIRE(pipeline.getLatency() == FramePipeline::MAX_LATENCY);
+
+    for (uint32 frame = 0; frame < 10; ++frame) {
+      for (uint32 i = 0; i < 3; ++i) {
+        pipeline.enqueue([&numCommands]() { ++numCommands; });
+      }
+      pipeline.submitFrame();
+    }
+
+    //Never submitted
+    pipeline.enqueue([&numCommands]() { numCommands += 100; });
+  }
+  REQUIRE(numCommands == 30);
+}
+
+TEST_CASE("FramePipeline: the simulation waits for the device", "[FramePipeline]")
+{
+  FramePipeline immediate(0);
+  REQUIRE(immediate.isRenderThread());
+
+  FramePipeline pipeline(2);
+  REQUIRE_FALSE(pipeline.isRenderThread());
+
+  std::atomic<bool> bDeviceInUse{ false };
+  std::atomic<bool> bOnRenderThread{ true };
+  for (uint32 frame = 0; frame < 20; ++frame) {
+    pipeline.enqueue([&]() {
+      bDeviceInUse = true;
+      if (!pipeline.isRenderThread()) {
+        bOnRenderThread = false;
+      }
+      pipeline.waitForDevice();
+      std::this_thread::sleep_for(std::chrono::microseconds(300));
+      bDeviceInUse = false;
+    });
+    pipeline.submitFrame();
+
+    //Nothing renders until the next frame is submitted
+    pipeline.waitForDevice();
+    REQUIRE(pipeline.getNumRenderedFrames() == pipeline.getSimFrame());
+    REQUIRE_FALSE(bDeviceInUse);
+  }
+  REQUIRE(bOnRenderThread);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "geGameConfig.h"
+#include "geMountManager.h"
+#include "geDiskFileSystem.h"
+
+using namespace geEngineSDK;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  fs::path
+  makeConfigDir(const char* name) {
+    auto base = fs::temp_directory_path() / "geEngineSDK_tests" / name / "";
+    std::error_code ec;
+    fs::remove_all(base, ec);
+    fs::create_directories(base);
+    return base;
+  }
+
+  void
+  writeConfig(const fs::path& p, const std::string& text) {
+    std::ofstream f(p, std::ios::binary | std::ios::trunc);
+    f.write(text.data(), static_cast<std::streamsize>(text.size()));
+  }
+
+  /**
+   * @brief Modules can only be started once per process, so the tests share
+   *        them and only swap the mounted directory.
+   */
+  GameConfig&
+  startConfigForTests(const fs::path& root) {
+    if (!MountManager::isStarted()) {
+      MountManager::startUp();
+    }
+    if (!GameConfig::isStarted()) {
+      GameConfig::startUp();
+    }
+
+    auto& mountManager = MountManager::instance();
+    mountManager.clear();
+    mountManager.mount(ge_shared_ptr_new<DiskFileSystem>(Path(String(root.string()))));
+    return GameConfig::instance();
+  }
+}
+
+TEST_CASE("GameConfig: typed variables read the parsed values", "[GameConfig]") {
+  auto root = makeConfigDir("game_config_typed");
+  writeConfig(root / "Engine.ini",
+              "# Comment line\r\n"
+              "Global Key = 7\r\n"
+              "\r\n"
+              "[ Window ]\r\n"
+              "Width=1920\r\n"
+              "  height =  1080  \r\n"
+              "Title = My Game = Best Game\r\n"
+              "FullScreen=true\r\n"
+              "Scale=0.5\r\n"
+              "Empty=\r\n");
+  auto& config = startConfigForTests(root);
+
+  //Resolved before loading, bound once the file is read
+  auto width = config.getVar<uint32>("WINDOW", "WIDTH", 1280);
+  REQUIRE(width.get() == 1280);
+
+  REQUIRE(config.load("Engine.ini"));
+  REQUIRE(width.get() == 1920);
+
+  REQUIRE(config.getVar<int32>("window", "Height", 0).get() == 1080);
+  REQUIRE(config.getVar<String>("WINDOW", "TITLE", "").get() == "My Game = Best Game");
+  REQUIRE(config.getVar<bool>("WINDOW", "FULLSCREEN", false).get());
+  REQUIRE(config.getVar<float>("WINDOW", "SCALE", 1.0f).get() == 0.5f);
+  REQUIRE(config.getVar<int32>("GLOBAL", "GLOBAL KEY", 0).get() == 7);
+
+  //Missing or empty values keep the default
+  REQUIRE(config.getVar<String>("WINDOW", "EMPTY", "None").get() == "None");
+  REQUIRE(config.getVar<int32>("WINDOW", "MISSING", -1).get() == -1);
+
+  //The handles agree with the string based lookup
+  REQUIRE(config.get<uint32>("Window", "Width", 0) == width.get());
+}
+
+TEST_CASE("GameConfig: set and reload update variables and notify", "[GameConfig]") {
+  auto root = makeConfigDir("game_config_reload");
+  writeConfig(root / "Engine.ini", "[Video]\nWidth=800\nHeight=600\n");
+  auto& config = startConfigForTests(root);
+  REQUIRE(config.load("Engine.ini"));
+
+  auto width = config.getVar<uint32>("VIDEO", "WIDTH", 0);
+  auto height = config.getVar<uint32>("VIDEO", "HEIGHT", 0);
+  REQUIRE(width.get() == 800);
+
+  int32 widthChanges = 0;
+  int32 heightChanges = 0;
+  int32 reloads = 0;
+  auto widthConn = width.onChanged([&]() { ++widthChanges; });
+  auto heightConn = height.onChanged([&]() { ++heightChanges; });
+  auto reloadConn = config.onReloaded.connect([&]() { ++reloads; });
+
+  config.set<uint32>("video", "width", 1024);
+  REQUIRE(width.get() == 1024);
+  REQUIRE(config.get<uint32>("VIDEO", "WIDTH", 0) == 1024);
+  REQUIRE(widthChanges == 1);
+  REQUIRE(heightChanges == 0);
+
+  writeConfig(root / "Engine.ini", "[Video]\nWidth=800\nHeight=720\n");
+  REQUIRE(config.reload());
+  REQUIRE(width.get() == 800);
+  REQUIRE(height.get() == 720);
+  REQUIRE(widthChanges == 2);
+  REQUIRE(heightChanges == 1);
+  REQUIRE(reloads == 1);
+
+  //Values that are removed go back to the default
+  writeConfig(root / "Engine.ini", "[Video]\nWidth=800\n");
+  REQUIRE(config.reload());
+  REQUIRE(height.get() == 0);
+  REQUIRE(widthChanges == 2);
+  REQUIRE(heightChanges == 2);
+}
@@ -0,0 +1,303 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "geOcclusionCuller.h"
+#include "geModelComponent.h"
+
+#include <geTaskScheduler.h>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+
+  Camera
+  makeCamera() {
+    Camera camera;
+    camera.setPerspective(Degree(45.0f), 1280.0f, 720.0f, 0.1f, 100.0f);
+    camera.setPosition(Vector3(0.0f, 0.0f, 0.0f));
+    camera.setLookAt(Vector3(0.0f, 0.0f, 1.0f));
+    return camera;
+  }
+
+  /**
+   * A unit box submesh that occludes with its own triangles.
+   */
+  SubMesh
+  makeBoxSubMesh() {
+    SubMesh subMesh;
+    subMesh.m_bounds = AABox(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
+    subMesh.m_vertexCount = 8;
+    subMesh.m_indexCount = 36;
+
+    for (uint32 i = 0; i < 8; ++i) {
+      subMesh.m_occluderPositions.push_back(Vector3((i & 1) ? 0.5f : -0.5f,
+                                                    (i & 2) ? 0.5f : -0.5f,
+                                                    (i & 4) ? 0.5f : -0.5f));
+    }
+
+    //Two triangles per face, the corners of every face in a loop
+    const uint32 faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 },
+                                 { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+    for (const auto& face : faces) {
+      subMesh.m_occluderIndices.insert(subMesh.m_occluderIndices.end(),
+                                       { face[0], face[1], face[2],
+                                         face[0], face[2], face[3] });
+    }
+    return subMesh;
+  }
+
+  AABox
+  makeBox(const Vector3& center, float halfSize) {
+    return AABox(center - Vector3(halfSize, halfSize, halfSize),
+                 center + Vector3(halfSize, halfSize, halfSize));
+  }
+
+  Matrix4
+  makeWorld(const Vector3& position, float scale) {
+    Matrix4 world = Matrix4::IDENTITY;
+    world.m[0][0] = world.m[1][1] = world.m[2][2] = scale;
+    world.m[3][0] = position.x;
+    world.m[3][1] = position.y;
+    world.m[3][2] = position.z;
+    return world;
+  }
+
+  /**
+   * A grid of box buildings in front of the camera.
+   */
+  void
+  addCity(OcclusionCuller& culler, const SubMesh& building, uint32 size) {
+    for (uint32 i = 0; i < size * size; ++i) {
+      const Vector3 position(float(i % size) * 4.0f - float(size) * 2.0f,
+                             0.0f,
+                             float(i / size) * 4.0f + 5.0f);
+      culler.addOccluder(building, makeWorld(position, 2.0f));
+    }
+  }
+}
+
+TEST_CASE("OcclusionCuller: boxes behind a wall", "[OcclusionCuller]")
+{
+  Camera camera = makeCamera();
+  const SubMesh wall = makeBoxSubMesh();
+
+  OcclusionCuller culler(200, 100);
+  REQUIRE(culler.getWidth() == 256);
+  REQUIRE(culler.getHeight() == 128);
+
+  //A 10x10 wall, 10 units ahead
+  Matrix4 wallWorld = makeWorld(Vector3(0.0f, 0.0f, 10.0f), 10.0f);
+  wallWorld.m[2][2] = 0.1f;
+
+  culler.beginFrame(camera);
+  culler.addOccluder(wall, wallWorld);
+  culler.render();
+  REQUIRE(culler.getNumTriangles() > 0);
+
+  //Far from the middle of the screen there is only the clear depth
+  REQUIRE(culler.getDepth(128, 64) < 1.0f);
+  REQUIRE(culler.getDepth(2, 64) == 1.0f);
+
+  REQUIRE_FALSE(culler.isVisible(makeBox(Vector3(0.0f, 0.0f, 20.0f), 1.0f)));
+  REQUIRE_FALSE(culler.isVisible(makeBox(Vector3(2.0f, -2.0f, 50.0f), 2.0f)));
+
+  //In front, around the edge, to the side, and crossing the near plane
+  REQUIRE(culler.isVisible(makeBox(Vector3(0.0f, 0.0f, 5.0f), 1.0f)));
+  REQUIRE(culler.isVisible(makeBox(Vector3(10.0f, 0.0f, 20.0f), 1.0f)));
+  REQUIRE(culler.isVisible(makeBox(Vector3(15.0f, 0.0f, 20.0f), 1.0f)));
+  REQUIRE(culler.isVisible(makeBox(Vector3(0.0f, 0.0f, 0.0f), 1.0f)));
+
+  //The box of the wall itself is not hidden by it
+  REQUIRE(culler.isVisible(wall.m_bounds.transformBy(wallWorld)));
+}
+
+TEST_CASE("OcclusionCuller: clips occluders at the near plane", "[OcclusionCuller]")
+{
+  Camera camera = makeCamera();
+  const SubMesh ground = makeBoxSubMesh();
+
+  //A large slab under the camera, it starts behind it
+  Matrix4 groundWorld = makeWorld(Vector3(0.0f, -1.5f, 0.0f), 1000.0f);
+  groundWorld.m[1][1] = 1.0f;
+
+  OcclusionCuller culler;
+  culler.beginFrame(camera);
+  culler.addOccluder(ground, groundWorld);
+  culler.render();
+
+  //Bottom half of the screen is covered, up to the horizon
+  REQUIRE(culler.getDepth(culler.getWidth() / 2, culler.getHeight() - 1) < 1.0f);
+  REQUIRE(culler.getDepth(0, culler.getHeight() - 1) < 1.0f);
+  REQUIRE(culler.getDepth(culler.getWidth() / 2, 0) == 1.0f);
+
+  //Under the top of the slab
+  REQUIRE_FALSE(culler.isVisible(makeBox(Vector3(0.0f, -3.0f, 10.0f), 0.5f)));
+  REQUIRE(culler.isVisible(makeBox(Vector3(0.0f, 0.0f, 10.0f), 0.5f)));
+}
+
+TEST_CASE("OcclusionCuller: culls the visible list of a scene", "[OcclusionCuller]")
+{
+  auto model = ge_shared_ptr_new<Model>();
+  MeshData mesh;
+  mesh.m_subMeshes.push_back(makeBoxSubMesh());
+  model->m_meshes.push_back(mesh);
+  model->updateBounds();
+
+  Scene scene;
+  auto addActor = [&](const Vector3& position, float scale) {
+    auto actor = scene.createActor();
+    actor->addComponent<ModelComponent>()->setModel(model);
+    actor->getSceneNode().setLocalTransform(Transform(Quaternion::IDENTITY,
+                                                      position,
+                                                      Vector3(scale, scale, scale)));
+    return actor;
+  };
+
+  auto building = addActor(Vector3(0.0f, 0.0f, 10.0f), 4.0f);
+  auto hidden = addActor(Vector3(0.0f, 0.0f, 30.0f), 1.0f);
+  auto aside = addActor(Vector3(25.0f, 0.0f, 30.0f), 1.0f);
+  scene.update(0.0f);
+
+  Camera camera = makeCamera();
+  SceneCuller sceneCuller;
+  Vector<Vector<VisibleSubMesh>> visible;
+  sceneCuller.cull(scene, { CullView(camera.getFrustum()) }, visible);
+  REQUIRE(visible[0].size() == 3);
+
+  OcclusionCuller culler;
+  culler.beginFrame(camera);
+  culler.addOccluders(visible[0]);
+  culler.render();
+
+  //The small ones are too small to be occluders
+  REQUIRE(culler.getNumTriangles() > 0);
+  REQUIRE(culler.getNumTriangles() <= 12);
+
+  culler.cull(visible[0]);
+  auto isInList = [&visible](const SPtr<Actor>& actor) {
+    return visible[0].end() != std::find_if(visible[0].begin(), visible[0].end(),
+      [&actor](const VisibleSubMesh& entry) { return entry.actor == actor.get(); });
+  };
+  REQUIRE(visible[0].size() == 2);
+  REQUIRE(isInList(building));
+  REQUIRE(isInList(aside));
+  REQUIRE_FALSE(isInList(hidden));
+}
+
+TEST_CASE("OcclusionCuller: parallel rendering matches the serial one", "[OcclusionCuller]")
+{
+  Camera camera = makeCamera();
+  const SubMesh building = makeBoxSubMesh();
+
+  OcclusionCuller serial;
+  serial.beginFrame(camera);
+  addCity(serial, building, 40);
+  serial.render();
+
+  ensureTaskSchedulerStartedForTests();
+
+  OcclusionCuller parallel;
+  parallel.beginFrame(camera);
+  addCity(parallel, building, 40);
+  parallel.render();
+
+  REQUIRE(parallel.getNumTriangles() == serial.getNumTriangles());
+  for (uint32 y = 0; y < serial.getHeight(); ++y) {
+    for (uint32 x = 0; x < serial.getWidth(); ++x) {
+      REQUIRE(parallel.getDepth(x, y) == serial.getDepth(x, y));
+    }
+  }
+}
+
+TEST_CASE("OcclusionCuller: triangles set up together match the ones set up alone", "[OcclusionCuller]")
+{
+  Camera camera = makeCamera();
+  const SubMesh box = makeBoxSubMesh();
+  const uint32 numTriangles = cast::st<uint32>(box.m_occluderIndices.size()) / 3;
+
+  //Both windings, one crossing the near plane and one seen edge on
+  Matrix4 mirrored = makeWorld(Vector3(-3.0f, 1.0f, 8.0f), 2.0f);
+  mirrored.m[0][0] = -2.0f;
+  Matrix4 flat = makeWorld(Vector3(0.0f, 0.0f, 6.0f), 1.0f);
+  flat.m[1][1] = 0.0f;
+  const Matrix4 worlds[] = { makeWorld(Vector3(2.0f, -1.0f, 12.0f), 3.0f),
+                             mirrored,
+                             makeWorld(Vector3(0.5f, -1.0f, 0.5f), 2.0f),
+                             flat };
+
+  OcclusionCuller together(200, 100);
+  together.beginFrame(camera);
+  for (const auto& world : worlds) {
+    together.addOccluder(box, world);
+  }
+  together.render();
+
+  //Rendered one triangle at a time, the nearest depth of every pixel
+  uint32 numAlone = 0;
+  Vector<float> nearest(together.getWidth() * together.getHeight(), 1.0f);
+  OcclusionCuller alone(200, 100);
+  for (const auto& world : worlds) {
+    for (uint32 i = 0; i < numTriangles; ++i) {
+      alone.beginFrame(camera);
+      alone.addOccluder(box.m_occluderPositions.data(),
+                        &box.m_occluderIndices[i * 3],
+                        3,
+                        world);
+      alone.render();
+      numAlone += alone.getNumTriangles();
+
+      for (uint32 y = 0; y < alone.getHeight(); ++y) {
+        for (uint32 x = 0; x < alone.getWidth(); ++x) {
+          float& depth = nearest[y * alone.getWidth() + x];
+          depth = Math::min(depth, alone.getDepth(x, y));
+        }
+      }
+    }
+  }
+
+  REQUIRE(together.getNumTriangles() == numAlone);
+  for (uint32 y = 0; y < together.getHeight(); ++y) {
+    for (uint32 x = 0; x < together.getWidth(); ++x) {
+      REQUIRE(together.getDepth(x, y) == nearest[y * together.getWidth() + x]);
+    }
+  }
+}
+
+TEST_CASE("OcclusionCuller: throughput", "[.][benchmark][OcclusionCuller]")
+{
+  ensureTaskSchedulerStartedForTests();
+
+  Camera camera = makeCamera();
+  const SubMesh building = makeBoxSubMesh();
+  OcclusionCuller culler;
+
+  BENCHMARK("render 10k box occluders") {
+    culler.beginFrame(camera);
+    addCity(culler, building, 100);
+    culler.render();
+    return culler.getNumTriangles();
+  };
+
+  culler.beginFrame(camera);
+  addCity(culler, building, 100);
+  culler.render();
+
+  BENCHMARK("test 10k boxes") {
+    uint32 numVisible = 0;
+    for (uint32 i = 0; i < 10000; ++i) {
+      const Vector3 center(float(i % 100) * 4.0f - 198.0f, 0.0f, float(i / 100) * 4.0f + 7.0f);
+      numVisible += culler.isVisible(makeBox(center, 0.5f)) ? 1 : 0;
+    }
+    return numVisible;
+  };
+}
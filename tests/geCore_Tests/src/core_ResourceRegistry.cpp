@@ -0,0 +1,256 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geResourceManagerBase.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  class TestResource : public Resource
+  {
+   public:
+    explicit TestResource(SIZE_T size = 0, int32 value = 0)
+      : m_size(size),
+        m_value(value) {}
+
+    void
+    moveFrom(Resource& other) override {
+      auto& resource = static_cast<TestResource&>(other);
+      m_size = resource.m_size;
+      m_value = resource.m_value;
+    }
+
+    bool
+    load(const Path&) override {
+      return true;
+    }
+
+    void
+    unload() override {}
+
+    bool
+    isLoaded() const override {
+      return true;
+    }
+
+    SIZE_T
+    getMemoryUsage() const override {
+      return m_size;
+    }
+
+    SIZE_T m_size;
+    int32 m_value;
+  };
+
+  using TestRegistry = ResourceRegistry<TestResource>;
+
+  SIZE_T
+  measure(const SPtr<TestResource>& resource) {
+    return resource->getMemoryUsage();
+  }
+
+  bool
+  keepNone(const SPtr<TestResource>&) {
+    return false;
+  }
+
+  SPtr<TestResource>
+  store(TestRegistry& registry, uint32 id, SIZE_T size) {
+    auto resource = ge_shared_ptr_new<TestResource>(size, cast::st<int32>(id));
+    return registry.update(id,
+                           [&resource](const SPtr<TestResource>&) { return resource; },
+                           measure);
+  }
+
+  class TestManager : public ResourceManagerBase<TestManager, TestResource>
+  {
+   public:
+    SPtr<TestResource>
+    _loadResource(const Path& filePath, bool, bool) {
+      ++m_numLoads;
+      return ge_shared_ptr_new<TestResource>(filePath.toString().size(), m_numLoads);
+    }
+
+    bool
+    _reuseLoadedResource(const SPtr<TestResource>&,
+                         const SPtr<TestResource>&,
+                         bool bReload) const {
+      return bReload;
+    }
+
+    int32 m_numLoads = 0;
+  };
+}
+
+TEST_CASE("ResourceRegistry: find, replace and remove", "[ResourceRegistry]")
+{
+  TestRegistry registry;
+  REQUIRE(registry.find(1) == nullptr);
+
+  auto first = store(registry, 1, 100);
+  store(registry, 17, 50);
+  REQUIRE(registry.find(1) == first);
+  REQUIRE(registry.find(17)->m_value == 17);
+  REQUIRE(registry.size() == 2);
+  REQUIRE(registry.getMemoryUsage() == 150);
+
+  //Replacing counts the new size only
+  auto second = store(registry, 1, 30);
+  REQUIRE(registry.find(1) == second);
+  REQUIRE(registry.size() == 2);
+  REQUIRE(registry.getMemoryUsage() == 80);
+
+  //The same resource with new contents is measured again
+  second->m_size = 60;
+  registry.update(1, [](const SPtr<TestResource>& current) { return current; }, measure);
+  REQUIRE(registry.getMemoryUsage() == 110);
+
+  registry.remove(1);
+  REQUIRE(registry.find(1) == nullptr);
+  REQUIRE(registry.size() == 1);
+  REQUIRE(registry.getMemoryUsage() == 50);
+
+  registry.clear();
+  REQUIRE(registry.size() == 0);
+  REQUIRE(registry.getMemoryUsage() == 0);
+  REQUIRE(second.use_count() == 1);
+}
+
+TEST_CASE("ResourceRegistry: the budget evicts the least recently used", "[ResourceRegistry]")
+{
+  TestRegistry registry;
+  for (uint32 id = 0; id < 10; ++id) {
+    store(registry, id, 10);
+  }
+  REQUIRE(registry.collect(100, keepNone) == 0);
+
+  //Resource 0 is held, 1 is used on every frame and 2 must stay loaded
+  auto held = registry.find(0);
+  registry.setMemoryBudget(70);
+  for (uint32 frame = 0; frame < 3; ++frame) {
+    registry.find(1);
+    registry.collect(100, [](const SPtr<TestResource>& resource) {
+      return 2 == resource->m_value;
+    });
+  }
+
+  REQUIRE(registry.getMemoryUsage() == 70);
+  REQUIRE(registry.size() == 7);
+  REQUIRE(registry.find(0) == held);
+  REQUIRE(registry.find(1) != nullptr);
+  REQUIRE(registry.find(2) != nullptr);
+
+  //Not over the budget, nothing else goes
+  REQUIRE(registry.collect(100, keepNone) == 0);
+
+  //Resource 1 is now the one used the longest ago
+  for (uint32 id = 2; id < 10; ++id) {
+    registry.find(id);
+  }
+  registry.setMemoryBudget(60);
+  REQUIRE(registry.collect(100, keepNone) == 1);
+  REQUIRE(registry.find(1) == nullptr);
+  REQUIRE(registry.getMemoryUsage() == 60);
+
+  //Everything nobody holds goes, whatever the budget
+  registry.setMemoryBudget(std::numeric_limits<SIZE_T>::max());
+  REQUIRE(registry.evictUnused(keepNone) == 5);
+  REQUIRE(registry.size() == 1);
+  REQUIRE(registry.getMemoryUsage() == 10);
+}
+
+TEST_CASE("ResourceRegistry: the collection is spread across frames", "[ResourceRegistry]")
+{
+  TestRegistry registry;
+  for (uint32 id = 0; id < 320; ++id) {
+    store(registry, id, 1);
+  }
+
+  registry.setMemoryBudget(0);
+  const uint32 evicted = registry.collect(20, keepNone);
+  REQUIRE(evicted > 0);
+  REQUIRE(evicted < 320);
+  REQUIRE(registry.size() == 320 - evicted);
+
+  uint32 numFrames = 1;
+  while (registry.size() > 0) {
+    registry.collect(20, keepNone);
+    ++numFrames;
+  }
+  REQUIRE(numFrames > 2);
+  REQUIRE(registry.getMemoryUsage() == 0);
+}
+
+TEST_CASE("ResourceRegistry: readers while the registry changes", "[ResourceRegistry]")
+{
+  TestRegistry registry;
+  CONSTEXPR uint32 NUM_IDS = 256;
+  CONSTEXPR uint32 NUM_READERS = 4;
+  for (uint32 id = 0; id < NUM_IDS; id += 2) {
+    store(registry, id, 1);
+  }
+
+  std::atomic<bool> bDone{ false };
+  std::atomic<uint32> numMismatches{ 0 };
+  Vector<Thread> readers;
+  for (uint32 t = 0; t < NUM_READERS; ++t) {
+    readers.emplace_back([&]() {
+      while (!bDone.load()) {
+        for (uint32 id = 0; id < NUM_IDS; ++id) {
+          auto resource = registry.find(id);
+          if (resource && cast::st<uint32>(resource->m_value) != id) {
+            ++numMismatches;
+          }
+        }
+      }
+    });
+  }
+
+  for (uint32 round = 0; round < 200; ++round) {
+    const uint32 id = (round * 7) % NUM_IDS;
+    store(registry, id, 1);
+    registry.remove((id + 1) % NUM_IDS);
+    if (0 == round % 50) {
+      registry.setMemoryBudget(NUM_IDS / 4);
+      registry.collect(64, keepNone);
+      registry.setMemoryBudget(std::numeric_limits<SIZE_T>::max());
+    }
+  }
+
+  bDone = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  REQUIRE(numMismatches == 0);
+  REQUIRE(registry.getMemoryUsage() == registry.size());
+}
+
+TEST_CASE("ResourceManagerBase: loads once and reloads in place", "[ResourceRegistry]")
+{
+  TestManager manager;
+
+  auto resource = manager.load(Path("textures/a.dds"));
+  REQUIRE(resource);
+  REQUIRE(manager.isLoaded(Path("textures/a.dds")));
+  REQUIRE(manager.load(Path("textures/a.dds")) == resource);
+  REQUIRE(manager.m_numLoads == 1);
+  REQUIRE(manager.getMemoryUsage() == resource->m_size);
+
+  //A reload moves the new contents into the resource already handed out
+  manager.reload(Path("textures/a.dds"));
+  REQUIRE(manager.m_numLoads == 2);
+  REQUIRE(resource->m_value == 2);
+  REQUIRE(manager.load(Path("textures/a.dds")) == resource);
+
+  manager.load(Path("textures/b.dds"));
+  manager.setMemoryBudget(0);
+  REQUIRE(manager.collectGarbage() == 1);
+  REQUIRE(manager.isLoaded(Path("textures/a.dds")));
+  REQUIRE_FALSE(manager.isLoaded(Path("textures/b.dds")));
+
+  resource.reset();
+  manager.garbageCollector();
+  REQUIRE_FALSE(manager.isLoaded(Path("textures/a.dds")));
+  REQUIRE(manager.getMemoryUsage() == 0);
+}
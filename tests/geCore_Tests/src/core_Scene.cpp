@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geScene.h"
+#include "geModelComponent.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  SPtr<Model>
+  makeUnitModel() {
+    auto model = ge_shared_ptr_new<Model>();
+    model->m_bounds = AABox(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
+    return model;
+  }
+
+  SPtr<Actor>
+  addModelActor(Scene& scene, const SPtr<Model>& model, const Vector3& position) {
+    auto actor = scene.createActor();
+    actor->addComponent<ModelComponent>()->setModel(model);
+    actor->getSceneNode().setLocalTransform(Transform(position));
+    return actor;
+  }
+
+  Vector<Actor*>
+  queryBox(const Scene& scene, const AABox& box) {
+    Vector<Actor*> found;
+    scene.queryActors(box, [&found](Actor& actor) { found.push_back(&actor); });
+    return found;
+  }
+}
+
+TEST_CASE("Scene: spatial index follows the actors", "[Scene]")
+{
+  Scene scene;
+  const auto model = makeUnitModel();
+
+  Vector<SPtr<Actor>> actors;
+  for (uint32 i = 0; i < 100; ++i) {
+    actors.push_back(addModelActor(scene, model, Vector3(i * 10.0f, 0.0f, 0.0f)));
+  }
+
+  //Actors without a model are not in the index
+  scene.createActor("empty");
+
+  scene.update(0.0f);
+  REQUIRE(scene.getSpatialIndex().getProxyCount() == 100);
+
+  const AABox aroundFifth(Vector3(48.0f, -1.0f, -1.0f), Vector3(52.0f, 1.0f, 1.0f));
+  auto found = queryBox(scene, aroundFifth);
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0] == actors[5].get());
+
+  //Moving the actor moves its proxy on the next update
+  actors[5]->getSceneNode().setLocalTransform(Transform(Vector3(0.0f, 100.0f, 0.0f)));
+  scene.update(0.0f);
+  REQUIRE(queryBox(scene, aroundFifth).empty());
+
+  const Sphere aroundMoved(Vector3(0.0f, 100.0f, 0.0f), 2.0f);
+  found.clear();
+  scene.queryActors(aroundMoved, [&found](Actor& actor) { found.push_back(&actor); });
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0] == actors[5].get());
+
+  //Closest actor along the row
+  Actor* closest = nullptr;
+  scene.raycastActors(Vector3(-20.0f, 0.0f, 0.0f),
+                      Vector3(1.0f, 0.0f, 0.0f),
+                      1000.0f,
+                      [&closest](Actor& actor, float maxDistance) {
+                        const auto& world = actor.getSceneNode().getWorldMatrix();
+                        const float distance = world.m[3][0] + 20.0f;
+                        if (distance >= maxDistance) {
+                          return maxDistance;
+                        }
+                        closest = &actor;
+                        return distance;
+                      });
+  REQUIRE(closest == actors[0].get());
+
+  //Destroyed actors and removed models leave the index
+  scene.destroyActor(actors[0].get());
+  actors[1]->getComponent<ModelComponent>()->setModel(nullptr);
+  scene.update(0.0f);
+  REQUIRE(scene.getSpatialIndex().getProxyCount() == 98);
+  REQUIRE(scene.getSpatialIndex().validate());
+}
+
+TEST_CASE("Scene: spatial index follows the models of an actor", "[Scene]")
+{
+  Scene scene;
+  const auto model = makeUnitModel();
+
+  auto farModel = ge_shared_ptr_new<Model>();
+  farModel->m_bounds = AABox(Vector3(4.5f, -0.5f, -0.5f), Vector3(5.5f, 0.5f, 0.5f));
+
+  auto actor = addModelActor(scene, model, Vector3(0.0f, 0.0f, 0.0f));
+  scene.update(0.0f);
+
+  const AABox aroundOrigin(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+  const AABox aroundFar(Vector3(4.0f, -1.0f, -1.0f), Vector3(6.0f, 1.0f, 1.0f));
+  REQUIRE(queryBox(scene, aroundOrigin).size() == 1);
+  REQUIRE(queryBox(scene, aroundFar).empty());
+
+  //Every model of the actor counts for its bounds
+  actor->addComponent<ModelComponent>()->setModel(farModel);
+  scene.update(0.0f);
+  REQUIRE(scene.getSpatialIndex().getProxyCount() == 1);
+  REQUIRE(queryBox(scene, aroundOrigin).size() == 1);
+  REQUIRE(queryBox(scene, aroundFar).size() == 1);
+
+  //Removing or replacing a model refreshes the proxy without moving the actor
+  REQUIRE(actor->removeComponent<ModelComponent>(0));
+  scene.update(0.0f);
+  REQUIRE(queryBox(scene, aroundOrigin).empty());
+  REQUIRE(queryBox(scene, aroundFar).size() == 1);
+
+  actor->getComponent<ModelComponent>()->setModel(model);
+  scene.update(0.0f);
+  REQUIRE(queryBox(scene, aroundOrigin).size() == 1);
+  REQUIRE(queryBox(scene, aroundFar).empty());
+
+  //An actor destroyed while its changes are pending leaves nothing behind
+  actor->getSceneNode().setLocalTransform(Transform(Vector3(5.0f, 0.0f, 0.0f)));
+  actor->getComponent<ModelComponent>()->setModel(farModel);
+  scene.destroyActor(actor.get());
+  actor->getComponent<ModelComponent>()->setModel(model);
+  scene.update(0.0f);
+  REQUIRE(scene.getSpatialIndex().getProxyCount() == 0);
+  REQUIRE(scene.getSpatialIndex().validate());
+}
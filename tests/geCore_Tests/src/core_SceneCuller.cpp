@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geSceneCuller.h"
+#include "geModelComponent.h"
+#include "geCamera.h"
+
+#include <geTaskScheduler.h>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+
+  /**
+   * A model with two unit cube submeshes, the second one 2 units up.
+   */
+  SPtr<Model>
+  makeModel() {
+    auto model = ge_shared_ptr_new<Model>();
+
+    MeshData mesh;
+    for (uint32 i = 0; i < 2; ++i) {
+      SubMesh subMesh;
+      subMesh.m_indexCount = 36;
+      subMesh.m_vertexCount = 24;
+      subMesh.m_bounds = AABox(Vector3(-0.5f, i * 2.0f - 0.5f, -0.5f),
+                               Vector3(0.5f, i * 2.0f + 0.5f, 0.5f));
+      mesh.m_subMeshes.push_back(subMesh);
+    }
+    model->m_meshes.push_back(mesh);
+    model->updateBounds();
+    return model;
+  }
+
+  Camera
+  makeCamera() {
+    Camera camera;
+    camera.setPerspective(Degree(45.0f), 1280.0f, 720.0f, 0.1f, 100.0f);
+    camera.setPosition(Vector3(0.0f, 0.0f, 0.0f));
+    camera.setLookAt(Vector3(0.0f, 0.0f, 1.0f));
+    return camera;
+  }
+
+  bool
+  isInside(const Array<Plane, 6>& planes, const Vector3& point) {
+    for (const auto& plane : planes) {
+      if (plane.planeDot(point) > 0.0f) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+TEST_CASE("SceneCuller: camera frustum planes", "[SceneCuller]")
+{
+  Camera camera = makeCamera();
+  const auto frustum = camera.getFrustum();
+
+  REQUIRE(isInside(frustum, Vector3(0.0f, 0.0f, 10.0f)));
+  REQUIRE(isInside(frustum, Vector3(5.0f, -3.0f, 50.0f)));
+  REQUIRE_FALSE(isInside(frustum, Vector3(0.0f, 0.0f, -10.0f)));
+  REQUIRE_FALSE(isInside(frustum, Vector3(0.0f, 0.0f, 150.0f)));
+  REQUIRE_FALSE(isInside(frustum, Vector3(0.0f, 0.0f, 0.05f)));
+  REQUIRE_FALSE(isInside(frustum, Vector3(200.0f, 0.0f, 10.0f)));
+
+  for (const auto& plane : frustum) {
+    REQUIRE(Math::abs(Vector3(plane.x, plane.y, plane.z).size() - 1.0f) < 0.0001f);
+  }
+}
+
+TEST_CASE("SceneCuller: culls several views in one pass", "[SceneCuller]")
+{
+  Scene scene;
+  const auto model = makeModel();
+
+  auto addActor = [&](const Vector3& position) {
+    auto actor = scene.createActor();
+    actor->addComponent<ModelComponent>()->setModel(model);
+    actor->getSceneNode().setLocalTransform(Transform(position));
+    return actor;
+  };
+
+  auto ahead = addActor(Vector3(0.0f, 0.0f, 10.0f));
+  auto behind = addActor(Vector3(0.0f, 0.0f, -10.0f));
+  auto farAway = addActor(Vector3(0.0f, 0.0f, 500.0f));
+
+  //Only the top submesh pokes into the view
+  auto below = addActor(Vector3(0.0f, -6.5f, 10.0f));
+
+  auto hidden = addActor(Vector3(0.0f, 0.0f, 20.0f));
+  hidden->getSceneNode().setVisible(false);
+
+  scene.update(0.0f);
+
+  //A second camera looking back, like a shadow or reflection view
+  Camera camera = makeCamera();
+  Camera backCamera = makeCamera();
+  backCamera.setLookAt(Vector3(0.0f, 0.0f, -1.0f));
+
+  const Vector<CullView> views = { CullView(camera.getFrustum()),
+                                   CullView(backCamera.getFrustum()) };
+
+  SceneCuller culler;
+  Vector<Vector<VisibleSubMesh>> visible;
+  culler.cull(scene, views, visible);
+
+  //The spatial index skips the actor out of range, the hidden one is found
+  //but none of its submeshes are tested
+  REQUIRE(culler.getNumInstances() == 6);
+  REQUIRE(visible.size() == 2);
+
+  auto findActor = [](const Vector<VisibleSubMesh>& list, const SPtr<Actor>& actor) {
+    Vector<const VisibleSubMesh*> found;
+    for (const auto& entry : list) {
+      if (entry.actor == actor.get()) {
+        found.push_back(&entry);
+      }
+    }
+    return found;
+  };
+
+  REQUIRE(visible[0].size() == 3);
+  const auto aheadSubMeshes = findActor(visible[0], ahead);
+  REQUIRE(aheadSubMeshes.size() == 2);
+  REQUIRE(aheadSubMeshes[0]->world.m[3][2] == 10.0f);
+  const auto belowSubMeshes = findActor(visible[0], below);
+  REQUIRE(belowSubMeshes.size() == 1);
+  REQUIRE(belowSubMeshes[0]->subMeshIndex == 1);
+
+  REQUIRE(visible[1].size() == 2);
+  REQUIRE(findActor(visible[1], behind).size() == 2);
+  REQUIRE(findActor(visible[0], farAway).empty());
+  REQUIRE(findActor(visible[0], hidden).empty());
+}
+
+TEST_CASE("SceneCuller: parallel culling matches the serial one", "[SceneCuller]")
+{
+  Scene scene;
+  const auto model = makeModel();
+  for (uint32 i = 0; i < 5000; ++i) {
+    auto actor = scene.createActor();
+    actor->addComponent<ModelComponent>()->setModel(model);
+    const float x = float(i % 100) - 50.0f;
+    const float z = float(i / 100) * 2.0f - 20.0f;
+    actor->getSceneNode().setLocalTransform(Transform(Vector3(x, 0.0f, z)));
+  }
+  scene.update(0.0f);
+
+  Camera camera = makeCamera();
+  const Vector<CullView> views = { CullView(camera.getFrustum()) };
+
+  SceneCuller serialCuller;
+  Vector<Vector<VisibleSubMesh>> serial;
+  serialCuller.cull(scene, views, serial);
+  REQUIRE(!serial[0].empty());
+  REQUIRE(serial[0].size() < 10000);
+
+  ensureTaskSchedulerStartedForTests();
+
+  SceneCuller parallelCuller;
+  Vector<Vector<VisibleSubMesh>> parallel;
+  parallelCuller.cull(scene, views, parallel);
+
+  REQUIRE(parallel[0].size() == serial[0].size());
+  for (SIZE_T i = 0; i < serial[0].size(); ++i) {
+    REQUIRE(parallel[0][i].actor == serial[0][i].actor);
+    REQUIRE(parallel[0][i].subMeshIndex == serial[0][i].subMeshIndex);
+  }
+}
@@ -0,0 +1,458 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geTextureStreamer.h"
+#include "geTexture.h"
+#include "geFramePipeline.h"
+
+#include <geMath.h>
+#include <geTaskScheduler.h>
+
+#include <future>
+#include <thread>
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+
+  class FakeTexture : public Texture
+  {
+   public:
+    explicit FakeTexture(uint32 firstMip = 0)
+      : m_firstMip(firstMip) {}
+
+    void
+    moveFrom(Resource& other) override {
+      m_firstMip = static_cast<FakeTexture&>(other).m_firstMip;
+    }
+
+    bool
+    load(const Path&) override {
+      return true;
+    }
+
+    void
+    unload() override {}
+
+    bool
+    isLoaded() const override {
+      return true;
+    }
+
+    SIZE_T
+    getMemoryUsage() const override {
+      return 0;
+    }
+
+    void
+    release() override {}
+
+    void*
+    _getGraphicsResource() const override {
+      return nullptr;
+    }
+
+    void
+    setDebugName(const String&) override {}
+
+    const void*
+    getDrawingReference(const uint32) const override {
+      return nullptr;
+    }
+
+    uint32 m_firstMip;
+  };
+
+  /**
+   * A square RGBA8 texture, with the size of each level.
+   */
+  TextureMipChain
+  makeChain(uint32 size) {
+    TextureMipChain chain;
+    chain.desc.dimensions = 2;
+    chain.desc.width = size;
+    chain.desc.height = size;
+    chain.desc.arraySize = 1;
+    chain.desc.format = GRAPHICS_FORMAT::kR8G8B8A8_UNORM;
+    for (uint32 mipSize = size; mipSize > 0; mipSize >>= 1) {
+      chain.mipSizes.push_back(uint64(mipSize) * mipSize * 4);
+    }
+    chain.desc.mipLevels = cast::st<uint32>(chain.mipSizes.size());
+    return chain;
+  }
+
+  uint64
+  getChainSize(const TextureMipChain& chain, uint32 firstMip) {
+    uint64 size = 0;
+    for (SIZE_T i = firstMip; i < chain.mipSizes.size(); ++i) {
+      size += chain.mipSizes[i];
+    }
+    return size;
+  }
+
+  /**
+   * Streamer that loads fake textures on the calling thread.
+   */
+  struct TestStreamer
+  {
+    TestStreamer() {
+      streamer.setFileReader([this](const Path& filePath,
+                                    uint64 headerSize,
+                                    const Vector<TextureMipChain::DataRange>& ranges,
+                                    Vector<uint8>& outData) {
+        ++numReads;
+        readHeaderSize = headerSize;
+        readRanges = ranges;
+        outData.assign(4, 0);
+        return !filePath.toString().ends_with("missing.dds");
+      });
+      streamer.setMipUploader([this](const Path&,
+                                     const Vector<uint8>&,
+                                     uint64 skippedSize,
+                                     uint32 firstMip) {
+        uploadSkippedSize = skippedSize;
+        return ge_shared_ptr_new<FakeTexture>(firstMip);
+      });
+    }
+
+    uint32
+    getFirstMip(uint32 id) const {
+      return std::static_pointer_cast<FakeTexture>(streamer.getTexture(id))->m_firstMip;
+    }
+
+    TextureStreamer streamer;
+    uint32 numReads = 0;
+
+    //Headers and ranges of the last read
+    uint64 readHeaderSize = 0;
+    Vector<TextureMipChain::DataRange> readRanges;
+    uint64 uploadSkippedSize = 0;
+  };
+}
+
+TEST_CASE("TextureStreamer: textures load the mips they're used with", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  auto placeholder = ge_shared_ptr_new<FakeTexture>(100);
+
+  const TextureMipChain chain = makeChain(1024);
+  const uint32 id = streamer.registerTexture(Path("textures/rock.dds"), chain, placeholder);
+  REQUIRE(id != TextureStreamer::INVALID_ID);
+  REQUIRE(streamer.registerTexture(Path("textures/rock.dds"), chain) == id);
+
+  //Nothing is loaded until it's used
+  streamer.update();
+  REQUIRE(test.numReads == 0);
+  REQUIRE(streamer.getTexture(id) == placeholder);
+  REQUIRE(streamer.getResidentMip(id) == 11);
+  REQUIRE(streamer.getMemoryUsage() == 0);
+
+  streamer.reportMip(id, 3);
+  streamer.reportMip(id, 5);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(test.numReads == 1);
+  REQUIRE(streamer.getResidentMip(id) == 3);
+  REQUIRE(streamer.getMemoryUsage() == getChainSize(chain, 3));
+
+  //The same handle takes the finer levels
+  auto texture = streamer.getTexture(id);
+  REQUIRE(texture != placeholder);
+  streamer.reportMip(id, 0);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getTexture(id) == texture);
+  REQUIRE(test.getFirstMip(id) == 0);
+  REQUIRE(streamer.getMemoryUsage() == getChainSize(chain, 0));
+
+  streamer.unregisterTexture(id);
+  REQUIRE(streamer.getTexture(id) == nullptr);
+  REQUIRE(streamer.getMemoryUsage() == 0);
+}
+
+TEST_CASE("TextureStreamer: the level follows the size on the screen", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  const uint32 id = streamer.registerTexture(Path("textures/grass.dds"), makeChain(1024));
+
+  //A thousand pixels per world unit at a distance of one
+  streamer.setViewport(1000.0f, Radian(2.0f * Math::atan(0.5f)));
+
+  REQUIRE(streamer.computeMip(id, 1.0f, 0.5f) == 0);
+  REQUIRE(streamer.computeMip(id, 1.0f, 1.0f) == 0);
+  REQUIRE(streamer.computeMip(id, 1.0f, 4.0f) == 2);
+  REQUIRE(streamer.computeMip(id, 4.0f, 4.0f) == 4);
+  REQUIRE(streamer.computeMip(id, 1.0f, 100000.0f) == 10);
+
+  //The closest use of the frame wins
+  streamer.reportUsage(id, 1.0f, 16.0f);
+  streamer.reportUsage(id, 1.0f, 4.0f);
+  streamer.update();
+  REQUIRE(streamer.getWantedMip(id) == 2);
+}
+
+TEST_CASE("TextureStreamer: the budget drops the least recently used levels", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  const TextureMipChain chain = makeChain(1024);
+
+  const uint32 old = streamer.registerTexture(Path("textures/old.dds"), chain);
+  const uint32 recent = streamer.registerTexture(Path("textures/recent.dds"), chain);
+
+  streamer.reportMip(old, 0);
+  streamer.update();
+  streamer.flush();
+  streamer.reportMip(recent, 0);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getMemoryUsage() == getChainSize(chain, 0) * 2);
+
+  //Over the budget, the texture used the longest ago loses detail first
+  streamer.setMemoryBudget(cast::st<SIZE_T>(getChainSize(chain, 0) + getChainSize(chain, 1)));
+  streamer.reportMip(recent, 0);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getWantedMip(old) == 1);
+  REQUIRE(streamer.getWantedMip(recent) == 0);
+  REQUIRE(streamer.getResidentMip(old) == 1);
+  REQUIRE(test.getFirstMip(old) == 1);
+  REQUIRE(streamer.getMemoryUsage() <= streamer.getMemoryBudget());
+
+  //A tighter budget takes a level at a time from each
+  streamer.setMemoryBudget(cast::st<SIZE_T>(getChainSize(chain, 1) + getChainSize(chain, 2)));
+  streamer.reportMip(recent, 0);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getWantedMip(old) == 2);
+  REQUIRE(streamer.getWantedMip(recent) == 1);
+  REQUIRE(streamer.getMemoryUsage() <= streamer.getMemoryBudget());
+}
+
+TEST_CASE("TextureStreamer: unused textures drop to their coarsest level", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  const TextureMipChain chain = makeChain(256);
+  streamer.setIdleFrames(3);
+
+  const uint32 id = streamer.registerTexture(Path("textures/wall.dds"), chain);
+  streamer.reportMip(id, 0);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getResidentMip(id) == 0);
+
+  //Still loaded for a few frames after the last use
+  for (uint32 frame = 0; frame < 3; ++frame) {
+    streamer.update();
+    REQUIRE(streamer.getWantedMip(id) == 0);
+  }
+
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getWantedMip(id) == 8);
+  REQUIRE(streamer.getResidentMip(id) == 8);
+  REQUIRE(streamer.getMemoryUsage() == getChainSize(chain, 8));
+}
+
+TEST_CASE("TextureStreamer: reads only the levels it loads", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+
+  //Without a layout the whole file is read
+  const uint32 whole = streamer.registerTexture(Path("textures/whole.dds"), makeChain(256));
+  streamer.reportMip(whole, 2);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(test.readHeaderSize == 0);
+  REQUIRE(test.readRanges.empty());
+  REQUIRE(test.uploadSkippedSize == 0);
+
+  //Two array slices after the headers, each with its own chain from the
+  //finest level, like a DDS
+  TextureMipChain chain = makeChain(256);
+  chain.desc.arraySize = 2;
+  const Vector<uint64> sliceMipSizes = chain.mipSizes;
+  Vector<TextureMipChain::SubresourceData> subresources;
+  uint64 srcOffset = 0;
+  for (uint32 slice = 0; slice < 2; ++slice) {
+    for (uint32 mip = 0; mip < sliceMipSizes.size(); ++mip) {
+      subresources.push_back({ mip, srcOffset, sliceMipSizes[mip] });
+      srcOffset += sliceMipSizes[mip];
+    }
+  }
+  chain.setLayout(148, subresources);
+  REQUIRE(chain.headerSize == 148);
+  REQUIRE(chain.mipSizes[0] == sliceMipSizes[0] * 2);
+
+  //Every level is read in one go, but the finer levels of the second slice
+  //are left out of the others
+  const uint64 sliceSize = srcOffset / 2;
+  const uint64 skippedSize = sliceMipSizes[0] + sliceMipSizes[1];
+  REQUIRE(chain.mipDataRanges[0].size() == 1);
+  REQUIRE(chain.mipDataRanges[0][0].begin == 148);
+  REQUIRE(chain.mipDataRanges[0][0].end == 148 + srcOffset);
+  REQUIRE(chain.mipDataRanges[2].size() == 2);
+  REQUIRE(chain.mipDataRanges[2][0].begin == 148 + skippedSize);
+  REQUIRE(chain.mipDataRanges[2][0].end == 148 + sliceSize);
+  REQUIRE(chain.mipDataRanges[2][1].begin == 148 + sliceSize + skippedSize);
+  REQUIRE(chain.mipDataRanges[2][1].end == 148 + srcOffset);
+
+  const uint32 id = streamer.registerTexture(Path("textures/range.dds"), chain);
+  streamer.reportMip(id, 2);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getResidentMip(id) == 2);
+  REQUIRE(test.readHeaderSize == 148);
+  REQUIRE(test.readRanges.size() == 2);
+  REQUIRE(test.readRanges[1].begin == chain.mipDataRanges[2][1].begin);
+  REQUIRE(test.uploadSkippedSize == skippedSize);
+}
+
+TEST_CASE("TextureStreamer: failed and throttled loads", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  auto placeholder = ge_shared_ptr_new<FakeTexture>();
+
+  //A texture that can't be read keeps its placeholder and isn't retried
+  const uint32 missing = streamer.registerTexture(Path("textures/missing.dds"),
+                                                  makeChain(64),
+                                                  placeholder);
+  for (uint32 frame = 0; frame < 3; ++frame) {
+    streamer.reportMip(missing, 0);
+    streamer.update();
+    streamer.flush();
+  }
+  REQUIRE(test.numReads == 1);
+  REQUIRE(streamer.getTexture(missing) == placeholder);
+  REQUIRE(streamer.getMemoryUsage() == 0);
+
+  //Only a few loads start on each update
+  streamer.setMaxPendingLoads(2);
+  Vector<uint32> ids;
+  for (uint32 i = 0; i < 5; ++i) {
+    ids.push_back(streamer.registerTexture(Path("textures/" + toString(i) + ".dds"),
+                                           makeChain(64)));
+  }
+  for (uint32 id : ids) {
+    streamer.reportMip(id, 0);
+  }
+  streamer.update();
+  REQUIRE(test.numReads == 3);
+
+  for (uint32 frame = 0; frame < 3; ++frame) {
+    for (uint32 id : ids) {
+      streamer.reportMip(id, 0);
+    }
+    streamer.update();
+  }
+  streamer.flush();
+  for (uint32 id : ids) {
+    REQUIRE(streamer.getResidentMip(id) == 0);
+  }
+}
+
+TEST_CASE("TextureStreamer: loads from before a texture is registered again are dropped",
+          "[TextureStreamer]")
+{
+  ensureTaskSchedulerStartedForTests();
+
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+
+  //The first read waits until the texture is registered again
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<uint32> numReads{ 0 };
+  streamer.setFileReader([&](const Path&,
+                             uint64,
+                             const Vector<TextureMipChain::DataRange>&,
+                             Vector<uint8>& outData) {
+    if (0 == numReads++) {
+      released.wait();
+    }
+    outData.assign(4, 0);
+    return true;
+  });
+
+  const TextureMipChain chain = makeChain(256);
+  const Path path("textures/reloaded.dds");
+  const uint32 id = streamer.registerTexture(path, chain);
+  streamer.reportMip(id, 0);
+  streamer.update();
+
+  //Same path, same id
+  streamer.unregisterTexture(id);
+  REQUIRE(streamer.registerTexture(path, chain) == id);
+  streamer.reportMip(id, 4);
+  streamer.update();
+
+  release.set_value();
+  streamer.flush();
+  REQUIRE(numReads == 2);
+  REQUIRE(streamer.getResidentMip(id) == 4);
+  REQUIRE(test.getFirstMip(id) == 4);
+  REQUIRE(streamer.getMemoryUsage() == getChainSize(chain, 4));
+
+  //No load is left counted as pending
+  streamer.setMaxPendingLoads(1);
+  streamer.reportMip(id, 2);
+  streamer.update();
+  streamer.flush();
+  REQUIRE(streamer.getResidentMip(id) == 2);
+}
+
+TEST_CASE("TextureStreamer: a pipeline uploads on the render thread", "[TextureStreamer]")
+{
+  TestStreamer test;
+  TextureStreamer& streamer = test.streamer;
+  FramePipeline pipeline(1);
+
+  const std::thread::id simThread = std::this_thread::get_id();
+  std::atomic<uint32> numUploads{ 0 };
+  std::atomic<bool> bUploadedOnSimThread{ false };
+  streamer.setMipUploader([&](const Path&, const Vector<uint8>&, uint64, uint32 firstMip) {
+    bUploadedOnSimThread = std::this_thread::get_id() == simThread;
+    ++numUploads;
+    return ge_shared_ptr_new<FakeTexture>(firstMip);
+  });
+
+  auto placeholder = ge_shared_ptr_new<FakeTexture>();
+  const uint32 id = streamer.registerTexture(Path("textures/pipelined.dds"),
+                                             makeChain(64),
+                                             placeholder);
+
+  //The read may finish on a worker a few frames later
+  for (uint32 frame = 0; frame < 1000 && streamer.getResidentMip(id) != 0; ++frame) {
+    streamer.reportMip(id, 0);
+    const uint32 numUploadsBefore = numUploads;
+    streamer.update(&pipeline);
+
+    //Nothing is uploaded until the render thread runs the commands of the
+    //frame, and the placeholder stays until an update after that
+    REQUIRE(numUploads == numUploadsBefore);
+    REQUIRE((streamer.getTexture(id) == placeholder) == (0 == numUploadsBefore));
+
+    pipeline.submitFrame();
+    pipeline.flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  REQUIRE(1 == numUploads);
+  REQUIRE_FALSE(bUploadedOnSimThread);
+  REQUIRE(streamer.getResidentMip(id) == 0);
+  REQUIRE(test.getFirstMip(id) == 0);
+}
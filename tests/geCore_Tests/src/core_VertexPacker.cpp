@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstring>
+#include <random>
+
+#include "geVertexPacker.h"
+#include "geFloat16.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  using VET = VERTEX_ELEMENT_TYPE::E;
+  using VES = VERTEX_ELEMENT_SEMANTIC::E;
+
+  struct SkinnedVertex
+  {
+    float position[3];
+    float normal[3];
+    float tangent[4];
+    float uv[2];
+    uint16 boneIndices[4];
+    float boneWeights[4];
+  };
+
+  Vector<VertexElement>
+  skinnedElements() {
+    return {
+      VertexElement(0, 0, VET::FLOAT3, VES::POSITION),
+      VertexElement(0, 12, VET::FLOAT3, VES::NORMAL),
+      VertexElement(0, 24, VET::FLOAT4, VES::TANGENT),
+      VertexElement(0, 40, VET::FLOAT2, VES::TEXCOORD),
+      VertexElement(0, 48, VET::USHORT4, VES::BLENDINDICES),
+      VertexElement(0, 56, VET::FLOAT4, VES::BLENDWEIGHT)
+    };
+  }
+
+  Vector3
+  randomDirection(std::mt19937& rng) {
+    std::normal_distribution<float> dist;
+    Vector3 direction(dist(rng), dist(rng), dist(rng));
+    return direction / direction.size();
+  }
+
+  Vector<SkinnedVertex>
+  makeVertices(uint32 count, uint32 seed = 11) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    Vector<SkinnedVertex> vertices(count);
+    for (auto& vertex : vertices) {
+      const Vector3 normal = randomDirection(rng);
+      const Vector3 tangent = randomDirection(rng);
+      const float weights[4] = { unit(rng), unit(rng), unit(rng), unit(rng) };
+      const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+
+      vertex = SkinnedVertex{
+        { unit(rng) * 40.0f - 20.0f, unit(rng) * 2.0f, unit(rng) * 0.5f },
+        { normal.x, normal.y, normal.z },
+        { tangent.x, tangent.y, tangent.z, 1.0f },
+        { unit(rng), unit(rng) },
+        { 0, 1, 2, 3 },
+        { weights[0] / sum, weights[1] / sum, weights[2] / sum, weights[3] / sum }
+      };
+    }
+    return vertices;
+  }
+}
+
+TEST_CASE("VertexPacker: octahedral normals round trip", "[VertexPacker]")
+{
+  std::mt19937 rng(3);
+  for (uint32 i = 0; i < 10000; ++i) {
+    const Vector3 direction = randomDirection(rng);
+    int16 encoded[2];
+    VertexPacker::encodeOctahedral(direction, encoded);
+    const Vector3 decoded = VertexPacker::decodeOctahedral(encoded);
+
+    //Within 0.01 degrees
+    REQUIRE((decoded - direction).size() < 0.000175f);
+    REQUIRE(decoded.size() == Catch::Approx(1.0f));
+  }
+
+  //The poles and the folded edge
+  const Vector3 axes[] = { Vector3(0, 0, 1), Vector3(0, 0, -1), Vector3(1, 0, 0),
+                           Vector3(0, -1, 0), Vector3(0.7071f, 0, -0.7071f) };
+  for (const auto& axis : axes) {
+    int16 encoded[2];
+    VertexPacker::encodeOctahedral(axis, encoded);
+    REQUIRE((VertexPacker::decodeOctahedral(encoded) | axis) > 0.9999f);
+  }
+}
+
+TEST_CASE("VertexPacker: blend weights still add up to one", "[VertexPacker]")
+{
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  for (uint32 i = 0; i < 1000; ++i) {
+    Vector4 weights(unit(rng), unit(rng), unit(rng), unit(rng));
+    const float sum = weights.x + weights.y + weights.z + weights.w;
+
+    uint8 encoded[4];
+    VertexPacker::encodeBlendWeights(weights, encoded);
+    REQUIRE(encoded[0] + encoded[1] + encoded[2] + encoded[3] == 255);
+    for (uint32 j = 0; j < 4; ++j) {
+      REQUIRE(Math::abs(encoded[j] / 255.0f - weights[j] / sum) <= 1.0f / 255.0f);
+    }
+  }
+
+  uint8 encoded[4];
+  VertexPacker::encodeBlendWeights(Vector4(1.0f / 3, 1.0f / 3, 1.0f / 3, 0.0f), encoded);
+  REQUIRE(encoded[0] + encoded[1] + encoded[2] == 255);
+  REQUIRE(encoded[3] == 0);
+
+  VertexPacker::encodeBlendWeights(Vector4(0.0f, 0.0f, 0.0f, 0.0f), encoded);
+  REQUIRE(encoded[0] + encoded[1] + encoded[2] + encoded[3] == 0);
+}
+
+TEST_CASE("VertexPacker: packs a skinned layout", "[VertexPacker]")
+{
+  const auto elements = skinnedElements();
+  const auto vertices = makeVertices(256);
+  const auto* data = reinterpret_cast<const uint8*>(vertices.data());
+  const uint32 count = static_cast<uint32>(vertices.size());
+
+  VertexPackingOptions options;
+  options.packNormals = true;
+  options.packTexCoords = true;
+  options.packBlendWeights = true;
+  options.packPositions = true;
+  const auto packed = VertexPacker::getPackedElements(elements, data, count, options);
+
+  REQUIRE(packed.size() == elements.size());
+  REQUIRE(packed[0].getType() == VET::USHORT4_NORM);
+  REQUIRE(packed[1].getType() == VET::SHORT2_NORM);
+  REQUIRE(packed[2].getType() == VET::SHORT2_NORM);
+  REQUIRE(packed[3].getType() == VET::HALF2);
+  REQUIRE(packed[4].getType() == VET::USHORT4);
+  REQUIRE(packed[5].getType() == VET::UBYTE4_NORM);
+
+  const uint32 packedSize = VertexDeclarationProperties(packed).getVertexSize(0);
+  REQUIRE(sizeof(SkinnedVertex) == 72);
+  REQUIRE(packedSize == 32);
+
+  const AABox range = VertexPacker::getPositionRange(elements, data, count);
+  REQUIRE(range.m_isValid);
+
+  Vector<uint8> out(SIZE_T(count) * packedSize);
+  VertexPacker::packVertices(elements, data, packed, out.data(), count, range);
+
+  const Vector3 scale = range.m_max - range.m_min;
+  for (uint32 i = 0; i < count; ++i) {
+    const uint8* vertex = &out[SIZE_T(i) * packedSize];
+    const auto& source = vertices[i];
+
+    uint16 position[4];
+    std::memcpy(position, vertex + packed[0].getOffset(), sizeof(position));
+    for (uint32 axis = 0; axis < 3; ++axis) {
+      const float decoded = range.m_min[axis] + scale[axis] * (position[axis] / 65535.0f);
+      REQUIRE(Math::abs(decoded - source.position[axis]) <= scale[axis] / 65535.0f);
+    }
+
+    int16 normal[2];
+    std::memcpy(normal, vertex + packed[1].getOffset(), sizeof(normal));
+    const Vector3 sourceNormal(source.normal[0], source.normal[1], source.normal[2]);
+    REQUIRE((VertexPacker::decodeOctahedral(normal) | sourceNormal) > 0.9999f);
+
+    uint16 uv[2];
+    std::memcpy(uv, vertex + packed[3].getOffset(), sizeof(uv));
+    for (uint32 j = 0; j < 2; ++j) {
+      REQUIRE(Math::abs(float(Float16(uint32(uv[j]))) - source.uv[j]) <= 1.0f / 4096.0f);
+    }
+
+    uint16 indices[4];
+    std::memcpy(indices, vertex + packed[4].getOffset(), sizeof(indices));
+    REQUIRE(std::memcmp(indices, source.boneIndices, sizeof(indices)) == 0);
+  }
+}
+
+TEST_CASE("VertexPacker: keeps what doesn't fit", "[VertexPacker]")
+{
+  const auto elements = skinnedElements();
+  auto vertices = makeVertices(16);
+
+  //Tiled texture coordinates and a mirrored tangent
+  vertices[3].uv[0] = 12.0f;
+  vertices[7].tangent[3] = -1.0f;
+
+  VertexPackingOptions options;
+  options.packNormals = true;
+  options.packTexCoords = true;
+  options.packBlendWeights = true;
+
+  const auto* data = reinterpret_cast<const uint8*>(vertices.data());
+  const auto packed = VertexPacker::getPackedElements(elements,
+                                                      data,
+                                                      static_cast<uint32>(vertices.size()),
+                                                      options);
+  REQUIRE(packed[0].getType() == VET::FLOAT3);
+  REQUIRE(packed[1].getType() == VET::SHORT2_NORM);
+  REQUIRE(packed[2].getType() == VET::FLOAT4);
+  REQUIRE(packed[3].getType() == VET::FLOAT2);
+
+  uint32 offset = 0;
+  for (const auto& element : packed) {
+    REQUIRE(element.getOffset() == offset);
+    offset += element.getSize();
+  }
+}
+
+TEST_CASE("VertexPacker: packs nothing unless asked to", "[VertexPacker]")
+{
+  const auto elements = skinnedElements();
+  const auto vertices = makeVertices(16);
+  const auto* data = reinterpret_cast<const uint8*>(vertices.data());
+
+  const auto packed = VertexPacker::getPackedElements(elements,
+                                                      data,
+                                                      static_cast<uint32>(vertices.size()),
+                                                      VertexPackingOptions());
+  REQUIRE(packed.size() == elements.size());
+  for (SIZE_T i = 0; i < packed.size(); ++i) {
+    REQUIRE(packed[i].getType() == elements[i].getType());
+    REQUIRE(packed[i].getOffset() == elements[i].getOffset());
+  }
+}
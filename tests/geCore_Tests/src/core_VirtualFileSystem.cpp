@@ -126,6 +126,65 @@ TEST_CASE("DiskFileSystem: getAllFiles returns relative paths (recursive)", "[Mo
   REQUIRE(names[2] == "sub/deep/c.bin");
 }
 
+TEST_CASE("DiskFileSystem: getAllFiles reads large folders", "[Mount][DiskFS]") {
+  auto root = makeTempDir("diskfs_manyfiles");
+
+  for (int i = 0; i < 40; ++i) {
+    for (int j = 0; j < 25; ++j) {
+      writeFile(root / ("dir" + std::to_string(i)) / ("f" + std::to_string(j) + ".bin"), "x");
+    }
+  }
+  writeFile(root / "top.txt", "T");
+
+  auto disk = ge_shared_ptr_new<DiskFileSystem>(Path(String(root.string())));
+  auto files = disk->getAllFiles();
+  REQUIRE(files.size() == 40 * 25 + 1);
+}
+
+TEST_CASE("DiskFileSystem: index cache only reads changed folders again", "[Mount][DiskFS]") {
+  auto root = makeTempDir("diskfs_index");
+  auto cacheDir = makeTempDir("diskfs_index_cache");
+  const Path indexPath(String((cacheDir / "index.idx").string()));
+
+  writeFile(root / "a.txt", "A");
+  writeFile(root / "sub" / "b.txt", "B");
+
+  //Folders changed on the same second as the scan are never trusted
+  const auto past = fs::file_time_type::clock::now() - std::chrono::hours(1);
+  fs::last_write_time(root, past);
+  fs::last_write_time(root / "sub", past);
+
+  {
+    auto disk = ge_shared_ptr_new<DiskFileSystem>(Path(String(root.string())), indexPath);
+    REQUIRE(disk->getAllFiles().size() == 2);
+  }
+  REQUIRE(fs::exists(cacheDir / "index.idx"));
+
+  //Adding a file and restoring the time of the folder leaves the cached listing
+  writeFile(root / "sub" / "c.txt", "C");
+  const auto subTime = fs::last_write_time(root / "sub");
+  fs::last_write_time(root / "sub", past);
+  {
+    auto disk = ge_shared_ptr_new<DiskFileSystem>(Path(String(root.string())), indexPath);
+    REQUIRE(disk->getAllFiles().size() == 2);
+  }
+
+  //Once the folder time moves the folder is read again
+  fs::last_write_time(root / "sub", subTime);
+  {
+    auto disk = ge_shared_ptr_new<DiskFileSystem>(Path(String(root.string())), indexPath);
+    REQUIRE(disk->getAllFiles().size() == 3);
+  }
+
+  //An index from another root is ignored
+  auto otherRoot = makeTempDir("diskfs_index_other");
+  writeFile(otherRoot / "x.txt", "X");
+  {
+    auto disk = ge_shared_ptr_new<DiskFileSystem>(Path(String(otherRoot.string())), indexPath);
+    REQUIRE(disk->getAllFiles().size() == 1);
+  }
+}
+
 TEST_CASE("DiskFileSystem: open reads contents from root-relative path", "[Mount][DiskFS]") {
   auto root = makeTempDir("diskfs_open");
 
@@ -0,0 +1,242 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <random>
+
+#include "geBlockCompression.h"
+#include "geMipMapGenerator.h"
+#include "geTaskScheduler.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  /**
+   * Smooth gradients on the color channels, a radial ramp on the alpha and
+   * a bit of noise so the blocks are not trivially flat.
+   */
+  Vector<uint8>
+  testImage(uint32 width, uint32 height, uint32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32> noise(-6, 6);
+
+    Vector<uint8> pixels(static_cast<SIZE_T>(width) * height * 4);
+    for (uint32 y = 0; y < height; ++y) {
+      for (uint32 x = 0; x < width; ++x) {
+        const SIZE_T i = (static_cast<SIZE_T>(y) * width + x) * 4;
+        const int32 dx = static_cast<int32>(x) - static_cast<int32>(width / 2);
+        const int32 dy = static_cast<int32>(y) - static_cast<int32>(height / 2);
+        const int32 values[4] = {
+          static_cast<int32>(x * 255 / std::max(width - 1, 1u)),
+          static_cast<int32>(y * 255 / std::max(height - 1, 1u)),
+          static_cast<int32>((x + y) * 127 / std::max(width + height - 2, 1u)) + 64,
+          255 - std::min(static_cast<int32>(std::sqrt(static_cast<float>(dx * dx + dy * dy)) * 4.0f), 255)
+        };
+        for (uint32 c = 0; c < 4; ++c) {
+          pixels[i + c] = static_cast<uint8>(std::min(std::max(values[c] + noise(rng), 0), 255));
+        }
+      }
+    }
+    return pixels;
+  }
+
+  /**
+   * Root mean squared error of the selected channels.
+   */
+  float
+  rmse(const Vector<uint8>& a, const Vector<uint8>& b, uint32 firstChannel, uint32 numChannels) {
+    double sum = 0.0;
+    SIZE_T count = 0;
+    for (SIZE_T i = 0; i < a.size(); i += 4) {
+      for (uint32 c = firstChannel; c < firstChannel + numChannels; ++c) {
+        const double d = static_cast<double>(a[i + c]) - static_cast<double>(b[i + c]);
+        sum += d * d;
+        ++count;
+      }
+    }
+    return static_cast<float>(std::sqrt(sum / static_cast<double>(count)));
+  }
+
+  Vector<uint8>
+  roundTrip(BLOCK_FORMAT::E format, const Vector<uint8>& pixels, uint32 width, uint32 height) {
+    Vector<uint8> blocks(BlockCompression::calcImageSize(format, width, height));
+    BlockCompression::compress(format, pixels.data(), width, height, blocks.data(), false);
+
+    Vector<uint8> decoded(pixels.size());
+    BlockCompression::decompress(format, blocks.data(), width, height, decoded.data());
+    return decoded;
+  }
+
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+}
+
+TEST_CASE("BlockCompression: block sizes", "[BlockCompression]") {
+  REQUIRE(BlockCompression::getBlockSize(BLOCK_FORMAT::kBC1) == 8);
+  REQUIRE(BlockCompression::getBlockSize(BLOCK_FORMAT::kBC3) == 16);
+  REQUIRE(BlockCompression::getBlockSize(BLOCK_FORMAT::kBC5) == 16);
+  REQUIRE(BlockCompression::getBlockSize(BLOCK_FORMAT::kBC7) == 16);
+
+  REQUIRE(BlockCompression::calcRowPitch(BLOCK_FORMAT::kBC1, 5) == 16);
+  REQUIRE(BlockCompression::calcRowPitch(BLOCK_FORMAT::kBC7, 1) == 16);
+  REQUIRE(BlockCompression::calcImageSize(BLOCK_FORMAT::kBC1, 256, 256) == 32768);
+  REQUIRE(BlockCompression::calcImageSize(BLOCK_FORMAT::kBC7, 5, 3) == 32);
+}
+
+TEST_CASE("BlockCompression: solid blocks", "[BlockCompression]") {
+  uint8 pixels[64];
+  for (uint32 i = 0; i < 16; ++i) {
+    pixels[i * 4 + 0] = 200;
+    pixels[i * 4 + 1] = 100;
+    pixels[i * 4 + 2] = 50;
+    pixels[i * 4 + 3] = 128;
+  }
+
+  const BLOCK_FORMAT::E formats[] = {
+    BLOCK_FORMAT::kBC1, BLOCK_FORMAT::kBC3, BLOCK_FORMAT::kBC5, BLOCK_FORMAT::kBC7
+  };
+  for (auto format : formats) {
+    uint8 block[16];
+    uint8 decoded[64];
+    BlockCompression::encodeBlock(format, pixels, block);
+    BlockCompression::decodeBlock(format, block, decoded);
+
+    for (uint32 i = 0; i < 16; ++i) {
+      const uint32 numChannels = BLOCK_FORMAT::kBC5 == format ? 2 : 3;
+      const int32 tolerance = BLOCK_FORMAT::kBC1 == format ||
+                              BLOCK_FORMAT::kBC3 == format ? 4 : 1;
+      for (uint32 c = 0; c < numChannels; ++c) {
+        REQUIRE(std::abs(decoded[i * 4 + c] - pixels[i * 4 + c]) <= tolerance);
+      }
+    }
+
+    if (BLOCK_FORMAT::kBC3 == format) {
+      REQUIRE(decoded[3] == 128);
+    }
+    else if (BLOCK_FORMAT::kBC7 == format) {
+      REQUIRE(std::abs(decoded[3] - 128) <= 1);
+    }
+  }
+}
+
+TEST_CASE("BlockCompression: alpha keeps exact extremes", "[BlockCompression]") {
+  //A cutout: fully transparent and fully opaque pixels plus a soft edge
+  uint8 pixels[64] = {};
+  const uint8 alphas[16] = { 0, 0, 0, 0, 0, 0, 90, 255, 0, 120, 255, 255, 100, 255, 255, 255 };
+  for (uint32 i = 0; i < 16; ++i) {
+    pixels[i * 4 + 3] = alphas[i];
+  }
+
+  uint8 block[16];
+  uint8 decoded[64];
+  BlockCompression::encodeBlock(BLOCK_FORMAT::kBC3, pixels, block);
+  BlockCompression::decodeBlock(BLOCK_FORMAT::kBC3, block, decoded);
+
+  for (uint32 i = 0; i < 16; ++i) {
+    if (0 == alphas[i] || 255 == alphas[i]) {
+      REQUIRE(decoded[i * 4 + 3] == alphas[i]);
+    }
+    else {
+      REQUIRE(std::abs(decoded[i * 4 + 3] - alphas[i]) <= 8);
+    }
+  }
+}
+
+TEST_CASE("BlockCompression: image quality", "[BlockCompression]") {
+  const uint32 width = 61;
+  const uint32 height = 37;
+  const auto pixels = testImage(width, height, 17);
+
+  const auto bc1 = roundTrip(BLOCK_FORMAT::kBC1, pixels, width, height);
+  REQUIRE(rmse(pixels, bc1, 0, 3) < 6.0f);
+
+  const auto bc3 = roundTrip(BLOCK_FORMAT::kBC3, pixels, width, height);
+  REQUIRE(rmse(pixels, bc3, 0, 3) < 6.0f);
+  REQUIRE(rmse(pixels, bc3, 3, 1) < 4.0f);
+
+  const auto bc5 = roundTrip(BLOCK_FORMAT::kBC5, pixels, width, height);
+  REQUIRE(rmse(pixels, bc5, 0, 2) < 4.0f);
+
+  const auto bc7 = roundTrip(BLOCK_FORMAT::kBC7, pixels, width, height);
+  REQUIRE(rmse(pixels, bc7, 0, 4) < 4.0f);
+
+  //Mode 6 spends more bits per block than BC1, it should be better
+  REQUIRE(rmse(pixels, bc7, 0, 3) < rmse(pixels, bc1, 0, 3));
+}
+
+TEST_CASE("BlockCompression: BC7 blocks use mode 6 with an anchor index", "[BlockCompression]") {
+  const auto pixels = testImage(16, 16, 3);
+
+  Vector<uint8> blocks(BlockCompression::calcImageSize(BLOCK_FORMAT::kBC7, 16, 16));
+  BlockCompression::compress(BLOCK_FORMAT::kBC7, pixels.data(), 16, 16, blocks.data(), false);
+
+  for (SIZE_T i = 0; i < blocks.size(); i += 16) {
+    REQUIRE((blocks[i] & 0x7F) == 0x40);
+  }
+}
+
+TEST_CASE("BlockCompression: parallel output matches serial", "[BlockCompression]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const uint32 size = 512;
+  const auto pixels = testImage(size, size, 5);
+
+  const BLOCK_FORMAT::E formats[] = { BLOCK_FORMAT::kBC1, BLOCK_FORMAT::kBC7 };
+  for (auto format : formats) {
+    Vector<uint8> serial(BlockCompression::calcImageSize(format, size, size));
+    Vector<uint8> parallel(serial.size());
+    BlockCompression::compress(format, pixels.data(), size, size, serial.data(), false);
+    BlockCompression::compress(format, pixels.data(), size, size, parallel.data(), true);
+    REQUIRE(serial == parallel);
+  }
+}
+
+TEST_CASE("BlockCompression: mip chain layout", "[BlockCompression]") {
+  const auto pixels = testImage(40, 20, 9);
+  const auto chain = MipMapGenerator::generateRGBA8(pixels.data(), 40, 20);
+  const auto compressed = BlockCompression::compressChain(BLOCK_FORMAT::kBC3, chain, false);
+
+  REQUIRE(compressed.levels.size() == chain.levels.size());
+
+  SIZE_T expectedOffset = 0;
+  for (SIZE_T i = 0; i < compressed.levels.size(); ++i) {
+    const auto& level = compressed.levels[i];
+    REQUIRE(level.width == chain.levels[i].width);
+    REQUIRE(level.height == chain.levels[i].height);
+    REQUIRE(level.rowPitch == BlockCompression::calcRowPitch(BLOCK_FORMAT::kBC3, level.width));
+    REQUIRE(level.offset == expectedOffset);
+    expectedOffset += BlockCompression::calcImageSize(BLOCK_FORMAT::kBC3,
+                                                      level.width,
+                                                      level.height);
+  }
+  REQUIRE(compressed.data.size() == expectedOffset);
+}
+
+TEST_CASE("BlockCompression: throughput", "[.][benchmark][BlockCompression]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const uint32 size = 2048;
+  const auto pixels = testImage(size, size, 1);
+  Vector<uint8> blocks(BlockCompression::calcImageSize(BLOCK_FORMAT::kBC7, size, size));
+
+  BENCHMARK("BC1 2048x2048") {
+    BlockCompression::compress(BLOCK_FORMAT::kBC1, pixels.data(), size, size, blocks.data());
+    return blocks[0];
+  };
+
+  BENCHMARK("BC3 2048x2048") {
+    BlockCompression::compress(BLOCK_FORMAT::kBC3, pixels.data(), size, size, blocks.data());
+    return blocks[0];
+  };
+
+  BENCHMARK("BC7 2048x2048") {
+    BlockCompression::compress(BLOCK_FORMAT::kBC7, pixels.data(), size, size, blocks.data());
+    return blocks[0];
+  };
+}
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <vector>
 
@@ -172,3 +173,225 @@ TEST_CASE("Compression: empty roundtrip", "[Compression]") {
   REQUIRE(decomp->size() == 0);
 }
 
+
+#include <geTaskScheduler.h>
+
+static void ensureTaskSchedulerStartedForTests() {
+  if (!ThreadPool::isStarted()) {
+    ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+  }
+  if (!TaskScheduler::isStarted()) {
+    TaskScheduler::startUp();
+  }
+}
+
+// Text-like data that LZ4 can compress, with some noise
+static std::vector<uint8_t> makeCompressibleBytes(size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  const char* words[] = { "mesh ", "texture ", "shader ", "material ", "scene ", "actor " };
+  std::vector<uint8_t> bytes;
+  bytes.reserve(size);
+  while (bytes.size() < size) {
+    const char* word = words[rng() % 6];
+    bytes.insert(bytes.end(), word, word + std::strlen(word));
+    if (rng() % 16 == 0) {
+      bytes.push_back(static_cast<uint8_t>(rng()));
+    }
+  }
+  bytes.resize(size);
+  return bytes;
+}
+
+static std::vector<uint8_t> compressBytes(const std::vector<uint8_t>& bytes,
+                                          const CompressionOptions& options) {
+  auto src = makeStreamFromBytes(bytes);
+  auto comp = Compression::compress(src, options);
+  REQUIRE(comp != nullptr);
+  return readAllBytes(comp);
+}
+
+TEST_CASE("Compression: blocks roundtrip in parallel and serially", "[Compression]") {
+  ensureTaskSchedulerStartedForTests();
+
+  // Not a multiple of the block size, with a last block of one byte
+  const auto srcBytes = makeCompressibleBytes(5 * 64 * 1024 + 1, 7);
+
+  CompressionOptions options;
+  options.blockSize = 64 * 1024;
+
+  const auto parallel = compressBytes(srcBytes, options);
+  options.bParallel = false;
+  const auto serial = compressBytes(srcBytes, options);
+
+  // The blocks don't depend on who compressed them
+  REQUIRE(parallel == serial);
+  REQUIRE(parallel.size() < srcBytes.size() / 2);
+
+  for (bool bParallel : { true, false }) {
+    auto comp = std::static_pointer_cast<DataStream>(makeStreamFromBytes(parallel));
+    auto decomp = Compression::decompress(comp, nullptr, bParallel);
+    REQUIRE(decomp != nullptr);
+    REQUIRE(readAllBytes(decomp) == srcBytes);
+  }
+}
+
+TEST_CASE("Compression: incompressible blocks are stored", "[Compression]") {
+  std::mt19937 rng(99);
+  std::vector<uint8_t> srcBytes(100000);
+  for (auto& b : srcBytes) b = static_cast<uint8_t>(rng());
+
+  const auto comp = compressBytes(srcBytes, CompressionOptions());
+
+  // Header and index, but no LZ4 expansion
+  REQUIRE(comp.size() <= srcBytes.size() + 64);
+
+  auto compAsDS = makeStreamFromBytes(comp);
+  auto decomp = Compression::decompress(compAsDS);
+  REQUIRE(decomp != nullptr);
+  REQUIRE(readAllBytes(decomp) == srcBytes);
+}
+
+TEST_CASE("Compression: HC levels compress smaller", "[Compression]") {
+  const auto srcBytes = makeCompressibleBytes(300 * 1024, 11);
+
+  CompressionOptions options;
+  const auto fast = compressBytes(srcBytes, options);
+  options.level = 9;
+  const auto hc = compressBytes(srcBytes, options);
+  REQUIRE(hc.size() < fast.size());
+
+  auto compAsDS = makeStreamFromBytes(hc);
+  auto decomp = Compression::decompress(compAsDS);
+  REQUIRE(decomp != nullptr);
+  REQUIRE(readAllBytes(decomp) == srcBytes);
+}
+
+TEST_CASE("Compression: dictionaries", "[Compression]") {
+  g_debug().setConsoleVerbosity(LogVerbosity::kFatal); //Avoid logging to console
+
+  // Small blocks gain the most from a dictionary
+  const auto srcBytes = makeCompressibleBytes(64 * 1024, 3);
+  const auto dictBytes = makeCompressibleBytes(16 * 1024, 5);
+  auto dictionary = ge_shared_ptr_new<MemoryDataStream>(dictBytes.size());
+  dictionary->write(dictBytes.data(), dictBytes.size());
+
+  CompressionOptions options;
+  options.blockSize = Compression::MIN_BLOCK_SIZE;
+  const auto plain = compressBytes(srcBytes, options);
+
+  for (int32 level : { 0, 4 }) {
+    options.level = level;
+    options.dictionary = dictionary;
+    const auto withDict = compressBytes(srcBytes, options);
+    REQUIRE(withDict.size() < plain.size());
+
+    auto comp = makeStreamFromBytes(withDict);
+    auto decomp = Compression::decompress(comp, dictionary);
+    REQUIRE(decomp != nullptr);
+    REQUIRE(readAllBytes(decomp) == srcBytes);
+
+    // Without it, or with another one, the data can't be read
+    comp = makeStreamFromBytes(withDict);
+    REQUIRE(Compression::decompress(comp) == nullptr);
+
+    auto otherDictionary = ge_shared_ptr_new<MemoryDataStream>(16u);
+    memset(otherDictionary->getPtr(), 1, 16);
+    comp = makeStreamFromBytes(withDict);
+    REQUIRE(Compression::decompress(comp, otherDictionary) == nullptr);
+  }
+}
+
+TEST_CASE("Compression: CompressedDataStream reads at random", "[Compression]") {
+  const auto srcBytes = makeCompressibleBytes(200000, 13);
+
+  CompressionOptions options;
+  options.blockSize = 16 * 1024;
+  const auto comp = compressBytes(srcBytes, options);
+
+  // The compressed data doesn't have to start the source stream
+  std::vector<uint8_t> prefixed(10, 0xEE);
+  prefixed.insert(prefixed.end(), comp.begin(), comp.end());
+  auto source = makeStreamFromBytes(prefixed);
+  source->seek(10);
+
+  CompressedDataStream stream(source);
+  REQUIRE(stream.isValid());
+  REQUIRE(stream.size() == srcBytes.size());
+  REQUIRE(stream.getNumBlocks() == 13);
+
+  // Across a block boundary
+  std::vector<uint8_t> out(5000);
+  stream.seek(16 * 1024 - 100);
+  REQUIRE(stream.read(out.data(), out.size()) == out.size());
+  REQUIRE(std::equal(out.begin(), out.end(), srcBytes.begin() + (16 * 1024 - 100)));
+
+  // Back to the start, then past the end
+  stream.seek(0);
+  REQUIRE(stream.read(out.data(), 10) == 10);
+  REQUIRE(std::equal(out.begin(), out.begin() + 10, srcBytes.begin()));
+
+  stream.seek(srcBytes.size() - 30);
+  REQUIRE(stream.read(out.data(), out.size()) == 30);
+  REQUIRE(stream.isEOF());
+
+  // Clones start where the original is
+  stream.seek(1234);
+  auto copy = stream.clone();
+  REQUIRE(copy->tell() == 1234);
+  REQUIRE(copy->read(out.data(), 100) == 100);
+  REQUIRE(std::equal(out.begin(), out.begin() + 100, srcBytes.begin() + 1234));
+
+  // Everything, read sequentially
+  stream.seek(0);
+  std::vector<uint8_t> all(srcBytes.size());
+  REQUIRE(stream.read(all.data(), all.size()) == all.size());
+  REQUIRE(all == srcBytes);
+}
+
+TEST_CASE("Compression: CompressedDataStream rejects other data", "[Compression]") {
+  g_debug().setConsoleVerbosity(LogVerbosity::kFatal); //Avoid logging to console
+
+  auto source = makeStreamFromBytes(std::vector<uint8_t>(64, 0x42));
+  CompressedDataStream stream(source);
+  REQUIRE_FALSE(stream.isValid());
+  REQUIRE(stream.size() == 0);
+
+  uint8_t byte = 0;
+  REQUIRE(stream.read(&byte, 1) == 0);
+}
+
+TEST_CASE("Compression: corrupt block index fails cleanly", "[Compression]") {
+  g_debug().setConsoleVerbosity(LogVerbosity::kFatal); //Avoid logging to console
+
+  const auto srcBytes = makeCompressibleBytes(100000, 17);
+  CompressionOptions options;
+  options.blockSize = 16 * 1024;
+  const auto comp = compressBytes(srcBytes, options);
+
+  // The index starts after the 32 bytes of the header
+  const size_t indexOffset = 32;
+  auto withBlockSize = [&comp](uint32 block, uint32 packedSize) {
+    auto bytes = comp;
+    std::memcpy(&bytes[indexOffset + block * sizeof(uint32)], &packedSize, sizeof(uint32));
+    return bytes;
+  };
+
+  const std::vector<uint8_t> corrupt[] = {
+    withBlockSize(0, 0x7FFFFFFFu),              // Bigger than LZ4 can make a block
+    withBlockSize(1, 100 | 0x80000000u),        // Stored, but not the size of a block
+    withBlockSize(6, 16 * 1024),                // Past the end of the data
+  };
+  for (const auto& bytes : corrupt) {
+    auto compAsDS = makeStreamFromBytes(bytes);
+    REQUIRE(Compression::decompress(compAsDS) == nullptr);
+
+    CompressedDataStream stream(makeStreamFromBytes(bytes));
+    REQUIRE_FALSE(stream.isValid());
+  }
+
+  // The output of compress is exactly what was written
+  auto compAsDS = makeStreamFromBytes(comp);
+  auto decomp = Compression::decompress(compAsDS);
+  REQUIRE(decomp != nullptr);
+  REQUIRE(readAllBytes(decomp) == srcBytes);
+}
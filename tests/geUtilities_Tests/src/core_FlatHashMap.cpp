@@ -0,0 +1,334 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <random>
+
+#include "geFlatHashMap.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  /**
+   * Every key lands in the same probe sequence, to test the collisions.
+   */
+  struct CollidingHash
+  {
+    size_t
+    operator()(uint32) const {
+      return 42;
+    }
+  };
+
+  struct Counted
+  {
+    explicit Counted(int32 value = 0)
+      : m_value(value) {
+      ++s_alive;
+    }
+
+    Counted(const Counted& other)
+      : m_value(other.m_value) {
+      ++s_alive;
+    }
+
+    Counted(Counted&& other) noexcept
+      : m_value(other.m_value) {
+      ++s_alive;
+    }
+
+    Counted&
+    operator=(const Counted&) = default;
+
+    ~Counted() {
+      --s_alive;
+    }
+
+    int32 m_value;
+    static int32 s_alive;
+  };
+
+  int32 Counted::s_alive = 0;
+}
+
+TEST_CASE("FlatHashMap: insert, find and erase", "[FlatHashMap]")
+{
+  FlatHashMap<uint32, uint32> map;
+  REQUIRE(map.empty());
+  REQUIRE(map.find(7) == map.end());
+  REQUIRE(map.begin() == map.end());
+
+  for (uint32 i = 0; i < 1000; ++i) {
+    REQUIRE(map.insert({ i, i * 3 }).second);
+  }
+  REQUIRE(map.size() == 1000);
+  REQUIRE_FALSE(map.insert({ 5, 0 }).second);
+  REQUIRE(map[5] == 15);
+
+  for (uint32 i = 0; i < 1000; ++i) {
+    auto it = map.find(i);
+    REQUIRE(it != map.end());
+    REQUIRE(it->second == i * 3);
+  }
+  REQUIRE_FALSE(map.contains(1000));
+
+  //Erasing every other key
+  for (uint32 i = 0; i < 1000; i += 2) {
+    REQUIRE(1 == map.erase(i));
+  }
+  REQUIRE(0 == map.erase(0));
+  REQUIRE(map.size() == 500);
+  for (uint32 i = 0; i < 1000; ++i) {
+    REQUIRE(map.contains(i) == (1 == i % 2));
+  }
+
+  uint32 count = 0;
+  uint64 sum = 0;
+  for (const auto& [key, value] : map) {
+    ++count;
+    sum += value - key * 3;
+  }
+  REQUIRE(count == 500);
+  REQUIRE(sum == 0);
+
+  map.clear();
+  REQUIRE(map.empty());
+  REQUIRE(map.begin() == map.end());
+  REQUIRE(map.capacity() > 0);
+}
+
+TEST_CASE("FlatHashMap: erasing while iterating", "[FlatHashMap]")
+{
+  FlatHashMap<uint32, SPtr<uint32>> map;
+  for (uint32 i = 0; i < 300; ++i) {
+    map[i] = ge_shared_ptr_new<uint32>(i);
+  }
+
+  //The same loop as the resource garbage collectors
+  auto it = map.cbegin();
+  while (it != map.cend()) {
+    if (0 == *it->second % 3) {
+      it = map.erase(it);
+      continue;
+    }
+    ++it;
+  }
+
+  REQUIRE(map.size() == 200);
+  for (uint32 i = 0; i < 300; ++i) {
+    REQUIRE(map.contains(i) == (0 != i % 3));
+  }
+}
+
+TEST_CASE("FlatHashMap: collisions and reused slots", "[FlatHashMap]")
+{
+  FlatHashMap<uint32, uint32, CollidingHash> map;
+  for (uint32 i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  for (uint32 i = 0; i < 100; ++i) {
+    REQUIRE(map.find(i)->second == i);
+  }
+
+  //Churning the same keys reuses the erased slots instead of growing
+  const SIZE_T capacity = map.capacity();
+  for (uint32 round = 0; round < 50; ++round) {
+    for (uint32 i = 0; i < 100; i += 2) {
+      REQUIRE(1 == map.erase(i));
+    }
+    for (uint32 i = 0; i < 100; i += 2) {
+      REQUIRE(map.try_emplace(i, i + round).second);
+    }
+  }
+  REQUIRE(map.capacity() == capacity);
+  REQUIRE(map.size() == 100);
+  for (uint32 i = 1; i < 100; i += 2) {
+    REQUIRE(map[i] == i);
+  }
+  REQUIRE(map[0] == 49);
+}
+
+TEST_CASE("FlatHashMap: reserve doesn't move the elements", "[FlatHashMap]")
+{
+  FlatHashMap<uint32, uint32> map;
+  map.reserve(500);
+  const SIZE_T capacity = map.capacity();
+  REQUIRE(capacity >= 500);
+
+  map[0] = 1;
+  const uint32* first = &map[0];
+  for (uint32 i = 1; i < 500; ++i) {
+    map[i] = i;
+  }
+  REQUIRE(map.capacity() == capacity);
+  REQUIRE(first == &map.find(0)->second);
+}
+
+TEST_CASE("FlatHashMap: elements are built and destroyed once", "[FlatHashMap]")
+{
+  {
+    FlatHashMap<String, Counted> map;
+    for (int32 i = 0; i < 200; ++i) {
+      map.try_emplace(toString(i), i);
+    }
+    REQUIRE(Counted::s_alive == 200);
+
+    //try_emplace doesn't build anything for a key already in the map
+    REQUIRE_FALSE(map.try_emplace("7", 1000).second);
+    REQUIRE(map["7"].m_value == 7);
+    REQUIRE(Counted::s_alive == 200);
+
+    map.erase("7");
+    REQUIRE(Counted::s_alive == 199);
+
+    FlatHashMap<String, Counted> copy = map;
+    REQUIRE(Counted::s_alive == 398);
+    REQUIRE(copy.size() == map.size());
+    REQUIRE(copy.find("150")->second.m_value == 150);
+
+    FlatHashMap<String, Counted> moved = std::move(copy);
+    REQUIRE(Counted::s_alive == 398);
+    REQUIRE(moved.find("199")->second.m_value == 199);
+
+    map.clear();
+    REQUIRE(Counted::s_alive == 199);
+  }
+  REQUIRE(Counted::s_alive == 0);
+}
+
+TEST_CASE("FlatHashMap: string views are looked up without a String", "[FlatHashMap]")
+{
+  FlatStringMap<uint32> map = { { "albedo", 0 }, { "normal", 1 }, { "roughness", 2 } };
+
+  const std::string_view name = "normal";
+  REQUIRE(map.find(name)->second == 1);
+  REQUIRE(map.contains("roughness"));
+  REQUIRE_FALSE(map.contains(std::string_view("albedo_")));
+  REQUIRE(map.count(String("albedo")) == 1);
+
+  REQUIRE(1 == map.erase(std::string_view("albedo")));
+  REQUIRE(map.size() == 2);
+}
+
+TEST_CASE("FlatHashSet: insert, find and erase", "[FlatHashMap]")
+{
+  FlatHashSet<uint32> set = { 1, 2, 3 };
+  REQUIRE(set.size() == 3);
+  REQUIRE_FALSE(set.insert(2).second);
+  REQUIRE(set.insert(4).second);
+  REQUIRE(set.contains(4));
+
+  FlatHashSet<uint32>::iterator it = set.find(3);
+  REQUIRE(*it == 3);
+  set.erase(it);
+  REQUIRE_FALSE(set.contains(3));
+
+  uint32 sum = 0;
+  for (uint32 value : set) {
+    sum += value;
+  }
+  REQUIRE(sum == 7);
+}
+
+namespace
+{
+  Vector<uint32>
+  makeRandomKeys(uint32 count) {
+    std::mt19937 generator(1234);
+    Vector<uint32> keys(count);
+    for (auto& key : keys) {
+      key = cast::st<uint32>(generator());
+    }
+    return keys;
+  }
+
+  Vector<String>
+  makePathKeys(uint32 count) {
+    Vector<String> keys;
+    keys.reserve(count);
+    for (uint32 i = 0; i < count; ++i) {
+      keys.push_back("textures/environment/" + toString(i) + ".dds");
+    }
+    return keys;
+  }
+
+  template<typename Map, typename Key>
+  uint64
+  lookupAll(const Map& map, const Vector<Key>& keys) {
+    uint64 found = 0;
+    for (const auto& key : keys) {
+      if (map.find(key) != map.end()) {
+        ++found;
+      }
+    }
+    return found;
+  }
+}
+
+TEST_CASE("FlatHashMap: throughput", "[.][benchmark][FlatHashMap]")
+{
+  const Vector<uint32> keys = makeRandomKeys(100000);
+  const Vector<String> paths = makePathKeys(20000);
+
+  BENCHMARK("UnorderedMap insert 100k") {
+    UnorderedMap<uint32, uint32> map;
+    for (auto key : keys) {
+      map[key] = key;
+    }
+    return map.size();
+  };
+
+  BENCHMARK("FlatHashMap insert 100k") {
+    FlatHashMap<uint32, uint32> map;
+    for (auto key : keys) {
+      map[key] = key;
+    }
+    return map.size();
+  };
+
+  UnorderedMap<uint32, uint32> nodeMap;
+  FlatHashMap<uint32, uint32> flatMap;
+  for (auto key : keys) {
+    nodeMap[key] = key;
+    flatMap[key] = key;
+  }
+
+  BENCHMARK("UnorderedMap find 100k") {
+    return lookupAll(nodeMap, keys);
+  };
+
+  BENCHMARK("FlatHashMap find 100k") {
+    return lookupAll(flatMap, keys);
+  };
+
+  BENCHMARK("UnorderedMap iterate 100k") {
+    uint64 sum = 0;
+    for (const auto& entry : nodeMap) {
+      sum += entry.second;
+    }
+    return sum;
+  };
+
+  BENCHMARK("FlatHashMap iterate 100k") {
+    uint64 sum = 0;
+    for (const auto& entry : flatMap) {
+      sum += entry.second;
+    }
+    return sum;
+  };
+
+  UnorderedMap<String, uint32> nodePaths;
+  FlatStringMap<uint32> flatPaths;
+  for (uint32 i = 0; i < paths.size(); ++i) {
+    nodePaths[paths[i]] = i;
+    flatPaths[paths[i]] = i;
+  }
+
+  BENCHMARK("UnorderedMap find 20k paths") {
+    return lookupAll(nodePaths, paths);
+  };
+
+  BENCHMARK("FlatStringMap find 20k paths") {
+    return lookupAll(flatPaths, paths);
+  };
+}
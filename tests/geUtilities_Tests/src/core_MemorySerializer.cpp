@@ -0,0 +1,295 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geMemorySerializer.h"
+#include "geDebug.h"
+#include "geBox.h"
+
+using namespace geEngineSDK;
+
+TEST_CASE("MemoryRecordWriter: aligned little-endian values", "[MemorySerializer]")
+{
+  MemoryRecordWriter writer;
+  writer.write(uint8(0xAB));
+  writer.write(uint32(0x11223344));
+  writer.write(uint16(0x5566));
+  writer.write(1.5);
+
+  //Each value is aligned to its size
+  REQUIRE(writer.size() == 24);
+  const uint8 expected[] = { 0xAB, 0, 0, 0, 0x44, 0x33, 0x22, 0x11, 0x66, 0x55 };
+  REQUIRE(0 == memcmp(writer.data(), expected, sizeof(expected)));
+
+  MemoryRecordReader reader(writer.data(), writer.size());
+  uint8 a = 0;
+  uint32 b = 0;
+  uint16 c = 0;
+  double d = 0;
+  REQUIRE(reader.read(a));
+  REQUIRE(reader.read(b));
+  REQUIRE(reader.read(c));
+  REQUIRE(reader.read(d));
+  REQUIRE(a == 0xAB);
+  REQUIRE(b == 0x11223344);
+  REQUIRE(c == 0x5566);
+  REQUIRE(d == 1.5);
+
+  //Nothing is read past the end
+  REQUIRE_FALSE(reader.read(a));
+  REQUIRE(reader.tell() == 24);
+}
+
+TEST_CASE("MemoryRecordWriter: arrays are read in place", "[MemorySerializer]")
+{
+  Vector<float> values(1000);
+  for (uint32 i = 0; i < values.size(); ++i) {
+    values[i] = i * 0.5f;
+  }
+
+  MemoryRecordWriter writer;
+  writer.writeString("samples");
+  writer.writeArray(values.data(), cast::st<uint32>(values.size()));
+  writer.writeArray<uint16>(nullptr, 0);
+
+  //The vector's buffer is aligned like the ones from ge_alloc()
+  const Vector<uint8> buffer(writer.data(), writer.data() + writer.size());
+  MemoryRecordReader reader(buffer.data(), buffer.size());
+
+  String name;
+  std::span<const float> view;
+  std::span<const uint16> empty;
+  REQUIRE(reader.readString(name));
+  REQUIRE(reader.readArrayInPlace(view));
+  REQUIRE(reader.readArrayInPlace(empty));
+  REQUIRE(name == "samples");
+  REQUIRE(empty.empty());
+
+  //Points into the buffer, aligned for the in place reads
+  REQUIRE(view.size() == values.size());
+  REQUIRE(reinterpret_cast<const uint8*>(view.data()) > buffer.data());
+  REQUIRE(reinterpret_cast<const uint8*>(view.data()) < buffer.data() + buffer.size());
+  REQUIRE(0 == (reinterpret_cast<const uint8*>(view.data()) - buffer.data()) %
+                 MemoryRecordWriter::ARRAY_ALIGNMENT);
+  REQUIRE(std::equal(view.begin(), view.end(), values.begin()));
+
+  //Or copied
+  REQUIRE(reader.seek(0));
+  Vector<float> copy;
+  REQUIRE(reader.readString(name));
+  REQUIRE(reader.readArray(copy));
+  REQUIRE(copy == values);
+}
+
+TEST_CASE("MemoryRecordReader: truncated arrays fail", "[MemorySerializer]")
+{
+  Vector<uint32> values(64, 7);
+  MemoryRecordWriter writer;
+  writer.writeArray(values.data(), cast::st<uint32>(values.size()));
+
+  MemoryRecordReader reader(writer.data(), writer.size() - 1);
+  Vector<uint32> copy;
+  REQUIRE_FALSE(reader.readArray(copy));
+
+  //A count larger than the data
+  MemoryRecordWriter liar;
+  liar.write(NumLimit::MAX_UINT32);
+  MemoryRecordReader liarReader(liar.data(), liar.size());
+  std::span<const uint32> view;
+  REQUIRE_FALSE(liarReader.readArrayInPlace(view));
+}
+
+#if USING(GE_REFLECTION)
+# include <rttr/registration>
+
+namespace
+{
+  enum class SaveDifficulty
+  {
+    kEasy,
+    kHard
+  };
+
+  struct SaveRecord
+  {
+    String name;
+    int32 level = 0;
+    float health = 0.0f;
+    SaveDifficulty difficulty = SaveDifficulty::kEasy;
+    AABox bounds = AABox(Vector3::ZERO, Vector3::ZERO);
+    Vector<float> samples;
+    std::span<const uint16> indices;
+    Vector<String> tags;
+    Vector<Vector3> points;
+  };
+
+  /**
+   * The previous version of SaveRecord, with other fields.
+   */
+  struct SaveRecordV0
+  {
+    String name;
+    int16 level = 0;
+    String removed;
+  };
+}
+
+RTTR_REGISTRATION
+{
+  using namespace rttr;
+  registration::enumeration<SaveDifficulty>("SaveDifficulty")(
+    value("kEasy", SaveDifficulty::kEasy),
+    value("kHard", SaveDifficulty::kHard));
+
+  registration::class_<SaveRecord>("SaveRecord")
+    .constructor<>()
+    .property("name", &SaveRecord::name)
+    .property("level", &SaveRecord::level)
+    .property("health", &SaveRecord::health)
+    .property("difficulty", &SaveRecord::difficulty)
+    .property("bounds", &SaveRecord::bounds)
+    .property("samples", &SaveRecord::samples)
+    .property("indices", &SaveRecord::indices)
+    .property("tags", &SaveRecord::tags)
+    .property("points", &SaveRecord::points);
+
+  //Same length as "SaveRecord", to rename the records of this type
+  registration::class_<SaveRecordV0>("SaveRecorV")
+    .constructor<>()
+    .property("name", &SaveRecordV0::name)
+    .property("level", &SaveRecordV0::level)
+    .property("removed", &SaveRecordV0::removed);
+}
+
+namespace
+{
+  SaveRecord
+  makeSaveRecord(const Vector<uint16>& indices) {
+    SaveRecord record;
+    record.name = "Slot 1";
+    record.level = 12;
+    record.health = 0.75f;
+    record.difficulty = SaveDifficulty::kHard;
+    record.bounds = AABox(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+    record.samples = { 1.0f, 2.0f, 3.0f };
+    record.indices = std::span<const uint16>(indices);
+    record.tags = { "forest", "night" };
+    record.points = { Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f) };
+    return record;
+  }
+}
+
+TEST_CASE("MemorySerializer: roundtrips a reflected object", "[MemorySerializer]")
+{
+  const Vector<uint16> indices = { 0, 1, 2, 2, 3, 0 };
+  const SaveRecord original = makeSaveRecord(indices);
+
+  MemorySerializer serializer;
+  uint32 size = 0;
+  uint8* buffer = serializer.encode(original, size);
+  REQUIRE(nullptr != buffer);
+  REQUIRE(size > 16);
+
+  SaveRecord copy;
+  REQUIRE(serializer.decode(buffer, size, copy));
+  REQUIRE(copy.name == original.name);
+  REQUIRE(copy.level == original.level);
+  REQUIRE(copy.health == original.health);
+  REQUIRE(copy.difficulty == original.difficulty);
+  REQUIRE(copy.bounds == original.bounds);
+  REQUIRE(copy.samples == original.samples);
+  REQUIRE(copy.tags == original.tags);
+  REQUIRE(copy.points == original.points);
+
+  //The span points into the encoded buffer instead of being copied
+  REQUIRE(copy.indices.size() == indices.size());
+  REQUIRE(reinterpret_cast<const uint8*>(copy.indices.data()) > buffer);
+  REQUIRE(reinterpret_cast<const uint8*>(copy.indices.data()) < buffer + size);
+  REQUIRE(std::equal(copy.indices.begin(), copy.indices.end(), indices.begin()));
+
+  //Created from the type name
+  rttr::variant created = serializer.decode(buffer, size);
+  REQUIRE(created.is_valid());
+
+  ge_free(buffer);
+}
+
+TEST_CASE("MemorySerializer: rejects corrupted data", "[MemorySerializer]")
+{
+  g_debug().setConsoleVerbosity(LogVerbosity::kFatal); //Avoid logging to console
+
+  const Vector<uint16> indices = { 1, 2, 3 };
+  const SaveRecord original = makeSaveRecord(indices);
+
+  MemorySerializer serializer;
+  uint32 size = 0;
+  uint8* buffer = serializer.encode(original, size);
+
+  SaveRecord copy;
+  REQUIRE_FALSE(serializer.decode(buffer, size - 1, copy));
+  REQUIRE_FALSE(serializer.decode(buffer, 8, copy));
+
+  //Another type
+  SaveRecordV0 other;
+  REQUIRE_FALSE(serializer.decode(buffer, size, other));
+
+  buffer[0] ^= 0xFF;
+  REQUIRE_FALSE(serializer.decode(buffer, size, copy));
+  ge_free(buffer);
+}
+
+TEST_CASE("MemorySerializer: rejects array counts past the end of the data", "[MemorySerializer]")
+{
+  const Vector<uint16> indices = { 1, 2, 3 };
+  SaveRecord original = makeSaveRecord(indices);
+  original.tags = { "tagA", "tagB", "tagC" };
+
+  MemorySerializer serializer;
+  uint32 size = 0;
+  uint8* buffer = serializer.encode(original, size);
+
+  //The count of the tags goes before the kind and the length of the first one
+  const uint8* firstTag = std::search(buffer, buffer + size, "tagA", "tagA" + 4);
+  REQUIRE(firstTag > buffer + 12);
+  uint8* countData = buffer + (firstTag - buffer) - 12;
+  uint32 count = 0;
+  memcpy(&count, countData, sizeof(count));
+  REQUIRE(3 == count);
+
+  //Would ask for billions of strings before reading the first one
+  count = 0x7FFFFFFF;
+  memcpy(countData, &count, sizeof(count));
+
+  SaveRecord copy;
+  REQUIRE_FALSE(serializer.decode(buffer, size, copy));
+  ge_free(buffer);
+}
+
+TEST_CASE("MemorySerializer: older records keep the matching fields", "[MemorySerializer]")
+{
+  SaveRecordV0 old;
+  old.name = "Old slot";
+  old.level = 3;
+  old.removed = "ignored";
+
+  MemorySerializer serializer;
+  uint32 size = 0;
+  uint8* buffer = serializer.encode(old, size);
+
+  //Renames the records to the current type
+  const String oldName = "SaveRecorV";
+  uint8* name = std::search(buffer, buffer + size, oldName.begin(), oldName.end());
+  REQUIRE(name != buffer + size);
+  memcpy(name, "SaveRecord", oldName.size());
+
+  SaveRecord record;
+  record.health = 1.0f;
+  REQUIRE(serializer.decode(buffer, size, record));
+  REQUIRE(record.name == "Old slot");
+
+  //Converted from int16, while the removed field is skipped and the new
+  //ones keep their values
+  REQUIRE(record.level == 3);
+  REQUIRE(record.health == 1.0f);
+  REQUIRE(record.samples.empty());
+  ge_free(buffer);
+}
+#endif
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "geMemoryTracker.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureMemoryTrackerStartedForTests() {
+    if (!MemoryTracker::isStarted()) {
+      MemoryTracker::startUp(true);
+    }
+  }
+
+  const MemoryTagStats&
+  findTag(const MemorySnapshot& snapshot, const char* name) {
+    for (const auto& tag : snapshot.tags) {
+      if (0 == strcmp(tag.name, name)) {
+        return tag;
+      }
+    }
+    FAIL("Missing tag " << name);
+    return snapshot.tags[0];
+  }
+
+  /**
+   * Every call records from the same call site.
+   */
+  void
+  allocFromOneSite(MemoryTracker& tracker, byte* ptr) {
+    tracker.recordAlloc(ptr, 8, MEMORY_SOURCE::kGeneral);
+  }
+}
+
+TEST_CASE("MemoryTracker: counts live bytes per tag and source", "[MemoryTracker]")
+{
+  ensureMemoryTrackerStartedForTests();
+  auto& tracker = MemoryTracker::instance();
+
+  Array<byte, 4> blocks{};
+  const MemorySnapshot before = tracker.snapshot();
+  {
+    GE_MEMORY_TAG("TrackerTest");
+    tracker.recordAlloc(&blocks[0], 100, MEMORY_SOURCE::kGeneral);
+    tracker.recordAlloc(&blocks[1], 50, MEMORY_SOURCE::kPool);
+  }
+  REQUIRE(0 == MemoryTracker::getThreadTag());
+
+  //Counted against the tag that allocated it
+  tracker.recordFree(&blocks[0], MEMORY_SOURCE::kGeneral);
+
+  //Never allocated while tracking
+  tracker.recordFree(&blocks[2], MEMORY_SOURCE::kGeneral);
+
+  const MemorySnapshot change = MemoryTracker::diff(before, tracker.snapshot());
+  const MemoryTagStats& tag = findTag(change, "TrackerTest");
+  REQUIRE(tag.stats.totalAllocs == 2);
+  REQUIRE(tag.stats.totalFrees == 1);
+  REQUIRE(tag.stats.totalBytes == 150);
+  REQUIRE(tag.stats.liveAllocs == 1);
+  REQUIRE(tag.stats.liveBytes == 50);
+  REQUIRE(tag.stats.peakBytes >= 150);
+
+  REQUIRE(change.sources[MEMORY_SOURCE::kPool].liveBytes == 50);
+  REQUIRE(change.sources[MEMORY_SOURCE::kPool].totalAllocs == 1);
+
+  //The leak shows in the report with its tag
+  const String report = tracker.getLeakReport();
+  REQUIRE(report.find("TrackerTest: 50 bytes in 1 allocations") != String::npos);
+
+  tracker.recordFree(&blocks[1], MEMORY_SOURCE::kPool);
+  REQUIRE(findTag(tracker.snapshot(), "TrackerTest").stats.liveBytes == 0);
+}
+
+TEST_CASE("MemoryTracker: frame allocations are only counted", "[MemoryTracker]")
+{
+  ensureMemoryTrackerStartedForTests();
+  auto& tracker = MemoryTracker::instance();
+
+  byte block{};
+  tracker.endFrame();
+  {
+    GE_MEMORY_TAG("TrackerFrame");
+    for (int32 i = 0; i < 3; ++i) {
+      tracker.recordAlloc(nullptr, 64, MEMORY_SOURCE::kFrame);
+    }
+    tracker.recordFree(&block, MEMORY_SOURCE::kFrame);
+  }
+  tracker.endFrame();
+
+  const MemorySnapshot snapshot = tracker.snapshot();
+  const MemoryTagStats& tag = findTag(snapshot, "TrackerFrame");
+  REQUIRE(tag.lastFrame.allocs == 3);
+  REQUIRE(tag.lastFrame.frees == 1);
+  REQUIRE(tag.lastFrame.bytes == 192);
+  REQUIRE(tag.stats.liveBytes == 0);
+
+  tracker.endFrame();
+  REQUIRE(findTag(tracker.snapshot(), "TrackerFrame").lastFrame.allocs == 0);
+}
+
+TEST_CASE("MemoryTracker: a diff ranks the call sites", "[MemoryTracker]")
+{
+  ensureMemoryTrackerStartedForTests();
+  auto& tracker = MemoryTracker::instance();
+
+  Vector<byte> blocks(1000);
+  byte other{};
+  const MemorySnapshot before = tracker.snapshot();
+  for (auto& block : blocks) {
+    allocFromOneSite(tracker, &block);
+  }
+  tracker.recordAlloc(&other, 8, MEMORY_SOURCE::kGeneral);
+
+  const MemorySnapshot change = MemoryTracker::diff(before, tracker.snapshot());
+  REQUIRE(change.callsites.size() >= 2);
+  REQUIRE(change.callsites[0].stats.totalAllocs == 1000);
+  REQUIRE(change.callsites[0].stats.liveBytes == 8000);
+  REQUIRE(change.callsites[0].numFrames > 0);
+
+  for (auto& block : blocks) {
+    tracker.recordFree(&block, MEMORY_SOURCE::kGeneral);
+  }
+  tracker.recordFree(&other, MEMORY_SOURCE::kGeneral);
+}
+
+TEST_CASE("MemoryTracker: records from many threads", "[MemoryTracker]")
+{
+  ensureMemoryTrackerStartedForTests();
+  auto& tracker = MemoryTracker::instance();
+
+  const MemorySnapshot before = tracker.snapshot();
+
+  Vector<byte> blocks(4 * 10000);
+  Vector<std::thread> threads;
+  for (uint32 i = 0; i < 4; ++i) {
+    threads.emplace_back([&tracker, &blocks, i]() {
+      GE_MEMORY_TAG("TrackerThreads");
+      for (uint32 j = 0; j < 10000; ++j) {
+        tracker.recordAlloc(&blocks[i * 10000 + j], 16, MEMORY_SOURCE::kStack);
+      }
+      for (uint32 j = 0; j < 10000; ++j) {
+        tracker.recordFree(&blocks[i * 10000 + j], MEMORY_SOURCE::kStack);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const MemorySnapshot change = MemoryTracker::diff(before, tracker.snapshot());
+  const MemoryTagStats& tag = findTag(change, "TrackerThreads");
+  REQUIRE(tag.stats.totalAllocs == 40000);
+  REQUIRE(tag.stats.totalFrees == 40000);
+  REQUIRE(tag.stats.liveBytes == 0);
+  REQUIRE(change.sources[MEMORY_SOURCE::kStack].liveAllocs == 0);
+}
+
+#if defined(GE_PROFILING_ENABLED) && GE_PROFILING_ENABLED
+TEST_CASE("MemoryTracker: the allocators feed it", "[MemoryTracker]")
+{
+  ensureMemoryTrackerStartedForTests();
+  auto& tracker = MemoryTracker::instance();
+
+  const MemorySnapshot before = tracker.snapshot();
+  void* ptr = nullptr;
+  {
+    GE_MEMORY_TAG("TrackerAlloc");
+    ptr = ge_alloc(256);
+  }
+
+  MemorySnapshot change = MemoryTracker::diff(before, tracker.snapshot());
+  REQUIRE(findTag(change, "TrackerAlloc").stats.liveBytes == 256);
+
+  ge_free(ptr);
+  change = MemoryTracker::diff(before, tracker.snapshot());
+  REQUIRE(findTag(change, "TrackerAlloc").stats.liveBytes == 0);
+}
+#endif
@@ -0,0 +1,208 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "geMeshOptimizer.h"
+#include "geVector3.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  struct TestVertex
+  {
+    float position[3];
+    float uv[2];
+  };
+
+  using TriangleBytes = std::array<uint8, sizeof(TestVertex) * 3>;
+
+  /**
+   * Grid of size x size quads where every triangle has its own three
+   * vertices (what the importer produces without joining vertices), in a
+   * random triangle order.
+   */
+  void makeUnweldedGrid(uint32 size,
+                        Vector<uint8>& vertices,
+                        Vector<uint32>& indices,
+                        uint32 seed = 7)
+  {
+    Vector<std::array<uint32, 3>> triangles;
+    auto gridIndex = [size](uint32 x, uint32 y) { return y * (size + 1) + x; };
+    for (uint32 y = 0; y < size; ++y) {
+      for (uint32 x = 0; x < size; ++x) {
+        triangles.push_back({ gridIndex(x, y), gridIndex(x, y + 1), gridIndex(x + 1, y) });
+        triangles.push_back({ gridIndex(x + 1, y), gridIndex(x, y + 1), gridIndex(x + 1, y + 1) });
+      }
+    }
+
+    std::mt19937 rng(seed);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+
+    vertices.clear();
+    indices.clear();
+    for (const auto& triangle : triangles) {
+      for (auto gridVertex : triangle) {
+        const float x = static_cast<float>(gridVertex % (size + 1));
+        const float y = static_cast<float>(gridVertex / (size + 1));
+        const TestVertex vertex = { { x, y, 0.0f }, { x / size, y / size } };
+
+        const auto* bytes = reinterpret_cast<const uint8*>(&vertex);
+        indices.push_back(static_cast<uint32>(vertices.size() / sizeof(TestVertex)));
+        vertices.insert(vertices.end(), bytes, bytes + sizeof(TestVertex));
+      }
+    }
+  }
+
+  /**
+   * The triangles as the GPU sees them, sorted so two meshes can be compared
+   * regardless of the order of the triangles and the vertices.
+   */
+  Vector<TriangleBytes> resolveTriangles(const Vector<uint8>& vertices,
+                                         const Vector<uint32>& indices)
+  {
+    Vector<TriangleBytes> triangles(indices.size() / 3);
+    for (SIZE_T i = 0; i < indices.size(); ++i) {
+      std::memcpy(triangles[i / 3].data() + (i % 3) * sizeof(TestVertex),
+                  &vertices[indices[i] * sizeof(TestVertex)],
+                  sizeof(TestVertex));
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  }
+
+  uint32 vertexCountOf(const Vector<uint8>& vertices)
+  {
+    return static_cast<uint32>(vertices.size() / sizeof(TestVertex));
+  }
+}
+
+TEST_CASE("MeshOptimizer: analyzeVertexCache on small meshes", "[MeshOptimizer]")
+{
+  const Vector<uint32> single = { 0, 1, 2 };
+  auto stats = MeshOptimizer::analyzeVertexCache(single, 3);
+  REQUIRE(stats.vertexTransforms == 3);
+  REQUIRE(stats.acmr == 3.0f);
+  REQUIRE(stats.atvr == 1.0f);
+
+  const Vector<uint32> quad = { 0, 1, 2, 2, 1, 3 };
+  stats = MeshOptimizer::analyzeVertexCache(quad, 4);
+  REQUIRE(stats.vertexTransforms == 4);
+  REQUIRE(stats.acmr == 2.0f);
+  REQUIRE(stats.atvr == 1.0f);
+
+  //A cache of 3 vertices forgets vertex 0 before it's used again
+  const Vector<uint32> fan = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+  stats = MeshOptimizer::analyzeVertexCache(fan, 6, 3);
+  REQUIRE(stats.vertexTransforms == 9);
+  REQUIRE(stats.atvr == 1.5f);
+}
+
+TEST_CASE("MeshOptimizer: weldVertices merges equal vertices", "[MeshOptimizer]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeUnweldedGrid(16, vertices, indices);
+  const auto expected = resolveTriangles(vertices, indices);
+
+  const uint32 vertexCount = MeshOptimizer::weldVertices(vertices, sizeof(TestVertex), indices);
+  REQUIRE(vertexCount == 17 * 17);
+  REQUIRE(vertexCountOf(vertices) == vertexCount);
+  REQUIRE(resolveTriangles(vertices, indices) == expected);
+
+  //Welding again finds nothing to merge
+  REQUIRE(MeshOptimizer::weldVertices(vertices, sizeof(TestVertex), indices) == vertexCount);
+}
+
+TEST_CASE("MeshOptimizer: optimizeVertexCache lowers the ACMR", "[MeshOptimizer]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeUnweldedGrid(32, vertices, indices);
+  const uint32 vertexCount = MeshOptimizer::weldVertices(vertices, sizeof(TestVertex), indices);
+  const auto expected = resolveTriangles(vertices, indices);
+
+  const auto before = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+  MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+  const auto after = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+
+  REQUIRE(resolveTriangles(vertices, indices) == expected);
+  REQUIRE(before.acmr > 2.0f);
+  REQUIRE(after.acmr < 0.8f);
+  REQUIRE(after.atvr < 1.5f);
+}
+
+TEST_CASE("MeshOptimizer: optimizeOverdraw keeps the triangles and most of the locality",
+          "[MeshOptimizer]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeUnweldedGrid(32, vertices, indices);
+  const uint32 vertexCount = MeshOptimizer::weldVertices(vertices, sizeof(TestVertex), indices);
+  MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+  const auto expected = resolveTriangles(vertices, indices);
+  const float cacheAcmr = MeshOptimizer::analyzeVertexCache(indices, vertexCount).acmr;
+
+  MeshOptimizer::optimizeOverdraw(indices, vertices, sizeof(TestVertex), 0, 1.05f);
+
+  REQUIRE(resolveTriangles(vertices, indices) == expected);
+  REQUIRE(MeshOptimizer::analyzeVertexCache(indices, vertexCount).acmr < cacheAcmr * 1.25f);
+}
+
+TEST_CASE("MeshOptimizer: optimizeVertexFetch orders vertices by first use", "[MeshOptimizer]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeUnweldedGrid(8, vertices, indices);
+  MeshOptimizer::weldVertices(vertices, sizeof(TestVertex), indices);
+
+  //An extra vertex that no triangle uses is dropped
+  vertices.resize(vertices.size() + sizeof(TestVertex), 0);
+  const auto expected = resolveTriangles(vertices, indices);
+
+  const uint32 vertexCount = MeshOptimizer::optimizeVertexFetch(vertices, sizeof(TestVertex), indices);
+  REQUIRE(vertexCount == 9 * 9);
+  REQUIRE(vertexCountOf(vertices) == vertexCount);
+  REQUIRE(resolveTriangles(vertices, indices) == expected);
+
+  uint32 nextNew = 0;
+  for (auto index : indices) {
+    REQUIRE(index <= nextNew);
+    if (index == nextNew) {
+      ++nextNew;
+    }
+  }
+}
+
+TEST_CASE("MeshOptimizer: optimize runs every pass", "[MeshOptimizer]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeUnweldedGrid(24, vertices, indices);
+  const auto expected = resolveTriangles(vertices, indices);
+
+  const uint32 vertexCount = MeshOptimizer::optimize(vertices, sizeof(TestVertex), 0, indices);
+  REQUIRE(vertexCount == 25 * 25);
+  REQUIRE(resolveTriangles(vertices, indices) == expected);
+  REQUIRE(MeshOptimizer::analyzeVertexCache(indices, vertexCount).acmr < 0.9f);
+
+  Vector<uint8> emptyVertices;
+  Vector<uint32> emptyIndices;
+  REQUIRE(MeshOptimizer::optimize(emptyVertices, sizeof(TestVertex), 0, emptyIndices) == 0);
+}
+
+TEST_CASE("MeshOptimizer: throughput", "[.][benchmark][MeshOptimizer]")
+{
+  Vector<uint8> sourceVertices;
+  Vector<uint32> sourceIndices;
+  makeUnweldedGrid(256, sourceVertices, sourceIndices);
+
+  BENCHMARK("optimize 131k triangles") {
+    Vector<uint8> vertices = sourceVertices;
+    Vector<uint32> indices = sourceIndices;
+    return MeshOptimizer::optimize(vertices, sizeof(TestVertex), 0, indices);
+  };
+}
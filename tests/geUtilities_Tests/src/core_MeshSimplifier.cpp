@@ -0,0 +1,319 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#include "geMeshSimplifier.h"
+#include "geVector3.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  struct TestVertex
+  {
+    float position[3];
+    float normal[3];
+    float uv[2];
+  };
+
+  void
+  pushVertex(Vector<uint8>& vertices, const TestVertex& vertex) {
+    const auto* bytes = reinterpret_cast<const uint8*>(&vertex);
+    vertices.insert(vertices.end(), bytes, bytes + sizeof(TestVertex));
+  }
+
+  TestVertex
+  getVertex(const Vector<uint8>& vertices, uint32 index) {
+    TestVertex vertex;
+    std::memcpy(&vertex, &vertices[index * sizeof(TestVertex)], sizeof(TestVertex));
+    return vertex;
+  }
+
+  /**
+   * UV sphere of radius one. The u seam and the poles repeat their
+   * positions with different uvs, like an imported mesh would.
+   */
+  void
+  makeSphere(uint32 rings, uint32 segments, Vector<uint8>& vertices, Vector<uint32>& indices) {
+    const float pi = 3.14159265f;
+    vertices.clear();
+    indices.clear();
+    for (uint32 r = 0; r <= rings; ++r) {
+      const float theta = pi * r / rings;
+      for (uint32 s = 0; s <= segments; ++s) {
+        const float phi = 2.0f * pi * (s % segments) / segments;
+        const float x = std::sin(theta) * std::cos(phi);
+        const float y = std::cos(theta);
+        const float z = std::sin(theta) * std::sin(phi);
+        pushVertex(vertices, TestVertex{ { x, y, z },
+                                         { x, y, z },
+                                         { float(s) / segments, float(r) / rings } });
+      }
+    }
+
+    auto index = [segments](uint32 r, uint32 s) { return r * (segments + 1) + s; };
+    for (uint32 r = 0; r < rings; ++r) {
+      for (uint32 s = 0; s < segments; ++s) {
+        if (r > 0) {
+          indices.insert(indices.end(), { index(r, s), index(r, s + 1), index(r + 1, s) });
+        }
+        if (r + 1 < rings) {
+          indices.insert(indices.end(), { index(r, s + 1), index(r + 1, s + 1), index(r + 1, s) });
+        }
+      }
+    }
+  }
+
+  /**
+   * Flat size x size grid on the xz plane, open on its four sides.
+   */
+  void
+  makeGrid(uint32 size, Vector<uint8>& vertices, Vector<uint32>& indices) {
+    vertices.clear();
+    indices.clear();
+    for (uint32 y = 0; y <= size; ++y) {
+      for (uint32 x = 0; x <= size; ++x) {
+        pushVertex(vertices, TestVertex{ { float(x), 0.0f, float(y) },
+                                         { 0.0f, 1.0f, 0.0f },
+                                         { float(x) / size, float(y) / size } });
+      }
+    }
+
+    auto index = [size](uint32 x, uint32 y) { return y * (size + 1) + x; };
+    for (uint32 y = 0; y < size; ++y) {
+      for (uint32 x = 0; x < size; ++x) {
+        indices.insert(indices.end(), { index(x, y), index(x, y + 1), index(x + 1, y) });
+        indices.insert(indices.end(), { index(x + 1, y), index(x, y + 1), index(x + 1, y + 1) });
+      }
+    }
+  }
+
+  /**
+   * Largest distance from the center of a triangle to the unit sphere.
+   */
+  float
+  maxSphereDeviation(const Vector<uint8>& vertices, const Vector<uint32>& indices) {
+    float deviation = 0.0f;
+    for (SIZE_T i = 0; i < indices.size(); i += 3) {
+      Vector3 center(0.0f, 0.0f, 0.0f);
+      for (uint32 e = 0; e < 3; ++e) {
+        const auto vertex = getVertex(vertices, indices[i + e]);
+        center += Vector3(vertex.position[0], vertex.position[1], vertex.position[2]);
+      }
+      center /= 3.0f;
+      deviation = Math::max(deviation, 1.0f - center.size());
+    }
+    return deviation;
+  }
+
+  const Vector<SimplifyAttribute> NO_ATTRIBUTES;
+}
+
+TEST_CASE("MeshSimplifier: reduces a closed mesh to the target", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeSphere(48, 96, vertices, indices);
+
+  const uint32 target = static_cast<uint32>(indices.size() / 4 / 3 * 3);
+  float error = 0.0f;
+  const auto simplified = MeshSimplifier::simplify(indices,
+                                                   vertices,
+                                                   sizeof(TestVertex),
+                                                   0,
+                                                   NO_ATTRIBUTES,
+                                                   target,
+                                                   NumLimit::MAX_FLOAT,
+                                                   &error);
+
+  REQUIRE(simplified.size() % 3 == 0);
+  REQUIRE(simplified.size() <= target);
+  REQUIRE(simplified.size() > target * 9 / 10);
+  REQUIRE(error > 0.0f);
+  REQUIRE(error < 0.02f);
+  REQUIRE(maxSphereDeviation(vertices, simplified) < 0.05f);
+
+  //No degenerate triangles left
+  for (SIZE_T i = 0; i < simplified.size(); i += 3) {
+    REQUIRE(simplified[i] != simplified[i + 1]);
+    REQUIRE(simplified[i + 1] != simplified[i + 2]);
+    REQUIRE(simplified[i] != simplified[i + 2]);
+  }
+}
+
+TEST_CASE("MeshSimplifier: keeps borders and seams in place", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeGrid(32, vertices, indices);
+
+  float error = 1.0f;
+  const auto simplified = MeshSimplifier::simplify(indices,
+                                                   vertices,
+                                                   sizeof(TestVertex),
+                                                   0,
+                                                   NO_ATTRIBUTES,
+                                                   0,
+                                                   NumLimit::MAX_FLOAT,
+                                                   &error);
+
+  //A flat grid can lose every inner vertex without any error
+  REQUIRE(error == 0.0f);
+  REQUIRE(simplified.size() < indices.size() / 10);
+
+  Vector<uint8> used(vertices.size() / sizeof(TestVertex), 0);
+  for (auto index : simplified) {
+    used[index] = 1;
+  }
+  for (uint32 i = 0; i <= 32; ++i) {
+    REQUIRE(used[i]);
+    REQUIRE(used[32 * 33 + i]);
+    REQUIRE(used[i * 33]);
+    REQUIRE(used[i * 33 + 32]);
+  }
+
+  //The u seam of the sphere is still there on both sides
+  makeSphere(24, 48, vertices, indices);
+  const auto sphere = MeshSimplifier::simplify(indices,
+                                               vertices,
+                                               sizeof(TestVertex),
+                                               0,
+                                               NO_ATTRIBUTES,
+                                               static_cast<uint32>(indices.size() / 8));
+  used.assign(vertices.size() / sizeof(TestVertex), 0);
+  for (auto index : sphere) {
+    used[index] = 1;
+  }
+  for (uint32 r = 1; r < 24; ++r) {
+    REQUIRE(used[r * 49]);
+    REQUIRE(used[r * 49 + 48]);
+  }
+}
+
+TEST_CASE("MeshSimplifier: stops at the max error", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeSphere(32, 64, vertices, indices);
+
+  float error = 0.0f;
+  const auto simplified = MeshSimplifier::simplify(indices,
+                                                   vertices,
+                                                   sizeof(TestVertex),
+                                                   0,
+                                                   NO_ATTRIBUTES,
+                                                   0,
+                                                   0.001f,
+                                                   &error);
+  REQUIRE(error <= 0.001f);
+  REQUIRE(simplified.size() < indices.size());
+  REQUIRE(simplified.size() > indices.size() / 4);
+}
+
+TEST_CASE("MeshSimplifier: attributes add to the error", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeGrid(32, vertices, indices);
+
+  //Bend the uvs so the flat grid has something to lose besides positions
+  for (uint32 v = 0; v < vertices.size() / sizeof(TestVertex); ++v) {
+    auto vertex = getVertex(vertices, v);
+    vertex.uv[0] = std::sin(vertex.position[0] * 0.5f);
+    std::memcpy(&vertices[v * sizeof(TestVertex)], &vertex, sizeof(TestVertex));
+  }
+
+  const uint32 target = static_cast<uint32>(indices.size() / 4 / 3 * 3);
+  const Vector<SimplifyAttribute> uvAttribute = {
+    SimplifyAttribute{ static_cast<uint32>(offsetof(TestVertex, uv)), 2, 0.01f }
+  };
+
+  float plainError = 0.0f;
+  float attributeError = 0.0f;
+  MeshSimplifier::simplify(indices, vertices, sizeof(TestVertex), 0,
+                           NO_ATTRIBUTES, target, NumLimit::MAX_FLOAT, &plainError);
+  MeshSimplifier::simplify(indices, vertices, sizeof(TestVertex), 0,
+                           uvAttribute, target, NumLimit::MAX_FLOAT, &attributeError);
+
+  REQUIRE(plainError == 0.0f);
+  REQUIRE(attributeError > 0.0f);
+}
+
+TEST_CASE("MeshSimplifier: generateLods builds a chain", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeSphere(48, 96, vertices, indices);
+
+  const auto lods = MeshSimplifier::generateLods(indices,
+                                                 vertices,
+                                                 sizeof(TestVertex),
+                                                 0,
+                                                 NO_ATTRIBUTES,
+                                                 4);
+  REQUIRE(lods.size() == 4);
+
+  SIZE_T previousCount = indices.size();
+  float previousError = 0.0f;
+  for (const auto& lod : lods) {
+    REQUIRE(lod.indices.size() <= previousCount / 2);
+    REQUIRE(lod.error >= previousError);
+    previousCount = lod.indices.size();
+    previousError = lod.error;
+  }
+
+  //A mesh that is all borders can't make any LOD
+  Vector<uint32> quad = { 0, 1, 2, 2, 1, 3 };
+  Vector<uint8> quadVertices;
+  for (uint32 i = 0; i < 4; ++i) {
+    pushVertex(quadVertices, TestVertex{ { float(i & 1), 0.0f, float(i >> 1) }, {}, {} });
+  }
+  REQUIRE(MeshSimplifier::generateLods(quad, quadVertices, sizeof(TestVertex), 0,
+                                       NO_ATTRIBUTES, 3).empty());
+}
+
+TEST_CASE("MeshSimplifier: extractPositions compacts the used vertices", "[MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeGrid(4, vertices, indices);
+
+  //Only the last two triangles, they use four of the 25 vertices
+  Vector<uint32> used(indices.end() - 6, indices.end());
+
+  Vector<Vector3> positions;
+  Vector<uint32> compact;
+  MeshSimplifier::extractPositions(used,
+                                   vertices,
+                                   sizeof(TestVertex),
+                                   0,
+                                   positions,
+                                   compact);
+  REQUIRE(positions.size() == 4);
+  REQUIRE(compact.size() == used.size());
+  for (SIZE_T i = 0; i < used.size(); ++i) {
+    REQUIRE(compact[i] < positions.size());
+    const auto vertex = getVertex(vertices, used[i]);
+    REQUIRE(positions[compact[i]] == Vector3(vertex.position[0],
+                                             vertex.position[1],
+                                             vertex.position[2]));
+  }
+}
+
+TEST_CASE("MeshSimplifier: throughput", "[.][benchmark][MeshSimplifier]")
+{
+  Vector<uint8> vertices;
+  Vector<uint32> indices;
+  makeSphere(256, 256, vertices, indices);
+
+  BENCHMARK("simplify 130k triangles to 25%") {
+    return MeshSimplifier::simplify(indices,
+                                    vertices,
+                                    sizeof(TestVertex),
+                                    0,
+                                    NO_ATTRIBUTES,
+                                    static_cast<uint32>(indices.size() / 4));
+  };
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "geMipMapGenerator.h"
+#include "geTaskScheduler.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  Vector<uint8>
+  solidImage(uint32 width, uint32 height, uint8 r, uint8 g, uint8 b, uint8 a) {
+    Vector<uint8> pixels(static_cast<SIZE_T>(width) * height * 4);
+    for (SIZE_T i = 0; i < pixels.size(); i += 4) {
+      pixels[i + 0] = r;
+      pixels[i + 1] = g;
+      pixels[i + 2] = b;
+      pixels[i + 3] = a;
+    }
+    return pixels;
+  }
+
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+}
+
+TEST_CASE("MipMapGenerator: level count and layout", "[MipMapGenerator]") {
+  REQUIRE(MipMapGenerator::calcMipCount(1, 1) == 1);
+  REQUIRE(MipMapGenerator::calcMipCount(256, 256) == 9);
+  REQUIRE(MipMapGenerator::calcMipCount(300, 17) == 9);
+
+  auto pixels = solidImage(37, 10, 10, 20, 30, 255);
+  auto chain = MipMapGenerator::generateRGBA8(pixels.data(), 37, 10);
+  REQUIRE(chain.levels.size() == 6);
+
+  SIZE_T expectedOffset = 0;
+  for (SIZE_T i = 0; i < chain.levels.size(); ++i) {
+    const auto& level = chain.levels[i];
+    REQUIRE(level.width == std::max(37u >> i, 1u));
+    REQUIRE(level.height == std::max(10u >> i, 1u));
+    REQUIRE(level.rowPitch == level.width * 4);
+    REQUIRE(level.offset == expectedOffset);
+    expectedOffset += static_cast<SIZE_T>(level.rowPitch) * level.height;
+  }
+  REQUIRE(chain.data.size() == expectedOffset);
+
+  //Level 0 is an exact copy of the source
+  REQUIRE(memcmp(chain.getLevelData(0), pixels.data(), pixels.size()) == 0);
+
+  MipMapOptions options;
+  options.maxLevels = 2;
+  REQUIRE(MipMapGenerator::generateRGBA8(pixels.data(), 37, 10, options).levels.size() == 2);
+}
+
+TEST_CASE("MipMapGenerator: solid colors are preserved by every filter", "[MipMapGenerator]") {
+  auto pixels = solidImage(45, 33, 200, 100, 7, 128);
+
+  for (auto filter : { MIP_FILTER::kBox, MIP_FILTER::kKaiser }) {
+    MipMapOptions options;
+    options.filter = filter;
+    auto chain = MipMapGenerator::generateRGBA8(pixels.data(), 45, 33, options);
+
+    for (uint32 i = 1; i < chain.levels.size(); ++i) {
+      const auto& level = chain.levels[i];
+      const uint8* data = chain.getLevelData(i);
+      for (uint32 p = 0; p < level.width * level.height; ++p) {
+        REQUIRE(data[p * 4 + 0] == 200);
+        REQUIRE(data[p * 4 + 1] == 100);
+        REQUIRE(data[p * 4 + 2] == 7);
+        REQUIRE(data[p * 4 + 3] == 128);
+      }
+    }
+  }
+}
+
+TEST_CASE("MipMapGenerator: filtering is done in linear space", "[MipMapGenerator]") {
+  //Black and white columns average to linear 0.5, which is 188 in sRGB
+  Vector<uint8> pixels(2 * 2 * 4);
+  for (uint32 p = 0; p < 4; ++p) {
+    const uint8 v = (p % 2) ? 255 : 0;
+    pixels[p * 4 + 0] = v;
+    pixels[p * 4 + 1] = v;
+    pixels[p * 4 + 2] = v;
+    pixels[p * 4 + 3] = 255;
+  }
+
+  MipMapOptions options;
+  options.bSRGB = true;
+  auto chain = MipMapGenerator::generateRGBA8(pixels.data(), 2, 2, options);
+  REQUIRE(chain.levels.size() == 2);
+  REQUIRE(chain.getLevelData(1)[0] == 188);
+
+  //UNORM images by default
+  chain = MipMapGenerator::generateRGBA8(pixels.data(), 2, 2);
+  REQUIRE(chain.getLevelData(1)[0] == 128);
+}
+
+TEST_CASE("MipMapGenerator: transparent pixels don't bleed their color", "[MipMapGenerator]") {
+  //Half red opaque, half green fully transparent
+  Vector<uint8> pixels(2 * 1 * 4, 0);
+  pixels[0] = 255;
+  pixels[3] = 255;
+  pixels[5] = 255;
+
+  auto chain = MipMapGenerator::generateRGBA8(pixels.data(), 2, 1);
+  const uint8* mip = chain.getLevelData(1);
+  REQUIRE(mip[0] == 255);
+  REQUIRE(mip[1] == 0);
+  REQUIRE(mip[3] == 128);
+}
+
+TEST_CASE("MipMapGenerator: float images", "[MipMapGenerator]") {
+  Vector<float> pixels(4 * 4 * 4);
+  for (uint32 p = 0; p < 16; ++p) {
+    pixels[p * 4 + 0] = static_cast<float>(p);
+    pixels[p * 4 + 1] = 2.0f;
+    pixels[p * 4 + 2] = 0.0f;
+    pixels[p * 4 + 3] = 1.0f;
+  }
+
+  auto chain = MipMapGenerator::generateRGBA32F(pixels.data(), 4, 4);
+  REQUIRE(chain.levels.size() == 3);
+  REQUIRE(chain.levels[1].rowPitch == 2 * 16);
+
+  const float* last = reinterpret_cast<const float*>(chain.getLevelData(2));
+  REQUIRE(last[0] == Catch::Approx(7.5f));
+  REQUIRE(last[1] == Catch::Approx(2.0f));
+  REQUIRE(last[3] == Catch::Approx(1.0f));
+}
+
+TEST_CASE("MipMapGenerator: parallel generation matches the serial one", "[MipMapGenerator]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const uint32 width = 1024;
+  const uint32 height = 768;
+  Vector<uint8> pixels(static_cast<SIZE_T>(width) * height * 4);
+  for (SIZE_T i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8>((i * 2654435761u) >> 13);
+  }
+
+  MipMapOptions options;
+  options.filter = MIP_FILTER::kKaiser;
+  auto parallel = MipMapGenerator::generateRGBA8(pixels.data(), width, height, options);
+  options.bParallel = false;
+  auto serial = MipMapGenerator::generateRGBA8(pixels.data(), width, height, options);
+
+  REQUIRE(parallel.data == serial.data);
+}
+
+TEST_CASE("MipMapGenerator: throughput", "[.][benchmark][MipMapGenerator]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const uint32 size = 2048;
+  Vector<uint8> pixels(static_cast<SIZE_T>(size) * size * 4);
+  for (SIZE_T i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8>((i * 2654435761u) >> 13);
+  }
+
+  BENCHMARK("box chain 2048x2048") {
+    return MipMapGenerator::generateRGBA8(pixels.data(), size, size).data.size();
+  };
+
+  MipMapOptions options;
+  options.filter = MIP_FILTER::kKaiser;
+  BENCHMARK("kaiser chain 2048x2048") {
+    return MipMapGenerator::generateRGBA8(pixels.data(), size, size, options).data.size();
+  };
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "gePrerequisitesUtilities.h"
+#include "gePath.h"
+#include "gePathID.h"
+
+using namespace geEngineSDK;
+
+TEST_CASE("Path: parses unix paths", "[Path]")
+{
+  const Path p("/usr/local/share/file.tar.gz", PATH_TYPE::kUnix);
+  REQUIRE(p.isAbsolute());
+  REQUIRE(p.isFile());
+  REQUIRE(p.getNumDirectories() == 3);
+  REQUIRE(p[0] == "usr");
+  REQUIRE(p[1] == "local");
+  REQUIRE(p[2] == "share");
+  REQUIRE(p.getFilename() == "file.tar.gz");
+  REQUIRE(p.getFilename(false) == "file.tar");
+  REQUIRE(p.getExtension() == ".gz");
+  REQUIRE(p.getTail() == "file.tar.gz");
+  REQUIRE(p.toString(PATH_TYPE::kUnix) == "/usr/local/share/file.tar.gz");
+
+  const Path dir("relative/dir/", PATH_TYPE::kUnix);
+  REQUIRE_FALSE(dir.isAbsolute());
+  REQUIRE(dir.isDirectory());
+  REQUIRE(dir.getNumDirectories() == 2);
+  REQUIRE(dir.getTail() == "dir");
+}
+
+TEST_CASE("Path: parses windows paths", "[Path]")
+{
+  const Path p("C:\\Games\\Data\\..\\Textures\\stone.png", PATH_TYPE::kWindows);
+  REQUIRE(p.isAbsolute());
+  REQUIRE(p.getDevice() == "C");
+  REQUIRE(p.getNumDirectories() == 2);
+  REQUIRE(p[0] == "Games");
+  REQUIRE(p[1] == "Textures");
+  REQUIRE(p.getFilename() == "stone.png");
+  REQUIRE(p.toString(PATH_TYPE::kWindows) == "C:\\Games\\Textures\\stone.png");
+
+  const Path unc("\\\\server\\share\\file.txt", PATH_TYPE::kWindows);
+  REQUIRE(unc.getNode() == "server");
+  REQUIRE(unc.getNumDirectories() == 1);
+  REQUIRE(unc.toString(PATH_TYPE::kWindows) == "\\\\server\\share\\file.txt");
+}
+
+TEST_CASE("Path: edits keep the elements consistent", "[Path]")
+{
+  Path p("/assets/textures/stone.png", PATH_TYPE::kUnix);
+
+  p.setExtension(".dds");
+  REQUIRE(p.getFilename() == "stone.dds");
+
+  p.setBasename("marble");
+  REQUIRE(p.getFilename() == "marble.dds");
+
+  p.setFilename("a_much_longer_file_name_that_does_not_fit_inline_storage.dds");
+  REQUIRE(p.getNumDirectories() == 2);
+  REQUIRE(p[1] == "textures");
+
+  p.makeParent();
+  REQUIRE(p.isDirectory());
+  REQUIRE(p.toString(PATH_TYPE::kUnix) == "/assets/textures/");
+
+  p.append(Path("../models/rock.obj", PATH_TYPE::kUnix));
+  REQUIRE(p.toString(PATH_TYPE::kUnix) == "/assets/models/rock.obj");
+
+  const Path base("/assets/", PATH_TYPE::kUnix);
+  Path relative = p.getRelative(base);
+  REQUIRE_FALSE(relative.isAbsolute());
+  REQUIRE(relative.toString(PATH_TYPE::kUnix) == "models/rock.obj");
+  REQUIRE(relative.getAbsolute(base) == p);
+
+  Path self("a/b", PATH_TYPE::kUnix);
+  self.append(self);
+  REQUIRE(self.toString(PATH_TYPE::kUnix) == "a/b/a/b");
+}
+
+TEST_CASE("Path: equality and hash ignore case", "[Path]")
+{
+  const Path a("/Data/Textures/Stone.PNG", PATH_TYPE::kUnix);
+  const Path b("/data/textures/stone.png", PATH_TYPE::kUnix);
+  const Path c("/data/textures.stone.png", PATH_TYPE::kUnix);
+
+  REQUIRE(a == b);
+  REQUIRE(a.getHash() == b.getHash());
+  REQUIRE(std::hash<Path>()(a) == std::hash<Path>()(b));
+  REQUIRE(a != c);
+  REQUIRE(a.getHash() != c.getHash());
+
+  REQUIRE(Path("/data/", PATH_TYPE::kUnix).includes(a));
+  REQUIRE_FALSE(a.includes(Path("/data/", PATH_TYPE::kUnix)));
+
+  UnorderedMap<Path, int32> index;
+  index[a] = 7;
+  REQUIRE(index.find(b) != index.end());
+  REQUIRE(index.find(c) == index.end());
+}
+
+TEST_CASE("PathID: interns the canonical path", "[Path][PathID]")
+{
+  const PathID a(Path("/Data/Textures/Stone.png", PATH_TYPE::kUnix));
+  const PathID b(Path("/data/models/../textures/stone.png", PATH_TYPE::kUnix));
+  const PathID c(Path("data/textures/stone.png", PATH_TYPE::kUnix));
+
+  REQUIRE(a == b);
+  REQUIRE(a.id() == b.id());
+  REQUIRE(a != c);
+  REQUIRE(String(a.c_str()) == "/data/textures/stone.png");
+  REQUIRE(a.toPath() == Path("/data/textures/stone.png", PATH_TYPE::kUnix));
+
+  REQUIRE(PathID().empty());
+  REQUIRE(PathID(Path()).empty());
+}
+
+TEST_CASE("Path: throughput", "[.][benchmark][Path]")
+{
+  const String source = "/project/assets/textures/environment/stone_albedo.png";
+  const Path path(source, PATH_TYPE::kUnix);
+
+  BENCHMARK("parse") {
+    return Path(source, PATH_TYPE::kUnix);
+  };
+
+  BENCHMARK("copy") {
+    return Path(path);
+  };
+
+  BENCHMARK("hash") {
+    return path.getHash();
+  };
+
+  BENCHMARK("PathID") {
+    return PathID(path);
+  };
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "geProfiler.h"
+#include "geThreadPool.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  void
+  ensureProfilerStartedForTests() {
+    if (!Profiler::isStarted()) {
+      Profiler::startUp();
+    }
+
+    //Drops what the other tests recorded
+    Profiler::instance().endFrame();
+  }
+
+  const ProfileNode*
+  findNode(const ProfileFrame& frame, const char* name) {
+    for (const auto& node : frame.nodes) {
+      if (0 == strcmp(node.name, name)) {
+        return &node;
+      }
+    }
+    return nullptr;
+  }
+
+  uint32
+  nodeIndex(const ProfileFrame& frame, const ProfileNode* node) {
+    return static_cast<uint32>(node - frame.nodes.data());
+  }
+}
+
+TEST_CASE("Profiler: nested zones build a tree", "[Profiler]")
+{
+  ensureProfilerStartedForTests();
+  auto& profiler = Profiler::instance();
+
+  {
+    GE_PROFILE_SCOPE("Outer");
+    for (int32 i = 0; i < 3; ++i) {
+      GE_PROFILE_SCOPE("Inner");
+      GE_PROFILE_SCOPE("Leaf");
+    }
+  }
+  {
+    GE_PROFILE_SCOPE("Outer");
+  }
+  profiler.endFrame();
+
+  const ProfileFrame& frame = profiler.getLastFrame();
+  REQUIRE(frame.end >= frame.begin);
+
+  const ProfileNode* root = findNode(frame, "Main");
+  const ProfileNode* outer = findNode(frame, "Outer");
+  const ProfileNode* inner = findNode(frame, "Inner");
+  const ProfileNode* leaf = findNode(frame, "Leaf");
+  REQUIRE(root);
+  REQUIRE(outer);
+  REQUIRE(inner);
+  REQUIRE(leaf);
+
+  REQUIRE(root->parent == NumLimit::MAX_UINT32);
+  REQUIRE(outer->parent == nodeIndex(frame, root));
+  REQUIRE(inner->parent == nodeIndex(frame, outer));
+  REQUIRE(leaf->parent == nodeIndex(frame, inner));
+
+  REQUIRE(outer->calls == 2);
+  REQUIRE(inner->calls == 3);
+  REQUIRE(leaf->calls == 3);
+
+  REQUIRE(root->totalTime == outer->totalTime);
+  REQUIRE(outer->totalTime >= inner->totalTime);
+  REQUIRE(outer->selfTime == outer->totalTime - inner->totalTime);
+  REQUIRE(inner->selfTime == inner->totalTime - leaf->totalTime);
+  REQUIRE(leaf->selfTime == leaf->totalTime);
+
+  //The next frame starts empty
+  profiler.endFrame();
+  REQUIRE(profiler.getLastFrame().index == frame.index);
+  REQUIRE(profiler.getLastFrame().nodes.empty());
+}
+
+TEST_CASE("Profiler: collects the zones of other threads", "[Profiler]")
+{
+  ensureProfilerStartedForTests();
+  auto& profiler = Profiler::instance();
+
+  Vector<std::thread> threads;
+  for (uint32 i = 0; i < 4; ++i) {
+    threads.emplace_back([i]() {
+      Profiler::instance().setThreadName("Worker " + toString(i));
+      for (int32 j = 0; j < 100; ++j) {
+        GE_PROFILE_SCOPE("WorkerZone");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  //Jobs of the thread pool are zones by themselves
+  TThreadPool<> pool(1, 2, 60);
+  pool.run("PooledJob", []() {}).blockUntilComplete();
+
+  profiler.endFrame();
+  const ProfileFrame& frame = profiler.getLastFrame();
+  const Vector<String> threadNames = profiler.getThreadNames();
+
+  uint32 numWorkerRoots = 0;
+  uint32 numWorkerZones = 0;
+  for (const auto& node : frame.nodes) {
+    if (NumLimit::MAX_UINT32 == node.parent &&
+        0 == threadNames[node.thread].rfind("Worker ", 0)) {
+      ++numWorkerRoots;
+    }
+    if (0 == strcmp(node.name, "WorkerZone")) {
+      REQUIRE(node.calls == 100);
+      numWorkerZones += 1;
+    }
+  }
+  REQUIRE(numWorkerRoots == 4);
+  REQUIRE(numWorkerZones == 4);
+  REQUIRE(findNode(frame, "PooledJob"));
+}
+
+TEST_CASE("Profiler: exports the captured frames as a Chrome trace", "[Profiler]")
+{
+  ensureProfilerStartedForTests();
+  auto& profiler = Profiler::instance();
+
+  profiler.setCapturedFrames(2);
+  for (int32 i = 0; i < 3; ++i) {
+    GE_PROFILE_SCOPE(0 == i ? "Dropped" : "Exported \"zone\"");
+    profiler.endFrame();
+  }
+  {
+    GE_PROFILE_SCOPE("Exported \"zone\"");
+  }
+  profiler.endFrame();
+
+  const String trace = profiler.exportChromeTrace();
+  profiler.setCapturedFrames(0);
+
+  REQUIRE(trace.rfind("{\"traceEvents\":[", 0) == 0);
+  REQUIRE(trace.find(R"("name":"thread_name","ph":"M")") != String::npos);
+  REQUIRE(trace.find(R"("args":{"name":"Main"})") != String::npos);
+  REQUIRE(trace.find(R"({"name":"Exported \"zone\"","ph":"X","pid":1,"tid":0,"ts":)") !=
+          String::npos);
+
+  //Only the last two frames are kept
+  REQUIRE(trace.find("Dropped") == String::npos);
+  REQUIRE(trace.substr(trace.size() - 2) == "]}");
+}
+
+TEST_CASE("Profiler: counts the zones that don't fit in the ring", "[Profiler]")
+{
+  ensureProfilerStartedForTests();
+  auto& profiler = Profiler::instance();
+
+  const uint64 dropped = profiler.getNumDroppedZones();
+  for (uint32 i = 0; i < Profiler::RING_SIZE + 10; ++i) {
+    GE_PROFILE_SCOPE("Overflow");
+  }
+  REQUIRE(profiler.getNumDroppedZones() == dropped + 10);
+
+  profiler.endFrame();
+  REQUIRE(findNode(profiler.getLastFrame(), "Overflow")->calls == Profiler::RING_SIZE);
+}
+
+TEST_CASE("Profiler: zone overhead", "[.][benchmark][Profiler]")
+{
+  ensureProfilerStartedForTests();
+  auto& profiler = Profiler::instance();
+
+  BENCHMARK("1000 zones") {
+    for (int32 i = 0; i < 1000; ++i) {
+      GE_PROFILE_SCOPE("Benchmark");
+    }
+    profiler.endFrame();
+    return profiler.getLastFrame().nodes.size();
+  };
+}
@@ -1,10 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_get_random_seed.hpp>
 #include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <random>
 #include <limits>
 #include <locale>
+#include <thread>
 
 #include "geString.h"
 #include "geStringID.h"
@@ -459,6 +461,63 @@ TEST_CASE("StringID: works with std::hash (unordered_map key)", "[Text][StringID
   REQUIRE(m[StringID("b")] == 2);
 }
 
+TEST_CASE("StringID: long names, explicit sizes and compile time hashes", "[Text][StringID]")
+{
+  //Names are no longer limited to 256 characters
+  const String longName(5000, 'x');
+  StringID a(longName);
+  StringID b(longName.c_str());
+  REQUIRE(a == b);
+  REQUIRE(a.size() == 5000);
+  REQUIRE(String(a.c_str()) == longName);
+
+  //A prefix is a different name
+  StringID prefix("hello_world", 5);
+  REQUIRE(prefix == StringID("hello"));
+  REQUIRE(prefix != StringID("hello_world"));
+
+  static_assert(StringID::calcHash("abc", 3) != StringID::calcHash("abd", 3));
+  REQUIRE(GE_STRING_ID("compile_time") == StringID("compile_time"));
+  REQUIRE(StringID(String("")) == StringID(""));
+  REQUIRE_FALSE(StringID("").empty());
+}
+
+TEST_CASE("StringID: concurrent construction interns each name once", "[Text][StringID][Threading]")
+{
+  //More names than the old fixed chunks could hold
+  const uint32 numNames = 20000;
+  const uint32 numThreads = 4;
+
+  std::vector<std::vector<StringID>> results(numThreads);
+  std::vector<std::thread> threads;
+  for (uint32 t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      auto& ids = results[t];
+      ids.resize(numNames);
+      //Each thread walks the names on a different order (steps are coprime
+      //with the number of names so every name is visited)
+      const uint32 steps[] = { 1, 3, 7, 9 };
+      for (uint32 i = 0; i < numNames; ++i) {
+        const uint32 n = (i * steps[t] + t * 977) % numNames;
+        ids[n] = StringID("concurrent_name_" + toString(n));
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  std::unordered_map<uint32, uint32> seenIds;
+  for (uint32 n = 0; n < numNames; ++n) {
+    const StringID& id = results[0][n];
+    REQUIRE(String(id.c_str()) == "concurrent_name_" + toString(n));
+    for (uint32 t = 1; t < numThreads; ++t) {
+      REQUIRE(results[t][n] == id);
+    }
+    REQUIRE(seenIds.emplace(id.id(), n).second);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // Property-based: split/join-ish invariants, trim idempotence, format stability
 // -----------------------------------------------------------------------------
@@ -557,3 +616,101 @@ TEST_CASE("StringFormat: backslash is literal unless escaping braces/backslash",
   // 4) Escape de '{' con backslash: "\{0}" debe dejar "{0}" literal (no formatear)
   REQUIRE(StringFormat::format("x{{0}}y", 9) == "x{0}y");
 }
+
+TEST_CASE("StringFormat: numbers, bools and strings", "[Text][Format]") {
+  REQUIRE(StringFormat::format("{0} {1} {2}", -42, 42u, int64(-9000000000)) ==
+          "-42 42 -9000000000");
+  REQUIRE(StringFormat::format("{0}|{1}", true, false) == "true|false");
+  REQUIRE(StringFormat::format("{0} {1}", 1.5f, 0.1) == toString(1.5f) + " " + toString(0.1));
+  REQUIRE(StringFormat::format("{0}", 123456789.0) == toString(123456789.0));
+
+  const String str = "abc";
+  const char* cstr = "def";
+  const char* nullStr = nullptr;
+  REQUIRE(StringFormat::format("{0}{1}[{2}]", str, cstr, nullStr) == "abcdef[]");
+
+  //Parameters can be reused and written in any order
+  REQUIRE(StringFormat::format("{1}{0}{1}", 'a', 2) == "2972");
+}
+
+TEST_CASE("StringFormat: wide strings", "[Text][Format]") {
+  REQUIRE(StringFormat::format(L"{0}-{1}", 7, WString(L"x")) == L"7-x");
+  REQUIRE(StringFormat::format(L"{0}", String("narrow")) == L"narrow");
+  REQUIRE(StringUtil::format(WString(L"{1}{0}"), 1, 2) == L"21");
+}
+
+TEST_CASE("StringFormat: runtime format strings", "[Text][Format]") {
+  const String fmt = "{0} and {3}";
+  REQUIRE(StringFormat::format(fmt.c_str(), 1) == "1 and ");
+  REQUIRE(StringUtil::format(fmt, 1, 2, 3, 4) == "1 and 4");
+
+  char buffer[16];
+  REQUIRE(StringFormat::formatTo(buffer, StringFormat::runtime<char, int32>(fmt.c_str()), 5) == 6);
+  REQUIRE(String(buffer) == "5 and ");
+}
+
+TEST_CASE("StringFormat: long strings are not truncated", "[Text][Format]") {
+  const String longArg(2000, 'x');
+  const String result = StringFormat::format("[{0}]{0}", longArg);
+  REQUIRE(result == "[" + longArg + "]" + longArg);
+
+  //More pieces than the pre-parsed limit
+  REQUIRE(StringFormat::format("{0}a{0}b{0}c{0}d{0}e{0}f{0}g{0}h{0}i{0}j{0}", 1) ==
+          "1a1b1c1d1e1f1g1h1i1j1");
+}
+
+TEST_CASE("StringFormat::formatTo: writes to the caller buffer", "[Text][Format]") {
+  char buffer[8];
+  REQUIRE(StringFormat::formatTo(buffer, "{0}+{1}", 1, 2) == 3);
+  REQUIRE(String(buffer) == "1+2");
+
+  //Truncated output is null terminated, the full size is returned
+  REQUIRE(StringFormat::formatTo(buffer, "value={0}", 123456) == 12);
+  REQUIRE(String(buffer) == "value=1");
+
+  char small[4] = { 'z', 'z', 'z', 'z' };
+  REQUIRE(StringFormat::formatTo(small, 0, "{0}", 99) == 2);
+  REQUIRE(small[0] == 'z');
+
+  wchar_t wbuffer[8];
+  REQUIRE(StringFormat::formatTo(wbuffer, L"{0}", 42) == 2);
+  REQUIRE(WString(wbuffer) == L"42");
+}
+
+TEST_CASE("StringFormat::formatToFrame: allocates from the frame allocator",
+          "[Text][Format]") {
+  ge_frame_mark();
+
+  const char* message = StringFormat::formatToFrame("{0} of {1}", 3, 10);
+  REQUIRE(String(message) == "3 of 10");
+
+  const String longArg(1000, 'y');
+  const char* longMessage = StringFormat::formatToFrame("<{0}>", longArg);
+  REQUIRE(String(longMessage) == "<" + longArg + ">");
+
+  const wchar_t* wideMessage = StringFormat::formatToFrame(L"{0}", 5);
+  REQUIRE(WString(wideMessage) == L"5");
+
+  ge_frame_clear();
+}
+
+TEST_CASE("StringFormat: throughput", "[.][benchmark][Text][Format]") {
+  const String name = "texture.png";
+
+  BENCHMARK("format") {
+    return StringFormat::format("Loaded {0} ({1}x{2}, {3} mips) in {4} ms",
+                                name, 1024, 512, 11, 3.25f);
+  };
+
+  BENCHMARK("formatTo") {
+    char buffer[128];
+    return StringFormat::formatTo(buffer,
+                                  "Loaded {0} ({1}x{2}, {3} mips) in {4} ms",
+                                  name, 1024, 512, 11, 3.25f);
+  };
+
+  BENCHMARK("toString concatenation") {
+    return "Loaded " + name + " (" + toString(1024) + "x" + toString(512) + ", " +
+           toString(11) + " mips) in " + toString(3.25f) + " ms";
+  };
+}
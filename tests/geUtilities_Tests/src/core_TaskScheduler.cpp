@@ -132,3 +132,46 @@ TEST_CASE("TaskScheduler: TaskGroup runs count items and wait completes",
   REQUIRE(g->isComplete());
   REQUIRE(hits.load(std::memory_order_relaxed) == N);
 }
+
+TEST_CASE("TaskScheduler: parallelForChunks covers the range once",
+          "[TaskScheduler]") {
+  ensureThreadPoolModuleStartedForTests();
+  if (!TaskScheduler::isStarted()) {
+    TaskScheduler::startUp();
+  }
+
+  for (const uint32 count : { 0u, 1u, 100u, 1000u, 4099u }) {
+    std::vector<std::atomic<uint32>> hits(count);
+    std::atomic<uint32> numCalls{ 0 };
+    std::atomic<uint32> numBadChunks{ 0 };
+
+    //The assertion macros are not thread safe, the workers only count
+    parallelForChunks("chunks", count, 64, [&](uint32 begin, uint32 end) {
+      if (begin >= end || end - begin > 64) {
+        numBadChunks.fetch_add(1, std::memory_order_relaxed);
+      }
+      for (uint32 i = begin; i < end; ++i) {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+      }
+      numCalls.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    uint32 numHitOnce = 0;
+    for (auto& hit : hits) {
+      numHitOnce += 1 == hit.load() ? 1 : 0;
+    }
+    REQUIRE(numBadChunks.load() == 0);
+    REQUIRE(numHitOnce == count);
+    REQUIRE(numCalls.load() == (count + 63) / 64);
+  }
+
+  //Sequential chunks go in order on the calling thread
+  const auto callerId = std::this_thread::get_id();
+  uint32 next = 0;
+  parallelForChunks("chunks", 1000, 64, [&](uint32 begin, uint32 end) {
+    REQUIRE(std::this_thread::get_id() == callerId);
+    REQUIRE(begin == next);
+    next = end;
+  }, false);
+  REQUIRE(next == 1000);
+}
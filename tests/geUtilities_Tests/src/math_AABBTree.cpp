@@ -0,0 +1,255 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <random>
+
+#include "geAABBTree.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  struct TestObject
+  {
+    AABox box;
+    int32 proxy = AABBTree::NULL_NODE;
+  };
+
+  Vector<TestObject>
+  makeObjects(uint32 count, float worldSize, uint32 seed = 7) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    Vector<TestObject> objects(count);
+    for (auto& object : objects) {
+      const Vector3 min(position(rng), position(rng), position(rng));
+      object.box = AABox(min, min + Vector3(size(rng), size(rng), size(rng)));
+    }
+    return objects;
+  }
+
+  void
+  insertAll(AABBTree& tree, Vector<TestObject>& objects) {
+    for (auto& object : objects) {
+      object.proxy = tree.createProxy(object.box, &object);
+    }
+  }
+
+  template<class Overlaps>
+  Vector<int32>
+  bruteForce(const AABBTree& tree, const Vector<TestObject>& objects, Overlaps&& overlaps) {
+    Vector<int32> result;
+    for (const auto& object : objects) {
+      if (AABBTree::NULL_NODE != object.proxy && overlaps(tree.getFatBox(object.proxy))) {
+        result.push_back(object.proxy);
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  Vector<int32>
+  sorted(Vector<int32> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+}
+
+TEST_CASE("AABBTree: box and sphere queries match a linear scan", "[AABBTree]")
+{
+  AABBTree tree;
+  auto objects = makeObjects(2000, 100.0f);
+  insertAll(tree, objects);
+
+  REQUIRE(tree.getProxyCount() == 2000);
+  REQUIRE(tree.validate());
+
+  //A balanced tree of 2000 leaves has a height of 11
+  REQUIRE(tree.getHeight() < 24);
+
+  const AABox queryBox(Vector3(20.0f, 30.0f, 10.0f), Vector3(45.0f, 50.0f, 60.0f));
+  Vector<int32> found;
+  tree.query(queryBox, [&](int32 proxyId) {
+    found.push_back(proxyId);
+    return true;
+  });
+  REQUIRE(!found.empty());
+  REQUIRE(sorted(found) ==
+          bruteForce(tree, objects, [&](const AABox& box) { return box.intersect(queryBox); }));
+  REQUIRE(static_cast<TestObject*>(tree.getUserData(found[0]))->proxy == found[0]);
+
+  const Sphere sphere(Vector3(50.0f, 50.0f, 50.0f), 15.0f);
+  found.clear();
+  tree.query(sphere, [&](int32 proxyId) {
+    found.push_back(proxyId);
+    return true;
+  });
+  REQUIRE(!found.empty());
+  REQUIRE(sorted(found) == bruteForce(tree, objects, [&](const AABox& box) {
+    return Math::sphereAABBIntersection(sphere.m_center, 15.0f * 15.0f, box);
+  }));
+
+  //Returning false stops the query
+  uint32 visited = 0;
+  tree.query(queryBox, [&](int32) { return ++visited < 3; });
+  REQUIRE(visited == 3);
+}
+
+TEST_CASE("AABBTree: plane and ray queries", "[AABBTree]")
+{
+  AABBTree tree(0.0f);
+  Vector<TestObject> objects;
+  for (uint32 i = 0; i < 10; ++i) {
+    TestObject object;
+    object.box = AABox(Vector3(i * 10.0f, 0.0f, 0.0f), Vector3(i * 10.0f + 1.0f, 1.0f, 1.0f));
+    objects.push_back(object);
+  }
+  insertAll(tree, objects);
+
+  //Everything with x <= 35 (the normal faces out of the volume)
+  const Plane halfSpace(Vector3(1.0f, 0.0f, 0.0f), 35.0f);
+  Vector<int32> found;
+  tree.query(&halfSpace, 1, [&](int32 proxyId) {
+    found.push_back(proxyId);
+    return true;
+  });
+  REQUIRE(found.size() == 4);
+
+  //Closest hit along +x from the middle of the row
+  int32 closest = AABBTree::NULL_NODE;
+  tree.raycast(Vector3(25.0f, 0.5f, 0.5f),
+               Vector3(1.0f, 0.0f, 0.0f),
+               1000.0f,
+               [&](int32 proxyId, float maxDistance) {
+                 const float distance = tree.getFatBox(proxyId).m_min.x - 25.0f;
+                 if (distance >= maxDistance) {
+                   return maxDistance;
+                 }
+                 closest = proxyId;
+                 return distance;
+               });
+  REQUIRE(closest == objects[3].proxy);
+
+  //A ray that misses everything, parallel to two axes
+  bool bHit = false;
+  tree.raycast(Vector3(0.0f, 5.0f, 0.5f),
+               Vector3(1.0f, 0.0f, 0.0f),
+               1000.0f,
+               [&](int32, float maxDistance) {
+                 bHit = true;
+                 return maxDistance;
+               });
+  REQUIRE(!bHit);
+}
+
+TEST_CASE("AABBTree: moving and destroying proxies", "[AABBTree]")
+{
+  AABBTree tree(0.5f);
+  auto objects = makeObjects(1000, 50.0f);
+  insertAll(tree, objects);
+
+  //Small movements stay inside the fat boxes
+  const Vector3 nudge(0.2f, 0.0f, 0.0f);
+  uint32 reinserted = 0;
+  for (auto& object : objects) {
+    object.box = AABox(object.box.m_min + nudge, object.box.m_max + nudge);
+    reinserted += tree.moveProxy(object.proxy, object.box) ? 1 : 0;
+  }
+  REQUIRE(reinserted == 0);
+
+  //Large ones don't
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+  for (auto& object : objects) {
+    const Vector3 move(offset(rng), offset(rng), offset(rng));
+    object.box = AABox(object.box.m_min + move, object.box.m_max + move);
+    REQUIRE(tree.moveProxy(object.proxy, object.box, move));
+    REQUIRE(tree.getFatBox(object.proxy).m_min.x <= object.box.m_min.x);
+    REQUIRE(tree.getFatBox(object.proxy).m_max.x >= object.box.m_max.x);
+  }
+  REQUIRE(tree.validate());
+
+  for (uint32 i = 0; i < objects.size(); i += 2) {
+    tree.destroyProxy(objects[i].proxy);
+    objects[i].proxy = AABBTree::NULL_NODE;
+  }
+  REQUIRE(tree.getProxyCount() == 500);
+  REQUIRE(tree.validate());
+
+  const AABox queryBox(Vector3(-10.0f, -10.0f, -10.0f), Vector3(30.0f, 30.0f, 30.0f));
+  Vector<int32> found;
+  tree.query(queryBox, [&](int32 proxyId) {
+    found.push_back(proxyId);
+    return true;
+  });
+  REQUIRE(sorted(found) ==
+          bruteForce(tree, objects, [&](const AABox& box) { return box.intersect(queryBox); }));
+
+  //Freed nodes are reused
+  const uint32 nodesBefore = tree.getProxyCount();
+  TestObject extra;
+  extra.box = AABox(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f));
+  extra.proxy = tree.createProxy(extra.box, &extra);
+  REQUIRE(extra.proxy < cast::st<int32>(objects.size() * 2));
+  REQUIRE(tree.getProxyCount() == nodesBefore + 1);
+  REQUIRE(tree.validate());
+
+  tree.clear();
+  REQUIRE(tree.getProxyCount() == 0);
+  REQUIRE(tree.validate());
+}
+
+TEST_CASE("AABBTree: rotations keep sorted inserts shallow", "[AABBTree]")
+{
+  //Inserting along a line is the worst case for a tree without rotations
+  AABBTree tree(0.0f);
+  Vector<TestObject> objects(4096);
+  for (uint32 i = 0; i < objects.size(); ++i) {
+    objects[i].box = AABox(Vector3(float(i), 0.0f, 0.0f), Vector3(float(i) + 0.5f, 1.0f, 1.0f));
+  }
+  insertAll(tree, objects);
+
+  REQUIRE(tree.validate());
+  REQUIRE(tree.getHeight() < 40);
+}
+
+TEST_CASE("AABBTree: query throughput", "[.][benchmark][AABBTree]")
+{
+  AABBTree tree;
+  auto objects = makeObjects(100000, 1000.0f);
+
+  BENCHMARK("insert 100k proxies") {
+    AABBTree localTree;
+    for (auto& object : objects) {
+      localTree.createProxy(object.box, &object);
+    }
+    return localTree.getHeight();
+  };
+
+  insertAll(tree, objects);
+
+  BENCHMARK("100 box queries in 100k proxies") {
+    uint32 count = 0;
+    for (uint32 i = 0; i < 100; ++i) {
+      const Vector3 min(float(i % 10) * 100.0f, float(i / 10) * 100.0f, 500.0f);
+      tree.query(AABox(min, min + Vector3(10.0f, 10.0f, 10.0f)), [&](int32) {
+        ++count;
+        return true;
+      });
+    }
+    return count;
+  };
+
+  BENCHMARK("100 linear box scans in 100k objects") {
+    uint32 count = 0;
+    for (uint32 i = 0; i < 100; ++i) {
+      const Vector3 min(float(i % 10) * 100.0f, float(i / 10) * 100.0f, 500.0f);
+      const AABox queryBox(min, min + Vector3(10.0f, 10.0f, 10.0f));
+      for (const auto& object : objects) {
+        count += object.box.intersect(queryBox) ? 1 : 0;
+      }
+    }
+    return count;
+  };
+}
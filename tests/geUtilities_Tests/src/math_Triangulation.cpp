@@ -0,0 +1,276 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <random>
+
+#include "geTriangulation.h"
+#include "geTaskScheduler.h"
+#include "geVector3.h"
+
+using namespace geEngineSDK;
+
+namespace
+{
+  struct Vec3D
+  {
+    double x, y, z;
+  };
+
+  inline Vec3D
+  toD(const Vector3& v) {
+    return { v.x, v.y, v.z };
+  }
+
+  inline Vec3D
+  sub(const Vec3D& a, const Vec3D& b) {
+    return { a.x - b.x, a.y - b.y, a.z - b.z };
+  }
+
+  inline double
+  dot(const Vec3D& a, const Vec3D& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+  }
+
+  inline Vec3D
+  cross(const Vec3D& a, const Vec3D& b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+  }
+
+  inline double
+  tetVolume(const Vector<Vector3>& pts, const Tetrahedron& tet) {
+    const Vec3D a = toD(pts[tet.vertices[0]]);
+    const Vec3D b = toD(pts[tet.vertices[1]]);
+    const Vec3D c = toD(pts[tet.vertices[2]]);
+    const Vec3D d = toD(pts[tet.vertices[3]]);
+    return std::abs(dot(sub(a, d), cross(sub(b, d), sub(c, d)))) / 6.0;
+  }
+
+  void
+  requireConsistentNeighbors(const TetrahedronVolume& volume) {
+    const auto& tets = volume.tetrahedra;
+    SIZE_T numOpenFaces = 0;
+
+    for (SIZE_T i = 0; i < tets.size(); ++i) {
+      for (int32 j = 0; j < 4; ++j) {
+        const int32 neighbor = tets[i].neighbors[j];
+        if (neighbor < 0) {
+          ++numOpenFaces;
+          continue;
+        }
+
+        REQUIRE(neighbor < static_cast<int32>(tets.size()));
+
+        //The neighbor must point back and must not contain the opposite vertex
+        bool pointsBack = false;
+        for (int32 k = 0; k < 4; ++k) {
+          pointsBack |= tets[neighbor].neighbors[k] == static_cast<int32>(i);
+          REQUIRE(tets[neighbor].vertices[k] != tets[i].vertices[j]);
+        }
+        REQUIRE(pointsBack);
+      }
+    }
+
+    REQUIRE(numOpenFaces == volume.outerFaces.size());
+  }
+
+  void
+  requireOutwardFaces(const Vector<Vector3>& pts, const TetrahedronVolume& volume) {
+    for (const auto& face : volume.outerFaces) {
+      const Tetrahedron& tet = volume.tetrahedra[face.tetrahedron];
+      const Vec3D a = toD(pts[face.vertices[0]]);
+      const Vec3D b = toD(pts[face.vertices[1]]);
+      const Vec3D c = toD(pts[face.vertices[2]]);
+
+      Vec3D center = { 0.0, 0.0, 0.0 };
+      for (const int32 v : tet.vertices) {
+        const Vec3D p = toD(pts[v]);
+        center = { center.x + p.x * 0.25, center.y + p.y * 0.25, center.z + p.z * 0.25 };
+      }
+
+      const Vec3D normal = cross(sub(b, a), sub(c, a));
+      REQUIRE(dot(normal, sub(a, center)) > 0.0);
+    }
+  }
+
+  Vector<Vector3>
+  randomPoints(uint32 count, uint32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+    Vector<Vector3> points(count);
+    for (auto& pt : points) {
+      pt = Vector3(dist(rng), dist(rng), dist(rng));
+    }
+    return points;
+  }
+
+  Vector<Vector3>
+  clusteredPoints(uint32 count, uint32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> centerDist(-100.0f, 100.0f);
+    std::normal_distribution<float> spread(0.0f, 1.5f);
+
+    Vector<Vector3> centers(32);
+    for (auto& center : centers) {
+      center = Vector3(centerDist(rng), centerDist(rng), centerDist(rng));
+    }
+
+    Vector<Vector3> points(count);
+    for (uint32 i = 0; i < count; ++i) {
+      const Vector3& center = centers[i % centers.size()];
+      points[i] = Vector3(center.x + spread(rng),
+                          center.y + spread(rng),
+                          center.z + spread(rng));
+    }
+    return points;
+  }
+
+  void
+  ensureTaskSchedulerStartedForTests() {
+    if (!ThreadPool::isStarted()) {
+      ThreadPool::startUp<TThreadPool<>>(GE_THREAD_HARDWARE_CONCURRENCY - 1);
+    }
+    if (!TaskScheduler::isStarted()) {
+      TaskScheduler::startUp();
+    }
+  }
+}
+
+TEST_CASE("Triangulation: less than four points gives an empty volume", "[Triangulation]") {
+  Vector<Vector3> points = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0) };
+  auto volume = Triangulation::tetrahedralize(points);
+  REQUIRE(volume.tetrahedra.empty());
+  REQUIRE(volume.outerFaces.empty());
+}
+
+TEST_CASE("Triangulation: single tetrahedron", "[Triangulation]") {
+  Vector<Vector3> points = { Vector3(0, 0, 0),
+                             Vector3(1, 0, 0),
+                             Vector3(0, 1, 0),
+                             Vector3(0, 0, 1) };
+  auto volume = Triangulation::tetrahedralize(points);
+
+  REQUIRE(volume.tetrahedra.size() == 1);
+  REQUIRE(volume.outerFaces.size() == 4);
+  for (const int32 neighbor : volume.tetrahedra[0].neighbors) {
+    REQUIRE(neighbor == -1);
+  }
+  requireOutwardFaces(points, volume);
+}
+
+TEST_CASE("Triangulation: cospherical grid fills the whole box", "[Triangulation]") {
+  //A regular grid is the worst case for the predicates: every cell has eight
+  //cospherical points and lots of coplanar faces.
+  Vector<Vector3> points;
+  for (int32 z = 0; z < 5; ++z) {
+    for (int32 y = 0; y < 5; ++y) {
+      for (int32 x = 0; x < 5; ++x) {
+        points.emplace_back(static_cast<float>(x),
+                            static_cast<float>(y),
+                            static_cast<float>(z));
+      }
+    }
+  }
+
+  auto volume = Triangulation::tetrahedralize(points);
+  REQUIRE_FALSE(volume.tetrahedra.empty());
+
+  double totalVolume = 0.0;
+  for (const auto& tet : volume.tetrahedra) {
+    const double tetVol = tetVolume(points, tet);
+    REQUIRE(tetVol > 0.0);
+    totalVolume += tetVol;
+  }
+
+  REQUIRE(totalVolume == Catch::Approx(64.0));
+  requireConsistentNeighbors(volume);
+  requireOutwardFaces(points, volume);
+
+  //Every side of the box is made of 16 quads split in two triangles
+  REQUIRE(volume.outerFaces.size() == 6 * 16 * 2);
+}
+
+TEST_CASE("Triangulation: random points satisfy the empty sphere property", "[Triangulation]") {
+  const Vector<Vector3> points = randomPoints(600, 1234);
+  auto volume = Triangulation::tetrahedralize(points);
+  REQUIRE_FALSE(volume.tetrahedra.empty());
+
+  requireConsistentNeighbors(volume);
+  requireOutwardFaces(points, volume);
+
+  //Every input point must be used by some tetrahedron
+  Vector<uint8> used(points.size(), 0);
+  for (const auto& tet : volume.tetrahedra) {
+    for (const int32 v : tet.vertices) {
+      used[v] = 1;
+    }
+  }
+  for (const uint8 isUsed : used) {
+    REQUIRE(isUsed != 0);
+  }
+
+  for (const auto& tet : volume.tetrahedra) {
+    const Vec3D a = toD(points[tet.vertices[0]]);
+    const Vec3D b = sub(toD(points[tet.vertices[1]]), a);
+    const Vec3D c = sub(toD(points[tet.vertices[2]]), a);
+    const Vec3D d = sub(toD(points[tet.vertices[3]]), a);
+
+    //Circumcenter relative to a
+    const double denom = 2.0 * dot(b, cross(c, d));
+    REQUIRE(denom != 0.0);
+    const Vec3D bc = cross(c, d);
+    const Vec3D cd = cross(d, b);
+    const Vec3D db = cross(b, c);
+    const double b2 = dot(b, b), c2 = dot(c, c), d2 = dot(d, d);
+    const Vec3D center = { (b2 * bc.x + c2 * cd.x + d2 * db.x) / denom,
+                           (b2 * bc.y + c2 * cd.y + d2 * db.y) / denom,
+                           (b2 * bc.z + c2 * cd.z + d2 * db.z) / denom };
+    const double radius2 = dot(center, center);
+
+    for (const auto& pt : points) {
+      const Vec3D rel = sub(sub(toD(pt), a), center);
+      REQUIRE(dot(rel, rel) >= radius2 * (1.0 - 1e-6));
+    }
+  }
+}
+
+TEST_CASE("Triangulation: duplicated points are ignored", "[Triangulation]") {
+  Vector<Vector3> points = randomPoints(200, 99);
+  const Vector<Vector3> copy = points;
+  points.insert(points.end(), copy.begin(), copy.end());
+
+  auto withDuplicates = Triangulation::tetrahedralize(points);
+  auto withoutDuplicates = Triangulation::tetrahedralize(copy);
+
+  REQUIRE(withDuplicates.tetrahedra.size() == withoutDuplicates.tetrahedra.size());
+  requireConsistentNeighbors(withDuplicates);
+}
+
+TEST_CASE("Triangulation: parallel batches produce a valid mesh", "[Triangulation]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const Vector<Vector3> points = clusteredPoints(20000, 42);
+  auto volume = Triangulation::tetrahedralize(points);
+  REQUIRE_FALSE(volume.tetrahedra.empty());
+  requireConsistentNeighbors(volume);
+  requireOutwardFaces(points, volume);
+
+  for (const auto& tet : volume.tetrahedra) {
+    REQUIRE(tetVolume(points, tet) > 0.0);
+  }
+}
+
+TEST_CASE("Triangulation: throughput", "[.][benchmark][Triangulation]") {
+  ensureTaskSchedulerStartedForTests();
+
+  const Vector<Vector3> uniform = randomPoints(100000, 7);
+  const Vector<Vector3> clustered = clusteredPoints(100000, 7);
+
+  BENCHMARK("tetrahedralize 100k uniform points") {
+    return Triangulation::tetrahedralize(uniform).tetrahedra.size();
+  };
+
+  BENCHMARK("tetrahedralize 100k clustered points") {
+    return Triangulation::tetrahedralize(clustered).tetrahedra.size();
+  };
+}